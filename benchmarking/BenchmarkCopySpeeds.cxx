@@ -12,6 +12,7 @@
 
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/DeviceAdapter.h>
+#include <vtkm/cont/RuntimeDeviceInformation.h>
 #include <vtkm/cont/RuntimeDeviceTracker.h>
 #include <vtkm/cont/Timer.h>
 
@@ -30,6 +31,9 @@ vtkm::cont::InitializeResult Config;
 const vtkm::UInt64 COPY_SIZE_MIN = (1 << 10); // 1 KiB
 const vtkm::UInt64 COPY_SIZE_MAX = (1 << 30); // 1 GiB
 
+// NUMA effects only show once the arrays are much larger than the caches:
+const vtkm::UInt64 NUMA_COPY_SIZE_MIN = (1 << 24); // 16 MiB
+
 using TypeList = vtkm::List<vtkm::UInt8,
                             vtkm::Vec2ui_8,
                             vtkm::Vec3ui_8,
@@ -81,6 +85,117 @@ VTKM_BENCHMARK_TEMPLATES_OPTS(CopySpeed,
                                 ->ArgName("Bytes"),
                               TypeList);
 
+enum class NumaMode
+{
+  Default = 0,
+  FirstTouch = 1,
+  FirstTouchPinned = 2
+};
+
+const char* NumaModeName(NumaMode mode)
+{
+  switch (mode)
+  {
+    case NumaMode::Default:
+      return "Default";
+    case NumaMode::FirstTouch:
+      return "FirstTouch";
+    case NumaMode::FirstTouchPinned:
+      return "FirstTouchPinned";
+  }
+  return "";
+}
+
+// Copies arrays that were allocated on the device with each NUMA placement mode. The arrays
+// are allocated after the mode is set so that the first touch takes effect.
+void NumaCopySpeed(benchmark::State& state)
+{
+  using ValueType = vtkm::Float64;
+
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const NumaMode mode = static_cast<NumaMode>(state.range(0));
+  const vtkm::UInt64 numBytes = static_cast<vtkm::UInt64>(state.range(1));
+  const vtkm::Id numValues = static_cast<vtkm::Id>(numBytes / sizeof(ValueType));
+
+  vtkm::cont::internal::RuntimeDeviceConfigurationBase& config =
+    vtkm::cont::RuntimeDeviceInformation{}.GetRuntimeConfiguration(device);
+
+  bool oldFirstTouch = false;
+  bool oldPinning = false;
+  const bool supportsFirstTouch = config.GetNumaFirstTouch(oldFirstTouch) ==
+    vtkm::cont::internal::RuntimeDeviceConfigReturnCode::SUCCESS;
+  const bool supportsPinning = config.GetThreadPinning(oldPinning) ==
+    vtkm::cont::internal::RuntimeDeviceConfigReturnCode::SUCCESS;
+  if ((mode != NumaMode::Default && !supportsFirstTouch) ||
+      (mode == NumaMode::FirstTouchPinned && !supportsPinning))
+  {
+    state.SkipWithError("Device does not support this NUMA mode.");
+    return;
+  }
+  if (supportsFirstTouch)
+  {
+    config.SetNumaFirstTouch(mode != NumaMode::Default);
+  }
+  if (supportsPinning)
+  {
+    config.SetThreadPinning(mode == NumaMode::FirstTouchPinned);
+  }
+
+  vtkm::Id numThreads = 1;
+  config.GetThreads(numThreads);
+
+  {
+    std::ostringstream desc;
+    desc << NumaModeName(mode) << " " << vtkm::cont::GetHumanReadableSize(numBytes);
+    state.SetLabel(desc.str());
+  }
+
+  vtkm::cont::ArrayHandle<ValueType> src;
+  vtkm::cont::ArrayHandle<ValueType> dst;
+  vtkm::cont::Algorithm::Fill(device, src, ValueType{ 1 }, numValues);
+  vtkm::cont::Algorithm::Fill(device, dst, ValueType{ 0 }, numValues);
+
+  vtkm::cont::Timer timer(device);
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    vtkm::cont::Algorithm::Copy(device, src, dst);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+
+  const int64_t iterations = static_cast<int64_t>(state.iterations());
+  state.SetBytesProcessed(static_cast<int64_t>(numBytes) * iterations);
+  state.SetItemsProcessed(static_cast<int64_t>(numValues) * iterations);
+  state.counters["Threads"] = static_cast<double>(numThreads);
+
+  if (supportsFirstTouch)
+  {
+    config.SetNumaFirstTouch(oldFirstTouch);
+  }
+  if (supportsPinning)
+  {
+    config.SetThreadPinning(oldPinning);
+  }
+}
+
+void NumaCopySpeedGenerator(benchmark::internal::Benchmark* bm)
+{
+  bm->UseManualTime();
+  bm->ArgNames({ "Mode", "Bytes" });
+
+  for (int64_t mode = 0; mode <= static_cast<int64_t>(NumaMode::FirstTouchPinned); ++mode)
+  {
+    bm->Ranges({ { mode, mode },
+                 { static_cast<int64_t>(NUMA_COPY_SIZE_MIN),
+                   static_cast<int64_t>(COPY_SIZE_MAX) } });
+  }
+}
+
+VTKM_BENCHMARK_APPLY(NumaCopySpeed, NumaCopySpeedGenerator);
+
 } // end anon namespace
 
 int main(int argc, char* argv[])
@@ -15,17 +15,22 @@
 #include <vtkm/VecTraits.h>
 #include <vtkm/VectorAnalysis.h>
 
+#include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleSOA.h>
 #include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
 #include <vtkm/cont/CellSetExplicit.h>
 #include <vtkm/cont/CellSetSingleType.h>
 #include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/DataSetBuilderExplicit.h>
 #include <vtkm/cont/ErrorInternal.h>
+#include <vtkm/cont/Invoker.h>
 #include <vtkm/cont/Logging.h>
 #include <vtkm/cont/PartitionedDataSet.h>
 #include <vtkm/cont/RuntimeDeviceTracker.h>
 #include <vtkm/cont/Timer.h>
+#include <vtkm/cont/UnknownArrayHandle.h>
 
 #include <vtkm/cont/internal/OptionParser.h>
 
@@ -40,6 +45,9 @@
 #include <vtkm/filter/geometry_refinement/Tetrahedralize.h>
 #include <vtkm/filter/geometry_refinement/Triangulate.h>
 #include <vtkm/filter/geometry_refinement/VertexClustering.h>
+#include <vtkm/filter/image_processing/ImageMedian.h>
+#include <vtkm/filter/image_processing/worklet/ImageMedian.h>
+#include <vtkm/filter/resampling/Probe.h>
 #include <vtkm/filter/vector_analysis/Gradient.h>
 #include <vtkm/filter/vector_analysis/VectorMagnitude.h>
 
@@ -50,6 +58,7 @@
 #include <vtkm/worklet/WorkletMapField.h>
 
 #include <cctype> // for std::tolower
+#include <random>
 #include <sstream>
 #include <type_traits>
 
@@ -132,7 +141,9 @@ enum GradOpts : int
   QCriterion = 1 << 4,
   RowOrdering = 1 << 5,
   ScalarInput = 1 << 6,
-  PartitionedInput = 1 << 7
+  PartitionedInput = 1 << 7,
+  VorticityMagnitude = 1 << 8,
+  HighOrder = 1 << 9
 };
 
 void BenchGradient(::benchmark::State& state, int options)
@@ -144,7 +155,8 @@ void BenchGradient(::benchmark::State& state, int options)
   if (options & ScalarInput)
   {
     // Some outputs require vectors:
-    if (options & Divergence || options & Vorticity || options & QCriterion)
+    if (options & Divergence || options & Vorticity || options & VorticityMagnitude ||
+        options & QCriterion)
     {
       throw vtkm::cont::ErrorInternal("A requested gradient output is "
                                       "incompatible with scalar input.");
@@ -160,8 +172,20 @@ void BenchGradient(::benchmark::State& state, int options)
   filter.SetComputePointGradient(static_cast<bool>(options & PointGradient));
   filter.SetComputeDivergence(static_cast<bool>(options & Divergence));
   filter.SetComputeVorticity(static_cast<bool>(options & Vorticity));
+  filter.SetComputeVorticityMagnitude(static_cast<bool>(options & VorticityMagnitude));
   filter.SetComputeQCriterion(static_cast<bool>(options & QCriterion));
 
+  if (options & HighOrder)
+  {
+    // Higher order gradients only support structured data:
+    if (!InputIsStructured())
+    {
+      state.SkipWithError("Higher order gradients require structured data.");
+      return;
+    }
+    filter.SetOrderOfAccuracy(4);
+  }
+
   if (options & RowOrdering)
   {
     filter.SetRowMajorOrdering();
@@ -206,8 +230,12 @@ VTKM_PRIVATE_GRADIENT_BENCHMARK(Vector, Gradient);
 VTKM_PRIVATE_GRADIENT_BENCHMARK(VectorPartitionedData, Gradient | PartitionedInput);
 VTKM_PRIVATE_GRADIENT_BENCHMARK(VectorRow, Gradient | RowOrdering);
 VTKM_PRIVATE_GRADIENT_BENCHMARK(Point, PointGradient);
+VTKM_PRIVATE_GRADIENT_BENCHMARK(PointHighOrder, PointGradient | HighOrder);
+VTKM_PRIVATE_GRADIENT_BENCHMARK(ScalarPointHighOrder, PointGradient | HighOrder | ScalarInput);
 VTKM_PRIVATE_GRADIENT_BENCHMARK(Divergence, Divergence);
 VTKM_PRIVATE_GRADIENT_BENCHMARK(Vorticity, Vorticity);
+VTKM_PRIVATE_GRADIENT_BENCHMARK(VorticityMagnitude, VorticityMagnitude);
+VTKM_PRIVATE_GRADIENT_BENCHMARK(GradientAndQCriterion, Gradient | QCriterion);
 VTKM_PRIVATE_GRADIENT_BENCHMARK(QCriterion, QCriterion);
 VTKM_PRIVATE_GRADIENT_BENCHMARK(All,
                                 Gradient | PointGradient | Divergence | Vorticity | QCriterion);
@@ -567,6 +595,85 @@ void BenchTetrahedralize(::benchmark::State& state)
 
 VTKM_BENCHMARK_OPTS(BenchTetrahedralize, ->ArgName("PartitionedInput")->DenseRange(0, 1));
 
+void BenchImageMedian(::benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::IdComponent radius = static_cast<vtkm::IdComponent>(state.range(0));
+  const bool use3D = static_cast<bool>(state.range(1));
+
+  // This filter only supports structured datasets:
+  if (FileAsInput && !InputIsStructured())
+  {
+    state.SkipWithError("ImageMedian Filter requires structured data.");
+  }
+
+  vtkm::filter::image_processing::ImageMedian filter;
+  filter.SetNeighborhoodRadius(radius);
+  filter.SetUse3DNeighborhood(use3D);
+  filter.SetActiveField(PointScalarsName, vtkm::cont::Field::Association::Points);
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    auto result = filter.Execute(GetInputDataSet());
+    ::benchmark::DoNotOptimize(result);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+}
+
+void BenchImageMedianGenerator(::benchmark::internal::Benchmark* bm)
+{
+  bm->ArgNames({ "Radius", "3D" });
+  for (int64_t radius : { 1, 2, 4, 7 })
+  {
+    bm->Args({ radius, 0 });
+  }
+  for (int64_t radius : { 1, 2, 3 })
+  {
+    bm->Args({ radius, 1 });
+  }
+}
+
+VTKM_BENCHMARK_APPLY(BenchImageMedian, BenchImageMedianGenerator);
+
+// The neighborhood worklet that ImageMedian used before it slid the neighborhood along rows.
+void BenchImageMedianNeighborhoodWorklet(::benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const int neighborhood = static_cast<int>(state.range(0));
+
+  if (FileAsInput && !InputIsStructured())
+  {
+    state.SkipWithError("ImageMedian worklet requires structured data.");
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> input;
+  vtkm::cont::ArrayCopyShallowIfPossible(
+    GetInputDataSet().GetField(PointScalarsName, vtkm::cont::Field::Association::Points).GetData(),
+    input);
+
+  vtkm::cont::Invoker invoke{ device };
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    vtkm::cont::ArrayHandle<vtkm::FloatDefault> result;
+    invoke(
+      vtkm::worklet::ImageMedian{ neighborhood }, GetInputDataSet().GetCellSet(), input, result);
+    ::benchmark::DoNotOptimize(result);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+}
+
+VTKM_BENCHMARK_OPTS(BenchImageMedianNeighborhoodWorklet, ->ArgName("Radius")->DenseRange(1, 2));
+
 void BenchVertexClustering(::benchmark::State& state)
 {
   const vtkm::cont::DeviceAdapterId device = Config.Device;
@@ -599,6 +706,148 @@ VTKM_BENCHMARK_OPTS(BenchVertexClustering,
                       ->Range(32, 1024)
                       ->ArgName("NumDivs"));
 
+void BenchProbe(::benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::Id numPoints = static_cast<vtkm::Id>(state.range(0));
+  const bool reuseFilter = static_cast<bool>(state.range(1));
+
+  // Probe the unstructured input at random points, which are not in any spatial order.
+  const vtkm::cont::DataSet& input = GetUnstructuredInputDataSet();
+  const vtkm::Bounds bounds = input.GetCoordinateSystem().GetBounds();
+  std::mt19937 rng(42);
+  std::vector<vtkm::Vec3f> points(static_cast<std::size_t>(numPoints));
+  std::vector<vtkm::Id> connectivity(points.size());
+  for (std::size_t i = 0; i < points.size(); ++i)
+  {
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      const vtkm::Range range = d == 0 ? bounds.X : (d == 1 ? bounds.Y : bounds.Z);
+      std::uniform_real_distribution<vtkm::FloatDefault> distribution(
+        static_cast<vtkm::FloatDefault>(range.Min), static_cast<vtkm::FloatDefault>(range.Max));
+      points[i][d] = distribution(rng);
+    }
+    connectivity[i] = static_cast<vtkm::Id>(i);
+  }
+  const vtkm::cont::DataSet geometry = vtkm::cont::DataSetBuilderExplicit::Create(
+    points, vtkm::CellShapeTagVertex{}, 1, connectivity);
+
+  vtkm::filter::resampling::Probe filter;
+  filter.SetGeometry(geometry);
+  filter.SetFieldsToPass({ PointScalarsName });
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    // A new filter builds a new locator, while a reused filter keeps the locator of the input.
+    vtkm::filter::resampling::Probe newFilter;
+    newFilter.SetGeometry(geometry);
+    newFilter.SetFieldsToPass({ PointScalarsName });
+
+    timer.Start();
+    auto result = reuseFilter ? filter.Execute(input) : newFilter.Execute(input);
+    ::benchmark::DoNotOptimize(result);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+}
+
+void BenchProbeGenerator(::benchmark::internal::Benchmark* bm)
+{
+  bm->ArgNames({ "NumPoints", "ReuseFilter" });
+  for (int numPoints : { 1 << 16, 1 << 20 })
+  {
+    bm->Args({ numPoints, 0 });
+    bm->Args({ numPoints, 1 });
+  }
+}
+
+VTKM_BENCHMARK_APPLY(BenchProbe, BenchProbeGenerator);
+
+// Arrays for the dispatch latency benchmark. They are tried in different positions of the
+// default type and storage lists.
+enum DispatchArray : int
+{
+  DispatchFloat32 = 0,
+  DispatchVec3fSOA = 1,
+  DispatchUniformPoints = 2,
+  DispatchInt64 = 3
+};
+
+vtkm::cont::UnknownArrayHandle MakeDispatchArray(int kind)
+{
+  switch (kind)
+  {
+    case DispatchFloat32:
+      return vtkm::cont::ArrayHandle<vtkm::Float32>{};
+    case DispatchVec3fSOA:
+      return vtkm::cont::ArrayHandleSOA<vtkm::Vec3f>{};
+    case DispatchUniformPoints:
+      return vtkm::cont::ArrayHandleUniformPointCoordinates{ vtkm::Id3{ 2 } };
+    default:
+      return vtkm::cont::ArrayHandle<vtkm::Int64>{};
+  }
+}
+
+struct DispatchFunctor
+{
+  template <typename ArrayType>
+  VTKM_CONT void operator()(const ArrayType& array, vtkm::Id& numValues) const
+  {
+    numValues += array.GetNumberOfValues();
+  }
+};
+
+// Measures the time for an UnknownArrayHandle to find the type of its array, which every
+// filter pays for each field it uses. Small partitions make this latency visible.
+void BenchDispatchLatency(::benchmark::State& state)
+{
+  constexpr vtkm::Id numCalls = 1000;
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const int kind = static_cast<int>(state.range(0));
+  const bool extract = static_cast<bool>(state.range(1));
+
+  vtkm::cont::UnknownArrayHandle array = MakeDispatchArray(kind);
+  vtkm::Id numValues = 0;
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    for (vtkm::Id call = 0; call < numCalls; ++call)
+    {
+      if (extract)
+      {
+        array.CastAndCallWithExtractedArray(DispatchFunctor{}, numValues);
+      }
+      else
+      {
+        array.CastAndCallForTypes<VTKM_DEFAULT_TYPE_LIST, VTKM_DEFAULT_STORAGE_LIST>(
+          DispatchFunctor{}, numValues);
+      }
+    }
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  ::benchmark::DoNotOptimize(numValues);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * numCalls);
+}
+
+void BenchDispatchLatencyGenerator(::benchmark::internal::Benchmark* bm)
+{
+  bm->ArgNames({ "Array", "Extract" });
+  for (int kind : { DispatchFloat32, DispatchVec3fSOA, DispatchUniformPoints, DispatchInt64 })
+  {
+    bm->Args({ kind, 0 });
+    bm->Args({ kind, 1 });
+  }
+}
+
+VTKM_BENCHMARK_APPLY(BenchDispatchLatency, BenchDispatchLatencyGenerator);
+
 // Helper for resetting the reverse connectivity table:
 struct PrepareForInput
 {
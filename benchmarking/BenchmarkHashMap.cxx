@@ -0,0 +1,249 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include "Benchmarker.h"
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/AtomicArray.h>
+#include <vtkm/cont/HashMap.h>
+#include <vtkm/cont/Initialize.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/RuntimeDeviceTracker.h>
+#include <vtkm/cont/Timer.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+// Provide access to the requested device to the benchmark functions:
+vtkm::cont::InitializeResult Config;
+
+static constexpr int64_t NUM_VALUES_MIN = 1 << 12;
+static constexpr int64_t NUM_VALUES_MAX = 1 << 24;
+
+// Generates keys with a given number of unique values, scattered so that equal keys are
+// not adjacent (as is the case with, for example, the faces of a mesh).
+struct ScatteredKey
+{
+  vtkm::Id NumUnique;
+
+  VTKM_EXEC_CONT vtkm::Id operator()(vtkm::Id index) const
+  {
+    return ((index * 2654435761) % this->NumUnique) * 3;
+  }
+};
+
+struct CountWorklet : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn key, ExecObject table, AtomicArrayInOut counts);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename KeyType, typename TableType, typename CountsType>
+  VTKM_EXEC void operator()(const KeyType& key,
+                            const TableType& table,
+                            const CountsType& counts) const
+  {
+    counts.Add(table.Insert(key), 1);
+  }
+};
+
+void MakeKeys(benchmark::State& state, vtkm::cont::ArrayHandle<vtkm::Id>& keys)
+{
+  const vtkm::Id numValues = static_cast<vtkm::Id>(state.range(0));
+  const vtkm::Id percentUnique = static_cast<vtkm::Id>(state.range(1));
+  const vtkm::Id numUnique = std::max((numValues * percentUnique) / 100, vtkm::Id{ 1 });
+
+  std::ostringstream desc;
+  desc << numValues << " keys | " << numUnique << " unique";
+  state.SetLabel(desc.str());
+
+  vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandleTransform(
+                          vtkm::cont::ArrayHandleIndex(numValues), ScatteredKey{ numUnique }),
+                        keys);
+}
+
+void SetProcessed(benchmark::State& state)
+{
+  const int64_t iterations = static_cast<int64_t>(state.iterations());
+  state.SetItemsProcessed(state.range(0) * iterations);
+  state.SetBytesProcessed(state.range(0) * static_cast<int64_t>(sizeof(vtkm::Id)) * iterations);
+}
+
+// Find the unique keys with a hash set.
+void BenchHashSetUnique(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  if (!vtkm::cont::internal::IsHashTableDevice(device))
+  {
+    state.SkipWithError("Hash tables only run on host devices.");
+    return;
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> keys;
+  MakeKeys(state, keys);
+
+  vtkm::cont::HashSet<vtkm::Id> set;
+  vtkm::cont::ArrayHandle<vtkm::Id> uniqueKeys;
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    set.Allocate(keys.GetNumberOfValues());
+    set.Insert(keys);
+    set.GetKeys(uniqueKeys);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  SetProcessed(state);
+}
+
+// Baseline for BenchHashSetUnique: find the unique keys by sorting.
+void BenchSortUnique(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+
+  vtkm::cont::ArrayHandle<vtkm::Id> keys;
+  MakeKeys(state, keys);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> uniqueKeys;
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    vtkm::cont::Algorithm::Copy(device, keys, uniqueKeys);
+    vtkm::cont::Algorithm::Sort(device, uniqueKeys);
+    vtkm::cont::Algorithm::Unique(device, uniqueKeys);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  SetProcessed(state);
+}
+
+// Count the occurrences of each key with a hash set and atomic counters.
+void BenchHashSetCount(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  if (!vtkm::cont::internal::IsHashTableDevice(device))
+  {
+    state.SkipWithError("Hash tables only run on host devices.");
+    return;
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> keys;
+  MakeKeys(state, keys);
+
+  vtkm::cont::HashSet<vtkm::Id> set;
+  vtkm::cont::ArrayHandle<vtkm::Id> counts;
+
+  vtkm::cont::Invoker invoker{ device };
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    set.Allocate(keys.GetNumberOfValues());
+    counts.AllocateAndFill(set.GetCapacity(), 0);
+    invoker(CountWorklet{}, keys, set, counts);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  SetProcessed(state);
+}
+
+// Baseline for BenchHashSetCount: count the occurrences of each key by sorting.
+void BenchSortCount(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+
+  vtkm::cont::ArrayHandle<vtkm::Id> keys;
+  MakeKeys(state, keys);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> sortedKeys;
+  vtkm::cont::ArrayHandle<vtkm::Id> uniqueKeys;
+  vtkm::cont::ArrayHandle<vtkm::Id> counts;
+
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    vtkm::cont::Algorithm::Copy(device, keys, sortedKeys);
+    vtkm::cont::Algorithm::Sort(device, sortedKeys);
+    vtkm::cont::Algorithm::ReduceByKey(
+      device,
+      sortedKeys,
+      vtkm::cont::make_ArrayHandleConstant(vtkm::Id{ 1 }, sortedKeys.GetNumberOfValues()),
+      uniqueKeys,
+      counts,
+      vtkm::Add{});
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  SetProcessed(state);
+}
+
+void HashGenerator(benchmark::internal::Benchmark* bm)
+{
+  bm->RangeMultiplier(16);
+  bm->ArgNames({ "Size", "%Unique" });
+  for (int64_t percentUnique : { 1, 25, 100 })
+  {
+    bm->Ranges({ { NUM_VALUES_MIN, NUM_VALUES_MAX }, { percentUnique, percentUnique } });
+  }
+}
+
+VTKM_BENCHMARK_APPLY(BenchHashSetUnique, HashGenerator);
+VTKM_BENCHMARK_APPLY(BenchSortUnique, HashGenerator);
+VTKM_BENCHMARK_APPLY(BenchHashSetCount, HashGenerator);
+VTKM_BENCHMARK_APPLY(BenchSortCount, HashGenerator);
+
+} // end anon namespace
+
+int main(int argc, char* argv[])
+{
+  // Parse VTK-m options:
+  auto opts = vtkm::cont::InitializeOptions::RequireDevice;
+
+  std::vector<char*> args(argv, argv + argc);
+  vtkm::bench::detail::InitializeArgs(&argc, args, opts);
+
+  // Parse VTK-m options:
+  Config = vtkm::cont::Initialize(argc, args.data(), opts);
+
+  // This occurs when it is help
+  if (opts == vtkm::cont::InitializeOptions::None)
+  {
+    std::cout << Config.Usage << std::endl;
+  }
+  else
+  {
+    vtkm::cont::GetRuntimeDeviceTracker().ForceDevice(Config.Device);
+  }
+
+  // handle benchmarking related args and run benchmarks:
+  VTKM_EXECUTE_BENCHMARKS(argc, args.data());
+}
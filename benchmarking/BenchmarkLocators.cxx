@@ -17,6 +17,7 @@
 #include <vtkm/cont/DataSet.h>
 #include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/Logging.h>
+#include <vtkm/cont/PointLocatorSparseGrid.h>
 #include <vtkm/cont/RuntimeDeviceTracker.h>
 #include <vtkm/cont/Timer.h>
 #include <vtkm/cont/internal/OptionParser.h>
@@ -342,6 +343,80 @@ void Bench2DCellLocatorUniformBinsIterate(::benchmark::State& state)
   }
 }
 
+vtkm::cont::ArrayHandle<vtkm::Vec3f> CreateRandomPoints(vtkm::Id numPoints, vtkm::Id seed)
+{
+  return CreateRandomPoints(
+    numPoints,
+    vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id3(2), vtkm::Vec3f(0), vtkm::Vec3f(1)),
+    seed);
+}
+
+// Sets up a sparse grid locator over random points in the unit cube with about 4 points per bin.
+void BuildPointLocator(vtkm::cont::PointLocatorSparseGrid& locator, vtkm::Id numPoints)
+{
+  auto bins = static_cast<vtkm::Id>(
+    vtkm::Max(1.0, vtkm::Cbrt(static_cast<vtkm::Float64>(numPoints) / 4.0)));
+  locator.SetCoordinates(vtkm::cont::CoordinateSystem("coords", CreateRandomPoints(numPoints, 0)));
+  locator.SetNumberOfBins(vtkm::Id3(bins));
+  locator.Update();
+}
+
+void BenchPointLocatorKNearest(::benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  vtkm::Id numPoints = static_cast<vtkm::Id>(state.range(0));
+  vtkm::Id numQueries = static_cast<vtkm::Id>(state.range(1));
+  vtkm::IdComponent k = static_cast<vtkm::IdComponent>(state.range(2));
+
+  vtkm::cont::PointLocatorSparseGrid locator;
+  BuildPointLocator(locator, numPoints);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> neighborIds;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> distances2;
+  vtkm::cont::Timer timer{ device };
+  vtkm::Id seed = 1;
+  for (auto _ : state)
+  {
+    (void)_;
+    auto queries = CreateRandomPoints(numQueries, seed++);
+
+    timer.Start();
+    locator.FindKNearestNeighbors(queries, k, neighborIds, distances2);
+    timer.Stop();
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(numQueries) * state.iterations());
+}
+
+void BenchPointLocatorRadius(::benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  vtkm::Id numPoints = static_cast<vtkm::Id>(state.range(0));
+  vtkm::Id numQueries = static_cast<vtkm::Id>(state.range(1));
+  vtkm::FloatDefault radius = static_cast<vtkm::FloatDefault>(state.range(2)) / 1000;
+
+  vtkm::cont::PointLocatorSparseGrid locator;
+  BuildPointLocator(locator, numPoints);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> offsets;
+  vtkm::cont::ArrayHandle<vtkm::Id> neighborIds;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> distances2;
+  vtkm::cont::Timer timer{ device };
+  vtkm::Id seed = 1;
+  for (auto _ : state)
+  {
+    (void)_;
+    auto queries = CreateRandomPoints(numQueries, seed++);
+
+    timer.Start();
+    locator.FindNeighborsInRadius(queries, radius, offsets, neighborIds, distances2);
+    timer.Stop();
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(numQueries) * state.iterations());
+  state.counters["Neighbors"] = static_cast<double>(neighborIds.GetNumberOfValues());
+}
+
 void Bench2DCellLocatorTwoLevelGenerator(::benchmark::internal::Benchmark* bm)
 {
   bm->ArgNames({ "NumPoints", "DSNx", "DSNy", "LocL1Param", "LocL2Param" });
@@ -401,6 +476,29 @@ void Bench2DCellLocatorTwoLevelIterateGenerator(::benchmark::internal::Benchmark
               }
 }
 
+void BenchPointLocatorKNearestGenerator(::benchmark::internal::Benchmark* bm)
+{
+  bm->ArgNames({ "NumPoints", "NumQueries", "K" });
+
+  for (auto np : { 100000, 1000000 })
+    for (auto k : { 1, 8, 32 })
+    {
+      bm->Args({ np, 100000, k });
+    }
+}
+
+void BenchPointLocatorRadiusGenerator(::benchmark::internal::Benchmark* bm)
+{
+  // The radius is in thousandths of the size of the point cloud.
+  bm->ArgNames({ "NumPoints", "NumQueries", "RadiusPerMille" });
+
+  for (auto np : { 100000, 1000000 })
+    for (auto r : { 10, 30 })
+    {
+      bm->Args({ np, 100000, r });
+    }
+}
+
 void Bench2DCellLocatorUniformBinsIterateGenerator(::benchmark::internal::Benchmark* bm)
 {
   bm->ArgNames({ "NumPoints", "NumIters", "DSNx", "DSNy", "LocNx", "LocNY", "LastCell" });
@@ -430,6 +528,9 @@ VTKM_BENCHMARK_APPLY(Bench2DCellLocatorTwoLevelIterate, Bench2DCellLocatorTwoLev
 VTKM_BENCHMARK_APPLY(Bench2DCellLocatorUniformBinsIterate,
                      Bench2DCellLocatorUniformBinsIterateGenerator);
 
+VTKM_BENCHMARK_APPLY(BenchPointLocatorKNearest, BenchPointLocatorKNearestGenerator);
+VTKM_BENCHMARK_APPLY(BenchPointLocatorRadius, BenchPointLocatorRadiusGenerator);
+
 } // end anon namespace
 
 int main(int argc, char* argv[])
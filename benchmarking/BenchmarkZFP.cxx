@@ -0,0 +1,207 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include "Benchmarker.h"
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/Initialize.h>
+#include <vtkm/cont/RuntimeDeviceTracker.h>
+#include <vtkm/cont/Timer.h>
+
+#include <vtkm/filter/zfp/worklet/ZFPCompressor.h>
+#include <vtkm/filter/zfp/worklet/ZFPDecompress.h>
+
+#include <vtkm/source/Wavelet.h>
+
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+// Provide access to the requested device to the benchmark functions:
+vtkm::cont::InitializeResult Config;
+
+static constexpr int64_t DIM_MIN = 32;
+static constexpr int64_t DIM_MAX = 256;
+
+// The ZFP modes compared by the benchmarks.
+enum ZFPMode
+{
+  FixedRate = 0,
+  FixedAccuracy = 1,
+  FixedPrecision = 2
+};
+
+constexpr vtkm::Float64 RATE = 8;
+constexpr vtkm::Float64 TOLERANCE = 1e-3;
+constexpr vtkm::UInt32 PRECISION = 24;
+
+void MakeInput(benchmark::State& state, vtkm::cont::ArrayHandle<vtkm::Float64>& values)
+{
+  const vtkm::Id dim = static_cast<vtkm::Id>(state.range(0));
+  vtkm::source::Wavelet source;
+  source.SetExtent({ 0 }, { dim - 1 });
+  vtkm::cont::ArrayCopy(source.Execute().GetPointField("RTData").GetData(), values);
+}
+
+std::string ModeName(vtkm::Id mode)
+{
+  switch (mode)
+  {
+    case FixedRate:
+      return "fixed rate";
+    case FixedAccuracy:
+      return "fixed accuracy";
+    default:
+      return "fixed precision";
+  }
+}
+
+// Compresses `values` in the mode selected by the second benchmark argument. The fixed rate
+// mode leaves `blockOffsets` empty.
+vtkm::cont::ArrayHandle<vtkm::Int64> Compress(benchmark::State& state,
+                                              const vtkm::cont::ArrayHandle<vtkm::Float64>& values,
+                                              vtkm::worklet::zfp::ZFPStream& stream,
+                                              vtkm::cont::ArrayHandle<vtkm::Id>& blockOffsets)
+{
+  const vtkm::Id dim = static_cast<vtkm::Id>(state.range(0));
+  const vtkm::Id3 dims(dim);
+  vtkm::worklet::ZFPCompressor compressor;
+  switch (state.range(1))
+  {
+    case FixedRate:
+      stream.SetRate(RATE, 3, vtkm::Float64());
+      return compressor.Compress(values, RATE, dims);
+    case FixedAccuracy:
+      stream.SetAccuracy(TOLERANCE);
+      break;
+    default:
+      stream.SetPrecision(PRECISION);
+      break;
+  }
+  return compressor.Compress(values, stream, dims, blockOffsets);
+}
+
+void SetProcessed(benchmark::State& state,
+                  const vtkm::cont::ArrayHandle<vtkm::Float64>& values,
+                  const vtkm::cont::ArrayHandle<vtkm::Int64>& compressed)
+{
+  const int64_t iterations = static_cast<int64_t>(state.iterations());
+  const int64_t numBytes =
+    static_cast<int64_t>(values.GetNumberOfValues()) * static_cast<int64_t>(sizeof(vtkm::Float64));
+  const int64_t compressedBytes = static_cast<int64_t>(compressed.GetNumberOfValues()) *
+    static_cast<int64_t>(sizeof(vtkm::Int64));
+  state.SetBytesProcessed(numBytes * iterations);
+  state.counters["CompressedBytes"] = static_cast<double>(compressedBytes);
+  state.counters["Ratio"] = static_cast<double>(numBytes) / static_cast<double>(compressedBytes);
+
+  std::ostringstream desc;
+  desc << state.range(0) << "^3 values | " << ModeName(state.range(1));
+  state.SetLabel(desc.str());
+}
+
+void BenchZFPCompress(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> values;
+  MakeInput(state, values);
+
+  vtkm::cont::ArrayHandle<vtkm::Int64> compressed;
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    vtkm::worklet::zfp::ZFPStream stream;
+    vtkm::cont::ArrayHandle<vtkm::Id> blockOffsets;
+    timer.Start();
+    compressed = Compress(state, values, stream, blockOffsets);
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  SetProcessed(state, values, compressed);
+}
+
+void BenchZFPDecompress(benchmark::State& state)
+{
+  const vtkm::cont::DeviceAdapterId device = Config.Device;
+  const vtkm::Id3 dims(static_cast<vtkm::Id>(state.range(0)));
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> values;
+  MakeInput(state, values);
+
+  vtkm::worklet::zfp::ZFPStream stream;
+  vtkm::cont::ArrayHandle<vtkm::Id> blockOffsets;
+  vtkm::cont::ArrayHandle<vtkm::Int64> compressed = Compress(state, values, stream, blockOffsets);
+
+  vtkm::worklet::ZFPDecompressor decompressor;
+  vtkm::cont::ArrayHandle<vtkm::Float64> decompressed;
+  vtkm::cont::Timer timer{ device };
+  for (auto _ : state)
+  {
+    (void)_;
+    timer.Start();
+    if (state.range(1) == FixedRate)
+    {
+      decompressor.Decompress(compressed, decompressed, RATE, dims);
+    }
+    else
+    {
+      decompressor.Decompress(compressed, blockOffsets, decompressed, stream, dims);
+    }
+    timer.Stop();
+
+    state.SetIterationTime(timer.GetElapsedTime());
+  }
+  SetProcessed(state, values, compressed);
+}
+
+void ZFPGenerator(benchmark::internal::Benchmark* bm)
+{
+  bm->RangeMultiplier(2);
+  bm->ArgNames({ "Dim", "Mode" });
+  for (int64_t mode : { FixedRate, FixedAccuracy, FixedPrecision })
+  {
+    bm->Ranges({ { DIM_MIN, DIM_MAX }, { mode, mode } });
+  }
+}
+
+VTKM_BENCHMARK_APPLY(BenchZFPCompress, ZFPGenerator);
+VTKM_BENCHMARK_APPLY(BenchZFPDecompress, ZFPGenerator);
+
+} // end anon namespace
+
+int main(int argc, char* argv[])
+{
+  // Parse VTK-m options:
+  auto opts = vtkm::cont::InitializeOptions::RequireDevice;
+
+  std::vector<char*> args(argv, argv + argc);
+  vtkm::bench::detail::InitializeArgs(&argc, args, opts);
+
+  // Parse VTK-m options:
+  Config = vtkm::cont::Initialize(argc, args.data(), opts);
+
+  // This occurs when it is help
+  if (opts == vtkm::cont::InitializeOptions::None)
+  {
+    std::cout << Config.Usage << std::endl;
+  }
+  else
+  {
+    vtkm::cont::GetRuntimeDeviceTracker().ForceDevice(Config.Device);
+  }
+
+  // handle benchmarking related args and run benchmarks:
+  VTKM_EXECUTE_BENCHMARKS(argc, args.data());
+}
@@ -61,6 +61,7 @@ void TestCosmoCenterFinder(const char* fileName)
   // Output MBP particleId pairs array
   vtkm::Pair<vtkm::Id, vtkm::Float32> nxnResult;
   vtkm::Pair<vtkm::Id, vtkm::Float32> mxnResult;
+  vtkm::Pair<vtkm::Id, vtkm::Float32> bhResult;
 
   const vtkm::Float32 particleMass = 1.08413e+09f;
   vtkm::worklet::CosmoTools cosmoTools;
@@ -84,6 +85,15 @@ void TestCosmoCenterFinder(const char* fileName)
                "MxN MPB = " << mxnResult.first << "  potential = " << mxnResult.second);
   }
 
+  {
+    VTKM_LOG_SCOPE(CosmoLogLevel, "Executing Barnes-Hut");
+    cosmoTools.RunMBPCenterFinderBarnesHut(
+      xLocArray, yLocArray, zLocArray, nParticles, particleMass, 0.5f, bhResult);
+
+    VTKM_LOG_S(CosmoLogLevel,
+               "Barnes-Hut MPB = " << bhResult.first << "  potential = " << bhResult.second);
+  }
+
   if (nxnResult.first == mxnResult.first)
     std::cout << "FOUND CORRECT PARTICLE " << mxnResult.first << " with potential "
               << nxnResult.second << std::endl;
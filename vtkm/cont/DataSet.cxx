@@ -31,21 +31,21 @@ VTKM_CONT void CheckFieldSize(const vtkm::cont::UnknownCellSet& cellSet,
   switch (field.GetAssociation())
   {
     case vtkm::cont::Field::Association::Points:
-      if (cellSet.GetNumberOfPoints() != field.GetData().GetNumberOfValues())
+      if (cellSet.GetNumberOfPoints() != field.GetNumberOfValues())
       {
         VTKM_LOG_S(vtkm::cont::LogLevel::Warn,
                    "The size of field `"
-                     << field.GetName() << "` (" << field.GetData().GetNumberOfValues()
+                     << field.GetName() << "` (" << field.GetNumberOfValues()
                      << " values) does not match the size of the data set structure ("
                      << cellSet.GetNumberOfPoints() << " points).");
       }
       break;
     case vtkm::cont::Field::Association::Cells:
-      if (cellSet.GetNumberOfCells() != field.GetData().GetNumberOfValues())
+      if (cellSet.GetNumberOfCells() != field.GetNumberOfValues())
       {
         VTKM_LOG_S(vtkm::cont::LogLevel::Warn,
                    "The size of field `"
-                     << field.GetName() << "` (" << field.GetData().GetNumberOfValues()
+                     << field.GetName() << "` (" << field.GetNumberOfValues()
                      << " values) does not match the size of the data set structure ("
                      << cellSet.GetNumberOfCells() << " cells).");
       }
@@ -136,7 +136,7 @@ vtkm::Id DataSet::GetNumberOfPoints() const
     const vtkm::cont::Field& field = this->Fields.GetField(fieldIdx);
     if (field.GetAssociation() == vtkm::cont::Field::Association::Points)
     {
-      return field.GetData().GetNumberOfValues();
+      return field.GetNumberOfValues();
     }
   }
 
@@ -18,12 +18,93 @@
 #include <vtkm/TypeList.h>
 
 #include <vtkm/cont/ArrayRangeCompute.h>
+#include <vtkm/cont/ErrorBadValue.h>
+
+#include <vtkm/cont/internal/MapArrayPermutation.h>
+
+#include <mutex>
 
 namespace vtkm
 {
 namespace cont
 {
 
+// The state of deferred data is shared by all the copies of a field so that the values are
+// produced only once.
+struct Field::DeferredData
+{
+  vtkm::Id NumberOfValues = 0;
+  std::function<vtkm::cont::UnknownArrayHandle()> Producer;
+
+  // Without a producer, the data are a permutation of another array. The permutation is kept
+  // so that it can be combined with another permutation.
+  vtkm::cont::UnknownArrayHandle Source;
+  vtkm::cont::ArrayHandle<vtkm::Id> Permutation;
+  vtkm::Float64 InvalidValue = 0;
+
+  std::mutex Mutex;
+  vtkm::cont::UnknownArrayHandle Result;
+  bool Materialized = false;
+
+  static std::shared_ptr<DeferredData> MakePermutation(
+    const vtkm::cont::UnknownArrayHandle& source,
+    const vtkm::cont::ArrayHandle<vtkm::Id>& permutation,
+    vtkm::Float64 invalidValue)
+  {
+    auto deferred = std::make_shared<DeferredData>();
+    deferred->NumberOfValues = permutation.GetNumberOfValues();
+    deferred->Source = source;
+    deferred->Permutation = permutation;
+    deferred->InvalidValue = invalidValue;
+    return deferred;
+  }
+
+  bool SameInvalidValue(vtkm::Float64 invalidValue) const
+  {
+    return (this->InvalidValue == invalidValue) ||
+      (vtkm::IsNan(this->InvalidValue) && vtkm::IsNan(invalidValue));
+  }
+
+  // Several threads may read the same field, so the values are produced under the mutex.
+  // Once produced, `Result` is never modified again, so a reference to it stays valid.
+  const vtkm::cont::UnknownArrayHandle& Materialize()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    if (!this->Materialized)
+    {
+      VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "Materialize deferred field data");
+      if (this->Producer)
+      {
+        this->Result = this->Producer();
+        if (this->Result.GetNumberOfValues() != this->NumberOfValues)
+        {
+          throw vtkm::cont::ErrorBadValue("Deferred field data produced " +
+                                          std::to_string(this->Result.GetNumberOfValues()) +
+                                          " values instead of " +
+                                          std::to_string(this->NumberOfValues));
+        }
+      }
+      else
+      {
+        this->Result = vtkm::cont::internal::MapArrayPermutation(
+          this->Source, this->Permutation, this->InvalidValue);
+      }
+      // Release the source data that is no longer needed.
+      this->Producer = nullptr;
+      this->Source = vtkm::cont::UnknownArrayHandle{};
+      this->Permutation = vtkm::cont::ArrayHandle<vtkm::Id>{};
+      this->Materialized = true;
+    }
+    return this->Result;
+  }
+
+  bool IsMaterialized()
+  {
+    std::lock_guard<std::mutex> lock(this->Mutex);
+    return this->Materialized;
+  }
+};
+
 /// constructors for points / whole mesh
 VTKM_CONT
 Field::Field(std::string name, Association association, const vtkm::cont::UnknownArrayHandle& data)
@@ -40,6 +121,7 @@ Field::Field(const vtkm::cont::Field& src)
   : Name(src.Name)
   , FieldAssociation(src.FieldAssociation)
   , Data(src.Data)
+  , Deferred(src.Deferred)
   , Range(src.Range)
   , ModifiedFlag(src.ModifiedFlag)
 {
@@ -50,6 +132,7 @@ Field::Field(vtkm::cont::Field&& src) noexcept
   : Name(std::move(src.Name))
   , FieldAssociation(std::move(src.FieldAssociation))
   , Data(std::move(src.Data))
+  , Deferred(std::move(src.Deferred))
   , Range(std::move(src.Range))
   , ModifiedFlag(std::move(src.ModifiedFlag))
 {
@@ -61,6 +144,7 @@ Field& Field::operator=(const vtkm::cont::Field& src)
   this->Name = src.Name;
   this->FieldAssociation = src.FieldAssociation;
   this->Data = src.Data;
+  this->Deferred = src.Deferred;
   this->Range = src.Range;
   this->ModifiedFlag = src.ModifiedFlag;
   return *this;
@@ -72,6 +156,7 @@ Field& Field::operator=(vtkm::cont::Field&& src) noexcept
   this->Name = std::move(src.Name);
   this->FieldAssociation = std::move(src.FieldAssociation);
   this->Data = std::move(src.Data);
+  this->Deferred = std::move(src.Deferred);
   this->Range = std::move(src.Range);
   this->ModifiedFlag = std::move(src.ModifiedFlag);
   return *this;
@@ -104,33 +189,104 @@ void Field::PrintSummary(std::ostream& out, bool full) const
       out << "Global ";
       break;
   }
-  this->Data.PrintSummary(out, full);
+  this->GetData().PrintSummary(out, full);
 }
 
 VTKM_CONT
 Field::~Field() {}
 
 
+VTKM_CONT vtkm::Id Field::GetNumberOfValues() const
+{
+  if (this->Deferred)
+  {
+    return this->Deferred->NumberOfValues;
+  }
+  return this->Data.GetNumberOfValues();
+}
+
 VTKM_CONT
 const vtkm::cont::UnknownArrayHandle& Field::GetData() const
 {
+  // A const field may be read by several threads, so the field itself is not modified. The
+  // deferred values are kept in the state shared by the copies of the field.
+  if (this->Deferred)
+  {
+    return this->Deferred->Materialize();
+  }
   return this->Data;
 }
 
 VTKM_CONT
 vtkm::cont::UnknownArrayHandle& Field::GetData()
 {
+  if (this->Deferred)
+  {
+    this->Data = this->Deferred->Materialize();
+    this->Deferred.reset();
+  }
   this->ModifiedFlag = true;
   return this->Data;
 }
 
+VTKM_CONT vtkm::cont::Field Field::Permute(const vtkm::cont::ArrayHandle<vtkm::Id>& permutation,
+                                           vtkm::Float64 invalidValue) const
+{
+  vtkm::cont::Field result;
+  result.Name = this->Name;
+  result.FieldAssociation = this->FieldAssociation;
+
+  std::shared_ptr<DeferredData> deferred = this->Deferred;
+  if (deferred && deferred->SameInvalidValue(invalidValue))
+  {
+    std::lock_guard<std::mutex> lock(deferred->Mutex);
+    if (!deferred->Materialized && !deferred->Producer)
+    {
+      // Compose the two permutations. An index outside of the first permutation becomes -1,
+      // which is outside of the source and so still gets the invalid value.
+      vtkm::cont::ArrayHandle<vtkm::Id> composed;
+      vtkm::cont::internal::MapArrayPermutation(deferred->Permutation, permutation, -1)
+        .AsArrayHandle(composed);
+      result.Deferred = DeferredData::MakePermutation(deferred->Source, composed, invalidValue);
+      return result;
+    }
+  }
+
+  result.Deferred = DeferredData::MakePermutation(this->GetData(), permutation, invalidValue);
+  return result;
+}
+
+VTKM_CONT void Field::SetDeferredData(vtkm::Id numberOfValues,
+                                      std::function<vtkm::cont::UnknownArrayHandle()> producer)
+{
+  auto deferred = std::make_shared<DeferredData>();
+  deferred->NumberOfValues = numberOfValues;
+  deferred->Producer = std::move(producer);
+  this->Data = vtkm::cont::UnknownArrayHandle{};
+  this->Deferred = deferred;
+  this->ModifiedFlag = true;
+}
+
+VTKM_CONT bool Field::IsDataDeferred() const
+{
+  return this->Deferred && !this->Deferred->IsMaterialized();
+}
+
+VTKM_CONT void Field::MaterializeData() const
+{
+  if (this->Deferred)
+  {
+    this->Deferred->Materialize();
+  }
+}
+
 VTKM_CONT const vtkm::cont::ArrayHandle<vtkm::Range>& Field::GetRange() const
 {
   VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "Field::GetRange");
 
   if (this->ModifiedFlag)
   {
-    this->Range = vtkm::cont::ArrayRangeCompute(this->Data);
+    this->Range = vtkm::cont::ArrayRangeCompute(this->GetData());
     this->ModifiedFlag = false;
   }
 
@@ -151,6 +307,7 @@ VTKM_CONT void Field::GetRange(vtkm::Range* range) const
 VTKM_CONT void Field::SetData(const vtkm::cont::UnknownArrayHandle& newdata)
 {
   this->Data = newdata;
+  this->Deferred.reset();
   this->ModifiedFlag = true;
 }
 
@@ -177,7 +334,7 @@ bool Field::IsSupportedType() const
   vtkm::ListForEach(
     CheckArrayType{},
     vtkm::cont::internal::ListAllArrayTypes<VTKM_DEFAULT_TYPE_LIST, VTKM_DEFAULT_STORAGE_LIST>{},
-    this->Data,
+    this->GetData(),
     found);
   return found;
 }
@@ -229,24 +386,24 @@ struct CopyToFloatArray
 
 vtkm::cont::UnknownArrayHandle Field::GetDataAsDefaultFloat() const
 {
-  if (this->Data.IsBaseComponentType<vtkm::FloatDefault>())
+  if (this->GetData().IsBaseComponentType<vtkm::FloatDefault>())
   {
     bool supportedStorage = false;
     vtkm::ListForEach(
-      CheckStorageType{}, VTKM_DEFAULT_STORAGE_LIST{}, this->Data, supportedStorage);
+      CheckStorageType{}, VTKM_DEFAULT_STORAGE_LIST{}, this->GetData(), supportedStorage);
     if (supportedStorage)
     {
       // Array is already float default and supported storage. No better conversion can be done.
-      return this->Data;
+      return this->GetData();
     }
   }
 
   VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Info,
                  "Converting field '%s' to default floating point.",
                  this->GetName().c_str());
-  vtkm::cont::UnknownArrayHandle outArray = this->Data.NewInstanceFloatBasic();
-  outArray.Allocate(this->Data.GetNumberOfValues());
-  this->Data.CastAndCallWithExtractedArray(CopyToFloatArray{}, outArray);
+  vtkm::cont::UnknownArrayHandle outArray = this->GetData().NewInstanceFloatBasic();
+  outArray.Allocate(this->GetData().GetNumberOfValues());
+  this->GetData().CastAndCallWithExtractedArray(CopyToFloatArray{}, outArray);
   return outArray;
 }
 
@@ -254,7 +411,7 @@ vtkm::cont::UnknownArrayHandle Field::GetDataWithExpectedTypes() const
 {
   if (this->IsSupportedType())
   {
-    return this->Data;
+    return this->GetData();
   }
   else
   {
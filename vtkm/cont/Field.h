@@ -12,6 +12,7 @@
 
 #include <vtkm/cont/vtkm_cont_export.h>
 
+#include <vtkm/Math.h>
 #include <vtkm/Range.h>
 #include <vtkm/Types.h>
 
@@ -19,6 +20,9 @@
 #include <vtkm/cont/CastAndCall.h>
 #include <vtkm/cont/UnknownArrayHandle.h>
 
+#include <functional>
+#include <memory>
+
 namespace vtkm
 {
 namespace cont
@@ -137,17 +141,45 @@ public:
   VTKM_CONT bool IsSupportedType() const;
 
   /// Return the number of values in the field array.
-  VTKM_CONT vtkm::Id GetNumberOfValues() const { return this->Data.GetNumberOfValues(); }
+  VTKM_CONT vtkm::Id GetNumberOfValues() const;
 
   /// Return the name of the field.
   VTKM_CONT const std::string& GetName() const { return this->Name; }
   /// Return the association of the field.
   VTKM_CONT Association GetAssociation() const { return this->FieldAssociation; }
-  /// Get the array of the data for the field.
+  /// @brief Get the array of the data for the field.
+  ///
+  /// If the data of the field are deferred (see `Permute()` and `SetDeferredData()`), the
+  /// array is created the first time this method is called. The const version can be called
+  /// from several threads at once; the array is still created only once.
   const vtkm::cont::UnknownArrayHandle& GetData() const;
-  /// Get the array of the data for the field.
+  /// @copydoc GetData
   vtkm::cont::UnknownArrayHandle& GetData();
 
+  /// @brief Returns a copy of this field with its values permuted by an index array.
+  ///
+  /// Value _i_ of the returned field is value `permutation[i]` of this field, or
+  /// `invalidValue` (converted as best as possible to the value type) if that index is
+  /// outside of the array. The values are not copied right away. They are gathered into a
+  /// new basic array the first time the data of the returned field are retrieved (for
+  /// example with `GetData()` or `GetRange()`) or when `MaterializeData()` is called. A
+  /// field that is never used is thus never copied. Copies of the returned field share the
+  /// deferred values, so they are gathered at most once.
+  ///
+  /// Permuting a field that is itself a deferred permutation combines the two index arrays,
+  /// so chains of permutations also copy the values at most once.
+  VTKM_CONT vtkm::cont::Field Permute(
+    const vtkm::cont::ArrayHandle<vtkm::Id>& permutation,
+    vtkm::Float64 invalidValue = vtkm::Nan<vtkm::Float64>()) const;
+
+  /// Returns true if the data of the field are deferred and their array has not yet been
+  /// created. See `Permute()` and `SetDeferredData()`.
+  VTKM_CONT bool IsDataDeferred() const;
+
+  /// Creates the array of deferred data. Does nothing if the data of the field are not
+  /// deferred. See `Permute()` and `SetDeferredData()`.
+  VTKM_CONT void MaterializeData() const;
+
   /// @brief Returns the range of each component in the field array.
   ///
   /// The ranges of each component are returned in an `ArrayHandle` containing `vtkm::Range`
@@ -223,6 +255,16 @@ public:
     this->SetData(vtkm::cont::UnknownArrayHandle(newdata));
   }
 
+  /// @brief Sets the data of the field to an array that is created on demand.
+  ///
+  /// `producer` is called to create the array the first time the data of the field are
+  /// retrieved (for example with `GetData()` or `GetRange()`) or when `MaterializeData()` is
+  /// called. It must return an array with `numberOfValues` values, which is what
+  /// `GetNumberOfValues()` returns in the meantime. Copies of the field share the created
+  /// array, so `producer` is called at most once.
+  VTKM_CONT void SetDeferredData(vtkm::Id numberOfValues,
+                                 std::function<vtkm::cont::UnknownArrayHandle()> producer);
+
   /// Print a summary of the data in the field.
   VTKM_CONT
   virtual void PrintSummary(std::ostream& out, bool full = false) const;
@@ -236,10 +278,13 @@ public:
   }
 
 private:
+  struct DeferredData;
+
   std::string Name; ///< name of field
 
   Association FieldAssociation = Association::Any;
   vtkm::cont::UnknownArrayHandle Data;
+  std::shared_ptr<DeferredData> Deferred;
   mutable vtkm::cont::ArrayHandle<vtkm::Range> Range;
   mutable bool ModifiedFlag = true;
 };
@@ -0,0 +1,390 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_HashMap_h
+#define vtk_m_cont_HashMap_h
+
+#include <vtkm/BinaryOperators.h>
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/ErrorBadAllocation.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/ExecutionObjectBase.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/RuntimeDeviceTracker.h>
+#include <vtkm/exec/HashMap.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace vtkm
+{
+namespace cont
+{
+
+namespace internal
+{
+
+struct HashSetInsertWorklet : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn key, ExecObject table, FieldOut slot);
+  using ExecutionSignature = _3(_1, _2);
+
+  template <typename KeyType, typename TableType>
+  VTKM_EXEC vtkm::Id operator()(const KeyType& key, const TableType& table) const
+  {
+    return table.Insert(key);
+  }
+};
+
+struct HashMapInsertWorklet : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn key, FieldIn value, ExecObject table, FieldOut slot);
+  using ExecutionSignature = _4(_1, _2, _3);
+
+  template <typename KeyType, typename ValueType, typename TableType>
+  VTKM_EXEC vtkm::Id operator()(const KeyType& key,
+                                const ValueType& value,
+                                const TableType& table) const
+  {
+    return table.Insert(key, value);
+  }
+};
+
+struct HashSetFindWorklet : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn key, ExecObject table, FieldOut slot);
+  using ExecutionSignature = _3(_1, _2);
+
+  template <typename KeyType, typename TableType>
+  VTKM_EXEC vtkm::Id operator()(const KeyType& key, const TableType& table) const
+  {
+    return table.Find(key);
+  }
+};
+
+template <typename ValueType>
+struct HashMapLookupWorklet : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn key, ExecObject table, FieldOut value);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  VTKM_CONT explicit HashMapLookupWorklet(const ValueType& notFoundValue)
+    : NotFoundValue(notFoundValue)
+  {
+  }
+
+  template <typename KeyType, typename TableType>
+  VTKM_EXEC void operator()(const KeyType& key, const TableType& table, ValueType& value) const
+  {
+    if (!table.Lookup(key, value))
+    {
+      value = this->NotFoundValue;
+    }
+  }
+
+  ValueType NotFoundValue;
+};
+
+struct HashSlotIsOccupied
+{
+  VTKM_EXEC_CONT bool operator()(vtkm::UInt32 state) const
+  {
+    return state == static_cast<vtkm::UInt32>(vtkm::exec::internal::HashSlotState::Occupied);
+  }
+};
+
+struct HashSlotCountOccupied
+{
+  VTKM_EXEC_CONT vtkm::Id operator()(vtkm::UInt32 state) const
+  {
+    return HashSlotIsOccupied{}(state) ? 1 : 0;
+  }
+};
+
+/// A thread that probes a slot that another thread has reserved but not yet published waits
+/// for the slot. Threads that do not make independent progress, such as the threads of a GPU
+/// warp, can wait forever, so hash tables only run on host devices.
+VTKM_CONT inline bool IsHashTableDevice(vtkm::cont::DeviceAdapterId device)
+{
+#if defined(VTKM_KOKKOS_CUDA) || defined(VTKM_KOKKOS_HIP)
+  if (device.GetValue() == VTKM_DEVICE_ADAPTER_KOKKOS)
+  {
+    return false;
+  }
+#endif
+  return device.GetValue() != VTKM_DEVICE_ADAPTER_CUDA;
+}
+
+VTKM_CONT inline void CheckHashTableDevice(vtkm::cont::DeviceAdapterId device)
+{
+  if (!IsHashTableDevice(device))
+  {
+    throw vtkm::cont::ErrorBadValue("Hash tables cannot be used on device " + device.GetName() +
+                                    ". Only host devices are supported.");
+  }
+}
+
+/// Disables the devices that hash tables do not support for the life of the object, so that
+/// the bulk operations of the tables run on a host device.
+class HashTableDeviceScope
+{
+public:
+  VTKM_CONT HashTableDeviceScope()
+    : Scope(vtkm::cont::GetRuntimeDeviceTracker())
+  {
+    for (vtkm::Int8 id = 1; id < VTKM_MAX_DEVICE_ADAPTER_ID; ++id)
+    {
+      vtkm::cont::DeviceAdapterId device = vtkm::cont::make_DeviceAdapterId(id);
+      if (!IsHashTableDevice(device))
+      {
+        this->Scope.DisableDevice(device);
+      }
+    }
+  }
+
+private:
+  vtkm::cont::ScopedRuntimeDeviceTracker Scope;
+};
+
+} // namespace internal
+
+/// \brief A fixed-capacity hash set that can be built and queried in parallel.
+///
+/// `HashSet` stores unique keys in an open-addressing table backed by `ArrayHandle`s.
+/// The table can be filled and queried in bulk with the `Insert` and `Find` methods or
+/// it can be passed to a worklet as an `ExecObject`, in which case the worklet receives
+/// a `vtkm::exec::HashSet` that supports lock-free insertion and lookup.
+///
+/// Each key is assigned a slot in the range [0, `GetCapacity()`). Slots do not move once
+/// assigned, so they can be used to index auxiliary arrays. This allows, for example,
+/// counting the occurrences of each key with an `AtomicArray` in O(n) rather than
+/// sorting all of the keys.
+///
+/// The capacity is fixed when the table is allocated. Insertions that do not fit cause
+/// an `ErrorBadAllocation` when using the bulk methods.
+///
+/// The key type must be an integer or a `vtkm::Vec` of integers.
+///
+/// Hash tables only run on host devices (serial, TBB, OpenMP, and Kokkos without a GPU
+/// backend). The bulk methods skip other devices, and passing the table to a worklet
+/// that runs on a GPU throws an `ErrorBadValue`.
+///
+template <typename KeyType>
+class HashSet : public vtkm::cont::ExecutionObjectBase
+{
+public:
+  using ExecObjectType = vtkm::exec::HashSet<KeyType>;
+
+  VTKM_CONT HashSet() = default;
+
+  /// Creates a table able to hold `numberOfKeys` keys. See `Allocate`.
+  VTKM_CONT explicit HashSet(vtkm::Id numberOfKeys) { this->Allocate(numberOfKeys); }
+
+  /// \brief Allocates an empty table able to hold `numberOfKeys` keys.
+  ///
+  /// The number of slots is the smallest power of 2 that keeps the table no more than
+  /// half full, which keeps probe sequences short. Any previous contents are lost.
+  VTKM_CONT void Allocate(vtkm::Id numberOfKeys)
+  {
+    if (numberOfKeys < 0)
+    {
+      throw vtkm::cont::ErrorBadValue("Cannot allocate a hash table with negative size.");
+    }
+    vtkm::Id capacity = 1;
+    while (capacity < 2 * numberOfKeys)
+    {
+      capacity *= 2;
+    }
+    this->Keys.Allocate(capacity);
+    this->States.AllocateAndFill(
+      capacity, static_cast<vtkm::UInt32>(vtkm::exec::internal::HashSlotState::Empty));
+  }
+
+  /// Removes all keys from the table without changing its capacity.
+  VTKM_CONT void Clear()
+  {
+    this->States.Fill(static_cast<vtkm::UInt32>(vtkm::exec::internal::HashSlotState::Empty));
+  }
+
+  /// Returns the number of slots in the table.
+  VTKM_CONT vtkm::Id GetCapacity() const { return this->Keys.GetNumberOfValues(); }
+
+  /// Returns the number of keys stored in the table.
+  VTKM_CONT vtkm::Id GetNumberOfKeys() const
+  {
+    return vtkm::cont::Algorithm::Reduce(
+      vtkm::cont::make_ArrayHandleTransform(this->States, internal::HashSlotCountOccupied{}),
+      vtkm::Id(0));
+  }
+
+  /// Inserts all of the given keys in parallel.
+  template <typename KeyStorage>
+  VTKM_CONT void Insert(const vtkm::cont::ArrayHandle<KeyType, KeyStorage>& keys)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> slots;
+    this->InsertWithSlots(keys, slots);
+  }
+
+  /// Inserts all of the given keys in parallel and fills `slots` with the slot of each
+  /// key. Duplicate keys are given the same slot.
+  template <typename KeyStorage>
+  VTKM_CONT void InsertWithSlots(const vtkm::cont::ArrayHandle<KeyType, KeyStorage>& keys,
+                                 vtkm::cont::ArrayHandle<vtkm::Id>& slots)
+  {
+    internal::HashTableDeviceScope deviceScope;
+    vtkm::cont::Invoker invoke;
+    invoke(internal::HashSetInsertWorklet{}, keys, *this, slots);
+    this->CheckSlots(slots);
+  }
+
+  /// Finds the slot of each of the given keys. Keys not in the table get a slot of -1.
+  template <typename KeyStorage>
+  VTKM_CONT void Find(const vtkm::cont::ArrayHandle<KeyType, KeyStorage>& keys,
+                      vtkm::cont::ArrayHandle<vtkm::Id>& slots) const
+  {
+    internal::HashTableDeviceScope deviceScope;
+    vtkm::cont::Invoker invoke;
+    invoke(internal::HashSetFindWorklet{}, keys, *this, slots);
+  }
+
+  /// Copies the keys stored in the table to a compact array. The order of the keys is
+  /// the order of their slots, which is arbitrary.
+  VTKM_CONT void GetKeys(vtkm::cont::ArrayHandle<KeyType>& keys) const
+  {
+    vtkm::cont::Algorithm::CopyIf(this->Keys, this->States, keys, internal::HashSlotIsOccupied{});
+  }
+
+  /// The raw table of keys, indexed by slot. Only slots marked occupied in
+  /// `GetSlotStates` hold valid keys.
+  VTKM_CONT const vtkm::cont::ArrayHandle<KeyType>& GetSlotKeys() const { return this->Keys; }
+
+  /// The state of each slot. See `vtkm::exec::internal::HashSlotState`.
+  VTKM_CONT const vtkm::cont::ArrayHandle<vtkm::UInt32>& GetSlotStates() const
+  {
+    return this->States;
+  }
+
+  VTKM_CONT ExecObjectType PrepareForExecution(vtkm::cont::DeviceAdapterId device,
+                                               vtkm::cont::Token& token) const
+  {
+    internal::CheckHashTableDevice(device);
+    return ExecObjectType(this->Keys, this->States, device, token);
+  }
+
+protected:
+  VTKM_CONT void CheckSlots(const vtkm::cont::ArrayHandle<vtkm::Id>& slots) const
+  {
+    if ((slots.GetNumberOfValues() > 0) &&
+        (vtkm::cont::Algorithm::Reduce(slots, vtkm::Id(0), vtkm::Minimum{}) < 0))
+    {
+      throw vtkm::cont::ErrorBadAllocation("Hash table capacity exceeded.");
+    }
+  }
+
+  vtkm::cont::ArrayHandle<KeyType> Keys;
+  vtkm::cont::ArrayHandle<vtkm::UInt32> States;
+};
+
+/// \brief A fixed-capacity hash map that can be built and queried in parallel.
+///
+/// `HashMap` extends `HashSet` with a value stored for each key. When the same key is
+/// inserted more than once, the value of whichever insertion claimed the slot is kept.
+/// When passed to a worklet as an `ExecObject`, the worklet receives a
+/// `vtkm::exec::HashMap`. The `Insert` methods of `HashSet`, which insert keys without
+/// values, are hidden.
+///
+template <typename KeyType, typename ValueType>
+class HashMap : public vtkm::cont::HashSet<KeyType>
+{
+  using Superclass = vtkm::cont::HashSet<KeyType>;
+
+public:
+  using ExecObjectType = vtkm::exec::HashMap<KeyType, ValueType>;
+
+  VTKM_CONT HashMap() = default;
+
+  /// Creates a table able to hold `numberOfKeys` key/value pairs. See `Allocate`.
+  VTKM_CONT explicit HashMap(vtkm::Id numberOfKeys) { this->Allocate(numberOfKeys); }
+
+  /// \brief Allocates an empty table able to hold `numberOfKeys` key/value pairs.
+  ///
+  /// Any previous contents are lost.
+  VTKM_CONT void Allocate(vtkm::Id numberOfKeys)
+  {
+    this->Superclass::Allocate(numberOfKeys);
+    this->Values.Allocate(this->GetCapacity());
+  }
+
+  /// Inserts all of the given key/value pairs in parallel.
+  template <typename KeyStorage, typename ValueStorage>
+  VTKM_CONT void Insert(const vtkm::cont::ArrayHandle<KeyType, KeyStorage>& keys,
+                        const vtkm::cont::ArrayHandle<ValueType, ValueStorage>& values)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> slots;
+    this->InsertWithSlots(keys, values, slots);
+  }
+
+  /// Inserts all of the given key/value pairs in parallel and fills `slots` with the slot
+  /// of each key.
+  template <typename KeyStorage, typename ValueStorage>
+  VTKM_CONT void InsertWithSlots(const vtkm::cont::ArrayHandle<KeyType, KeyStorage>& keys,
+                                 const vtkm::cont::ArrayHandle<ValueType, ValueStorage>& values,
+                                 vtkm::cont::ArrayHandle<vtkm::Id>& slots)
+  {
+    if (keys.GetNumberOfValues() != values.GetNumberOfValues())
+    {
+      throw vtkm::cont::ErrorBadValue("Number of keys and values given to HashMap differ.");
+    }
+    internal::HashTableDeviceScope deviceScope;
+    vtkm::cont::Invoker invoke;
+    invoke(internal::HashMapInsertWorklet{}, keys, values, *this, slots);
+    this->CheckSlots(slots);
+  }
+
+  /// Gets the value of each of the given keys. Keys not in the map get `notFoundValue`.
+  template <typename KeyStorage>
+  VTKM_CONT void Lookup(const vtkm::cont::ArrayHandle<KeyType, KeyStorage>& keys,
+                        vtkm::cont::ArrayHandle<ValueType>& values,
+                        const ValueType& notFoundValue = ValueType{}) const
+  {
+    internal::HashTableDeviceScope deviceScope;
+    vtkm::cont::Invoker invoke;
+    invoke(internal::HashMapLookupWorklet<ValueType>{ notFoundValue }, keys, *this, values);
+  }
+
+  /// Copies the key/value pairs stored in the map to compact arrays.
+  VTKM_CONT void GetEntries(vtkm::cont::ArrayHandle<KeyType>& keys,
+                            vtkm::cont::ArrayHandle<ValueType>& values) const
+  {
+    this->GetKeys(keys);
+    vtkm::cont::Algorithm::CopyIf(
+      this->Values, this->States, values, internal::HashSlotIsOccupied{});
+  }
+
+  /// The raw table of values, indexed by slot.
+  VTKM_CONT const vtkm::cont::ArrayHandle<ValueType>& GetSlotValues() const
+  {
+    return this->Values;
+  }
+
+  VTKM_CONT ExecObjectType PrepareForExecution(vtkm::cont::DeviceAdapterId device,
+                                               vtkm::cont::Token& token) const
+  {
+    internal::CheckHashTableDevice(device);
+    return ExecObjectType(this->Keys, this->Values, this->States, device, token);
+  }
+
+private:
+  vtkm::cont::ArrayHandle<ValueType> Values;
+};
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_HashMap_h
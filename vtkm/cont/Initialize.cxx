@@ -12,6 +12,7 @@
 
 #include <vtkm/cont/Logging.h>
 #include <vtkm/cont/RuntimeDeviceTracker.h>
+#include <vtkm/cont/ThreadPool.h>
 #include <vtkm/cont/internal/OptionParser.h>
 #include <vtkm/cont/internal/OptionParserArguments.h>
 
@@ -177,6 +178,13 @@ InitializeResult Initialize(int& argc, char* argv[], InitializeOptions opts)
                       loggingFlagName.c_str(),
                       opt::VtkmArg::Required,
                       loggingHelp.c_str() });
+    usage.push_back({ opt::OptionIndex::THREAD_POOL_SIZE,
+                      0,
+                      "",
+                      "vtkm-thread-pool-size",
+                      opt::VtkmArg::Required,
+                      "  --vtkm-thread-pool-size <#> \tLimit the number of threads used to run "
+                      "independent tasks, such as the partitions of a data set." });
 
     // Bring in extra args used by the runtime device configuration options
     vtkm::cont::internal::RuntimeDeviceConfigurationOptions runtimeDeviceOptions(usage);
@@ -256,6 +264,32 @@ InitializeResult Initialize(int& argc, char* argv[], InitializeOptions opts)
         }
       }
     }
+
+    // Check for the thread pool size on the command line or in an environment variable.
+    {
+      const char* poolSizeArg = nullptr;
+      if (options[opt::OptionIndex::THREAD_POOL_SIZE])
+      {
+        poolSizeArg = options[opt::OptionIndex::THREAD_POOL_SIZE].arg;
+      }
+      else
+      {
+        poolSizeArg = std::getenv("VTKM_THREAD_POOL_SIZE");
+      }
+      if (poolSizeArg != nullptr)
+      {
+        try
+        {
+          vtkm::cont::GetThreadPool().SetMaximumNumberOfThreads(
+            static_cast<vtkm::Id>(std::stoll(poolSizeArg)));
+        }
+        catch (std::exception&)
+        {
+          VTKM_LOG_S(vtkm::cont::LogLevel::Error,
+                     "Invalid thread pool size `" << poolSizeArg << "`. Ignoring.");
+        }
+      }
+    }
     // If still not defined, check to see if "any" device should be added.
     if ((config.Device == vtkm::cont::DeviceAdapterTagUndefined{}) &&
         (opts & InitializeOptions::DefaultAnyDevice) != InitializeOptions::None)
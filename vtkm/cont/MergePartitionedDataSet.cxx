@@ -269,6 +269,31 @@ vtkm::Id GetFirstEmptyPartition(const vtkm::cont::PartitionedDataSet& partitione
   return firstNonEmptyPartitionId;
 }
 
+// Returns the cell set of the only non-empty partition if it already has a type produced by the
+// merge, so it can be used as is. Otherwise returns an invalid cell set.
+vtkm::cont::UnknownCellSet GetOnlyUnstructuredCellSet(
+  const vtkm::cont::PartitionedDataSet& partitionedDataSet,
+  const vtkm::Id firstNonEmptyPartitionId)
+{
+  vtkm::Id numOfDataSet = partitionedDataSet.GetNumberOfPartitions();
+  for (vtkm::Id partitionIndex = firstNonEmptyPartitionId + 1; partitionIndex < numOfDataSet;
+       partitionIndex++)
+  {
+    if (partitionedDataSet.GetPartition(partitionIndex).GetNumberOfPoints() != 0)
+    {
+      return vtkm::cont::UnknownCellSet{};
+    }
+  }
+  vtkm::cont::UnknownCellSet cellSet =
+    partitionedDataSet.GetPartition(firstNonEmptyPartitionId).GetCellSet();
+  if (cellSet.IsType<vtkm::cont::CellSetSingleType<>>() ||
+      cellSet.IsType<vtkm::cont::CellSetExplicit<>>())
+  {
+    return cellSet;
+  }
+  return vtkm::cont::UnknownCellSet{};
+}
+
 bool PartitionsAreSingleType(const vtkm::cont::PartitionedDataSet partitionedDataSet,
                              const vtkm::Id firstNonEmptyPartitionId)
 {
@@ -346,12 +371,73 @@ void CheckCoordsNames(const vtkm::cont::PartitionedDataSet partitionedDataSet,
 }
 
 
+// Concatenates the arrays of a field over the non-empty partitions. Partitions that do not
+// have the field are filled with the invalid value.
+vtkm::cont::UnknownArrayHandle MergeFieldArrays(const std::vector<vtkm::cont::Field>& fields,
+                                                const std::vector<bool>& hasField,
+                                                const std::vector<vtkm::Id>& sizes,
+                                                vtkm::Id numValues,
+                                                vtkm::Float64 invalidValue,
+                                                bool shareArrays)
+{
+  std::size_t firstField = 0;
+  while (!hasField[firstField])
+  {
+    ++firstField;
+  }
+  const vtkm::cont::UnknownArrayHandle& firstArray = fields[firstField].GetData();
+  if (shareArrays && (fields.size() == 1) &&
+      firstArray.IsStorageType<vtkm::cont::StorageTagBasic>())
+  {
+    // Only one partition, so the merged field is the same array.
+    return firstArray;
+  }
+
+  vtkm::cont::UnknownArrayHandle mergedFieldArray = firstArray.NewInstanceBasic();
+  mergedFieldArray.Allocate(numValues);
+  //Merging each field into the mergedField array
+  auto resolveType = [&](auto& concreteOut) {
+    vtkm::Id offset = 0;
+    for (std::size_t index = 0; index < fields.size(); ++index)
+    {
+      vtkm::Id copySize = sizes[index];
+      if (hasField[index])
+      {
+        vtkm::cont::UnknownArrayHandle in = fields[index].GetData();
+        VTKM_ASSERT(in.GetNumberOfValues() == copySize);
+        auto viewOut = vtkm::cont::make_ArrayHandleView(concreteOut, offset, copySize);
+        vtkm::cont::ArrayCopy(in, viewOut);
+      }
+      else
+      {
+        //Creating invalid values for the partition that does not have the field
+        using ComponentType =
+          typename std::decay_t<decltype(concreteOut)>::ValueType::ComponentType;
+        ComponentType castInvalid =
+          vtkm::cont::internal::CastInvalidValue<ComponentType>(invalidValue);
+        for (vtkm::IdComponent component = 0; component < concreteOut.GetNumberOfComponents();
+             ++component)
+        {
+          //Extracting each component from RecombineVec and copy invalid value into it
+          //Avoid using invoke to call worklet on ArrayHandleRecombineVec (it may cause long compiling issue on CUDA 12.x).
+          concreteOut.GetComponentArray(component).Fill(castInvalid, offset, offset + copySize);
+        }
+      }
+      offset += copySize;
+    }
+    VTKM_ASSERT(offset == numValues);
+  };
+  mergedFieldArray.CastAndCallWithExtractedArray(resolveType);
+  return mergedFieldArray;
+}
+
 void MergeFieldsAndAddIntoDataSet(vtkm::cont::DataSet& outputDataSet,
                                   const vtkm::cont::PartitionedDataSet partitionedDataSet,
                                   const vtkm::Id numPoints,
                                   const vtkm::Id numCells,
                                   const vtkm::Float64 invalidValue,
-                                  const vtkm::Id firstNonEmptyPartitionId)
+                                  const vtkm::Id firstNonEmptyPartitionId,
+                                  bool deferFields)
 {
   // Merging selected fields and coordinates
   // We get fields names in all partitions firstly
@@ -405,70 +491,56 @@ void MergeFieldsAndAddIntoDataSet(vtkm::cont::DataSet& outputDataSet,
          ++fieldNameIter)
     {
       std::string fieldName = fieldNameIter->first;
-      vtkm::Id partitionOwnsField = fieldNameIter->second;
-      const vtkm::cont::Field& field =
-        partitionedDataSet.GetPartition(partitionOwnsField).GetField(fieldName, fieldAssociation);
 
-      vtkm::cont::UnknownArrayHandle mergedFieldArray = field.GetData().NewInstanceBasic();
-      if (fieldAssociation == vtkm::cont::Field::Association::Points)
+      // Collect the field of each non-empty partition. The fields are copies that share the
+      // arrays, so this is cheap even when the merge itself is deferred.
+      std::vector<vtkm::cont::Field> partitionFields;
+      std::vector<bool> partitionHasField;
+      std::vector<vtkm::Id> partitionSizes;
+      for (vtkm::Id partitionIndex = firstNonEmptyPartitionId; partitionIndex < numOfDataSet;
+           ++partitionIndex)
       {
-        mergedFieldArray.Allocate(numPoints);
+        const vtkm::cont::DataSet& partition = partitionedDataSet.GetPartition(partitionIndex);
+        if (partition.GetNumberOfPoints() == 0)
+        {
+          continue;
+        }
+        bool hasField = partition.HasField(fieldName, fieldAssociation);
+        partitionFields.push_back(hasField ? partition.GetField(fieldName, fieldAssociation)
+                                           : vtkm::cont::Field{});
+        partitionHasField.push_back(hasField);
+        if (fieldAssociation == vtkm::cont::Field::Association::Points)
+        {
+          partitionSizes.push_back(partition.GetNumberOfPoints());
+        }
+        else
+        {
+          //We may add a new association (such as edges or faces) in future
+          VTKM_ASSERT(fieldAssociation == vtkm::cont::Field::Association::Cells);
+          partitionSizes.push_back(partition.GetNumberOfCells());
+        }
+      }
+      vtkm::Id numValues =
+        (fieldAssociation == vtkm::cont::Field::Association::Points) ? numPoints : numCells;
+
+      auto mergeArrays = [=]() {
+        return MergeFieldArrays(partitionFields,
+                                partitionHasField,
+                                partitionSizes,
+                                numValues,
+                                invalidValue,
+                                deferFields);
+      };
+      vtkm::cont::Field mergedField(fieldName, fieldAssociation, vtkm::cont::UnknownArrayHandle{});
+      if (deferFields)
+      {
+        mergedField.SetDeferredData(numValues, mergeArrays);
       }
       else
       {
-        //We may add a new association (such as edges or faces) in future
-        VTKM_ASSERT(fieldAssociation == vtkm::cont::Field::Association::Cells);
-        mergedFieldArray.Allocate(numCells);
+        mergedField.SetData(mergeArrays());
       }
-      //Merging each field into the mergedField array
-      auto resolveType = [&](auto& concreteOut) {
-        vtkm::Id offset = 0;
-        for (vtkm::Id partitionIndex = firstNonEmptyPartitionId; partitionIndex < numOfDataSet;
-             ++partitionIndex)
-        {
-          if (partitionedDataSet.GetPartition(partitionIndex).GetNumberOfPoints() == 0)
-          {
-            continue;
-          }
-          if (partitionedDataSet.GetPartition(partitionIndex).HasField(fieldName, fieldAssociation))
-          {
-            vtkm::cont::UnknownArrayHandle in = partitionedDataSet.GetPartition(partitionIndex)
-                                                  .GetField(fieldName, fieldAssociation)
-                                                  .GetData();
-            vtkm::Id copySize = in.GetNumberOfValues();
-            auto viewOut = vtkm::cont::make_ArrayHandleView(concreteOut, offset, copySize);
-            vtkm::cont::ArrayCopy(in, viewOut);
-            offset += copySize;
-          }
-          else
-          {
-            //Creating invalid values for the partition that does not have the field
-            using ComponentType =
-              typename std::decay_t<decltype(concreteOut)>::ValueType::ComponentType;
-            ComponentType castInvalid =
-              vtkm::cont::internal::CastInvalidValue<ComponentType>(invalidValue);
-            vtkm::Id copySize = 0;
-            if (fieldAssociation == vtkm::cont::Field::Association::Points)
-            {
-              copySize = partitionedDataSet.GetPartition(partitionIndex).GetNumberOfPoints();
-            }
-            else
-            {
-              copySize = partitionedDataSet.GetPartition(partitionIndex).GetNumberOfCells();
-            }
-            for (vtkm::IdComponent component = 0; component < concreteOut.GetNumberOfComponents();
-                 ++component)
-            {
-              //Extracting each component from RecombineVec and copy invalid value into it
-              //Avoid using invoke to call worklet on ArrayHandleRecombineVec (it may cause long compiling issue on CUDA 12.x).
-              concreteOut.GetComponentArray(component).Fill(castInvalid, offset, offset + copySize);
-            }
-            offset += copySize;
-          }
-        }
-      };
-      mergedFieldArray.CastAndCallWithExtractedArray(resolveType);
-      outputDataSet.AddField(vtkm::cont::Field(fieldName, fieldAssociation, mergedFieldArray));
+      outputDataSet.AddField(mergedField);
     }
   }
   return;
@@ -487,6 +559,15 @@ VTKM_CONT
 vtkm::cont::DataSet MergePartitionedDataSet(
   const vtkm::cont::PartitionedDataSet& partitionedDataSet,
   vtkm::Float64 invalidValue)
+{
+  return vtkm::cont::MergePartitionedDataSet(partitionedDataSet, invalidValue, false);
+}
+
+VTKM_CONT
+vtkm::cont::DataSet MergePartitionedDataSet(
+  const vtkm::cont::PartitionedDataSet& partitionedDataSet,
+  vtkm::Float64 invalidValue,
+  bool deferFields)
 {
   vtkm::cont::DataSet outputData;
   //The name of coordinates system in the first non-empty partition will be used in merged data set
@@ -508,7 +589,15 @@ vtkm::cont::DataSet MergePartitionedDataSet(
   vtkm::Id numCellsTotal;
   CountPointsAndCells(partitionedDataSet, numPointsTotal, numCellsTotal);
 
-  if (allPartitionsAreSingleType)
+  // A deferred merge references the partitions anyway, so it may share the cell set too.
+  vtkm::cont::UnknownCellSet singleCellSet = deferFields
+    ? GetOnlyUnstructuredCellSet(partitionedDataSet, firstNonEmptyPartitionId)
+    : vtkm::cont::UnknownCellSet{};
+  if (singleCellSet.IsValid())
+  {
+    outputData.SetCellSet(singleCellSet);
+  }
+  else if (allPartitionsAreSingleType)
   {
     outputData.SetCellSet(MergeCellSetsSingleType(partitionedDataSet, firstNonEmptyPartitionId));
   }
@@ -523,7 +612,8 @@ vtkm::cont::DataSet MergePartitionedDataSet(
                                numPointsTotal,
                                numCellsTotal,
                                invalidValue,
-                               firstNonEmptyPartitionId);
+                               firstNonEmptyPartitionId,
+                               deferFields);
   //Labeling fields that belong to the coordinate system.
   //There might be multiple coordinates systems, assuming all partitions have the same name of the coordinates system
   vtkm::IdComponent numCoordsNames =
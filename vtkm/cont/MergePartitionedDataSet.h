@@ -32,6 +32,23 @@ vtkm::cont::DataSet MergePartitionedDataSet(
   const vtkm::cont::PartitionedDataSet& partitionedDataSet,
   vtkm::Float64 invalidValue = vtkm::Nan64());
 
+/// When `deferFields` is true, the fields are not merged when this function is called. Each
+/// field of the merged data set is concatenated the first time its data are retrieved (see
+/// `vtkm::cont::Field::SetDeferredData()`), so the fields that are never used are never copied.
+/// Until then the merged data set references the arrays of the partitions, and if there is
+/// only one non-empty partition, its explicit cell set and its basic field arrays are shared
+/// with the merged data set instead of being copied. Modifying the partitions afterward thus
+/// changes the merged data set.
+///
+/// The cell set is always merged immediately, so deferring the fields saves the copies of the
+/// field data but the merge still takes time proportional to the number of cells.
+VTKM_CONT_EXPORT
+VTKM_CONT
+vtkm::cont::DataSet MergePartitionedDataSet(
+  const vtkm::cont::PartitionedDataSet& partitionedDataSet,
+  vtkm::Float64 invalidValue,
+  bool deferFields);
+
 //@}
 }
 }
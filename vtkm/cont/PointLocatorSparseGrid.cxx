@@ -21,7 +21,10 @@
 
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleGroupVecVariable.h>
 #include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ConvertNumComponentsToOffsets.h>
+#include <vtkm/cont/ErrorBadValue.h>
 #include <vtkm/cont/Invoker.h>
 #include <vtkm/worklet/WorkletMapField.h>
 
@@ -63,6 +66,112 @@ private:
   vtkm::Vec3f Dxdydz;
 };
 
+template <vtkm::IdComponent MaxK>
+class KNearestNeighborsWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn queryPoint,
+                                ExecObject locator,
+                                WholeArrayOut neighborIds,
+                                WholeArrayOut distances2);
+
+  using ExecutionSignature = void(_1, _2, _3, _4, WorkIndex);
+
+  VTKM_CONT
+  explicit KNearestNeighborsWorklet(vtkm::IdComponent k)
+    : K(k)
+  {
+  }
+
+  template <typename Locator, typename IdPortalType, typename DistancePortalType>
+  VTKM_EXEC void operator()(const vtkm::Vec3f& queryPoint,
+                            const Locator& locator,
+                            const IdPortalType& neighborIds,
+                            const DistancePortalType& distances2,
+                            vtkm::Id index) const
+  {
+    vtkm::Vec<vtkm::Id, MaxK> ids;
+    vtkm::Vec<vtkm::FloatDefault, MaxK> dist2;
+    locator.FindKNearestNeighbors(queryPoint, this->K, ids, dist2);
+
+    vtkm::Id first = index * this->K;
+    for (vtkm::IdComponent i = 0; i < this->K; ++i)
+    {
+      neighborIds.Set(first + i, ids[i]);
+      distances2.Set(first + i, dist2[i]);
+    }
+  }
+
+private:
+  vtkm::IdComponent K;
+};
+
+class CountNeighborsInRadiusWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn queryPoint, ExecObject locator, FieldOut count);
+
+  using ExecutionSignature = void(_1, _2, _3);
+
+  VTKM_CONT
+  explicit CountNeighborsInRadiusWorklet(vtkm::FloatDefault radius)
+    : Radius(radius)
+  {
+  }
+
+  template <typename Locator>
+  VTKM_EXEC void operator()(const vtkm::Vec3f& queryPoint,
+                            const Locator& locator,
+                            vtkm::IdComponent& count) const
+  {
+    count =
+      static_cast<vtkm::IdComponent>(locator.CountNeighborsInRadius(queryPoint, this->Radius));
+  }
+
+private:
+  vtkm::FloatDefault Radius;
+};
+
+class FindNeighborsInRadiusWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn queryPoint,
+                                ExecObject locator,
+                                FieldOut neighborIds,
+                                FieldOut distances2);
+
+  using ExecutionSignature = void(_1, _2, _3, _4);
+
+  VTKM_CONT
+  explicit FindNeighborsInRadiusWorklet(vtkm::FloatDefault radius)
+    : Radius(radius)
+  {
+  }
+
+  template <typename Locator, typename IdVecType, typename DistanceVecType>
+  VTKM_EXEC void operator()(const vtkm::Vec3f& queryPoint,
+                            const Locator& locator,
+                            IdVecType& neighborIds,
+                            DistanceVecType& distances2) const
+  {
+    locator.FindNeighborsInRadius(queryPoint, this->Radius, neighborIds, distances2);
+  }
+
+private:
+  vtkm::FloatDefault Radius;
+};
+
+template <vtkm::IdComponent MaxK>
+void RunKNearestNeighbors(const vtkm::cont::PointLocatorSparseGrid& locator,
+                          const vtkm::cont::ArrayHandle<vtkm::Vec3f>& queryPoints,
+                          vtkm::IdComponent k,
+                          vtkm::cont::ArrayHandle<vtkm::Id>& neighborIds,
+                          vtkm::cont::ArrayHandle<vtkm::FloatDefault>& distances2)
+{
+  vtkm::cont::Invoker invoke;
+  invoke(KNearestNeighborsWorklet<MaxK>{ k }, queryPoints, locator, neighborIds, distances2);
+}
+
 } // vtkm::cont::internal
 
 void PointLocatorSparseGrid::Build()
@@ -103,6 +212,80 @@ void PointLocatorSparseGrid::Build()
   vtkm::cont::Algorithm::LowerBounds(cellIds, cell_ids_counting, this->CellLower);
 }
 
+void PointLocatorSparseGrid::FindKNearestNeighbors(
+  const vtkm::cont::UnknownArrayHandle& queryPoints,
+  vtkm::IdComponent k,
+  vtkm::cont::ArrayHandle<vtkm::Id>& neighborIds,
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault>& distances2) const
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "PointLocatorSparseGrid::FindKNearestNeighbors");
+
+  if ((k < 1) || (k > MaxNumberOfNearestNeighbors))
+  {
+    throw vtkm::cont::ErrorBadValue("The number of nearest neighbors must be between 1 and " +
+                                    std::to_string(MaxNumberOfNearestNeighbors) + ".");
+  }
+
+  this->Update();
+
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> points;
+  vtkm::cont::ArrayCopyShallowIfPossible(queryPoints, points);
+  neighborIds.Allocate(points.GetNumberOfValues() * k);
+  distances2.Allocate(points.GetNumberOfValues() * k);
+
+  // The priority queue of each point is sized at compile time so that it stays in registers.
+  if (k <= 4)
+  {
+    internal::RunKNearestNeighbors<4>(*this, points, k, neighborIds, distances2);
+  }
+  else if (k <= 16)
+  {
+    internal::RunKNearestNeighbors<16>(*this, points, k, neighborIds, distances2);
+  }
+  else
+  {
+    internal::RunKNearestNeighbors<MaxNumberOfNearestNeighbors>(
+      *this, points, k, neighborIds, distances2);
+  }
+}
+
+void PointLocatorSparseGrid::FindNeighborsInRadius(
+  const vtkm::cont::UnknownArrayHandle& queryPoints,
+  vtkm::FloatDefault radius,
+  vtkm::cont::ArrayHandle<vtkm::Id>& offsets,
+  vtkm::cont::ArrayHandle<vtkm::Id>& neighborIds,
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault>& distances2) const
+{
+  VTKM_LOG_SCOPE(vtkm::cont::LogLevel::Perf, "PointLocatorSparseGrid::FindNeighborsInRadius");
+
+  if (!(radius >= 0))
+  {
+    throw vtkm::cont::ErrorBadValue("The search radius must not be negative.");
+  }
+
+  this->Update();
+
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> points;
+  vtkm::cont::ArrayCopyShallowIfPossible(queryPoints, points);
+
+  // First pass counts the neighbors of each point to size the output.
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::IdComponent> counts;
+  invoke(internal::CountNeighborsInRadiusWorklet{ radius }, points, *this, counts);
+
+  vtkm::Id numberOfNeighbors;
+  vtkm::cont::ConvertNumComponentsToOffsets(counts, offsets, numberOfNeighbors);
+
+  // Second pass writes the neighbors of each point to its range of the output.
+  neighborIds.Allocate(numberOfNeighbors);
+  distances2.Allocate(numberOfNeighbors);
+  invoke(internal::FindNeighborsInRadiusWorklet{ radius },
+         points,
+         *this,
+         vtkm::cont::make_ArrayHandleGroupVecVariable(neighborIds, offsets),
+         vtkm::cont::make_ArrayHandleGroupVecVariable(distances2, offsets));
+}
+
 vtkm::exec::PointLocatorSparseGrid PointLocatorSparseGrid::PrepareForExecution(
   vtkm::cont::DeviceAdapterId device,
   vtkm::cont::Token& token) const
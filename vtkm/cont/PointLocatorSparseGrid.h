@@ -11,6 +11,7 @@
 #define vtk_m_cont_PointLocatorSparseGrid_h
 
 #include <vtkm/cont/PointLocatorBase.h>
+#include <vtkm/cont/UnknownArrayHandle.h>
 #include <vtkm/exec/PointLocatorSparseGrid.h>
 
 namespace vtkm
@@ -68,6 +69,35 @@ public:
 
   const vtkm::Id3& GetNumberOfBins() const { return this->Dims; }
 
+  /// The largest number of neighbors `FindKNearestNeighbors` can find for each point.
+  static constexpr vtkm::IdComponent MaxNumberOfNearestNeighbors = 64;
+
+  /// \brief Find the `k` nearest points of each query point.
+  ///
+  /// `neighborIds` and `distances2` get `k` values for each query point, which are the ids
+  /// of its nearest points and their squared distances, nearest first. When there are fewer
+  /// than `k` points, the missing neighbors have an id of -1 and an infinite distance.
+  /// `k` must be between 1 and `MaxNumberOfNearestNeighbors`.
+  VTKM_CONT void FindKNearestNeighbors(
+    const vtkm::cont::UnknownArrayHandle& queryPoints,
+    vtkm::IdComponent k,
+    vtkm::cont::ArrayHandle<vtkm::Id>& neighborIds,
+    vtkm::cont::ArrayHandle<vtkm::FloatDefault>& distances2) const;
+
+  /// \brief Find the points within a distance of each query point.
+  ///
+  /// The result is in compressed sparse row form. `offsets` has one more value than
+  /// there are query points, and the neighbors of query point `i` are the values from
+  /// `offsets[i]` to `offsets[i + 1]` of `neighborIds` and `distances2`. They are not
+  /// sorted by distance. The neighbors are counted in a first pass so that the output
+  /// arrays are allocated once to their final size.
+  VTKM_CONT void FindNeighborsInRadius(
+    const vtkm::cont::UnknownArrayHandle& queryPoints,
+    vtkm::FloatDefault radius,
+    vtkm::cont::ArrayHandle<vtkm::Id>& offsets,
+    vtkm::cont::ArrayHandle<vtkm::Id>& neighborIds,
+    vtkm::cont::ArrayHandle<vtkm::FloatDefault>& distances2) const;
+
   VTKM_CONT
   vtkm::exec::PointLocatorSparseGrid PrepareForExecution(vtkm::cont::DeviceAdapterId device,
                                                          vtkm::cont::Token& token) const;
@@ -108,6 +108,18 @@ public:
     throw vtkm::cont::ErrorBadDevice("Tried to set the device instance on an invalid device");
   }
 
+  VTKM_CONT virtual vtkm::cont::internal::RuntimeDeviceConfigReturnCode SetNumaFirstTouch(
+    bool) override final
+  {
+    throw vtkm::cont::ErrorBadDevice("Tried to set NUMA first touch on an invalid device");
+  }
+
+  VTKM_CONT virtual vtkm::cont::internal::RuntimeDeviceConfigReturnCode SetThreadPinning(
+    bool) override final
+  {
+    throw vtkm::cont::ErrorBadDevice("Tried to set thread pinning on an invalid device");
+  }
+
   VTKM_CONT virtual vtkm::cont::internal::RuntimeDeviceConfigReturnCode GetThreads(
     vtkm::Id&) const override final
   {
@@ -120,6 +132,18 @@ public:
     throw vtkm::cont::ErrorBadDevice("Tried to get the device instance on an invalid device");
   }
 
+  VTKM_CONT virtual vtkm::cont::internal::RuntimeDeviceConfigReturnCode GetNumaFirstTouch(
+    bool&) const override final
+  {
+    throw vtkm::cont::ErrorBadDevice("Tried to get NUMA first touch on an invalid device");
+  }
+
+  VTKM_CONT virtual vtkm::cont::internal::RuntimeDeviceConfigReturnCode GetThreadPinning(
+    bool&) const override final
+  {
+    throw vtkm::cont::ErrorBadDevice("Tried to get thread pinning on an invalid device");
+  }
+
   VTKM_CONT virtual vtkm::cont::internal::RuntimeDeviceConfigReturnCode GetMaxThreads(
     vtkm::Id&) const override final
   {
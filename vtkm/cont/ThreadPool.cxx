@@ -0,0 +1,237 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ThreadPool.h>
+
+#include <vtkm/cont/Logging.h>
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace vtkm
+{
+namespace cont
+{
+
+// A single call to Execute. Tasks are claimed by incrementing NextTask, so the threads working
+// on a job never wait on each other except to report an exception.
+struct ThreadPool::Job
+{
+  const std::vector<vtkm::Id>& TaskOrder;
+  const std::function<void(vtkm::Id)>& Task;
+  const std::size_t NumberOfTasks;
+  const vtkm::Id MaximumNumberOfWorkers;
+
+  std::atomic<std::size_t> NextTask{ 0 };
+  std::atomic<std::size_t> FinishedTasks{ 0 };
+
+  // Protected by the mutex of the pool.
+  vtkm::Id NumberOfWorkers = 0;
+
+  std::mutex Mutex;
+  std::condition_variable AllFinished;
+  std::exception_ptr Error;
+
+  Job(const std::vector<vtkm::Id>& taskOrder,
+      const std::function<void(vtkm::Id)>& task,
+      vtkm::Id maximumNumberOfWorkers)
+    : TaskOrder(taskOrder)
+    , Task(task)
+    , NumberOfTasks(taskOrder.size())
+    , MaximumNumberOfWorkers(maximumNumberOfWorkers)
+  {
+  }
+
+  bool HasTasks() const { return this->NextTask.load() < this->NumberOfTasks; }
+
+  void RunTasks()
+  {
+    std::size_t index;
+    while ((index = this->NextTask.fetch_add(1)) < this->NumberOfTasks)
+    {
+      try
+      {
+        this->Task(this->TaskOrder[index]);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        if (!this->Error)
+        {
+          this->Error = std::current_exception();
+        }
+      }
+
+      if ((this->FinishedTasks.fetch_add(1) + 1) == this->NumberOfTasks)
+      {
+        std::lock_guard<std::mutex> lock(this->Mutex);
+        this->AllFinished.notify_all();
+      }
+    }
+  }
+
+  void Wait()
+  {
+    std::unique_lock<std::mutex> lock(this->Mutex);
+    this->AllFinished.wait(
+      lock, [this]() { return this->FinishedTasks.load() == this->NumberOfTasks; });
+  }
+};
+
+struct ThreadPool::InternalStruct
+{
+  mutable std::mutex Mutex;
+  std::condition_variable WorkAvailable;
+  std::deque<std::shared_ptr<ThreadPool::Job>> Jobs;
+  std::vector<std::thread> Workers;
+  vtkm::Id MaximumNumberOfThreads = 0;
+  bool Stop = false;
+
+  void RemoveJob(const std::shared_ptr<ThreadPool::Job>& job)
+  {
+    auto jobIter = std::find(this->Jobs.begin(), this->Jobs.end(), job);
+    if (jobIter != this->Jobs.end())
+    {
+      this->Jobs.erase(jobIter);
+    }
+  }
+};
+
+ThreadPool::ThreadPool()
+  : Internals(new InternalStruct)
+{
+}
+
+ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+    this->Internals->Stop = true;
+  }
+  this->Internals->WorkAvailable.notify_all();
+  for (auto& worker : this->Internals->Workers)
+  {
+    worker.join();
+  }
+}
+
+void ThreadPool::SetMaximumNumberOfThreads(vtkm::Id numberOfThreads)
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  this->Internals->MaximumNumberOfThreads = std::max(numberOfThreads, vtkm::Id{ 0 });
+}
+
+vtkm::Id ThreadPool::GetMaximumNumberOfThreads() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return this->Internals->MaximumNumberOfThreads;
+}
+
+vtkm::Id ThreadPool::GetNumberOfWorkerThreads() const
+{
+  std::lock_guard<std::mutex> lock(this->Internals->Mutex);
+  return static_cast<vtkm::Id>(this->Internals->Workers.size());
+}
+
+void ThreadPool::Execute(const std::vector<vtkm::Id>& taskOrder,
+                         const std::function<void(vtkm::Id)>& task,
+                         vtkm::Id numberOfThreads)
+{
+  if (taskOrder.empty())
+  {
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(this->Internals->Mutex);
+  if (this->Internals->MaximumNumberOfThreads > 0)
+  {
+    numberOfThreads = std::min(numberOfThreads, this->Internals->MaximumNumberOfThreads);
+  }
+  numberOfThreads = std::min(numberOfThreads, static_cast<vtkm::Id>(taskOrder.size()));
+  // The calling thread is one of the threads running the tasks.
+  vtkm::Id numberOfWorkers = std::max(numberOfThreads - 1, vtkm::Id{ 0 });
+
+  auto job = std::make_shared<Job>(taskOrder, task, numberOfWorkers);
+  if (numberOfWorkers > 0)
+  {
+    while (static_cast<vtkm::Id>(this->Internals->Workers.size()) < numberOfWorkers)
+    {
+      VTKM_LOG_S(vtkm::cont::LogLevel::Info,
+                 "Starting thread pool worker " << this->Internals->Workers.size());
+      this->Internals->Workers.emplace_back([this]() { this->WorkerLoop(); });
+    }
+    this->Internals->Jobs.push_back(job);
+    lock.unlock();
+    this->Internals->WorkAvailable.notify_all();
+  }
+  else
+  {
+    lock.unlock();
+  }
+
+  job->RunTasks();
+  job->Wait();
+
+  if (numberOfWorkers > 0)
+  {
+    lock.lock();
+    this->Internals->RemoveJob(job);
+    lock.unlock();
+  }
+
+  if (job->Error)
+  {
+    std::rethrow_exception(job->Error);
+  }
+}
+
+void ThreadPool::WorkerLoop()
+{
+  InternalStruct& internals = *this->Internals;
+  std::unique_lock<std::mutex> lock(internals.Mutex);
+  while (true)
+  {
+    internals.WorkAvailable.wait(
+      lock, [&internals]() { return internals.Stop || !internals.Jobs.empty(); });
+    if (internals.Stop)
+    {
+      return;
+    }
+
+    std::shared_ptr<Job> job = internals.Jobs.front();
+    if (!job->HasTasks() || (job->NumberOfWorkers >= job->MaximumNumberOfWorkers))
+    {
+      // Every task of this job is claimed or it has all the workers it asked for.
+      internals.Jobs.pop_front();
+      continue;
+    }
+    ++job->NumberOfWorkers;
+
+    lock.unlock();
+    job->RunTasks();
+    lock.lock();
+
+    internals.RemoveJob(job);
+  }
+}
+
+vtkm::cont::ThreadPool& GetThreadPool()
+{
+  static vtkm::cont::ThreadPool threadPool;
+  return threadPool;
+}
+
+}
+} // namespace vtkm::cont
@@ -0,0 +1,89 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_cont_ThreadPool_h
+#define vtk_m_cont_ThreadPool_h
+
+#include <vtkm/cont/vtkm_cont_export.h>
+
+#include <vtkm/Types.h>
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace vtkm
+{
+namespace cont
+{
+
+/// \brief A pool of persistent threads that run independent control-side tasks.
+///
+/// Some operations, such as executing a filter on each partition of a `PartitionedDataSet`,
+/// are made of independent tasks that each launch their own device work. `ThreadPool` runs
+/// such tasks on worker threads that are created once and reused by every call to `Execute`,
+/// so a pipeline of many filters does not pay for creating and joining threads in each one.
+///
+/// Tasks are handed out in the order given to `Execute` by advancing an atomic counter, so
+/// no lock is taken to schedule a task. The thread that calls `Execute` also runs tasks,
+/// which makes it safe to call `Execute` from within a task.
+///
+/// A process-wide pool is available from `vtkm::cont::GetThreadPool()`. Its maximum size can
+/// be set with the `--vtkm-thread-pool-size` argument to `vtkm::cont::Initialize`.
+///
+class VTKM_CONT_EXPORT ThreadPool final
+{
+public:
+  VTKM_CONT ThreadPool();
+  VTKM_CONT ~ThreadPool();
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  /// @brief Specifies the largest number of threads that work on one call to `Execute`.
+  ///
+  /// The count includes the thread calling `Execute`. A value of 0 (the default) places no
+  /// limit beyond the number of threads requested in `Execute`. Lowering the limit does not
+  /// destroy worker threads that were already created; they are simply left idle.
+  VTKM_CONT void SetMaximumNumberOfThreads(vtkm::Id numberOfThreads);
+  /// @copydoc SetMaximumNumberOfThreads
+  VTKM_CONT vtkm::Id GetMaximumNumberOfThreads() const;
+
+  /// @brief Returns the number of worker threads that have been created.
+  ///
+  /// Worker threads are created the first time they are needed and live as long as the pool.
+  VTKM_CONT vtkm::Id GetNumberOfWorkerThreads() const;
+
+  /// @brief Runs a task for each of the given indices and waits for all of them to finish.
+  ///
+  /// `task` is called once with each value in `taskOrder`. Tasks are started in the order of
+  /// `taskOrder`, so putting the most expensive tasks first reduces the time spent waiting on
+  /// the last one. At most `numberOfThreads` threads, including the calling thread, run the
+  /// tasks. If a task throws an exception, the remaining tasks still run and the first
+  /// exception is rethrown once they finish.
+  VTKM_CONT void Execute(const std::vector<vtkm::Id>& taskOrder,
+                         const std::function<void(vtkm::Id)>& task,
+                         vtkm::Id numberOfThreads);
+
+private:
+  struct Job;
+  struct InternalStruct;
+  std::unique_ptr<InternalStruct> Internals;
+
+  VTKM_CONT void WorkerLoop();
+};
+
+/// @brief Returns the process-wide `ThreadPool`.
+///
+VTKM_CONT_EXPORT VTKM_CONT vtkm::cont::ThreadPool& GetThreadPool();
+
+}
+} // namespace vtkm::cont
+
+#endif //vtk_m_cont_ThreadPool_h
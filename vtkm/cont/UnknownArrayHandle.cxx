@@ -27,8 +27,14 @@
 
 #include <vtkm/cont/internal/ArrayCopyUnknown.h>
 
+#include <atomic>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 namespace
 {
@@ -114,6 +120,88 @@ bool UnknownAHComponentInfo::operator==(const UnknownAHComponentInfo& rhs)
   }
 }
 
+struct UnknownAHDispatchCache::InternalsType
+{
+  using KeyType = std::pair<std::type_index, std::type_index>;
+
+  struct KeyHash
+  {
+    std::size_t operator()(const KeyType& key) const
+    {
+      std::size_t hash = std::hash<std::type_index>{}(key.first);
+      return hash ^ (std::hash<std::type_index>{}(key.second) + 0x9e3779b9 + (hash << 6) +
+                     (hash >> 2));
+    }
+  };
+
+  using TableType = std::unordered_map<KeyType, vtkm::IdComponent, KeyHash>;
+
+  // Dispatch looks up the current table without locking. A published table is never
+  // modified; an insertion publishes a modified copy instead. Superseded tables are kept
+  // until the cache is destroyed because a lookup may still be reading them. There is one
+  // entry for each array type that is cast, so they stay small.
+  std::atomic<const TableType*> Current{ nullptr };
+  std::mutex InsertMutex;
+  std::vector<std::unique_ptr<TableType>> Tables;
+};
+
+constexpr vtkm::IdComponent UnknownAHDispatchCache::NotFound;
+constexpr vtkm::IdComponent UnknownAHDispatchCache::NotCached;
+
+UnknownAHDispatchCache::UnknownAHDispatchCache()
+  : Internals(new InternalsType)
+{
+}
+
+UnknownAHDispatchCache::~UnknownAHDispatchCache() = default;
+
+vtkm::IdComponent UnknownAHDispatchCache::Find(const vtkm::cont::UnknownArrayHandle& array) const
+{
+  if (!array.Container)
+  {
+    return NotFound;
+  }
+  if (array.IsStorageType<vtkm::cont::StorageTagRuntimeVec>())
+  {
+    return NotCached;
+  }
+
+  const InternalsType::TableType* table =
+    this->Internals->Current.load(std::memory_order_acquire);
+  if (table == nullptr)
+  {
+    return NotCached;
+  }
+  auto entry =
+    table->find(InternalsType::KeyType(array.Container->ValueType, array.Container->StorageType));
+  return (entry != table->end()) ? entry->second : NotCached;
+}
+
+void UnknownAHDispatchCache::Insert(const vtkm::cont::UnknownArrayHandle& array,
+                                    vtkm::IdComponent index)
+{
+  if (!array.Container || array.IsStorageType<vtkm::cont::StorageTagRuntimeVec>())
+  {
+    return;
+  }
+
+  InternalsType::KeyType key(array.Container->ValueType, array.Container->StorageType);
+  std::lock_guard<std::mutex> lock(this->Internals->InsertMutex);
+  const InternalsType::TableType* current =
+    this->Internals->Current.load(std::memory_order_relaxed);
+  if ((current != nullptr) && (current->find(key) != current->end()))
+  {
+    // Another thread cached this array type first.
+    return;
+  }
+  std::unique_ptr<InternalsType::TableType> table = (current != nullptr)
+    ? std::unique_ptr<InternalsType::TableType>(new InternalsType::TableType(*current))
+    : std::unique_ptr<InternalsType::TableType>(new InternalsType::TableType);
+  table->emplace(key, index);
+  this->Internals->Current.store(table.get(), std::memory_order_release);
+  this->Internals->Tables.push_back(std::move(table));
+}
+
 } // namespace detail
 
 VTKM_CONT bool UnknownArrayHandle::IsValueTypeImpl(std::type_index type) const
@@ -171,6 +171,8 @@ void UnknownAHPrintSummary(void* mem, std::ostream& out, bool full)
 
 struct VTKM_CONT_EXPORT UnknownAHContainer;
 
+class UnknownAHDispatchCache;
+
 struct MakeUnknownAHContainerFunctor
 {
   template <typename T, typename S>
@@ -431,6 +433,8 @@ class VTKM_CONT_EXPORT UnknownArrayHandle
 {
   std::shared_ptr<detail::UnknownAHContainer> Container;
 
+  friend class detail::UnknownAHDispatchCache;
+
   VTKM_CONT bool IsValueTypeImpl(std::type_index type) const;
   VTKM_CONT bool IsStorageTypeImpl(std::type_index type) const;
   VTKM_CONT bool IsBaseComponentTypeImpl(const detail::UnknownAHComponentInfo& type) const;
@@ -1143,6 +1147,130 @@ struct UnknownArrayHandleTry
   }
 };
 
+/// Remembers which candidate of a `CastAndCall` an array type was dispatched to.
+///
+/// Finding the candidate tries each one in turn, and each try compares `std::type_index`es
+/// (and their names when they differ). The cache maps the value and storage type of the held
+/// array to the index of the candidate, so later calls with the same array type find it with
+/// one hash lookup. Arrays with `StorageTagRuntimeVec` are never cached because whether they
+/// convert also depends on their number of components.
+///
+/// `Find()` takes no lock, so threads that dispatch concurrently do not contend. Only
+/// `Insert()`, which happens once for each array type, is serialized.
+class VTKM_CONT_EXPORT UnknownAHDispatchCache
+{
+public:
+  /// Returned when no candidate can be called with the array.
+  static constexpr vtkm::IdComponent NotFound = -1;
+  /// Returned when the array type has not been cached.
+  static constexpr vtkm::IdComponent NotCached = -2;
+
+  VTKM_CONT UnknownAHDispatchCache();
+  VTKM_CONT ~UnknownAHDispatchCache();
+
+  VTKM_CONT vtkm::IdComponent Find(const vtkm::cont::UnknownArrayHandle& array) const;
+  VTKM_CONT void Insert(const vtkm::cont::UnknownArrayHandle& array, vtkm::IdComponent index);
+
+private:
+  struct InternalsType;
+  std::unique_ptr<InternalsType> Internals;
+};
+
+/// Dispatches an `UnknownArrayHandle` to one of a list of candidates.
+///
+/// `Caller` has a static `CanCall(Candidate{}, array)` that tells whether the array can be
+/// passed as the candidate and a static `Call<Candidate>(array, functor, args...)` that does
+/// it. The index of the first candidate that can be called is cached per array type, and the
+/// call goes through a jump table built at compile time, so a cached dispatch is a hash lookup
+/// and an indirect call regardless of the number of candidates.
+template <typename CandidateList, typename Caller>
+struct UnknownArrayHandleDispatch;
+
+template <typename Caller>
+struct UnknownArrayHandleDispatch<vtkm::List<>, Caller>
+{
+  VTKM_CONT static vtkm::IdComponent FindIndex(const vtkm::cont::UnknownArrayHandle&)
+  {
+    return UnknownAHDispatchCache::NotFound;
+  }
+
+  template <typename Functor, typename... Args>
+  VTKM_CONT static void Call(vtkm::IdComponent,
+                             const vtkm::cont::UnknownArrayHandle&,
+                             Functor&&,
+                             Args&&...)
+  {
+  }
+};
+
+template <typename... Candidates, typename Caller>
+struct UnknownArrayHandleDispatch<vtkm::List<Candidates...>, Caller>
+{
+  VTKM_CONT static vtkm::IdComponent FindIndex(const vtkm::cont::UnknownArrayHandle& array)
+  {
+    static UnknownAHDispatchCache cache;
+    vtkm::IdComponent index = cache.Find(array);
+    if (index == UnknownAHDispatchCache::NotCached)
+    {
+      index = UnknownAHDispatchCache::NotFound;
+      vtkm::IdComponent current = 0;
+      vtkm::ListForEach(Search{}, vtkm::List<Candidates...>{}, array, current, index);
+      cache.Insert(array, index);
+    }
+    return index;
+  }
+
+  template <typename Functor, typename... Args>
+  VTKM_CONT static void Call(vtkm::IdComponent index,
+                             const vtkm::cont::UnknownArrayHandle& array,
+                             Functor&& f,
+                             Args&&... args)
+  {
+    using CallType = void(const vtkm::cont::UnknownArrayHandle&, Functor&&, Args&&...);
+    static constexpr CallType* table[] = {
+      &Caller::template Call<Candidates, Functor, Args...>...
+    };
+    table[index](array, std::forward<Functor>(f), std::forward<Args>(args)...);
+  }
+
+private:
+  struct Search
+  {
+    template <typename Candidate>
+    VTKM_CONT void operator()(Candidate,
+                              const vtkm::cont::UnknownArrayHandle& array,
+                              vtkm::IdComponent& current,
+                              vtkm::IdComponent& found) const
+    {
+      if ((found < 0) && Caller::CanCall(Candidate{}, array))
+      {
+        found = current;
+      }
+      ++current;
+    }
+  };
+};
+
+// Caller for `UnknownArrayHandleDispatch` with candidates of the form `vtkm::List<T, S>`.
+struct UnknownAHCastCaller
+{
+  template <typename T, typename S>
+  VTKM_CONT static bool CanCall(vtkm::List<T, S>, const vtkm::cont::UnknownArrayHandle& array)
+  {
+    return array.CanConvert<vtkm::cont::ArrayHandle<T, S>>();
+  }
+
+  template <typename Candidate, typename Functor, typename... Args>
+  VTKM_CONT static void Call(const vtkm::cont::UnknownArrayHandle& array,
+                             Functor&& f,
+                             Args&&... args)
+  {
+    bool called = false;
+    UnknownArrayHandleTry{}(
+      Candidate{}, std::forward<Functor>(f), called, array, std::forward<Args>(args)...);
+  }
+};
+
 } // namespace detail
 
 namespace internal
@@ -1175,20 +1303,16 @@ template <typename TypeList, typename StorageTagList, typename Functor, typename
 inline void UnknownArrayHandle::CastAndCallForTypes(Functor&& f, Args&&... args) const
 {
   using crossProduct = internal::ListAllArrayTypes<TypeList, StorageTagList>;
+  using Dispatch = detail::UnknownArrayHandleDispatch<crossProduct, detail::UnknownAHCastCaller>;
 
-  bool called = false;
-  vtkm::ListForEach(detail::UnknownArrayHandleTry{},
-                    crossProduct{},
-                    std::forward<Functor>(f),
-                    called,
-                    *this,
-                    std::forward<Args>(args)...);
-  if (!called)
+  vtkm::IdComponent index = Dispatch::FindIndex(*this);
+  if (index < 0)
   {
     // throw an exception
     VTKM_LOG_CAST_FAIL(*this, TypeList);
     internal::ThrowCastAndCallException(*this, typeid(TypeList));
   }
+  Dispatch::Call(index, *this, std::forward<Functor>(f), std::forward<Args>(args)...);
 }
 
 template <typename TypeList, typename StorageTagList, typename Functor, typename... Args>
@@ -1196,35 +1320,29 @@ VTKM_CONT void UnknownArrayHandle::CastAndCallForTypesWithFloatFallback(Functor&
                                                                         Args&&... args) const
 {
   using crossProduct = internal::ListAllArrayTypes<TypeList, StorageTagList>;
+  using Dispatch = detail::UnknownArrayHandleDispatch<crossProduct, detail::UnknownAHCastCaller>;
 
-  bool called = false;
-  vtkm::ListForEach(detail::UnknownArrayHandleTry{},
-                    crossProduct{},
-                    std::forward<Functor>(functor),
-                    called,
-                    *this,
-                    std::forward<Args>(args)...);
-  if (!called)
+  vtkm::IdComponent index = Dispatch::FindIndex(*this);
+  if (index >= 0)
   {
-    // Copy to a float array and try again
-    VTKM_LOG_F(vtkm::cont::LogLevel::Info,
-               "Cast and call from %s failed. Copying to basic float array.",
-               this->GetArrayTypeName().c_str());
-    vtkm::cont::UnknownArrayHandle floatArray = this->NewInstanceFloatBasic();
-    floatArray.DeepCopyFrom(*this);
-    vtkm::ListForEach(detail::UnknownArrayHandleTry{},
-                      crossProduct{},
-                      std::forward<Functor>(functor),
-                      called,
-                      floatArray,
-                      std::forward<Args>(args)...);
+    Dispatch::Call(index, *this, std::forward<Functor>(functor), std::forward<Args>(args)...);
+    return;
   }
-  if (!called)
+
+  // Copy to a float array and try again
+  VTKM_LOG_F(vtkm::cont::LogLevel::Info,
+             "Cast and call from %s failed. Copying to basic float array.",
+             this->GetArrayTypeName().c_str());
+  vtkm::cont::UnknownArrayHandle floatArray = this->NewInstanceFloatBasic();
+  floatArray.DeepCopyFrom(*this);
+  index = Dispatch::FindIndex(floatArray);
+  if (index < 0)
   {
     // throw an exception
     VTKM_LOG_CAST_FAIL(*this, TypeList);
     internal::ThrowCastAndCallException(*this, typeid(TypeList));
   }
+  Dispatch::Call(index, floatArray, std::forward<Functor>(functor), std::forward<Args>(args)...);
 }
 
 //=============================================================================
@@ -1278,20 +1396,37 @@ struct UnknownArrayHandleTryExtract
   }
 };
 
+// Caller for `UnknownArrayHandleDispatch` with base component types as candidates.
+struct UnknownAHExtractCaller
+{
+  template <typename T>
+  VTKM_CONT static bool CanCall(T, const vtkm::cont::UnknownArrayHandle& array)
+  {
+    return array.IsBaseComponentType<T>();
+  }
+
+  template <typename Candidate, typename Functor, typename... Args>
+  VTKM_CONT static void Call(const vtkm::cont::UnknownArrayHandle& array,
+                             Functor&& f,
+                             Args&&... args)
+  {
+    bool called = false;
+    UnknownArrayHandleTryExtract{}(
+      Candidate{}, std::forward<Functor>(f), called, array, std::forward<Args>(args)...);
+  }
+};
+
 } // namespace detail
 
 template <typename Functor, typename... Args>
 inline void UnknownArrayHandle::CastAndCallWithExtractedArray(Functor&& functor,
                                                               Args&&... args) const
 {
-  bool called = false;
-  vtkm::ListForEach(detail::UnknownArrayHandleTryExtract{},
-                    vtkm::TypeListScalarAll{},
-                    std::forward<Functor>(functor),
-                    called,
-                    *this,
-                    std::forward<Args>(args)...);
-  if (!called)
+  using Dispatch =
+    detail::UnknownArrayHandleDispatch<vtkm::TypeListScalarAll, detail::UnknownAHExtractCaller>;
+
+  vtkm::IdComponent index = Dispatch::FindIndex(*this);
+  if (index < 0)
   {
     // Throw an exception.
     // The message will be a little wonky because the types are just the value types, not the
@@ -1299,6 +1434,7 @@ inline void UnknownArrayHandle::CastAndCallWithExtractedArray(Functor&& functor,
     VTKM_LOG_CAST_FAIL(*this, vtkm::TypeListScalarAll);
     internal::ThrowCastAndCallException(*this, typeid(vtkm::TypeListScalarAll));
   }
+  Dispatch::Call(index, *this, std::forward<Functor>(functor), std::forward<Args>(args)...);
 }
 
 }
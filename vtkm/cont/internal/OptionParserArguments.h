@@ -36,7 +36,10 @@ enum OptionIndex
   // All RuntimeDeviceConfiguration specific options
   NUM_THREADS,
   NUMA_REGIONS,
-  DEVICE_INSTANCE
+  DEVICE_INSTANCE,
+
+  // Options for the control-side thread pool
+  THREAD_POOL_SIZE
 };
 
 struct VtkmArg : public option::Arg
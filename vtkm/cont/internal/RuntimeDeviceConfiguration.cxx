@@ -117,6 +117,16 @@ RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::SetDeviceInstance(
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
 }
 
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::SetNumaFirstTouch(bool)
+{
+  return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
+}
+
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::SetThreadPinning(bool)
+{
+  return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
+}
+
 RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetThreads(vtkm::Id&) const
 {
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
@@ -127,6 +137,16 @@ RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetDeviceInstance(
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
 }
 
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetNumaFirstTouch(bool&) const
+{
+  return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
+}
+
+RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetThreadPinning(bool&) const
+{
+  return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
+}
+
 RuntimeDeviceConfigReturnCode RuntimeDeviceConfigurationBase::GetMaxThreads(vtkm::Id&) const
 {
   return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
@@ -55,11 +55,20 @@ public:
   /// support the particular set method.
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetThreads(const vtkm::Id& value);
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetDeviceInstance(const vtkm::Id& value);
+  /// When on, memory allocated for a device that runs on the host CPUs is first touched in
+  /// parallel, with the same static partitioning the device then uses to schedule its tasks.
+  /// This places each page on the NUMA node of the thread that processes it.
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetNumaFirstTouch(bool value);
+  /// When on, each thread of a device that runs on the host CPUs is pinned to a core, so
+  /// threads do not migrate away from the memory they first touched.
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetThreadPinning(bool value);
 
   /// The following public methods are overriden in each individual device and store the
   /// values that were set via the above Set* methods for the given device.
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetThreads(vtkm::Id& value) const;
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetDeviceInstance(vtkm::Id& value) const;
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetNumaFirstTouch(bool& value) const;
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetThreadPinning(bool& value) const;
 
   /// The following public methods should be overriden as needed for each individual device
   /// as they describe various device parameters.
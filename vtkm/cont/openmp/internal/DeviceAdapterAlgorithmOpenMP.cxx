@@ -12,6 +12,7 @@
 #include <vtkm/cont/openmp/internal/FunctorsOpenMP.h>
 
 #include <vtkm/cont/ErrorExecution.h>
+#include <vtkm/cont/RuntimeDeviceInformation.h>
 
 #include <omp.h>
 
@@ -49,13 +50,29 @@ void DeviceAdapterAlgorithm<vtkm::cont::DeviceAdapterTagOpenMP>::ScheduleTask(
   const vtkm::Id chunkSize = computeChunkSize(size, 256, 1, 1024);
   const vtkm::Id numChunks = (size + chunkSize - 1) / chunkSize;
 
-  VTKM_OPENMP_DIRECTIVE(parallel for
-                        schedule(guided))
-  for (vtkm::Id i = 0; i < numChunks; ++i)
+  if (vtkm::cont::openmp::UseNumaFirstTouch())
   {
-    const vtkm::Id first = i * chunkSize;
-    const vtkm::Id last = std::min((i + 1) * chunkSize, size);
-    functor(first, last);
+    // Give each thread one contiguous range, which matches how the memory manager first
+    // touched the pages of the arrays.
+    VTKM_OPENMP_DIRECTIVE(parallel for
+                          schedule(static))
+    for (vtkm::Id i = 0; i < numChunks; ++i)
+    {
+      const vtkm::Id first = i * chunkSize;
+      const vtkm::Id last = std::min((i + 1) * chunkSize, size);
+      functor(first, last);
+    }
+  }
+  else
+  {
+    VTKM_OPENMP_DIRECTIVE(parallel for
+                          schedule(guided))
+    for (vtkm::Id i = 0; i < numChunks; ++i)
+    {
+      const vtkm::Id first = i * chunkSize;
+      const vtkm::Id last = std::min((i + 1) * chunkSize, size);
+      functor(first, last);
+    }
   }
 
   if (errorMessage.IsErrorRaised())
@@ -12,7 +12,12 @@
 
 #include <vtkm/cont/openmp/internal/DeviceAdapterTagOpenMP.h>
 
+#include <vtkm/cont/RuntimeDeviceInformation.h>
 #include <vtkm/cont/internal/DeviceAdapterMemoryManagerShared.h>
+#include <vtkm/cont/openmp/internal/FunctorsOpenMP.h>
+
+#include <algorithm>
+#include <cstring>
 
 namespace vtkm
 {
@@ -29,6 +34,52 @@ class DeviceAdapterMemoryManager<vtkm::cont::DeviceAdapterTagOpenMP>
   {
     return vtkm::cont::DeviceAdapterTagOpenMP{};
   }
+
+  VTKM_CONT vtkm::cont::internal::BufferInfo Allocate(vtkm::BufferSizeType size) const override
+  {
+    vtkm::cont::internal::BufferInfo info = this->DeviceAdapterMemoryManagerShared::Allocate(size);
+    if (vtkm::cont::openmp::UseNumaFirstTouch())
+    {
+      // Write one byte of each page with the static schedule that ScheduleTask uses in this
+      // mode, so each page lands on the NUMA node of the thread that will process it.
+      constexpr vtkm::Id pageSize = vtkm::cont::openmp::VTKM_PAGE_SIZE;
+      vtkm::UInt8* data = static_cast<vtkm::UInt8*>(info.GetPointer());
+      const vtkm::Id numPages = vtkm::cont::openmp::CeilDivide(size, pageSize);
+      VTKM_OPENMP_DIRECTIVE(parallel for schedule(static))
+      for (vtkm::Id page = 0; page < numPages; ++page)
+      {
+        data[page * pageSize] = 0;
+      }
+    }
+    return info;
+  }
+
+  using DeviceAdapterMemoryManagerShared::CopyDeviceToDevice;
+
+  VTKM_CONT void CopyDeviceToDevice(const vtkm::cont::internal::BufferInfo& src,
+                                    const vtkm::cont::internal::BufferInfo& dest) const override
+  {
+    if (!vtkm::cont::openmp::UseNumaFirstTouch())
+    {
+      this->DeviceAdapterMemoryManagerShared::CopyDeviceToDevice(src, dest);
+      return;
+    }
+
+    // Copy page by page with the same static schedule as the first touch.
+    VTKM_ASSERT(src.GetSize() == dest.GetSize());
+    const vtkm::UInt8* srcData = static_cast<const vtkm::UInt8*>(src.GetPointer());
+    vtkm::UInt8* destData = static_cast<vtkm::UInt8*>(dest.GetPointer());
+    constexpr vtkm::Id pageSize = vtkm::cont::openmp::VTKM_PAGE_SIZE;
+    const vtkm::BufferSizeType size = src.GetSize();
+    const vtkm::Id numPages = vtkm::cont::openmp::CeilDivide(size, pageSize);
+    VTKM_OPENMP_DIRECTIVE(parallel for schedule(static))
+    for (vtkm::Id page = 0; page < numPages; ++page)
+    {
+      const vtkm::Id offset = page * pageSize;
+      const vtkm::Id numBytes = std::min(pageSize, size - offset);
+      std::memcpy(destData + offset, srcData + offset, static_cast<std::size_t>(numBytes));
+    }
+  }
 };
 }
 }
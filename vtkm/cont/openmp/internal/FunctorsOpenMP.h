@@ -73,6 +73,24 @@ static constexpr T CeilDivide(const T& numerator, const T& denominator)
   return (numerator + denominator - 1) / denominator;
 }
 
+// The runtime configuration of the OpenMP device. It lives as long as the process, so it is
+// looked up once rather than on every schedule and allocation.
+static inline vtkm::cont::internal::RuntimeDeviceConfigurationBase& GetRuntimeConfiguration()
+{
+  static vtkm::cont::internal::RuntimeDeviceConfigurationBase& config =
+    vtkm::cont::RuntimeDeviceInformation{}.GetRuntimeConfiguration(
+      vtkm::cont::DeviceAdapterTagOpenMP{});
+  return config;
+}
+
+// Whether device arrays are placed with NUMA first touch and scheduled to match.
+static inline bool UseNumaFirstTouch()
+{
+  bool numaFirstTouch = false;
+  GetRuntimeConfiguration().GetNumaFirstTouch(numaFirstTouch);
+  return numaFirstTouch;
+}
+
 // Computes the number of values per chunk. Note that numChunks + chunkSize may
 // exceed numVals, so be sure to check upper limits.
 static void ComputeChunkSize(const vtkm::Id numVals,
@@ -167,9 +185,7 @@ static void CopyHelper(InPortalT inPortal,
       // data here so that we can exploit std::copy's memmove optimizations.
       vtkm::Id numChunks;
       vtkm::Id numThreads;
-      vtkm::cont::RuntimeDeviceInformation{}
-        .GetRuntimeConfiguration(vtkm::cont::DeviceAdapterTagOpenMP())
-        .GetThreads(numThreads);
+      GetRuntimeConfiguration().GetThreads(numThreads);
       ComputeChunkSize(numVals, numThreads, 8, sizeof(InValueT), numChunks, valuesPerChunk);
     }
 
@@ -197,9 +213,7 @@ struct CopyIfHelper
   void Initialize(vtkm::Id numValues, vtkm::Id valueSize)
   {
     this->NumValues = numValues;
-    vtkm::cont::RuntimeDeviceInformation{}
-      .GetRuntimeConfiguration(vtkm::cont::DeviceAdapterTagOpenMP())
-      .GetThreads(this->NumThreads);
+    GetRuntimeConfiguration().GetThreads(this->NumThreads);
     this->ValueSize = valueSize;
 
     // Evenly distribute pages across the threads. We manually chunk the
@@ -334,9 +348,7 @@ struct ReduceHelper
     bool doParallel = false;
     vtkm::Id numThreads = 0;
 
-    vtkm::cont::RuntimeDeviceInformation{}
-      .GetRuntimeConfiguration(vtkm::cont::DeviceAdapterTagOpenMP())
-      .GetThreads(numThreads);
+    GetRuntimeConfiguration().GetThreads(numThreads);
 
     std::unique_ptr<ReturnType[]> threadData;
 
@@ -538,9 +550,7 @@ void ReduceByKeyHelper(KeysInArray keysInArray,
   vtkm::Id outIdx = 0;
   vtkm::Id numThreads = 0;
 
-  vtkm::cont::RuntimeDeviceInformation{}
-    .GetRuntimeConfiguration(vtkm::cont::DeviceAdapterTagOpenMP())
-    .GetThreads(numThreads);
+  GetRuntimeConfiguration().GetThreads(numThreads);
 
   VTKM_OPENMP_DIRECTIVE(parallel default(none) firstprivate(keysIn, valuesIn, keysOut, valuesOut, f)
                           shared(numThreads, outIdx) VTKM_OPENMP_SHARED_CONST(numValues))
@@ -691,9 +701,7 @@ private:
   {
     // Figure out how many values each thread should handle:
     vtkm::Id numThreads = 0;
-    vtkm::cont::RuntimeDeviceInformation{}
-      .GetRuntimeConfiguration(vtkm::cont::DeviceAdapterTagOpenMP())
-      .GetThreads(numThreads);
+    GetRuntimeConfiguration().GetThreads(numThreads);
 
     vtkm::Id chunksPerThread = 8;
     vtkm::Id numChunks;
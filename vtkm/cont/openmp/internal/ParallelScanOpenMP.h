@@ -155,9 +155,7 @@ private:
     // Figure out how many values each thread should handle:
     vtkm::Id numVals = range[1] - range[0];
     vtkm::Id numThreads = 0;
-    vtkm::cont::RuntimeDeviceInformation{}
-      .GetRuntimeConfiguration(vtkm::cont::DeviceAdapterTagOpenMP())
-      .GetThreads(numThreads);
+    vtkm::cont::openmp::GetRuntimeConfiguration().GetThreads(numThreads);
     vtkm::Id chunksPerThread = 8;
     vtkm::Id numChunks;
     ComputeChunkSize(
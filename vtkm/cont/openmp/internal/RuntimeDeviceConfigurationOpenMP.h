@@ -19,6 +19,13 @@ VTKM_THIRDPARTY_PRE_INCLUDE
 #include <omp.h>
 VTKM_THIRDPARTY_POST_INCLUDE
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <atomic>
+#include <vector>
+
 namespace vtkm
 {
 namespace cont
@@ -35,6 +42,11 @@ public:
     : HardwareMaxThreads(InitializeHardwareMaxThreads())
     , CurrentNumThreads(this->HardwareMaxThreads)
   {
+#ifdef __linux__
+    // Remember the CPUs available to the process so that pinning can be undone.
+    CPU_ZERO(&this->ProcessAffinity);
+    sched_getaffinity(0, sizeof(this->ProcessAffinity), &this->ProcessAffinity);
+#endif
   }
 
   VTKM_CONT vtkm::cont::DeviceAdapterId GetDevice() const override final
@@ -66,15 +78,58 @@ public:
       this->CurrentNumThreads = this->HardwareMaxThreads;
       omp_set_num_threads(this->CurrentNumThreads);
     }
+    if (this->ThreadPinning)
+    {
+      // New threads in the pool start unpinned.
+      this->ApplyThreadPinning();
+    }
+    return RuntimeDeviceConfigReturnCode::SUCCESS;
+  }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetNumaFirstTouch(bool value) override final
+  {
+    this->NumaFirstTouch.store(value);
     return RuntimeDeviceConfigReturnCode::SUCCESS;
   }
 
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode SetThreadPinning(bool value) override final
+  {
+#ifdef __linux__
+    if (omp_in_parallel())
+    {
+      VTKM_LOG_S(vtkm::cont::LogLevel::Error,
+                 "OpenMP SetThreadPinning: Error, currently in parallel");
+      return RuntimeDeviceConfigReturnCode::NOT_APPLIED;
+    }
+    this->ThreadPinning = value;
+    this->ApplyThreadPinning();
+    return RuntimeDeviceConfigReturnCode::SUCCESS;
+#else
+    (void)value;
+    return RuntimeDeviceConfigReturnCode::INVALID_FOR_DEVICE;
+#endif
+  }
+
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetThreads(vtkm::Id& value) const override final
   {
     value = this->CurrentNumThreads;
     return RuntimeDeviceConfigReturnCode::SUCCESS;
   }
 
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetNumaFirstTouch(
+    bool& value) const override final
+  {
+    value = this->NumaFirstTouch.load();
+    return RuntimeDeviceConfigReturnCode::SUCCESS;
+  }
+
+  VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetThreadPinning(
+    bool& value) const override final
+  {
+    value = this->ThreadPinning;
+    return RuntimeDeviceConfigReturnCode::SUCCESS;
+  }
+
   VTKM_CONT virtual RuntimeDeviceConfigReturnCode GetMaxThreads(
     vtkm::Id& value) const override final
   {
@@ -102,8 +157,55 @@ private:
     return count;
   }
 
+  // Pins thread i of the pool to the i-th CPU available to the process, or restores the
+  // process affinity when pinning is off. With the static schedule used for NUMA first touch,
+  // consecutive blocks of an array then stay on consecutive cores. Thread 0 is the calling
+  // application thread, which is left alone: threads it creates later, such as those of
+  // `vtkm::cont::ThreadPool` or `std::async`, inherit its affinity and would otherwise all
+  // share one core.
+  VTKM_CONT void ApplyThreadPinning() const
+  {
+#ifdef __linux__
+    std::vector<int> cpus;
+    for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+    {
+      if (CPU_ISSET(cpu, &this->ProcessAffinity))
+      {
+        cpus.push_back(cpu);
+      }
+    }
+    if (cpus.empty())
+    {
+      return;
+    }
+
+    const bool pin = this->ThreadPinning;
+    VTKM_OPENMP_DIRECTIVE(parallel)
+    {
+      if (omp_get_thread_num() != 0)
+      {
+        cpu_set_t threadAffinity = this->ProcessAffinity;
+        if (pin)
+        {
+          CPU_ZERO(&threadAffinity);
+          CPU_SET(cpus[static_cast<std::size_t>(omp_get_thread_num()) % cpus.size()],
+                  &threadAffinity);
+        }
+        // A pid of 0 applies to the calling thread.
+        sched_setaffinity(0, sizeof(threadAffinity), &threadAffinity);
+      }
+    }
+#endif
+  }
+
   vtkm::Id HardwareMaxThreads;
   vtkm::Id CurrentNumThreads;
+  // Read on every schedule and allocation, possibly from several threads.
+  std::atomic<bool> NumaFirstTouch{ false };
+  bool ThreadPinning = false;
+#ifdef __linux__
+  cpu_set_t ProcessAffinity;
+#endif
 };
 } // namespace vtkm::cont::internal
 } // namespace vtkm::cont
@@ -7,9 +7,16 @@
 //  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
+#include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/openmp/DeviceAdapterOpenMP.h>
 #include <vtkm/cont/testing/TestingRuntimeDeviceConfiguration.h>
 
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include <vector>
+
 namespace internal = vtkm::cont::internal;
 
 namespace vtkm
@@ -53,6 +60,89 @@ TestingRuntimeDeviceConfiguration<vtkm::cont::DeviceAdapterTagOpenMP>::TestRunti
   VTKM_TEST_ASSERT(setMaxThreads == maxThreads,
                    "RTC's maxThreads != maxThreads openmp direct! " +
                      std::to_string(setMaxThreads) + " != " + std::to_string(maxThreads));
+
+  bool numaFirstTouch = true;
+  VTKM_TEST_ASSERT(config.GetNumaFirstTouch(numaFirstTouch) ==
+                     internal::RuntimeDeviceConfigReturnCode::SUCCESS,
+                   "Failed to get NUMA first touch");
+  VTKM_TEST_ASSERT(!numaFirstTouch, "NUMA first touch should be off by default");
+  VTKM_TEST_ASSERT(config.SetNumaFirstTouch(true) ==
+                     internal::RuntimeDeviceConfigReturnCode::SUCCESS,
+                   "Failed to set NUMA first touch");
+  {
+    // Arrays allocated and copied in this mode must behave as usual.
+    vtkm::cont::ArrayHandle<vtkm::Id> src;
+    vtkm::cont::Algorithm::Fill(DeviceAdapterTagOpenMP{}, src, vtkm::Id{ 7 }, 100000);
+    vtkm::cont::ArrayHandle<vtkm::Id> dest;
+    vtkm::cont::Algorithm::Copy(DeviceAdapterTagOpenMP{}, src, dest);
+    VTKM_TEST_ASSERT(vtkm::cont::Algorithm::Reduce(DeviceAdapterTagOpenMP{}, dest, vtkm::Id{ 0 }) ==
+                       700000,
+                     "Wrong values after NUMA first touch allocation");
+  }
+  config.SetNumaFirstTouch(false);
+
+#ifdef __linux__
+  bool threadPinning = true;
+  VTKM_TEST_ASSERT(config.GetThreadPinning(threadPinning) ==
+                     internal::RuntimeDeviceConfigReturnCode::SUCCESS,
+                   "Failed to get thread pinning");
+  VTKM_TEST_ASSERT(!threadPinning, "Thread pinning should be off by default");
+  cpu_set_t callerAffinity;
+  sched_getaffinity(0, sizeof(callerAffinity), &callerAffinity);
+  VTKM_TEST_ASSERT(config.SetThreadPinning(true) ==
+                     internal::RuntimeDeviceConfigReturnCode::SUCCESS,
+                   "Failed to set thread pinning");
+  // The calling thread is not pinned, so the threads it creates can use every CPU.
+  cpu_set_t pinnedCallerAffinity;
+  sched_getaffinity(0, sizeof(pinnedCallerAffinity), &pinnedCallerAffinity);
+  VTKM_TEST_ASSERT(CPU_EQUAL(&callerAffinity, &pinnedCallerAffinity),
+                   "Thread pinning changed the affinity of the calling thread");
+
+  // Worker thread i is pinned to the i-th CPU available to the process.
+  std::vector<int> cpus;
+  for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+  {
+    if (CPU_ISSET(cpu, &callerAffinity))
+    {
+      cpus.push_back(cpu);
+    }
+  }
+  int badlyPinnedThreads = 0;
+  VTKM_OPENMP_DIRECTIVE(parallel reduction(+ : badlyPinnedThreads))
+  {
+    const int thread = omp_get_thread_num();
+    if (thread != 0)
+    {
+      cpu_set_t threadAffinity;
+      sched_getaffinity(0, sizeof(threadAffinity), &threadAffinity);
+      const int expectedCpu = cpus[static_cast<std::size_t>(thread) % cpus.size()];
+      if ((CPU_COUNT(&threadAffinity) != 1) || !CPU_ISSET(expectedCpu, &threadAffinity))
+      {
+        ++badlyPinnedThreads;
+      }
+    }
+  }
+  VTKM_TEST_ASSERT(badlyPinnedThreads == 0,
+                   std::to_string(badlyPinnedThreads) + " worker threads are not pinned");
+
+  VTKM_TEST_ASSERT(config.SetThreadPinning(false) ==
+                     internal::RuntimeDeviceConfigReturnCode::SUCCESS,
+                   "Failed to reset thread pinning");
+
+  // Turning pinning off gives the worker threads every CPU of the process again.
+  int stillPinnedThreads = 0;
+  VTKM_OPENMP_DIRECTIVE(parallel reduction(+ : stillPinnedThreads))
+  {
+    cpu_set_t threadAffinity;
+    sched_getaffinity(0, sizeof(threadAffinity), &threadAffinity);
+    if (!CPU_EQUAL(&threadAffinity, &callerAffinity))
+    {
+      ++stillPinnedThreads;
+    }
+  }
+  VTKM_TEST_ASSERT(stillPinnedThreads == 0,
+                   std::to_string(stillPinnedThreads) + " worker threads are still pinned");
+#endif
 }
 
 } // namespace vtkm::cont::testing
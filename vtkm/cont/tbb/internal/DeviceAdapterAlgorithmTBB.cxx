@@ -10,6 +10,8 @@
 
 #include <vtkm/cont/tbb/internal/DeviceAdapterAlgorithmTBB.h>
 
+#include <vtkm/cont/RuntimeDeviceInformation.h>
+
 namespace vtkm
 {
 namespace cont
@@ -29,8 +31,19 @@ void DeviceAdapterAlgorithm<vtkm::cont::DeviceAdapterTagTBB>::ScheduleTask(
 
   ::tbb::blocked_range<vtkm::Id> range(0, size, tbb::TBB_GRAIN_SIZE);
 
-  ::tbb::parallel_for(
-    range, [&](const ::tbb::blocked_range<vtkm::Id>& r) { functor(r.begin(), r.end()); });
+  if (tbb::UseNumaFirstTouch())
+  {
+    // Split the range the same way the memory manager first touched the pages of the arrays.
+    ::tbb::parallel_for(
+      range,
+      [&](const ::tbb::blocked_range<vtkm::Id>& r) { functor(r.begin(), r.end()); },
+      ::tbb::static_partitioner{});
+  }
+  else
+  {
+    ::tbb::parallel_for(
+      range, [&](const ::tbb::blocked_range<vtkm::Id>& r) { functor(r.begin(), r.end()); });
+  }
 
   if (errorMessage.IsErrorRaised())
   {
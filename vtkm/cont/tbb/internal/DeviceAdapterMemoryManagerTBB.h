@@ -12,7 +12,9 @@
 
 #include <vtkm/cont/tbb/internal/DeviceAdapterTagTBB.h>
 
+#include <vtkm/cont/RuntimeDeviceInformation.h>
 #include <vtkm/cont/internal/DeviceAdapterMemoryManagerShared.h>
+#include <vtkm/cont/tbb/internal/FunctorsTBB.h>
 
 namespace vtkm
 {
@@ -29,6 +31,29 @@ class DeviceAdapterMemoryManager<vtkm::cont::DeviceAdapterTagTBB>
   {
     return vtkm::cont::DeviceAdapterTagTBB{};
   }
+
+  VTKM_CONT vtkm::cont::internal::BufferInfo Allocate(vtkm::BufferSizeType size) const override
+  {
+    vtkm::cont::internal::BufferInfo info = this->DeviceAdapterMemoryManagerShared::Allocate(size);
+    if (vtkm::cont::tbb::UseNumaFirstTouch())
+    {
+      // Write one byte of each page with the static partitioner that ScheduleTask uses in this
+      // mode, so each page lands on the NUMA node of the thread that will process it.
+      constexpr vtkm::Id pageSize = vtkm::cont::tbb::VTKM_PAGE_SIZE;
+      vtkm::UInt8* data = static_cast<vtkm::UInt8*>(info.GetPointer());
+      const vtkm::Id numPages = (size + pageSize - 1) / pageSize;
+      ::tbb::parallel_for(
+        ::tbb::blocked_range<vtkm::Id>(0, numPages),
+        [&](const ::tbb::blocked_range<vtkm::Id>& r) {
+          for (vtkm::Id page = r.begin(); page < r.end(); ++page)
+          {
+            data[page * pageSize] = 0;
+          }
+        },
+        ::tbb::static_partitioner{});
+    }
+    return info;
+  }
 };
 }
 }
@@ -14,7 +14,9 @@
 #include <vtkm/Types.h>
 #include <vtkm/cont/ArrayPortalToIterators.h>
 #include <vtkm/cont/Error.h>
+#include <vtkm/cont/RuntimeDeviceInformation.h>
 #include <vtkm/cont/internal/FunctorsGeneral.h>
+#include <vtkm/cont/tbb/internal/DeviceAdapterTagTBB.h>
 #include <vtkm/exec/internal/ErrorMessageBuffer.h>
 
 #include <algorithm>
@@ -72,6 +74,22 @@ using WrappedBinaryOperator = vtkm::cont::internal::WrappedBinaryOperator<Result
 // into picking this size.
 static constexpr vtkm::Id TBB_GRAIN_SIZE = 1024;
 
+// The size of a memory page, which is the granularity of NUMA first-touch placement.
+static constexpr vtkm::Id VTKM_PAGE_SIZE = 4096;
+
+// Whether device arrays are placed with NUMA first touch and scheduled to match. The runtime
+// configuration lives as long as the process, so it is looked up once rather than on every
+// schedule and allocation.
+static inline bool UseNumaFirstTouch()
+{
+  static vtkm::cont::internal::RuntimeDeviceConfigurationBase& config =
+    vtkm::cont::RuntimeDeviceInformation{}.GetRuntimeConfiguration(
+      vtkm::cont::DeviceAdapterTagTBB{});
+  bool numaFirstTouch = false;
+  config.GetNumaFirstTouch(numaFirstTouch);
+  return numaFirstTouch;
+}
+
 template <typename InputPortalType, typename OutputPortalType>
 struct CopyBody
 {
@@ -23,6 +23,7 @@ VTKM_THIRDPARTY_PRE_INCLUDE
 #endif
 VTKM_THIRDPARTY_POST_INCLUDE
 
+#include <atomic>
 #include <memory>
 
 namespace vtkm
@@ -79,6 +80,18 @@ public:
     return RuntimeDeviceConfigReturnCode::SUCCESS;
   }
 
+  VTKM_CONT RuntimeDeviceConfigReturnCode SetNumaFirstTouch(bool value) final
+  {
+    this->NumaFirstTouch.store(value);
+    return RuntimeDeviceConfigReturnCode::SUCCESS;
+  }
+
+  VTKM_CONT RuntimeDeviceConfigReturnCode GetNumaFirstTouch(bool& value) const final
+  {
+    value = this->NumaFirstTouch.load();
+    return RuntimeDeviceConfigReturnCode::SUCCESS;
+  }
+
   VTKM_CONT RuntimeDeviceConfigReturnCode GetMaxThreads(vtkm::Id& value) const final
   {
     value = this->HardwareMaxThreads;
@@ -93,6 +106,8 @@ private:
 #endif
   vtkm::Id HardwareMaxThreads;
   vtkm::Id CurrentNumThreads;
+  // Read on every schedule and allocation, possibly from several threads.
+  std::atomic<bool> NumaFirstTouch{ false };
 };
 } // namespace vktm::cont::internal
 } // namespace vtkm::cont
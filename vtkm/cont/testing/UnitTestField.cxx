@@ -0,0 +1,168 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/Field.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+constexpr vtkm::Id ARRAY_SIZE = 100;
+constexpr int NUM_THREADS = 8;
+
+vtkm::cont::Field MakeField()
+{
+  std::vector<vtkm::Float32> values(static_cast<std::size_t>(ARRAY_SIZE));
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = TestValue(static_cast<vtkm::Id>(i), vtkm::Float32{});
+  }
+  return vtkm::cont::make_FieldPoint("field", vtkm::cont::make_ArrayHandleMove(std::move(values)));
+}
+
+// Every third value in reverse order, followed by an index outside of the array.
+vtkm::cont::ArrayHandle<vtkm::Id> MakePermutation()
+{
+  std::vector<vtkm::Id> permutation;
+  for (vtkm::Id i = ARRAY_SIZE - 1; i >= 0; i -= 3)
+  {
+    permutation.push_back(i);
+  }
+  permutation.push_back(ARRAY_SIZE);
+  return vtkm::cont::make_ArrayHandleMove(std::move(permutation));
+}
+
+void CheckPermuted(const vtkm::cont::UnknownArrayHandle& data,
+                   const vtkm::cont::ArrayHandle<vtkm::Id>& permutation)
+{
+  vtkm::cont::ArrayHandle<vtkm::Float32> values;
+  data.AsArrayHandle(values);
+  VTKM_TEST_ASSERT(values.GetNumberOfValues() == permutation.GetNumberOfValues());
+  auto valuePortal = values.ReadPortal();
+  auto permutationPortal = permutation.ReadPortal();
+  for (vtkm::Id i = 0; i < values.GetNumberOfValues(); ++i)
+  {
+    const vtkm::Id index = permutationPortal.Get(i);
+    const vtkm::Float32 expected =
+      index < ARRAY_SIZE ? TestValue(index, vtkm::Float32{}) : vtkm::Float32(-1);
+    VTKM_TEST_ASSERT(test_equal(valuePortal.Get(i), expected), "Bad permuted value at ", i);
+  }
+}
+
+bool SameArray(const vtkm::cont::UnknownArrayHandle& data1,
+               const vtkm::cont::UnknownArrayHandle& data2)
+{
+  return data1.AsArrayHandle<vtkm::cont::ArrayHandle<vtkm::Float32>>() ==
+    data2.AsArrayHandle<vtkm::cont::ArrayHandle<vtkm::Float32>>();
+}
+
+void TestPermute()
+{
+  std::cout << "Permute a field" << std::endl;
+  const vtkm::cont::ArrayHandle<vtkm::Id> permutation = MakePermutation();
+  const vtkm::cont::Field permuted = MakeField().Permute(permutation, -1);
+  VTKM_TEST_ASSERT(permuted.IsDataDeferred());
+  VTKM_TEST_ASSERT(permuted.GetName() == "field");
+  VTKM_TEST_ASSERT(permuted.IsPointField());
+  VTKM_TEST_ASSERT(permuted.GetNumberOfValues() == permutation.GetNumberOfValues());
+
+  // Copies share the deferred values.
+  const vtkm::cont::Field copy = permuted;
+  CheckPermuted(copy.GetData(), permutation);
+  VTKM_TEST_ASSERT(!permuted.IsDataDeferred());
+  VTKM_TEST_ASSERT(SameArray(copy.GetData(), permuted.GetData()));
+}
+
+void TestPermuteTwice()
+{
+  std::cout << "Permute a deferred permutation" << std::endl;
+  const vtkm::cont::ArrayHandle<vtkm::Id> permutation = MakePermutation();
+  const vtkm::cont::Field once = MakeField().Permute(permutation, -1);
+
+  // Picks values 1, 0 and 4 of the first permutation, then an index outside of it.
+  const vtkm::cont::ArrayHandle<vtkm::Id> second = vtkm::cont::make_ArrayHandle<vtkm::Id>(
+    { 1, 0, 4, permutation.GetNumberOfValues() + 2 });
+  const vtkm::cont::Field twice = once.Permute(second, -1);
+  VTKM_TEST_ASSERT(twice.IsDataDeferred());
+  VTKM_TEST_ASSERT(once.IsDataDeferred(), "Permuting materialized the first permutation");
+
+  auto permutationPortal = permutation.ReadPortal();
+  const vtkm::cont::ArrayHandle<vtkm::Id> composed = vtkm::cont::make_ArrayHandle<vtkm::Id>(
+    { permutationPortal.Get(1), permutationPortal.Get(0), permutationPortal.Get(4), ARRAY_SIZE });
+  CheckPermuted(twice.GetData(), composed);
+  VTKM_TEST_ASSERT(once.IsDataDeferred());
+  CheckPermuted(once.GetData(), permutation);
+}
+
+void TestConcurrentMaterialize()
+{
+  std::cout << "Read a deferred field from several threads" << std::endl;
+  const vtkm::cont::ArrayHandle<vtkm::Id> permutation = MakePermutation();
+  const vtkm::cont::Field permuted = MakeField().Permute(permutation, -1);
+
+  std::vector<vtkm::cont::UnknownArrayHandle> results(NUM_THREADS);
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < results.size(); ++t)
+  {
+    threads.emplace_back([&, t]() { results[t] = permuted.GetData(); });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  for (const auto& result : results)
+  {
+    VTKM_TEST_ASSERT(SameArray(result, results[0]), "Threads got different arrays");
+  }
+  CheckPermuted(results[0], permutation);
+
+  std::cout << "Produce deferred data from several threads" << std::endl;
+  std::atomic<int> numCalls(0);
+  vtkm::cont::Field produced("produced", vtkm::cont::Field::Association::Cells, {});
+  produced.SetDeferredData(ARRAY_SIZE, [&numCalls]() {
+    ++numCalls;
+    return vtkm::cont::UnknownArrayHandle(
+      vtkm::cont::make_ArrayHandleConstant(vtkm::Float32(2), ARRAY_SIZE));
+  });
+  const vtkm::cont::Field& constProduced = produced;
+  threads.clear();
+  for (int t = 0; t < NUM_THREADS; ++t)
+  {
+    threads.emplace_back([&]() {
+      constProduced.MaterializeData();
+      VTKM_TEST_ASSERT(constProduced.GetData().GetNumberOfValues() == ARRAY_SIZE);
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  VTKM_TEST_ASSERT(numCalls.load() == 1, "Deferred data produced more than once");
+}
+
+void TestField()
+{
+  TestPermute();
+  TestPermuteTwice();
+  TestConcurrentMaterialize();
+}
+
+} // anonymous namespace
+
+int UnitTestField(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestField, argc, argv);
+}
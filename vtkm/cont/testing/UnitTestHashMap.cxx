@@ -0,0 +1,257 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/HashMap.h>
+
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/AtomicArray.h>
+#include <vtkm/cont/ErrorBadAllocation.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/serial/DeviceAdapterSerial.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <set>
+
+namespace
+{
+
+constexpr vtkm::Id NUM_KEYS = 1000;
+constexpr vtkm::Id NUM_REPEATS = 5;
+
+// Maps index i to one of NUM_KEYS distinct keys so that each key appears
+// NUM_REPEATS times.
+struct RepeatedKey
+{
+  VTKM_EXEC_CONT vtkm::Id operator()(vtkm::Id index) const
+  {
+    return ((index % NUM_KEYS) * 7919) + 3;
+  }
+};
+
+struct FaceKey
+{
+  VTKM_EXEC_CONT vtkm::Id3 operator()(vtkm::Id index) const
+  {
+    vtkm::Id base = index % NUM_KEYS;
+    return vtkm::Id3(base, base + 1, base * 2);
+  }
+};
+
+struct CountKeysWorklet : public vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn key, ExecObject table, AtomicArrayInOut counts);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  template <typename KeyType, typename TableType, typename CountsType>
+  VTKM_EXEC void operator()(const KeyType& key,
+                            const TableType& table,
+                            const CountsType& counts) const
+  {
+    vtkm::Id slot = table.Insert(key);
+    counts.Add(slot, 1);
+  }
+};
+
+void TestHashSet()
+{
+  std::cout << "Testing HashSet" << std::endl;
+
+  auto keys = vtkm::cont::make_ArrayHandleTransform(
+    vtkm::cont::ArrayHandleIndex(NUM_KEYS * NUM_REPEATS), RepeatedKey{});
+
+  vtkm::cont::HashSet<vtkm::Id> set(NUM_KEYS);
+  VTKM_TEST_ASSERT(set.GetCapacity() >= 2 * NUM_KEYS);
+  VTKM_TEST_ASSERT(set.GetNumberOfKeys() == 0);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> slots;
+  set.InsertWithSlots(keys, slots);
+  VTKM_TEST_ASSERT(set.GetNumberOfKeys() == NUM_KEYS);
+
+  auto keysPortal = keys.ReadPortal();
+  auto slotsPortal = slots.ReadPortal();
+  auto slotKeysPortal = set.GetSlotKeys().ReadPortal();
+  for (vtkm::Id index = 0; index < NUM_KEYS * NUM_REPEATS; ++index)
+  {
+    // All copies of a key must land in the same slot.
+    VTKM_TEST_ASSERT(slotsPortal.Get(index) == slotsPortal.Get(index % NUM_KEYS));
+    VTKM_TEST_ASSERT(slotKeysPortal.Get(slotsPortal.Get(index)) == keysPortal.Get(index));
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> uniqueKeys;
+  set.GetKeys(uniqueKeys);
+  VTKM_TEST_ASSERT(uniqueKeys.GetNumberOfValues() == NUM_KEYS);
+  std::set<vtkm::Id> expectedKeys;
+  for (vtkm::Id index = 0; index < NUM_KEYS; ++index)
+  {
+    expectedKeys.insert(RepeatedKey{}(index));
+  }
+  auto uniquePortal = uniqueKeys.ReadPortal();
+  for (vtkm::Id index = 0; index < NUM_KEYS; ++index)
+  {
+    VTKM_TEST_ASSERT(expectedKeys.count(uniquePortal.Get(index)) == 1);
+  }
+
+  // Query keys that are and are not in the set.
+  vtkm::cont::ArrayHandleCounting<vtkm::Id> queries(0, 1, 2 * NUM_KEYS);
+  vtkm::cont::ArrayHandle<vtkm::Id> found;
+  set.Find(queries, found);
+  auto foundPortal = found.ReadPortal();
+  for (vtkm::Id query = 0; query < 2 * NUM_KEYS; ++query)
+  {
+    bool expected = expectedKeys.count(query) == 1;
+    VTKM_TEST_ASSERT((foundPortal.Get(query) >= 0) == expected, "Bad find for ", query);
+  }
+
+  set.Clear();
+  VTKM_TEST_ASSERT(set.GetNumberOfKeys() == 0);
+}
+
+void TestHashSetCounting()
+{
+  std::cout << "Testing HashSet counting with Vec keys" << std::endl;
+
+  auto keys = vtkm::cont::make_ArrayHandleTransform(
+    vtkm::cont::ArrayHandleIndex(NUM_KEYS * NUM_REPEATS), FaceKey{});
+
+  vtkm::cont::HashSet<vtkm::Id3> set(NUM_KEYS);
+  vtkm::cont::ArrayHandle<vtkm::Id> counts;
+  counts.AllocateAndFill(set.GetCapacity(), 0);
+
+  vtkm::cont::Invoker invoke;
+  invoke(CountKeysWorklet{}, keys, set, counts);
+
+  VTKM_TEST_ASSERT(set.GetNumberOfKeys() == NUM_KEYS);
+  auto statesPortal = set.GetSlotStates().ReadPortal();
+  auto countsPortal = counts.ReadPortal();
+  for (vtkm::Id slot = 0; slot < set.GetCapacity(); ++slot)
+  {
+    if (vtkm::cont::internal::HashSlotIsOccupied{}(statesPortal.Get(slot)))
+    {
+      VTKM_TEST_ASSERT(countsPortal.Get(slot) == NUM_REPEATS);
+    }
+    else
+    {
+      VTKM_TEST_ASSERT(countsPortal.Get(slot) == 0);
+    }
+  }
+}
+
+void TestHashMap()
+{
+  std::cout << "Testing HashMap" << std::endl;
+
+  vtkm::cont::ArrayHandleCounting<vtkm::Id> keys(10, 3, NUM_KEYS);
+  vtkm::cont::ArrayHandleCounting<vtkm::FloatDefault> values(0, 0.5f, NUM_KEYS);
+
+  vtkm::cont::HashMap<vtkm::Id, vtkm::FloatDefault> map(NUM_KEYS);
+  vtkm::cont::ArrayHandle<vtkm::Id> slots;
+  map.InsertWithSlots(keys, values, slots);
+  VTKM_TEST_ASSERT(map.GetNumberOfKeys() == NUM_KEYS);
+  auto slotsPortal = slots.ReadPortal();
+  auto slotValuesPortal = map.GetSlotValues().ReadPortal();
+  for (vtkm::Id index = 0; index < NUM_KEYS; ++index)
+  {
+    VTKM_TEST_ASSERT(test_equal(slotValuesPortal.Get(slotsPortal.Get(index)),
+                                0.5f * static_cast<float>(index)));
+  }
+
+  vtkm::cont::ArrayHandleCounting<vtkm::Id> queries(10, 1, 3 * NUM_KEYS);
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> result;
+  map.Lookup(queries, result, -1.0f);
+  auto resultPortal = result.ReadPortal();
+  for (vtkm::Id index = 0; index < 3 * NUM_KEYS; ++index)
+  {
+    if ((index % 3) == 0)
+    {
+      VTKM_TEST_ASSERT(test_equal(resultPortal.Get(index), 0.5f * static_cast<float>(index / 3)));
+    }
+    else
+    {
+      VTKM_TEST_ASSERT(test_equal(resultPortal.Get(index), -1.0f));
+    }
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> entryKeys;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> entryValues;
+  map.GetEntries(entryKeys, entryValues);
+  VTKM_TEST_ASSERT(entryKeys.GetNumberOfValues() == NUM_KEYS);
+  VTKM_TEST_ASSERT(entryValues.GetNumberOfValues() == NUM_KEYS);
+  auto entryKeysPortal = entryKeys.ReadPortal();
+  auto entryValuesPortal = entryValues.ReadPortal();
+  for (vtkm::Id index = 0; index < NUM_KEYS; ++index)
+  {
+    vtkm::Id key = entryKeysPortal.Get(index);
+    VTKM_TEST_ASSERT(test_equal(entryValuesPortal.Get(index),
+                                0.5f * static_cast<float>((key - 10) / 3)));
+  }
+}
+
+void TestOverflow()
+{
+  std::cout << "Testing capacity overflow" << std::endl;
+
+  vtkm::cont::HashSet<vtkm::Id> set(4);
+  bool caughtError = false;
+  try
+  {
+    set.Insert(vtkm::cont::ArrayHandleCounting<vtkm::Id>(0, 1, 3 * set.GetCapacity()));
+  }
+  catch (vtkm::cont::ErrorBadAllocation& error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    caughtError = true;
+  }
+  VTKM_TEST_ASSERT(caughtError, "Did not get error for overfilled table.");
+}
+
+void TestDevices()
+{
+  std::cout << "Testing supported devices" << std::endl;
+
+  VTKM_TEST_ASSERT(vtkm::cont::internal::IsHashTableDevice(vtkm::cont::DeviceAdapterTagSerial{}));
+  vtkm::cont::DeviceAdapterId cuda = vtkm::cont::make_DeviceAdapterId(VTKM_DEVICE_ADAPTER_CUDA);
+  VTKM_TEST_ASSERT(!vtkm::cont::internal::IsHashTableDevice(cuda));
+
+  vtkm::cont::HashSet<vtkm::Id> set(4);
+  bool caughtError = false;
+  try
+  {
+    vtkm::cont::Token token;
+    set.PrepareForExecution(cuda, token);
+  }
+  catch (vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    caughtError = true;
+  }
+  VTKM_TEST_ASSERT(caughtError, "Did not get error for a GPU device.");
+}
+
+void Run()
+{
+  TestHashSet();
+  TestHashSetCounting();
+  TestHashMap();
+  TestOverflow();
+  TestDevices();
+}
+
+} // anonymous namespace
+
+int UnitTestHashMap(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(Run, argc, argv);
+}
@@ -81,9 +81,59 @@ static void MergePartitionedDataSetTest()
                    "Incorrect number of cells");
 }
 
+static void MergeDeferredFieldsTest()
+{
+  vtkm::cont::testing::MakeTestDataSet testDataSet;
+  vtkm::cont::PartitionedDataSet pds;
+  pds.AppendPartition(testDataSet.Make3DExplicitDataSet0());
+  pds.AppendPartition(testDataSet.Make3DExplicitDataSet1());
+  pds.AppendPartition(testDataSet.Make3DExplicitDataSet2());
+
+  vtkm::cont::DataSet expected = vtkm::cont::MergePartitionedDataSet(pds);
+  vtkm::cont::DataSet merged = vtkm::cont::MergePartitionedDataSet(pds, vtkm::Nan64(), true);
+
+  VTKM_TEST_ASSERT(merged.GetNumberOfFields() == expected.GetNumberOfFields());
+  for (vtkm::IdComponent fieldIndex = 0; fieldIndex < merged.GetNumberOfFields(); ++fieldIndex)
+  {
+    const vtkm::cont::Field& field = merged.GetField(fieldIndex);
+    VTKM_TEST_ASSERT(field.IsDataDeferred(), "Field was merged before it was used");
+    const vtkm::cont::Field& expectedField =
+      expected.GetField(field.GetName(), field.GetAssociation());
+    VTKM_TEST_ASSERT(field.GetNumberOfValues() == expectedField.GetNumberOfValues());
+  }
+  VTKM_TEST_ASSERT(test_equal_DataSets(merged, expected), "Deferred merge gave different results");
+  VTKM_TEST_ASSERT(!merged.GetField("pointvar").IsDataDeferred());
+
+  // A single partition is copied, unless the merge is deferred.
+  vtkm::cont::DataSet single = testDataSet.Make3DExplicitDataSet0();
+  vtkm::cont::PartitionedDataSet singlePds;
+  singlePds.AppendPartition(single);
+  vtkm::cont::ArrayHandle<vtkm::Float32> singleArray;
+  single.GetField("pointvar").GetData().AsArrayHandle(singleArray);
+
+  vtkm::cont::DataSet singleCopied = vtkm::cont::MergePartitionedDataSet(singlePds);
+  VTKM_TEST_ASSERT(test_equal_DataSets(singleCopied, single));
+  vtkm::cont::ArrayHandle<vtkm::Float32> singleCopiedArray;
+  singleCopied.GetField("pointvar").GetData().AsArrayHandle(singleCopiedArray);
+  VTKM_TEST_ASSERT(singleCopiedArray != singleArray, "Single partition field was shared");
+
+  vtkm::cont::DataSet singleShared =
+    vtkm::cont::MergePartitionedDataSet(singlePds, vtkm::Nan64(), true);
+  VTKM_TEST_ASSERT(test_equal_DataSets(singleShared, single));
+  vtkm::cont::ArrayHandle<vtkm::Float32> singleSharedArray;
+  singleShared.GetField("pointvar").GetData().AsArrayHandle(singleSharedArray);
+  VTKM_TEST_ASSERT(singleSharedArray == singleArray, "Single partition field was copied");
+}
+
+static void TestMergePartitionedDataSet()
+{
+  MergePartitionedDataSetTest();
+  MergeDeferredFieldsTest();
+}
+
 int UnitTestMergePartitionedDataSet(int argc, char* argv[])
 {
   //More test cases can be found in the vtkm/filter/multi_block/testing/UnitTestMergeDataSetsFilter.cxx
   //which is a filter that wraps MergePartitionedDataSet algorithm.
-  return vtkm::cont::testing::Testing::Run(MergePartitionedDataSetTest, argc, argv);
+  return vtkm::cont::testing::Testing::Run(TestMergePartitionedDataSet, argc, argv);
 }
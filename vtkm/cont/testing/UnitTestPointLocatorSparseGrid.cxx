@@ -16,6 +16,7 @@
 
 #include <vtkm/worklet/WorkletMapField.h>
 
+#include <algorithm>
 #include <random>
 
 namespace
@@ -181,9 +182,146 @@ void TestTest()
   VTKM_TEST_ASSERT(passTest, "Uniform Grid NN search result incorrect.");
 }
 
+vtkm::FloatDefault Distance2(const vtkm::Vec3f& p1, const vtkm::Vec3f& p2)
+{
+  return vtkm::MagnitudeSquared(p1 - p2);
+}
+
+void TestNeighborQueries()
+{
+  std::cout << "Testing k nearest neighbor and radius queries." << std::endl;
+
+  std::default_random_engine dre(42);
+  std::uniform_real_distribution<vtkm::FloatDefault> dr(0.0f, 10.0f);
+  std::normal_distribution<vtkm::FloatDefault> cluster(2.0f, 0.3f);
+
+  // Mix uniformly spread points with a dense cluster so that bins are very uneven.
+  std::vector<vtkm::Vec3f> coords;
+  for (vtkm::Id i = 0; i < 1500; ++i)
+  {
+    coords.push_back(vtkm::make_Vec(dr(dre), dr(dre), dr(dre)));
+  }
+  for (vtkm::Id i = 0; i < 500; ++i)
+  {
+    coords.push_back(vtkm::make_Vec(cluster(dre), cluster(dre), cluster(dre)));
+  }
+  vtkm::cont::CoordinateSystem coordSystem(
+    "points", vtkm::cont::make_ArrayHandle(coords, vtkm::CopyFlag::Off));
+
+  // Some query points are outside of the points' bounds.
+  std::uniform_real_distribution<vtkm::FloatDefault> qr(-2.0f, 12.0f);
+  std::vector<vtkm::Vec3f> queries;
+  for (vtkm::Id i = 0; i < 200; ++i)
+  {
+    queries.push_back(vtkm::make_Vec(qr(dre), qr(dre), qr(dre)));
+  }
+  queries.push_back(vtkm::make_Vec(2.0f, 2.0f, 2.0f));
+  auto queryArray = vtkm::cont::make_ArrayHandle(queries, vtkm::CopyFlag::Off);
+
+  vtkm::cont::PointLocatorSparseGrid locator;
+  locator.SetCoordinates(coordSystem);
+  locator.SetNumberOfBins({ 16, 16, 16 });
+
+  for (vtkm::IdComponent k : { 1, 7, 30, 64 })
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> ids;
+    vtkm::cont::ArrayHandle<vtkm::FloatDefault> dist2;
+    locator.FindKNearestNeighbors(queryArray, k, ids, dist2);
+    VTKM_TEST_ASSERT(ids.GetNumberOfValues() == static_cast<vtkm::Id>(queries.size()) * k);
+
+    auto idPortal = ids.ReadPortal();
+    auto distPortal = dist2.ReadPortal();
+    for (std::size_t q = 0; q < queries.size(); ++q)
+    {
+      std::vector<vtkm::FloatDefault> expected;
+      for (const auto& point : coords)
+      {
+        expected.push_back(Distance2(point, queries[q]));
+      }
+      std::partial_sort(expected.begin(), expected.begin() + k, expected.end());
+
+      for (vtkm::IdComponent i = 0; i < k; ++i)
+      {
+        vtkm::Id index = static_cast<vtkm::Id>(q) * k + i;
+        vtkm::Id id = idPortal.Get(index);
+        VTKM_TEST_ASSERT(test_equal(distPortal.Get(index), expected[static_cast<std::size_t>(i)]),
+                         "Wrong distance for neighbor ",
+                         i,
+                         " of query ",
+                         q,
+                         " with k = ",
+                         k);
+        VTKM_TEST_ASSERT(id >= 0 && id < static_cast<vtkm::Id>(coords.size()));
+        VTKM_TEST_ASSERT(
+          test_equal(Distance2(coords[static_cast<std::size_t>(id)], queries[q]),
+                     distPortal.Get(index)),
+          "Neighbor id does not match its distance.");
+      }
+    }
+  }
+
+  // Asking for more neighbors than there are points leaves the extra neighbors empty.
+  {
+    vtkm::cont::PointLocatorSparseGrid smallLocator;
+    smallLocator.SetCoordinates(vtkm::cont::CoordinateSystem(
+      "points", vtkm::cont::make_ArrayHandle({ vtkm::Vec3f(0, 0, 0), vtkm::Vec3f(1, 1, 1) })));
+    vtkm::cont::ArrayHandle<vtkm::Id> ids;
+    vtkm::cont::ArrayHandle<vtkm::FloatDefault> dist2;
+    smallLocator.FindKNearestNeighbors(
+      vtkm::cont::make_ArrayHandle({ vtkm::Vec3f(0.9f, 0.9f, 0.9f) }), 4, ids, dist2);
+    VTKM_TEST_ASSERT(
+      test_equal_ArrayHandles(ids, vtkm::cont::make_ArrayHandle<vtkm::Id>({ 1, 0, -1, -1 })));
+  }
+
+  for (vtkm::FloatDefault radius : { 0.0f, 0.4f, 1.5f })
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> offsets;
+    vtkm::cont::ArrayHandle<vtkm::Id> ids;
+    vtkm::cont::ArrayHandle<vtkm::FloatDefault> dist2;
+    locator.FindNeighborsInRadius(queryArray, radius, offsets, ids, dist2);
+    VTKM_TEST_ASSERT(offsets.GetNumberOfValues() == static_cast<vtkm::Id>(queries.size()) + 1);
+
+    auto offsetPortal = offsets.ReadPortal();
+    auto idPortal = ids.ReadPortal();
+    auto distPortal = dist2.ReadPortal();
+    VTKM_TEST_ASSERT(offsetPortal.Get(static_cast<vtkm::Id>(queries.size())) ==
+                     ids.GetNumberOfValues());
+    for (std::size_t q = 0; q < queries.size(); ++q)
+    {
+      std::vector<vtkm::Id> expected;
+      for (std::size_t p = 0; p < coords.size(); ++p)
+      {
+        if (Distance2(coords[p], queries[q]) <= radius * radius)
+        {
+          expected.push_back(static_cast<vtkm::Id>(p));
+        }
+      }
+
+      std::vector<vtkm::Id> found;
+      for (vtkm::Id i = offsetPortal.Get(static_cast<vtkm::Id>(q));
+           i < offsetPortal.Get(static_cast<vtkm::Id>(q) + 1);
+           ++i)
+      {
+        vtkm::Id id = idPortal.Get(i);
+        found.push_back(id);
+        VTKM_TEST_ASSERT(test_equal(distPortal.Get(i),
+                                    Distance2(coords[static_cast<std::size_t>(id)], queries[q])));
+      }
+      std::sort(found.begin(), found.end());
+      VTKM_TEST_ASSERT(found == expected, "Wrong neighbors in radius ", radius, " of query ", q);
+    }
+  }
+}
+
+void TestPointLocatorSparseGrid()
+{
+  TestTest();
+  TestNeighborQueries();
+}
+
 } // anonymous namespace
 
 int UnitTestPointLocatorSparseGrid(int argc, char* argv[])
 {
-  return vtkm::cont::testing::Testing::Run(TestTest, argc, argv);
+  return vtkm::cont::testing::Testing::Run(TestPointLocatorSparseGrid, argc, argv);
 }
@@ -0,0 +1,159 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/ThreadPool.h>
+
+#include <vtkm/cont/testing/Testing.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <thread>
+
+namespace
+{
+
+constexpr vtkm::Id NUM_TASKS = 100;
+
+std::vector<vtkm::Id> MakeOrder(vtkm::Id numTasks)
+{
+  std::vector<vtkm::Id> order(static_cast<std::size_t>(numTasks));
+  std::iota(order.rbegin(), order.rend(), vtkm::Id{ 0 });
+  return order;
+}
+
+void TestAllTasksRun()
+{
+  std::cout << "Check that every task runs once." << std::endl;
+  vtkm::cont::ThreadPool pool;
+
+  for (vtkm::Id numThreads : { 1, 2, 4 })
+  {
+    std::vector<std::atomic<vtkm::Id>> counts(NUM_TASKS);
+    for (auto& count : counts)
+    {
+      count = 0;
+    }
+    pool.Execute(
+      MakeOrder(NUM_TASKS),
+      [&](vtkm::Id index) { ++counts[static_cast<std::size_t>(index)]; },
+      numThreads);
+    for (auto& count : counts)
+    {
+      VTKM_TEST_ASSERT(count.load() == 1, "Task did not run exactly once.");
+    }
+    VTKM_TEST_ASSERT(pool.GetNumberOfWorkerThreads() == numThreads - 1,
+                     "Unexpected number of worker threads.");
+  }
+
+  std::cout << "Check that workers are reused." << std::endl;
+  pool.Execute(MakeOrder(NUM_TASKS), [](vtkm::Id) {}, 2);
+  VTKM_TEST_ASSERT(pool.GetNumberOfWorkerThreads() == 3, "Worker threads were not reused.");
+}
+
+void TestOrder()
+{
+  std::cout << "Check that tasks start in the given order." << std::endl;
+  vtkm::cont::ThreadPool pool;
+
+  std::vector<vtkm::Id> order = MakeOrder(NUM_TASKS);
+  std::vector<vtkm::Id> visited;
+  pool.Execute(
+    order, [&](vtkm::Id index) { visited.push_back(index); }, 1);
+  VTKM_TEST_ASSERT(visited == order, "Tasks ran out of order.");
+  VTKM_TEST_ASSERT(pool.GetNumberOfWorkerThreads() == 0, "Serial execution created threads.");
+}
+
+void TestMaximumThreads()
+{
+  std::cout << "Check the maximum number of threads." << std::endl;
+  vtkm::cont::ThreadPool pool;
+  pool.SetMaximumNumberOfThreads(2);
+  VTKM_TEST_ASSERT(pool.GetMaximumNumberOfThreads() == 2);
+
+  std::mutex mutex;
+  std::vector<std::thread::id> threadIds;
+  pool.Execute(
+    MakeOrder(NUM_TASKS),
+    [&](vtkm::Id) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (std::find(threadIds.begin(), threadIds.end(), std::this_thread::get_id()) ==
+          threadIds.end())
+      {
+        threadIds.push_back(std::this_thread::get_id());
+      }
+    },
+    8);
+  VTKM_TEST_ASSERT(threadIds.size() <= 2, "Too many threads ran tasks.");
+  VTKM_TEST_ASSERT(pool.GetNumberOfWorkerThreads() == 1, "Too many worker threads created.");
+}
+
+void TestNested()
+{
+  std::cout << "Check calling Execute from within a task." << std::endl;
+  vtkm::cont::ThreadPool pool;
+
+  std::atomic<vtkm::Id> count{ 0 };
+  pool.Execute(
+    MakeOrder(4),
+    [&](vtkm::Id) {
+      pool.Execute(
+        MakeOrder(10), [&](vtkm::Id) { ++count; }, 3);
+    },
+    3);
+  VTKM_TEST_ASSERT(count.load() == 40, "Nested tasks did not all run.");
+}
+
+void TestException()
+{
+  std::cout << "Check that exceptions are passed to the caller." << std::endl;
+  vtkm::cont::ThreadPool pool;
+
+  std::atomic<vtkm::Id> count{ 0 };
+  bool caught = false;
+  try
+  {
+    pool.Execute(
+      MakeOrder(NUM_TASKS),
+      [&](vtkm::Id index) {
+        ++count;
+        if (index == 10)
+        {
+          throw vtkm::cont::ErrorBadValue("Expected error.");
+        }
+      },
+      4);
+  }
+  catch (vtkm::cont::ErrorBadValue& error)
+  {
+    std::cout << "  Caught: " << error.GetMessage() << std::endl;
+    caught = true;
+  }
+  VTKM_TEST_ASSERT(caught, "Exception was not passed to the caller.");
+  VTKM_TEST_ASSERT(count.load() == NUM_TASKS, "Remaining tasks did not run.");
+}
+
+void DoTest()
+{
+  TestAllTasksRun();
+  TestOrder();
+  TestMaximumThreads();
+  TestNested();
+  TestException();
+}
+
+} // anonymous namespace
+
+int UnitTestThreadPool(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(DoTest, argc, argv);
+}
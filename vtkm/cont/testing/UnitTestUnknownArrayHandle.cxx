@@ -23,6 +23,10 @@
 
 #include <vtkm/cont/testing/Testing.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 namespace
 {
 
@@ -691,6 +695,100 @@ void TryConvertRuntimeVec()
   }
 }
 
+struct RecordNumComponentsFunctor
+{
+  template <typename T, typename S>
+  void operator()(const vtkm::cont::ArrayHandle<T, S>&, vtkm::IdComponent& numComponents) const
+  {
+    numComponents = vtkm::VecTraits<T>::NUM_COMPONENTS;
+  }
+};
+
+void TryRepeatedCastAndCall()
+{
+  // CastAndCall remembers where it found each array type. Make sure that alternating between
+  // array types, including ArrayHandleRuntimeVec whose match depends on its number of
+  // components, always finds the right type.
+  using TypeList = vtkm::List<vtkm::Float32, vtkm::Vec3f_32>;
+  using StorageList = vtkm::List<vtkm::cont::StorageTagBasic>;
+
+  vtkm::cont::ArrayHandle<vtkm::Float32> scalars;
+  scalars.Allocate(ARRAY_SIZE);
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_32> vectors;
+  vectors.Allocate(ARRAY_SIZE);
+  vtkm::cont::ArrayHandleRuntimeVec<vtkm::Float32> runtimeScalars(1);
+  runtimeScalars.Allocate(ARRAY_SIZE);
+  vtkm::cont::ArrayHandleRuntimeVec<vtkm::Float32> runtimeVectors(3);
+  runtimeVectors.Allocate(ARRAY_SIZE);
+  vtkm::cont::ArrayHandleRuntimeVec<vtkm::Float32> runtimeOther(2);
+  runtimeOther.Allocate(ARRAY_SIZE);
+
+  for (int repeat = 0; repeat < 3; ++repeat)
+  {
+    for (auto&& item : { std::make_pair(vtkm::cont::UnknownArrayHandle(scalars), 1),
+                         std::make_pair(vtkm::cont::UnknownArrayHandle(vectors), 3),
+                         std::make_pair(vtkm::cont::UnknownArrayHandle(runtimeScalars), 1),
+                         std::make_pair(vtkm::cont::UnknownArrayHandle(runtimeVectors), 3) })
+    {
+      vtkm::IdComponent numComponents = 0;
+      item.first.CastAndCallForTypes<TypeList, StorageList>(RecordNumComponentsFunctor{},
+                                                            numComponents);
+      VTKM_TEST_ASSERT(numComponents == item.second, "CastAndCall found the wrong type.");
+    }
+
+    bool threw = false;
+    try
+    {
+      vtkm::IdComponent numComponents = 0;
+      vtkm::cont::UnknownArrayHandle(runtimeOther)
+        .CastAndCallForTypes<TypeList, StorageList>(RecordNumComponentsFunctor{}, numComponents);
+    }
+    catch (vtkm::cont::ErrorBadType&)
+    {
+      threw = true;
+    }
+    VTKM_TEST_ASSERT(threw, "CastAndCall should fail for a Vec of 2 components.");
+  }
+}
+
+void TryConcurrentCastAndCall()
+{
+  // Threads fill the dispatch cache while others read it. This list is not used elsewhere, so
+  // the cache starts empty.
+  using TypeList = vtkm::List<vtkm::Int16, vtkm::Vec2i_16, vtkm::Vec3i_16, vtkm::Vec4i_16>;
+  using StorageList = vtkm::List<vtkm::cont::StorageTagBasic>;
+
+  std::vector<std::pair<vtkm::cont::UnknownArrayHandle, vtkm::IdComponent>> items;
+  items.emplace_back(vtkm::cont::ArrayHandle<vtkm::Int16>{}, 1);
+  items.emplace_back(vtkm::cont::ArrayHandle<vtkm::Vec2i_16>{}, 2);
+  items.emplace_back(vtkm::cont::ArrayHandle<vtkm::Vec3i_16>{}, 3);
+  items.emplace_back(vtkm::cont::ArrayHandle<vtkm::Vec4i_16>{}, 4);
+
+  std::atomic<int> numWrong(0);
+  std::vector<std::thread> threads;
+  for (std::size_t thread = 0; thread < 8; ++thread)
+  {
+    threads.emplace_back([&, thread]() {
+      for (std::size_t call = 0; call < 1000; ++call)
+      {
+        const auto& item = items[(thread + call) % items.size()];
+        vtkm::IdComponent numComponents = 0;
+        item.first.CastAndCallForTypes<TypeList, StorageList>(RecordNumComponentsFunctor{},
+                                                              numComponents);
+        if (numComponents != item.second)
+        {
+          ++numWrong;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  VTKM_TEST_ASSERT(numWrong.load() == 0, "Concurrent CastAndCall found the wrong type.");
+}
+
 struct DefaultTypeFunctor
 {
   template <typename T>
@@ -728,6 +826,12 @@ void TestUnknownArrayHandle()
 
   std::cout << "Try converting between ArrayHandleRuntimeVec and basic array" << std::endl;
   TryConvertRuntimeVec();
+
+  std::cout << "Try repeated CastAndCall with different arrays" << std::endl;
+  TryRepeatedCastAndCall();
+
+  std::cout << "Try CastAndCall from several threads" << std::endl;
+  TryConcurrentCastAndCall();
 }
 
 } // anonymous namespace
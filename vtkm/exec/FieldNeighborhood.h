@@ -141,6 +141,73 @@ struct FieldNeighborhood<vtkm::internal::ArrayPortalUniformPointCoordinates>
   vtkm::exec::BoundaryState const* const Boundary;
   vtkm::internal::ArrayPortalUniformPointCoordinates Portal;
 };
+
+namespace internal
+{
+
+/// \brief A neighborhood of field values staged in a contiguous scratch buffer.
+///
+/// `Center` points to the value of the visited element and the strides step to the
+/// neighbors along each axis. The buffer holds a halo around the visited elements that
+/// is already clamped to the boundary, so no bounds checking is needed. A stride of 0
+/// makes every neighbor along an axis with a single point resolve to the visited plane.
+template <typename T>
+struct NeighborhoodTile
+{
+  using ValueType = T;
+
+  const T* Center;
+  vtkm::Id3 Strides;
+};
+
+} // namespace internal
+
+/// \brief Specialization of Neighborhood for values staged in a scratch tile.
+///
+/// Both `Get` and `GetUnchecked` are plain offset computations, because the values
+/// beyond the boundary were clamped when the tile was filled.
+template <typename T>
+struct FieldNeighborhood<vtkm::exec::internal::NeighborhoodTile<T>>
+{
+  VTKM_EXEC
+  FieldNeighborhood(const vtkm::exec::internal::NeighborhoodTile<T>& portal,
+                    const vtkm::exec::BoundaryState& boundary)
+    : Boundary(&boundary)
+    , Portal(portal)
+  {
+  }
+
+  using ValueType = T;
+
+  VTKM_EXEC
+  ValueType Get(vtkm::IdComponent i, vtkm::IdComponent j, vtkm::IdComponent k) const
+  {
+    return this->Portal.Center[i * this->Portal.Strides[0] + j * this->Portal.Strides[1] +
+                               k * this->Portal.Strides[2]];
+  }
+
+  VTKM_EXEC
+  ValueType GetUnchecked(vtkm::IdComponent i, vtkm::IdComponent j, vtkm::IdComponent k) const
+  {
+    return this->Get(i, j, k);
+  }
+
+  template <typename IndexType>
+  VTKM_EXEC ValueType Get(const vtkm::Vec<IndexType, 3>& ijk) const
+  {
+    return this->Portal.Center[ijk[0] * this->Portal.Strides[0] +
+                               ijk[1] * this->Portal.Strides[1] + ijk[2] * this->Portal.Strides[2]];
+  }
+
+  template <typename IndexType>
+  VTKM_EXEC ValueType GetUnchecked(const vtkm::Vec<IndexType, 3>& ijk) const
+  {
+    return this->Get(ijk);
+  }
+
+  vtkm::exec::BoundaryState const* const Boundary;
+  vtkm::exec::internal::NeighborhoodTile<T> Portal;
+};
 }
 } // namespace vtkm::exec
 
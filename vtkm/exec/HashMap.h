@@ -0,0 +1,278 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_exec_HashMap_h
+#define vtk_m_exec_HashMap_h
+
+#include <vtkm/Hash.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/exec/AtomicArrayExecutionObject.h>
+
+namespace vtkm
+{
+namespace exec
+{
+
+namespace internal
+{
+
+/// States that a slot in a `vtkm::exec::HashSet` or `vtkm::exec::HashMap` can be in.
+/// A slot moves from `Empty` to `Reserved` when a thread claims it with a compare and
+/// exchange and from `Reserved` to `Occupied` once the key (and value) is written.
+enum struct HashSlotState : vtkm::UInt32
+{
+  Empty = 0,
+  Reserved = 1,
+  Occupied = 2
+};
+
+/// The hashes returned by `vtkm::Hash` are not well mixed in the low bits for small
+/// integer keys. Since the hash tables use the low bits to select a slot, apply the
+/// MurmurHash3 finalizer to spread the bits.
+VTKM_EXEC_CONT inline vtkm::HashType HashMix(vtkm::HashType hash)
+{
+  hash ^= hash >> 16;
+  hash *= 0x85ebca6b;
+  hash ^= hash >> 13;
+  hash *= 0xc2b2ae35;
+  hash ^= hash >> 16;
+  return hash;
+}
+
+} // namespace internal
+
+/// \brief Execution object for a fixed-capacity, open-addressing hash set.
+///
+/// `HashSet` is the execution side of `vtkm::cont::HashSet`. Keys are placed in a
+/// power-of-two sized table using linear probing. A thread claims an empty slot with an
+/// atomic compare and exchange, writes the key, and then publishes the slot. Other threads
+/// that probe a slot while it is being published wait for the key to become visible. This
+/// wait requires threads that make independent progress, so the table must only be used on
+/// host devices. `vtkm::cont::HashSet` refuses to prepare it for any other device.
+///
+/// The key type must be an integer or a `vtkm::Vec` of integers (anything that can be
+/// passed to `vtkm::Hash`).
+///
+template <typename KeyType>
+class HashSet
+{
+  using KeyPortalType = typename vtkm::cont::ArrayHandle<KeyType>::WritePortalType;
+  using StateType = vtkm::UInt32;
+
+public:
+  HashSet() = default;
+
+  VTKM_CONT HashSet(const vtkm::cont::ArrayHandle<KeyType>& keys,
+                    const vtkm::cont::ArrayHandle<StateType>& states,
+                    vtkm::cont::DeviceAdapterId device,
+                    vtkm::cont::Token& token)
+    : Keys(keys.PrepareForInPlace(device, token))
+    , States(states, device, token)
+    , Mask(keys.GetNumberOfValues() - 1)
+  {
+  }
+
+  /// Returns the number of slots in the table.
+  VTKM_EXEC vtkm::Id GetCapacity() const { return this->Mask + 1; }
+
+  /// Adds a key to the set. Returns the slot that holds the key, which is stable for the
+  /// life of the table. `inserted` is set to true if this call added the key and false
+  /// if the key was already present. If the table is full, -1 is returned.
+  VTKM_EXEC vtkm::Id Insert(const KeyType& key, bool& inserted) const
+  {
+    vtkm::Id slot = this->ReserveSlot(key, inserted);
+    if (inserted)
+    {
+      this->PublishSlot(slot);
+    }
+    return slot;
+  }
+
+  VTKM_EXEC vtkm::Id Insert(const KeyType& key) const
+  {
+    bool inserted;
+    return this->Insert(key, inserted);
+  }
+
+  /// Returns the slot holding the given key or -1 if the key is not in the set.
+  VTKM_EXEC vtkm::Id Find(const KeyType& key) const
+  {
+    vtkm::Id slot = this->StartSlot(key);
+    for (vtkm::Id probe = 0; probe <= this->Mask; ++probe)
+    {
+      StateType state = this->WaitForSlot(slot);
+      if (state == static_cast<StateType>(internal::HashSlotState::Empty))
+      {
+        return -1;
+      }
+      if (this->Keys.Get(slot) == key)
+      {
+        return slot;
+      }
+      slot = (slot + 1) & this->Mask;
+    }
+    return -1;
+  }
+
+  VTKM_EXEC bool Contains(const KeyType& key) const { return this->Find(key) >= 0; }
+
+  /// Returns true if the given slot holds a key.
+  VTKM_EXEC bool IsOccupied(vtkm::Id slot) const
+  {
+    return this->States.Get(slot) == static_cast<StateType>(internal::HashSlotState::Occupied);
+  }
+
+  /// Returns the key stored in an occupied slot.
+  VTKM_EXEC KeyType GetKey(vtkm::Id slot) const { return this->Keys.Get(slot); }
+
+protected:
+  VTKM_EXEC vtkm::Id StartSlot(const KeyType& key) const
+  {
+    return static_cast<vtkm::Id>(internal::HashMix(vtkm::Hash(key))) & this->Mask;
+  }
+
+  // Spin while another thread is between reserving a slot and publishing it. The thread
+  // that reserved the slot must be able to progress while this one spins, which is true
+  // for the host devices but not for the threads of a GPU warp.
+  VTKM_EXEC StateType WaitForSlot(vtkm::Id slot) const
+  {
+    StateType state = this->States.Get(slot);
+    while (state == static_cast<StateType>(internal::HashSlotState::Reserved))
+    {
+      state = this->States.Get(slot);
+    }
+    return state;
+  }
+
+  // Finds the slot for the key, claiming an empty slot if the key is not present. When
+  // `reserved` is set to true, the key has been written but the slot is not visible to
+  // other threads until `PublishSlot` is called.
+  VTKM_EXEC vtkm::Id ReserveSlot(const KeyType& key, bool& reserved) const
+  {
+    reserved = false;
+    vtkm::Id slot = this->StartSlot(key);
+    for (vtkm::Id probe = 0; probe <= this->Mask; ++probe)
+    {
+      StateType state = this->States.Get(slot);
+      if (state == static_cast<StateType>(internal::HashSlotState::Empty))
+      {
+        if (this->States.CompareExchange(
+              slot, &state, static_cast<StateType>(internal::HashSlotState::Reserved)))
+        {
+          this->Keys.Set(slot, key);
+          reserved = true;
+          return slot;
+        }
+        // Lost the race for this slot. `state` now holds the current value.
+      }
+      if (state == static_cast<StateType>(internal::HashSlotState::Reserved))
+      {
+        this->WaitForSlot(slot);
+      }
+      if (this->Keys.Get(slot) == key)
+      {
+        return slot;
+      }
+      slot = (slot + 1) & this->Mask;
+    }
+    return -1;
+  }
+
+  VTKM_EXEC void PublishSlot(vtkm::Id slot) const
+  {
+    this->States.Set(slot,
+                     static_cast<StateType>(internal::HashSlotState::Occupied),
+                     vtkm::MemoryOrder::Release);
+  }
+
+  KeyPortalType Keys;
+  vtkm::exec::AtomicArrayExecutionObject<StateType> States;
+  vtkm::Id Mask = -1;
+};
+
+/// \brief Execution object for a fixed-capacity, open-addressing hash map.
+///
+/// `HashMap` is the execution side of `vtkm::cont::HashMap`. It extends
+/// `vtkm::exec::HashSet` with a value stored for each key. The value of a key is set
+/// by the thread that inserts the key and is visible to any thread that subsequently
+/// finds the key. The slot returned by `Insert` and `Find` can also be used to index
+/// auxiliary arrays (for example, an atomic array of counts).
+///
+template <typename KeyType, typename ValueType>
+class HashMap : public vtkm::exec::HashSet<KeyType>
+{
+  using Superclass = vtkm::exec::HashSet<KeyType>;
+  using ValuePortalType = typename vtkm::cont::ArrayHandle<ValueType>::WritePortalType;
+
+public:
+  HashMap() = default;
+
+  VTKM_CONT HashMap(const vtkm::cont::ArrayHandle<KeyType>& keys,
+                    const vtkm::cont::ArrayHandle<ValueType>& values,
+                    const vtkm::cont::ArrayHandle<vtkm::UInt32>& states,
+                    vtkm::cont::DeviceAdapterId device,
+                    vtkm::cont::Token& token)
+    : Superclass(keys, states, device, token)
+    , Values(values.PrepareForInPlace(device, token))
+  {
+  }
+
+  /// Adds a key/value pair to the map. If the key is already present, the existing value
+  /// is left unchanged and `inserted` is set to false. Returns the slot of the key or -1
+  /// if the table is full.
+  VTKM_EXEC vtkm::Id Insert(const KeyType& key, const ValueType& value, bool& inserted) const
+  {
+    vtkm::Id slot = this->ReserveSlot(key, inserted);
+    if (inserted)
+    {
+      this->Values.Set(slot, value);
+      this->PublishSlot(slot);
+    }
+    return slot;
+  }
+
+  VTKM_EXEC vtkm::Id Insert(const KeyType& key, const ValueType& value) const
+  {
+    bool inserted;
+    return this->Insert(key, value, inserted);
+  }
+
+  /// Finds the value for the given key. Returns true and sets `value` if the key is
+  /// present. Otherwise returns false and leaves `value` unchanged.
+  VTKM_EXEC bool Lookup(const KeyType& key, ValueType& value) const
+  {
+    vtkm::Id slot = this->Find(key);
+    if (slot < 0)
+    {
+      return false;
+    }
+    value = this->Values.Get(slot);
+    return true;
+  }
+
+  /// Returns the value stored in an occupied slot.
+  VTKM_EXEC ValueType GetValue(vtkm::Id slot) const { return this->Values.Get(slot); }
+
+  /// Replaces the value stored in an occupied slot. This is not atomic with respect to
+  /// other threads reading or writing the same slot.
+  VTKM_EXEC void SetValue(vtkm::Id slot, const ValueType& value) const
+  {
+    this->Values.Set(slot, value);
+  }
+
+private:
+  ValuePortalType Values;
+};
+
+}
+} // namespace vtkm::exec
+
+#endif //vtk_m_exec_HashMap_h
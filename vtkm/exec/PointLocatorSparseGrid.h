@@ -65,21 +65,123 @@ public:
 
     nearestNeighborId = -1;
     distance2 = vtkm::Infinity<vtkm::FloatDefault>();
+    NearestVisitor visitor{ nearestNeighborId, distance2 };
 
-    this->FindInCell(queryPoint, ijk, nearestNeighborId, distance2);
+    this->FindInCell(queryPoint, ijk, visitor);
 
     // TODO: This might stop looking before the absolute nearest neighbor is found.
     vtkm::Id maxLevel = vtkm::Max(vtkm::Max(this->Dims[0], this->Dims[1]), this->Dims[2]);
     vtkm::Id level;
     for (level = 1; (nearestNeighborId < 0) && (level < maxLevel); ++level)
     {
-      this->FindInBox(queryPoint, ijk, level, nearestNeighborId, distance2);
+      this->FindInBox(queryPoint, ijk, level, visitor);
     }
 
     // Search one more level out. This is still not guaranteed to find the closest point
     // in all cases (past level 2), but it will catch most cases where the closest point
     // is just on the other side of a cell boundary.
-    this->FindInBox(queryPoint, ijk, level, nearestNeighborId, distance2);
+    this->FindInBox(queryPoint, ijk, level, visitor);
+  }
+
+  /// \brief Find the `k` nearest neighbors of a point.
+  ///
+  /// The neighbors are kept in a bounded priority queue held in `neighborIds` and
+  /// `distance2`, which are sorted from the nearest to the farthest neighbor. Unlike
+  /// `FindNearestNeighbor`, the search is exact: the bins are visited in growing boxes
+  /// around the query point until the `k`-th neighbor is closer than any bin that has
+  /// not been visited. Entries past the number of points found are set to -1 and to
+  /// infinity.
+  ///
+  /// \param queryPoint Point coordinates to query for nearest neighbors.
+  /// \param k Number of neighbors to find. Must be at most `K`.
+  /// \param neighborIds Ids of the nearest points, nearest first.
+  /// \param distance2 Squared distances of the nearest points.
+  /// \returns The number of neighbors found, which is less than `k` only when there are
+  /// fewer than `k` points.
+  template <vtkm::IdComponent K>
+  VTKM_EXEC vtkm::IdComponent FindKNearestNeighbors(
+    const vtkm::Vec3f& queryPoint,
+    vtkm::IdComponent k,
+    vtkm::Vec<vtkm::Id, K>& neighborIds,
+    vtkm::Vec<vtkm::FloatDefault, K>& distance2) const
+  {
+    vtkm::Id3 ijk = (queryPoint - this->Min) / this->Dxdydz;
+    ijk = vtkm::Max(ijk, vtkm::Id3(0));
+    ijk = vtkm::Min(ijk, this->Dims - vtkm::Id3(1));
+
+    for (vtkm::IdComponent i = 0; i < K; ++i)
+    {
+      neighborIds[i] = -1;
+      distance2[i] = vtkm::Infinity<vtkm::FloatDefault>();
+    }
+    KNearestVisitor<K> visitor{ neighborIds, distance2, vtkm::Min(k, K), 0 };
+    if (visitor.Capacity < 1)
+    {
+      return 0;
+    }
+
+    this->FindInCell(queryPoint, ijk, visitor);
+
+    vtkm::Id maxLevel = vtkm::Max(vtkm::Max(this->Dims[0], this->Dims[1]), this->Dims[2]);
+    for (vtkm::Id level = 1; level < maxLevel; ++level)
+    {
+      if (visitor.Count == visitor.Capacity)
+      {
+        // Every bin not visited yet is outside the box of the previous level.
+        vtkm::FloatDefault bound = this->DistanceOutsideBox(queryPoint, ijk, level - 1);
+        if (distance2[visitor.Capacity - 1] <= bound * bound)
+        {
+          break;
+        }
+      }
+      this->FindInBox(queryPoint, ijk, level, visitor);
+    }
+    return visitor.Count;
+  }
+
+  /// \copydoc FindKNearestNeighbors
+  template <vtkm::IdComponent K>
+  VTKM_EXEC vtkm::IdComponent FindKNearestNeighbors(
+    const vtkm::Vec3f& queryPoint,
+    vtkm::Vec<vtkm::Id, K>& neighborIds,
+    vtkm::Vec<vtkm::FloatDefault, K>& distance2) const
+  {
+    return this->FindKNearestNeighbors(queryPoint, K, neighborIds, distance2);
+  }
+
+  /// \brief Count the points within a distance of a point.
+  ///
+  /// Points at exactly `radius` from `queryPoint` are counted. This is the first pass
+  /// of a two pass radius search: the counts give the size of the output of
+  /// `FindNeighborsInRadius`.
+  VTKM_EXEC vtkm::Id CountNeighborsInRadius(const vtkm::Vec3f& queryPoint,
+                                            vtkm::FloatDefault radius) const
+  {
+    CountVisitor visitor{ radius * radius, 0 };
+    this->FindInRadius(queryPoint, radius, visitor);
+    return visitor.Count;
+  }
+
+  /// \brief Find the points within a distance of a point.
+  ///
+  /// `neighborIds` and `distance2` are Vec-like objects (for example, the values of an
+  /// `ArrayHandleGroupVecVariable` sized with `CountNeighborsInRadius`). They are filled
+  /// with the ids and squared distances of the points within `radius` of `queryPoint`,
+  /// up to their number of components. The neighbors are not sorted by distance.
+  ///
+  /// \returns The number of points within `radius`, which may be larger than the number
+  /// of components of `neighborIds`.
+  template <typename IdVecType, typename DistanceVecType>
+  VTKM_EXEC vtkm::Id FindNeighborsInRadius(const vtkm::Vec3f& queryPoint,
+                                           vtkm::FloatDefault radius,
+                                           IdVecType& neighborIds,
+                                           DistanceVecType& distance2) const
+  {
+    FillVisitor<IdVecType, DistanceVecType> visitor{
+      neighborIds, distance2, radius * radius, neighborIds.GetNumberOfComponents(), 0
+    };
+    this->FindInRadius(queryPoint, radius, visitor);
+    return visitor.Count;
   }
 
 private:
@@ -93,10 +195,160 @@ private:
   IdPortalType CellLower;
   IdPortalType CellUpper;
 
+  struct NearestVisitor
+  {
+    vtkm::Id& NearestId;
+    vtkm::FloatDefault& NearestDistance2;
+
+    VTKM_EXEC void operator()(vtkm::Id pointId, vtkm::FloatDefault distance2)
+    {
+      if (distance2 < this->NearestDistance2)
+      {
+        this->NearestId = pointId;
+        this->NearestDistance2 = distance2;
+      }
+    }
+  };
+
+  // Bounded priority queue kept sorted by insertion. It is meant for small `K`, for which
+  // it stays in registers.
+  template <vtkm::IdComponent K>
+  struct KNearestVisitor
+  {
+    vtkm::Vec<vtkm::Id, K>& Ids;
+    vtkm::Vec<vtkm::FloatDefault, K>& Distance2;
+    vtkm::IdComponent Capacity;
+    vtkm::IdComponent Count;
+
+    VTKM_EXEC void operator()(vtkm::Id pointId, vtkm::FloatDefault distance2)
+    {
+      vtkm::IdComponent slot;
+      if (this->Count < this->Capacity)
+      {
+        slot = this->Count++;
+      }
+      else if (distance2 < this->Distance2[this->Capacity - 1])
+      {
+        slot = this->Capacity - 1;
+      }
+      else
+      {
+        return;
+      }
+      for (; (slot > 0) && (distance2 < this->Distance2[slot - 1]); --slot)
+      {
+        this->Ids[slot] = this->Ids[slot - 1];
+        this->Distance2[slot] = this->Distance2[slot - 1];
+      }
+      this->Ids[slot] = pointId;
+      this->Distance2[slot] = distance2;
+    }
+  };
+
+  struct CountVisitor
+  {
+    vtkm::FloatDefault Radius2;
+    vtkm::Id Count;
+
+    VTKM_EXEC void operator()(vtkm::Id, vtkm::FloatDefault distance2)
+    {
+      if (distance2 <= this->Radius2)
+      {
+        ++this->Count;
+      }
+    }
+  };
+
+  template <typename IdVecType, typename DistanceVecType>
+  struct FillVisitor
+  {
+    IdVecType& Ids;
+    DistanceVecType& Distance2;
+    vtkm::FloatDefault Radius2;
+    vtkm::IdComponent Capacity;
+    vtkm::Id Count;
+
+    VTKM_EXEC void operator()(vtkm::Id pointId, vtkm::FloatDefault distance2)
+    {
+      if (distance2 <= this->Radius2)
+      {
+        if (this->Count < this->Capacity)
+        {
+          this->Ids[static_cast<vtkm::IdComponent>(this->Count)] = pointId;
+          this->Distance2[static_cast<vtkm::IdComponent>(this->Count)] = distance2;
+        }
+        ++this->Count;
+      }
+    }
+  };
+
+  // Lower bound of the distance from the query point to any bin outside the box of bins
+  // within `level` of `boxCenter`. Sides of the box on the boundary of the grid have no
+  // bins past them.
+  VTKM_EXEC vtkm::FloatDefault DistanceOutsideBox(const vtkm::Vec3f& queryPoint,
+                                                  const vtkm::Id3& boxCenter,
+                                                  vtkm::Id level) const
+  {
+    vtkm::FloatDefault distance = vtkm::Infinity<vtkm::FloatDefault>();
+    for (vtkm::IdComponent axis = 0; axis < 3; ++axis)
+    {
+      if (boxCenter[axis] - level > 0)
+      {
+        vtkm::FloatDefault lower = this->Min[axis] +
+          static_cast<vtkm::FloatDefault>(boxCenter[axis] - level) * this->Dxdydz[axis];
+        distance = vtkm::Min(distance, queryPoint[axis] - lower);
+      }
+      if (boxCenter[axis] + level + 1 < this->Dims[axis])
+      {
+        vtkm::FloatDefault upper = this->Min[axis] +
+          static_cast<vtkm::FloatDefault>(boxCenter[axis] + level + 1) * this->Dxdydz[axis];
+        distance = vtkm::Min(distance, upper - queryPoint[axis]);
+      }
+    }
+    return vtkm::Max(distance, vtkm::FloatDefault(0));
+  }
+
+  template <typename Visitor>
+  VTKM_EXEC void FindInRadius(const vtkm::Vec3f& queryPoint,
+                              vtkm::FloatDefault radius,
+                              Visitor& visitor) const
+  {
+    vtkm::Id3 lower(0);
+    vtkm::Id3 upper = this->Dims - vtkm::Id3(1);
+    for (vtkm::IdComponent axis = 0; axis < 3; ++axis)
+    {
+      // Clamp in floating point so that far away queries do not overflow the bin index.
+      if (this->Dxdydz[axis] > 0)
+      {
+        vtkm::FloatDefault last = static_cast<vtkm::FloatDefault>(upper[axis]);
+        vtkm::FloatDefault first =
+          vtkm::Floor((queryPoint[axis] - radius - this->Min[axis]) / this->Dxdydz[axis]);
+        vtkm::FloatDefault end =
+          vtkm::Floor((queryPoint[axis] + radius - this->Min[axis]) / this->Dxdydz[axis]);
+        first = vtkm::Min(vtkm::Max(first, vtkm::FloatDefault(0)), last);
+        end = vtkm::Min(vtkm::Max(end, vtkm::FloatDefault(0)), last);
+        lower[axis] = static_cast<vtkm::Id>(first);
+        upper[axis] = static_cast<vtkm::Id>(end);
+      }
+    }
+
+    vtkm::Id3 ijk;
+    for (ijk[2] = lower[2]; ijk[2] <= upper[2]; ++ijk[2])
+    {
+      for (ijk[1] = lower[1]; ijk[1] <= upper[1]; ++ijk[1])
+      {
+        for (ijk[0] = lower[0]; ijk[0] <= upper[0]; ++ijk[0])
+        {
+          this->FindInCell(queryPoint, ijk, visitor);
+        }
+      }
+    }
+  }
+
+  template <typename Visitor>
   VTKM_EXEC void FindInCell(const vtkm::Vec3f& queryPoint,
                             const vtkm::Id3& ijk,
-                            vtkm::Id& nearestNeighborId,
-                            vtkm::FloatDefault& nearestDistance2) const
+                            Visitor& visitor) const
   {
     vtkm::Id cellId = ijk[0] + (ijk[1] * this->Dims[0]) + (ijk[2] * this->Dims[0] * this->Dims[1]);
     vtkm::Id lower = this->CellLower.Get(cellId);
@@ -105,63 +357,52 @@ private:
     {
       vtkm::Id pointid = this->PointIds.Get(index);
       vtkm::Vec3f point = this->Coords.Get(pointid);
-      vtkm::FloatDefault distance2 = vtkm::MagnitudeSquared(point - queryPoint);
-      if (distance2 < nearestDistance2)
-      {
-        nearestNeighborId = pointid;
-        nearestDistance2 = distance2;
-      }
+      visitor(pointid, vtkm::MagnitudeSquared(point - queryPoint));
     }
   }
 
+  template <typename Visitor>
   VTKM_EXEC void FindInBox(const vtkm::Vec3f& queryPoint,
                            const vtkm::Id3& boxCenter,
                            vtkm::Id level,
-                           vtkm::Id& nearestNeighborId,
-                           vtkm::FloatDefault& nearestDistance2) const
+                           Visitor& visitor) const
   {
     if ((boxCenter[0] - level) >= 0)
     {
-      this->FindInXPlane(
-        queryPoint, boxCenter - vtkm::Id3(level, 0, 0), level, nearestNeighborId, nearestDistance2);
+      this->FindInXPlane(queryPoint, boxCenter - vtkm::Id3(level, 0, 0), level, visitor);
     }
     if ((boxCenter[0] + level) < this->Dims[0])
     {
-      this->FindInXPlane(
-        queryPoint, boxCenter + vtkm::Id3(level, 0, 0), level, nearestNeighborId, nearestDistance2);
+      this->FindInXPlane(queryPoint, boxCenter + vtkm::Id3(level, 0, 0), level, visitor);
     }
 
     if ((boxCenter[1] - level) >= 0)
     {
-      this->FindInYPlane(
-        queryPoint, boxCenter - vtkm::Id3(0, level, 0), level, nearestNeighborId, nearestDistance2);
+      this->FindInYPlane(queryPoint, boxCenter - vtkm::Id3(0, level, 0), level, visitor);
     }
     if ((boxCenter[1] + level) < this->Dims[1])
     {
-      this->FindInYPlane(
-        queryPoint, boxCenter + vtkm::Id3(0, level, 0), level, nearestNeighborId, nearestDistance2);
+      this->FindInYPlane(queryPoint, boxCenter + vtkm::Id3(0, level, 0), level, visitor);
     }
 
     if ((boxCenter[2] - level) >= 0)
     {
-      this->FindInZPlane(
-        queryPoint, boxCenter - vtkm::Id3(0, 0, level), level, nearestNeighborId, nearestDistance2);
+      this->FindInZPlane(queryPoint, boxCenter - vtkm::Id3(0, 0, level), level, visitor);
     }
     if ((boxCenter[2] + level) < this->Dims[2])
     {
-      this->FindInZPlane(
-        queryPoint, boxCenter + vtkm::Id3(0, 0, level), level, nearestNeighborId, nearestDistance2);
+      this->FindInZPlane(queryPoint, boxCenter + vtkm::Id3(0, 0, level), level, visitor);
     }
   }
 
+  template <typename Visitor>
   VTKM_EXEC void FindInPlane(const vtkm::Vec3f& queryPoint,
                              const vtkm::Id3& planeCenter,
                              const vtkm::Id3& div,
                              const vtkm::Id3& mod,
                              const vtkm::Id3& origin,
                              vtkm::Id numInPlane,
-                             vtkm::Id& nearestNeighborId,
-                             vtkm::FloatDefault& nearestDistance2) const
+                             Visitor& visitor) const
   {
     for (vtkm::Id index = 0; index < numInPlane; ++index)
     {
@@ -170,16 +411,16 @@ private:
       if ((ijk[0] >= 0) && (ijk[0] < this->Dims[0]) && (ijk[1] >= 0) && (ijk[1] < this->Dims[1]) &&
           (ijk[2] >= 0) && (ijk[2] < this->Dims[2]))
       {
-        this->FindInCell(queryPoint, ijk, nearestNeighborId, nearestDistance2);
+        this->FindInCell(queryPoint, ijk, visitor);
       }
     }
   }
 
+  template <typename Visitor>
   VTKM_EXEC void FindInXPlane(const vtkm::Vec3f& queryPoint,
                               const vtkm::Id3& planeCenter,
                               vtkm::Id level,
-                              vtkm::Id& nearestNeighborId,
-                              vtkm::FloatDefault& nearestDistance2) const
+                              Visitor& visitor) const
   {
     vtkm::Id yWidth = (2 * level) + 1;
     vtkm::Id zWidth = (2 * level) + 1;
@@ -187,15 +428,14 @@ private:
     vtkm::Id3 mod = { 1, yWidth, 1 };
     vtkm::Id3 origin = { 0, -level, -level };
     vtkm::Id numInPlane = yWidth * zWidth;
-    this->FindInPlane(
-      queryPoint, planeCenter, div, mod, origin, numInPlane, nearestNeighborId, nearestDistance2);
+    this->FindInPlane(queryPoint, planeCenter, div, mod, origin, numInPlane, visitor);
   }
 
+  template <typename Visitor>
   VTKM_EXEC void FindInYPlane(const vtkm::Vec3f& queryPoint,
                               vtkm::Id3 planeCenter,
                               vtkm::Id level,
-                              vtkm::Id& nearestNeighborId,
-                              vtkm::FloatDefault& nearestDistance2) const
+                              Visitor& visitor) const
   {
     vtkm::Id xWidth = (2 * level) - 1;
     vtkm::Id zWidth = (2 * level) + 1;
@@ -203,15 +443,14 @@ private:
     vtkm::Id3 mod = { xWidth, 1, 1 };
     vtkm::Id3 origin = { -level + 1, 0, -level };
     vtkm::Id numInPlane = xWidth * zWidth;
-    this->FindInPlane(
-      queryPoint, planeCenter, div, mod, origin, numInPlane, nearestNeighborId, nearestDistance2);
+    this->FindInPlane(queryPoint, planeCenter, div, mod, origin, numInPlane, visitor);
   }
 
+  template <typename Visitor>
   VTKM_EXEC void FindInZPlane(const vtkm::Vec3f& queryPoint,
                               vtkm::Id3 planeCenter,
                               vtkm::Id level,
-                              vtkm::Id& nearestNeighborId,
-                              vtkm::FloatDefault& nearestDistance2) const
+                              Visitor& visitor) const
   {
     vtkm::Id xWidth = (2 * level) - 1;
     vtkm::Id yWidth = (2 * level) - 1;
@@ -219,8 +458,7 @@ private:
     vtkm::Id3 mod = { xWidth, 1, 1 };
     vtkm::Id3 origin = { -level + 1, -level + 1, 0 };
     vtkm::Id numInPlane = xWidth * yWidth;
-    this->FindInPlane(
-      queryPoint, planeCenter, div, mod, origin, numInPlane, nearestNeighborId, nearestDistance2);
+    this->FindInPlane(queryPoint, planeCenter, div, mod, origin, numInPlane, visitor);
   }
 };
 
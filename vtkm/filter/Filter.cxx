@@ -8,13 +8,30 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 #include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopyDevice.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/ArrayHandleView.h>
+#include <vtkm/cont/CellSetExplicit.h>
 #include <vtkm/cont/Logging.h>
+#include <vtkm/cont/MergePartitionedDataSet.h>
 #include <vtkm/cont/RuntimeDeviceTracker.h>
+#include <vtkm/cont/ThreadPool.h>
+#include <vtkm/cont/internal/MapArrayPermutation.h>
 
 #include <vtkm/filter/Filter.h>
-#include <vtkm/filter/TaskQueue.h>
 
-#include <future>
+#include <vtkm/worklet/CellDeepCopy.h>
+#include <vtkm/worklet/WorkletMapField.h>
+#include <vtkm/worklet/WorkletMapTopology.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <thread>
 
 namespace vtkm
 {
@@ -23,21 +40,272 @@ namespace filter
 
 namespace
 {
-void RunFilter(Filter* self, vtkm::filter::DataSetQueue& input, vtkm::filter::DataSetQueue& output)
+// Name of the point and cell fields that record which partition of a fused group each point
+// and cell came from.
+constexpr const char* FusedPartitionIdsName = "vtkmFusedPartitionIds";
+
+// Partitions can only be fused if they have the same fields (with the same types) and the same
+// coordinate systems. Otherwise merging would fill in invalid values. They are also grouped by
+// the type of their cell set (and the shape of single type cell sets), so that the merged cell
+// set has the single cell type of its partitions whenever it can.
+std::string FuseSignature(const vtkm::cont::DataSet& partition)
 {
-  auto& tracker = vtkm::cont::GetRuntimeDeviceTracker();
-  bool prevVal = tracker.GetThreadFriendlyMemAlloc();
-  tracker.SetThreadFriendlyMemAlloc(true);
+  std::ostringstream signature;
+  const vtkm::cont::UnknownCellSet& cellSet = partition.GetCellSet();
+  signature << cellSet.GetCellSetName();
+  if (cellSet.IsType<vtkm::cont::CellSetSingleType<>>())
+  {
+    signature << ':' << static_cast<int>(cellSet.GetCellShape(0));
+  }
+  signature << '#';
+  for (vtkm::IdComponent index = 0; index < partition.GetNumberOfCoordinateSystems(); ++index)
+  {
+    signature << partition.GetCoordinateSystemName(index) << ';';
+  }
+  for (vtkm::IdComponent index = 0; index < partition.GetNumberOfFields(); ++index)
+  {
+    const vtkm::cont::Field& field = partition.GetField(index);
+    signature << '|' << field.GetName() << ':' << static_cast<int>(field.GetAssociation()) << ':'
+              << field.GetData().GetValueTypeName() << ':'
+              << field.GetData().GetNumberOfComponentsFlat();
+  }
+  return signature.str();
+}
+
+struct CopyRangeWorklet : vtkm::worklet::WorkletMapField
+{
+  vtkm::Id Start;
+
+  explicit CopyRangeWorklet(vtkm::Id start)
+    : Start(start)
+  {
+  }
+
+  using ControlSignature = void(FieldIn index, WholeArrayIn input, FieldOut output);
+
+  template <typename InputPortalType, typename OutputType>
+  VTKM_EXEC void operator()(vtkm::Id index,
+                            const InputPortalType& inputPortal,
+                            OutputType& output) const
+  {
+    output = inputPortal.Get(index + this->Start);
+  }
+};
+
+struct ShiftWorklet : vtkm::worklet::WorkletMapField
+{
+  vtkm::Id Shift;
+
+  explicit ShiftWorklet(vtkm::Id shift)
+    : Shift(shift)
+  {
+  }
+
+  using ControlSignature = void(FieldIn input, FieldOut output);
+
+  VTKM_EXEC void operator()(vtkm::Id input, vtkm::Id& output) const
+  {
+    output = input + this->Shift;
+  }
+};
+
+struct IsDecreasingWorklet : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn value, FieldIn next, FieldOut isDecreasing);
+
+  VTKM_EXEC void operator()(vtkm::Id value, vtkm::Id next, vtkm::Id& isDecreasing) const
+  {
+    isDecreasing = (next < value) ? 1 : 0;
+  }
+};
+
+vtkm::cont::UnknownArrayHandle SliceArray(const vtkm::cont::UnknownArrayHandle& input,
+                                          vtkm::Id start,
+                                          vtkm::Id count)
+{
+  vtkm::cont::UnknownArrayHandle output = input.NewInstanceBasic();
+  output.Allocate(count);
+  input.CastAndCallWithExtractedArray([&](const auto& concrete) {
+    using ComponentType = typename std::decay_t<decltype(concrete)>::ValueType::ComponentType;
+    vtkm::cont::Invoker{}(CopyRangeWorklet{ start },
+                          vtkm::cont::ArrayHandleIndex(count),
+                          concrete,
+                          output.ExtractArrayFromComponents<ComponentType>(vtkm::CopyFlag::Off));
+  });
+  return output;
+}
+
+// Interpolating the partition ids onto new points is subject to round off, so take the
+// partition of each point from a cell that uses it.
+struct PointPartitionFromCellsWorklet : vtkm::worklet::WorkletVisitCellsWithPoints
+{
+  using ControlSignature = void(CellSetIn cellSet,
+                                FieldInCell partitionId,
+                                WholeArrayInOut pointPartitionIds);
+  using ExecutionSignature = void(PointIndices, _2, _3);
+
+  template <typename PointIndicesType, typename PortalType>
+  VTKM_EXEC void operator()(const PointIndicesType& pointIndices,
+                            vtkm::Id partitionId,
+                            const PortalType& pointPartitionIds) const
+  {
+    for (vtkm::IdComponent index = 0; index < pointIndices.GetNumberOfComponents(); ++index)
+    {
+      pointPartitionIds.Set(pointIndices[index], partitionId);
+    }
+  }
+};
+
+struct InvertPermutationWorklet : vtkm::worklet::WorkletMapField
+{
+  using ControlSignature = void(FieldIn oldIndex, WholeArrayOut newIndices);
+  using ExecutionSignature = void(_1, WorkIndex, _2);
 
-  std::pair<vtkm::Id, vtkm::cont::DataSet> task;
-  while (input.GetTask(task))
+  template <typename PortalType>
+  VTKM_EXEC void operator()(vtkm::Id oldIndex, vtkm::Id newIndex, PortalType& newIndices) const
   {
-    auto outDS = self->Execute(task.second);
-    output.Push(std::make_pair(task.first, std::move(outDS)));
+    newIndices.Set(oldIndex, newIndex);
   }
+};
 
-  vtkm::cont::Algorithm::Synchronize();
-  tracker.SetThreadFriendlyMemAlloc(prevVal);
+bool IsSorted(const vtkm::cont::ArrayHandle<vtkm::Id>& ids)
+{
+  vtkm::Id numberOfIds = ids.GetNumberOfValues();
+  if (numberOfIds < 2)
+  {
+    return true;
+  }
+  vtkm::cont::ArrayHandle<vtkm::Id> isDecreasing;
+  vtkm::cont::Invoker{}(IsDecreasingWorklet{},
+                        vtkm::cont::make_ArrayHandleView(ids, 0, numberOfIds - 1),
+                        vtkm::cont::make_ArrayHandleView(ids, 1, numberOfIds - 1),
+                        isDecreasing);
+  return vtkm::cont::Algorithm::Reduce(isDecreasing, vtkm::Id{ 0 }) == 0;
+}
+
+// Finds where each partition starts in a sorted array of partition ids.
+void FindPartitionOffsets(const vtkm::cont::ArrayHandle<vtkm::Id>& ids,
+                          vtkm::Id numberOfPartitions,
+                          std::vector<vtkm::Id>& offsets)
+{
+  vtkm::cont::ArrayHandle<vtkm::Id> offsetsArray;
+  vtkm::cont::Algorithm::LowerBounds(
+    ids, vtkm::cont::ArrayHandleIndex(numberOfPartitions + 1), offsetsArray);
+  auto offsetsPortal = offsetsArray.ReadPortal();
+  offsets.resize(static_cast<std::size_t>(numberOfPartitions + 1));
+  for (vtkm::Id index = 0; index <= numberOfPartitions; ++index)
+  {
+    offsets[static_cast<std::size_t>(index)] = offsetsPortal.Get(index);
+  }
+}
+
+// Some filters (such as marching cells) do not generate points in the order of the input
+// points. Reorder the points so that the points of each partition are contiguous. On return,
+// `pointOrder` gives the index of the original point for each reordered point and the
+// connectivity of `cellSet` refers to the reordered points.
+void GroupPointsByPartition(vtkm::cont::ArrayHandle<vtkm::Id>& pointPartitionIds,
+                            vtkm::cont::CellSetExplicit<>& cellSet,
+                            vtkm::cont::ArrayHandle<vtkm::Id>& pointOrder)
+{
+  vtkm::Id numberOfPoints = pointPartitionIds.GetNumberOfValues();
+  vtkm::cont::ArrayHandle<vtkm::Id> sortedIds;
+  vtkm::cont::ArrayCopyDevice(pointPartitionIds, sortedIds);
+  vtkm::cont::ArrayCopyDevice(vtkm::cont::ArrayHandleIndex(numberOfPoints), pointOrder);
+  vtkm::cont::Algorithm::SortByKey(sortedIds, pointOrder);
+  pointPartitionIds = sortedIds;
+
+  vtkm::cont::ArrayHandle<vtkm::Id> newIndices;
+  newIndices.Allocate(numberOfPoints);
+  vtkm::cont::Invoker{}(InvertPermutationWorklet{}, pointOrder, newIndices);
+
+  vtkm::TopologyElementTagCell visitTopology;
+  vtkm::TopologyElementTagPoint incidentTopology;
+  vtkm::cont::ArrayHandle<vtkm::Id> connectivity;
+  vtkm::cont::ArrayCopyDevice(
+    vtkm::cont::make_ArrayHandlePermutation(
+      cellSet.GetConnectivityArray(visitTopology, incidentTopology), newIndices),
+    connectivity);
+  vtkm::cont::CellSetExplicit<> reorderedCellSet;
+  reorderedCellSet.Fill(numberOfPoints,
+                        cellSet.GetShapesArray(visitTopology, incidentTopology),
+                        connectivity,
+                        cellSet.GetOffsetsArray(visitTopology, incidentTopology));
+  cellSet = reorderedCellSet;
+}
+
+vtkm::cont::CellSetExplicit<> SliceCellSet(const vtkm::cont::CellSetExplicit<>& cellSet,
+                                           vtkm::Id cellStart,
+                                           vtkm::Id cellEnd,
+                                           vtkm::Id pointStart,
+                                           vtkm::Id pointEnd)
+{
+  vtkm::TopologyElementTagCell visitTopology;
+  vtkm::TopologyElementTagPoint incidentTopology;
+  const auto& shapes = cellSet.GetShapesArray(visitTopology, incidentTopology);
+  const auto& connectivity = cellSet.GetConnectivityArray(visitTopology, incidentTopology);
+  const auto& offsets = cellSet.GetOffsetsArray(visitTopology, incidentTopology);
+
+  auto offsetsPortal = offsets.ReadPortal();
+  vtkm::Id connectivityStart = offsetsPortal.Get(cellStart);
+  vtkm::Id connectivityEnd = offsetsPortal.Get(cellEnd);
+
+  vtkm::cont::ArrayHandle<vtkm::UInt8> sliceShapes;
+  vtkm::cont::ArrayCopyDevice(
+    vtkm::cont::make_ArrayHandleView(shapes, cellStart, cellEnd - cellStart), sliceShapes);
+
+  vtkm::cont::Invoker invoke;
+  vtkm::cont::ArrayHandle<vtkm::Id> sliceConnectivity;
+  invoke(ShiftWorklet{ -pointStart },
+         vtkm::cont::make_ArrayHandleView(
+           connectivity, connectivityStart, connectivityEnd - connectivityStart),
+         sliceConnectivity);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> sliceOffsets;
+  invoke(ShiftWorklet{ -connectivityStart },
+         vtkm::cont::make_ArrayHandleView(offsets, cellStart, cellEnd - cellStart + 1),
+         sliceOffsets);
+
+  vtkm::cont::CellSetExplicit<> sliceCellSet;
+  sliceCellSet.Fill(pointEnd - pointStart, sliceShapes, sliceConnectivity, sliceOffsets);
+  return sliceCellSet;
+}
+
+// Runs `task` for each index in `order` on the thread pool. The worker threads get the device
+// tracker state of the calling thread.
+void ExecuteOnThreadPool(const std::vector<vtkm::Id>& order,
+                         const std::function<void(vtkm::Id)>& task,
+                         vtkm::Id numThreads)
+{
+  auto& callerTracker = vtkm::cont::GetRuntimeDeviceTracker();
+  vtkm::cont::ScopedRuntimeDeviceTracker callerScope(callerTracker);
+  callerTracker.SetThreadFriendlyMemAlloc(true);
+  const std::thread::id callerThread = std::this_thread::get_id();
+
+  auto trackedTask = [&](vtkm::Id index) {
+    // Worker threads have their own device tracker, so give it the state of the caller's.
+    std::unique_ptr<vtkm::cont::ScopedRuntimeDeviceTracker> workerScope;
+    if (std::this_thread::get_id() != callerThread)
+    {
+      auto& workerTracker = vtkm::cont::GetRuntimeDeviceTracker();
+      workerScope.reset(new vtkm::cont::ScopedRuntimeDeviceTracker(workerTracker));
+      workerTracker.CopyStateFrom(callerTracker);
+    }
+
+    task(index);
+    vtkm::cont::Algorithm::Synchronize();
+  };
+  vtkm::cont::GetThreadPool().Execute(order, trackedTask, numThreads);
+}
+
+// Returns the indices of `sizes` ordered from the largest size to the smallest.
+std::vector<vtkm::Id> LargestFirst(const std::vector<vtkm::Id>& sizes)
+{
+  std::vector<vtkm::Id> order(sizes.size());
+  std::iota(order.begin(), order.end(), vtkm::Id{ 0 });
+  std::stable_sort(order.begin(), order.end(), [&](vtkm::Id a, vtkm::Id b) {
+    return sizes[static_cast<std::size_t>(a)] > sizes[static_cast<std::size_t>(b)];
+  });
+  return order;
 }
 
 } // anonymous namespace
@@ -54,6 +322,11 @@ bool Filter::CanThread() const
   return true;
 }
 
+bool Filter::CanFusePartitions() const
+{
+  return false;
+}
+
 //----------------------------------------------------------------------------
 void Filter::SetFieldsToPass(const vtkm::filter::FieldSelection& fieldsToPass)
 {
@@ -98,28 +371,43 @@ vtkm::cont::PartitionedDataSet Filter::DoExecutePartitions(
   const vtkm::cont::PartitionedDataSet& input)
 {
   vtkm::cont::PartitionedDataSet output;
+  if (this->GetFusePartitions() && this->CanFusePartitions())
+  {
+    output = this->ExecutePartitionsFused(input);
+  }
+  else
+  {
+    output = this->ExecutePartitionsSeparately(input);
+  }
+
+  return this->CreateResult(input, output);
+}
+
+vtkm::cont::PartitionedDataSet Filter::ExecutePartitionsSeparately(
+  const vtkm::cont::PartitionedDataSet& input)
+{
+  vtkm::cont::PartitionedDataSet output;
 
   if (this->GetRunMultiThreadedFilter())
   {
-    vtkm::filter::DataSetQueue inputQueue(input);
-    vtkm::filter::DataSetQueue outputQueue;
-
     vtkm::Id numThreads = this->DetermineNumberOfThreads(input);
 
-    //Run 'numThreads' filters.
-    std::vector<std::future<void>> futures(static_cast<std::size_t>(numThreads));
-    for (std::size_t i = 0; i < static_cast<std::size_t>(numThreads); i++)
+    // Start the largest partitions first so that a big partition is not left running alone
+    // after all the others have finished.
+    std::vector<vtkm::Id> numCells(static_cast<std::size_t>(input.GetNumberOfPartitions()));
+    for (std::size_t index = 0; index < numCells.size(); ++index)
     {
-      auto f = std::async(
-        std::launch::async, RunFilter, this, std::ref(inputQueue), std::ref(outputQueue));
-      futures[i] = std::move(f);
+      numCells[index] = input.GetPartition(static_cast<vtkm::Id>(index)).GetNumberOfCells();
     }
 
-    for (auto& f : futures)
-      f.get();
+    std::vector<vtkm::cont::DataSet> outputPartitions(numCells.size());
+    auto task = [&](vtkm::Id index) {
+      outputPartitions[static_cast<std::size_t>(index)] =
+        this->Execute(input.GetPartition(index));
+    };
+    ExecuteOnThreadPool(LargestFirst(numCells), task, numThreads);
 
-    //Get results from the outputQueue.
-    output = outputQueue.Get();
+    output = vtkm::cont::PartitionedDataSet(outputPartitions);
   }
   else
   {
@@ -130,7 +418,277 @@ vtkm::cont::PartitionedDataSet Filter::DoExecutePartitions(
     }
   }
 
-  return this->CreateResult(input, output);
+  return output;
+}
+
+vtkm::cont::PartitionedDataSet Filter::ExecutePartitionsFused(
+  const vtkm::cont::PartitionedDataSet& input)
+{
+  // Group the partitions that can be merged with each other. Empty and large partitions are
+  // not worth fusing and are executed on their own.
+  std::map<std::string, std::vector<vtkm::Id>> groups;
+  std::vector<vtkm::Id> separate;
+  for (vtkm::Id index = 0; index < input.GetNumberOfPartitions(); ++index)
+  {
+    const vtkm::cont::DataSet& partition = input.GetPartition(index);
+    vtkm::Id numberOfCells = partition.GetNumberOfCells();
+    if ((numberOfCells < 1) || (numberOfCells > this->FusePartitionsMaxCells))
+    {
+      separate.push_back(index);
+    }
+    else
+    {
+      groups[FuseSignature(partition)].push_back(index);
+    }
+  }
+
+  // Groups of one partition gain nothing from fusing.
+  std::vector<std::vector<vtkm::Id>> fusedGroups;
+  for (const auto& group : groups)
+  {
+    if (group.second.size() > 1)
+    {
+      fusedGroups.push_back(group.second);
+    }
+    else
+    {
+      separate.insert(separate.end(), group.second.begin(), group.second.end());
+    }
+  }
+
+  std::vector<vtkm::cont::DataSet> outputPartitions(
+    static_cast<std::size_t>(input.GetNumberOfPartitions()));
+  std::vector<char> groupFused(fusedGroups.size(), 0);
+  auto fuseGroup = [&](vtkm::Id groupIndex) {
+    const std::vector<vtkm::Id>& indices = fusedGroups[static_cast<std::size_t>(groupIndex)];
+    std::vector<vtkm::cont::DataSet> groupPartitions;
+    for (vtkm::Id index : indices)
+    {
+      groupPartitions.push_back(input.GetPartition(index));
+    }
+    std::vector<vtkm::cont::DataSet> groupResults;
+    if (this->ExecuteFusedGroup(groupPartitions, groupResults))
+    {
+      for (std::size_t index = 0; index < indices.size(); ++index)
+      {
+        outputPartitions[static_cast<std::size_t>(indices[index])] = groupResults[index];
+      }
+      groupFused[static_cast<std::size_t>(groupIndex)] = 1;
+    }
+  };
+
+  if (this->GetRunMultiThreadedFilter() && (fusedGroups.size() > 1))
+  {
+    // Groups write to different output partitions, so they can run concurrently.
+    std::vector<vtkm::Id> groupCells(fusedGroups.size(), 0);
+    for (std::size_t groupIndex = 0; groupIndex < fusedGroups.size(); ++groupIndex)
+    {
+      for (vtkm::Id index : fusedGroups[groupIndex])
+      {
+        groupCells[groupIndex] += input.GetPartition(index).GetNumberOfCells();
+      }
+    }
+    ExecuteOnThreadPool(
+      LargestFirst(groupCells), fuseGroup, this->DetermineNumberOfThreads(input));
+  }
+  else
+  {
+    for (std::size_t groupIndex = 0; groupIndex < fusedGroups.size(); ++groupIndex)
+    {
+      fuseGroup(static_cast<vtkm::Id>(groupIndex));
+    }
+  }
+
+  for (std::size_t groupIndex = 0; groupIndex < fusedGroups.size(); ++groupIndex)
+  {
+    if (!groupFused[groupIndex])
+    {
+      const std::vector<vtkm::Id>& indices = fusedGroups[groupIndex];
+      VTKM_LOG_S(vtkm::cont::LogLevel::Warn,
+                 "Could not split the fused result of " << indices.size()
+                                                        << " partitions. Executing separately.");
+      separate.insert(separate.end(), indices.begin(), indices.end());
+    }
+  }
+
+  if (!separate.empty())
+  {
+    vtkm::cont::PartitionedDataSet separateInput;
+    for (vtkm::Id index : separate)
+    {
+      separateInput.AppendPartition(input.GetPartition(index));
+    }
+    vtkm::cont::PartitionedDataSet separateOutput =
+      this->ExecutePartitionsSeparately(separateInput);
+    for (std::size_t index = 0; index < separate.size(); ++index)
+    {
+      outputPartitions[static_cast<std::size_t>(separate[index])] =
+        separateOutput.GetPartition(static_cast<vtkm::Id>(index));
+    }
+  }
+
+  return vtkm::cont::PartitionedDataSet(outputPartitions);
+}
+
+bool Filter::ExecuteFusedGroup(const std::vector<vtkm::cont::DataSet>& partitions,
+                               std::vector<vtkm::cont::DataSet>& results)
+{
+  vtkm::Id numberOfPartitions = static_cast<vtkm::Id>(partitions.size());
+  std::vector<vtkm::Id> pointOffsets(partitions.size() + 1, 0);
+  std::vector<vtkm::Id> cellOffsets(partitions.size() + 1, 0);
+  for (std::size_t index = 0; index < partitions.size(); ++index)
+  {
+    pointOffsets[index + 1] = pointOffsets[index] + partitions[index].GetNumberOfPoints();
+    cellOffsets[index + 1] = cellOffsets[index] + partitions[index].GetNumberOfCells();
+  }
+
+  // Defer the merged fields so that fields the filter neither uses nor passes are never
+  // copied. The arrays are still concatenated into basic storage when they are read because
+  // filters cast their inputs to basic arrays, and the cell sets are always merged.
+  vtkm::cont::DataSet merged = vtkm::cont::MergePartitionedDataSet(
+    vtkm::cont::PartitionedDataSet(partitions), vtkm::Nan64(), true);
+
+  // Tag every point and cell with the partition it came from so that the filter carries the
+  // tags through to its output.
+  vtkm::cont::ArrayHandle<vtkm::Id> pointPartitionIds;
+  vtkm::cont::Algorithm::UpperBounds(
+    vtkm::cont::make_ArrayHandleView(
+      vtkm::cont::make_ArrayHandle(pointOffsets, vtkm::CopyFlag::Off), 1, numberOfPartitions),
+    vtkm::cont::ArrayHandleIndex(pointOffsets.back()),
+    pointPartitionIds);
+  vtkm::cont::ArrayHandle<vtkm::Id> cellPartitionIds;
+  vtkm::cont::Algorithm::UpperBounds(
+    vtkm::cont::make_ArrayHandleView(
+      vtkm::cont::make_ArrayHandle(cellOffsets, vtkm::CopyFlag::Off), 1, numberOfPartitions),
+    vtkm::cont::ArrayHandleIndex(cellOffsets.back()),
+    cellPartitionIds);
+  merged.AddPointField(FusedPartitionIdsName, pointPartitionIds);
+  merged.AddCellField(FusedPartitionIdsName, cellPartitionIds);
+
+  // The partition tags are always passed (see `IsFusedPartitionIdsField`), whatever fields the
+  // filter is asked to pass.
+  vtkm::cont::DataSet fusedOutput = this->Execute(merged);
+
+  // If the filter kept the input topology, the output partitions are the input partitions with
+  // the new fields. Otherwise, find the range of output points and cells of each partition from
+  // the partition tags.
+  bool sameTopology =
+    (fusedOutput.GetCellSet().GetCellSetBase() == merged.GetCellSet().GetCellSetBase());
+  vtkm::cont::CellSetExplicit<> outputCellSet;
+  vtkm::cont::ArrayHandle<vtkm::Id> pointOrder;
+  if (!sameTopology)
+  {
+    using IdArrayType = vtkm::cont::ArrayHandle<vtkm::Id>;
+    if (!fusedOutput.HasPointField(FusedPartitionIdsName) ||
+        !fusedOutput.HasCellField(FusedPartitionIdsName) ||
+        !fusedOutput.GetPointField(FusedPartitionIdsName).GetData().CanConvert<IdArrayType>() ||
+        !fusedOutput.GetCellField(FusedPartitionIdsName).GetData().CanConvert<IdArrayType>())
+    {
+      return false;
+    }
+    IdArrayType outputPointPartitionIds;
+    vtkm::cont::ArrayCopyDevice(
+      fusedOutput.GetPointField(FusedPartitionIdsName).GetData().AsArrayHandle<IdArrayType>(),
+      outputPointPartitionIds);
+    IdArrayType outputCellPartitionIds;
+    fusedOutput.GetCellField(FusedPartitionIdsName).GetData().AsArrayHandle(
+      outputCellPartitionIds);
+    if (!IsSorted(outputCellPartitionIds))
+    {
+      return false;
+    }
+
+    if (fusedOutput.GetCellSet().IsType<vtkm::cont::CellSetExplicit<>>())
+    {
+      fusedOutput.GetCellSet().AsCellSet(outputCellSet);
+    }
+    else
+    {
+      vtkm::cont::CastAndCall(fusedOutput.GetCellSet(), [&](const auto& cellSet) {
+        outputCellSet = vtkm::worklet::CellDeepCopy::Run(cellSet);
+      });
+    }
+
+    vtkm::cont::Invoker{}(PointPartitionFromCellsWorklet{},
+                          outputCellSet,
+                          outputCellPartitionIds,
+                          outputPointPartitionIds);
+    if (!IsSorted(outputPointPartitionIds))
+    {
+      GroupPointsByPartition(outputPointPartitionIds, outputCellSet, pointOrder);
+    }
+    FindPartitionOffsets(outputPointPartitionIds, numberOfPartitions, pointOffsets);
+    FindPartitionOffsets(outputCellPartitionIds, numberOfPartitions, cellOffsets);
+  }
+
+  results.resize(partitions.size());
+  for (std::size_t index = 0; index < partitions.size(); ++index)
+  {
+    vtkm::Id pointStart = pointOffsets[index];
+    vtkm::Id pointEnd = pointOffsets[index + 1];
+    vtkm::Id cellStart = cellOffsets[index];
+    vtkm::Id cellEnd = cellOffsets[index + 1];
+
+    vtkm::cont::DataSet& result = results[index];
+    if (sameTopology)
+    {
+      result.SetCellSet(partitions[index].GetCellSet());
+    }
+    else
+    {
+      result.SetCellSet(SliceCellSet(outputCellSet, cellStart, cellEnd, pointStart, pointEnd));
+    }
+
+    for (vtkm::IdComponent fieldIndex = 0; fieldIndex < fusedOutput.GetNumberOfFields();
+         ++fieldIndex)
+    {
+      const vtkm::cont::Field& field = fusedOutput.GetField(fieldIndex);
+      if (field.GetName() == FusedPartitionIdsName)
+      {
+        continue;
+      }
+      if (field.IsPointField() && (pointOrder.GetNumberOfValues() > 0))
+      {
+        result.AddPointField(
+          field.GetName(),
+          vtkm::cont::internal::MapArrayPermutation(
+            field.GetData(),
+            vtkm::cont::make_ArrayHandleView(pointOrder, pointStart, pointEnd - pointStart)));
+      }
+      else if (field.IsPointField())
+      {
+        result.AddPointField(field.GetName(),
+                             SliceArray(field.GetData(), pointStart, pointEnd - pointStart));
+      }
+      else if (field.IsCellField())
+      {
+        result.AddCellField(field.GetName(),
+                            SliceArray(field.GetData(), cellStart, cellEnd - cellStart));
+      }
+      else
+      {
+        result.AddField(field);
+      }
+    }
+
+    for (vtkm::IdComponent csIndex = 0; csIndex < fusedOutput.GetNumberOfCoordinateSystems();
+         ++csIndex)
+    {
+      result.AddCoordinateSystem(fusedOutput.GetCoordinateSystemName(csIndex));
+    }
+    if (fusedOutput.HasGhostCellField())
+    {
+      result.SetGhostCellFieldName(fusedOutput.GetGhostCellFieldName());
+    }
+  }
+
+  return true;
+}
+
+bool Filter::IsFusedPartitionIdsField(const vtkm::cont::Field& field)
+{
+  return (field.GetName() == FusedPartitionIdsName) &&
+    (field.IsPointField() || field.IsCellField());
 }
 
 vtkm::cont::DataSet Filter::Execute(const vtkm::cont::DataSet& input)
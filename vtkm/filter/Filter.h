@@ -152,14 +152,24 @@ namespace filter
 ///
 /// _FilterThreadScheduling DoExecute_
 ///
-/// The default multi-threaded execution of `Execute(PartitionedDataSet&)` uses a simple FIFO queue
-/// of DataSet and pool of *worker* threads. Implementation of Filter subclass can override the
+/// The default multi-threaded execution of `Execute(PartitionedDataSet&)` runs the partitions on
+/// the persistent `vtkm::cont::ThreadPool`, starting with the partitions that have the most
+/// cells. The calling thread works on partitions too, and the worker threads are reused across
+/// filter executions. Implementation of Filter subclass can override the
 /// `DoExecutePartitions(PartitionedDataSet)` virtual method to provide implementation specific
-/// scheduling policy. The default number of *worker* threads in the pool are determined by the
+/// scheduling policy. The default number of threads working on the partitions is determined by the
 /// `DetermineNumberOfThreads()` virtual method using several backend dependent heuristic.
 /// Implementations of Filter subclass can also override
 /// `DetermineNumberOfThreads()` to provide implementation specific heuristic.
 ///
+/// _FilterPartitionFusing_
+///
+/// When a `PartitionedDataSet` holds many small partitions, the fixed cost of running the filter
+/// on each partition (worklet launches, allocations, and scheduling) can dominate. Filters whose
+/// `CanFusePartitions()` returns true can instead concatenate compatible partitions into a single
+/// `DataSet`, execute once, and split the result back into one output partition per input
+/// partition. Fusing is requested with `SetFusePartitions()`.
+///
 class VTKM_FILTER_CORE_EXPORT Filter
 {
 public:
@@ -371,6 +381,28 @@ public:
     }
   }
 
+  /// @brief Specify whether small partitions are fused before they are executed.
+  ///
+  /// When on and the filter supports it (see `CanFusePartitions()`), `Execute` on a
+  /// `PartitionedDataSet` merges partitions that have the same fields, coordinate systems and
+  /// cell set type, runs the filter once on each merged group, and splits the result back into
+  /// partitions. When the filter runs multithreaded, the merged groups run concurrently.
+  /// The output has the same partitions and fields as unfused execution, but partitions whose
+  /// topology is changed by the filter are returned as `vtkm::cont::CellSetExplicit`.
+  /// Fusing is off by default.
+  VTKM_CONT void SetFusePartitions(bool fuse) { this->FusePartitions = fuse; }
+  VTKM_CONT bool GetFusePartitions() const { return this->FusePartitions; }
+
+  /// @brief Specify the largest partition, in cells, that is fused with others.
+  ///
+  /// Partitions with more cells than this are executed on their own because the per-partition
+  /// overhead is already small compared to their work.
+  VTKM_CONT void SetFusePartitionsMaxCells(vtkm::Id numCells)
+  {
+    this->FusePartitionsMaxCells = numCells;
+  }
+  VTKM_CONT vtkm::Id GetFusePartitionsMaxCells() const { return this->FusePartitionsMaxCells; }
+
   // FIXME: Is this actually materialize? Are there different kinds of Invoker?
   /// Specify the vtkm::cont::Invoker to be used to execute worklets by
   /// this filter instance. Overriding the default allows callers to control
@@ -661,6 +693,17 @@ protected:
   VTKM_CONT virtual vtkm::cont::PartitionedDataSet DoExecutePartitions(
     const vtkm::cont::PartitionedDataSet& inData);
 
+  /// @brief Returns whether partitions can be fused into one `DataSet` before executing.
+  ///
+  /// A derived class should override this to return true only if running `DoExecute` on
+  /// partitions concatenated into a single `DataSet` gives the same results as running it on
+  /// each partition. This requires that the output for a cell or point depends only on the
+  /// cells connected to it, that output cells are generated in the order of the input cells
+  /// they come from, that output points are generated in the order of the input points they
+  /// come from, and that passed point and cell fields are mapped with the output topology.
+  /// The default returns false.
+  VTKM_CONT virtual bool CanFusePartitions() const;
+
   /// @brief Convenience method to get the array from a filter's input scalar field.
   ///
   /// A field filter typically gets its input fields using the internal `GetFieldFromDataSet`.
@@ -776,7 +819,7 @@ private:
     for (vtkm::IdComponent cc = 0; cc < input.GetNumberOfFields(); ++cc)
     {
       auto field = input.GetField(cc);
-      if (fieldSelection.IsFieldSelected(field))
+      if (fieldSelection.IsFieldSelected(field) || IsFusedPartitionIdsField(field))
       {
         fieldMapper(output, field);
       }
@@ -835,6 +878,16 @@ private:
   VTKM_CONT
   virtual vtkm::Id DetermineNumberOfThreads(const vtkm::cont::PartitionedDataSet& input);
 
+  VTKM_CONT vtkm::cont::PartitionedDataSet ExecutePartitionsSeparately(
+    const vtkm::cont::PartitionedDataSet& input);
+  VTKM_CONT vtkm::cont::PartitionedDataSet ExecutePartitionsFused(
+    const vtkm::cont::PartitionedDataSet& input);
+  VTKM_CONT bool ExecuteFusedGroup(const std::vector<vtkm::cont::DataSet>& partitions,
+                                   std::vector<vtkm::cont::DataSet>& results);
+  // The tags that record which partition of a fused group each point and cell came from. They
+  // are passed to the output of every filter so that the fused result can be split.
+  VTKM_CONT static bool IsFusedPartitionIdsField(const vtkm::cont::Field& field);
+
   void ResizeIfNeeded(size_t index_st);
 
   vtkm::filter::FieldSelection FieldsToPass = vtkm::filter::FieldSelection::Mode::All;
@@ -842,6 +895,8 @@ private:
   bool RunFilterWithMultipleThreads = false;
   vtkm::Id NumThreadsPerCPU = 4;
   vtkm::Id NumThreadsPerGPU = 8;
+  bool FusePartitions = false;
+  vtkm::Id FusePartitionsMaxCells = 65536;
 
   std::string OutputFieldName;
 
@@ -48,7 +48,11 @@ bool DoMapField(vtkm::cont::DataSet& result,
   if (field.IsPointField() && (self.GetCompactPointFields() || self.GetMergePoints()))
   {
     vtkm::cont::Field compactedField;
-    if (self.GetCompactPointFields())
+    if (self.GetCompactPointFields() && self.GetDeferFieldMapping())
+    {
+      compactedField = field.Permute(worklets.PointCompactor.GetPermutationArray());
+    }
+    else if (self.GetCompactPointFields())
     {
       bool success = vtkm::filter::MapFieldPermutation(
         field, worklets.PointCompactor.GetPermutationArray(), compactedField);
@@ -74,6 +78,11 @@ bool DoMapField(vtkm::cont::DataSet& result,
   }
   else if (field.IsCellField() && self.GetRemoveDegenerateCells())
   {
+    if (self.GetDeferFieldMapping())
+    {
+      result.AddField(field.Permute(worklets.CellCompactor.GetValidCellIds()));
+      return true;
+    }
     return vtkm::filter::MapFieldPermutation(
       field, worklets.CellCompactor.GetValidCellIds(), result);
   }
@@ -93,6 +93,14 @@ public:
   /// @copydoc GetFastMerge
   VTKM_CONT void SetFastMerge(bool flag) { this->FastMerge = flag; }
 
+  /// When the DeferFieldMapping flag is true, the fields that are only compacted (not merged)
+  /// are permuted lazily with `vtkm::cont::Field::Permute()`, so their values are copied
+  /// only when they are first used. This is off by default.
+  ///
+  VTKM_CONT bool GetDeferFieldMapping() const { return this->DeferFieldMapping; }
+  /// @copydoc GetDeferFieldMapping
+  VTKM_CONT void SetDeferFieldMapping(bool flag) { this->DeferFieldMapping = flag; }
+
 private:
   VTKM_CONT
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& inData) override;
@@ -107,6 +115,7 @@ private:
   bool ToleranceIsAbsolute = false;
   bool RemoveDegenerateCells = true;
   bool FastMerge = true;
+  bool DeferFieldMapping = false;
 };
 } // namespace clean_grid
 
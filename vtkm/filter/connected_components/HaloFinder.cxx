@@ -0,0 +1,569 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleConcatenate.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/ArrayRangeCompute.h>
+#include <vtkm/cont/AssignerPartitionedDataSet.h>
+#include <vtkm/cont/EnvironmentTracker.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/filter/connected_components/HaloFinder.h>
+#include <vtkm/worklet/connectivity/HaloFinder.h>
+
+#include <vtkm/thirdparty/diy/diy.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace connected_components
+{
+namespace
+{
+// Turn the halo of each particle found within one partition into its final halo id. Halos
+// that were joined with halos of other partitions are looked up in a table sorted by
+// global halo id that gives the joined halo and its total size.
+class AssignHaloIds : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn localHaloId,
+                                WholeArrayIn localHaloSizes,
+                                WholeArrayIn joinedIds,
+                                WholeArrayIn joinedRoots,
+                                WholeArrayIn joinedSizes,
+                                FieldOut haloId);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6);
+
+  VTKM_CONT AssignHaloIds(vtkm::Id offset, vtkm::Id minimumHaloSize)
+    : Offset(offset)
+    , MinimumHaloSize(minimumHaloSize)
+  {
+  }
+
+  template <typename SizePortalType, typename TablePortalType>
+  VTKM_EXEC void operator()(vtkm::Id localHaloId,
+                            const SizePortalType& localHaloSizes,
+                            const TablePortalType& joinedIds,
+                            const TablePortalType& joinedRoots,
+                            const TablePortalType& joinedSizes,
+                            vtkm::Id& haloId) const
+  {
+    haloId = localHaloId + this->Offset;
+    vtkm::Id size = localHaloSizes.Get(localHaloId);
+
+    vtkm::Id begin = 0;
+    vtkm::Id end = joinedIds.GetNumberOfValues();
+    while (begin < end)
+    {
+      const vtkm::Id mid = begin + (end - begin) / 2;
+      if (joinedIds.Get(mid) < haloId)
+      {
+        begin = mid + 1;
+      }
+      else
+      {
+        end = mid;
+      }
+    }
+    if (begin < joinedIds.GetNumberOfValues() && joinedIds.Get(begin) == haloId)
+    {
+      haloId = joinedRoots.Get(begin);
+      size = joinedSizes.Get(begin);
+    }
+
+    if (size < this->MinimumHaloSize)
+    {
+      haloId = -1;
+    }
+  }
+
+private:
+  vtkm::Id Offset;
+  vtkm::Id MinimumHaloSize;
+};
+
+// Flag the particles that are within the linking length of a neighboring partition.
+class InsideBounds : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn point, FieldOut isInside);
+  using ExecutionSignature = _2(_1);
+
+  VTKM_CONT explicit InsideBounds(const vtkm::Bounds& bounds)
+    : Bounds(bounds)
+  {
+  }
+
+  VTKM_EXEC bool operator()(const vtkm::Vec3f_64& point) const
+  {
+    return this->Bounds.Contains(point);
+  }
+
+private:
+  vtkm::Bounds Bounds;
+};
+
+vtkm::Bounds ExpandBounds(vtkm::Bounds bounds, vtkm::Float64 delta)
+{
+  if (bounds.IsNonEmpty())
+  {
+    bounds.X.Min -= delta;
+    bounds.X.Max += delta;
+    bounds.Y.Min -= delta;
+    bounds.Y.Max += delta;
+    bounds.Z.Min -= delta;
+    bounds.Z.Max += delta;
+  }
+  return bounds;
+}
+
+// The halos joined across partitions, kept as a union-find on the host. Halos are always
+// joined to the one with the smaller id so that the result does not depend on the order
+// of the joins.
+class JoinedHalos
+{
+public:
+  void Add(vtkm::Id haloId, vtkm::Id size)
+  {
+    if (this->Parents.emplace(haloId, haloId).second)
+    {
+      this->Sizes[haloId] = size;
+    }
+  }
+
+  void Join(vtkm::Id haloId1, vtkm::Id haloId2)
+  {
+    const vtkm::Id root1 = this->FindRoot(haloId1);
+    const vtkm::Id root2 = this->FindRoot(haloId2);
+    this->Parents[vtkm::Max(root1, root2)] = vtkm::Min(root1, root2);
+  }
+
+  // Each joined halo as an (id, root, size) triple, ordered by id. The size is that of the
+  // halo within its own partition.
+  std::vector<vtkm::Id> GetJoins()
+  {
+    std::vector<vtkm::Id> joins;
+    for (const auto& entry : this->Sizes)
+    {
+      joins.insert(joins.end(), { entry.first, this->FindRoot(entry.first), entry.second });
+    }
+    return joins;
+  }
+
+  void AddJoins(const std::vector<vtkm::Id>& joins)
+  {
+    // The root of each triple is also the id of another triple.
+    for (std::size_t i = 0; i < joins.size(); i += 3)
+    {
+      this->Add(joins[i], joins[i + 2]);
+    }
+    for (std::size_t i = 0; i < joins.size(); i += 3)
+    {
+      this->Join(joins[i], joins[i + 1]);
+    }
+  }
+
+  // Like `GetJoins()`, but the size is the total size of the joined halos.
+  std::vector<vtkm::Id> GetJoinedSizes()
+  {
+    std::map<vtkm::Id, vtkm::Id> rootSizes;
+    for (const auto& entry : this->Sizes)
+    {
+      rootSizes[this->FindRoot(entry.first)] += entry.second;
+    }
+    std::vector<vtkm::Id> joins = this->GetJoins();
+    for (std::size_t i = 0; i < joins.size(); i += 3)
+    {
+      joins[i + 2] = rootSizes[joins[i + 1]];
+    }
+    return joins;
+  }
+
+private:
+  vtkm::Id FindRoot(vtkm::Id id)
+  {
+    vtkm::Id root = id;
+    while (this->Parents[root] != root)
+    {
+      root = this->Parents[root];
+    }
+    while (this->Parents[id] != root)
+    {
+      const vtkm::Id next = this->Parents[id];
+      this->Parents[id] = root;
+      id = next;
+    }
+    return root;
+  }
+
+  std::map<vtkm::Id, vtkm::Id> Parents;
+  std::map<vtkm::Id, vtkm::Id> Sizes;
+};
+
+// The diy block of one partition.
+struct HaloBlock
+{
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_64> Points;
+  vtkm::cont::ArrayHandle<vtkm::Id> LocalHaloIds;
+  vtkm::cont::ArrayHandle<vtkm::Id> LocalHaloSizes;
+  vtkm::Id Offset = 0;
+  JoinedHalos Halos;
+  // The (id, root, total size) triples of all the joined halos, once they are reduced.
+  std::vector<vtkm::Id> Joins;
+};
+
+template <typename T>
+void AllGatherVector(const vtkmdiy::mpi::communicator& comm, std::vector<T>& values)
+{
+  if (comm.size() == 1)
+  {
+    return;
+  }
+  std::vector<std::vector<T>> gathered;
+  vtkmdiy::mpi::all_gather(comm, values, gathered);
+  values.clear();
+  for (const auto& rankValues : gathered)
+  {
+    values.insert(values.end(), rankValues.begin(), rankValues.end());
+  }
+}
+} // anonymous namespace
+
+VTKM_CONT HaloFinder::HaloFinder()
+{
+  this->SetUseCoordinateSystemAsField(true);
+  this->SetOutputFieldName("haloId");
+}
+
+VTKM_CONT vtkm::cont::DataSet HaloFinder::DoExecute(const vtkm::cont::DataSet& input)
+{
+  const auto& field = this->GetFieldFromDataSet(input);
+  if (!field.IsPointField())
+  {
+    throw vtkm::cont::ErrorBadValue("Active field for HaloFinder must be a point field.");
+  }
+  if (this->LinkingLength < 0)
+  {
+    throw vtkm::cont::ErrorBadValue("HaloFinder linking length must not be negative.");
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Id> localHaloIds;
+  auto resolveType = [&](const auto& concrete) {
+    vtkm::worklet::connectivity::HaloFinder::Run(concrete, this->LinkingLength, localHaloIds);
+  };
+  this->CastAndCallVecField<3>(field, resolveType);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> localHaloSizes;
+  vtkm::worklet::connectivity::HaloFinder::CountHaloSizes(localHaloIds, localHaloSizes);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> haloIds;
+  vtkm::cont::ArrayHandle<vtkm::Id> noJoinedHalos;
+  this->Invoke(AssignHaloIds(0, this->MinimumHaloSize),
+               localHaloIds,
+               localHaloSizes,
+               noJoinedHalos,
+               noJoinedHalos,
+               noJoinedHalos,
+               haloIds);
+
+  return this->CreateResultFieldPoint(input, this->GetOutputFieldName(), haloIds);
+}
+
+VTKM_CONT vtkm::cont::PartitionedDataSet HaloFinder::DoExecutePartitions(
+  const vtkm::cont::PartitionedDataSet& input)
+{
+  auto comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
+  const vtkm::Id numLocalPartitions = input.GetNumberOfPartitions();
+  if (comm.size() == 1 && numLocalPartitions <= 1)
+  {
+    return this->Filter::DoExecutePartitions(input);
+  }
+  if (this->LinkingLength < 0)
+  {
+    throw vtkm::cont::ErrorBadValue("HaloFinder linking length must not be negative.");
+  }
+  const vtkm::Float64 linkingLength = this->LinkingLength;
+
+  // Each partition is a diy block. The global ids of the blocks follow the order of the
+  // partitions over all ranks.
+  vtkm::cont::AssignerPartitionedDataSet assigner(numLocalPartitions);
+  if (assigner.nblocks() <= 1)
+  {
+    return this->Filter::DoExecutePartitions(input);
+  }
+  std::vector<int> gids;
+  assigner.local_gids(comm.rank(), gids);
+
+  vtkmdiy::Master master(
+    comm,
+    /*threads*/ 1,
+    /*limit*/ -1,
+    []() -> void* { return new HaloBlock(); },
+    [](void* ptr) { delete static_cast<HaloBlock*>(ptr); });
+
+  // Find the halos within each partition. The particles are numbered in the order of the
+  // partitions over all ranks, which makes the halo ids global.
+  std::vector<std::unique_ptr<HaloBlock>> blocks(static_cast<std::size_t>(numLocalPartitions));
+  std::vector<vtkm::Float64> localBounds;
+  vtkm::Id numLocalParticles = 0;
+  for (std::size_t p = 0; p < blocks.size(); ++p)
+  {
+    const auto& field = this->GetFieldFromDataSet(input.GetPartition(static_cast<vtkm::Id>(p)));
+    if (!field.IsPointField())
+    {
+      throw vtkm::cont::ErrorBadValue("Active field for HaloFinder must be a point field.");
+    }
+
+    blocks[p].reset(new HaloBlock());
+    HaloBlock& block = *blocks[p];
+    auto resolveType = [&](const auto& concrete) {
+      vtkm::worklet::connectivity::HaloFinder::Run(concrete, linkingLength, block.LocalHaloIds);
+    };
+    this->CastAndCallVecField<3>(field, resolveType);
+    vtkm::worklet::connectivity::HaloFinder::CountHaloSizes(block.LocalHaloIds,
+                                                            block.LocalHaloSizes);
+    vtkm::cont::ArrayCopyShallowIfPossible(field.GetData(), block.Points);
+
+    block.Offset = numLocalParticles;
+    numLocalParticles += block.LocalHaloIds.GetNumberOfValues();
+
+    auto ranges = vtkm::cont::ArrayRangeCompute(field.GetData());
+    auto rangePortal = ranges.ReadPortal();
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      localBounds.push_back(rangePortal.Get(d).Min);
+      localBounds.push_back(rangePortal.Get(d).Max);
+    }
+  }
+
+  vtkm::Id firstParticle = 0;
+  vtkmdiy::mpi::scan(comm, numLocalParticles, firstParticle, std::plus<vtkm::Id>{});
+  firstParticle -= numLocalParticles;
+
+  // The bounds of all the partitions decide which partitions are neighbors.
+  std::vector<vtkm::Float64> globalBounds = localBounds;
+  AllGatherVector(comm, globalBounds);
+  std::vector<vtkm::Bounds> expandedBounds(globalBounds.size() / 6);
+  for (std::size_t b = 0; b < expandedBounds.size(); ++b)
+  {
+    expandedBounds[b] = ExpandBounds(vtkm::Bounds(&globalBounds[6 * b]), linkingLength);
+  }
+
+  // Link each partition to the partitions within the linking length of it.
+  for (std::size_t p = 0; p < blocks.size(); ++p)
+  {
+    blocks[p]->Offset += firstParticle;
+    const std::size_t gid = static_cast<std::size_t>(gids[p]);
+    vtkmdiy::Link link;
+    for (std::size_t b = 0; b < expandedBounds.size(); ++b)
+    {
+      if (b != gid && expandedBounds[b].Intersection(expandedBounds[gid]).IsNonEmpty())
+      {
+        const int neighbor = static_cast<int>(b);
+        link.add_neighbor(vtkmdiy::BlockID(neighbor, assigner.rank(neighbor)));
+      }
+    }
+    master.add(gids[p], blocks[p].release(), link);
+  }
+
+  // Each partition sends its particles within the linking length of a neighbor to that
+  // neighbor only.
+  master.foreach([&](HaloBlock* block, const vtkmdiy::Master::ProxyWithLink& cp) {
+    for (int i = 0; i < cp.link()->size(); ++i)
+    {
+      const vtkmdiy::BlockID target = cp.link()->target(i);
+      vtkm::cont::ArrayHandle<bool> isNear;
+      this->Invoke(InsideBounds(expandedBounds[static_cast<std::size_t>(target.gid)]),
+                   block->Points,
+                   isNear);
+
+      vtkm::cont::ArrayHandle<vtkm::Vec3f_64> nearPoints;
+      vtkm::cont::ArrayHandle<vtkm::Id> nearHaloIds;
+      vtkm::cont::ArrayHandle<vtkm::Id> nearHaloSizes;
+      vtkm::cont::Algorithm::CopyIf(block->Points, isNear, nearPoints);
+      vtkm::cont::Algorithm::CopyIf(block->LocalHaloIds, isNear, nearHaloIds);
+      vtkm::cont::Algorithm::CopyIf(
+        vtkm::cont::make_ArrayHandlePermutation(block->LocalHaloIds, block->LocalHaloSizes),
+        isNear,
+        nearHaloSizes);
+      cp.enqueue(target, block->Offset);
+      cp.enqueue(target, nearPoints);
+      cp.enqueue(target, nearHaloIds);
+      cp.enqueue(target, nearHaloSizes);
+    }
+  });
+  master.exchange();
+
+  // Each partition finds its particles that are friends of the particles received from its
+  // neighbors. Each such pair of particles joins their halos. The pairs are found by running
+  // the halo finder on the received particles together with the local particles near the
+  // sender, so that friends are tested the same way across partitions as within one.
+  master.foreach([&](HaloBlock* block, const vtkmdiy::Master::ProxyWithLink& cp) {
+    for (int i = 0; i < cp.link()->size(); ++i)
+    {
+      const int gid = cp.link()->target(i).gid;
+      vtkm::Id offset;
+      vtkm::cont::ArrayHandle<vtkm::Vec3f_64> points;
+      vtkm::cont::ArrayHandle<vtkm::Id> haloIds;
+      vtkm::cont::ArrayHandle<vtkm::Id> haloSizes;
+      cp.dequeue(gid, offset);
+      cp.dequeue(gid, points);
+      cp.dequeue(gid, haloIds);
+      cp.dequeue(gid, haloSizes);
+
+      vtkm::cont::ArrayHandle<bool> isNear;
+      this->Invoke(
+        InsideBounds(expandedBounds[static_cast<std::size_t>(gid)]), block->Points, isNear);
+      vtkm::cont::ArrayHandle<vtkm::Vec3f_64> nearPoints;
+      vtkm::cont::ArrayHandle<vtkm::Id> nearHaloIds;
+      vtkm::cont::Algorithm::CopyIf(block->Points, isNear, nearPoints);
+      vtkm::cont::Algorithm::CopyIf(block->LocalHaloIds, isNear, nearHaloIds);
+      const vtkm::Id numNear = nearPoints.GetNumberOfValues();
+      if (numNear == 0 || points.GetNumberOfValues() == 0)
+      {
+        continue;
+      }
+
+      // The local particles come first, then the received ones.
+      vtkm::cont::ArrayHandle<vtkm::Id> combinedHaloIds;
+      vtkm::worklet::connectivity::HaloFinder::Run(
+        vtkm::cont::make_ArrayHandleConcatenate(nearPoints, points),
+        linkingLength,
+        combinedHaloIds);
+
+      auto combinedPortal = combinedHaloIds.ReadPortal();
+      auto nearIdPortal = nearHaloIds.ReadPortal();
+      auto remoteIdPortal = haloIds.ReadPortal();
+      auto remoteSizePortal = haloSizes.ReadPortal();
+      auto localSizePortal = block->LocalHaloSizes.ReadPortal();
+      auto globalHaloId = [&](vtkm::Id index) {
+        return index < numNear ? nearIdPortal.Get(index) + block->Offset
+                               : remoteIdPortal.Get(index - numNear) + offset;
+      };
+      auto haloSize = [&](vtkm::Id index) {
+        return index < numNear ? localSizePortal.Get(nearIdPortal.Get(index))
+                               : remoteSizePortal.Get(index - numNear);
+      };
+      // Each particle is linked to the first particle of its combined halo. Only links
+      // between different halos join anything.
+      for (vtkm::Id q = 0; q < combinedHaloIds.GetNumberOfValues(); ++q)
+      {
+        const vtkm::Id root = combinedPortal.Get(q);
+        if (globalHaloId(root) != globalHaloId(q))
+        {
+          block->Halos.Add(globalHaloId(root), haloSize(root));
+          block->Halos.Add(globalHaloId(q), haloSize(q));
+          block->Halos.Join(globalHaloId(root), globalHaloId(q));
+        }
+      }
+    }
+  });
+
+  // Merge the joined halos of all the partitions into partition 0 along a tree. At each
+  // step, the halos are reduced to one (id, root, size) triple per halo. The halos joined
+  // over all partitions are then broadcast back to every partition.
+  vtkmdiy::RegularDecomposer<vtkmdiy::DiscreteBounds> decomposer(
+    /*dims*/ 1, vtkmdiy::interval(0, assigner.nblocks() - 1), assigner.nblocks());
+  vtkmdiy::RegularMergePartners mergePartners(decomposer, /*k=*/2);
+  vtkmdiy::reduce(master,
+                  assigner,
+                  mergePartners,
+                  [](HaloBlock* block,
+                     const vtkmdiy::ReduceProxy& srp,
+                     const vtkmdiy::RegularMergePartners&) {
+                    std::vector<int> incoming;
+                    srp.incoming(incoming);
+                    for (const int gid : incoming)
+                    {
+                      if (gid != srp.gid())
+                      {
+                        std::vector<vtkm::Id> joins;
+                        srp.dequeue(gid, joins);
+                        block->Halos.AddJoins(joins);
+                      }
+                    }
+                    for (int cc = 0; cc < srp.out_link().size(); ++cc)
+                    {
+                      auto target = srp.out_link().target(cc);
+                      if (target.gid != srp.gid())
+                      {
+                        srp.enqueue(target, block->Halos.GetJoins());
+                      }
+                    }
+                  });
+  if (master.local(0))
+  {
+    HaloBlock* root = master.block<HaloBlock>(master.lid(0));
+    root->Joins = root->Halos.GetJoinedSizes();
+  }
+
+  vtkmdiy::RegularBroadcastPartners broadcastPartners(decomposer, /*k=*/2);
+  vtkmdiy::reduce(master,
+                  assigner,
+                  broadcastPartners,
+                  [](HaloBlock* block,
+                     const vtkmdiy::ReduceProxy& srp,
+                     const vtkmdiy::RegularMergePartners&) {
+                    std::vector<int> incoming;
+                    srp.incoming(incoming);
+                    for (const int gid : incoming)
+                    {
+                      if (gid != srp.gid())
+                      {
+                        srp.dequeue(gid, block->Joins);
+                      }
+                    }
+                    for (int cc = 0; cc < srp.out_link().size(); ++cc)
+                    {
+                      auto target = srp.out_link().target(cc);
+                      if (target.gid != srp.gid())
+                      {
+                        srp.enqueue(target, block->Joins);
+                      }
+                    }
+                  });
+
+  vtkm::cont::PartitionedDataSet output;
+  for (std::size_t p = 0; p < blocks.size(); ++p)
+  {
+    // The blocks were added to the master in the order of the partitions.
+    const HaloBlock& block = *master.block<HaloBlock>(static_cast<int>(p));
+    std::vector<vtkm::Id> ids;
+    std::vector<vtkm::Id> roots;
+    std::vector<vtkm::Id> sizes;
+    for (std::size_t i = 0; i < block.Joins.size(); i += 3)
+    {
+      ids.push_back(block.Joins[i]);
+      roots.push_back(block.Joins[i + 1]);
+      sizes.push_back(block.Joins[i + 2]);
+    }
+
+    vtkm::cont::ArrayHandle<vtkm::Id> haloIds;
+    this->Invoke(AssignHaloIds(block.Offset, this->MinimumHaloSize),
+                 block.LocalHaloIds,
+                 block.LocalHaloSizes,
+                 vtkm::cont::make_ArrayHandle(ids, vtkm::CopyFlag::Off),
+                 vtkm::cont::make_ArrayHandle(roots, vtkm::CopyFlag::Off),
+                 vtkm::cont::make_ArrayHandle(sizes, vtkm::CopyFlag::Off),
+                 haloIds);
+    output.AppendPartition(this->CreateResultFieldPoint(
+      input.GetPartition(static_cast<vtkm::Id>(p)), this->GetOutputFieldName(), haloIds));
+  }
+  return this->CreateResult(input, output);
+}
+} // namespace connected_components
+} // namespace filter
+} // namespace vtkm
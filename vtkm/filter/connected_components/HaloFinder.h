@@ -0,0 +1,70 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_filter_connected_components_HaloFinder_h
+#define vtk_m_filter_connected_components_HaloFinder_h
+
+#include <vtkm/filter/Filter.h>
+#include <vtkm/filter/connected_components/vtkm_filter_connected_components_export.h>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace connected_components
+{
+/// \brief Groups particles into friends-of-friends halos.
+///
+/// Two particles are friends when the distance between them is no more than the linking
+/// length, and a halo is a group of particles connected through friends. The points of the
+/// input are the particles. By default, the active coordinate system provides their
+/// positions, but any 3-component point field can be selected with `SetActiveField()`.
+///
+/// The result of the filter is a point field of type `vtkm::Id` named "haloId" (which can
+/// be changed with the `SetOutputFieldName` method). The id of a halo is the index of its
+/// first particle. Particles in halos with fewer than `GetMinimumHaloSize()` particles get
+/// a halo id of -1.
+///
+/// When run on a `vtkm::cont::PartitionedDataSet`, halos that cross partitions, on this
+/// rank or on other ranks, are joined into one. The particles are indexed in the order of
+/// the partitions across all ranks, so halo ids are unique over the whole data set.
+class VTKM_FILTER_CONNECTED_COMPONENTS_EXPORT HaloFinder : public vtkm::filter::Filter
+{
+public:
+  VTKM_CONT HaloFinder();
+
+  /// @brief Set the largest distance between two particles of the same halo.
+  ///
+  /// The default is 0.2.
+  VTKM_CONT void SetLinkingLength(vtkm::FloatDefault length) { this->LinkingLength = length; }
+  /// @copydoc SetLinkingLength
+  VTKM_CONT vtkm::FloatDefault GetLinkingLength() const { return this->LinkingLength; }
+
+  /// @brief Set the smallest number of particles of a halo.
+  ///
+  /// Particles in smaller halos are not part of any halo and get a halo id of -1. The
+  /// default is 1, which makes every particle part of a halo.
+  VTKM_CONT void SetMinimumHaloSize(vtkm::Id size) { this->MinimumHaloSize = size; }
+  /// @copydoc SetMinimumHaloSize
+  VTKM_CONT vtkm::Id GetMinimumHaloSize() const { return this->MinimumHaloSize; }
+
+private:
+  VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
+  VTKM_CONT vtkm::cont::PartitionedDataSet DoExecutePartitions(
+    const vtkm::cont::PartitionedDataSet& input) override;
+
+  vtkm::FloatDefault LinkingLength = 0.2f;
+  vtkm::Id MinimumHaloSize = 1;
+};
+} // namespace connected_components
+} // namespace filter
+} // namespace vtkm
+
+#endif //vtk_m_filter_connected_components_HaloFinder_h
@@ -0,0 +1,214 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/connected_components/HaloFinder.h>
+
+#include <vtkm/cont/DataSetBuilderExplicit.h>
+#include <vtkm/cont/PartitionedDataSet.h>
+#include <vtkm/cont/testing/Testing.h>
+
+#include <random>
+
+namespace
+{
+
+constexpr vtkm::FloatDefault LinkingLength = 0.3f;
+
+// Clumps of particles with some particles scattered around them.
+std::vector<vtkm::Vec3f> MakeParticles()
+{
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<vtkm::FloatDefault> box(0, 10);
+  std::normal_distribution<vtkm::FloatDefault> clump(0, 0.25f);
+
+  std::vector<vtkm::Vec3f> particles;
+  for (int c = 0; c < 12; ++c)
+  {
+    const vtkm::Vec3f center(box(rng), box(rng), box(rng));
+    const int size = 5 + 15 * c;
+    for (int i = 0; i < size; ++i)
+    {
+      particles.push_back(center + vtkm::Vec3f(clump(rng), clump(rng), clump(rng)));
+    }
+  }
+  for (int i = 0; i < 400; ++i)
+  {
+    particles.push_back(vtkm::Vec3f(box(rng), box(rng), box(rng)));
+  }
+  std::shuffle(particles.begin(), particles.end(), rng);
+  return particles;
+}
+
+// Brute force friends-of-friends. The halo id is the index of the first particle.
+std::vector<vtkm::Id> FindHalos(const std::vector<vtkm::Vec3f>& particles, vtkm::Id minimumSize)
+{
+  const std::size_t numParticles = particles.size();
+  std::vector<vtkm::Id> haloIds(numParticles);
+  for (std::size_t i = 0; i < numParticles; ++i)
+  {
+    haloIds[i] = static_cast<vtkm::Id>(i);
+  }
+  auto findRoot = [&](vtkm::Id id) {
+    while (haloIds[static_cast<std::size_t>(id)] != id)
+    {
+      id = haloIds[static_cast<std::size_t>(id)];
+    }
+    return id;
+  };
+  for (std::size_t i = 0; i < numParticles; ++i)
+  {
+    for (std::size_t j = i + 1; j < numParticles; ++j)
+    {
+      if (vtkm::MagnitudeSquared(particles[i] - particles[j]) <= LinkingLength * LinkingLength)
+      {
+        const vtkm::Id root1 = findRoot(static_cast<vtkm::Id>(i));
+        const vtkm::Id root2 = findRoot(static_cast<vtkm::Id>(j));
+        haloIds[static_cast<std::size_t>(vtkm::Max(root1, root2))] = vtkm::Min(root1, root2);
+      }
+    }
+  }
+
+  std::vector<vtkm::Id> sizes(numParticles, 0);
+  for (std::size_t i = 0; i < numParticles; ++i)
+  {
+    haloIds[i] = findRoot(haloIds[i]);
+    ++sizes[static_cast<std::size_t>(haloIds[i])];
+  }
+  for (auto& haloId : haloIds)
+  {
+    if (sizes[static_cast<std::size_t>(haloId)] < minimumSize)
+    {
+      haloId = -1;
+    }
+  }
+  return haloIds;
+}
+
+template <typename T>
+vtkm::cont::DataSet MakeDataSet(const std::vector<vtkm::Vec<T, 3>>& particles)
+{
+  std::vector<vtkm::Id> connectivity(particles.size());
+  for (std::size_t i = 0; i < particles.size(); ++i)
+  {
+    connectivity[i] = static_cast<vtkm::Id>(i);
+  }
+  return vtkm::cont::DataSetBuilderExplicit::Create(
+    particles, vtkm::CellShapeTagVertex{}, 1, connectivity);
+}
+
+void CheckHaloIds(const vtkm::cont::DataSet& output,
+                  const std::vector<vtkm::Id>& expected,
+                  std::size_t first)
+{
+  vtkm::cont::ArrayHandle<vtkm::Id> haloIds;
+  output.GetPointField("haloId").GetData().AsArrayHandle(haloIds);
+  auto portal = haloIds.ReadPortal();
+  for (vtkm::Id i = 0; i < portal.GetNumberOfValues(); ++i)
+  {
+    VTKM_TEST_ASSERT(portal.Get(i) == expected[first + static_cast<std::size_t>(i)],
+                     "Wrong halo id for particle ",
+                     first + static_cast<std::size_t>(i));
+  }
+}
+
+void TestHaloFinder()
+{
+  std::cout << "Testing HaloFinder on one data set" << std::endl;
+  const std::vector<vtkm::Vec3f> particles = MakeParticles();
+
+  vtkm::filter::connected_components::HaloFinder haloFinder;
+  haloFinder.SetLinkingLength(LinkingLength);
+  for (vtkm::Id minimumSize : { 1, 10 })
+  {
+    haloFinder.SetMinimumHaloSize(minimumSize);
+    const std::vector<vtkm::Id> expected = FindHalos(particles, minimumSize);
+    CheckHaloIds(haloFinder.Execute(MakeDataSet(particles)), expected, 0);
+  }
+}
+
+void TestHaloFinderPartitioned(std::size_t numSlabs)
+{
+  std::cout << "Testing HaloFinder on " << numSlabs << " partitions" << std::endl;
+  std::vector<vtkm::Vec3f> particles = MakeParticles();
+
+  // Split the particles into slabs along x so that halos cross the partitions, and order
+  // them by partition so that the halo ids match those of the whole data set. Each slab
+  // only neighbors the slabs next to it. An empty partition is added at the end.
+  const std::size_t numPartitions = numSlabs + 1;
+  std::vector<std::vector<vtkm::Vec3f>> slabs(numPartitions);
+  for (const auto& particle : particles)
+  {
+    const vtkm::Id slab = static_cast<vtkm::Id>(vtkm::Floor(particle[0] / 10 * numSlabs));
+    slabs[static_cast<std::size_t>(vtkm::Max(vtkm::Id(0), vtkm::Min(slab, vtkm::Id(numSlabs) - 1)))]
+      .push_back(particle);
+  }
+  particles.clear();
+  vtkm::cont::PartitionedDataSet input;
+  for (const auto& slab : slabs)
+  {
+    particles.insert(particles.end(), slab.begin(), slab.end());
+    input.AppendPartition(MakeDataSet(slab));
+  }
+
+  vtkm::filter::connected_components::HaloFinder haloFinder;
+  haloFinder.SetLinkingLength(LinkingLength);
+  haloFinder.SetMinimumHaloSize(10);
+  const std::vector<vtkm::Id> expected = FindHalos(particles, 10);
+  const vtkm::cont::PartitionedDataSet output = haloFinder.Execute(input);
+  VTKM_TEST_ASSERT(output.GetNumberOfPartitions() == static_cast<vtkm::Id>(numPartitions));
+
+  std::size_t first = 0;
+  for (std::size_t p = 0; p < numPartitions; ++p)
+  {
+    CheckHaloIds(output.GetPartition(static_cast<vtkm::Id>(p)), expected, first);
+    first += slabs[p].size();
+  }
+}
+
+void TestHaloFinderPartitionedPrecision()
+{
+  std::cout << "Testing HaloFinder friends exactly at the linking length" << std::endl;
+  // The particles are exactly one linking length apart in double precision, but rounding
+  // their coordinates to single precision would put them 8 apart.
+  const vtkm::FloatDefault linkingLength = 0.5f;
+  const std::vector<vtkm::Vec3f_64> first = { vtkm::Vec3f_64(100000003.75, 0, 0) };
+  const std::vector<vtkm::Vec3f_64> second = { vtkm::Vec3f_64(100000004.25, 0, 0) };
+
+  vtkm::filter::connected_components::HaloFinder haloFinder;
+  haloFinder.SetLinkingLength(linkingLength);
+  haloFinder.SetMinimumHaloSize(2);
+  const std::vector<vtkm::Id> expected = { 0, 0 };
+
+  // The particles are friends whether or not they are in the same partition.
+  std::vector<vtkm::Vec3f_64> both = first;
+  both.insert(both.end(), second.begin(), second.end());
+  CheckHaloIds(haloFinder.Execute(MakeDataSet(both)), expected, 0);
+
+  vtkm::cont::PartitionedDataSet input;
+  input.AppendPartition(MakeDataSet(first));
+  input.AppendPartition(MakeDataSet(second));
+  const vtkm::cont::PartitionedDataSet output = haloFinder.Execute(input);
+  CheckHaloIds(output.GetPartition(0), expected, 0);
+  CheckHaloIds(output.GetPartition(1), expected, 1);
+}
+
+void TestHaloFinderFilter()
+{
+  TestHaloFinder();
+  TestHaloFinderPartitioned(4);
+  TestHaloFinderPartitioned(7);
+  TestHaloFinderPartitionedPrecision();
+}
+}
+
+int UnitTestHaloFinderFilter(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestHaloFinderFilter, argc, argv);
+}
@@ -14,7 +14,7 @@
 #include <vtkm/cont/Invoker.h>
 #include <vtkm/filter/connected_components/worklet/CellSetDualGraph.h>
 #include <vtkm/filter/connected_components/worklet/InnerJoin.h>
-#include <vtkm/filter/connected_components/worklet/UnionFind.h>
+#include <vtkm/worklet/connectivity/UnionFind.h>
 
 namespace vtkm
 {
@@ -19,7 +19,7 @@
 #include <vtkm/worklet/WorkletPointNeighborhood.h>
 
 #include <vtkm/filter/connected_components/worklet/InnerJoin.h>
-#include <vtkm/filter/connected_components/worklet/UnionFind.h>
+#include <vtkm/worklet/connectivity/UnionFind.h>
 
 
 namespace vtkm
@@ -72,6 +72,7 @@ vtkm::cont::DataSet ClipWithField::DoExecute(const vtkm::cont::DataSet& input)
   }
 
   vtkm::worklet::Clip worklet;
+  worklet.SetBlockSize(this->BlockSize);
 
   const vtkm::cont::UnknownCellSet& inputCellSet = input.GetCellSet();
   vtkm::cont::CellSetExplicit<> outputCellSet;
@@ -44,6 +44,18 @@ public:
   /// field is more than the specified clip value are removed.
   VTKM_CONT void SetInvertClip(bool invert) { this->Invert = invert; }
 
+  /// @brief Specifies the number of cells to process at a time.
+  ///
+  /// When set to a positive value smaller than the number of input cells, the cells are
+  /// processed in two passes over fixed-size blocks. The first pass sizes the output so
+  /// that it can be allocated once, and the second pass writes the output of each block in
+  /// place. This bounds the memory used for per-cell temporaries by the block size, which
+  /// helps when memory is tight. The result is identical to processing all cells at once.
+  /// The default of 0 processes all cells at once.
+  VTKM_CONT void SetBlockSize(vtkm::Id blockSize) { this->BlockSize = blockSize; }
+  /// @copydoc SetBlockSize
+  VTKM_CONT vtkm::Id GetBlockSize() const { return this->BlockSize; }
+
   /// @brief Specifies the field value for the clip operation.
   VTKM_CONT vtkm::Float64 GetClipValue() const { return this->ClipValue; }
 
@@ -55,6 +67,7 @@ private:
 
   vtkm::Float64 ClipValue = 0;
   bool Invert = false;
+  vtkm::Id BlockSize = 0;
 };
 } // namespace contour
 } // namespace filter
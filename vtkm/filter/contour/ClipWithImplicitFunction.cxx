@@ -69,6 +69,7 @@ vtkm::cont::DataSet ClipWithImplicitFunction::DoExecute(const vtkm::cont::DataSe
     input.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex());
 
   vtkm::worklet::Clip worklet;
+  worklet.SetBlockSize(this->BlockSize);
 
   vtkm::cont::CellSetExplicit<> outputCellSet =
     worklet.Run(inputCellSet, this->Function, this->Offset, inputCoords, this->Invert);
@@ -48,6 +48,11 @@ public:
   ///
   void SetInvertClip(bool invert) { this->Invert = invert; }
 
+  /// @copydoc vtkm::filter::contour::ClipWithField::SetBlockSize
+  VTKM_CONT void SetBlockSize(vtkm::Id blockSize) { this->BlockSize = blockSize; }
+  /// @copydoc vtkm::filter::contour::ClipWithField::SetBlockSize
+  VTKM_CONT vtkm::Id GetBlockSize() const { return this->BlockSize; }
+
   /// @brief Specifies the implicit function to be used to perform the clip operation.
   const vtkm::ImplicitFunctionGeneral& GetImplicitFunction() const { return this->Function; }
 
@@ -57,6 +62,7 @@ private:
   vtkm::ImplicitFunctionGeneral Function;
   vtkm::Float64 Offset = 0.0;
   bool Invert = false;
+  vtkm::Id BlockSize = 0;
 };
 } // namespace contour
 } // namespace filter
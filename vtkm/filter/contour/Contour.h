@@ -54,6 +54,7 @@ public:
 protected:
   // Needed by the subclass Slice
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& result) override;
+  VTKM_CONT bool CanFusePartitions() const override { return true; }
 };
 } // namespace contour
 } // namespace filter
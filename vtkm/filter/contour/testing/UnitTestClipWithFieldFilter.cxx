@@ -98,11 +98,35 @@ void TestClipVolume()
   const vtkm::cont::DataSet outputData = clip.Execute(ds);
 }
 
+void TestClipBlocks()
+{
+  std::cout << "Testing Clip Filter processed in blocks" << std::endl;
+
+  vtkm::cont::testing::MakeTestDataSet maker;
+  vtkm::cont::DataSet ds = maker.Make3DUniformDataSet3(vtkm::Id3(16));
+
+  vtkm::filter::contour::ClipWithField clip;
+  clip.SetClipValue(0.0);
+  clip.SetActiveField("pointvar");
+  const vtkm::cont::DataSet expected = clip.Execute(ds);
+  VTKM_TEST_ASSERT(expected.GetNumberOfCells() > 0);
+
+  for (vtkm::Id blockSize : { 1, 37, 1000, 5000 })
+  {
+    std::cout << "  block size " << blockSize << std::endl;
+    clip.SetBlockSize(blockSize);
+    const vtkm::cont::DataSet outputData = clip.Execute(ds);
+    VTKM_TEST_ASSERT(test_equal_DataSets(outputData, expected),
+                     "Clip in blocks differs from clip of all cells");
+  }
+}
+
 void TestClip()
 {
   //todo: add more clip tests
   TestClipExplicit();
   TestClipVolume();
+  TestClipBlocks();
 }
 }
 
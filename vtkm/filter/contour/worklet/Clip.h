@@ -19,9 +19,12 @@
 
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
 #include <vtkm/cont/ArrayHandlePermutation.h>
 #include <vtkm/cont/ArrayHandleView.h>
+#include <vtkm/cont/CastAndCall.h>
 #include <vtkm/cont/CellSetExplicit.h>
+#include <vtkm/cont/CellSetPermutation.h>
 #include <vtkm/cont/ConvertNumComponentsToOffsets.h>
 #include <vtkm/cont/CoordinateSystem.h>
 #include <vtkm/cont/Invoker.h>
@@ -31,6 +34,7 @@
 #include <vtkm/ImplicitFunction.h>
 
 #include <utility>
+#include <vector>
 #include <vtkm/exec/FunctorBase.h>
 
 #if defined(THRUST_MAJOR_VERSION) && THRUST_MAJOR_VERSION == 1 && THRUST_MINOR_VERSION == 8 && \
@@ -315,8 +319,9 @@ public:
   {
   public:
     VTKM_CONT
-    GenerateCellSet(vtkm::Float64 value)
+    GenerateCellSet(vtkm::Float64 value, vtkm::Id cellIdOffset = 0)
       : Value(value)
+      , CellIdOffset(cellIdOffset)
     {
     }
 
@@ -380,6 +385,8 @@ public:
                               IdArrayType& cellMapOutputToInput) const
     {
       (void)shape;
+      // When the cells are processed in blocks, the work index is relative to the block.
+      const vtkm::Id cellId = workIndex + this->CellIdOffset;
       vtkm::Id clipIndex = clipDataIndex;
       // Start index for the cells of this case.
       vtkm::Id cellIndex = clipStats.NumberOfCells;
@@ -419,7 +426,7 @@ public:
           {
             vtkm::IdComponent entry =
               static_cast<vtkm::IdComponent>(clippingData.ValueAt(clipIndex));
-            inCellInterpolationKeys.Set(inCellInterpPointIndex, workIndex);
+            inCellInterpolationKeys.Set(inCellInterpPointIndex, cellId);
             if (entry >= 100)
             {
               inCellInterpolationInfo.Set(inCellInterpPointIndex, points[entry - 100]);
@@ -504,7 +511,7 @@ public:
               edgeIndex++;
             }
           }
-          cellMapOutputToInput.Set(cellIndex, workIndex);
+          cellMapOutputToInput.Set(cellIndex, cellId);
           ++cellIndex;
         }
       }
@@ -520,6 +527,7 @@ public:
 
   private:
     vtkm::Float64 Value;
+    vtkm::Id CellIdOffset;
   };
 
   class ScatterEdgeConnectivity : public vtkm::worklet::WorkletMapField
@@ -589,27 +597,83 @@ public:
   {
   }
 
+  /// \brief Sets the number of cells processed at a time.
+  ///
+  /// By default (a block size of 0), the statistics for all cells are computed at once,
+  /// which requires several temporary arrays the size of the input cell set. When the block
+  /// size is positive and smaller than the number of cells, the cells are instead processed
+  /// in blocks of this size in two passes. The first pass counts the output of each block
+  /// so that the output arrays can be allocated to their final size. The second pass
+  /// generates the output of each block directly into those arrays. This bounds the size of
+  /// the per-cell temporaries by the block size at the cost of computing the clip case of
+  /// each cell twice. The output is the same regardless of the block size.
+  VTKM_CONT void SetBlockSize(vtkm::Id blockSize) { this->BlockSize = blockSize; }
+  VTKM_CONT vtkm::Id GetBlockSize() const { return this->BlockSize; }
+
   template <typename CellSetType, typename ScalarsArrayHandle>
   vtkm::cont::CellSetExplicit<> Run(const CellSetType& cellSet,
                                     const ScalarsArrayHandle& scalars,
                                     vtkm::Float64 value,
                                     bool invert)
+  {
+    // Blocks are permutations of the input cells, which must wrap a concrete cell set.
+    vtkm::cont::CellSetExplicit<> output;
+    vtkm::cont::CastAndCall(cellSet, [&](const auto& concreteCellSet) {
+      output = this->RunImpl(concreteCellSet, scalars, value, invert);
+    });
+    return output;
+  }
+
+  template <typename CellSetType, typename ScalarsArrayHandle>
+  vtkm::cont::CellSetExplicit<> RunImpl(const CellSetType& cellSet,
+                                        const ScalarsArrayHandle& scalars,
+                                        vtkm::Float64 value,
+                                        bool invert)
   {
     vtkm::cont::Invoker invoke;
 
+    const vtkm::Id numberOfInputCells = cellSet.GetNumberOfCells();
+    const bool processInBlocks = (this->BlockSize > 0) && (numberOfInputCells > this->BlockSize);
+
+    ComputeStats statsWorklet(value, invert);
+
     // Create the required output fields.
     vtkm::cont::ArrayHandle<ClipStats> clipStats;
     vtkm::cont::ArrayHandle<vtkm::Id> clipTableIndices;
-
-    //Send this CellSet to process
-    ComputeStats statsWorklet(value, invert);
-    invoke(statsWorklet, cellSet, scalars, this->ClipTablesInstance, clipStats, clipTableIndices);
+    vtkm::cont::ArrayHandle<ClipStats> cellSetStats;
 
     ClipStats zero;
-    vtkm::cont::ArrayHandle<ClipStats> cellSetStats;
-    ClipStats total =
-      vtkm::cont::Algorithm::ScanExclusive(clipStats, cellSetStats, ClipStats::SumOp(), zero);
-    clipStats.ReleaseResources();
+    ClipStats total;
+    // When processing in blocks, holds the offsets into the output for each block.
+    std::vector<ClipStats> blockOffsets;
+    if (!processInBlocks)
+    {
+      //Send this CellSet to process
+      invoke(statsWorklet, cellSet, scalars, this->ClipTablesInstance, clipStats, clipTableIndices);
+
+      total =
+        vtkm::cont::Algorithm::ScanExclusive(clipStats, cellSetStats, ClipStats::SumOp(), zero);
+      clipStats.ReleaseResources();
+    }
+    else
+    {
+      // First pass: count the output of each block without keeping the per-cell results.
+      total = zero;
+      for (vtkm::Id blockStart = 0; blockStart < numberOfInputCells;
+           blockStart += this->BlockSize)
+      {
+        auto blockCellSet = this->MakeBlockCellSet(cellSet, blockStart);
+        invoke(statsWorklet,
+               blockCellSet,
+               scalars,
+               this->ClipTablesInstance,
+               clipStats,
+               clipTableIndices);
+        blockOffsets.push_back(total);
+        total = ClipStats::SumOp{}(
+          total, vtkm::cont::Algorithm::Reduce(clipStats, zero, ClipStats::SumOp()));
+      }
+    }
 
     vtkm::cont::ArrayHandle<vtkm::UInt8> shapes;
     vtkm::cont::ArrayHandle<vtkm::IdComponent> numberOfIndices;
@@ -639,24 +703,52 @@ public:
     this->InCellInterpolationInfo.Allocate(total.NumberOfInCellInterpPoints);
     this->CellMapOutputToInput.Allocate(total.NumberOfCells);
 
+    auto generateCellSet = [&](const auto& cells, vtkm::Id cellIdOffset) {
+      GenerateCellSet cellSetWorklet(value, cellIdOffset);
+      invoke(cellSetWorklet,
+             cells,
+             scalars,
+             clipTableIndices,
+             cellSetStats,
+             this->ClipTablesInstance,
+             connectivityObject,
+             pointsOnlyConnectivityIndices,
+             edgePointReverseConnectivity,
+             edgeInterpolation,
+             cellPointReverseConnectivity,
+             cellPointEdgeReverseConnectivity,
+             cellPointEdgeInterpolation,
+             this->InCellInterpolationKeys,
+             this->InCellInterpolationInfo,
+             this->CellMapOutputToInput);
+    };
+
     //Send this CellSet to process
-    GenerateCellSet cellSetWorklet(value);
-    invoke(cellSetWorklet,
-           cellSet,
-           scalars,
-           clipTableIndices,
-           cellSetStats,
-           this->ClipTablesInstance,
-           connectivityObject,
-           pointsOnlyConnectivityIndices,
-           edgePointReverseConnectivity,
-           edgeInterpolation,
-           cellPointReverseConnectivity,
-           cellPointEdgeReverseConnectivity,
-           cellPointEdgeInterpolation,
-           this->InCellInterpolationKeys,
-           this->InCellInterpolationInfo,
-           this->CellMapOutputToInput);
+    if (!processInBlocks)
+    {
+      generateCellSet(cellSet, 0);
+    }
+    else
+    {
+      // Second pass: recompute the clip cases of each block and write its output at the
+      // offsets found in the first pass.
+      std::size_t blockIndex = 0;
+      for (vtkm::Id blockStart = 0; blockStart < numberOfInputCells;
+           blockStart += this->BlockSize, ++blockIndex)
+      {
+        auto blockCellSet = this->MakeBlockCellSet(cellSet, blockStart);
+        invoke(statsWorklet,
+               blockCellSet,
+               scalars,
+               this->ClipTablesInstance,
+               clipStats,
+               clipTableIndices);
+        vtkm::cont::Algorithm::ScanExclusive(
+          clipStats, cellSetStats, ClipStats::SumOp(), blockOffsets[blockIndex]);
+        generateCellSet(blockCellSet, blockStart);
+      }
+      clipStats.ReleaseResources();
+    }
     this->InterpolationKeysBuilt = false;
 
     clipTableIndices.ReleaseResources();
@@ -766,6 +858,15 @@ public:
     return output;
   }
 
+  template <typename CellSetType>
+  VTKM_CONT vtkm::cont::CellSetPermutation<CellSetType, vtkm::cont::ArrayHandleCounting<vtkm::Id>>
+  MakeBlockCellSet(const CellSetType& cellSet, vtkm::Id blockStart) const
+  {
+    vtkm::Id blockSize = vtkm::Min(this->BlockSize, cellSet.GetNumberOfCells() - blockStart);
+    return vtkm::cont::make_CellSetPermutation(
+      vtkm::cont::ArrayHandleCounting<vtkm::Id>(blockStart, 1, blockSize), cellSet);
+  }
+
   template <typename CellSetType, typename ImplicitFunction>
   class ClipWithImplicitFunction
   {
@@ -946,6 +1047,7 @@ private:
   vtkm::Id InCellPointsOffset;
   vtkm::worklet::Keys<vtkm::Id> InterpolationKeys;
   bool InterpolationKeysBuilt = false;
+  vtkm::Id BlockSize = 0;
 };
 }
 } // namespace vtkm::worklet
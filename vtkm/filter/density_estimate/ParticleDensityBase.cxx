@@ -8,7 +8,10 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ErrorBadValue.h>
 #include <vtkm/filter/density_estimate/ParticleDensityBase.h>
+#include <vtkm/filter/density_estimate/worklet/ParticleDeposition.h>
 #include <vtkm/worklet/WorkletMapField.h>
 
 namespace
@@ -52,6 +55,56 @@ VTKM_CONT void ParticleDensityBase::DoDivideByVolume(
   };
   this->CastAndCallScalarField(density, resolve);
 }
+
+VTKM_CONT vtkm::cont::UnknownArrayHandle ParticleDensityBase::Deposit(
+  const vtkm::cont::DataSet& input,
+  vtkm::IdComponent order) const
+{
+  const auto coords = input.GetCoordinateSystem().GetDataAsMultiplexer();
+  const bool sorted = this->Deposition == DepositionMode::Sorted;
+  const vtkm::Vec3f_64 origin(this->Origin);
+  const vtkm::Vec3f_64 spacing(this->Spacing);
+
+  vtkm::cont::UnknownArrayHandle result;
+  auto resolveType = [&](const auto& concrete) {
+    // use std::decay to remove const ref from the decltype of concrete.
+    using T = typename std::decay_t<decltype(concrete)>::ValueType;
+    vtkm::cont::ArrayHandle<T> density;
+    switch (order)
+    {
+      case 1:
+        vtkm::worklet::ParticleDeposition::Run<1>(
+          coords, concrete, origin, spacing, this->Dimension, sorted, density);
+        break;
+      case 2:
+        vtkm::worklet::ParticleDeposition::Run<2>(
+          coords, concrete, origin, spacing, this->Dimension, sorted, density);
+        break;
+      case 3:
+        vtkm::worklet::ParticleDeposition::Run<3>(
+          coords, concrete, origin, spacing, this->Dimension, sorted, density);
+        break;
+      case 4:
+        vtkm::worklet::ParticleDeposition::Run<4>(
+          coords, concrete, origin, spacing, this->Dimension, sorted, density);
+        break;
+      default:
+        throw vtkm::cont::ErrorBadValue("Unsupported mass assignment order.");
+    }
+    result = density;
+  };
+
+  if (this->ComputeNumberDensity)
+  {
+    resolveType(
+      vtkm::cont::make_ArrayHandleConstant(vtkm::FloatDefault{ 1 }, input.GetNumberOfPoints()));
+  }
+  else
+  {
+    this->CastAndCallScalarField(this->GetFieldFromDataSet(input), resolveType);
+  }
+  return result;
+}
 } // namespace density_estimate
 } // namespace filter
 } // namespace vtkm
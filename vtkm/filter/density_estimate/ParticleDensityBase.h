@@ -93,16 +93,44 @@ public:
              { this->Origin[2], this->Origin[2] + (this->Spacing[2] * this->Dimension[2]) } };
   }
 
+  /// @brief How the particles are accumulated in the grid.
+  enum struct DepositionMode
+  {
+    /// Each particle adds its mass to the grid with atomic operations. This is fast
+    /// when the particles are spread out, but atomic operations on the same values
+    /// contend with each other when many particles are close together.
+    Atomic,
+    /// The particles are sorted by the cell they are in, and each value of the grid sums
+    /// the mass of the particles in the cells around it. This uses no atomic operations,
+    /// and the result does not depend on the scheduling of the threads.
+    Sorted
+  };
+
+  /// @brief Specifies how the particles are accumulated in the grid.
+  ///
+  /// The default is `DepositionMode::Atomic`.
+  VTKM_CONT void SetDepositionMode(DepositionMode mode) { this->Deposition = mode; }
+  /// @copydoc SetDepositionMode
+  VTKM_CONT DepositionMode GetDepositionMode() const { return this->Deposition; }
+
 protected:
   // Note: we are using the paradoxical "const ArrayHandle&" parameter whose content can actually
   // be change by the function.
   VTKM_CONT void DoDivideByVolume(const vtkm::cont::UnknownArrayHandle& array) const;
 
+  // Deposits the active field (or the particle count) of the input on the grid with the
+  // mass assignment function of the given order: 1 for nearest grid point, 2 for cloud in
+  // cell, 3 for triangular shaped cloud and 4 for piecewise cubic spline. The values of
+  // order 1 are on the cells of the grid and those of higher orders on its points.
+  VTKM_CONT vtkm::cont::UnknownArrayHandle Deposit(const vtkm::cont::DataSet& input,
+                                                   vtkm::IdComponent order) const;
+
   vtkm::Id3 Dimension = { 100, 100, 100 }; // Cell dimension
   vtkm::Vec3f Origin = { 0.0f, 0.0f, 0.0f };
   vtkm::Vec3f Spacing = { 1.0f, 1.0f, 1.0f };
   bool ComputeNumberDensity = false;
   bool DivideByVolume = true;
+  DepositionMode Deposition = DepositionMode::Atomic;
 };
 } // namespace density_estimate
 } // namespace filter
@@ -0,0 +1,38 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/filter/density_estimate/ParticleDensityPiecewiseCubicSpline.h>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace density_estimate
+{
+
+VTKM_CONT vtkm::cont::DataSet ParticleDensityPiecewiseCubicSpline::DoExecute(
+  const vtkm::cont::DataSet& input)
+{
+  // Like ParticleDensityCloudInCell, particles deposit mass on the grid points.
+  auto uniform = vtkm::cont::DataSetBuilderUniform::Create(
+    this->Dimension + vtkm::Id3{ 1, 1, 1 }, this->Origin, this->Spacing);
+
+  auto density = this->Deposit(input, 4);
+  if (DivideByVolume)
+  {
+    this->DoDivideByVolume(density);
+  }
+  uniform.AddField(vtkm::cont::make_FieldPoint("density", density));
+  return uniform;
+}
+} // namespace density_estimate
+} // namespace filter
+} // namespace vtkm
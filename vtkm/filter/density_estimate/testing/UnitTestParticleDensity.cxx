@@ -15,8 +15,12 @@
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/filter/density_estimate/ParticleDensityCloudInCell.h>
 #include <vtkm/filter/density_estimate/ParticleDensityNearestGridPoint.h>
+#include <vtkm/filter/density_estimate/ParticleDensityPiecewiseCubicSpline.h>
+#include <vtkm/filter/density_estimate/ParticleDensityTriangularShapedCloud.h>
 #include <vtkm/worklet/DescriptiveStatistics.h>
 
+#include <random>
+
 void TestNGP()
 {
   const vtkm::Id N = 1000;
@@ -130,10 +134,169 @@ void TestCIC()
   VTKM_TEST_ASSERT(test_equal(counts_result.Sum(), mass_result.N(), 0.1));
 }
 
+vtkm::cont::DataSet MakeParticles(const std::vector<vtkm::Vec3f>& positions,
+                                  const std::vector<vtkm::FloatDefault>& mass)
+{
+  std::vector<vtkm::Id> connectivity(positions.size());
+  for (std::size_t i = 0; i < connectivity.size(); ++i)
+  {
+    connectivity[i] = static_cast<vtkm::Id>(i);
+  }
+  auto dataSet = vtkm::cont::DataSetBuilderExplicit::Create(
+    positions, vtkm::CellShapeTagVertex{}, 1, connectivity);
+  dataSet.AddCellField("mass", mass);
+  return dataSet;
+}
+
+vtkm::cont::ArrayHandle<vtkm::FloatDefault> Deposit(
+  vtkm::filter::density_estimate::ParticleDensityBase& filter,
+  const vtkm::cont::DataSet& dataSet)
+{
+  filter.SetActiveField("mass");
+  filter.SetDivideByVolume(false);
+  auto result = filter.Execute(dataSet);
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> density;
+  result.GetField("density").GetData().AsArrayHandle(density);
+  return density;
+}
+
+void TestAssignmentWeights()
+{
+  // One particle of mass 1 on a grid with a spacing of 0.5. The weights of the points
+  // around the particle are the products of the weights along each axis.
+  const vtkm::Id3 cellDims = { 4, 4, 4 };
+  const vtkm::Id3 pointDims = cellDims + vtkm::Id3{ 1, 1, 1 };
+  auto pointId = [&](vtkm::Id i, vtkm::Id j, vtkm::Id k) {
+    return i + pointDims[0] * (j + pointDims[1] * k);
+  };
+  auto check = [](vtkm::filter::density_estimate::ParticleDensityBase& filter,
+                  const vtkm::Vec3f& position,
+                  const std::vector<std::pair<vtkm::Id, vtkm::FloatDefault>>& expected) {
+    filter.SetDimension({ 4, 4, 4 });
+    filter.SetBounds({ { 0, 2 }, { 0, 2 }, { 0, 2 } });
+    auto portal = Deposit(filter, MakeParticles({ position }, { 1 })).ReadPortal();
+    for (const auto& value : expected)
+    {
+      VTKM_TEST_ASSERT(test_equal(portal.Get(value.first), value.second),
+                       "Wrong weight at ",
+                       value.first,
+                       ": ",
+                       portal.Get(value.first),
+                       " expected ",
+                       value.second);
+    }
+  };
+
+  std::cout << "Testing CIC weights" << std::endl;
+  // The particle is at 0.2, 0.4 and 0.6 of the cell (1, 1, 1) along each axis.
+  vtkm::filter::density_estimate::ParticleDensityCloudInCell cic;
+  check(cic,
+        { 0.6f, 0.7f, 0.8f },
+        { { pointId(1, 1, 1), 0.8f * 0.6f * 0.4f },
+          { pointId(2, 1, 1), 0.2f * 0.6f * 0.4f },
+          { pointId(1, 2, 2), 0.8f * 0.4f * 0.6f },
+          { pointId(2, 2, 2), 0.2f * 0.4f * 0.6f } });
+
+  std::cout << "Testing TSC weights" << std::endl;
+  // The particle is on the point (2, 2, 2), which gets 3/4 along each axis while its
+  // neighbors get 1/8.
+  vtkm::filter::density_estimate::ParticleDensityTriangularShapedCloud tsc;
+  check(tsc,
+        { 1, 1, 1 },
+        { { pointId(2, 2, 2), 0.75f * 0.75f * 0.75f },
+          { pointId(1, 2, 2), 0.125f * 0.75f * 0.75f },
+          { pointId(3, 1, 3), 0.125f * 0.125f * 0.125f } });
+
+  std::cout << "Testing PCS weights" << std::endl;
+  // On a point, the cubic spline gives 2/3 to the point and 1/6 to its neighbors.
+  vtkm::filter::density_estimate::ParticleDensityPiecewiseCubicSpline pcs;
+  check(pcs,
+        { 1, 1, 1 },
+        { { pointId(2, 2, 2), 8.0f / 27.0f },
+          { pointId(2, 3, 2), 1.0f / 6.0f * 4.0f / 9.0f },
+          { pointId(0, 2, 2), 0.0f },
+          { pointId(1, 1, 1), 1.0f / 216.0f } });
+}
+
+void TestHigherOrderMassConservation()
+{
+  std::cout << "Testing TSC and PCS mass conservation" << std::endl;
+  // Particles far enough from the boundary keep all their mass in the grid.
+  std::mt19937 rng(3);
+  std::uniform_real_distribution<vtkm::FloatDefault> inside(0.3f, 0.7f);
+  std::vector<vtkm::Vec3f> positions;
+  std::vector<vtkm::FloatDefault> mass;
+  vtkm::Float64 totalMass = 0;
+  for (int i = 0; i < 1000; ++i)
+  {
+    positions.push_back(vtkm::Vec3f(inside(rng), inside(rng), inside(rng)));
+    mass.push_back(inside(rng));
+    totalMass += mass.back();
+  }
+  const auto dataSet = MakeParticles(positions, mass);
+
+  vtkm::filter::density_estimate::ParticleDensityTriangularShapedCloud tsc;
+  vtkm::filter::density_estimate::ParticleDensityPiecewiseCubicSpline pcs;
+  for (vtkm::filter::density_estimate::ParticleDensityBase* filter :
+       { static_cast<vtkm::filter::density_estimate::ParticleDensityBase*>(&tsc),
+         static_cast<vtkm::filter::density_estimate::ParticleDensityBase*>(&pcs) })
+  {
+    filter->SetDimension({ 10, 10, 10 });
+    filter->SetBounds({ { 0, 1 }, { 0, 1 }, { 0, 1 } });
+    const auto density = Deposit(*filter, dataSet);
+    VTKM_TEST_ASSERT(density.GetNumberOfValues() == 11 * 11 * 11);
+    auto result = vtkm::worklet::DescriptiveStatistics::Run(density);
+    VTKM_TEST_ASSERT(test_equal(result.Sum(), totalMass, 1e-4));
+  }
+}
+
+void TestSortedDeposition()
+{
+  std::cout << "Testing sorted deposition" << std::endl;
+  // Clustered particles, some of them outside the grid.
+  std::mt19937 rng(5);
+  std::normal_distribution<vtkm::FloatDefault> cluster(0, 0.1f);
+  std::uniform_real_distribution<vtkm::FloatDefault> box(-0.1f, 1.1f);
+  std::vector<vtkm::Vec3f> positions;
+  std::vector<vtkm::FloatDefault> mass;
+  for (int i = 0; i < 3000; ++i)
+  {
+    const vtkm::FloatDefault center = (i % 3 == 0) ? 0.5f : 0.9f;
+    positions.push_back(i % 5 == 0
+                          ? vtkm::Vec3f(box(rng), box(rng), box(rng))
+                          : vtkm::Vec3f(center) +
+                            vtkm::Vec3f(cluster(rng), cluster(rng), cluster(rng)));
+    mass.push_back(0.5f + static_cast<vtkm::FloatDefault>(i % 7));
+  }
+  const auto dataSet = MakeParticles(positions, mass);
+
+  vtkm::filter::density_estimate::ParticleDensityNearestGridPoint ngp;
+  vtkm::filter::density_estimate::ParticleDensityCloudInCell cic;
+  vtkm::filter::density_estimate::ParticleDensityTriangularShapedCloud tsc;
+  vtkm::filter::density_estimate::ParticleDensityPiecewiseCubicSpline pcs;
+  using Base = vtkm::filter::density_estimate::ParticleDensityBase;
+  for (Base* filter : { static_cast<Base*>(&ngp),
+                        static_cast<Base*>(&cic),
+                        static_cast<Base*>(&tsc),
+                        static_cast<Base*>(&pcs) })
+  {
+    filter->SetDimension({ 12, 9, 7 });
+    filter->SetBounds({ { 0, 1 }, { 0, 1 }, { 0, 1 } });
+    VTKM_TEST_ASSERT(filter->GetDepositionMode() == Base::DepositionMode::Atomic);
+    const auto atomic = Deposit(*filter, dataSet);
+    filter->SetDepositionMode(Base::DepositionMode::Sorted);
+    const auto sorted = Deposit(*filter, dataSet);
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(atomic, sorted));
+  }
+}
+
 void TestParticleDensity()
 {
   TestNGP();
   TestCIC();
+  TestAssignmentWeights();
+  TestHigherOrderMassConservation();
+  TestSortedDeposition();
 }
 
 int UnitTestParticleDensity(int argc, char* argv[])
@@ -0,0 +1,398 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_worklet_ParticleDeposition_h
+#define vtk_m_worklet_ParticleDeposition_h
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/Invoker.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace particle_deposition
+{
+
+/// Mass assignment function of the given order. The position `u` of a particle is given in
+/// units of the grid spacing from the first grid point. `Weights` fills the weights of the
+/// `Order` grid nodes the particle is assigned to along one axis and returns the index of
+/// the first of them. A particle in cell `c` is only assigned to nodes `c - CellsAfter` to
+/// `c + CellsBefore`, so node `n` only receives particles of the cells `n - CellsBefore`
+/// to `n + CellsAfter`.
+template <vtkm::IdComponent Order>
+struct AssignmentFunction;
+
+// Nearest grid point. The nodes are the cells of the grid.
+template <>
+struct AssignmentFunction<1>
+{
+  static constexpr vtkm::IdComponent CellsBefore = 0;
+  static constexpr vtkm::IdComponent CellsAfter = 0;
+
+  VTKM_EXEC static vtkm::Id Weights(vtkm::Float64 u, vtkm::Vec<vtkm::Float64, 1>& weights)
+  {
+    weights[0] = 1.0;
+    return static_cast<vtkm::Id>(vtkm::Floor(u));
+  }
+};
+
+// Cloud in cell.
+template <>
+struct AssignmentFunction<2>
+{
+  static constexpr vtkm::IdComponent CellsBefore = 1;
+  static constexpr vtkm::IdComponent CellsAfter = 0;
+
+  VTKM_EXEC static vtkm::Id Weights(vtkm::Float64 u, vtkm::Vec<vtkm::Float64, 2>& weights)
+  {
+    const vtkm::Float64 cell = vtkm::Floor(u);
+    const vtkm::Float64 d = u - cell;
+    weights[0] = 1.0 - d;
+    weights[1] = d;
+    return static_cast<vtkm::Id>(cell);
+  }
+};
+
+// Triangular shaped cloud.
+template <>
+struct AssignmentFunction<3>
+{
+  static constexpr vtkm::IdComponent CellsBefore = 2;
+  static constexpr vtkm::IdComponent CellsAfter = 1;
+
+  VTKM_EXEC static vtkm::Id Weights(vtkm::Float64 u, vtkm::Vec<vtkm::Float64, 3>& weights)
+  {
+    const vtkm::Float64 nearest = vtkm::Floor(u + 0.5);
+    const vtkm::Float64 d = u - nearest;
+    weights[0] = 0.5 * (0.5 - d) * (0.5 - d);
+    weights[1] = 0.75 - d * d;
+    weights[2] = 0.5 * (0.5 + d) * (0.5 + d);
+    return static_cast<vtkm::Id>(nearest) - 1;
+  }
+};
+
+// Piecewise cubic spline.
+template <>
+struct AssignmentFunction<4>
+{
+  static constexpr vtkm::IdComponent CellsBefore = 2;
+  static constexpr vtkm::IdComponent CellsAfter = 1;
+
+  VTKM_EXEC static vtkm::Id Weights(vtkm::Float64 u, vtkm::Vec<vtkm::Float64, 4>& weights)
+  {
+    const vtkm::Float64 cell = vtkm::Floor(u);
+    const vtkm::Float64 d = u - cell;
+    const vtkm::Float64 r = 1.0 - d;
+    weights[0] = r * r * r / 6.0;
+    weights[1] = (4.0 - 6.0 * d * d + 3.0 * d * d * d) / 6.0;
+    weights[2] = (4.0 - 6.0 * r * r + 3.0 * r * r * r) / 6.0;
+    weights[3] = d * d * d / 6.0;
+    return static_cast<vtkm::Id>(cell) - 1;
+  }
+};
+
+// Maps particles to the uniform grid and computes their assignment weights.
+template <vtkm::IdComponent Order>
+class GridMapping
+{
+public:
+  VTKM_CONT GridMapping(const vtkm::Vec3f_64& origin,
+                        const vtkm::Vec3f_64& spacing,
+                        const vtkm::Id3& cellDims)
+    : Origin(origin)
+    , InverseSpacing(1.0 / spacing[0], 1.0 / spacing[1], 1.0 / spacing[2])
+    , CellDims(cellDims)
+    , NodeDims(Order == 1 ? cellDims : cellDims + vtkm::Id3(1, 1, 1))
+  {
+  }
+
+  // Returns false when the particle is outside the grid.
+  template <typename PointType>
+  VTKM_EXEC bool ToGrid(const PointType& point, vtkm::Vec3f_64& u) const
+  {
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      u[d] = (static_cast<vtkm::Float64>(point[d]) - this->Origin[d]) * this->InverseSpacing[d];
+      if (!(u[d] >= 0.0 && u[d] <= static_cast<vtkm::Float64>(this->CellDims[d])))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // The cell of a particle in the grid. The upper boundary of the grid belongs to the last
+  // cell, as with the cell locators.
+  VTKM_EXEC vtkm::Id Cell(const vtkm::Vec3f_64& u, vtkm::IdComponent d) const
+  {
+    return vtkm::Min(static_cast<vtkm::Id>(u[d]), this->CellDims[d] - 1);
+  }
+
+  VTKM_EXEC vtkm::Id3 Weights(const vtkm::Vec3f_64& u,
+                              vtkm::Vec<vtkm::Vec<vtkm::Float64, Order>, 3>& weights) const
+  {
+    vtkm::Id3 first;
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      first[d] = AssignmentFunction<Order>::Weights(u[d], weights[d]);
+    }
+    if (Order == 1)
+    {
+      first = vtkm::Id3(this->Cell(u, 0), this->Cell(u, 1), this->Cell(u, 2));
+    }
+    return first;
+  }
+
+  vtkm::Vec3f_64 Origin;
+  vtkm::Vec3f_64 InverseSpacing;
+  vtkm::Id3 CellDims;
+  vtkm::Id3 NodeDims;
+};
+
+// Adds the mass of each particle to its nodes with atomic operations.
+template <vtkm::IdComponent Order>
+class DepositAtomic : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn coords, FieldIn field, AtomicArrayInOut density);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  VTKM_CONT explicit DepositAtomic(const GridMapping<Order>& mapping)
+    : Mapping(mapping)
+  {
+  }
+
+  template <typename PointType, typename T, typename AtomicArray>
+  VTKM_EXEC void operator()(const PointType& point, const T value, AtomicArray& density) const
+  {
+    vtkm::Vec3f_64 u;
+    if (!this->Mapping.ToGrid(point, u))
+    {
+      // We simply ignore that particular particle when it is not in the mesh.
+      return;
+    }
+    vtkm::Vec<vtkm::Vec<vtkm::Float64, Order>, 3> weights;
+    const vtkm::Id3 first = this->Mapping.Weights(u, weights);
+    const vtkm::Id3& dims = this->Mapping.NodeDims;
+
+    for (vtkm::IdComponent k = 0; k < Order; ++k)
+    {
+      const vtkm::Id z = first[2] + k;
+      if (z < 0 || z >= dims[2])
+      {
+        continue;
+      }
+      for (vtkm::IdComponent j = 0; j < Order; ++j)
+      {
+        const vtkm::Id y = first[1] + j;
+        if (y < 0 || y >= dims[1])
+        {
+          continue;
+        }
+        const vtkm::Float64 weightYZ = weights[1][j] * weights[2][k];
+        for (vtkm::IdComponent i = 0; i < Order; ++i)
+        {
+          const vtkm::Id x = first[0] + i;
+          if (x < 0 || x >= dims[0])
+          {
+            continue;
+          }
+          density.Add(x + dims[0] * (y + dims[1] * z),
+                      static_cast<T>(value * weights[0][i] * weightYZ));
+        }
+      }
+    }
+  }
+
+private:
+  GridMapping<Order> Mapping;
+};
+
+// Finds the cell of each particle. Particles outside the grid get the number of cells.
+template <vtkm::IdComponent Order>
+class ComputeCell : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn coords, FieldOut cellId);
+  using ExecutionSignature = _2(_1);
+
+  VTKM_CONT explicit ComputeCell(const GridMapping<Order>& mapping)
+    : Mapping(mapping)
+  {
+  }
+
+  template <typename PointType>
+  VTKM_EXEC vtkm::Id operator()(const PointType& point) const
+  {
+    const vtkm::Id3& dims = this->Mapping.CellDims;
+    vtkm::Vec3f_64 u;
+    if (!this->Mapping.ToGrid(point, u))
+    {
+      return dims[0] * dims[1] * dims[2];
+    }
+    return this->Mapping.Cell(u, 0) +
+      dims[0] * (this->Mapping.Cell(u, 1) + dims[1] * this->Mapping.Cell(u, 2));
+  }
+
+private:
+  GridMapping<Order> Mapping;
+};
+
+// Sums the mass the particles of the surrounding cells assign to each node. The particles
+// are sorted by cell, so the cells of a row along x are one contiguous range of particles.
+// Each node only writes its own value, so no atomics are needed.
+template <vtkm::IdComponent Order>
+class DepositGather : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn nodeId,
+                                WholeArrayIn cellStarts,
+                                WholeArrayIn sortedCoords,
+                                WholeArrayIn sortedField,
+                                FieldOut density);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5);
+
+  VTKM_CONT explicit DepositGather(const GridMapping<Order>& mapping)
+    : Mapping(mapping)
+  {
+  }
+
+  template <typename StartPortalType,
+            typename PointPortalType,
+            typename FieldPortalType,
+            typename T>
+  VTKM_EXEC void operator()(vtkm::Id nodeId,
+                            const StartPortalType& cellStarts,
+                            const PointPortalType& sortedCoords,
+                            const FieldPortalType& sortedField,
+                            T& density) const
+  {
+    using Function = AssignmentFunction<Order>;
+    const vtkm::Id3& nodeDims = this->Mapping.NodeDims;
+    const vtkm::Id3& cellDims = this->Mapping.CellDims;
+    const vtkm::Id3 node(nodeId % nodeDims[0],
+                         (nodeId / nodeDims[0]) % nodeDims[1],
+                         nodeId / (nodeDims[0] * nodeDims[1]));
+
+    vtkm::Id3 firstCell;
+    vtkm::Id3 lastCell;
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      firstCell[d] = vtkm::Max(node[d] - Function::CellsBefore, vtkm::Id(0));
+      lastCell[d] = vtkm::Min(node[d] + Function::CellsAfter, cellDims[d] - 1);
+    }
+
+    vtkm::Float64 sum = 0.0;
+    for (vtkm::Id k = firstCell[2]; k <= lastCell[2]; ++k)
+    {
+      for (vtkm::Id j = firstCell[1]; j <= lastCell[1]; ++j)
+      {
+        const vtkm::Id row = cellDims[0] * (j + cellDims[1] * k);
+        const vtkm::Id begin = cellStarts.Get(row + firstCell[0]);
+        const vtkm::Id end = cellStarts.Get(row + lastCell[0] + 1);
+        for (vtkm::Id p = begin; p < end; ++p)
+        {
+          vtkm::Vec3f_64 u;
+          this->Mapping.ToGrid(sortedCoords.Get(p), u);
+          vtkm::Vec<vtkm::Vec<vtkm::Float64, Order>, 3> weights;
+          const vtkm::Id3 offset = node - this->Mapping.Weights(u, weights);
+          if (offset[0] < 0 || offset[0] >= Order || offset[1] < 0 || offset[1] >= Order ||
+              offset[2] < 0 || offset[2] >= Order)
+          {
+            continue;
+          }
+          sum += static_cast<vtkm::Float64>(sortedField.Get(p)) *
+            weights[0][static_cast<vtkm::IdComponent>(offset[0])] *
+            weights[1][static_cast<vtkm::IdComponent>(offset[1])] *
+            weights[2][static_cast<vtkm::IdComponent>(offset[2])];
+        }
+      }
+    }
+    density = static_cast<T>(sum);
+  }
+
+private:
+  GridMapping<Order> Mapping;
+};
+} // namespace particle_deposition
+
+/// Deposits the mass of particles on a uniform grid with the mass assignment function of
+/// order `Order`: 1 for nearest grid point, 2 for cloud in cell, 3 for triangular shaped
+/// cloud and 4 for piecewise cubic spline. The nearest grid point scheme deposits to the
+/// cells of the grid and the other schemes to its points. Particles outside the grid are
+/// ignored, and the mass assigned to nodes outside the grid is lost.
+///
+/// When `sorted` is false, each particle adds its mass to its nodes with atomic
+/// operations. When true, the particles are sorted by cell and each node gathers the mass
+/// of the particles of the cells around it, which avoids the contention of atomic
+/// operations on clustered particles and gives results that do not depend on the
+/// scheduling of the threads.
+class ParticleDeposition
+{
+public:
+  template <vtkm::IdComponent Order, typename PointArrayType, typename FieldArrayType, typename T>
+  static void Run(const PointArrayType& points,
+                  const FieldArrayType& field,
+                  const vtkm::Vec3f_64& origin,
+                  const vtkm::Vec3f_64& spacing,
+                  const vtkm::Id3& cellDims,
+                  bool sorted,
+                  vtkm::cont::ArrayHandle<T>& density)
+  {
+    using Algorithm = vtkm::cont::Algorithm;
+    const particle_deposition::GridMapping<Order> mapping(origin, spacing, cellDims);
+    const vtkm::Id numNodes = mapping.NodeDims[0] * mapping.NodeDims[1] * mapping.NodeDims[2];
+    vtkm::cont::Invoker invoke;
+
+    if (!sorted)
+    {
+      density.AllocateAndFill(numNodes, 0);
+      invoke(particle_deposition::DepositAtomic<Order>{ mapping }, points, field, density);
+      return;
+    }
+
+    const vtkm::Id numCells = cellDims[0] * cellDims[1] * cellDims[2];
+    vtkm::cont::ArrayHandle<vtkm::Id> cellIds;
+    invoke(particle_deposition::ComputeCell<Order>{ mapping }, points, cellIds);
+    vtkm::cont::ArrayHandle<vtkm::Id> particleIds;
+    vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(points.GetNumberOfValues()), particleIds);
+    Algorithm::SortByKey(cellIds, particleIds);
+
+    // Particles outside the grid are sorted after the last cell and never gathered.
+    vtkm::cont::ArrayHandle<vtkm::Id> cellStarts;
+    Algorithm::LowerBounds(
+      cellIds, vtkm::cont::ArrayHandleCounting<vtkm::Id>(0, 1, numCells + 1), cellStarts);
+
+    vtkm::cont::ArrayHandle<typename PointArrayType::ValueType> sortedPoints;
+    vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandlePermutation(particleIds, points),
+                          sortedPoints);
+    vtkm::cont::ArrayHandle<typename FieldArrayType::ValueType> sortedField;
+    vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandlePermutation(particleIds, field),
+                          sortedField);
+
+    invoke(particle_deposition::DepositGather<Order>{ mapping },
+           vtkm::cont::ArrayHandleIndex(numNodes),
+           cellStarts,
+           sortedPoints,
+           sortedField,
+           density);
+  }
+};
+}
+} // vtkm::worklet
+
+#endif // vtk_m_worklet_ParticleDeposition_h
@@ -8,21 +8,40 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/UncertainCellSet.h>
 #include <vtkm/filter/MapFieldPermutation.h>
 #include <vtkm/filter/clean_grid/CleanGrid.h>
 #include <vtkm/filter/entity_extraction/ExternalFaces.h>
 #include <vtkm/filter/entity_extraction/worklet/ExternalFaces.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace vtkm
 {
 namespace filter
 {
 namespace entity_extraction
 {
+//-----------------------------------------------------------------------------
+// The face adjacency of each cell set seen while `ReuseFaceAdjacency` is on. Each entry holds
+// its cell set, so that the cell set cannot be freed and its address given to another one.
+struct ExternalFaces::FaceAdjacencyCache
+{
+  struct Entry
+  {
+    vtkm::cont::UnknownCellSet CellSet;
+    vtkm::worklet::ExternalFaces::FaceAdjacency Adjacency;
+    bool Used;
+  };
+  std::vector<Entry> Entries;
+};
+
 //-----------------------------------------------------------------------------
 ExternalFaces::ExternalFaces()
-  : Worklet(std::make_unique<vtkm::worklet::ExternalFaces>())
+  : FaceAdjacencies(std::make_unique<FaceAdjacencyCache>())
+  , Worklet(std::make_unique<vtkm::worklet::ExternalFaces>())
 {
   this->SetPassPolyData(true);
 }
@@ -36,6 +55,61 @@ void ExternalFaces::SetPassPolyData(bool value)
   this->Worklet->SetPassPolyData(value);
 }
 
+//-----------------------------------------------------------------------------
+void ExternalFaces::SetReuseFaceAdjacency(bool value)
+{
+  this->ReuseFaceAdjacency = value;
+  if (!value)
+  {
+    this->FaceAdjacencies->Entries.clear();
+  }
+}
+
+//-----------------------------------------------------------------------------
+void ExternalFaces::RunWithFaceAdjacency(const vtkm::cont::DataSet& input,
+                                         vtkm::cont::CellSetExplicit<>& outCellSet)
+{
+  const vtkm::cont::UnknownCellSet& cells = input.GetCellSet();
+  auto cellSets = cells.ResetCellSetList<VTKM_DEFAULT_CELL_SET_LIST>();
+
+  auto& entries = this->FaceAdjacencies->Entries;
+  auto entry = std::find_if(entries.begin(), entries.end(), [&](const FaceAdjacencyCache::Entry& e) {
+    return e.CellSet.GetCellSetBase() == cells.GetCellSetBase();
+  });
+  if (entry != entries.end())
+  {
+    this->Worklet->SetFaceAdjacency(entry->Adjacency);
+    entry->Used = true;
+  }
+  else
+  {
+    this->Worklet->BuildFaceAdjacency(cellSets);
+    if (this->ReuseFaceAdjacency)
+    {
+      entries.push_back({ cells, this->Worklet->GetFaceAdjacency(), true });
+    }
+  }
+
+  // Outside of a partitioned execution, the input has only this cell set.
+  if (this->ReuseFaceAdjacency && !this->ExecutingPartitions)
+  {
+    entries.erase(std::remove_if(entries.begin(),
+                                 entries.end(),
+                                 [&](const FaceAdjacencyCache::Entry& e) {
+                                   return e.CellSet.GetCellSetBase() != cells.GetCellSetBase();
+                                 }),
+                  entries.end());
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::UInt8> ghostFlags;
+  vtkm::cont::ArrayCopyShallowIfPossible(input.GetGhostCellField().GetData(), ghostFlags);
+
+  this->Worklet->RunWithFaceAdjacency(cellSets, ghostFlags, this->HiddenCellTypes, outCellSet);
+
+  // The cache keeps its own reference to the arrays, so only let go of them here.
+  this->Worklet->SetFaceAdjacency({});
+}
+
 //-----------------------------------------------------------------------------
 vtkm::cont::DataSet ExternalFaces::GenerateOutput(const vtkm::cont::DataSet& input,
                                                   vtkm::cont::CellSetExplicit<>& outCellSet)
@@ -63,6 +137,36 @@ vtkm::cont::DataSet ExternalFaces::GenerateOutput(const vtkm::cont::DataSet& inp
   return this->CreateResult(input, outCellSet, mapper);
 }
 
+//-----------------------------------------------------------------------------
+vtkm::cont::PartitionedDataSet ExternalFaces::DoExecutePartitions(
+  const vtkm::cont::PartitionedDataSet& input)
+{
+  // Keep the face adjacencies of the cell sets of all the partitions, and drop the others.
+  // The partitions are not executed concurrently because this filter cannot thread.
+  auto& entries = this->FaceAdjacencies->Entries;
+  for (auto& entry : entries)
+  {
+    entry.Used = false;
+  }
+  this->ExecutingPartitions = true;
+  vtkm::cont::PartitionedDataSet output;
+  try
+  {
+    output = this->Filter::DoExecutePartitions(input);
+  }
+  catch (...)
+  {
+    this->ExecutingPartitions = false;
+    throw;
+  }
+  this->ExecutingPartitions = false;
+  entries.erase(std::remove_if(entries.begin(),
+                               entries.end(),
+                               [](const FaceAdjacencyCache::Entry& e) { return !e.Used; }),
+                entries.end());
+  return output;
+}
+
 //-----------------------------------------------------------------------------
 vtkm::cont::DataSet ExternalFaces::DoExecute(const vtkm::cont::DataSet& input)
 {
@@ -73,7 +177,11 @@ vtkm::cont::DataSet ExternalFaces::DoExecute(const vtkm::cont::DataSet& input)
   // external faces worklet
   vtkm::cont::CellSetExplicit<> outCellSet;
 
-  if (cells.CanConvert<vtkm::cont::CellSetStructured<3>>())
+  if (this->ReuseFaceAdjacency || (this->HiddenCellTypes != 0))
+  {
+    this->RunWithFaceAdjacency(input, outCellSet);
+  }
+  else if (cells.CanConvert<vtkm::cont::CellSetStructured<3>>())
   {
     this->Worklet->Run(cells.AsCellSet<vtkm::cont::CellSetStructured<3>>(),
                        input.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex()),
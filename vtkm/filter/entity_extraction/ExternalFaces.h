@@ -11,6 +11,7 @@
 #ifndef vtkm_filter_entity_extraction_ExternalFaces_h
 #define vtkm_filter_entity_extraction_ExternalFaces_h
 
+#include <vtkm/cont/UnknownCellSet.h>
 #include <vtkm/filter/Filter.h>
 #include <vtkm/filter/entity_extraction/vtkm_filter_entity_extraction_export.h>
 
@@ -60,16 +61,58 @@ public:
   /// @copydoc GetPassPolyData
   VTKM_CONT void SetPassPolyData(bool value);
 
+  /// @brief Specify which types of cells to treat as hidden.
+  ///
+  /// The types are specified by the flags in `vtkm::CellClassification` and matched
+  /// against the ghost cell field of the input. Any cell with a ghost flag matching one
+  /// or more of these flags is treated as if it were not in the mesh, so the faces it
+  /// shares with visible cells become external faces. The default is 0, which uses all
+  /// cells regardless of the ghost cell field.
+  ///
+  /// Hiding cells requires the face adjacency of the input topology. See
+  /// `SetReuseFaceAdjacency` to avoid rebuilding it on every execution.
+  VTKM_CONT void SetHiddenCellTypes(vtkm::UInt8 typeFlags) { this->HiddenCellTypes = typeFlags; }
+  /// @copydoc SetHiddenCellTypes
+  VTKM_CONT vtkm::UInt8 GetHiddenCellTypes() const { return this->HiddenCellTypes; }
+
+  /// @brief Option to build the face adjacency of the input once and reuse it.
+  ///
+  /// When on, the filter computes which cells share each face the first time it is
+  /// executed and keeps this face adjacency. Subsequent executions on the same cell set
+  /// (that is, data sets sharing the same `vtkm::cont::CellSet` object, as happens when
+  /// only fields change) skip the face hashing and extract the external faces of the
+  /// visible cells in a few passes over the faces. This is most useful when the topology
+  /// is fixed but the hidden cells (see `SetHiddenCellTypes`) change every time step.
+  /// A face adjacency is kept for each cell set of the latest input, so each partition
+  /// of a `vtkm::cont::PartitionedDataSet` reuses its own. Those of cell sets that are
+  /// no longer in the input are dropped. When off (the default), the face adjacency is
+  /// discarded after each execution.
+  VTKM_CONT bool GetReuseFaceAdjacency() const { return this->ReuseFaceAdjacency; }
+  /// @copydoc GetReuseFaceAdjacency
+  VTKM_CONT void SetReuseFaceAdjacency(bool value);
+
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
+  VTKM_CONT vtkm::cont::PartitionedDataSet DoExecutePartitions(
+    const vtkm::cont::PartitionedDataSet& input) override;
 
   vtkm::cont::DataSet GenerateOutput(const vtkm::cont::DataSet& input,
                                      vtkm::cont::CellSetExplicit<>& outCellSet);
 
   VTKM_CONT bool MapFieldOntoOutput(vtkm::cont::DataSet& result, const vtkm::cont::Field& field);
 
+  VTKM_CONT void RunWithFaceAdjacency(const vtkm::cont::DataSet& input,
+                                      vtkm::cont::CellSetExplicit<>& outCellSet);
+
   bool CompactPoints = false;
   bool PassPolyData = true;
+  bool ReuseFaceAdjacency = false;
+  vtkm::UInt8 HiddenCellTypes = 0;
+
+  // The face adjacencies kept for reuse, defined in the .cxx file like the worklet.
+  struct FaceAdjacencyCache;
+  std::unique_ptr<FaceAdjacencyCache> FaceAdjacencies;
+  bool ExecutingPartitions = false;
 
   // Note: This shared state as a data member requires us to explicitly implement the
   // constructor and destructor in the .cxx file, after the compiler actually have
@@ -18,7 +18,8 @@ namespace
 {
 bool DoMapField(vtkm::cont::DataSet& result,
                 const vtkm::cont::Field& field,
-                const vtkm::worklet::ExtractGeometry& worklet)
+                const vtkm::worklet::ExtractGeometry& worklet,
+                bool deferFieldMapping)
 {
   if (field.IsPointField())
   {
@@ -28,6 +29,11 @@ bool DoMapField(vtkm::cont::DataSet& result,
   else if (field.IsCellField())
   {
     vtkm::cont::ArrayHandle<vtkm::Id> permutation = worklet.GetValidCellIds();
+    if (deferFieldMapping)
+    {
+      result.AddField(field.Permute(permutation));
+      return true;
+    }
     return vtkm::filter::MapFieldPermutation(field, permutation, result);
   }
   else if (field.IsWholeDataSetField())
@@ -69,7 +75,9 @@ vtkm::cont::DataSet ExtractGeometry::DoExecute(const vtkm::cont::DataSet& input)
   });
 
   // create the output dataset
-  auto mapper = [&](auto& result, const auto& f) { DoMapField(result, f, worklet); };
+  auto mapper = [&](auto& result, const auto& f) {
+    DoMapField(result, f, worklet, this->DeferFieldMapping);
+  };
   return this->CreateResult(input, outCells, mapper);
 }
 
@@ -105,6 +105,17 @@ public:
   VTKM_CONT
   void ExtractOnlyBoundaryCellsOff() { this->ExtractOnlyBoundaryCells = false; }
 
+  /// @brief Specifies whether the cell fields are permuted lazily.
+  ///
+  /// When on, the cell fields of the output reference the input fields through deferred
+  /// permutations (see `vtkm::cont::Field::Permute()`) and are only copied when first used.
+  /// This is off by default.
+  VTKM_CONT
+  bool GetDeferFieldMapping() const { return this->DeferFieldMapping; }
+  /// @copydoc GetDeferFieldMapping
+  VTKM_CONT
+  void SetDeferFieldMapping(bool value) { this->DeferFieldMapping = value; }
+
 private:
   VTKM_CONT
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
@@ -112,6 +123,7 @@ private:
   bool ExtractInside = true;
   bool ExtractBoundaryCells = false;
   bool ExtractOnlyBoundaryCells = false;
+  bool DeferFieldMapping = false;
   vtkm::ImplicitFunctionGeneral Function;
 };
 } // namespace entity_extraction
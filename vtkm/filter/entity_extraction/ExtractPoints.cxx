@@ -67,6 +67,7 @@ vtkm::cont::DataSet ExtractPoints::DoExecute(const vtkm::cont::DataSet& input)
     vtkm::filter::clean_grid::CleanGrid compactor;
     compactor.SetCompactPointFields(true);
     compactor.SetMergePoints(false);
+    compactor.SetDeferFieldMapping(this->DeferFieldMapping);
     return compactor.Execute(output);
   }
   else
@@ -47,6 +47,18 @@ public:
   VTKM_CONT
   void SetCompactPoints(bool value) { this->CompactPoints = value; }
 
+  /// @brief Specifies whether compacted point fields are permuted lazily.
+  ///
+  /// Only has an effect when `SetCompactPoints()` is on. The compacted point fields then
+  /// reference the input fields through deferred permutations (see
+  /// `vtkm::cont::Field::Permute()`) and are only copied when first used. This is off by
+  /// default.
+  VTKM_CONT
+  bool GetDeferFieldMapping() const { return this->DeferFieldMapping; }
+  /// @copydoc GetDeferFieldMapping
+  VTKM_CONT
+  void SetDeferFieldMapping(bool value) { this->DeferFieldMapping = value; }
+
   /// @brief Specifies the implicit function to be used to perform extract points.
   ///
   /// Only a limited number of implicit functions are supported. See
@@ -82,6 +94,7 @@ private:
   vtkm::ImplicitFunctionGeneral Function;
 
   bool CompactPoints = false;
+  bool DeferFieldMapping = false;
 };
 } // namespace entity_extraction
 } // namespace filter
@@ -15,7 +15,8 @@ namespace
 {
 VTKM_CONT bool DoMapField(vtkm::cont::DataSet& result,
                           const vtkm::cont::Field& field,
-                          const vtkm::worklet::Mask& worklet)
+                          const vtkm::worklet::Mask& worklet,
+                          bool deferFieldMapping)
 {
   if (field.IsPointField() || field.IsWholeDataSetField())
   {
@@ -24,6 +25,11 @@ VTKM_CONT bool DoMapField(vtkm::cont::DataSet& result,
   }
   else if (field.IsCellField())
   {
+    if (deferFieldMapping)
+    {
+      result.AddField(field.Permute(worklet.GetValidCellIds()));
+      return true;
+    }
     return vtkm::filter::MapFieldPermutation(field, worklet.GetValidCellIds(), result);
   }
   else
@@ -50,7 +56,9 @@ VTKM_CONT vtkm::cont::DataSet Mask::DoExecute(const vtkm::cont::DataSet& input)
     [&](const auto& concrete) { cellOut = worklet.Run(concrete, this->Stride); });
 
   // create the output dataset
-  auto mapper = [&](auto& result, const auto& f) { DoMapField(result, f, worklet); };
+  auto mapper = [&](auto& result, const auto& f) {
+    DoMapField(result, f, worklet, this->DeferFieldMapping);
+  };
   return this->CreateResult(input, cellOut, mapper);
 }
 } // namespace entity_extraction
@@ -39,12 +39,20 @@ public:
   VTKM_CONT
   void SetStride(vtkm::Id& stride) { this->Stride = stride; }
 
+  // When DeferFieldMapping is set, the cell fields of the output are permuted lazily (see
+  // vtkm::cont::Field::Permute) and only copied when they are first used
+  VTKM_CONT
+  bool GetDeferFieldMapping() const { return this->DeferFieldMapping; }
+  VTKM_CONT
+  void SetDeferFieldMapping(bool value) { this->DeferFieldMapping = value; }
+
 private:
   VTKM_CONT
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
   vtkm::Id Stride = 1;
   bool CompactPoints = false;
+  bool DeferFieldMapping = false;
 };
 } // namespace entity_extraction
 } // namespace filter
@@ -44,7 +44,8 @@ private:
 
 bool DoMapField(vtkm::cont::DataSet& result,
                 const vtkm::cont::Field& field,
-                const vtkm::worklet::Threshold& worklet)
+                const vtkm::worklet::Threshold& worklet,
+                bool deferFieldMapping)
 {
   if (field.IsPointField() || field.IsWholeDataSetField())
   {
@@ -54,6 +55,11 @@ bool DoMapField(vtkm::cont::DataSet& result,
   }
   else if (field.IsCellField())
   {
+    if (deferFieldMapping)
+    {
+      result.AddField(field.Permute(worklet.GetValidCellIds()));
+      return true;
+    }
     return vtkm::filter::MapFieldPermutation(field, worklet.GetValidCellIds(), result);
   }
   else
@@ -128,6 +134,7 @@ vtkm::cont::DataSet Threshold::DoExecute(const vtkm::cont::DataSet& input)
 
   ThresholdRange predicate(this->GetLowerThreshold(), this->GetUpperThreshold());
   vtkm::worklet::Threshold worklet;
+  worklet.SetBlockSize(this->BlockSize);
   vtkm::cont::UnknownCellSet cellOut;
 
   auto callWithArrayBaseComponent = [&](auto baseComp) {
@@ -181,7 +188,9 @@ vtkm::cont::DataSet Threshold::DoExecute(const vtkm::cont::DataSet& input)
 
   vtkm::ListForEach(callWithArrayBaseComponent, vtkm::TypeListScalarAll{});
 
-  auto mapper = [&](auto& result, const auto& f) { DoMapField(result, f, worklet); };
+  auto mapper = [&](auto& result, const auto& f) {
+    DoMapField(result, f, worklet, this->DeferFieldMapping);
+  };
   return this->CreateResult(input, cellOut, mapper);
 }
 } // namespace entity_extraction
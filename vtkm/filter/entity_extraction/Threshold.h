@@ -106,9 +106,25 @@ public:
   /// @copydoc SetInvert
   VTKM_CONT bool GetInvert() const { return this->Invert; }
 
+  /// @copydoc vtkm::filter::contour::ClipWithField::SetBlockSize
+  VTKM_CONT void SetBlockSize(vtkm::Id blockSize) { this->BlockSize = blockSize; }
+  /// @copydoc vtkm::filter::contour::ClipWithField::SetBlockSize
+  VTKM_CONT vtkm::Id GetBlockSize() const { return this->BlockSize; }
+
+  /// @brief Specifies whether the cell fields are permuted lazily.
+  ///
+  /// When set to true, the cell fields of the output are deferred permutations of the input
+  /// fields (see `vtkm::cont::Field::Permute()`). The values of a field are gathered only
+  /// when the field is first used, so the fields that are never used are never copied. When
+  /// false (the default), every cell field is copied when the filter executes.
+  VTKM_CONT void SetDeferFieldMapping(bool value) { this->DeferFieldMapping = value; }
+  /// @copydoc SetDeferFieldMapping
+  VTKM_CONT bool GetDeferFieldMapping() const { return this->DeferFieldMapping; }
+
 private:
   VTKM_CONT
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
+  VTKM_CONT bool CanFusePartitions() const override { return true; }
 
   double LowerValue = 0;
   double UpperValue = 0;
@@ -125,6 +141,8 @@ private:
 
   bool AllInRange = false;
   bool Invert = false;
+  vtkm::Id BlockSize = 0;
+  bool DeferFieldMapping = false;
 };
 } // namespace entity_extraction
 } // namespace filter
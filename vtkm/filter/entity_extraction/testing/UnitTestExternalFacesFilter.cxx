@@ -8,6 +8,10 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/CellClassification.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/cont/PartitionedDataSet.h>
+
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 
@@ -135,6 +139,116 @@ void TestWithMixed2Dand3DMesh()
   TestExternalFacesExplicitGrid(ds, true, 6, 5, false);
 }
 
+// Marks the cells of a 4x4x4 cell grid for which `hide` returns true as blanked.
+template <typename HideFunctor>
+void SetBlankedCells(vtkm::cont::DataSet& ds, HideFunctor hide)
+{
+  vtkm::cont::ArrayHandle<vtkm::UInt8> ghosts;
+  ghosts.Allocate(64);
+  auto portal = ghosts.WritePortal();
+  for (vtkm::Id k = 0; k < 4; ++k)
+  {
+    for (vtkm::Id j = 0; j < 4; ++j)
+    {
+      for (vtkm::Id i = 0; i < 4; ++i)
+      {
+        portal.Set(i + 4 * (j + 4 * k),
+                   hide(i, j, k) ? vtkm::CellClassification::Blanked
+                                 : vtkm::CellClassification::Normal);
+      }
+    }
+  }
+  ds.SetGhostCellField(ghosts);
+}
+
+void TestHiddenCells(vtkm::cont::DataSet ds)
+{
+  vtkm::filter::entity_extraction::ExternalFaces externalFaces;
+  externalFaces.SetHiddenCellTypes(vtkm::CellClassification::Blanked);
+  externalFaces.SetReuseFaceAdjacency(true);
+
+  auto checkNumFaces = [&](vtkm::Id numExpectedExtFaces) {
+    vtkm::cont::DataSet resultds = externalFaces.Execute(ds);
+    const vtkm::Id numOutputExtFaces = resultds.GetNumberOfCells();
+    VTKM_TEST_ASSERT(numOutputExtFaces == numExpectedExtFaces,
+                     "Number of External Faces mismatch. Expected ",
+                     numExpectedExtFaces,
+                     ", got ",
+                     numOutputExtFaces);
+    VTKM_TEST_ASSERT(resultds.HasField("cellvar"), "Cell field not mapped successfully");
+  };
+
+  std::cout << "No hidden cells\n";
+  checkNumFaces(96);
+
+  std::cout << "Hide interior cells\n";
+  SetBlankedCells(ds, [](vtkm::Id i, vtkm::Id j, vtkm::Id k) {
+    return (i > 0) && (i < 3) && (j > 0) && (j < 3) && (k > 0) && (k < 3);
+  });
+  checkNumFaces(96 + 24); // Adds the 2x2x2 cavity
+
+  std::cout << "Hide bottom layer\n";
+  SetBlankedCells(ds, [](vtkm::Id, vtkm::Id, vtkm::Id k) { return k == 0; });
+  checkNumFaces(2 * 16 + 4 * 12); // 4x4x3 block
+
+  std::cout << "Hide all cells\n";
+  SetBlankedCells(ds, [](vtkm::Id, vtkm::Id, vtkm::Id) { return true; });
+  checkNumFaces(0);
+
+  std::cout << "Compare with filter without face adjacency\n";
+  SetBlankedCells(ds, [](vtkm::Id i, vtkm::Id j, vtkm::Id) { return (i + j) == 3; });
+  vtkm::filter::entity_extraction::ExternalFaces reference;
+  vtkm::cont::DataSet referenceResult = reference.Execute(ds);
+  externalFaces.SetHiddenCellTypes(0);
+  VTKM_TEST_ASSERT(externalFaces.Execute(ds).GetNumberOfCells() ==
+                   referenceResult.GetNumberOfCells());
+}
+
+void TestWithHiddenCells()
+{
+  std::cout << "Testing with hidden cells on Hexahedra mesh\n";
+  TestHiddenCells(MakeDataTestSet1());
+  std::cout << "Testing with hidden cells on Uniform mesh\n";
+  TestHiddenCells(MakeDataTestSet3());
+}
+
+void TestHiddenCellsPartitioned()
+{
+  std::cout << "Testing with hidden cells on partitions\n";
+  // Two partitions of different sizes, so that the face adjacency of one partition cannot
+  // be used for the other.
+  vtkm::cont::DataSet large = MakeDataTestSet3();
+  vtkm::cont::DataSet small = vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id3(3, 3, 3));
+
+  vtkm::filter::entity_extraction::ExternalFaces externalFaces;
+  externalFaces.SetHiddenCellTypes(vtkm::CellClassification::Blanked);
+  externalFaces.SetReuseFaceAdjacency(true);
+  vtkm::filter::entity_extraction::ExternalFaces reference;
+  reference.SetHiddenCellTypes(vtkm::CellClassification::Blanked);
+
+  for (vtkm::Id hidden : { 0, 5, 7 })
+  {
+    SetBlankedCells(large, [&](vtkm::Id i, vtkm::Id j, vtkm::Id k) {
+      return (i + j + k) == hidden % 4;
+    });
+    vtkm::cont::ArrayHandle<vtkm::UInt8> ghosts;
+    ghosts.AllocateAndFill(8, vtkm::CellClassification::Normal);
+    ghosts.WritePortal().Set(hidden, vtkm::CellClassification::Blanked);
+    small.SetGhostCellField(ghosts);
+
+    const vtkm::cont::PartitionedDataSet input({ large, small });
+    const vtkm::cont::PartitionedDataSet result = externalFaces.Execute(input);
+    const vtkm::cont::PartitionedDataSet expected = reference.Execute(input);
+    for (vtkm::Id p = 0; p < input.GetNumberOfPartitions(); ++p)
+    {
+      VTKM_TEST_ASSERT(result.GetPartition(p).GetNumberOfCells() ==
+                         expected.GetPartition(p).GetNumberOfCells(),
+                       "Number of external faces mismatch in partition ",
+                       p);
+    }
+  }
+}
+
 void TestExternalFacesFilter()
 {
   TestWithHeterogeneousMesh();
@@ -142,6 +256,8 @@ void TestExternalFacesFilter()
   TestWithUniformMesh();
   TestWithRectilinearMesh();
   TestWithMixed2Dand3DMesh();
+  TestWithHiddenCells();
+  TestHiddenCellsPartitioned();
 }
 
 } // anonymous namespace
@@ -311,6 +311,80 @@ public:
     VTKM_TEST_ASSERT(failures == 0, "Some combinations have failed");
   }
 
+  static void TestBlocks()
+  {
+    std::cout << "Testing threshold processed in blocks" << std::endl;
+    vtkm::cont::DataSet dataset = MakeTestDataSet().Make3DUniformDataSet3(vtkm::Id3(16));
+
+    auto runThreshold = [&](const std::string& fieldName,
+                            vtkm::Float64 lower,
+                            vtkm::Float64 upper,
+                            vtkm::Id blockSize) {
+      vtkm::filter::entity_extraction::Threshold threshold;
+      threshold.SetThresholdBetween(lower, upper);
+      threshold.SetActiveField(fieldName);
+      threshold.SetBlockSize(blockSize);
+      return threshold.Execute(dataset);
+    };
+
+    for (vtkm::Id blockSize : { 1, 100, 1024, 5000 })
+    {
+      std::cout << "  block size " << blockSize << std::endl;
+      for (const auto& fieldName : { std::string("pointvar"), std::string("cellvar") })
+      {
+        vtkm::Float64 lower = (fieldName == "pointvar") ? 1.0 : 500.0;
+        vtkm::Float64 upper = (fieldName == "pointvar") ? 4.0 : 2000.0;
+        vtkm::cont::DataSet expected = runThreshold(fieldName, lower, upper, 0);
+        vtkm::cont::DataSet output = runThreshold(fieldName, lower, upper, blockSize);
+
+        VTKM_TEST_ASSERT(expected.GetNumberOfCells() > 0);
+        VTKM_TEST_ASSERT(output.GetNumberOfCells() == expected.GetNumberOfCells(),
+                         "Wrong number of cells");
+        // cellvar holds the input cell ids, so the cells must come out in the same order.
+        VTKM_TEST_ASSERT(test_equal_ArrayHandles(output.GetField("cellvar").GetData(),
+                                                 expected.GetField("cellvar").GetData()));
+        VTKM_TEST_ASSERT(test_equal_DataSets(output, expected));
+      }
+    }
+  }
+
+  static void TestDeferFieldMapping()
+  {
+    std::cout << "Testing threshold with deferred field mapping" << std::endl;
+    vtkm::cont::DataSet dataset = MakeTestDataSet().Make3DUniformDataSet3(vtkm::Id3(16));
+
+    auto runThreshold = [](const vtkm::cont::DataSet& input,
+                           vtkm::Float64 lower,
+                           vtkm::Float64 upper,
+                           bool defer) {
+      vtkm::filter::entity_extraction::Threshold threshold;
+      threshold.SetThresholdBetween(lower, upper);
+      threshold.SetActiveField("pointvar");
+      threshold.SetDeferFieldMapping(defer);
+      return threshold.Execute(input);
+    };
+
+    vtkm::cont::DataSet expected = runThreshold(dataset, 1.0, 4.0, false);
+    VTKM_TEST_ASSERT(!expected.GetField("cellvar").IsDataDeferred());
+    expected = runThreshold(expected, 2.0, 3.0, false);
+
+    vtkm::cont::DataSet output = runThreshold(dataset, 1.0, 4.0, true);
+    VTKM_TEST_ASSERT(output.GetField("cellvar").IsDataDeferred());
+    VTKM_TEST_ASSERT(!output.GetField("pointvar").IsDataDeferred());
+    // Thresholding the output again combines the two permutations without copying.
+    output = runThreshold(output, 2.0, 3.0, true);
+    vtkm::cont::Field cellField = output.GetField("cellvar");
+    VTKM_TEST_ASSERT(cellField.IsDataDeferred());
+    VTKM_TEST_ASSERT(cellField.GetNumberOfValues() == expected.GetNumberOfCells());
+
+    VTKM_TEST_ASSERT(expected.GetNumberOfCells() > 0);
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(cellField.GetData(),
+                                             expected.GetField("cellvar").GetData()));
+    VTKM_TEST_ASSERT(!cellField.IsDataDeferred());
+    VTKM_TEST_ASSERT(cellField.GetData().IsType<vtkm::cont::ArrayHandle<vtkm::Float64>>());
+    VTKM_TEST_ASSERT(test_equal_DataSets(output, expected));
+  }
+
   // Regression test for issue #804
   static void RegressionTest804()
   {
@@ -342,6 +416,8 @@ public:
     TestingThreshold::TestExplicit3DZeroResults();
     TestingThreshold::TestAllOptions();
     TestingThreshold::RegressionTest804();
+    TestingThreshold::TestBlocks();
+    TestingThreshold::TestDeferFieldMapping();
   }
 };
 }
@@ -754,6 +754,249 @@ public:
     T Bias;
   };
 
+  // Worklet that records, for each face of each cell, the cell on the other side of the
+  // face. Faces on the boundary of the mesh get a neighbor of -1. Relies on FaceCounts
+  // having placed the external faces of each hash first, followed by the pairs of matching
+  // internal faces.
+  class BuildFaceNeighbors : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn cellAndFaceIdOfFacesInHash,
+                                  FieldIn numExternalFacesInHash,
+                                  WholeArrayIn facesPerCellOffsets,
+                                  WholeArrayOut faceNeighbors);
+    using ExecutionSignature = void(_1, _2, _3, _4);
+    using InputDomain = _1;
+
+    template <typename CellAndFaceIdOfFacesInHash, typename OffsetsPortal, typename NeighborsPortal>
+    VTKM_EXEC void operator()(const CellAndFaceIdOfFacesInHash& cellAndFaceIdOfFacesInHash,
+                              vtkm::IdComponent numExternalFacesInHash,
+                              const OffsetsPortal& facesPerCellOffsets,
+                              const NeighborsPortal& faceNeighbors) const
+    {
+      const vtkm::IdComponent numFacesInHash = cellAndFaceIdOfFacesInHash.GetNumberOfComponents();
+      CellFaceIdPacker::CellIdType cellId, otherCellId;
+      CellFaceIdPacker::FaceIdType faceId, otherFaceId;
+      vtkm::IdComponent faceIndex = 0;
+      for (; faceIndex < numExternalFacesInHash; ++faceIndex)
+      {
+        CellFaceIdPacker::Unpack(cellAndFaceIdOfFacesInHash[faceIndex], cellId, faceId);
+        faceNeighbors.Set(facesPerCellOffsets.Get(cellId) + faceId, -1);
+      }
+      for (; faceIndex + 1 < numFacesInHash; faceIndex += 2)
+      {
+        CellFaceIdPacker::Unpack(cellAndFaceIdOfFacesInHash[faceIndex], cellId, faceId);
+        CellFaceIdPacker::Unpack(
+          cellAndFaceIdOfFacesInHash[faceIndex + 1], otherCellId, otherFaceId);
+        faceNeighbors.Set(facesPerCellOffsets.Get(cellId) + faceId, otherCellId);
+        faceNeighbors.Set(facesPerCellOffsets.Get(otherCellId) + otherFaceId, cellId);
+      }
+    }
+  };
+
+  // Returns true if a cell with the given ghost flags is to be treated as not in the mesh.
+  VTKM_EXEC static bool IsHiddenCell(vtkm::UInt8 ghostFlags, vtkm::UInt8 hiddenTypes)
+  {
+    return (ghostFlags & hiddenTypes) != 0;
+  }
+
+  // A face of a visible cell is external if there is no cell on the other side or if that
+  // cell is hidden.
+  template <typename GhostPortal>
+  VTKM_EXEC static bool IsMaskedExternalFace(vtkm::Id neighbor,
+                                             const GhostPortal& ghosts,
+                                             vtkm::UInt8 hiddenTypes)
+  {
+    return (neighbor < 0) || IsHiddenCell(ghosts.Get(neighbor), hiddenTypes);
+  }
+
+  // Worklet that counts the external faces of each cell given the face adjacency and the
+  // current ghost flags. Cells without faces (poly data) count as one output cell if passed.
+  class NumMaskedExternalFacesPerCell : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn faceNeighbors,
+                                  FieldIn cellGhostFlags,
+                                  WholeArrayIn ghostFlags,
+                                  FieldOut numExternalFaces);
+    using ExecutionSignature = _4(_1, _2, _3);
+    using InputDomain = _1;
+
+    VTKM_CONT NumMaskedExternalFacesPerCell(vtkm::UInt8 hiddenTypes, bool passPolyData)
+      : HiddenTypes(hiddenTypes)
+      , PassPolyData(passPolyData)
+    {
+    }
+
+    template <typename FaceNeighbors, typename GhostPortal>
+    VTKM_EXEC vtkm::IdComponent operator()(const FaceNeighbors& faceNeighbors,
+                                           vtkm::UInt8 cellGhostFlags,
+                                           const GhostPortal& ghostFlags) const
+    {
+      if (IsHiddenCell(cellGhostFlags, this->HiddenTypes))
+      {
+        return 0;
+      }
+      const vtkm::IdComponent numFaces = faceNeighbors.GetNumberOfComponents();
+      if (numFaces == 0)
+      {
+        return this->PassPolyData ? 1 : 0;
+      }
+      vtkm::IdComponent numExternalFaces = 0;
+      for (vtkm::IdComponent faceIndex = 0; faceIndex < numFaces; ++faceIndex)
+      {
+        if (IsMaskedExternalFace(faceNeighbors[faceIndex], ghostFlags, this->HiddenTypes))
+        {
+          ++numExternalFaces;
+        }
+      }
+      return numExternalFaces;
+    }
+
+  private:
+    vtkm::UInt8 HiddenTypes;
+    bool PassPolyData;
+  };
+
+  // Returns the index of the visitIndex-th external face of a cell.
+  template <typename FaceNeighbors, typename GhostPortal>
+  VTKM_EXEC static vtkm::IdComponent FindMaskedExternalFace(const FaceNeighbors& faceNeighbors,
+                                                            const GhostPortal& ghostFlags,
+                                                            vtkm::UInt8 hiddenTypes,
+                                                            vtkm::IdComponent visitIndex)
+  {
+    const vtkm::IdComponent numFaces = faceNeighbors.GetNumberOfComponents();
+    for (vtkm::IdComponent faceIndex = 0; faceIndex < numFaces; ++faceIndex)
+    {
+      if (IsMaskedExternalFace(faceNeighbors[faceIndex], ghostFlags, hiddenTypes))
+      {
+        if (visitIndex == 0)
+        {
+          return faceIndex;
+        }
+        --visitIndex;
+      }
+    }
+    return -1;
+  }
+
+  // Worklet that returns the number of points of each external face found with the face
+  // adjacency.
+  class NumPointsPerMaskedFace : public vtkm::worklet::WorkletVisitCellsWithPoints
+  {
+  public:
+    using ControlSignature = void(CellSetIn inCellSet,
+                                  FieldInCell faceNeighbors,
+                                  WholeArrayIn ghostFlags,
+                                  FieldOut numPointsInExternalFace);
+    using ExecutionSignature = void(CellShape, PointCount, _2, _3, VisitIndex, _4);
+    using InputDomain = _1;
+
+    using ScatterType = vtkm::worklet::ScatterCounting;
+
+    VTKM_CONT explicit NumPointsPerMaskedFace(vtkm::UInt8 hiddenTypes)
+      : HiddenTypes(hiddenTypes)
+    {
+    }
+
+    template <typename CellShapeTag, typename FaceNeighbors, typename GhostPortal>
+    VTKM_EXEC void operator()(CellShapeTag shape,
+                              vtkm::IdComponent pointCount,
+                              const FaceNeighbors& faceNeighbors,
+                              const GhostPortal& ghostFlags,
+                              vtkm::IdComponent visitIndex,
+                              vtkm::IdComponent& numPointsInExternalFace) const
+    {
+      if (faceNeighbors.GetNumberOfComponents() == 0)
+      {
+        // Poly data cell passed through.
+        numPointsInExternalFace = pointCount;
+        return;
+      }
+      const vtkm::IdComponent faceIndex =
+        FindMaskedExternalFace(faceNeighbors, ghostFlags, this->HiddenTypes, visitIndex);
+      vtkm::exec::CellFaceNumberOfPoints(faceIndex, shape, numPointsInExternalFace);
+    }
+
+  private:
+    vtkm::UInt8 HiddenTypes;
+  };
+
+  // Worklet that returns the shape and connectivity of each external face found with the
+  // face adjacency.
+  class BuildMaskedConnectivity : public vtkm::worklet::WorkletVisitCellsWithPoints
+  {
+  public:
+    using ControlSignature = void(CellSetIn inCellSet,
+                                  FieldInCell faceNeighbors,
+                                  WholeArrayIn ghostFlags,
+                                  FieldOut shapesOut,
+                                  FieldOut connectivityOut,
+                                  FieldOut cellIdMapOut);
+    using ExecutionSignature =
+      void(CellShape, PointIndices, _2, _3, VisitIndex, InputIndex, _4, _5, _6);
+    using InputDomain = _1;
+
+    using ScatterType = vtkm::worklet::ScatterCounting;
+
+    VTKM_CONT explicit BuildMaskedConnectivity(vtkm::UInt8 hiddenTypes)
+      : HiddenTypes(hiddenTypes)
+    {
+    }
+
+    template <typename CellShapeTag,
+              typename CellNodeVecType,
+              typename FaceNeighbors,
+              typename GhostPortal,
+              typename ConnectivityType>
+    VTKM_EXEC void operator()(CellShapeTag shape,
+                              const CellNodeVecType& inCellIndices,
+                              const FaceNeighbors& faceNeighbors,
+                              const GhostPortal& ghostFlags,
+                              vtkm::IdComponent visitIndex,
+                              vtkm::Id inputIndex,
+                              vtkm::UInt8& shapeOut,
+                              ConnectivityType& connectivityOut,
+                              vtkm::Id& cellIdMapOut) const
+    {
+      cellIdMapOut = inputIndex;
+      const vtkm::IdComponent numPointsOut = connectivityOut.GetNumberOfComponents();
+
+      if (faceNeighbors.GetNumberOfComponents() == 0)
+      {
+        // Poly data cell passed through.
+        shapeOut = shape.Id;
+        for (vtkm::IdComponent pointIndex = 0; pointIndex < numPointsOut; ++pointIndex)
+        {
+          connectivityOut[pointIndex] = inCellIndices[pointIndex];
+        }
+        return;
+      }
+
+      const vtkm::IdComponent faceIndex =
+        FindMaskedExternalFace(faceNeighbors, ghostFlags, this->HiddenTypes, visitIndex);
+      vtkm::exec::CellFaceShape(faceIndex, shape, shapeOut);
+      for (vtkm::IdComponent facePointIndex = 0; facePointIndex < numPointsOut; ++facePointIndex)
+      {
+        vtkm::IdComponent localFaceIndex;
+        const vtkm::ErrorCode status =
+          vtkm::exec::CellFaceLocalIndex(facePointIndex, faceIndex, shape, localFaceIndex);
+        if (status == vtkm::ErrorCode::Success)
+        {
+          connectivityOut[facePointIndex] = inCellIndices[localFaceIndex];
+        }
+        else
+        {
+          this->RaiseError(vtkm::ErrorString(status));
+          connectivityOut[facePointIndex] = 0;
+        }
+      }
+    }
+
+  private:
+    vtkm::UInt8 HiddenTypes;
+  };
+
 public:
   VTKM_CONT
   ExternalFaces()
@@ -942,54 +1185,23 @@ public:
       }
     }
 
-    // Create an array to store the hash values of the faces
-    vtkm::cont::ArrayHandle<vtkm::HashType> faceHashes;
-    faceHashes.Allocate(totalNumberOfFaces);
-
-    // Create a group vec array to access the faces of each cell conveniently
-    auto faceHashesGroupVec =
-      vtkm::cont::make_ArrayHandleGroupVecVariable(faceHashes, facesPerCellOffsets);
-
-    // Compute the hash values of the faces
-    invoke(FaceHash(), inCellSet, faceHashesGroupVec);
-
-    // Create an array to store the number of faces per hash
+    // Group the faces by hash, with the external faces of each hash first
     const vtkm::Id numberOfHashes = inCellSet.GetNumberOfPoints();
-    vtkm::cont::ArrayHandle<vtkm::IdComponent> numFacesPerHash;
-    numFacesPerHash.AllocateAndFill(numberOfHashes, 0);
-
-    // Count the number of faces per hash
-    invoke(NumFacesPerHash(), faceHashes, numFacesPerHash);
-
-    // Compute the offsets for a packed array holding face information for each hash.
-    vtkm::cont::ArrayHandle<vtkm::Id> facesPerHashOffsets;
-    vtkm::cont::ConvertNumComponentsToOffsets(numFacesPerHash, facesPerHashOffsets);
-
-    // Create an array to store the cell and face ids of each face per hash
     vtkm::cont::ArrayHandle<CellFaceIdPacker::CellAndFaceIdType> cellAndFaceIdOfFacesPerHash;
-    cellAndFaceIdOfFacesPerHash.Allocate(totalNumberOfFaces);
+    vtkm::cont::ArrayHandle<vtkm::Id> facesPerHashOffsets;
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> numExternalFacesPerHash;
+    GroupFacesByHash(inCellSet,
+                     facesPerCellOffsets,
+                     totalNumberOfFaces,
+                     cellAndFaceIdOfFacesPerHash,
+                     facesPerHashOffsets,
+                     numExternalFacesPerHash);
+    facesPerCellOffsets.ReleaseResources();
 
-    // Create a group vec array to access/write the cell and face ids of each face per hash
+    // Create a group vec array to access the cell and face ids of each face per hash
     auto cellAndFaceIdOfFacesPerHashGroupVec = vtkm::cont::make_ArrayHandleGroupVecVariable(
       cellAndFaceIdOfFacesPerHash, facesPerHashOffsets);
 
-    // Build the cell and face ids of all faces per hash
-    invoke(BuildFacesPerHash(),
-           faceHashesGroupVec,
-           numFacesPerHash,
-           cellAndFaceIdOfFacesPerHashGroupVec);
-    // Release the resources of the arrays that are not needed anymore
-    facesPerCellOffsets.ReleaseResources();
-    faceHashes.ReleaseResources();
-    numFacesPerHash.ReleaseResources();
-
-    // Create an array to count the number of external faces per hash
-    vtkm::cont::ArrayHandle<vtkm::IdComponent> numExternalFacesPerHash;
-    numExternalFacesPerHash.Allocate(numberOfHashes);
-
-    // Compute the number of external faces per hash
-    invoke(FaceCounts(), cellAndFaceIdOfFacesPerHashGroupVec, inCellSet, numExternalFacesPerHash);
-
     // Create a scatter counting object to only access the hashes with external faces
     vtkm::worklet::ScatterCounting scatterCullInternalFaces(numExternalFacesPerHash);
     const vtkm::Id numberOfExternalFaces = scatterCullInternalFaces.GetOutputRange(numberOfHashes);
@@ -1091,11 +1303,217 @@ public:
     }
   }
 
+private:
+  // Groups the faces of all cells by hash (the minimum point id of the face) and finds the
+  // number of external faces of each hash. Within each hash, the external faces are placed
+  // first, followed by the pairs of matching internal faces.
+  template <typename InCellSetType>
+  VTKM_CONT static void GroupFacesByHash(
+    const InCellSetType& inCellSet,
+    const vtkm::cont::ArrayHandle<vtkm::Id>& facesPerCellOffsets,
+    vtkm::Id totalNumberOfFaces,
+    vtkm::cont::ArrayHandle<CellFaceIdPacker::CellAndFaceIdType>& cellAndFaceIdOfFacesPerHash,
+    vtkm::cont::ArrayHandle<vtkm::Id>& facesPerHashOffsets,
+    vtkm::cont::ArrayHandle<vtkm::IdComponent>& numExternalFacesPerHash)
+  {
+    // create an invoker
+    vtkm::cont::Invoker invoke;
+
+    // Create an array to store the hash values of the faces
+    vtkm::cont::ArrayHandle<vtkm::HashType> faceHashes;
+    faceHashes.Allocate(totalNumberOfFaces);
+
+    // Create a group vec array to access the faces of each cell conveniently
+    auto faceHashesGroupVec =
+      vtkm::cont::make_ArrayHandleGroupVecVariable(faceHashes, facesPerCellOffsets);
+
+    // Compute the hash values of the faces
+    invoke(FaceHash(), inCellSet, faceHashesGroupVec);
+
+    // Create an array to store the number of faces per hash
+    const vtkm::Id numberOfHashes = inCellSet.GetNumberOfPoints();
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> numFacesPerHash;
+    numFacesPerHash.AllocateAndFill(numberOfHashes, 0);
+
+    // Count the number of faces per hash
+    invoke(NumFacesPerHash(), faceHashes, numFacesPerHash);
+
+    // Compute the offsets for a packed array holding face information for each hash.
+    vtkm::cont::ConvertNumComponentsToOffsets(numFacesPerHash, facesPerHashOffsets);
+
+    // Create an array to store the cell and face ids of each face per hash
+    cellAndFaceIdOfFacesPerHash.Allocate(totalNumberOfFaces);
+
+    // Create a group vec array to access/write the cell and face ids of each face per hash
+    auto cellAndFaceIdOfFacesPerHashGroupVec = vtkm::cont::make_ArrayHandleGroupVecVariable(
+      cellAndFaceIdOfFacesPerHash, facesPerHashOffsets);
+
+    // Build the cell and face ids of all faces per hash
+    invoke(BuildFacesPerHash(),
+           faceHashesGroupVec,
+           numFacesPerHash,
+           cellAndFaceIdOfFacesPerHashGroupVec);
+    // Release the resources of the arrays that are not needed anymore
+    faceHashes.ReleaseResources();
+    numFacesPerHash.ReleaseResources();
+
+    // Create an array to count the number of external faces per hash
+    numExternalFacesPerHash.Allocate(numberOfHashes);
+
+    // Compute the number of external faces per hash
+    invoke(FaceCounts(), cellAndFaceIdOfFacesPerHashGroupVec, inCellSet, numExternalFacesPerHash);
+  }
+
+public:
+  ///////////////////////////////////////////////////
+  /// \brief Builds the face adjacency of a cell set for use with `RunWithFaceAdjacency`.
+  ///
+  /// The face adjacency records, for each face of each cell, the cell on the other side.
+  /// It depends only on the topology of the cell set, so it can be built once and reused
+  /// while the ghost/blanking flags of the cells change.
+  template <typename InCellSetType>
+  VTKM_CONT void BuildFaceAdjacency(const InCellSetType& inCellSet)
+  {
+    vtkm::cont::Invoker invoke;
+
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> numFacesPerCell;
+    invoke(NumFacesPerCell(), inCellSet, numFacesPerCell);
+    vtkm::Id totalNumberOfFaces;
+    vtkm::cont::ConvertNumComponentsToOffsets(
+      numFacesPerCell, this->FacesPerCellOffsets, totalNumberOfFaces);
+    numFacesPerCell.ReleaseResources();
+
+    this->FaceNeighbors.Allocate(totalNumberOfFaces);
+    if (totalNumberOfFaces == 0)
+    {
+      return;
+    }
+
+    vtkm::cont::ArrayHandle<CellFaceIdPacker::CellAndFaceIdType> cellAndFaceIdOfFacesPerHash;
+    vtkm::cont::ArrayHandle<vtkm::Id> facesPerHashOffsets;
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> numExternalFacesPerHash;
+    GroupFacesByHash(inCellSet,
+                     this->FacesPerCellOffsets,
+                     totalNumberOfFaces,
+                     cellAndFaceIdOfFacesPerHash,
+                     facesPerHashOffsets,
+                     numExternalFacesPerHash);
+
+    invoke(BuildFaceNeighbors(),
+           vtkm::cont::make_ArrayHandleGroupVecVariable(cellAndFaceIdOfFacesPerHash,
+                                                        facesPerHashOffsets),
+           numExternalFacesPerHash,
+           this->FacesPerCellOffsets,
+           this->FaceNeighbors);
+  }
+
+  /// Returns true if `BuildFaceAdjacency` has been called and the adjacency not released.
+  VTKM_CONT bool HasFaceAdjacency() const
+  {
+    return this->FacesPerCellOffsets.GetNumberOfValues() > 0;
+  }
+
+  /// Frees the memory held by the face adjacency.
+  VTKM_CONT void ReleaseFaceAdjacency()
+  {
+    this->FacesPerCellOffsets.ReleaseResources();
+    this->FaceNeighbors.ReleaseResources();
+  }
+
+  /// The arrays of a face adjacency built by `BuildFaceAdjacency`.
+  struct FaceAdjacency
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> FacesPerCellOffsets;
+    vtkm::cont::ArrayHandle<vtkm::Id> FaceNeighbors;
+  };
+
+  /// Returns the face adjacency held by the worklet. The arrays are shared, not copied.
+  VTKM_CONT FaceAdjacency GetFaceAdjacency() const
+  {
+    return { this->FacesPerCellOffsets, this->FaceNeighbors };
+  }
+
+  /// Replaces the face adjacency held by the worklet, for example with one previously
+  /// returned by `GetFaceAdjacency` for the same cell set.
+  VTKM_CONT void SetFaceAdjacency(const FaceAdjacency& adjacency)
+  {
+    this->FacesPerCellOffsets = adjacency.FacesPerCellOffsets;
+    this->FaceNeighbors = adjacency.FaceNeighbors;
+  }
+
+  ///////////////////////////////////////////////////
+  /// \brief ExternalFaces: Extract faces on the outside of the visible cells.
+  ///
+  /// Uses the face adjacency previously computed with `BuildFaceAdjacency` for the same
+  /// cell set. Cells whose ghost flags match any of `hiddenTypes` are treated as if they
+  /// are not in the mesh, so faces they share with visible cells become external. This
+  /// requires only a few passes over the faces of the mesh, so it is much cheaper than
+  /// `Run` when the topology stays the same but the hidden cells change.
+  template <typename InCellSetType,
+            typename GhostStorage,
+            typename ShapeStorage,
+            typename ConnectivityStorage,
+            typename OffsetsStorage>
+  VTKM_CONT void RunWithFaceAdjacency(
+    const InCellSetType& inCellSet,
+    const vtkm::cont::ArrayHandle<vtkm::UInt8, GhostStorage>& ghostFlags,
+    vtkm::UInt8 hiddenTypes,
+    vtkm::cont::CellSetExplicit<ShapeStorage, ConnectivityStorage, OffsetsStorage>& outCellSet)
+  {
+    VTKM_ASSERT(this->HasFaceAdjacency());
+    VTKM_ASSERT(ghostFlags.GetNumberOfValues() == inCellSet.GetNumberOfCells());
+
+    vtkm::cont::Invoker invoke;
+
+    auto faceNeighbors =
+      vtkm::cont::make_ArrayHandleGroupVecVariable(this->FaceNeighbors, this->FacesPerCellOffsets);
+
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> numExternalFacesPerCell;
+    invoke(NumMaskedExternalFacesPerCell(hiddenTypes, this->PassPolyData),
+           faceNeighbors,
+           ghostFlags,
+           ghostFlags,
+           numExternalFacesPerCell);
+
+    vtkm::worklet::ScatterCounting scatterCellToExternalFace(numExternalFacesPerCell);
+    numExternalFacesPerCell.ReleaseResources();
+
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> numPointsPerExternalFace;
+    invoke(NumPointsPerMaskedFace(hiddenTypes),
+           scatterCellToExternalFace,
+           inCellSet,
+           faceNeighbors,
+           ghostFlags,
+           numPointsPerExternalFace);
+
+    vtkm::cont::ArrayHandle<vtkm::Id, OffsetsStorage> offsets;
+    vtkm::Id connectivitySize;
+    vtkm::cont::ConvertNumComponentsToOffsets(
+      numPointsPerExternalFace, offsets, connectivitySize);
+    numPointsPerExternalFace.ReleaseResources();
+
+    vtkm::cont::ArrayHandle<vtkm::UInt8, ShapeStorage> shapes;
+    vtkm::cont::ArrayHandle<vtkm::Id, ConnectivityStorage> connectivity;
+    connectivity.Allocate(connectivitySize);
+    invoke(BuildMaskedConnectivity(hiddenTypes),
+           scatterCellToExternalFace,
+           inCellSet,
+           faceNeighbors,
+           ghostFlags,
+           shapes,
+           vtkm::cont::make_ArrayHandleGroupVecVariable(connectivity, offsets),
+           this->CellIdMap);
+
+    outCellSet.Fill(inCellSet.GetNumberOfPoints(), shapes, connectivity, offsets);
+  }
+
   vtkm::cont::ArrayHandle<vtkm::Id> GetCellIdMap() const { return this->CellIdMap; }
 
 private:
   vtkm::cont::ArrayHandle<vtkm::Id> CellIdMap;
   bool PassPolyData;
+  vtkm::cont::ArrayHandle<vtkm::Id> FacesPerCellOffsets;
+  vtkm::cont::ArrayHandle<vtkm::Id> FaceNeighbors;
 
 }; //struct ExternalFaces
 }
@@ -16,8 +16,11 @@
 
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCast.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
 #include <vtkm/cont/ArrayHandleIndex.h>
 #include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/ArrayHandleView.h>
 #include <vtkm/cont/CellSetPermutation.h>
 #include <vtkm/cont/Field.h>
 #include <vtkm/cont/UncertainCellSet.h>
@@ -25,6 +28,8 @@
 
 #include <vtkm/UnaryPredicates.h>
 
+#include <vector>
+
 namespace vtkm
 {
 namespace worklet
@@ -79,18 +84,26 @@ public:
     bool AllPointsMustPass;
   };
 
-  template <typename CellSetType, typename ValueType, typename StorageType, typename UnaryPredicate>
-  vtkm::cont::CellSetPermutation<CellSetType> RunImpl(
-    const CellSetType& cellSet,
-    const vtkm::cont::ArrayHandle<ValueType, StorageType>& field,
-    vtkm::cont::Field::Association fieldType,
-    const UnaryPredicate& predicate,
-    bool allPointsMustPass,
-    bool invert)
-  {
-    using OutputType = vtkm::cont::CellSetPermutation<CellSetType>;
+  /// \brief Sets the number of cells processed at a time.
+  ///
+  /// By default (a block size of 0), a pass flag is computed for every cell at once. When
+  /// the block size is positive and smaller than the number of cells, the cells are instead
+  /// processed in blocks of this size in two passes. The first pass counts the passing cells
+  /// of each block, which gives the exact size of the output. The second pass writes the ids
+  /// of the passing cells of each block directly into the preallocated output. This bounds
+  /// the temporary memory by the block size rather than by the number of cells.
+  VTKM_CONT void SetBlockSize(vtkm::Id blockSize) { this->BlockSize = blockSize; }
+  VTKM_CONT vtkm::Id GetBlockSize() const { return this->BlockSize; }
 
-    vtkm::cont::ArrayHandle<bool> passFlags;
+  template <typename CellSetType, typename FieldArrayType, typename UnaryPredicate>
+  void ComputePassFlags(const CellSetType& cellSet,
+                        const FieldArrayType& field,
+                        vtkm::cont::Field::Association fieldType,
+                        const UnaryPredicate& predicate,
+                        bool allPointsMustPass,
+                        bool invert,
+                        vtkm::cont::ArrayHandle<bool>& passFlags)
+  {
     switch (fieldType)
     {
       case vtkm::cont::Field::Association::Points:
@@ -117,9 +130,108 @@ public:
       vtkm::cont::Algorithm::Copy(
         vtkm::cont::make_ArrayHandleTransform(passFlags, vtkm::LogicalNot{}), passFlags);
     }
+  }
+
+  // Computes the pass flags for the cells [blockStart, blockStart + blockSize).
+  template <typename CellSetType, typename ValueType, typename StorageType, typename UnaryPredicate>
+  void ComputeBlockPassFlags(const CellSetType& cellSet,
+                             const vtkm::cont::ArrayHandle<ValueType, StorageType>& field,
+                             vtkm::cont::Field::Association fieldType,
+                             const UnaryPredicate& predicate,
+                             bool allPointsMustPass,
+                             bool invert,
+                             vtkm::Id blockStart,
+                             vtkm::Id blockSize,
+                             vtkm::cont::ArrayHandle<bool>& passFlags)
+  {
+    vtkm::cont::ArrayHandleCounting<vtkm::Id> blockCellIds(blockStart, 1, blockSize);
+    auto blockCellSet = vtkm::cont::make_CellSetPermutation(blockCellIds, cellSet);
+    if (fieldType == vtkm::cont::Field::Association::Cells)
+    {
+      this->ComputePassFlags(blockCellSet,
+                             vtkm::cont::make_ArrayHandleView(field, blockStart, blockSize),
+                             fieldType,
+                             predicate,
+                             allPointsMustPass,
+                             invert,
+                             passFlags);
+    }
+    else
+    {
+      this->ComputePassFlags(
+        blockCellSet, field, fieldType, predicate, allPointsMustPass, invert, passFlags);
+    }
+  }
 
-    vtkm::cont::Algorithm::CopyIf(
-      vtkm::cont::ArrayHandleIndex(passFlags.GetNumberOfValues()), passFlags, this->ValidCellIds);
+  template <typename CellSetType, typename ValueType, typename StorageType, typename UnaryPredicate>
+  vtkm::cont::CellSetPermutation<CellSetType> RunImpl(
+    const CellSetType& cellSet,
+    const vtkm::cont::ArrayHandle<ValueType, StorageType>& field,
+    vtkm::cont::Field::Association fieldType,
+    const UnaryPredicate& predicate,
+    bool allPointsMustPass,
+    bool invert)
+  {
+    using OutputType = vtkm::cont::CellSetPermutation<CellSetType>;
+
+    const vtkm::Id numberOfCells = cellSet.GetNumberOfCells();
+    vtkm::cont::ArrayHandle<bool> passFlags;
+    if ((this->BlockSize <= 0) || (numberOfCells <= this->BlockSize))
+    {
+      this->ComputePassFlags(
+        cellSet, field, fieldType, predicate, allPointsMustPass, invert, passFlags);
+      vtkm::cont::Algorithm::CopyIf(
+        vtkm::cont::ArrayHandleIndex(passFlags.GetNumberOfValues()), passFlags, this->ValidCellIds);
+      return OutputType(this->ValidCellIds, cellSet);
+    }
+
+    // First pass: count the passing cells in each block to size the output.
+    std::vector<vtkm::Id> blockOffsets;
+    vtkm::Id numberOfValidCells = 0;
+    for (vtkm::Id blockStart = 0; blockStart < numberOfCells; blockStart += this->BlockSize)
+    {
+      vtkm::Id blockSize = vtkm::Min(this->BlockSize, numberOfCells - blockStart);
+      this->ComputeBlockPassFlags(cellSet,
+                                  field,
+                                  fieldType,
+                                  predicate,
+                                  allPointsMustPass,
+                                  invert,
+                                  blockStart,
+                                  blockSize,
+                                  passFlags);
+      blockOffsets.push_back(numberOfValidCells);
+      numberOfValidCells += vtkm::cont::Algorithm::Reduce(
+        vtkm::cont::make_ArrayHandleCast<vtkm::Id>(passFlags), vtkm::Id{ 0 });
+    }
+
+    // Second pass: write the ids of the passing cells of each block into the output.
+    this->ValidCellIds.Allocate(numberOfValidCells);
+    vtkm::cont::ArrayHandle<vtkm::Id> blockValidCellIds;
+    std::size_t blockIndex = 0;
+    for (vtkm::Id blockStart = 0; blockStart < numberOfCells;
+         blockStart += this->BlockSize, ++blockIndex)
+    {
+      vtkm::Id blockSize = vtkm::Min(this->BlockSize, numberOfCells - blockStart);
+      this->ComputeBlockPassFlags(cellSet,
+                                  field,
+                                  fieldType,
+                                  predicate,
+                                  allPointsMustPass,
+                                  invert,
+                                  blockStart,
+                                  blockSize,
+                                  passFlags);
+      vtkm::cont::Algorithm::CopyIf(
+        vtkm::cont::ArrayHandleCounting<vtkm::Id>(blockStart, 1, blockSize),
+        passFlags,
+        blockValidCellIds);
+      vtkm::cont::Algorithm::CopySubRange(blockValidCellIds,
+                                          0,
+                                          blockValidCellIds.GetNumberOfValues(),
+                                          this->ValidCellIds,
+                                          blockOffsets[blockIndex]);
+    }
 
     return OutputType(this->ValidCellIds, cellSet);
   }
@@ -145,6 +257,7 @@ public:
 
 private:
   vtkm::cont::ArrayHandle<vtkm::Id> ValidCellIds;
+  vtkm::Id BlockSize = 0;
 };
 }
 } // namespace vtkm::worklet
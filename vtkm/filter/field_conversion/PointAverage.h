@@ -36,6 +36,7 @@ class VTKM_FILTER_FIELD_CONVERSION_EXPORT PointAverage : public vtkm::filter::Fi
 {
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
+  VTKM_CONT bool CanFusePartitions() const override { return true; }
 };
 } // namespace field_conversion
 } // namespace filter
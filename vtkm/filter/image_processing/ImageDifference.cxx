@@ -17,6 +17,7 @@
 #include <vtkm/filter/image_processing/ImageDifference.h>
 #include <vtkm/filter/image_processing/worklet/ImageDifference.h>
 #include <vtkm/worklet/AveragePointNeighborhood.h>
+#include <vtkm/worklet/TiledPointNeighborhood.h>
 
 namespace vtkm
 {
@@ -76,8 +77,27 @@ VTKM_CONT vtkm::cont::DataSet ImageDifference::DoExecute(const vtkm::cont::DataS
       VTKM_LOG_S(vtkm::cont::LogLevel::Info,
                  "Performing Average with radius: " << this->AverageRadius);
       auto averageWorklet = vtkm::worklet::AveragePointNeighborhood(this->AverageRadius);
-      this->Invoke(averageWorklet, inputCellSet, primaryArray, primaryOutput);
-      this->Invoke(averageWorklet, inputCellSet, secondaryArray, secondaryOutput);
+      using TiledAverage = vtkm::worklet::TiledPointNeighborhood<decltype(averageWorklet)>;
+      if (this->UseTiledNeighborhood && this->AverageRadius <= TiledAverage::MaxRadius)
+      {
+        vtkm::worklet::InvokeTiledPointNeighborhood(this->Invoke,
+                                                    averageWorklet,
+                                                    this->AverageRadius,
+                                                    inputCellSet,
+                                                    primaryArray,
+                                                    primaryOutput);
+        vtkm::worklet::InvokeTiledPointNeighborhood(this->Invoke,
+                                                    averageWorklet,
+                                                    this->AverageRadius,
+                                                    inputCellSet,
+                                                    secondaryArray,
+                                                    secondaryOutput);
+      }
+      else
+      {
+        this->Invoke(averageWorklet, inputCellSet, primaryArray, primaryOutput);
+        this->Invoke(averageWorklet, inputCellSet, secondaryArray, secondaryOutput);
+      }
     }
     else
     {
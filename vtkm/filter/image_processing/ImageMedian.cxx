@@ -8,81 +8,13 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/filter/image_processing/ImageMedian.h>
-#include <vtkm/worklet/WorkletPointNeighborhood.h>
-
-// NOTE BIEN!!! This line has to come last!!! Otherwise CUDA complains!!! NEIB ETON
-#include <vtkm/Swap.h>
+#include <vtkm/filter/image_processing/worklet/ImageMedian.h>
 
 namespace vtkm
 {
-namespace worklet
-{
-// An implementation of the quickselect/Hoare's selection algorithm to find medians
-// inplace, generally fairly fast for reasonable sized data.
-//
-template <typename T>
-VTKM_EXEC inline T find_median(T* values, std::size_t mid, std::size_t size)
-{
-  std::size_t begin = 0;
-  std::size_t end = size - 1;
-  while (begin < end)
-  {
-    T x = values[mid];
-    std::size_t i = begin;
-    std::size_t j = end;
-    do
-    {
-      for (; values[i] < x; i++)
-      {
-      }
-      for (; x < values[j]; j--)
-      {
-      }
-      if (i <= j)
-      {
-        vtkm::Swap(values[i], values[j]);
-        i++;
-        j--;
-      }
-    } while (i <= j);
-
-    begin = (j < mid) ? i : begin;
-    end = (mid < i) ? j : end;
-  }
-  return values[mid];
-}
-struct ImageMedian : public vtkm::worklet::WorkletPointNeighborhood
-{
-  int Neighborhood;
-  ImageMedian(int neighborhoodSize)
-    : Neighborhood(neighborhoodSize)
-  {
-  }
-  using ControlSignature = void(CellSetIn, FieldInNeighborhood, FieldOut);
-  using ExecutionSignature = void(_2, _3);
-
-  template <typename InNeighborhoodT, typename T>
-  VTKM_EXEC void operator()(const InNeighborhoodT& input, T& out) const
-  {
-    vtkm::Vec<T, 25> values;
-    int index = 0;
-    for (int x = -this->Neighborhood; x <= this->Neighborhood; ++x)
-    {
-      for (int y = -this->Neighborhood; y <= this->Neighborhood; ++y)
-      {
-        values[index++] = input.Get(x, y, 0);
-      }
-    }
-
-    std::size_t len =
-      static_cast<std::size_t>((this->Neighborhood * 2 + 1) * (this->Neighborhood * 2 + 1));
-    std::size_t mid = len / 2;
-    out = find_median(&values[0], mid, len);
-  }
-};
-}
-
 namespace filter
 {
 namespace image_processing
@@ -94,21 +26,91 @@ VTKM_CONT vtkm::cont::DataSet ImageMedian::DoExecute(const vtkm::cont::DataSet&
   {
     throw vtkm::cont::ErrorBadValue("Active field for ImageMedian must be a point field.");
   }
+  const vtkm::IdComponent maxRadius = vtkm::worklet::ImageRankCapacity::MaxRadius;
+  if (this->NeighborhoodRadius < 0 || this->NeighborhoodRadius > maxRadius)
+  {
+    throw vtkm::cont::ErrorBadValue("ImageMedian neighborhood radius must be between 0 and " +
+                                    std::to_string(maxRadius) + ".");
+  }
+  if (!(this->Percentile >= 0 && this->Percentile <= 1))
+  {
+    throw vtkm::cont::ErrorBadValue("ImageMedian percentile must be between 0 and 1.");
+  }
 
   const vtkm::cont::UnknownCellSet& inputCellSet = input.GetCellSet();
-  vtkm::cont::UnknownArrayHandle outArray;
+  vtkm::Id3 pointDimensions;
+  if (inputCellSet.IsType<vtkm::cont::CellSetStructured<3>>())
+  {
+    pointDimensions =
+      inputCellSet.AsCellSet<vtkm::cont::CellSetStructured<3>>().GetPointDimensions();
+  }
+  else if (inputCellSet.IsType<vtkm::cont::CellSetStructured<2>>())
+  {
+    vtkm::Id2 dims =
+      inputCellSet.AsCellSet<vtkm::cont::CellSetStructured<2>>().GetPointDimensions();
+    pointDimensions = vtkm::Id3(dims[0], dims[1], 1);
+  }
+  else if (inputCellSet.IsType<vtkm::cont::CellSetStructured<1>>())
+  {
+    vtkm::Id dims =
+      inputCellSet.AsCellSet<vtkm::cont::CellSetStructured<1>>().GetPointDimensions();
+    pointDimensions = vtkm::Id3(dims, 1, 1);
+  }
+  else
+  {
+    throw vtkm::cont::ErrorBadType("ImageMedian requires a structured cell set.");
+  }
+
+  // Axes with a single point contribute nothing but copies of the same values.
+  const vtkm::IdComponent radius = this->NeighborhoodRadius;
+  const vtkm::IdComponent3 radii(pointDimensions[0] > 1 ? radius : 0,
+                                 pointDimensions[1] > 1 ? radius : 0,
+                                 (this->Use3DNeighborhood && pointDimensions[2] > 1) ? radius : 0);
+  const vtkm::Id numberOfPoints = pointDimensions[0] * pointDimensions[1] * pointDimensions[2];
+  const vtkm::cont::ArrayHandleIndex rows(pointDimensions[1] * pointDimensions[2]);
+
+  const vtkm::IdComponent neighborhoodSize =
+    (2 * radii[0] + 1) * (2 * radii[1] + 1) * (2 * radii[2] + 1);
 
+  vtkm::cont::UnknownArrayHandle outArray;
   auto resolveType = [&](const auto& concrete) {
     // use std::decay to remove const ref from the decltype of concrete.
     using T = typename std::decay_t<decltype(concrete)>::ValueType;
     vtkm::cont::ArrayHandle<T> result;
+    result.Allocate(numberOfPoints);
 
-    VTKM_ASSERT((this->Neighborhood == 1) || (this->Neighborhood == 2));
-    this->Invoke(worklet::ImageMedian{ this->Neighborhood }, inputCellSet, concrete, result);
+    using Capacity = vtkm::worklet::ImageRankCapacity;
+    auto invoke = [&](auto worklet) { this->Invoke(worklet, rows, concrete, result); };
+    // The sorted path keeps the neighborhood on the stack, so it is compiled for a few sizes
+    // and the smallest that fits is picked.
+    if (neighborhoodSize <= Capacity::Small)
+    {
+      invoke(vtkm::worklet::ImageRank<Capacity::Small>{ pointDimensions, radii, this->Percentile });
+    }
+    else if (neighborhoodSize <= Capacity::Medium)
+    {
+      invoke(
+        vtkm::worklet::ImageRank<Capacity::Medium>{ pointDimensions, radii, this->Percentile });
+    }
+    else
+    {
+      invoke(vtkm::worklet::ImageRank<Capacity::Large>{ pointDimensions, radii, this->Percentile });
+    }
 
     outArray = result;
   };
-  this->CastAndCallScalarField(field, resolveType);
+  // 8-bit fields are not part of the scalar field types, but they are common for images and
+  // take the histogram path of the worklet.
+  const vtkm::cont::UnknownArrayHandle& fieldArray = field.GetData();
+  if (fieldArray.IsValueType<vtkm::UInt8>() || fieldArray.IsValueType<vtkm::Int8>())
+  {
+    fieldArray.CastAndCallForTypes<vtkm::List<vtkm::UInt8, vtkm::Int8>, VTKM_DEFAULT_STORAGE_LIST>(
+      resolveType);
+  }
+  else
+  {
+    this->CastAndCallScalarField(field, resolveType);
+  }
 
   std::string name = this->GetOutputFieldName();
   if (name.empty())
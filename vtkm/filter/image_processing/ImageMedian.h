@@ -17,11 +17,17 @@
 /// \brief Median algorithm for general image blur
 ///
 /// The ImageMedian filter finds the median value for each pixel in an image.
-/// Currently the algorithm has the following restrictions.
-///   - Only supports a neighborhood of 5x5x1 or 3x3x1
+/// More generally, it can select any percentile of the values in the
+/// neighborhood of each point, which makes it a rank filter.
 ///
-/// This means that volumes are basically treated as an image stack
-/// along the z axis
+/// The neighborhood is a box with a radius of up to 7 points. By default it
+/// spans the x and y axes only, which means that volumes are basically treated
+/// as an image stack along the z axis. `SetUse3DNeighborhood()` extends it
+/// along the z axis. Points beyond the boundary are clamped to the boundary.
+///
+/// 8-bit integer fields are filtered with a sliding histogram, so the cost per
+/// point barely depends on the radius. Other fields keep the neighborhood sorted
+/// as it slides along each row. NaN values rank above all other values.
 ///
 /// Default output field name is 'median'
 namespace vtkm
@@ -35,13 +41,49 @@ class VTKM_FILTER_IMAGE_PROCESSING_EXPORT ImageMedian : public vtkm::filter::Fil
 public:
   VTKM_CONT ImageMedian() { this->SetOutputFieldName("median"); }
 
-  VTKM_CONT void Perform3x3() { this->Neighborhood = 1; };
-  VTKM_CONT void Perform5x5() { this->Neighborhood = 2; };
+  VTKM_CONT void Perform3x3()
+  {
+    this->NeighborhoodRadius = 1;
+    this->Use3DNeighborhood = false;
+  };
+  VTKM_CONT void Perform5x5()
+  {
+    this->NeighborhoodRadius = 2;
+    this->Use3DNeighborhood = false;
+  };
+
+  /// @brief Specifies the radius of the neighborhood.
+  ///
+  /// A radius of 1 selects from 3x3 points, 2 from 5x5 points, and so on. The radius
+  /// must be between 0 and 7. The default is 1.
+  VTKM_CONT void SetNeighborhoodRadius(vtkm::IdComponent radius)
+  {
+    this->NeighborhoodRadius = radius;
+  }
+  /// @copydoc SetNeighborhoodRadius
+  VTKM_CONT vtkm::IdComponent GetNeighborhoodRadius() const { return this->NeighborhoodRadius; }
+
+  /// @brief Specifies whether the neighborhood also spans the z axis.
+  ///
+  /// When off (the default), each z slice is filtered as a separate image.
+  VTKM_CONT void SetUse3DNeighborhood(bool use3D) { this->Use3DNeighborhood = use3D; }
+  /// @copydoc SetUse3DNeighborhood
+  VTKM_CONT bool GetUse3DNeighborhood() const { return this->Use3DNeighborhood; }
+
+  /// @brief Specifies which value of the sorted neighborhood is selected.
+  ///
+  /// The percentile is between 0 and 1. 0 selects the minimum, 1 the maximum, and the
+  /// default of 0.5 the median.
+  VTKM_CONT void SetPercentile(vtkm::Float64 percentile) { this->Percentile = percentile; }
+  /// @copydoc SetPercentile
+  VTKM_CONT vtkm::Float64 GetPercentile() const { return this->Percentile; }
 
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
-  int Neighborhood = 1;
+  vtkm::IdComponent NeighborhoodRadius = 1;
+  bool Use3DNeighborhood = false;
+  vtkm::Float64 Percentile = 0.5;
 };
 } // namespace image_processing
 } // namespace filter
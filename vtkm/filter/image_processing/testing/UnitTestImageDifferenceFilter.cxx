@@ -119,8 +119,9 @@ void TestImageDifference()
       expectedDiff, expectedThreshold, result, filter.GetImageDiffWithinThreshold(), true);
   }
 
+  for (bool tiled : { false, true })
   {
-    VTKM_LOG_S(vtkm::cont::LogLevel::Info, "Matching Images with Average");
+    VTKM_LOG_S(vtkm::cont::LogLevel::Info, "Matching Images with Average, tiled: " << tiled);
     auto dataSet = FillDataSet(static_cast<vtkm::FloatDefault>(1));
     vtkm::filter::image_processing::ImageDifference filter;
     filter.SetPrimaryField("primary");
@@ -128,6 +129,7 @@ void TestImageDifference()
     filter.SetPixelDiffThreshold(0.05f);
     filter.SetPixelShiftRadius(1);
     filter.SetAverageRadius(1);
+    filter.SetUseTiledNeighborhood(tiled);
     vtkm::cont::DataSet result = filter.Execute(dataSet);
 
     std::vector<vtkm::Vec4f> expectedDiff = {
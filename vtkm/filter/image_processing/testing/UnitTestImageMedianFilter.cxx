@@ -8,9 +8,16 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/cont/Invoker.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/filter/image_processing/ImageMedian.h>
+#include <vtkm/filter/image_processing/worklet/ImageMedian.h>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
 
 namespace
 {
@@ -44,9 +51,153 @@ void TestImageMedian()
     VTKM_TEST_ASSERT(test_equal(expected_median, 2.82843), "incorrect median value");
   }
 }
+
+template <typename T>
+vtkm::cont::DataSet MakeNoisyDataSet(const vtkm::Id3& dims, bool withNan = false)
+{
+  vtkm::cont::DataSet dataSet = vtkm::cont::DataSetBuilderUniform::Create(dims);
+  std::vector<T> values(static_cast<std::size_t>(dims[0] * dims[1] * dims[2]));
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    // Few distinct values, so that the neighborhoods contain duplicates.
+    values[i] = static_cast<T>((i * 7919 + (i * i) % 31) % 97);
+    if (withNan && (i % 5 == 3))
+    {
+      values[i] = std::numeric_limits<T>::quiet_NaN();
+    }
+  }
+  dataSet.AddPointField("noise", values);
+  return dataSet;
+}
+
+template <typename T>
+std::vector<T> ComputeRank(const vtkm::cont::ArrayHandle<T>& field,
+                           const vtkm::Id3& dims,
+                           vtkm::IdComponent radius,
+                           bool use3D,
+                           vtkm::Float64 percentile)
+{
+  auto portal = field.ReadPortal();
+  auto clamp = [](vtkm::Id i, vtkm::Id size) {
+    return std::max(vtkm::Id{ 0 }, std::min(size - 1, i));
+  };
+  const vtkm::IdComponent radiusZ = use3D ? radius : 0;
+  std::vector<T> result;
+  for (vtkm::Id z = 0; z < dims[2]; ++z)
+  {
+    for (vtkm::Id y = 0; y < dims[1]; ++y)
+    {
+      for (vtkm::Id x = 0; x < dims[0]; ++x)
+      {
+        std::vector<T> neighborhood;
+        for (vtkm::Id k = z - radiusZ; k <= z + radiusZ; ++k)
+        {
+          for (vtkm::Id j = y - radius; j <= y + radius; ++j)
+          {
+            for (vtkm::Id i = x - radius; i <= x + radius; ++i)
+            {
+              neighborhood.push_back(portal.Get(
+                clamp(i, dims[0]) + dims[0] * (clamp(j, dims[1]) + dims[1] * clamp(k, dims[2]))));
+            }
+          }
+        }
+        std::size_t rank = static_cast<std::size_t>(
+          vtkm::Round(percentile * static_cast<vtkm::Float64>(neighborhood.size() - 1)));
+        std::nth_element(neighborhood.begin(),
+                         neighborhood.begin() + rank,
+                         neighborhood.end(),
+                         [](const T& value1, const T& value2) {
+                           return vtkm::worklet::rank_less(value1, value2);
+                         });
+        result.push_back(neighborhood[rank]);
+      }
+    }
+  }
+  return result;
+}
+
+void TestMatchesNeighborhoodWorklet()
+{
+  std::cout << "Testing Image Median Filter against the neighborhood worklet" << std::endl;
+
+  vtkm::cont::DataSet dataSet = MakeNoisyDataSet<vtkm::Float32>(vtkm::Id3(17, 13, 4));
+  vtkm::cont::ArrayHandle<vtkm::Float32> noise;
+  dataSet.GetPointField("noise").GetData().AsArrayHandle(noise);
+
+  for (int neighborhood = 1; neighborhood <= 2; ++neighborhood)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Float32> expected;
+    vtkm::cont::Invoker invoke;
+    invoke(vtkm::worklet::ImageMedian{ neighborhood }, dataSet.GetCellSet(), noise, expected);
+
+    vtkm::filter::image_processing::ImageMedian median;
+    median.SetNeighborhoodRadius(neighborhood);
+    median.SetActiveField("noise");
+    auto result = median.Execute(dataSet);
+
+    vtkm::cont::ArrayHandle<vtkm::Float32> resultArray;
+    result.GetPointField("median").GetData().AsArrayHandle(resultArray);
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(resultArray, expected), "Wrong median");
+  }
+}
+
+template <typename T>
+void TestRank(const vtkm::Id3& dims,
+              vtkm::IdComponent radius,
+              bool use3D,
+              vtkm::Float64 percentile,
+              bool withNan = false)
+{
+  std::cout << "Testing Image Median Filter with " << vtkm::cont::TypeToString<T>()
+            << ", radius " << radius << (use3D ? " in 3D" : " in 2D") << ", percentile "
+            << percentile << (withNan ? " with NaN" : "") << std::endl;
+
+  vtkm::cont::DataSet dataSet = MakeNoisyDataSet<T>(dims, withNan);
+  vtkm::cont::ArrayHandle<T> noise;
+  dataSet.GetPointField("noise").GetData().AsArrayHandle(noise);
+
+  vtkm::filter::image_processing::ImageMedian median;
+  median.SetNeighborhoodRadius(radius);
+  median.SetUse3DNeighborhood(use3D);
+  median.SetPercentile(percentile);
+  median.SetActiveField("noise");
+  auto result = median.Execute(dataSet);
+
+  vtkm::cont::ArrayHandle<T> resultArray;
+  result.GetPointField("median").GetData().AsArrayHandle(resultArray);
+  std::vector<T> expected = ComputeRank(noise, dims, radius, use3D, percentile);
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+                     resultArray, vtkm::cont::make_ArrayHandle(expected, vtkm::CopyFlag::Off)),
+                   "Wrong rank");
+}
+
+void TestImageRank()
+{
+  TestMatchesNeighborhoodWorklet();
+
+  TestRank<vtkm::Float32>(vtkm::Id3(11, 9, 7), 2, true, 0.5);
+  TestRank<vtkm::Float64>(vtkm::Id3(11, 9, 7), 3, true, 0.25);
+  TestRank<vtkm::Float32>(vtkm::Id3(20, 18, 3), 7, false, 0.9);
+  TestRank<vtkm::UInt8>(vtkm::Id3(11, 9, 7), 2, true, 0.5);
+  TestRank<vtkm::Int8>(vtkm::Id3(11, 9, 7), 1, true, 0.0);
+  // A radius larger than the data clamps most of the neighborhood to the boundary.
+  TestRank<vtkm::UInt8>(vtkm::Id3(6, 5, 4), 7, true, 1.0);
+  TestRank<vtkm::Float32>(vtkm::Id3(6, 5, 4), 7, true, 0.5);
+  // NaN ranks above all other values and must leave the sorted neighborhood again.
+  TestRank<vtkm::Float32>(vtkm::Id3(9, 7, 3), 1, false, 0.5, true);
+  TestRank<vtkm::Float64>(vtkm::Id3(11, 9, 7), 2, true, 0.5, true);
+  TestRank<vtkm::Float32>(vtkm::Id3(11, 9, 7), 3, true, 0.8, true);
+  TestRank<vtkm::Float32>(vtkm::Id3(17, 5, 4), 7, true, 0.5, true);
+}
+
+void TestImageMedianFilter()
+{
+  TestImageMedian();
+  TestImageRank();
+}
 }
 
 int UnitTestImageMedianFilter(int argc, char* argv[])
 {
-  return vtkm::cont::testing::Testing::Run(TestImageMedian, argc, argv);
+  return vtkm::cont::testing::Testing::Run(TestImageMedianFilter, argc, argv);
 }
@@ -0,0 +1,422 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_ImageMedian_h
+#define vtk_m_worklet_ImageMedian_h
+
+#include <vtkm/Assert.h>
+#include <vtkm/Math.h>
+#include <vtkm/Types.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+#include <vtkm/worklet/WorkletPointNeighborhood.h>
+
+#include <type_traits>
+
+// NOTE BIEN!!! This line has to come last!!! Otherwise CUDA complains!!! NEIB ETON
+#include <vtkm/Swap.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+// NaN compares false against every value, so it has no place in a sorted neighborhood, and
+// a NaN leaving the neighborhood would never be found again. It is ordered after all other
+// values instead, which makes the order strict weak for any input. NaN is tested first
+// because comparing it raises a floating point exception where those are enabled.
+template <typename T>
+VTKM_EXEC inline bool rank_less(const T& value1, const T& value2, std::true_type)
+{
+  if (vtkm::IsNan(value1))
+  {
+    return false;
+  }
+  return vtkm::IsNan(value2) || (value1 < value2);
+}
+
+template <typename T>
+VTKM_EXEC inline bool rank_less(const T& value1, const T& value2, std::false_type)
+{
+  return value1 < value2;
+}
+
+template <typename T>
+VTKM_EXEC inline bool rank_less(const T& value1, const T& value2)
+{
+  return rank_less(value1, value2, typename std::is_floating_point<T>::type{});
+}
+
+// An implementation of the quickselect/Hoare's selection algorithm to find medians
+// inplace, generally fairly fast for reasonable sized data.
+//
+template <typename T>
+VTKM_EXEC inline T find_median(T* values, std::size_t mid, std::size_t size)
+{
+  std::size_t begin = 0;
+  std::size_t end = size - 1;
+  while (begin < end)
+  {
+    T x = values[mid];
+    std::size_t i = begin;
+    std::size_t j = end;
+    do
+    {
+      for (; rank_less(values[i], x); i++)
+      {
+      }
+      for (; rank_less(x, values[j]); j--)
+      {
+      }
+      if (i <= j)
+      {
+        vtkm::Swap(values[i], values[j]);
+        i++;
+        j--;
+      }
+    } while (i <= j);
+
+    begin = (j < mid) ? i : begin;
+    end = (mid < i) ? j : end;
+  }
+  return values[mid];
+}
+
+// Median of a 3x3x1 or 5x5x1 neighborhood gathered point by point.
+struct ImageMedian : public vtkm::worklet::WorkletPointNeighborhood
+{
+  int Neighborhood;
+  ImageMedian(int neighborhoodSize)
+    : Neighborhood(neighborhoodSize)
+  {
+  }
+  using ControlSignature = void(CellSetIn, FieldInNeighborhood, FieldOut);
+  using ExecutionSignature = void(_2, _3);
+
+  template <typename InNeighborhoodT, typename T>
+  VTKM_EXEC void operator()(const InNeighborhoodT& input, T& out) const
+  {
+    vtkm::Vec<T, 25> values;
+    int index = 0;
+    for (int x = -this->Neighborhood; x <= this->Neighborhood; ++x)
+    {
+      for (int y = -this->Neighborhood; y <= this->Neighborhood; ++y)
+      {
+        values[index++] = input.Get(x, y, 0);
+      }
+    }
+
+    std::size_t len =
+      static_cast<std::size_t>((this->Neighborhood * 2 + 1) * (this->Neighborhood * 2 + 1));
+    std::size_t mid = len / 2;
+    out = find_median(&values[0], mid, len);
+  }
+};
+
+// Shell sort with the gaps of Ciura, which needs no extra memory and is fast for the few
+// hundred to few thousand values of a neighborhood.
+template <typename T>
+VTKM_EXEC inline void sort_neighborhood(T* values, vtkm::IdComponent size)
+{
+  constexpr vtkm::IdComponent gaps[] = { 1750, 701, 301, 132, 57, 23, 10, 4, 1 };
+  for (vtkm::IdComponent gap : gaps)
+  {
+    for (vtkm::IdComponent i = gap; i < size; ++i)
+    {
+      const T value = values[i];
+      vtkm::IdComponent j = i;
+      for (; j >= gap && rank_less(value, values[j - gap]); j -= gap)
+      {
+        values[j] = values[j - gap];
+      }
+      values[j] = value;
+    }
+  }
+}
+
+/// Bounds of the neighborhood of `ImageRank`.
+struct ImageRankCapacity
+{
+  static constexpr vtkm::IdComponent MaxRadius = 7;
+  static constexpr vtkm::IdComponent MaxSlabSize = (2 * MaxRadius + 1) * (2 * MaxRadius + 1);
+  static constexpr vtkm::IdComponent MaxNeighborhoodSize = (2 * MaxRadius + 1) * MaxSlabSize;
+
+  /// Fits any 2D neighborhood and 3D neighborhoods up to radius 2.
+  static constexpr vtkm::IdComponent Small = MaxSlabSize;
+  /// Fits 3D neighborhoods up to radius 4.
+  static constexpr vtkm::IdComponent Medium = 9 * 9 * 9;
+  /// Fits every neighborhood.
+  static constexpr vtkm::IdComponent Large = MaxNeighborhoodSize;
+};
+
+/// Computes a rank (percentile) filter over a box neighborhood of a structured point field.
+///
+/// Each invocation filters one row of points along the x axis and slides the neighborhood
+/// along it. Moving to the next point only removes the slab of values that leaves the
+/// neighborhood and adds the slab that enters it. 8-bit values are counted in a two level
+/// histogram (Huang's algorithm with the coarse bins of Perreault and Hebert), so finding the
+/// rank costs at most 32 steps. Other values are kept sorted, and each step sorts the two
+/// slabs and merges them with the sorted neighborhood. Neighborhoods of at most 32 values are
+/// instead kept in a ring of slabs and the rank is selected with quickselect.
+///
+/// Points beyond the boundary are clamped to the nearest point on the boundary, like
+/// `FieldInNeighborhood` does. NaN values rank above all other values. The output array must
+/// be allocated to the number of points.
+///
+/// The sorted path keeps two copies of the neighborhood on the stack. `NeighborhoodCapacity`
+/// bounds the size of the neighborhood and thereby that stack use, so callers should pick the
+/// smallest of the `ImageRankCapacity` sizes that fits.
+template <vtkm::IdComponent NeighborhoodCapacity = ImageRankCapacity::Large>
+class ImageRank : public vtkm::worklet::WorkletMapField
+{
+public:
+  static constexpr vtkm::IdComponent MaxRadius = ImageRankCapacity::MaxRadius;
+  static constexpr vtkm::IdComponent MaxSlabSize = ImageRankCapacity::MaxSlabSize;
+  static constexpr vtkm::IdComponent MaxNeighborhoodSize = NeighborhoodCapacity;
+  static constexpr vtkm::IdComponent MaxSelectNeighborhoodSize = 32;
+
+  using ControlSignature = void(FieldIn rowIndex, WholeArrayIn input, WholeArrayOut output);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  /// `radius` is the radius of the neighborhood along each axis, and `percentile` is the
+  /// rank of the result in [0, 1]. A percentile of 0.5 is the median.
+  VTKM_CONT ImageRank(const vtkm::Id3& pointDimensions,
+                      const vtkm::IdComponent3& radius,
+                      vtkm::Float64 percentile)
+    : PointDimensions(pointDimensions)
+    , Radius(radius)
+  {
+    this->SlabSize = (2 * radius[1] + 1) * (2 * radius[2] + 1);
+    this->NeighborhoodSize = (2 * radius[0] + 1) * this->SlabSize;
+    const vtkm::IdComponent size = this->NeighborhoodSize;
+    const vtkm::Float64 rank = vtkm::Round(percentile * static_cast<vtkm::Float64>(size - 1));
+    this->Rank = vtkm::Max(0, vtkm::Min(size - 1, static_cast<vtkm::IdComponent>(rank)));
+    VTKM_ASSERT(size <= MaxNeighborhoodSize);
+  }
+
+  template <typename InPortalType, typename OutPortalType>
+  VTKM_EXEC void operator()(vtkm::Id row, const InPortalType& input, OutPortalType& output) const
+  {
+    using T = typename InPortalType::ValueType;
+    using UseHistogram = std::integral_constant<bool,
+                                                std::is_same<T, vtkm::UInt8>::value ||
+                                                  std::is_same<T, vtkm::Int8>::value>;
+    const vtkm::Id y = row % this->PointDimensions[1];
+    const vtkm::Id z = row / this->PointDimensions[1];
+    this->FilterRow(y, z, input, output, UseHistogram{});
+  }
+
+private:
+  VTKM_EXEC vtkm::Id ClampX(vtkm::Id x) const
+  {
+    return vtkm::Max(vtkm::Id{ 0 }, vtkm::Min(this->PointDimensions[0] - 1, x));
+  }
+
+  // Copies the values of the slab at x of the neighborhood of row (y, z) to slab.
+  template <typename InPortalType, typename T>
+  VTKM_EXEC void GatherSlab(const InPortalType& input,
+                            vtkm::Id x,
+                            vtkm::Id y,
+                            vtkm::Id z,
+                            T* slab) const
+  {
+    vtkm::IdComponent index = 0;
+    for (vtkm::IdComponent k = -this->Radius[2]; k <= this->Radius[2]; ++k)
+    {
+      const vtkm::Id zk =
+        vtkm::Max(vtkm::Id{ 0 }, vtkm::Min(this->PointDimensions[2] - 1, z + k));
+      for (vtkm::IdComponent j = -this->Radius[1]; j <= this->Radius[1]; ++j)
+      {
+        const vtkm::Id yj =
+          vtkm::Max(vtkm::Id{ 0 }, vtkm::Min(this->PointDimensions[1] - 1, y + j));
+        slab[index++] =
+          input.Get(x + this->PointDimensions[0] * (yj + this->PointDimensions[1] * zk));
+      }
+    }
+  }
+
+  template <typename InPortalType, typename OutPortalType>
+  VTKM_EXEC void SelectRow(vtkm::Id y,
+                           vtkm::Id z,
+                           const InPortalType& input,
+                           OutPortalType& output) const
+  {
+    using T = typename InPortalType::ValueType;
+    vtkm::Vec<T, MaxSelectNeighborhoodSize> ring;
+    vtkm::Vec<T, MaxSelectNeighborhoodSize> values;
+
+    const vtkm::Id rowStart = this->PointDimensions[0] * (y + this->PointDimensions[1] * z);
+    const vtkm::IdComponent numSlabs = 2 * this->Radius[0] + 1;
+    for (vtkm::IdComponent i = 0; i < numSlabs; ++i)
+    {
+      this->GatherSlab(
+        input, this->ClampX(i - this->Radius[0]), y, z, &ring[i * this->SlabSize]);
+    }
+
+    const std::size_t size = static_cast<std::size_t>(this->NeighborhoodSize);
+    const std::size_t rank = static_cast<std::size_t>(this->Rank);
+    for (vtkm::Id x = 0; x < this->PointDimensions[0]; ++x)
+    {
+      if (x > 0)
+      {
+        // The oldest slab of the ring leaves the neighborhood.
+        const vtkm::IdComponent slot = static_cast<vtkm::IdComponent>((x - 1) % numSlabs);
+        this->GatherSlab(
+          input, this->ClampX(x + this->Radius[0]), y, z, &ring[slot * this->SlabSize]);
+      }
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        values[static_cast<vtkm::IdComponent>(i)] = ring[static_cast<vtkm::IdComponent>(i)];
+      }
+      output.Set(rowStart + x, find_median(&values[0], rank, size));
+    }
+  }
+
+  template <typename InPortalType, typename OutPortalType>
+  VTKM_EXEC void FilterRow(vtkm::Id y,
+                           vtkm::Id z,
+                           const InPortalType& input,
+                           OutPortalType& output,
+                           std::false_type) const
+  {
+    if (this->NeighborhoodSize <= MaxSelectNeighborhoodSize)
+    {
+      this->SelectRow(y, z, input, output);
+      return;
+    }
+
+    using T = typename InPortalType::ValueType;
+    vtkm::Vec<T, MaxNeighborhoodSize> bufferA;
+    vtkm::Vec<T, MaxNeighborhoodSize> bufferB;
+    vtkm::Vec<T, MaxSlabSize> leaving;
+    vtkm::Vec<T, MaxSlabSize> entering;
+    T* sorted = &bufferA[0];
+    T* merged = &bufferB[0];
+
+    const vtkm::Id rowStart = this->PointDimensions[0] * (y + this->PointDimensions[1] * z);
+    vtkm::IdComponent size = 0;
+    for (vtkm::IdComponent i = -this->Radius[0]; i <= this->Radius[0]; ++i)
+    {
+      this->GatherSlab(input, this->ClampX(i), y, z, sorted + size);
+      size += this->SlabSize;
+    }
+    sort_neighborhood(sorted, size);
+    output.Set(rowStart, sorted[this->Rank]);
+
+    for (vtkm::Id x = 1; x < this->PointDimensions[0]; ++x)
+    {
+      const vtkm::Id leavingX = this->ClampX(x - this->Radius[0] - 1);
+      const vtkm::Id enteringX = this->ClampX(x + this->Radius[0]);
+      if (leavingX != enteringX)
+      {
+        this->GatherSlab(input, leavingX, y, z, &leaving[0]);
+        this->GatherSlab(input, enteringX, y, z, &entering[0]);
+        sort_neighborhood(&leaving[0], this->SlabSize);
+        sort_neighborhood(&entering[0], this->SlabSize);
+
+        // Merge the entering values in and skip one copy of each leaving value.
+        vtkm::IdComponent leavingIndex = 0;
+        vtkm::IdComponent enteringIndex = 0;
+        vtkm::IdComponent mergedIndex = 0;
+        for (vtkm::IdComponent i = 0; i < size; ++i)
+        {
+          const T value = sorted[i];
+          while (enteringIndex < this->SlabSize && rank_less(entering[enteringIndex], value))
+          {
+            merged[mergedIndex++] = entering[enteringIndex++];
+          }
+          if (leavingIndex < this->SlabSize && !rank_less(leaving[leavingIndex], value) &&
+              !rank_less(value, leaving[leavingIndex]))
+          {
+            ++leavingIndex;
+          }
+          else
+          {
+            merged[mergedIndex++] = value;
+          }
+        }
+        while (enteringIndex < this->SlabSize)
+        {
+          merged[mergedIndex++] = entering[enteringIndex++];
+        }
+        VTKM_ASSERT(mergedIndex == size);
+        vtkm::Swap(sorted, merged);
+      }
+      output.Set(rowStart + x, sorted[this->Rank]);
+    }
+  }
+
+  template <typename InPortalType, typename OutPortalType>
+  VTKM_EXEC void FilterRow(vtkm::Id y,
+                           vtkm::Id z,
+                           const InPortalType& input,
+                           OutPortalType& output,
+                           std::true_type) const
+  {
+    using T = typename InPortalType::ValueType;
+    constexpr vtkm::IdComponent offset = std::is_signed<T>::value ? 128 : 0;
+    vtkm::Vec<vtkm::IdComponent, 256> fine(0);
+    vtkm::Vec<vtkm::IdComponent, 16> coarse(0);
+    vtkm::Vec<T, MaxSlabSize> slab;
+
+    auto update = [&](vtkm::Id x, vtkm::IdComponent delta) {
+      this->GatherSlab(input, x, y, z, &slab[0]);
+      for (vtkm::IdComponent i = 0; i < this->SlabSize; ++i)
+      {
+        const vtkm::IdComponent bin = static_cast<vtkm::IdComponent>(slab[i]) + offset;
+        fine[bin] += delta;
+        coarse[bin / 16] += delta;
+      }
+    };
+    auto findRank = [&]() {
+      vtkm::IdComponent remaining = this->Rank;
+      vtkm::IdComponent bin = 0;
+      while (remaining >= coarse[bin / 16])
+      {
+        remaining -= coarse[bin / 16];
+        bin += 16;
+      }
+      while (remaining >= fine[bin])
+      {
+        remaining -= fine[bin];
+        ++bin;
+      }
+      return static_cast<T>(bin - offset);
+    };
+
+    const vtkm::Id rowStart = this->PointDimensions[0] * (y + this->PointDimensions[1] * z);
+    for (vtkm::IdComponent i = -this->Radius[0]; i <= this->Radius[0]; ++i)
+    {
+      update(this->ClampX(i), 1);
+    }
+    output.Set(rowStart, findRank());
+
+    for (vtkm::Id x = 1; x < this->PointDimensions[0]; ++x)
+    {
+      const vtkm::Id leavingX = this->ClampX(x - this->Radius[0] - 1);
+      const vtkm::Id enteringX = this->ClampX(x + this->Radius[0]);
+      if (leavingX != enteringX)
+      {
+        update(leavingX, -1);
+        update(enteringX, 1);
+      }
+      output.Set(rowStart + x, findRank());
+    }
+  }
+
+  vtkm::Id3 PointDimensions;
+  vtkm::IdComponent3 Radius;
+  vtkm::IdComponent SlabSize;
+  vtkm::IdComponent NeighborhoodSize;
+  vtkm::IdComponent Rank;
+};
+}
+} // namespace vtkm::worklet
+
+#endif // vtk_m_worklet_ImageMedian_h
@@ -20,7 +20,7 @@ vtkm::cont::PartitionedDataSet MergeDataSets::DoExecutePartitions(
   const vtkm::cont::PartitionedDataSet& input)
 {
   vtkm::cont::DataSet mergedResult =
-    vtkm::cont::MergePartitionedDataSet(input, this->GetInvalidValue());
+    vtkm::cont::MergePartitionedDataSet(input, this->GetInvalidValue(), this->DeferFieldMerging);
   return vtkm::cont::PartitionedDataSet(mergedResult);
 }
 vtkm::cont::DataSet MergeDataSets::DoExecute(const vtkm::cont::DataSet&)
@@ -45,6 +45,17 @@ public:
   /// @copydoc SetInvalidValue
   vtkm::Float64 GetInvalidValue() { return this->InvalidValue; }
 
+  /// @brief Specify whether the fields are merged only when they are used.
+  ///
+  /// When set to true, each field of the merged data set is concatenated from the
+  /// partitions the first time its data are retrieved, so the fields that are never used
+  /// are never copied. The output then references the arrays of the input partitions.
+  /// The default is false, which merges all fields when the filter executes. See
+  /// `vtkm::cont::MergePartitionedDataSet()`.
+  void SetDeferFieldMerging(bool value) { this->DeferFieldMerging = value; }
+  /// @copydoc SetDeferFieldMerging
+  bool GetDeferFieldMerging() const { return this->DeferFieldMerging; }
+
 private:
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& inputDataSet) override;
 
@@ -52,6 +63,7 @@ private:
     const vtkm::cont::PartitionedDataSet& input) override;
 
   vtkm::Float64 InvalidValue = vtkm::Nan64();
+  bool DeferFieldMerging = false;
 };
 } // namespace multi_block
 } // namesapce filter
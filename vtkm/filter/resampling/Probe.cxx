@@ -7,6 +7,9 @@
 //  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
+#include <vtkm/cont/ArrayHandleCartesianProduct.h>
+#include <vtkm/cont/ArrayHandleSOA.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
 #include <vtkm/cont/internal/CastInvalidValue.h>
 
 #include <vtkm/filter/MapFieldPermutation.h>
@@ -23,6 +26,38 @@ namespace resampling
 namespace
 {
 
+template <typename T>
+using RectilinearCoordinates =
+  vtkm::cont::ArrayHandleCartesianProduct<vtkm::cont::ArrayHandle<T>,
+                                          vtkm::cont::ArrayHandle<T>,
+                                          vtkm::cont::ArrayHandle<T>>;
+
+using CoordinateArrayTypes = vtkm::List<vtkm::cont::ArrayHandleUniformPointCoordinates,
+                                        vtkm::cont::ArrayHandle<vtkm::Vec3f_32>,
+                                        vtkm::cont::ArrayHandle<vtkm::Vec3f_64>,
+                                        vtkm::cont::ArrayHandleSOA<vtkm::Vec3f_32>,
+                                        vtkm::cont::ArrayHandleSOA<vtkm::Vec3f_64>,
+                                        RectilinearCoordinates<vtkm::Float32>,
+                                        RectilinearCoordinates<vtkm::Float64>>;
+
+// Returns true when both arrays share the same memory. Arrays of other types are never
+// considered the same, which only costs rebuilding the locator.
+bool SameCoordinates(const vtkm::cont::UnknownArrayHandle& array1,
+                     const vtkm::cont::UnknownArrayHandle& array2)
+{
+  bool same = false;
+  vtkm::ListForEach(
+    [&](auto type) {
+      using ArrayType = decltype(type);
+      if (array1.IsType<ArrayType>() && array2.IsType<ArrayType>())
+      {
+        same = array1.AsArrayHandle<ArrayType>() == array2.AsArrayHandle<ArrayType>();
+      }
+    },
+    CoordinateArrayTypes{});
+  return same;
+}
+
 bool DoMapField(vtkm::cont::DataSet& result,
                 const vtkm::cont::Field& field,
                 const vtkm::worklet::Probe& worklet,
@@ -87,10 +122,43 @@ bool DoMapField(vtkm::cont::DataSet& result,
 
 vtkm::cont::DataSet Probe::DoExecute(const vtkm::cont::DataSet& input)
 {
+  const vtkm::cont::UnknownCellSet& cells = input.GetCellSet();
+  const vtkm::cont::CoordinateSystem& coords =
+    input.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex());
+
+  const vtkm::cont::UnknownArrayHandle& points = this->Geometry.GetCoordinateSystem().GetData();
   vtkm::worklet::Probe worklet;
-  worklet.Run(input.GetCellSet(),
-              input.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex()),
-              this->Geometry.GetCoordinateSystem().GetData());
+  if (points.IsType<vtkm::cont::ArrayHandleUniformPointCoordinates>())
+  {
+    // Uniform points are found by visiting the input cells, which needs no locator.
+    worklet.Run(cells, coords, points);
+  }
+  else
+  {
+    // Copies of a locator share its search structure, so each call probes with its own copy
+    // and concurrent partitions never modify the same locator.
+    vtkm::cont::CellLocatorGeneral locator;
+    bool cached;
+    {
+      std::lock_guard<std::mutex> lock(this->Cache->Mutex);
+      const vtkm::cont::CellLocatorGeneral& cachedLocator = this->Cache->Locator;
+      cached = cachedLocator.GetCellSet().GetCellSetBase() == cells.GetCellSetBase() &&
+        SameCoordinates(cachedLocator.GetCoordinates().GetData(), coords.GetData());
+      if (cached)
+      {
+        locator = cachedLocator;
+      }
+    }
+    if (!cached)
+    {
+      locator.SetCellSet(cells);
+      locator.SetCoordinates(coords);
+      locator.Update();
+      std::lock_guard<std::mutex> lock(this->Cache->Mutex);
+      this->Cache->Locator = locator;
+    }
+    worklet.Run(locator, points);
+  }
 
   auto mapper = [&](auto& outDataSet, const auto& f) {
     DoMapField(outDataSet, f, worklet, this->InvalidValue);
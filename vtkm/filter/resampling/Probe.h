@@ -10,9 +10,13 @@
 #ifndef vtk_m_filter_resampling_Probe_h
 #define vtk_m_filter_resampling_Probe_h
 
+#include <vtkm/cont/CellLocatorGeneral.h>
 #include <vtkm/filter/Filter.h>
 #include <vtkm/filter/resampling/vtkm_filter_resampling_export.h>
 
+#include <memory>
+#include <mutex>
+
 namespace vtkm
 {
 namespace filter
@@ -33,6 +37,14 @@ namespace resampling
 /// transferred to it. The fields are transfered by probing the input data
 /// set at the point locations of the geometry.
 ///
+/// The filter keeps the cell locator it builds for the input. When `Execute()` is called
+/// again with the same cell set and coordinate arrays, for example to probe other
+/// fields or another geometry, the locator is reused instead of rebuilt. Modifying the
+/// values of these arrays in place is not detected. The partitions of a
+/// `vtkm::cont::PartitionedDataSet` are still probed concurrently, each with its own
+/// locator. Copies of the filter share the cached locator. A geometry with uniform point
+/// coordinates is probed cell by cell and does not build a locator.
+///
 class VTKM_FILTER_RESAMPLING_EXPORT Probe : public vtkm::filter::Filter
 {
 public:
@@ -63,6 +75,15 @@ private:
 
   vtkm::cont::DataSet Geometry;
 
+  // Partitions may be executed on several threads, so the cached locator is only accessed
+  // while holding the mutex. It is held by pointer to keep the filter copyable.
+  struct LocatorCache
+  {
+    vtkm::cont::CellLocatorGeneral Locator;
+    std::mutex Mutex;
+  };
+  std::shared_ptr<LocatorCache> Cache = std::make_shared<LocatorCache>();
+
   vtkm::Float64 InvalidValue = vtkm::Nan64();
 };
 
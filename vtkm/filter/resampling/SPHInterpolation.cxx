@@ -0,0 +1,168 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/ErrorFilterExecution.h>
+
+#include <vtkm/filter/resampling/SPHInterpolation.h>
+#include <vtkm/filter/resampling/worklet/SPHInterpolation.h>
+
+#include <vtkm/worklet/splatkernels/Gaussian.h>
+#include <vtkm/worklet/splatkernels/Spline3rdOrder.h>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace resampling
+{
+
+namespace
+{
+
+struct ComputeVolume
+{
+  VTKM_EXEC_CONT vtkm::FloatDefault operator()(vtkm::FloatDefault mass,
+                                               vtkm::FloatDefault density) const
+  {
+    return mass / density;
+  }
+};
+
+vtkm::cont::ArrayHandle<vtkm::FloatDefault> GetParticleValues(const vtkm::cont::DataSet& input,
+                                                              const std::string& fieldName,
+                                                              vtkm::FloatDefault defaultValue)
+{
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> values;
+  if (fieldName.empty())
+  {
+    values.AllocateAndFill(input.GetNumberOfPoints(), defaultValue);
+  }
+  else
+  {
+    const vtkm::cont::Field& field = input.GetField(fieldName);
+    if (!field.IsPointField())
+    {
+      throw vtkm::cont::ErrorFilterExecution("SPHInterpolation: field " + fieldName +
+                                             " is not a point field.");
+    }
+    vtkm::cont::ArrayCopyShallowIfPossible(field.GetData(), values);
+  }
+  return values;
+}
+
+template <typename KernelType>
+bool DoMapField(vtkm::cont::DataSet& result,
+                const vtkm::cont::Field& field,
+                const vtkm::cont::DataSet& input,
+                const vtkm::cont::ArrayHandleUniformPointCoordinates& gridPoints,
+                const vtkm::worklet::SPHInterpolation& worklet,
+                const KernelType& kernel,
+                bool normalize)
+{
+  if (field.IsPointField())
+  {
+    if (input.HasCoordinateSystem(field.GetName()))
+    {
+      // The particle positions are not interpolated.
+      return false;
+    }
+
+    auto resolveType = [&](const auto& concrete) {
+      using T = typename std::decay_t<decltype(concrete)>::ValueType;
+      vtkm::cont::ArrayHandle<T> outArray;
+      worklet.Interpolate(kernel, normalize, gridPoints, concrete, outArray);
+      result.AddPointField(field.GetName(), outArray);
+    };
+    field.GetData()
+      .CastAndCallForTypesWithFloatFallback<vtkm::TypeListField, VTKM_DEFAULT_STORAGE_LIST>(
+        resolveType);
+    return true;
+  }
+  else if (field.IsWholeDataSetField())
+  {
+    result.AddField(field);
+    return true;
+  }
+  else
+  {
+    return false;
+  }
+}
+
+} // anonymous namespace
+
+vtkm::cont::DataSet SPHInterpolation::DoExecute(const vtkm::cont::DataSet& input)
+{
+  for (vtkm::IdComponent d = 0; d < 3; ++d)
+  {
+    if (this->PointDimensions[d] < 1)
+    {
+      throw vtkm::cont::ErrorFilterExecution(
+        "SPHInterpolation: the output grid needs at least one point along each axis.");
+    }
+  }
+
+  const vtkm::cont::ArrayHandle<vtkm::FloatDefault> smoothingLengths =
+    GetParticleValues(input, this->SmoothingLengthField, this->SmoothingLength);
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> volumes =
+    GetParticleValues(input, this->MassField, 1);
+  if (!this->DensityField.empty())
+  {
+    vtkm::cont::ArrayHandle<vtkm::FloatDefault> masses = volumes;
+    volumes = vtkm::cont::ArrayHandle<vtkm::FloatDefault>();
+    vtkm::cont::Algorithm::Transform(masses,
+                                     GetParticleValues(input, this->DensityField, 1),
+                                     volumes,
+                                     ComputeVolume{});
+  }
+
+  const bool twoDimensional = this->PointDimensions[2] == 1;
+  vtkm::cont::CellSetStructured<3> cells3D;
+  cells3D.SetPointDimensions(this->PointDimensions);
+  vtkm::cont::UnknownCellSet outCells = cells3D;
+  if (twoDimensional)
+  {
+    vtkm::cont::CellSetStructured<2> cells2D;
+    cells2D.SetPointDimensions({ this->PointDimensions[0], this->PointDimensions[1] });
+    outCells = cells2D;
+  }
+  const vtkm::cont::ArrayHandleUniformPointCoordinates gridPoints(
+    this->PointDimensions, this->Origin, this->Spacing);
+  const vtkm::cont::CoordinateSystem outCoords("coords", gridPoints);
+
+  // The kernels are only evaluated with the smoothing length of each particle, so the
+  // smoothing length given to the constructors is not used.
+  auto interpolate = [&](const auto& kernel) {
+    vtkm::worklet::SPHInterpolation worklet;
+    worklet.Run(
+      input.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex()).GetDataAsMultiplexer(),
+      smoothingLengths,
+      volumes,
+      kernel.getDilationFactor());
+    auto mapper = [&](auto& outDataSet, const auto& f) {
+      DoMapField(outDataSet, f, input, gridPoints, worklet, kernel, this->ShepardNormalization);
+    };
+    return this->CreateResultCoordinateSystem(input, outCells, outCoords, mapper);
+  };
+  if (this->Kernel == KernelType::Gaussian)
+  {
+    return twoDimensional ? interpolate(vtkm::worklet::splatkernels::Gaussian<2>(1.0))
+                          : interpolate(vtkm::worklet::splatkernels::Gaussian<3>(1.0));
+  }
+  return twoDimensional ? interpolate(vtkm::worklet::splatkernels::Spline3rdOrder<2>(1.0))
+                        : interpolate(vtkm::worklet::splatkernels::Spline3rdOrder<3>(1.0));
+}
+
+} // namespace resampling
+} // namespace filter
+} // namespace vtkm
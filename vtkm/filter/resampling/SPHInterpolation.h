@@ -0,0 +1,179 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_filter_resampling_SPHInterpolation_h
+#define vtk_m_filter_resampling_SPHInterpolation_h
+
+#include <vtkm/Bounds.h>
+#include <vtkm/filter/Filter.h>
+#include <vtkm/filter/resampling/vtkm_filter_resampling_export.h>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace resampling
+{
+
+/// @brief Interpolate the fields of particles to a uniform grid with SPH kernels.
+///
+/// The points of the input are particles. Each point field of the input is interpolated
+/// to the points of a uniform grid with the smoothed particle hydrodynamics (SPH) estimate
+///
+///   A(x) = sum_j (m_j / rho_j) A_j W(|x - x_j|, h_j)
+///
+/// where m_j, rho_j and h_j are the mass, density and smoothing length of particle j, and
+/// W is the kernel selected with `SetKernel()`. The mass, density and smoothing length are
+/// either constants or point fields of the input.
+///
+/// Each grid point gathers the contributions of the particles around it, which are found
+/// by sorting the particles into bins as wide as their kernel support. Particles are binned
+/// separately for each power of two of the smoothing length, so a few particles with a
+/// large smoothing length do not slow down the search in dense regions. The grid points
+/// are computed independently, so no atomic operations are needed and the result does not
+/// depend on the order of the particles.
+///
+/// The filter keeps a sorted copy of the positions, smoothing lengths and volumes of all
+/// the particles of a partition. Very large particle sets should be split into partitions
+/// (for example one per rank), each interpolated onto its own grid.
+///
+/// The output is the uniform grid defined by `SetPointDimensions()`, `SetOrigin()` and
+/// `SetSpacing()` (or `SetBounds()`). When the grid has a single point along z, the 2D
+/// form of the kernel is used.
+class VTKM_FILTER_RESAMPLING_EXPORT SPHInterpolation : public vtkm::filter::Filter
+{
+public:
+  /// @brief The kernels available to weight the particles.
+  enum struct KernelType
+  {
+    /// The cubic B-spline kernel, which is zero beyond twice the smoothing length.
+    CubicSpline,
+    /// The Gaussian kernel, truncated at five times the smoothing length.
+    Gaussian
+  };
+
+  /// @brief Specify the kernel used to weight the particles.
+  ///
+  /// The default is `KernelType::CubicSpline`.
+  VTKM_CONT void SetKernel(KernelType kernel) { this->Kernel = kernel; }
+  /// @copydoc SetKernel
+  VTKM_CONT KernelType GetKernel() const { return this->Kernel; }
+
+  /// @brief The number of points of the output grid along each axis.
+  ///
+  /// The default is 64 by 64 by 64 points.
+  VTKM_CONT void SetPointDimensions(const vtkm::Id3& dimensions)
+  {
+    this->PointDimensions = dimensions;
+  }
+  /// @copydoc SetPointDimensions
+  VTKM_CONT vtkm::Id3 GetPointDimensions() const { return this->PointDimensions; }
+
+  /// @brief The position of the first point of the output grid.
+  VTKM_CONT void SetOrigin(const vtkm::Vec3f& origin) { this->Origin = origin; }
+  /// @copydoc SetOrigin
+  VTKM_CONT vtkm::Vec3f GetOrigin() const { return this->Origin; }
+
+  /// @brief The distance between the points of the output grid along each axis.
+  VTKM_CONT void SetSpacing(const vtkm::Vec3f& spacing) { this->Spacing = spacing; }
+  /// @copydoc SetSpacing
+  VTKM_CONT vtkm::Vec3f GetSpacing() const { return this->Spacing; }
+
+  /// @brief The region covered by the output grid.
+  ///
+  /// This method can be used in place of `SetOrigin` and `SetSpacing`. The point
+  /// dimensions must be set before the bounds are set.
+  VTKM_CONT void SetBounds(const vtkm::Bounds& bounds)
+  {
+    const vtkm::Range ranges[3] = { bounds.X, bounds.Y, bounds.Z };
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      this->Origin[d] = static_cast<vtkm::FloatDefault>(ranges[d].Min);
+      this->Spacing[d] = this->PointDimensions[d] > 1
+        ? static_cast<vtkm::FloatDefault>(ranges[d].Length() /
+                                          static_cast<vtkm::Float64>(this->PointDimensions[d] - 1))
+        : vtkm::FloatDefault(1);
+    }
+  }
+  /// @copydoc SetBounds
+  VTKM_CONT vtkm::Bounds GetBounds() const
+  {
+    vtkm::Vec3f last = this->Origin;
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      last[d] += this->Spacing[d] * static_cast<vtkm::FloatDefault>(this->PointDimensions[d] - 1);
+    }
+    return { { this->Origin[0], last[0] },
+             { this->Origin[1], last[1] },
+             { this->Origin[2], last[2] } };
+  }
+
+  /// @brief The smoothing length of all the particles.
+  ///
+  /// This value is used when no smoothing length field is set. The default is 1.
+  VTKM_CONT void SetSmoothingLength(vtkm::FloatDefault length) { this->SmoothingLength = length; }
+  /// @copydoc SetSmoothingLength
+  VTKM_CONT vtkm::FloatDefault GetSmoothingLength() const { return this->SmoothingLength; }
+
+  /// @brief The name of the point field holding the smoothing length of each particle.
+  ///
+  /// When empty (the default), all particles use `GetSmoothingLength()`.
+  VTKM_CONT void SetSmoothingLengthField(const std::string& name)
+  {
+    this->SmoothingLengthField = name;
+  }
+  /// @copydoc SetSmoothingLengthField
+  VTKM_CONT const std::string& GetSmoothingLengthField() const
+  {
+    return this->SmoothingLengthField;
+  }
+
+  /// @brief The name of the point field holding the mass of each particle.
+  ///
+  /// When empty (the default), all particles have a mass of 1.
+  VTKM_CONT void SetMassField(const std::string& name) { this->MassField = name; }
+  /// @copydoc SetMassField
+  VTKM_CONT const std::string& GetMassField() const { return this->MassField; }
+
+  /// @brief The name of the point field holding the density of each particle.
+  ///
+  /// When empty (the default), all particles have a density of 1.
+  VTKM_CONT void SetDensityField(const std::string& name) { this->DensityField = name; }
+  /// @copydoc SetDensityField
+  VTKM_CONT const std::string& GetDensityField() const { return this->DensityField; }
+
+  /// @brief Specify whether the interpolated values are normalized by the kernel sum.
+  ///
+  /// When on, the value at each grid point is divided by sum_j (m_j / rho_j) W(|x - x_j|, h_j)
+  /// (Shepard normalization), which makes the interpolation of a constant field exact where
+  /// the particles are sparse or near the boundary of the particles. Grid points out of
+  /// reach of all the particles are 0 in both cases. The default is off.
+  VTKM_CONT void SetShepardNormalization(bool flag) { this->ShepardNormalization = flag; }
+  /// @copydoc SetShepardNormalization
+  VTKM_CONT bool GetShepardNormalization() const { return this->ShepardNormalization; }
+
+private:
+  VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
+
+  KernelType Kernel = KernelType::CubicSpline;
+  vtkm::Id3 PointDimensions = { 64, 64, 64 };
+  vtkm::Vec3f Origin = { 0.0f, 0.0f, 0.0f };
+  vtkm::Vec3f Spacing = { 1.0f, 1.0f, 1.0f };
+  vtkm::FloatDefault SmoothingLength = 1.0f;
+  std::string SmoothingLengthField;
+  std::string MassField;
+  std::string DensityField;
+  bool ShepardNormalization = false;
+};
+
+} // namespace resampling
+} // namespace filter
+} // namespace vtkm
+
+#endif // vtk_m_filter_resampling_SPHInterpolation_h
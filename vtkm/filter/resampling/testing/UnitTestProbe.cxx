@@ -43,6 +43,22 @@ vtkm::cont::DataSet MakeGeometryDataSet()
   return geometry;
 }
 
+vtkm::cont::DataSet Translate(const vtkm::cont::DataSet& dataSet, const vtkm::Vec3f& offset)
+{
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> points;
+  vtkm::cont::ArrayCopy(dataSet.GetCoordinateSystem().GetData(), points);
+  auto portal = points.WritePortal();
+  for (vtkm::Id i = 0; i < portal.GetNumberOfValues(); ++i)
+  {
+    portal.Set(i, portal.Get(i) + offset);
+  }
+
+  vtkm::cont::DataSet result = dataSet;
+  result.AddCoordinateSystem(
+    vtkm::cont::CoordinateSystem(dataSet.GetCoordinateSystem().GetName(), points));
+  return result;
+}
+
 vtkm::cont::DataSet ConvertDataSetUniformToExplicit(const vtkm::cont::DataSet& uds)
 {
   vtkm::filter::clean_grid::CleanGrid toUnstructured;
@@ -198,12 +214,64 @@ private:
                     GetExpectedHiddenCells());
   }
 
+  static void ReuseLocator()
+  {
+    std::cout << "Testing Probe reusing the locator:\n";
+
+    auto input = ConvertDataSetUniformToExplicit(MakeInputDataSet());
+    auto geometry = ConvertDataSetUniformToExplicit(MakeGeometryDataSet());
+
+    vtkm::filter::resampling::Probe probe;
+    probe.SetFieldsToPass({ "pointdata", "celldata" });
+    probe.SetGeometry(geometry);
+    for (int i = 0; i < 2; ++i)
+    {
+      auto output = probe.Execute(input);
+      TestResultArray(vtkm::cont::Cast<FieldArrayType>(output.GetField("pointdata").GetData()),
+                      GetExpectedPointData());
+      TestResultArray(vtkm::cont::Cast<HiddenArrayType>(output.GetPointField("HIDDEN").GetData()),
+                      GetExpectedHiddenPoints());
+    }
+
+    // Moving the points of the input without changing its cells must update the locator.
+    const vtkm::Vec3f offset(1.0f, 2.0f, 0.0f);
+    probe.SetGeometry(Translate(geometry, offset));
+    auto output = probe.Execute(Translate(input, offset));
+    TestResultArray(vtkm::cont::Cast<FieldArrayType>(output.GetField("pointdata").GetData()),
+                    GetExpectedPointData());
+    TestResultArray(vtkm::cont::Cast<FieldArrayType>(output.GetField("celldata").GetData()),
+                    GetExpectedCellData());
+    TestResultArray(vtkm::cont::Cast<HiddenArrayType>(output.GetPointField("HIDDEN").GetData()),
+                    GetExpectedHiddenPoints());
+
+    // The partitions may be probed concurrently, each with its own cell set. A copy of the
+    // filter shares the cached locator.
+    vtkm::cont::PartitionedDataSet partitions;
+    partitions.AppendPartition(input);
+    partitions.AppendPartition(ConvertDataSetUniformToExplicit(MakeInputDataSet()));
+    partitions.AppendPartition(ConvertDataSetUniformToExplicit(MakeInputDataSet()));
+    vtkm::filter::resampling::Probe probeCopy = probe;
+    probeCopy.SetGeometry(geometry);
+    auto outputs = probeCopy.Execute(partitions);
+    VTKM_TEST_ASSERT(outputs.GetNumberOfPartitions() == 3);
+    for (const auto& partition : outputs)
+    {
+      TestResultArray(
+        vtkm::cont::Cast<FieldArrayType>(partition.GetField("pointdata").GetData()),
+        GetExpectedPointData());
+      TestResultArray(
+        vtkm::cont::Cast<HiddenArrayType>(partition.GetPointField("HIDDEN").GetData()),
+        GetExpectedHiddenPoints());
+    }
+  }
+
 public:
   static void Run()
   {
     ExplicitToUnifrom();
     UniformToExplict();
     ExplicitToExplict();
+    ReuseLocator();
   }
 };
 
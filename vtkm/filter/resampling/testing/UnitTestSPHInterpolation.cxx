@@ -0,0 +1,313 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/resampling/SPHInterpolation.h>
+
+#include <vtkm/cont/DataSetBuilderExplicit.h>
+#include <vtkm/cont/testing/Testing.h>
+#include <vtkm/worklet/splatkernels/Gaussian.h>
+#include <vtkm/worklet/splatkernels/Spline3rdOrder.h>
+
+#include <random>
+
+namespace
+{
+
+using KernelType = vtkm::filter::resampling::SPHInterpolation::KernelType;
+
+struct Particles
+{
+  std::vector<vtkm::Vec3f> Positions;
+  std::vector<vtkm::FloatDefault> SmoothingLengths;
+  std::vector<vtkm::FloatDefault> Masses;
+  std::vector<vtkm::FloatDefault> Densities;
+  std::vector<vtkm::FloatDefault> Scalars;
+  std::vector<vtkm::Vec3f> Vectors;
+};
+
+Particles MakeParticles(std::size_t numParticles, bool flat)
+{
+  std::mt19937 rng(7);
+  std::uniform_real_distribution<vtkm::FloatDefault> box(0, 4);
+  std::uniform_real_distribution<vtkm::FloatDefault> range(0.5f, 1.5f);
+
+  Particles particles;
+  for (std::size_t i = 0; i < numParticles; ++i)
+  {
+    const vtkm::Vec3f position(box(rng), box(rng), flat ? 0 : box(rng));
+    particles.Positions.push_back(position);
+    particles.SmoothingLengths.push_back(0.3f * range(rng));
+    particles.Masses.push_back(range(rng));
+    particles.Densities.push_back(range(rng));
+    particles.Scalars.push_back(position[0] * position[1] - position[2]);
+    particles.Vectors.push_back(vtkm::Vec3f(range(rng), -position[2], position[0]));
+  }
+  return particles;
+}
+
+vtkm::cont::DataSet MakeDataSet(const Particles& particles)
+{
+  std::vector<vtkm::Id> connectivity(particles.Positions.size());
+  for (std::size_t i = 0; i < connectivity.size(); ++i)
+  {
+    connectivity[i] = static_cast<vtkm::Id>(i);
+  }
+  vtkm::cont::DataSet dataSet = vtkm::cont::DataSetBuilderExplicit::Create(
+    particles.Positions, vtkm::CellShapeTagVertex{}, 1, connectivity);
+  dataSet.AddPointField("h", particles.SmoothingLengths);
+  dataSet.AddPointField("mass", particles.Masses);
+  dataSet.AddPointField("rho", particles.Densities);
+  dataSet.AddPointField("scalar", particles.Scalars);
+  dataSet.AddPointField("vector", particles.Vectors);
+  return dataSet;
+}
+
+// Brute force SPH sum over all the particles for every grid point.
+template <typename Kernel, typename T>
+std::vector<T> Interpolate(const Kernel& kernel,
+                           const Particles& particles,
+                           const std::vector<T>& values,
+                           const vtkm::cont::ArrayHandleUniformPointCoordinates& grid,
+                           bool normalize)
+{
+  auto gridPortal = grid.ReadPortal();
+  std::vector<T> result;
+  for (vtkm::Id g = 0; g < gridPortal.GetNumberOfValues(); ++g)
+  {
+    const vtkm::Vec3f_64 x = gridPortal.Get(g);
+    vtkm::Vec3f_64 sum(0.0);
+    vtkm::Float64 weightSum = 0.0;
+    for (std::size_t p = 0; p < particles.Positions.size(); ++p)
+    {
+      const vtkm::Float64 distance2 =
+        vtkm::MagnitudeSquared(vtkm::Vec3f_64(particles.Positions[p]) - x);
+      const vtkm::Float64 weight = particles.Masses[p] / particles.Densities[p] *
+        kernel.w2(particles.SmoothingLengths[p], distance2);
+      weightSum += weight;
+      for (vtkm::IdComponent c = 0; c < vtkm::VecTraits<T>::NUM_COMPONENTS; ++c)
+      {
+        sum[c] += weight * vtkm::VecTraits<T>::GetComponent(values[p], c);
+      }
+    }
+    T value;
+    for (vtkm::IdComponent c = 0; c < vtkm::VecTraits<T>::NUM_COMPONENTS; ++c)
+    {
+      const vtkm::Float64 component = (normalize && weightSum > 0) ? sum[c] / weightSum : sum[c];
+      vtkm::VecTraits<T>::SetComponent(value, c, static_cast<vtkm::FloatDefault>(component));
+    }
+    result.push_back(value);
+  }
+  return result;
+}
+
+template <typename T>
+void CheckField(const vtkm::cont::DataSet& output,
+                const std::string& name,
+                const std::vector<T>& expected)
+{
+  vtkm::cont::ArrayHandle<T> values;
+  output.GetPointField(name).GetData().AsArrayHandle(values);
+  VTKM_TEST_ASSERT(values.GetNumberOfValues() == static_cast<vtkm::Id>(expected.size()),
+                   "Wrong number of values for ",
+                   name);
+  auto portal = values.ReadPortal();
+  for (vtkm::Id i = 0; i < portal.GetNumberOfValues(); ++i)
+  {
+    VTKM_TEST_ASSERT(test_equal(portal.Get(i), expected[static_cast<std::size_t>(i)], 1e-4),
+                     "Wrong value of ",
+                     name,
+                     " at grid point ",
+                     i,
+                     ": ",
+                     portal.Get(i),
+                     " expected ",
+                     expected[static_cast<std::size_t>(i)]);
+  }
+}
+
+template <typename Kernel>
+void CheckKernel(const Kernel& kernel, KernelType kernelType, bool flat)
+{
+  const Particles particles = MakeParticles(flat ? 200 : 600, flat);
+  const vtkm::Id3 dims(9, 8, flat ? 1 : 7);
+
+  vtkm::filter::resampling::SPHInterpolation filter;
+  filter.SetKernel(kernelType);
+  filter.SetPointDimensions(dims);
+  filter.SetBounds({ { -0.5, 4.5 }, { -0.5, 4.5 }, { -0.5, 4.5 } });
+  filter.SetSmoothingLengthField("h");
+  filter.SetMassField("mass");
+  filter.SetDensityField("rho");
+  const vtkm::cont::ArrayHandleUniformPointCoordinates grid(
+    dims, filter.GetOrigin(), filter.GetSpacing());
+
+  for (bool normalize : { false, true })
+  {
+    filter.SetShepardNormalization(normalize);
+    const vtkm::cont::DataSet output = filter.Execute(MakeDataSet(particles));
+    VTKM_TEST_ASSERT(output.GetNumberOfPoints() == dims[0] * dims[1] * dims[2]);
+    VTKM_TEST_ASSERT(output.GetCellSet().GetCellShape(0) ==
+                     (flat ? vtkm::CELL_SHAPE_QUAD : vtkm::CELL_SHAPE_HEXAHEDRON));
+    CheckField(
+      output, "scalar", Interpolate(kernel, particles, particles.Scalars, grid, normalize));
+    CheckField(
+      output, "vector", Interpolate(kernel, particles, particles.Vectors, grid, normalize));
+  }
+}
+
+void TestAgainstBruteForce()
+{
+  std::cout << "Testing SPHInterpolation with the cubic spline kernel" << std::endl;
+  CheckKernel(vtkm::worklet::splatkernels::Spline3rdOrder<3>(1.0), KernelType::CubicSpline, false);
+  CheckKernel(vtkm::worklet::splatkernels::Spline3rdOrder<2>(1.0), KernelType::CubicSpline, true);
+
+  std::cout << "Testing SPHInterpolation with the Gaussian kernel" << std::endl;
+  CheckKernel(vtkm::worklet::splatkernels::Gaussian<3>(1.0), KernelType::Gaussian, false);
+  CheckKernel(vtkm::worklet::splatkernels::Gaussian<2>(1.0), KernelType::Gaussian, true);
+}
+
+void TestShepardNormalization()
+{
+  std::cout << "Testing SPHInterpolation of a constant field" << std::endl;
+  // A lattice of particles with a constant smoothing length, so every grid point inside
+  // the lattice is reached by some particles.
+  std::vector<vtkm::Vec3f> positions;
+  for (int k = 0; k < 6; ++k)
+  {
+    for (int j = 0; j < 6; ++j)
+    {
+      for (int i = 0; i < 6; ++i)
+      {
+        positions.push_back(vtkm::Vec3f(0.5f * i, 0.5f * j, 0.5f * k));
+      }
+    }
+  }
+  std::vector<vtkm::Id> connectivity(positions.size());
+  for (std::size_t i = 0; i < connectivity.size(); ++i)
+  {
+    connectivity[i] = static_cast<vtkm::Id>(i);
+  }
+  vtkm::cont::DataSet input = vtkm::cont::DataSetBuilderExplicit::Create(
+    positions, vtkm::CellShapeTagVertex{}, 1, connectivity);
+  input.AddPointField("constant",
+                      std::vector<vtkm::Float64>(positions.size(), vtkm::Float64(3.5)));
+
+  vtkm::filter::resampling::SPHInterpolation filter;
+  filter.SetPointDimensions({ 11, 11, 11 });
+  filter.SetBounds({ { 0, 2.5 }, { 0, 2.5 }, { 0, 2.5 } });
+  filter.SetSmoothingLength(0.4f);
+  filter.SetShepardNormalization(true);
+  const vtkm::cont::DataSet output = filter.Execute(input);
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> values;
+  output.GetPointField("constant").GetData().AsArrayHandle(values);
+  auto portal = values.ReadPortal();
+  for (vtkm::Id i = 0; i < portal.GetNumberOfValues(); ++i)
+  {
+    VTKM_TEST_ASSERT(test_equal(portal.Get(i), 3.5), "Constant field not preserved");
+  }
+}
+
+void TestGridBeyondParticles()
+{
+  std::cout << "Testing SPHInterpolation on a grid extending beyond the particles" << std::endl;
+  // Most grid points are many bins away from the particles, on both sides of every axis.
+  const Particles particles = MakeParticles(300, false);
+  const vtkm::Id3 dims(13, 12, 11);
+
+  vtkm::filter::resampling::SPHInterpolation filter;
+  filter.SetPointDimensions(dims);
+  filter.SetBounds({ { -10, 14 }, { -12, 15 }, { -9, 13 } });
+  filter.SetSmoothingLengthField("h");
+  filter.SetMassField("mass");
+  filter.SetDensityField("rho");
+  filter.SetShepardNormalization(true);
+  const vtkm::cont::ArrayHandleUniformPointCoordinates grid(
+    dims, filter.GetOrigin(), filter.GetSpacing());
+
+  const vtkm::cont::DataSet output = filter.Execute(MakeDataSet(particles));
+  CheckField(output,
+             "scalar",
+             Interpolate(vtkm::worklet::splatkernels::Spline3rdOrder<3>(1.0),
+                         particles,
+                         particles.Scalars,
+                         grid,
+                         true));
+}
+
+void TestVaryingSmoothingLengths()
+{
+  std::cout << "Testing SPHInterpolation with smoothing lengths over several levels" << std::endl;
+  // A few particles reach across the whole grid while most have a small support, so the
+  // particles are spread over several bin levels.
+  Particles particles = MakeParticles(500, false);
+  for (std::size_t i = 0; i < particles.SmoothingLengths.size(); ++i)
+  {
+    if (i % 97 == 0)
+    {
+      particles.SmoothingLengths[i] = 3.0f;
+    }
+    else if (i % 3 == 0)
+    {
+      particles.SmoothingLengths[i] *= 0.2f;
+    }
+  }
+  const vtkm::Id3 dims(9, 8, 7);
+
+  for (KernelType kernelType : { KernelType::CubicSpline, KernelType::Gaussian })
+  {
+    vtkm::filter::resampling::SPHInterpolation filter;
+    filter.SetKernel(kernelType);
+    filter.SetPointDimensions(dims);
+    filter.SetBounds({ { -0.5, 4.5 }, { -0.5, 4.5 }, { -0.5, 4.5 } });
+    filter.SetSmoothingLengthField("h");
+    filter.SetMassField("mass");
+    filter.SetDensityField("rho");
+    const vtkm::cont::ArrayHandleUniformPointCoordinates grid(
+      dims, filter.GetOrigin(), filter.GetSpacing());
+
+    const vtkm::cont::DataSet output = filter.Execute(MakeDataSet(particles));
+    if (kernelType == KernelType::Gaussian)
+    {
+      CheckField(output,
+                 "scalar",
+                 Interpolate(vtkm::worklet::splatkernels::Gaussian<3>(1.0),
+                             particles,
+                             particles.Scalars,
+                             grid,
+                             false));
+    }
+    else
+    {
+      CheckField(output,
+                 "scalar",
+                 Interpolate(vtkm::worklet::splatkernels::Spline3rdOrder<3>(1.0),
+                             particles,
+                             particles.Scalars,
+                             grid,
+                             false));
+    }
+  }
+}
+
+void TestSPHInterpolation()
+{
+  TestAgainstBruteForce();
+  TestShepardNormalization();
+  TestGridBeyondParticles();
+  TestVaryingSmoothingLengths();
+}
+
+} // anonymous namespace
+
+int UnitTestSPHInterpolation(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestSPHInterpolation, argc, argv);
+}
@@ -10,9 +10,14 @@
 #ifndef vtk_m_worklet_Probe_h
 #define vtk_m_worklet_Probe_h
 
+#include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayRangeCompute.h>
 #include <vtkm/cont/CellLocatorChooser.h>
+#include <vtkm/cont/CellLocatorGeneral.h>
 #include <vtkm/cont/Invoker.h>
 #include <vtkm/exec/CellInside.h>
 #include <vtkm/exec/CellInterpolate.h>
@@ -51,17 +56,153 @@ public:
     }
   };
 
+  /// Computes the Morton code of each point. The position of the point in the bounds of all
+  /// the points is quantized to 21 bits per axis, and the bits of the axes are interleaved,
+  /// so points that are close in space usually have close codes.
+  class MortonCodeWorklet : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn points, FieldOut codes);
+    using ExecutionSignature = _2(_1);
+
+    VTKM_CONT MortonCodeWorklet(const vtkm::Vec3f_64& origin, const vtkm::Vec3f_64& scale)
+      : Origin(origin)
+      , Scale(scale)
+    {
+    }
+
+    template <typename PointType>
+    VTKM_EXEC vtkm::UInt64 operator()(const PointType& point) const
+    {
+      const vtkm::Vec3f_64 p = static_cast<vtkm::Vec3f_64>(point);
+      const vtkm::Float64 maxCell = MaxCell;
+      vtkm::UInt64 code = 0;
+      for (vtkm::IdComponent d = 0; d < 3; ++d)
+      {
+        const vtkm::Float64 x = (p[d] - this->Origin[d]) * this->Scale[d];
+        code |= SpreadBits(static_cast<vtkm::UInt64>(vtkm::Min(vtkm::Max(x, 0.0), maxCell))) << d;
+      }
+      return code;
+    }
+
+    static constexpr vtkm::Float64 MaxCell = 2097151.0; // 2^21 - 1
+
+  private:
+    // Insert two zero bits between each of the lower 21 bits of x.
+    VTKM_EXEC static vtkm::UInt64 SpreadBits(vtkm::UInt64 x)
+    {
+      x &= 0x1fffff;
+      x = (x | x << 32) & 0x1f00000000ffff;
+      x = (x | x << 16) & 0x1f0000ff0000ff;
+      x = (x | x << 8) & 0x100f00f00f00f00f;
+      x = (x | x << 4) & 0x10c30c30c30c30c3;
+      x = (x | x << 2) & 0x1249249249249249;
+      return x;
+    }
+
+    vtkm::Vec3f_64 Origin;
+    vtkm::Vec3f_64 Scale;
+  };
+
+  /// Finds the cells containing a batch of consecutive points in Morton order. Consecutive
+  /// points are usually in the same or in neighboring cells, so the locator is given the cell
+  /// of the previous point to check first. The results are written at the original index of
+  /// each point.
+  class FindCellBatchWorklet : public vtkm::worklet::WorkletMapField
+  {
+  public:
+    using ControlSignature = void(FieldIn batchStart,
+                                  WholeArrayIn sortedPointIds,
+                                  WholeArrayIn points,
+                                  ExecObject locator,
+                                  WholeArrayOut cellIds,
+                                  WholeArrayOut pcoords);
+    using ExecutionSignature = void(_1, _2, _3, _4, _5, _6);
+
+    static constexpr vtkm::Id BatchSize = 16;
+
+    template <typename IdPortalType,
+              typename PointPortalType,
+              typename LocatorType,
+              typename CellIdPortalType,
+              typename PCoordsPortalType>
+    VTKM_EXEC void operator()(vtkm::Id batchStart,
+                              const IdPortalType& sortedPointIds,
+                              const PointPortalType& points,
+                              const LocatorType& locator,
+                              const CellIdPortalType& cellIds,
+                              const PCoordsPortalType& pcoords) const
+    {
+      typename LocatorType::LastCell lastCell;
+      const vtkm::Id batchEnd =
+        vtkm::Min(batchStart + BatchSize, sortedPointIds.GetNumberOfValues());
+      for (vtkm::Id i = batchStart; i < batchEnd; ++i)
+      {
+        const vtkm::Id pointId = sortedPointIds.Get(i);
+        const vtkm::Vec3f point = static_cast<vtkm::Vec3f>(points.Get(pointId));
+        vtkm::Id cellId = -1;
+        vtkm::Vec3f pc;
+        if (locator.FindCell(point, cellId, pc, lastCell) != vtkm::ErrorCode::Success)
+        {
+          cellId = -1;
+        }
+        cellIds.Set(pointId, cellId);
+        pcoords.Set(pointId, pc);
+      }
+    }
+  };
+
 private:
   struct RunSelectLocator
   {
     template <typename LocatorType, typename PointsType>
     void operator()(const LocatorType& locator, Probe& worklet, const PointsType& points) const
     {
-      worklet.Invoke(
-        FindCellWorklet{}, points, locator, worklet.CellIds, worklet.ParametricCoordinates);
+      worklet.FindCells(locator, points);
     }
   };
 
+  template <typename LocatorType, typename PointsType, typename PointsStorage>
+  void FindCells(const LocatorType& locator,
+                 const vtkm::cont::ArrayHandle<PointsType, PointsStorage>& points)
+  {
+    const vtkm::Id numPoints = points.GetNumberOfValues();
+    this->CellIds.Allocate(numPoints);
+    this->ParametricCoordinates.Allocate(numPoints);
+    if (numPoints == 0)
+    {
+      return;
+    }
+
+    // Look the points up in Morton order so that consecutive lookups touch nearby cells.
+    vtkm::cont::ArrayHandle<vtkm::Range> ranges = vtkm::cont::ArrayRangeCompute(points);
+    auto rangePortal = ranges.ReadPortal();
+    vtkm::Vec3f_64 origin;
+    vtkm::Vec3f_64 scale;
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      const vtkm::Range range =
+        d < rangePortal.GetNumberOfValues() ? rangePortal.Get(d) : vtkm::Range(0, 0);
+      origin[d] = range.Min;
+      scale[d] = range.Length() > 0 ? MortonCodeWorklet::MaxCell / range.Length() : 0.0;
+    }
+    vtkm::cont::ArrayHandle<vtkm::UInt64> codes;
+    this->Invoke(MortonCodeWorklet(origin, scale), points, codes);
+    vtkm::cont::ArrayHandle<vtkm::Id> sortedPointIds;
+    vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(numPoints), sortedPointIds);
+    vtkm::cont::Algorithm::SortByKey(codes, sortedPointIds);
+
+    constexpr vtkm::Id batchSize = FindCellBatchWorklet::BatchSize;
+    this->Invoke(FindCellBatchWorklet{},
+                 vtkm::cont::ArrayHandleCounting<vtkm::Id>(
+                   0, batchSize, (numPoints + batchSize - 1) / batchSize),
+                 sortedPointIds,
+                 points,
+                 locator,
+                 this->CellIds,
+                 this->ParametricCoordinates);
+  }
+
   template <typename CellSetType, typename PointsType, typename PointsStorage>
   void RunImpl(const CellSetType& cells,
                const vtkm::cont::CoordinateSystem& coords,
@@ -72,6 +213,14 @@ private:
     vtkm::cont::CastAndCallCellLocatorChooser(cells, coords, RunSelectLocator{}, *this, points);
   }
 
+  template <typename PointsType, typename PointsStorage>
+  void RunImpl(const vtkm::cont::CellLocatorGeneral& locator,
+               const vtkm::cont::ArrayHandle<PointsType, PointsStorage>& points)
+  {
+    this->InputCellSet = locator.GetCellSet();
+    this->FindCells(locator, points);
+  }
+
   //============================================================================
 public:
   class ProbeUniformPoints : public vtkm::worklet::WorkletVisitCellsWithPoints
@@ -156,6 +305,13 @@ private:
       ProbeUniformPoints{}, cells, coords, points, this->CellIds, this->ParametricCoordinates);
   }
 
+  // Points on a uniform grid do not need the locator.
+  void RunImpl(const vtkm::cont::CellLocatorGeneral& locator,
+               const vtkm::cont::ArrayHandleUniformPointCoordinates::Superclass& points)
+  {
+    this->RunImpl(locator.GetCellSet(), locator.GetCoordinates(), points);
+  }
+
   //============================================================================
   struct RunImplCaller
   {
@@ -167,6 +323,14 @@ private:
     {
       worklet.RunImpl(cells, coords, points);
     }
+
+    template <typename PointsArrayType>
+    void operator()(const PointsArrayType& points,
+                    Probe& worklet,
+                    const vtkm::cont::CellLocatorGeneral& locator) const
+    {
+      worklet.RunImpl(locator, points);
+    }
   };
 
 public:
@@ -178,6 +342,15 @@ public:
     vtkm::cont::CastAndCall(points, RunImplCaller(), *this, cells, coords);
   }
 
+  /// Find the cells of the input containing the points with a locator of the input. The
+  /// locator is only built when it is needed and is out of date, so a locator can be
+  /// reused to probe the same input at several sets of points.
+  template <typename PointsArrayType>
+  void Run(const vtkm::cont::CellLocatorGeneral& locator, const PointsArrayType& points)
+  {
+    vtkm::cont::CastAndCall(points, RunImplCaller(), *this, locator);
+  }
+
   //============================================================================
   template <typename T>
   class InterpolatePointField : public vtkm::worklet::WorkletMapField
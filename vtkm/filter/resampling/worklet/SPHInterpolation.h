@@ -0,0 +1,442 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_worklet_SPHInterpolation_h
+#define vtk_m_worklet_SPHInterpolation_h
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayGetValues.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/Invoker.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <vtkm/VecTraits.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace sph
+{
+// Particles are binned separately by the size of their kernel support, so that a few
+// particles with a large smoothing length do not widen the bins of all the others. The
+// support of the particles of level l is in (R / 2^(l+1), R / 2^l], R being the largest
+// support, except for the last level, which holds all the smaller ones.
+constexpr vtkm::IdComponent MaxBinLevels = 8;
+
+// The grid of bins of one level. The bins are at least as wide as the largest kernel
+// support of the level. A level without particles has no bins.
+struct BinLevel
+{
+  vtkm::Vec3f_64 InverseBinSize = vtkm::Vec3f_64(1.0);
+  vtkm::Id3 Dims = vtkm::Id3(0, 0, 0);
+  vtkm::Id FirstBin = 0;
+  vtkm::Float64 MaxRadius = 0.0;
+};
+
+using BinLevels = vtkm::Vec<BinLevel, MaxBinLevels>;
+
+// Find the level of the kernel support of each particle.
+class ComputeLevel : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn smoothingLength, FieldOut level);
+  using ExecutionSignature = _2(_1);
+
+  VTKM_CONT ComputeLevel(vtkm::Float64 dilationFactor, vtkm::Float64 maxRadius)
+    : DilationFactor(dilationFactor)
+    , MaxRadius(maxRadius)
+  {
+  }
+
+  VTKM_EXEC vtkm::IdComponent operator()(vtkm::FloatDefault smoothingLength) const
+  {
+    const vtkm::Float64 radius =
+      this->DilationFactor * static_cast<vtkm::Float64>(smoothingLength);
+    if (!(radius > 0.0))
+    {
+      return MaxBinLevels - 1;
+    }
+    const vtkm::Float64 level = vtkm::Floor(vtkm::Log2(this->MaxRadius / radius));
+    return static_cast<vtkm::IdComponent>(
+      vtkm::Min(vtkm::Max(level, 0.0), static_cast<vtkm::Float64>(MaxBinLevels - 1)));
+  }
+
+private:
+  vtkm::Float64 DilationFactor;
+  vtkm::Float64 MaxRadius;
+};
+
+// Find the bin of each particle in the grid of bins of its level.
+class ComputeBin : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn point, FieldIn level, FieldOut binId);
+  using ExecutionSignature = _3(_1, _2);
+
+  VTKM_CONT ComputeBin(const vtkm::Vec3f_64& origin, const BinLevels& levels)
+    : Origin(origin)
+    , Levels(levels)
+  {
+  }
+
+  template <typename PointType>
+  VTKM_EXEC vtkm::Id operator()(const PointType& point, vtkm::IdComponent level) const
+  {
+    const BinLevel& bins = this->Levels[level];
+    vtkm::Id3 ijk;
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      const vtkm::Float64 x =
+        (static_cast<vtkm::Float64>(point[d]) - this->Origin[d]) * bins.InverseBinSize[d];
+      ijk[d] = vtkm::Min(vtkm::Max(static_cast<vtkm::Id>(x), vtkm::Id(0)), bins.Dims[d] - 1);
+    }
+    return bins.FirstBin + ijk[0] + bins.Dims[0] * (ijk[1] + bins.Dims[1] * ijk[2]);
+  }
+
+private:
+  vtkm::Vec3f_64 Origin;
+  BinLevels Levels;
+};
+
+// Sum the kernel weighted values of the particles around each grid point. On each level,
+// the bins are at least as wide as the largest kernel support of the level, so only the
+// bins that overlap the support around the grid point, at most 3 along each axis, are
+// searched. Each grid point only writes its own value, so no atomics are needed.
+template <typename KernelType>
+class Gather : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn gridPoint,
+                                WholeArrayIn binStarts,
+                                WholeArrayIn sortedPoints,
+                                WholeArrayIn sortedSmoothingLengths,
+                                WholeArrayIn sortedVolumes,
+                                WholeArrayIn sortedParticleIds,
+                                WholeArrayIn field,
+                                FieldOut result);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7, _8);
+
+  VTKM_CONT Gather(const KernelType& kernel,
+                   bool normalize,
+                   const vtkm::Vec3f_64& origin,
+                   const BinLevels& levels)
+    : Kernel(kernel)
+    , Normalize(normalize)
+    , Origin(origin)
+    , Levels(levels)
+  {
+  }
+
+  template <typename GridPointType,
+            typename StartPortalType,
+            typename PointPortalType,
+            typename ScalarPortalType,
+            typename IdPortalType,
+            typename FieldPortalType,
+            typename OutType>
+  VTKM_EXEC void operator()(const GridPointType& gridPoint,
+                            const StartPortalType& binStarts,
+                            const PointPortalType& sortedPoints,
+                            const ScalarPortalType& sortedSmoothingLengths,
+                            const ScalarPortalType& sortedVolumes,
+                            const IdPortalType& sortedParticleIds,
+                            const FieldPortalType& field,
+                            OutType& result) const
+  {
+    using OutTraits = vtkm::VecTraits<OutType>;
+    using OutComponentType = typename OutTraits::ComponentType;
+    using InTraits = vtkm::VecTraits<typename FieldPortalType::ValueType>;
+
+    const vtkm::Vec3f_64 x(static_cast<vtkm::Float64>(gridPoint[0]),
+                           static_cast<vtkm::Float64>(gridPoint[1]),
+                           static_cast<vtkm::Float64>(gridPoint[2]));
+
+    // The range of bins of each level around the grid point. A level is skipped when the
+    // grid point is out of reach of all its particles.
+    vtkm::Vec<vtkm::Id3, MaxBinLevels> first;
+    vtkm::Vec<vtkm::Id3, MaxBinLevels> last;
+    vtkm::Vec<bool, MaxBinLevels> inReach;
+    for (vtkm::IdComponent level = 0; level < MaxBinLevels; ++level)
+    {
+      const BinLevel& bins = this->Levels[level];
+      inReach[level] = bins.Dims[0] > 0;
+      for (vtkm::IdComponent d = 0; inReach[level] && (d < 3); ++d)
+      {
+        const vtkm::Float64 low =
+          (x[d] - bins.MaxRadius - this->Origin[d]) * bins.InverseBinSize[d];
+        const vtkm::Float64 high =
+          (x[d] + bins.MaxRadius - this->Origin[d]) * bins.InverseBinSize[d];
+        first[level][d] = vtkm::Max(static_cast<vtkm::Id>(vtkm::Floor(low)), vtkm::Id(0));
+        last[level][d] = vtkm::Min(static_cast<vtkm::Id>(vtkm::Floor(high)), bins.Dims[d] - 1);
+        inReach[level] = first[level][d] <= last[level][d];
+      }
+    }
+
+    // Accumulate up to ChunkSize components at a time in double precision so that the
+    // kernel weights are computed once for most fields.
+    constexpr vtkm::IdComponent ChunkSize = 4;
+    const vtkm::IdComponent numComponents = OutTraits::GetNumberOfComponents(result);
+    for (vtkm::IdComponent chunk = 0; chunk < numComponents; chunk += ChunkSize)
+    {
+      const vtkm::IdComponent chunkComponents = vtkm::Min(ChunkSize, numComponents - chunk);
+      vtkm::Vec<vtkm::Float64, ChunkSize> sum(0.0);
+      vtkm::Float64 weightSum = 0.0;
+
+      for (vtkm::IdComponent level = 0; level < MaxBinLevels; ++level)
+      {
+        if (!inReach[level])
+        {
+          continue;
+        }
+        const BinLevel& bins = this->Levels[level];
+        for (vtkm::Id k = first[level][2]; k <= last[level][2]; ++k)
+        {
+          for (vtkm::Id j = first[level][1]; j <= last[level][1]; ++j)
+          {
+            // The bins of a row along x are one contiguous range of particles.
+            const vtkm::Id rowBin = bins.FirstBin + bins.Dims[0] * (j + bins.Dims[1] * k);
+            const vtkm::Id begin = binStarts.Get(rowBin + first[level][0]);
+            const vtkm::Id end = binStarts.Get(rowBin + last[level][0] + 1);
+            for (vtkm::Id p = begin; p < end; ++p)
+            {
+              const auto point = sortedPoints.Get(p);
+              vtkm::Float64 distance2 = 0.0;
+              for (vtkm::IdComponent d = 0; d < 3; ++d)
+              {
+                const vtkm::Float64 delta = static_cast<vtkm::Float64>(point[d]) - x[d];
+                distance2 += delta * delta;
+              }
+              const vtkm::Float64 h = static_cast<vtkm::Float64>(sortedSmoothingLengths.Get(p));
+              if (distance2 >= this->Kernel.maxSquaredDistance(h))
+              {
+                continue;
+              }
+
+              const vtkm::Float64 weight =
+                static_cast<vtkm::Float64>(sortedVolumes.Get(p)) * this->Kernel.w2(h, distance2);
+              weightSum += weight;
+              const auto value = field.Get(sortedParticleIds.Get(p));
+              for (vtkm::IdComponent c = 0; c < chunkComponents; ++c)
+              {
+                sum[c] +=
+                  weight * static_cast<vtkm::Float64>(InTraits::GetComponent(value, chunk + c));
+              }
+            }
+          }
+        }
+      }
+
+      const vtkm::Float64 scale = (this->Normalize && weightSum > 0.0) ? 1.0 / weightSum : 1.0;
+      for (vtkm::IdComponent c = 0; c < chunkComponents; ++c)
+      {
+        OutTraits::SetComponent(result, chunk + c, static_cast<OutComponentType>(sum[c] * scale));
+      }
+    }
+  }
+
+private:
+  KernelType Kernel;
+  bool Normalize;
+  vtkm::Vec3f_64 Origin;
+  BinLevels Levels;
+};
+} // namespace sph
+
+/// Interpolates particle fields to grid points with the smoothed particle hydrodynamics
+/// (SPH) estimate
+///
+///   A(x) = sum_j V_j A_j W(|x - x_j|, h_j)
+///
+/// where V_j is the volume (mass over density) of particle j, h_j its smoothing length and
+/// W one of the kernels of `vtkm/worklet/splatkernels`.
+///
+/// `Run` sorts the particles into grids of bins at least as wide as the kernel supports,
+/// with a separate grid for each power of two of the kernel support (see
+/// `sph::MaxBinLevels`). `Interpolate` then gathers the contributions of the particles in
+/// the bins around each grid point, so each grid point is computed independently and
+/// without atomics.
+class SPHInterpolation
+{
+public:
+  template <typename PointArrayType>
+  void Run(const PointArrayType& points,
+           const vtkm::cont::ArrayHandle<vtkm::FloatDefault>& smoothingLengths,
+           const vtkm::cont::ArrayHandle<vtkm::FloatDefault>& volumes,
+           vtkm::Float64 dilationFactor)
+  {
+    VTKM_IS_ARRAY_HANDLE(PointArrayType);
+    using PointType = typename PointArrayType::ValueType;
+    using Algorithm = vtkm::cont::Algorithm;
+
+    const vtkm::Id numPoints = points.GetNumberOfValues();
+    this->Origin = vtkm::Vec3f_64(0.0);
+    this->Levels = sph::BinLevels{};
+    if (numPoints == 0)
+    {
+      this->BinStarts.AllocateAndFill(1, 0);
+      this->SortedPoints.Allocate(0);
+      this->SortedSmoothingLengths.Allocate(0);
+      this->SortedVolumes.Allocate(0);
+      this->SortedParticleIds.Allocate(0);
+      return;
+    }
+
+    const PointType firstPoint = vtkm::cont::ArrayGetValue(0, points);
+    const vtkm::Vec<PointType, 2> range = Algorithm::Reduce(
+      points, vtkm::Vec<PointType, 2>(firstPoint, firstPoint), vtkm::MinAndMax<PointType>());
+    vtkm::Vec3f_64 extent;
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      this->Origin[d] = static_cast<vtkm::Float64>(range[0][d]);
+      extent[d] = static_cast<vtkm::Float64>(range[1][d]) - this->Origin[d];
+    }
+
+    // Count the particles and find the largest kernel support of each level.
+    const vtkm::Float64 maxRadius = dilationFactor *
+      static_cast<vtkm::Float64>(Algorithm::Reduce(
+        smoothingLengths, vtkm::FloatDefault(0), vtkm::Maximum()));
+    vtkm::cont::Invoker invoke;
+    vtkm::cont::ArrayHandle<vtkm::IdComponent> particleLevels;
+    invoke(sph::ComputeLevel(dilationFactor, maxRadius), smoothingLengths, particleLevels);
+    {
+      vtkm::cont::ArrayHandle<vtkm::IdComponent> sortedLevels;
+      vtkm::cont::ArrayHandle<vtkm::FloatDefault> levelSmoothingLengths;
+      vtkm::cont::ArrayCopy(particleLevels, sortedLevels);
+      vtkm::cont::ArrayCopy(smoothingLengths, levelSmoothingLengths);
+      Algorithm::SortByKey(sortedLevels, levelSmoothingLengths);
+
+      vtkm::cont::ArrayHandle<vtkm::IdComponent> levelIds;
+      vtkm::cont::ArrayHandle<vtkm::Id> levelCounts;
+      vtkm::cont::ArrayHandle<vtkm::FloatDefault> levelMaxSmoothingLengths;
+      Algorithm::ReduceByKey(sortedLevels,
+                             vtkm::cont::make_ArrayHandleConstant(vtkm::Id(1), numPoints),
+                             levelIds,
+                             levelCounts,
+                             vtkm::Add());
+      Algorithm::ReduceByKey(sortedLevels,
+                             levelSmoothingLengths,
+                             levelIds,
+                             levelMaxSmoothingLengths,
+                             vtkm::Maximum());
+
+      auto idPortal = levelIds.ReadPortal();
+      auto countPortal = levelCounts.ReadPortal();
+      auto smoothingLengthPortal = levelMaxSmoothingLengths.ReadPortal();
+      vtkm::Id numBins = 0;
+      for (vtkm::Id i = 0; i < idPortal.GetNumberOfValues(); ++i)
+      {
+        sph::BinLevel& bins = this->Levels[idPortal.Get(i)];
+        bins.MaxRadius =
+          dilationFactor * static_cast<vtkm::Float64>(smoothingLengthPortal.Get(i));
+        bins.FirstBin = numBins;
+        numBins += MakeBins(extent, countPortal.Get(i), bins);
+      }
+      this->BinStarts.Allocate(numBins + 1);
+    }
+
+    vtkm::cont::ArrayHandle<vtkm::Id> binIds;
+    invoke(sph::ComputeBin(this->Origin, this->Levels), points, particleLevels, binIds);
+    particleLevels.ReleaseResources();
+
+    const vtkm::Id numBins = this->BinStarts.GetNumberOfValues() - 1;
+    vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(numPoints), this->SortedParticleIds);
+    Algorithm::SortByKey(binIds, this->SortedParticleIds);
+    Algorithm::LowerBounds(
+      binIds, vtkm::cont::ArrayHandleCounting<vtkm::Id>(0, 1, numBins + 1), this->BinStarts);
+
+    // Gather the particles in bin order so that the particles of a bin are close in memory.
+    vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandlePermutation(this->SortedParticleIds, points),
+                          this->SortedPoints);
+    vtkm::cont::ArrayCopy(
+      vtkm::cont::make_ArrayHandlePermutation(this->SortedParticleIds, smoothingLengths),
+      this->SortedSmoothingLengths);
+    vtkm::cont::ArrayCopy(vtkm::cont::make_ArrayHandlePermutation(this->SortedParticleIds, volumes),
+                          this->SortedVolumes);
+  }
+
+  /// Interpolates `field`, which has a value for each particle, at `gridPoints`. When
+  /// `normalize` is true, the sum is divided by the sum of V_j W(|x - x_j|, h_j) (Shepard
+  /// normalization).
+  template <typename KernelType,
+            typename GridPointArrayType,
+            typename FieldArrayType,
+            typename ResultArrayType>
+  void Interpolate(const KernelType& kernel,
+                   bool normalize,
+                   const GridPointArrayType& gridPoints,
+                   const FieldArrayType& field,
+                   ResultArrayType& result) const
+  {
+    vtkm::cont::Invoker invoke;
+    invoke(sph::Gather<KernelType>(kernel, normalize, this->Origin, this->Levels),
+           gridPoints,
+           this->BinStarts,
+           this->SortedPoints,
+           this->SortedSmoothingLengths,
+           this->SortedVolumes,
+           this->SortedParticleIds,
+           field,
+           result);
+  }
+
+private:
+  // Sets up the bins of a level holding numParticles particles over the given extent, and
+  // returns their number. The bins are at least as wide as the largest kernel support of
+  // the level, and are widened further when there would be many more bins than particles.
+  static vtkm::Id MakeBins(const vtkm::Vec3f_64& extent, vtkm::Id numParticles, sph::BinLevel& bins)
+  {
+    vtkm::Float64 binWidth = bins.MaxRadius;
+    if (!(binWidth > 0.0))
+    {
+      binWidth = vtkm::Max(vtkm::Max(extent[0], extent[1]), vtkm::Max(extent[2], 1e-30));
+    }
+    constexpr vtkm::Id maxBinsPerAxis = 1048576;
+    for (;;)
+    {
+      for (vtkm::IdComponent d = 0; d < 3; ++d)
+      {
+        bins.Dims[d] = vtkm::Max(
+          vtkm::Min(static_cast<vtkm::Id>(extent[d] / binWidth), maxBinsPerAxis), vtkm::Id(1));
+      }
+      if (bins.Dims[0] * bins.Dims[1] * bins.Dims[2] <= numParticles)
+      {
+        break;
+      }
+      binWidth *= 1.5;
+    }
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      // Stretch the bins to cover the particles. They only get wider, so the search stays
+      // within 3 bins along each axis.
+      bins.InverseBinSize[d] =
+        1.0 / vtkm::Max(binWidth, extent[d] / static_cast<vtkm::Float64>(bins.Dims[d]));
+    }
+    return bins.Dims[0] * bins.Dims[1] * bins.Dims[2];
+  }
+
+  vtkm::Vec3f_64 Origin;
+  sph::BinLevels Levels;
+
+  vtkm::cont::ArrayHandle<vtkm::Id> BinStarts;
+  vtkm::cont::ArrayHandle<vtkm::Vec3f> SortedPoints;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> SortedSmoothingLengths;
+  vtkm::cont::ArrayHandle<vtkm::FloatDefault> SortedVolumes;
+  vtkm::cont::ArrayHandle<vtkm::Id> SortedParticleIds;
+};
+}
+} // vtkm::worklet
+
+#endif // vtk_m_worklet_SPHInterpolation_h
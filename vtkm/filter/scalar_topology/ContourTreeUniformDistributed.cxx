@@ -51,8 +51,12 @@
 //==============================================================================
 
 // vtkm includes
+#include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/cont/ErrorFilterExecution.h>
+#include <vtkm/cont/PartitionedDataSet.h>
+#include <vtkm/cont/RuntimeDeviceTracker.h>
+#include <vtkm/cont/ThreadPool.h>
 #include <vtkm/cont/Timer.h>
 
 // single-node augmented contour tree includes
@@ -83,6 +87,10 @@ VTKM_THIRDPARTY_PRE_INCLUDE
 VTKM_THIRDPARTY_POST_INCLUDE
 // clang-format on
 
+#include <memory>
+#include <numeric>
+#include <thread>
+
 namespace vtkm
 {
 namespace filter
@@ -95,6 +103,46 @@ namespace scalar_topology
 //-----------------------------------------------------------------------------
 namespace contourtree_distributed_detail
 {
+/// Helper function that calls `functor(blockNo)` for each local data block using up to
+/// `numberOfThreads` threads of `vtkm::cont::GetThreadPool()`. The blocks are handed out
+/// one at a time, so a thread that finishes a small block moves on to the next one.
+template <typename Functor>
+void ForEachLocalBlock(vtkm::Id numberOfBlocks, vtkm::Id numberOfThreads, const Functor& functor)
+{
+  numberOfThreads = std::min(numberOfThreads, numberOfBlocks);
+  if (numberOfThreads <= 1)
+  {
+    for (vtkm::Id blockNo = 0; blockNo < numberOfBlocks; ++blockNo)
+    {
+      functor(blockNo);
+    }
+    return;
+  }
+
+  std::vector<vtkm::Id> blockOrder(static_cast<std::size_t>(numberOfBlocks));
+  std::iota(blockOrder.begin(), blockOrder.end(), vtkm::Id{ 0 });
+
+  auto& callerTracker = vtkm::cont::GetRuntimeDeviceTracker();
+  vtkm::cont::ScopedRuntimeDeviceTracker callerScope(callerTracker);
+  callerTracker.SetThreadFriendlyMemAlloc(true);
+  const std::thread::id callerThread = std::this_thread::get_id();
+
+  auto processBlock = [&](vtkm::Id blockNo) {
+    // Worker threads have their own device tracker, so give it the state of the caller's.
+    std::unique_ptr<vtkm::cont::ScopedRuntimeDeviceTracker> workerScope;
+    if (std::this_thread::get_id() != callerThread)
+    {
+      auto& workerTracker = vtkm::cont::GetRuntimeDeviceTracker();
+      workerScope.reset(new vtkm::cont::ScopedRuntimeDeviceTracker(workerTracker));
+      workerTracker.CopyStateFrom(callerTracker);
+    }
+
+    functor(blockNo);
+    vtkm::cont::Algorithm::Synchronize();
+  };
+  vtkm::cont::GetThreadPool().Execute(blockOrder, processBlock, numberOfThreads);
+}
+
 /// Helper function for saving the content of the tree for debugging
 template <typename FieldType>
 void SaveAfterFanInResults(
@@ -242,11 +290,13 @@ void ContourTreeUniformDistributed::ComputeLocalTreeImpl(
   // Set up the worklet
   vtkm::worklet::ContourTreeAugmented worklet;
   worklet.TimingsLogLevel = vtkm::cont::LogLevel::Off; // turn of the loggin, we do this afterwards
+  // Local to the block since blocks may be computed concurrently
+  vtkm::Id numIterations;
   worklet.Run(field,
               mesh,
               this->LocalContourTrees[static_cast<std::size_t>(blockIndex)],
               this->LocalMeshes[static_cast<std::size_t>(blockIndex)].SortOrder,
-              this->NumIterations,
+              numIterations,
               compRegularStruct,
               meshBoundaryExecObject);
   // Log the contour tree timiing stats
@@ -255,6 +305,7 @@ void ContourTreeUniformDistributed::ComputeLocalTreeImpl(
                << "    ---------------- Contour Tree Worklet Timings ------------------"
                << std::endl
                << "    Block Index : " << blockIndex << std::endl
+               << "    Number of Iterations : " << numIterations << std::endl
                << worklet.TimingsLogString);
   VTKM_LOG_S(this->TimingsLogLevel,
              std::endl
@@ -500,22 +551,29 @@ vtkm::cont::PartitionedDataSet ContourTreeUniformDistributed::DoExecutePartition
   vtkm::cont::Timer timer;
   timer.Start();
 
+  this->PhaseTimings.clear();
   this->PreExecute(input);
 
-  // Compute the local contour tree, boundary tree, and interior forest for each local data block
-  for (vtkm::Id blockNo = 0; blockNo < input.GetNumberOfPartitions(); ++blockNo)
-  {
-    const auto& dataset = input.GetPartition(blockNo);
-    const auto& field =
-      dataset.GetField(this->GetActiveFieldName(), this->GetActiveFieldAssociation());
-    if (!field.IsPointField())
-    {
-      throw vtkm::cont::ErrorFilterExecution("Point field expected.");
-    }
+  // Compute the local contour tree, boundary tree, and interior forest for each local data block.
+  // Each block writes only to its own entries of the Local* vectors, so the blocks can be
+  // processed concurrently.
+  contourtree_distributed_detail::ForEachLocalBlock(
+    input.GetNumberOfPartitions(), this->NumberOfLocalBlockThreads, [&](vtkm::Id blockNo) {
+      const auto& dataset = input.GetPartition(blockNo);
+      const auto field = this->GetBlockField(input, blockNo);
+      if (!field.IsPointField())
+      {
+        throw vtkm::cont::ErrorFilterExecution("Point field expected.");
+      }
+      if (blockNo == 0)
+      {
+        this->FieldValueTypeArray = field.GetData().NewInstanceBasic();
+      }
 
-    this->CastAndCallScalarField(
-      field, [&](const auto concrete) { this->ComputeLocalTree(blockNo, dataset, concrete); });
-  }
+      this->CastAndCallScalarField(
+        field, [&](const auto concrete) { this->ComputeLocalTree(blockNo, dataset, concrete); });
+    });
+  this->PhaseTimings.emplace_back("ComputeLocalTrees", timer.GetElapsedTime());
 
   // Log sizes of the local contour trees, boundary trees, and interior forests
   for (size_t bi = 0; bi < this->LocalContourTrees.size(); bi++)
@@ -556,6 +614,20 @@ vtkm::cont::PartitionedDataSet ContourTreeUniformDistributed::DoExecutePartition
   return result;
 }
 
+//-----------------------------------------------------------------------------
+VTKM_CONT vtkm::cont::Field ContourTreeUniformDistributed::GetBlockField(
+  const vtkm::cont::PartitionedDataSet& input,
+  vtkm::Id blockNo) const
+{
+  if (this->BlockLoader)
+  {
+    vtkm::cont::DataSet block = this->BlockLoader(blockNo);
+    return block.GetField(this->GetActiveFieldName(), this->GetActiveFieldAssociation());
+  }
+  return input.GetPartition(blockNo).GetField(this->GetActiveFieldName(),
+                                              this->GetActiveFieldAssociation());
+}
+
 //-----------------------------------------------------------------------------
 VTKM_CONT void ContourTreeUniformDistributed::PostExecute(
   const vtkm::cont::PartitionedDataSet& input,
@@ -564,14 +636,13 @@ VTKM_CONT void ContourTreeUniformDistributed::PostExecute(
   vtkm::cont::Timer timer;
   timer.Start();
 
-  auto field = // TODO/FIXME: Correct for more than one block per rank?
-    input.GetPartition(0).GetField(this->GetActiveFieldName(), this->GetActiveFieldAssociation());
-
+  // Only the value type of the field is needed here. It was recorded when the local trees
+  // were computed, so no block has to be loaded again.
   auto PostExecuteCaller = [&](const auto& concrete) {
     using T = typename std::decay_t<decltype(concrete)>::ValueType;
     this->DoPostExecute<T>(input, result);
   };
-  this->CastAndCallScalarField(field, PostExecuteCaller);
+  this->CastAndCallScalarField(this->FieldValueTypeArray, PostExecuteCaller);
 
   VTKM_LOG_S(this->TimingsLogLevel,
              std::endl
@@ -877,6 +948,9 @@ VTKM_CONT void ContourTreeUniformDistributed::DoPostExecute(
   vtkm::cont::Timer timer;
   timer.Start();
   std::stringstream timingsStream;
+  // Timer for the coarse per-phase timings reported via GetPhaseTimings()
+  vtkm::cont::Timer phaseTimer;
+  phaseTimer.Start();
 
   auto comm = vtkm::cont::EnvironmentTracker::GetCommunicator();
   vtkm::Id size = comm.size();
@@ -991,8 +1065,7 @@ VTKM_CONT void ContourTreeUniformDistributed::DoPostExecute(
     vtkm::cont::Algorithm::Copy(transformedIndex, localGlobalMeshIndex);
 
     // ... get data values
-    auto currField =
-      currBlock.GetField(this->GetActiveFieldName(), this->GetActiveFieldAssociation());
+    auto currField = this->GetBlockField(input, bi);
     vtkm::cont::ArrayHandle<FieldType> fieldData;
     vtkm::cont::ArrayCopy(currField.GetData(), fieldData);
 
@@ -1003,6 +1076,12 @@ VTKM_CONT void ContourTreeUniformDistributed::DoPostExecute(
                                              fieldData,
                                              localGlobalMeshIndex);
 
+    // The block now owns the local contour tree and interior forest, and the boundary tree
+    // is no longer needed, so drop the references held by the filter
+    this->LocalContourTrees[bi] = vtkm::worklet::contourtree_augmented::ContourTree{};
+    this->LocalInteriorForests[bi] = vtkm::worklet::contourtree_distributed::InteriorForest{};
+    this->LocalBoundaryTrees[bi] = vtkm::worklet::contourtree_distributed::BoundaryTree{};
+
     // NOTE: Use dummy link to make DIY happy. The dummy link is never used, since all
     //       communication is via RegularDecomposer, which sets up its own links. No need
     //       to keep the pointer, as DIY will "own" it and delete it when no longer needed.
@@ -1113,10 +1192,18 @@ VTKM_CONT void ContourTreeUniformDistributed::DoPostExecute(
   timingsStream << "    " << std::setw(38) << std::left << "Post Fan In Barrier"
                 << ": " << timer.GetElapsedTime() << " seconds" << std::endl;
   timer.Start();
+  this->PhaseTimings.emplace_back("FanIn", phaseTimer.GetElapsedTime());
+  phaseTimer.Start();
 
   // ******** 2. Fan out to update all the tree ********
-  master.foreach ([&](DistributedContourTreeBlockData* blockData,
-                      const vtkmdiy::Master::ProxyWithLink&) {
+  // The fan out of each block only touches the data of that block, so the local blocks
+  // are grafted concurrently
+  std::vector<DistributedContourTreeBlockData*> localBlocks;
+  master.foreach (
+    [&](DistributedContourTreeBlockData* blockData, const vtkmdiy::Master::ProxyWithLink&) {
+      localBlocks.push_back(blockData);
+    });
+  auto fanOutBlock = [&](DistributedContourTreeBlockData* blockData) {
 #ifdef DEBUG_PRINT_CTUD
     // Save the contour tree, contour tree meshes, and interior forest data for debugging
     vtkm::filter::contourtree_distributed_detail::SaveAfterFanInResults(
@@ -1175,24 +1262,27 @@ VTKM_CONT void ContourTreeUniformDistributed::DoPostExecute(
                 blockData->ContourTrees[0],
                 &(blockData->InteriorForests[0]));
     vtkm::cont::DataSet currBlock = input.GetPartition(blockData->LocalBlockNo);
-    auto currField =
-      currBlock.GetField(this->GetActiveFieldName(), this->GetActiveFieldAssociation());
+    auto currField = this->GetBlockField(input, blockData->LocalBlockNo);
     vtkm::cont::ArrayHandle<FieldType> fieldData;
     vtkm::cont::ArrayCopy(currField.GetData(), fieldData);
 
-    vtkm::Id3 pointDimensions, globalPointIndexStart;
-    // globalPointDimensions already defined in parent scope
+    // Use a local copy of the global point dimensions since blocks may be processed concurrently
+    vtkm::Id3 pointDimensions, blockGlobalPointDimensions, globalPointIndexStart;
     currBlock.GetCellSet().CastAndCallForTypes<VTKM_DEFAULT_CELL_SET_LIST_STRUCTURED>(
       vtkm::worklet::contourtree_augmented::GetLocalAndGlobalPointDimensions(),
       pointDimensions,
-      globalPointDimensions,
+      blockGlobalPointDimensions,
       globalPointIndexStart);
 
     auto localToGlobalIdRelabeler = vtkm::worklet::contourtree_augmented::mesh_dem::IdRelabeler(
-      globalPointIndexStart, pointDimensions, globalPointDimensions);
+      globalPointIndexStart, pointDimensions, blockGlobalPointDimensions);
     grafter.GraftInteriorForests(
       0, blockData->HierarchicalTree, fieldData, &localToGlobalIdRelabeler);
 
+    // The local mesh of the block is not needed after the last round of the fan out
+    this->LocalMeshes[static_cast<std::size_t>(blockData->LocalBlockNo)] =
+      vtkm::worklet::contourtree_augmented::DataSetMesh{};
+
     // Log the time for each of the iterations of the fan out loop
     fanoutTimingsStream << "    Fan Out Time (block=" << blockData->LocalBlockNo << " , round=" << 0
                         << ") : " << iterationTimer.GetElapsedTime() << " seconds" << std::endl;
@@ -1203,7 +1293,11 @@ VTKM_CONT void ContourTreeUniformDistributed::DoPostExecute(
                  << "    ------------ Fan Out (block=" << blockData->LocalBlockNo
                  << ")  ------------" << std::endl
                  << fanoutTimingsStream.str());
-  });
+  };
+  contourtree_distributed_detail::ForEachLocalBlock(
+    static_cast<vtkm::Id>(localBlocks.size()),
+    this->NumberOfLocalBlockThreads,
+    [&](vtkm::Id blockNo) { fanOutBlock(localBlocks[static_cast<std::size_t>(blockNo)]); });
 
   // 2.2 Log timings for fan out
   timingsStream << "    " << std::setw(38) << std::left << "Fan Out Foreach"
@@ -1218,6 +1312,8 @@ VTKM_CONT void ContourTreeUniformDistributed::DoPostExecute(
   timingsStream << "    " << std::setw(38) << std::left << "Post Fan Out Barrier"
                 << ": " << timer.GetElapsedTime() << " seconds" << std::endl;
   timer.Start();
+  this->PhaseTimings.emplace_back("FanOut", phaseTimer.GetElapsedTime());
+  phaseTimer.Start();
 
 
   // Compute the volume for pre-simplification if we want to pre-simplify
@@ -1243,6 +1339,8 @@ VTKM_CONT void ContourTreeUniformDistributed::DoPostExecute(
     timingsStream << "    " << std::setw(38) << std::left << "Compute Volume for Presimplication"
                   << ": " << timer.GetElapsedTime() << " seconds" << std::endl;
     timer.Start();
+    this->PhaseTimings.emplace_back("ComputePresimplifyVolume", phaseTimer.GetElapsedTime());
+    phaseTimer.Start();
   }
 
   // ******** 3. Augment the hierarchical tree if requested ********
@@ -1294,14 +1392,18 @@ VTKM_CONT void ContourTreeUniformDistributed::DoPostExecute(
                   << ": " << timer.GetElapsedTime() << " seconds" << std::endl;
     timer.Start();
 
-    master.foreach (
-      [](DistributedContourTreeBlockData* blockData, const vtkmdiy::Master::ProxyWithLink&) {
-        blockData->HierarchicalAugmenter.BuildAugmentedTree();
+    contourtree_distributed_detail::ForEachLocalBlock(
+      static_cast<vtkm::Id>(localBlocks.size()),
+      this->NumberOfLocalBlockThreads,
+      [&](vtkm::Id blockNo) {
+        localBlocks[static_cast<std::size_t>(blockNo)]->HierarchicalAugmenter.BuildAugmentedTree();
       });
 
     timingsStream << "    " << std::setw(38) << std::left << "Build Augmented Tree"
                   << ": " << timer.GetElapsedTime() << " seconds" << std::endl;
     timer.Start();
+    this->PhaseTimings.emplace_back("AugmentHierarchicalTree", phaseTimer.GetElapsedTime());
+    phaseTimer.Start();
   }
 
   // ******** 4. Create output data set ********
@@ -1387,6 +1489,8 @@ VTKM_CONT void ContourTreeUniformDistributed::DoPostExecute(
   timingsStream << "    " << std::setw(38) << std::left << "Create Output Data"
                 << ": " << timer.GetElapsedTime() << " seconds" << std::endl;
   timer.Start();
+  this->PhaseTimings.emplace_back("CreateOutputData", phaseTimer.GetElapsedTime());
+  phaseTimer.Start();
 
   if (this->AugmentHierarchicalTree)
   {
@@ -1418,6 +1522,7 @@ VTKM_CONT void ContourTreeUniformDistributed::DoPostExecute(
         timingsStream << "    " << std::setw(38) << std::left << "Add Volume Output Data"
                       << ": " << timer.GetElapsedTime() << " seconds" << std::endl;
       });
+    this->PhaseTimings.emplace_back("ComputeVolume", phaseTimer.GetElapsedTime());
   }
 
   VTKM_LOG_S(this->TimingsLogLevel,
@@ -56,13 +56,18 @@
 
 #include <vtkm/Types.h>
 #include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/UnknownArrayHandle.h>
 #include <vtkm/filter/scalar_topology/worklet/contourtree_augmented/ContourTree.h>
 #include <vtkm/filter/scalar_topology/worklet/contourtree_augmented/DataSetMesh.h>
 #include <vtkm/filter/scalar_topology/worklet/contourtree_distributed/BoundaryTree.h>
 #include <vtkm/filter/scalar_topology/worklet/contourtree_distributed/HierarchicalContourTree.h>
 #include <vtkm/filter/scalar_topology/worklet/contourtree_distributed/InteriorForest.h>
 
+#include <functional>
 #include <memory>
+#include <string>
+#include <utility>
+#include <vector>
 #include <vtkm/filter/Filter.h>
 #include <vtkm/filter/scalar_topology/vtkm_filter_scalar_topology_export.h>
 
@@ -138,6 +143,59 @@ public:
 
   VTKM_CONT bool GetSaveDotFiles() { return this->SaveDotFiles; }
 
+  /// Set the number of host threads used to process the data blocks of this rank.
+  ///
+  /// When a rank holds several blocks, the local contour trees (including their boundary
+  /// trees and interior forests), the fan out, and the construction of the augmented trees
+  /// are independent for each block. With more than one thread, these stages process the
+  /// blocks concurrently on threads of `vtkm::cont::GetThreadPool()`, each block launching
+  /// its own worklets on the device. This lets a rank own several blocks (and fewer ranks be
+  /// used per node, which reduces the depth of the distributed fan in) while still keeping
+  /// all cores busy. The rounds of the fan in still process the blocks of a rank one after
+  /// the other. The default is 1, which processes all blocks one after the other.
+  VTKM_CONT void SetNumberOfLocalBlockThreads(vtkm::Id numberOfThreads)
+  {
+    this->NumberOfLocalBlockThreads = numberOfThreads;
+  }
+
+  VTKM_CONT vtkm::Id GetNumberOfLocalBlockThreads() const
+  {
+    return this->NumberOfLocalBlockThreads;
+  }
+
+  /// Returns the time in seconds spent in each phase of the last execution of the filter,
+  /// in the order the phases ran. The phases are "ComputeLocalTrees", "FanIn", "FanOut",
+  /// and "CreateOutputData", plus "ComputePresimplifyVolume", "AugmentHierarchicalTree", and
+  /// "ComputeVolume" when pre-simplification or augmentation are enabled.
+  VTKM_CONT const std::vector<std::pair<std::string, vtkm::Float64>>& GetPhaseTimings() const
+  {
+    return this->PhaseTimings;
+  }
+
+  /// Function type used by `SetBlockLoader`. It is called with the index of a local
+  /// partition and returns a data set holding the active field of that block.
+  using BlockLoaderType = std::function<vtkm::cont::DataSet(vtkm::Id)>;
+
+  /// Load the field of each data block on demand rather than from the input.
+  ///
+  /// This supports volumes that do not fit into memory. The partitions passed to `Execute`
+  /// then only need to describe the decomposition, i.e., carry a structured cell set with
+  /// the global point dimensions and global point index start of the block, while the point
+  /// field may be omitted. Whenever the field of a block is needed (to compute its local
+  /// contour tree, to set up the fan in, and for the last round of the fan out), the loader
+  /// is called and the values are released again afterward. A natural choice is a loader
+  /// that reads the brick from disk with `vtkm::io::BOVDataSetReader::SetBrick`. The loader
+  /// may be called concurrently when more than one local block thread is used.
+  ///
+  /// Only the field values are paged. The fully augmented local contour trees and the sort
+  /// order of each local mesh stay in memory from the computation of the local trees until
+  /// the fan out, so the memory used by a rank still grows with the size of its blocks. The
+  /// boundary trees and the filter's own references to the local trees are released as soon
+  /// as the fan in has consumed them.
+  VTKM_CONT void SetBlockLoader(const BlockLoaderType& loader) { this->BlockLoader = loader; }
+
+  VTKM_CONT const BlockLoaderType& GetBlockLoader() const { return this->BlockLoader; }
+
   template <typename T, typename StorageType>
   VTKM_CONT void ComputeLocalTree(const vtkm::Id blockIndex,
                                   const vtkm::cont::DataSet& input,
@@ -165,6 +223,10 @@ private:
   VTKM_CONT void PostExecute(const vtkm::cont::PartitionedDataSet& input,
                              vtkm::cont::PartitionedDataSet& output);
 
+  /// Get the active field of a local block, either from the input or from the block loader
+  VTKM_CONT vtkm::cont::Field GetBlockField(const vtkm::cont::PartitionedDataSet& input,
+                                            vtkm::Id blockNo) const;
+
 
   template <typename FieldType>
   VTKM_CONT void ComputeVolumeMetric(
@@ -204,6 +266,19 @@ private:
   /// Save dot files for all tree computations
   bool SaveDotFiles;
 
+  /// Number of threads used to process the data blocks of this rank concurrently
+  vtkm::Id NumberOfLocalBlockThreads = 1;
+
+  /// Time spent in each phase of the last execution
+  std::vector<std::pair<std::string, vtkm::Float64>> PhaseTimings;
+
+  /// Optional function to load the field of a block on demand
+  BlockLoaderType BlockLoader;
+
+  /// Empty array with the value type of the active field, recorded while the local trees are
+  /// computed so that the post execution does not have to load a block to find the type
+  vtkm::cont::UnknownArrayHandle FieldValueTypeArray;
+
   /// Log level to be used for outputting timing information. Default is vtkm::cont::LogLevel::Perf
   vtkm::cont::LogLevel TimingsLogLevel = vtkm::cont::LogLevel::Perf;
 
@@ -229,8 +304,6 @@ private:
   // Currently we cannot do this here as it is a template on FieldType
   //
   //std::vector<vtkm::worklet::contourtree_distributed::HierarchicalContourTree> HierarchicalContourTrees;
-  /// Number of iterations used to compute the contour tree
-  vtkm::Id NumIterations;
 };
 } // namespace scalar_topology
 } // namespace filter
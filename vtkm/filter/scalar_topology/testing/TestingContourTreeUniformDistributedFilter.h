@@ -273,7 +273,9 @@ inline vtkm::cont::PartitionedDataSet RunContourTreeDUniformDistributed(
   bool computeHierarchicalVolumetricBranchDecomposition,
   vtkm::Id3& globalSize,
   bool passBlockIndices = true,
-  const vtkm::Id presimplifyThreshold = 0)
+  const vtkm::Id presimplifyThreshold = 0,
+  vtkm::Id numberOfLocalBlockThreads = 1,
+  bool useBlockLoader = false)
 {
   // Get dimensions of data set
   vtkm::cont::CastAndCall(
@@ -303,12 +305,26 @@ inline vtkm::cont::PartitionedDataSet RunContourTreeDUniformDistributed(
 
   auto localBlockIndicesPortal = localBlockIndices.WritePortal();
 
+  // When using a block loader, the partitions only describe the decomposition and the
+  // blocks with their fields are handed out by the loader
+  std::vector<vtkm::cont::DataSet> loaderBlocks;
   for (vtkm::Id blockNo = 0; blockNo < blocksOnThisRank; ++blockNo)
   {
     vtkm::Id3 blockOrigin, blockSize, blockIndex;
     std::tie(blockIndex, blockOrigin, blockSize) =
       ComputeBlockExtents(globalSize, blocksPerAxis, startBlockNo + blockNo);
-    pds.AppendPartition(CreateSubDataSet(ds, blockOrigin, blockSize, fieldName));
+    vtkm::cont::DataSet block = CreateSubDataSet(ds, blockOrigin, blockSize, fieldName);
+    if (useBlockLoader)
+    {
+      loaderBlocks.push_back(block);
+      vtkm::cont::DataSet structureOnly;
+      structureOnly.SetCellSet(block.GetCellSet());
+      pds.AppendPartition(structureOnly);
+    }
+    else
+    {
+      pds.AppendPartition(block);
+    }
     localBlockIndicesPortal.Set(blockNo, blockIndex);
   }
 
@@ -325,6 +341,13 @@ inline vtkm::cont::PartitionedDataSet RunContourTreeDUniformDistributed(
   filter.SetUseBoundaryExtremaOnly(true);
   filter.SetAugmentHierarchicalTree(augmentHierarchicalTree);
   filter.SetActiveField(fieldName);
+  filter.SetNumberOfLocalBlockThreads(numberOfLocalBlockThreads);
+  if (useBlockLoader)
+  {
+    filter.SetBlockLoader([loaderBlocks](vtkm::Id blockNo) {
+      return loaderBlocks[static_cast<std::size_t>(blockNo)];
+    });
+  }
   if (presimplifyThreshold > 0)
   {
     filter.SetPresimplifyThreshold(presimplifyThreshold);
@@ -408,7 +431,9 @@ inline vtkm::cont::PartitionedDataSet RunContourTreeDUniformDistributed(
   int numberOfRanks = 1,
   bool augmentHierarchicalTree = false,
   bool computeHierarchicalVolumetricBranchDecomposition = false,
-  bool passBlockIndices = true)
+  bool passBlockIndices = true,
+  vtkm::Id numberOfLocalBlockThreads = 1,
+  bool useBlockLoader = false)
 {
   vtkm::Id3 globalSize;
 
@@ -421,19 +446,37 @@ inline vtkm::cont::PartitionedDataSet RunContourTreeDUniformDistributed(
                                            augmentHierarchicalTree,
                                            computeHierarchicalVolumetricBranchDecomposition,
                                            globalSize,
-                                           passBlockIndices);
+                                           passBlockIndices,
+                                           0,
+                                           numberOfLocalBlockThreads,
+                                           useBlockLoader);
 }
 
-inline void TestContourTreeUniformDistributed8x9(int nBlocks, int rank = 0, int size = 1)
+inline void TestContourTreeUniformDistributed8x9(int nBlocks,
+                                                 int rank = 0,
+                                                 int size = 1,
+                                                 vtkm::Id numberOfLocalBlockThreads = 1,
+                                                 bool useBlockLoader = false)
 {
   if (rank == 0)
   {
     std::cout << "Testing ContourTreeUniformDistributed on 2D 8x9 data set divided into " << nBlocks
-              << " blocks." << std::endl;
+              << " blocks using " << numberOfLocalBlockThreads << " thread(s) per rank"
+              << (useBlockLoader ? " and loading blocks on demand." : ".") << std::endl;
   }
   vtkm::cont::DataSet in_ds = vtkm::cont::testing::MakeTestDataSet().Make2DUniformDataSet3();
   vtkm::cont::PartitionedDataSet result =
-    RunContourTreeDUniformDistributed(in_ds, "pointvar", false, nBlocks, rank, size);
+    RunContourTreeDUniformDistributed(in_ds,
+                                      "pointvar",
+                                      false,
+                                      nBlocks,
+                                      rank,
+                                      size,
+                                      false,
+                                      false,
+                                      true,
+                                      numberOfLocalBlockThreads,
+                                      useBlockLoader);
 
   if (vtkm::cont::EnvironmentTracker::GetCommunicator().rank() == 0)
   {
@@ -80,6 +80,8 @@ public:
 #endif
     TestContourTreeUniformDistributed8x9(8);
     TestContourTreeUniformDistributed8x9(16);
+    TestContourTreeUniformDistributed8x9(8, 0, 1, 4);
+    TestContourTreeUniformDistributed8x9(8, 0, 1, 1, true);
 
 #ifdef ENABLE_ADDITIONAL_TESTS
     TestContourTreeUniformDistributed5x6x7(2, false);
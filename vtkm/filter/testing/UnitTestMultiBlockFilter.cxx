@@ -9,6 +9,8 @@
 //============================================================================
 
 #include <vtkm/Math.h>
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleCounting.h>
 #include <vtkm/cont/DataSet.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
@@ -16,11 +18,17 @@
 #include <vtkm/filter/clean_grid/CleanGrid.h>
 #include <vtkm/filter/contour/ClipWithField.h>
 #include <vtkm/filter/contour/Contour.h>
+#include <vtkm/filter/entity_extraction/Threshold.h>
+#include <vtkm/filter/field_conversion/PointAverage.h>
 #include <vtkm/filter/vector_analysis/Gradient.h>
 
 #include <vtkm/io/VTKDataSetReader.h>
 #include <vtkm/source/Tangle.h>
 
+#include <algorithm>
+#include <array>
+#include <vector>
+
 namespace
 {
 template <typename T>
@@ -83,6 +91,93 @@ void ValidateResults(const vtkm::cont::PartitionedDataSet& truth,
     }
   }
 }
+
+// A point of a cell, described by its coordinates and field value.
+using PointKey = vtkm::Vec<vtkm::Float64, 4>;
+
+// Rounds the point description so that values that differ only by floating point error sort
+// the same way.
+std::array<vtkm::Int64, 4> SortKey(const PointKey& point)
+{
+  std::array<vtkm::Int64, 4> key;
+  for (vtkm::IdComponent i = 0; i < 4; ++i)
+  {
+    key[static_cast<std::size_t>(i)] = static_cast<vtkm::Int64>(vtkm::Round(point[i] * 1e4));
+  }
+  return key;
+}
+
+bool KeyLess(const PointKey& a, const PointKey& b)
+{
+  return SortKey(a) < SortKey(b);
+}
+
+// Describes every cell of the partition by its points, independent of the order of the points
+// and cells.
+std::vector<std::vector<PointKey>> DescribeCells(const vtkm::cont::DataSet& dataSet,
+                                                 const std::string& varName)
+{
+  vtkm::cont::ArrayHandle<vtkm::Float32> field;
+  dataSet.GetPointField(varName).GetData().AsArrayHandle(field);
+  auto fieldPortal = field.ReadPortal();
+  auto coordsPortal = dataSet.GetCoordinateSystem().GetDataAsMultiplexer().ReadPortal();
+  const vtkm::cont::UnknownCellSet& cellSet = dataSet.GetCellSet();
+
+  std::vector<std::vector<PointKey>> cells(static_cast<std::size_t>(cellSet.GetNumberOfCells()));
+  for (vtkm::Id cellId = 0; cellId < cellSet.GetNumberOfCells(); ++cellId)
+  {
+    std::vector<vtkm::Id> pointIds(
+      static_cast<std::size_t>(cellSet.GetNumberOfPointsInCell(cellId)));
+    cellSet.GetCellPointIds(cellId, pointIds.data());
+    std::vector<PointKey>& cell = cells[static_cast<std::size_t>(cellId)];
+    for (vtkm::Id pointId : pointIds)
+    {
+      auto coords = coordsPortal.Get(pointId);
+      cell.push_back(PointKey(coords[0], coords[1], coords[2], fieldPortal.Get(pointId)));
+    }
+    std::sort(cell.begin(), cell.end(), KeyLess);
+  }
+  std::sort(cells.begin(), cells.end(), [](const auto& a, const auto& b) {
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end(), KeyLess);
+  });
+  return cells;
+}
+
+// Contouring a fused partition may order the points and cells differently than contouring the
+// partition on its own, so compare the cells by the coordinates and field values of their
+// points.
+void ValidateContourResults(const vtkm::cont::PartitionedDataSet& truth,
+                            const vtkm::cont::PartitionedDataSet& result,
+                            const std::string& varName)
+{
+  VTKM_TEST_ASSERT(truth.GetNumberOfPartitions() == result.GetNumberOfPartitions());
+  for (vtkm::Id i = 0; i < truth.GetNumberOfPartitions(); i++)
+  {
+    auto truthDS = truth.GetPartition(i);
+    auto resultDS = result.GetPartition(i);
+
+    VTKM_TEST_ASSERT(truthDS.GetNumberOfPoints() == resultDS.GetNumberOfPoints(),
+                     "Wrong number of points");
+    VTKM_TEST_ASSERT(truthDS.GetNumberOfCells() == resultDS.GetNumberOfCells(),
+                     "Wrong number of cells");
+    VTKM_TEST_ASSERT(resultDS.HasPointField(varName), "Missing field");
+
+    std::vector<std::vector<PointKey>> truthCells = DescribeCells(truthDS, varName);
+    std::vector<std::vector<PointKey>> resultCells = DescribeCells(resultDS, varName);
+    for (std::size_t cellIndex = 0; cellIndex < truthCells.size(); ++cellIndex)
+    {
+      const std::vector<PointKey>& truthCell = truthCells[cellIndex];
+      const std::vector<PointKey>& resultCell = resultCells[cellIndex];
+      VTKM_TEST_ASSERT(truthCell.size() == resultCell.size(), "Wrong cell shape");
+      for (std::size_t pointIndex = 0; pointIndex < truthCell.size(); ++pointIndex)
+      {
+        VTKM_TEST_ASSERT(test_equal(truthCell[pointIndex], resultCell[pointIndex], 1e-3),
+                         "Wrong cell in partition ",
+                         i);
+      }
+    }
+  }
+}
 } //namespace
 
 
@@ -160,7 +255,119 @@ void TestMultiBlockFilter()
   ValidateResults(results[0], results[1], "gradient", false);
 }
 
+void TestFusedPartitions()
+{
+  vtkm::cont::PartitionedDataSet pds;
+
+  for (int i = 0; i < 12; i++)
+  {
+    vtkm::Id3 dims(3 + i, 4 + i, 2 + i);
+    vtkm::source::Tangle tangle;
+    tangle.SetCellDimensions(dims);
+    vtkm::cont::DataSet ds = tangle.Execute();
+    vtkm::cont::ArrayHandle<vtkm::Float32> cellvar;
+    vtkm::cont::ArrayCopy(
+      vtkm::cont::ArrayHandleCounting<vtkm::Float32>(
+        static_cast<vtkm::Float32>(i), 0.5f, ds.GetNumberOfCells()),
+      cellvar);
+    ds.AddCellField("cellvar", cellvar);
+    if (i % 4 == 3)
+    {
+      // Partitions with another cell set type are fused in their own group.
+      vtkm::filter::clean_grid::CleanGrid clean;
+      clean.SetCompactPointFields(false);
+      clean.SetMergePoints(false);
+      ds = clean.Execute(ds);
+    }
+    pds.AppendPartition(ds);
+  }
+
+  // The largest partitions are executed on their own.
+  const vtkm::Id maxFusedCells = 1000;
+  std::vector<bool> flags = { false, true };
+  std::vector<vtkm::cont::PartitionedDataSet> results;
+
+  std::cout << "Fused PointAverage" << std::endl;
+  for (const auto doFuse : flags)
+  {
+    vtkm::filter::field_conversion::PointAverage average;
+    average.SetFusePartitions(doFuse);
+    average.SetFusePartitionsMaxCells(maxFusedCells);
+    average.SetActiveField("cellvar");
+    average.SetOutputFieldName("average");
+    results.push_back(average.Execute(pds));
+  }
+  ValidateResults(results[0], results[1], "average");
+  ValidateResults(results[0], results[1], "tangle");
+
+  std::cout << "Fused Gradient" << std::endl;
+  results.clear();
+  for (const auto doFuse : flags)
+  {
+    vtkm::filter::vector_analysis::Gradient grad;
+    grad.SetFusePartitions(doFuse);
+    grad.SetFusePartitionsMaxCells(maxFusedCells);
+    grad.SetComputePointGradient(true);
+    grad.SetActiveField("tangle");
+    grad.SetOutputFieldName("gradient");
+    results.push_back(grad.Execute(pds));
+  }
+  ValidateResults(results[0], results[1], "gradient", false);
+
+  std::cout << "Fused Threshold" << std::endl;
+  results.clear();
+  for (const auto doFuse : flags)
+  {
+    vtkm::filter::entity_extraction::Threshold threshold;
+    threshold.SetFusePartitions(doFuse);
+    threshold.SetFusePartitionsMaxCells(maxFusedCells);
+    threshold.SetActiveField("tangle");
+    threshold.SetLowerThreshold(0.0);
+    threshold.SetUpperThreshold(20.0);
+    results.push_back(threshold.Execute(pds));
+  }
+  ValidateResults(results[0], results[1], "tangle");
+  ValidateResults(results[0], results[1], "cellvar");
+
+  std::cout << "Fused Contour" << std::endl;
+  results.clear();
+  for (const auto doFuse : flags)
+  {
+    vtkm::filter::contour::Contour mc;
+    mc.SetFusePartitions(doFuse);
+    mc.SetFusePartitionsMaxCells(maxFusedCells);
+    mc.SetIsoValue(0, 0.5);
+    mc.SetActiveField("tangle");
+    mc.SetFieldsToPass("tangle", vtkm::cont::Field::Association::Points);
+    results.push_back(mc.Execute(pds));
+  }
+  ValidateContourResults(results[0], results[1], "tangle");
+
+  std::cout << "Fused multithreaded Contour" << std::endl;
+  {
+    vtkm::filter::contour::Contour mc;
+    mc.SetFusePartitions(true);
+    mc.SetFusePartitionsMaxCells(maxFusedCells);
+    mc.SetRunMultiThreadedFilter(true);
+    mc.SetIsoValue(0, 0.5);
+    mc.SetActiveField("tangle");
+    mc.SetFieldsToPass("tangle", vtkm::cont::Field::Association::Points);
+    vtkm::cont::PartitionedDataSet result = mc.Execute(pds);
+    ValidateContourResults(results[0], result, "tangle");
+    VTKM_TEST_ASSERT(!result.GetPartition(0).HasField("vtkmFusedPartitionIds"),
+                     "Partition tags leaked into the output");
+    VTKM_TEST_ASSERT(!mc.GetFieldsToPass().HasField("vtkmFusedPartitionIds"),
+                     "Fusing changed the fields to pass");
+  }
+}
+
+void TestMultiBlockFilters()
+{
+  TestMultiBlockFilter();
+  TestFusedPartitions();
+}
+
 int UnitTestMultiBlockFilter(int argc, char* argv[])
 {
-  return vtkm::cont::testing::Testing::Run(TestMultiBlockFilter, argc, argv);
+  return vtkm::cont::testing::Testing::Run(TestMultiBlockFilters, argc, argv);
 }
@@ -115,6 +115,12 @@ void TestPartitionedDataSetFilters()
   result = cellAverage.Execute(partitions);
   Result_Verify<vtkm::FloatDefault>(result, cellAverage, partitions, std::string("pointvar"));
 
+  // Fusing the partitions into one execution should not change the result.
+  cellAverage.SetFusePartitions(true);
+  result = cellAverage.Execute(partitions);
+  Result_Verify<vtkm::FloatDefault>(result, cellAverage, partitions, std::string("pointvar"));
+  cellAverage.SetFusePartitions(false);
+
   //Make sure that any Fields are propagated to the output.
   //Test it with and without using SetFieldsToPass
   std::vector<std::vector<std::string>> fieldsToPass;
@@ -50,7 +50,7 @@ vtkm::cont::DataSet Gradient::DoExecute(const vtkm::cont::DataSet& inputDataSet)
   {
     throw vtkm::cont::ErrorFilterExecution("scalar gradients can't generate qcriterion");
   }
-  if (GetComputeVorticity() && !isVector)
+  if ((GetComputeVorticity() || GetComputeVorticityMagnitude()) && !isVector)
   {
     throw vtkm::cont::ErrorFilterExecution("scalar gradients can't generate vorticity");
   }
@@ -59,9 +59,23 @@ vtkm::cont::DataSet Gradient::DoExecute(const vtkm::cont::DataSet& inputDataSet)
   const vtkm::cont::CoordinateSystem& coords =
     inputDataSet.GetCoordinateSystem(this->GetActiveCoordinateSystemIndex());
 
+  const vtkm::IdComponent order = this->GetOrderOfAccuracy();
+  if (order != 2 && order != 4 && order != 6)
+  {
+    throw vtkm::cont::ErrorFilterExecution("The order of accuracy must be 2, 4 or 6.");
+  }
+  if (order != 2 &&
+      (!this->ComputePointGradient ||
+       !vtkm::worklet::StructuredPointGradientHighOrder::IsSupported(inputCellSet, coords)))
+  {
+    throw vtkm::cont::ErrorFilterExecution("Higher order gradients need point gradients on a "
+                                           "structured, uniform or rectilinear data set.");
+  }
+
   vtkm::cont::UnknownArrayHandle gradientArray;
   vtkm::cont::UnknownArrayHandle divergenceArray;
   vtkm::cont::UnknownArrayHandle vorticityArray;
+  vtkm::cont::UnknownArrayHandle vorticityMagnitudeArray;
   vtkm::cont::UnknownArrayHandle qcriterionArray;
 
   // TODO: there are a humungous number of (weak) symbols in the .o file. Investigate if
@@ -73,10 +87,16 @@ vtkm::cont::DataSet Gradient::DoExecute(const vtkm::cont::DataSet& inputDataSet)
     vtkm::worklet::GradientOutputFields<T> gradientfields(this->GetComputeGradient(),
                                                           this->GetComputeDivergence(),
                                                           this->GetComputeVorticity(),
-                                                          this->GetComputeQCriterion());
+                                                          this->GetComputeQCriterion(),
+                                                          this->GetComputeVorticityMagnitude());
 
     vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>> result;
-    if (this->ComputePointGradient)
+    if (order != 2)
+    {
+      result = vtkm::worklet::StructuredPointGradientHighOrder::Run(
+        inputCellSet, coords, concrete, order, gradientfields);
+    }
+    else if (this->ComputePointGradient)
     {
       vtkm::worklet::PointGradient gradient;
       result = gradient.Run(inputCellSet, coords, concrete, gradientfields);
@@ -94,6 +114,7 @@ vtkm::cont::DataSet Gradient::DoExecute(const vtkm::cont::DataSet& inputDataSet)
     gradientArray = result;
     divergenceArray = gradientfields.Divergence;
     vorticityArray = gradientfields.Vorticity;
+    vorticityMagnitudeArray = gradientfields.VorticityMagnitude;
     qcriterionArray = gradientfields.QCriterion;
   };
 
@@ -114,7 +135,12 @@ vtkm::cont::DataSet Gradient::DoExecute(const vtkm::cont::DataSet& inputDataSet)
                                                     ? vtkm::cont::Field::Association::Points
                                                     : vtkm::cont::Field::Association::Cells);
 
-  outputDataSet.AddField(vtkm::cont::Field{ outputName, fieldAssociation, gradientArray });
+  // The gradient of a vector field is only stored when requested. The gradient of a scalar
+  // field is always stored.
+  if (this->GetComputeGradient() || !isVector)
+  {
+    outputDataSet.AddField(vtkm::cont::Field{ outputName, fieldAssociation, gradientArray });
+  }
 
   if (this->GetComputeDivergence() && isVector)
   {
@@ -126,6 +152,11 @@ vtkm::cont::DataSet Gradient::DoExecute(const vtkm::cont::DataSet& inputDataSet)
     outputDataSet.AddField(
       vtkm::cont::Field{ this->GetVorticityName(), fieldAssociation, vorticityArray });
   }
+  if (this->GetComputeVorticityMagnitude() && isVector)
+  {
+    outputDataSet.AddField(vtkm::cont::Field{
+      this->GetVorticityMagnitudeName(), fieldAssociation, vorticityMagnitudeArray });
+  }
   if (this->GetComputeQCriterion() && isVector)
   {
     outputDataSet.AddField(
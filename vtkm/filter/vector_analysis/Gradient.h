@@ -43,6 +43,16 @@ public:
   /// @copydoc SetComputePointGradient
   bool GetComputePointGradient() const { return ComputePointGradient; }
 
+  /// @brief Specify the order of accuracy of point gradients.
+  ///
+  /// The default of 2 uses the gradient of the cells around each point and works on
+  /// any cell set. Orders 4 and 6 use wider finite difference stencils along each axis,
+  /// which are much more accurate for smooth fields. They require point gradients on a
+  /// structured cell set with uniform or rectilinear coordinates.
+  void SetOrderOfAccuracy(vtkm::IdComponent order) { this->OrderOfAccuracy = order; }
+  /// @copydoc SetOrderOfAccuracy
+  vtkm::IdComponent GetOrderOfAccuracy() const { return this->OrderOfAccuracy; }
+
   /// Add divergence field to the output data. The input array must have 3 components
   /// to compute this. The default is off.
   void SetComputeDivergence(bool enable) { ComputeDivergence = enable; }
@@ -67,6 +77,19 @@ public:
   /// @copydoc SetVorticityName
   const std::string& GetVorticityName() const { return this->VorticityName; }
 
+  /// Add the magnitude of the voriticity/curl to the output data. The input array must
+  /// have 3 components to compute this. It is computed with the gradient, so neither the
+  /// gradient nor the vorticity needs to be stored to get it. The default is off.
+  void SetComputeVorticityMagnitude(bool enable) { ComputeVorticityMagnitude = enable; }
+  /// @copydoc SetComputeVorticityMagnitude
+  bool GetComputeVorticityMagnitude() const { return ComputeVorticityMagnitude; }
+
+  /// When `SetComputeVorticityMagnitude()` is enabled, the result is stored in a field
+  /// of this name. If not specified, the name of the field will be `VorticityMagnitude`.
+  void SetVorticityMagnitudeName(const std::string& name) { this->VorticityMagnitudeName = name; }
+  /// @copydoc SetVorticityMagnitudeName
+  const std::string& GetVorticityMagnitudeName() const { return this->VorticityMagnitudeName; }
+
   /// Add Q-criterion field to the output data. The input array must have 3 components
   /// to compute this. The default is off.
   void SetComputeQCriterion(bool enable) { ComputeQCriterion = enable; }
@@ -83,7 +106,10 @@ public:
   /// will be `Gradients` unless otherwise specified with `SetOutputFieldName`
   /// and will be a cell field unless `ComputePointGradient()`
   /// is enabled. It is useful to turn this off when you are only interested
-  /// in the results of Divergence, Vorticity, or QCriterion. The default is on.
+  /// in the results of Divergence, Vorticity, or QCriterion. The derived quantities are
+  /// computed from the gradient of each point or cell as it is estimated, so when this is
+  /// off the gradient tensor is never stored. This only applies to vector fields; the
+  /// gradient of a scalar field is always added. The default is on.
   void SetComputeGradient(bool enable) { StoreGradient = enable; }
   /// @copydoc SetComputeGradient
   bool GetComputeGradient() const { return StoreGradient; }
@@ -102,18 +128,22 @@ public:
 
 private:
   vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& inputDataSet) override;
+  VTKM_CONT bool CanFusePartitions() const override { return true; }
 
   bool ComputePointGradient = false;
   bool ComputeDivergence = false;
   bool ComputeVorticity = false;
+  bool ComputeVorticityMagnitude = false;
   bool ComputeQCriterion = false;
   bool StoreGradient = true;
   bool RowOrdering = true;
+  vtkm::IdComponent OrderOfAccuracy = 2;
 
   std::string DivergenceName = "Divergence";
   std::string GradientsName = "Gradients";
   std::string QCriterionName = "QCriterion";
   std::string VorticityName = "Vorticity";
+  std::string VorticityMagnitudeName = "VorticityMagnitude";
 };
 
 } // namespace vector_analysis
@@ -10,6 +10,9 @@
 
 #include <vtkm/filter/vector_analysis/Gradient.h>
 
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/DataSetBuilderRectilinear.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/ErrorFilterExecution.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
@@ -107,6 +110,51 @@ void TestCellGradientUniform3DWithVectorField()
 }
 
 
+void TestCellGradientUniform3DDerivedOnly()
+{
+  std::cout << "Testing Gradient Filter with only derived quantities on 3D structured data"
+            << std::endl;
+  vtkm::cont::testing::MakeTestDataSet testDataSet;
+  vtkm::cont::DataSet dataSet = testDataSet.Make3DUniformDataSet0();
+
+  const int nVerts = 18;
+  vtkm::Float64 vars[nVerts] = { 10.1,  20.1,  30.1,  40.1,  50.2,  60.2,  70.2,  80.2,  90.3,
+                                 100.3, 110.3, 120.3, 130.4, 140.4, 150.4, 160.4, 170.5, 180.5 };
+  std::vector<vtkm::Vec3f_64> vec(nVerts);
+  for (std::size_t i = 0; i < vec.size(); ++i)
+  {
+    vec[i] = vtkm::make_Vec(vars[i], vars[i], vars[i]);
+  }
+  dataSet.AddPointField("vec_pointvar", vec);
+
+  vtkm::filter::vector_analysis::Gradient gradient;
+  gradient.SetOutputFieldName("vec_gradient");
+  gradient.SetComputeGradient(false);
+  gradient.SetComputeVorticityMagnitude(true);
+  gradient.SetComputeQCriterion(true);
+  gradient.SetActiveField("vec_pointvar");
+
+  vtkm::cont::DataSet result = gradient.Execute(dataSet);
+
+  //verify that the gradient and vorticity fields do NOT exist
+  VTKM_TEST_ASSERT(!result.HasField("vec_gradient"));
+  VTKM_TEST_ASSERT(!result.HasField("Vorticity"));
+  VTKM_TEST_ASSERT(result.HasCellField("VorticityMagnitude"));
+
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+    result.GetCellField("VorticityMagnitude").GetData(),
+    vtkm::cont::make_ArrayHandle<vtkm::Float64>(
+      { vtkm::Magnitude(vtkm::Vec3f_64(-30.05, 50.1, -20.05)),
+        vtkm::Magnitude(vtkm::Vec3f_64(-30.05, 50.1, -20.05)),
+        vtkm::Magnitude(vtkm::Vec3f_64(-30.1, 50.15, -20.05)),
+        vtkm::Magnitude(vtkm::Vec3f_64(-30.1, 50.15, -20.05)) })));
+
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(
+    result.GetCellField("QCriterion").GetData(),
+    vtkm::cont::make_ArrayHandle<vtkm::Float64>({ -5022.53, -5022.53, -5027.54, -5027.54 })));
+}
+
+
 void TestPointGradientUniform3DWithVectorField()
 {
   std::cout << "Testing Gradient Filter with vector point output on 3D structured data"
@@ -159,12 +207,182 @@ void TestPointGradientUniform3DWithVectorField()
 }
 
 
+// A polynomial of degree 4 along each axis and its gradient.
+vtkm::Float64 HighOrderField(const vtkm::Vec3f_64& p)
+{
+  return p[0] * p[0] * p[0] - 2 * p[0] * p[1] * p[1] + p[1] * p[2] * p[2] * p[2] +
+    p[2] * p[2] * p[2] * p[2];
+}
+
+vtkm::Vec3f_64 HighOrderFieldGradient(const vtkm::Vec3f_64& p)
+{
+  return { 3 * p[0] * p[0] - 2 * p[1] * p[1],
+           -4 * p[0] * p[1] + p[2] * p[2] * p[2],
+           3 * p[1] * p[2] * p[2] + 4 * p[2] * p[2] * p[2] };
+}
+
+void CheckPointGradientHighOrder(vtkm::cont::DataSet dataSet)
+{
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_64> points;
+  vtkm::cont::ArrayCopyShallowIfPossible(dataSet.GetCoordinateSystem().GetData(), points);
+  auto pointPortal = points.ReadPortal();
+  const vtkm::Id numPoints = pointPortal.GetNumberOfValues();
+
+  std::vector<vtkm::Float64> scalars(static_cast<std::size_t>(numPoints));
+  std::vector<vtkm::Vec3f_64> vectors(static_cast<std::size_t>(numPoints));
+  for (vtkm::Id i = 0; i < numPoints; ++i)
+  {
+    const vtkm::Vec3f_64 p = pointPortal.Get(i);
+    scalars[static_cast<std::size_t>(i)] = HighOrderField(p);
+    vectors[static_cast<std::size_t>(i)] =
+      vtkm::make_Vec(HighOrderField(p), p[1] * p[1] * p[1], p[0] * p[2] * p[2]);
+  }
+  dataSet.AddPointField("scalars", scalars);
+  dataSet.AddPointField("vectors", vectors);
+
+  vtkm::filter::vector_analysis::Gradient gradient;
+  gradient.SetComputePointGradient(true);
+  gradient.SetActiveField("scalars");
+
+  // The second order gradient is not exact for this field.
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_64> secondOrder;
+  gradient.Execute(dataSet).GetPointField("Gradients").GetData().AsArrayHandle(secondOrder);
+
+  for (vtkm::IdComponent order : { 4, 6 })
+  {
+    gradient.SetOrderOfAccuracy(order);
+    gradient.SetActiveField("scalars");
+    vtkm::cont::ArrayHandle<vtkm::Vec3f_64> scalarGradient;
+    gradient.Execute(dataSet).GetPointField("Gradients").GetData().AsArrayHandle(scalarGradient);
+
+    gradient.SetActiveField("vectors");
+    gradient.SetComputeGradient(false);
+    gradient.SetComputeDivergence(true);
+    vtkm::cont::DataSet result = gradient.Execute(dataSet);
+    gradient.SetComputeGradient(true);
+    gradient.SetComputeDivergence(false);
+    VTKM_TEST_ASSERT(!result.HasPointField("Gradients"), "Gradient should not be stored.");
+    vtkm::cont::ArrayHandle<vtkm::Float64> divergence;
+    result.GetPointField("Divergence").GetData().AsArrayHandle(divergence);
+
+    auto scalarPortal = scalarGradient.ReadPortal();
+    auto secondOrderPortal = secondOrder.ReadPortal();
+    auto divergencePortal = divergence.ReadPortal();
+    bool secondOrderExact = true;
+    for (vtkm::Id i = 0; i < numPoints; ++i)
+    {
+      const vtkm::Vec3f_64 p = pointPortal.Get(i);
+      const vtkm::Vec3f_64 expected = HighOrderFieldGradient(p);
+      VTKM_TEST_ASSERT(test_equal(scalarPortal.Get(i), expected, 1e-6),
+                       "Wrong order ",
+                       order,
+                       " gradient at ",
+                       p,
+                       ": ",
+                       scalarPortal.Get(i),
+                       " instead of ",
+                       expected);
+      VTKM_TEST_ASSERT(
+        test_equal(divergencePortal.Get(i), expected[0] + 3 * p[1] * p[1] + 2 * p[0] * p[2], 1e-6),
+        "Wrong order ",
+        order,
+        " divergence at ",
+        p);
+      secondOrderExact = secondOrderExact && test_equal(secondOrderPortal.Get(i), expected, 1e-6);
+    }
+    VTKM_TEST_ASSERT(!secondOrderExact, "Second order gradient should not be exact.");
+  }
+}
+
+void TestPointGradientHighOrder()
+{
+  std::cout << "Testing Gradient Filter with higher order point gradients" << std::endl;
+
+  CheckPointGradientHighOrder(vtkm::cont::DataSetBuilderUniform::Create(
+    vtkm::Id3(12, 9, 8), vtkm::Vec3f(-1.0f, 0.5f, 0.0f), vtkm::Vec3f(0.25f, 0.2f, 0.3f)));
+
+  std::vector<vtkm::Float64> x, y, z;
+  for (int i = 0; i < 11; ++i)
+  {
+    x.push_back(-1.0 + 0.05 * i * i);
+  }
+  for (int i = 0; i < 9; ++i)
+  {
+    y.push_back(0.3 * i + 0.02 * (i % 3));
+  }
+  for (int i = 0; i < 7; ++i)
+  {
+    z.push_back(0.1 * i * (1 + 0.1 * i));
+  }
+  CheckPointGradientHighOrder(vtkm::cont::DataSetBuilderRectilinear::Create(x, y, z));
+
+  // 2D structured data has a zero derivative along z.
+  vtkm::cont::DataSet dataSet2D = vtkm::cont::DataSetBuilderUniform::Create(
+    vtkm::Id2(10, 7), vtkm::Vec2f(0.0f, 0.0f), vtkm::Vec2f(0.1f, 0.2f));
+  std::vector<vtkm::Float64> scalars2D;
+  for (vtkm::Id j = 0; j < 7; ++j)
+  {
+    for (vtkm::Id i = 0; i < 10; ++i)
+    {
+      const vtkm::Float64 px = 0.1 * static_cast<vtkm::Float64>(i);
+      const vtkm::Float64 py = 0.2 * static_cast<vtkm::Float64>(j);
+      scalars2D.push_back(px * px * px * py);
+    }
+  }
+  dataSet2D.AddPointField("scalars", scalars2D);
+  vtkm::filter::vector_analysis::Gradient gradient;
+  gradient.SetComputePointGradient(true);
+  gradient.SetOrderOfAccuracy(4);
+  gradient.SetActiveField("scalars");
+  vtkm::cont::ArrayHandle<vtkm::Vec3f_64> gradient2D;
+  gradient.Execute(dataSet2D).GetPointField("Gradients").GetData().AsArrayHandle(gradient2D);
+  auto portal2D = gradient2D.ReadPortal();
+  for (vtkm::Id j = 0; j < 7; ++j)
+  {
+    for (vtkm::Id i = 0; i < 10; ++i)
+    {
+      const vtkm::Float64 px = 0.1 * static_cast<vtkm::Float64>(i);
+      const vtkm::Float64 py = 0.2 * static_cast<vtkm::Float64>(j);
+      VTKM_TEST_ASSERT(
+        test_equal(portal2D.Get(i + 10 * j), vtkm::make_Vec(3 * px * px * py, px * px * px, 0.0)),
+        "Wrong 2D gradient");
+    }
+  }
+
+  // Higher orders are only supported for point gradients.
+  gradient.SetComputePointGradient(false);
+  bool caught = false;
+  try
+  {
+    gradient.Execute(dataSet2D);
+  }
+  catch (vtkm::cont::ErrorFilterExecution&)
+  {
+    caught = true;
+  }
+  VTKM_TEST_ASSERT(caught, "Cell gradients of order 4 should fail.");
+
+  gradient.SetComputePointGradient(true);
+  gradient.SetOrderOfAccuracy(3);
+  caught = false;
+  try
+  {
+    gradient.Execute(dataSet2D);
+  }
+  catch (vtkm::cont::ErrorFilterExecution&)
+  {
+    caught = true;
+  }
+  VTKM_TEST_ASSERT(caught, "An odd order of accuracy should fail.");
+}
 
 void TestGradient()
 {
   TestCellGradientUniform3D();
   TestCellGradientUniform3DWithVectorField();
+  TestCellGradientUniform3DDerivedOnly();
   TestPointGradientUniform3DWithVectorField();
+  TestPointGradientHighOrder();
 }
 }
 
@@ -20,15 +20,19 @@
 #include <vtkm/filter/vector_analysis/worklet/gradient/PointGradient.h>
 #include <vtkm/filter/vector_analysis/worklet/gradient/QCriterion.h>
 #include <vtkm/filter/vector_analysis/worklet/gradient/StructuredPointGradient.h>
+#include <vtkm/filter/vector_analysis/worklet/gradient/StructuredPointGradientHighOrder.h>
 #include <vtkm/filter/vector_analysis/worklet/gradient/Transpose.h>
 #include <vtkm/filter/vector_analysis/worklet/gradient/Vorticity.h>
 
 // Required for instantiations
 #include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/ArrayHandleCartesianProduct.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
 #include <vtkm/cont/ArrayHandleSOA.h>
 #include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
 #include <vtkm/cont/CoordinateSystem.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Invoker.h>
 #include <vtkm/cont/UnknownCellSet.h>
 #include <vtkm/internal/Instantiations.h>
 
@@ -155,22 +159,30 @@ struct GradientOutputFields : public vtkm::cont::ExecutionObjectBase
     : Gradient()
     , Divergence()
     , Vorticity()
+    , VorticityMagnitude()
     , QCriterion()
     , StoreGradient(true)
     , ComputeDivergence(false)
     , ComputeVorticity(false)
+    , ComputeVorticityMagnitude(false)
     , ComputeQCriterion(false)
   {
   }
 
-  GradientOutputFields(bool store, bool divergence, bool vorticity, bool qc)
+  GradientOutputFields(bool store,
+                       bool divergence,
+                       bool vorticity,
+                       bool qc,
+                       bool vorticityMagnitude = false)
     : Gradient()
     , Divergence()
     , Vorticity()
+    , VorticityMagnitude()
     , QCriterion()
     , StoreGradient(store)
     , ComputeDivergence(divergence)
     , ComputeVorticity(vorticity)
+    , ComputeVorticityMagnitude(vorticityMagnitude)
     , ComputeQCriterion(qc)
   {
   }
@@ -187,6 +199,12 @@ struct GradientOutputFields : public vtkm::cont::ExecutionObjectBase
   void SetComputeVorticity(bool enable) { ComputeVorticity = enable; }
   bool GetComputeVorticity() const { return ComputeVorticity; }
 
+  /// Add the magnitude of the voriticity/curl to the output data.
+  /// The input array must have 3 components in order to compute this.
+  /// The default is off.
+  void SetComputeVorticityMagnitude(bool enable) { ComputeVorticityMagnitude = enable; }
+  bool GetComputeVorticityMagnitude() const { return ComputeVorticityMagnitude; }
+
   /// Add Q-criterion field to the output data.
   /// The input array must have 3 components in order to compute this.
   /// The default is off.
@@ -205,10 +223,12 @@ struct GradientOutputFields : public vtkm::cont::ExecutionObjectBase
     vtkm::exec::GradientOutput<T> portal(this->StoreGradient,
                                          this->ComputeDivergence,
                                          this->ComputeVorticity,
+                                         this->ComputeVorticityMagnitude,
                                          this->ComputeQCriterion,
                                          this->Gradient,
                                          this->Divergence,
                                          this->Vorticity,
+                                         this->VorticityMagnitude,
                                          this->QCriterion,
                                          size);
     return portal;
@@ -217,12 +237,14 @@ struct GradientOutputFields : public vtkm::cont::ExecutionObjectBase
   vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>> Gradient;
   vtkm::cont::ArrayHandle<BaseTType> Divergence;
   vtkm::cont::ArrayHandle<vtkm::Vec<BaseTType, 3>> Vorticity;
+  vtkm::cont::ArrayHandle<BaseTType> VorticityMagnitude;
   vtkm::cont::ArrayHandle<BaseTType> QCriterion;
 
 private:
   bool StoreGradient;
   bool ComputeDivergence;
   bool ComputeVorticity;
+  bool ComputeVorticityMagnitude;
   bool ComputeQCriterion;
 };
 class PointGradient
@@ -253,6 +275,135 @@ public:
                                                       GradientOutputFields<T>& extraOutput);
 };
 
+/// Point gradients of uniform and rectilinear structured grids with a finite difference
+/// stencil of a selectable (even) order of accuracy.
+class StructuredPointGradientHighOrder
+{
+public:
+  /// Returns true when the cell set is structured and the coordinates are uniform or
+  /// rectilinear, which is what `Run` supports.
+  static bool IsSupported(const vtkm::cont::UnknownCellSet& cells,
+                          const vtkm::cont::CoordinateSystem& coords)
+  {
+    vtkm::Id3 pointDimensions;
+    std::vector<vtkm::Float64> axes[3];
+    return GetAxes(cells, coords, pointDimensions, axes);
+  }
+
+  template <typename T, typename S>
+  static vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>> Run(const vtkm::cont::UnknownCellSet& cells,
+                                                      const vtkm::cont::CoordinateSystem& coords,
+                                                      const vtkm::cont::ArrayHandle<T, S>& field,
+                                                      vtkm::IdComponent order,
+                                                      GradientOutputFields<T>& extraOutput)
+  {
+    vtkm::Id3 pointDimensions;
+    std::vector<vtkm::Float64> axes[3];
+    if (!GetAxes(cells, coords, pointDimensions, axes))
+    {
+      throw vtkm::cont::ErrorBadValue(
+        "Higher order gradients need a structured cell set with uniform or rectilinear points.");
+    }
+
+    const gradient::StructuredAxisStencil x(axes[0], order);
+    const gradient::StructuredAxisStencil y(axes[1], order);
+    const gradient::StructuredAxisStencil z(axes[2], order);
+
+    const vtkm::Id numPoints = pointDimensions[0] * pointDimensions[1] * pointDimensions[2];
+    vtkm::cont::Invoker invoke;
+    invoke(gradient::StructuredPointGradientHighOrder(
+             pointDimensions, vtkm::Id3(x.StencilWidth, y.StencilWidth, z.StencilWidth)),
+           vtkm::cont::ArrayHandleIndex(pointDimensions[1] * pointDimensions[2]),
+           field,
+           x.Weights,
+           x.Starts,
+           y.Weights,
+           y.Starts,
+           z.Weights,
+           z.Starts,
+           extraOutput.PrepareForOutput(numPoints));
+    return extraOutput.Gradient;
+  }
+
+private:
+  static bool GetAxes(const vtkm::cont::UnknownCellSet& cells,
+                      const vtkm::cont::CoordinateSystem& coords,
+                      vtkm::Id3& pointDimensions,
+                      std::vector<vtkm::Float64> axes[3])
+  {
+    if (cells.IsType<vtkm::cont::CellSetStructured<3>>())
+    {
+      pointDimensions = cells.AsCellSet<vtkm::cont::CellSetStructured<3>>().GetPointDimensions();
+    }
+    else if (cells.IsType<vtkm::cont::CellSetStructured<2>>())
+    {
+      const vtkm::Id2 dims =
+        cells.AsCellSet<vtkm::cont::CellSetStructured<2>>().GetPointDimensions();
+      pointDimensions = vtkm::Id3(dims[0], dims[1], 1);
+    }
+    else
+    {
+      return false;
+    }
+
+    const auto& data = coords.GetData();
+    if (data.CanConvert<vtkm::cont::ArrayHandleUniformPointCoordinates>())
+    {
+      auto uniform = data.AsArrayHandle<vtkm::cont::ArrayHandleUniformPointCoordinates>();
+      if (uniform.GetDimensions() != pointDimensions)
+      {
+        return false;
+      }
+      // Use the coordinates as the array computes them so that the stencils match the points.
+      auto portal = uniform.ReadPortal();
+      for (vtkm::IdComponent d = 0; d < 3; ++d)
+      {
+        axes[d].resize(static_cast<std::size_t>(pointDimensions[d]));
+        for (vtkm::Id i = 0; i < pointDimensions[d]; ++i)
+        {
+          vtkm::Id3 ijk(0, 0, 0);
+          ijk[d] = i;
+          axes[d][static_cast<std::size_t>(i)] = static_cast<vtkm::Float64>(portal.Get(ijk)[d]);
+        }
+      }
+      return true;
+    }
+    return GetRectilinearAxes<vtkm::Float32>(data, pointDimensions, axes) ||
+      GetRectilinearAxes<vtkm::Float64>(data, pointDimensions, axes);
+  }
+
+  template <typename CT>
+  static bool GetRectilinearAxes(const vtkm::cont::UnknownArrayHandle& data,
+                                 const vtkm::Id3& pointDimensions,
+                                 std::vector<vtkm::Float64> axes[3])
+  {
+    using AxisType = vtkm::cont::ArrayHandle<CT>;
+    using RectilinearType = vtkm::cont::ArrayHandleCartesianProduct<AxisType, AxisType, AxisType>;
+    if (!data.CanConvert<RectilinearType>())
+    {
+      return false;
+    }
+    auto rectilinear = data.AsArrayHandle<RectilinearType>();
+    const AxisType axisArrays[3] = { rectilinear.GetFirstArray(),
+                                     rectilinear.GetSecondArray(),
+                                     rectilinear.GetThirdArray() };
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      if (axisArrays[d].GetNumberOfValues() != pointDimensions[d])
+      {
+        return false;
+      }
+      auto portal = axisArrays[d].ReadPortal();
+      axes[d].resize(static_cast<std::size_t>(pointDimensions[d]));
+      for (vtkm::Id i = 0; i < pointDimensions[d]; ++i)
+      {
+        axes[d][static_cast<std::size_t>(i)] = static_cast<vtkm::Float64>(portal.Get(i));
+      }
+    }
+    return true;
+  }
+};
+
 #ifndef VTKM_GRADIENT_CHECK_WORKLET_INSTANCES
 // Declare the methods that get instances outside of the class so that they are not inline.
 // If they are inline, the compiler may decide to compile them anyway.
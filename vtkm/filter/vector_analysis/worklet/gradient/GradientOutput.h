@@ -12,6 +12,7 @@
 #define vtk_m_worklet_gradient_GradientOutput_h
 
 #include <vtkm/VecTraits.h>
+#include <vtkm/VectorAnalysis.h>
 
 #include <vtkm/cont/arg/TransportTagArrayOut.h>
 #include <vtkm/cont/arg/TransportTagExecObject.h>
@@ -75,10 +76,12 @@ struct GradientScalarOutput : public vtkm::cont::ExecutionObjectBase
                        bool,
                        bool,
                        bool,
+                       bool,
                        vtkm::cont::ArrayHandle<ValueType>& gradient,
                        vtkm::cont::ArrayHandle<BaseTType>&,
                        vtkm::cont::ArrayHandle<vtkm::Vec<BaseTType, 3>>&,
                        vtkm::cont::ArrayHandle<BaseTType>&,
+                       vtkm::cont::ArrayHandle<BaseTType>&,
                        vtkm::Id size)
     : Size(size)
     , Gradient(gradient)
@@ -102,10 +105,12 @@ struct GradientVecOutputExecutionObject
   GradientVecOutputExecutionObject(bool g,
                                    bool d,
                                    bool v,
+                                   bool vm,
                                    bool q,
                                    vtkm::cont::ArrayHandle<ValueType> gradient,
                                    vtkm::cont::ArrayHandle<BaseTType> divergence,
                                    vtkm::cont::ArrayHandle<vtkm::Vec<BaseTType, 3>> vorticity,
+                                   vtkm::cont::ArrayHandle<BaseTType> vorticityMagnitude,
                                    vtkm::cont::ArrayHandle<BaseTType> qcriterion,
                                    vtkm::Id size,
                                    vtkm::cont::DeviceAdapterId device,
@@ -114,6 +119,7 @@ struct GradientVecOutputExecutionObject
     this->SetGradient = g;
     this->SetDivergence = d;
     this->SetVorticity = v;
+    this->SetVorticityMagnitude = vm;
     this->SetQCriterion = q;
 
     if (g)
@@ -128,6 +134,10 @@ struct GradientVecOutputExecutionObject
     {
       this->VorticityPortal = vorticity.PrepareForOutput(size, device, token);
     }
+    if (vm)
+    {
+      this->VorticityMagnitudePortal = vorticityMagnitude.PrepareForOutput(size, device, token);
+    }
     if (q)
     {
       this->QCriterionPortal = qcriterion.PrepareForOutput(size, device, token);
@@ -149,12 +159,19 @@ struct GradientVecOutputExecutionObject
       divergence(value, output);
       this->DivergencePortal.Set(index, output);
     }
-    if (this->SetVorticity)
+    if (this->SetVorticity || this->SetVorticityMagnitude)
     {
       vtkm::worklet::gradient::Vorticity vorticity;
       T output;
       vorticity(value, output);
-      this->VorticityPortal.Set(index, output);
+      if (this->SetVorticity)
+      {
+        this->VorticityPortal.Set(index, output);
+      }
+      if (this->SetVorticityMagnitude)
+      {
+        this->VorticityMagnitudePortal.Set(index, vtkm::Magnitude(output));
+      }
     }
     if (this->SetQCriterion)
     {
@@ -168,11 +185,13 @@ struct GradientVecOutputExecutionObject
   bool SetGradient;
   bool SetDivergence;
   bool SetVorticity;
+  bool SetVorticityMagnitude;
   bool SetQCriterion;
 
   PortalType<ValueType> GradientPortal;
   PortalType<BaseTType> DivergencePortal;
   PortalType<vtkm::Vec<BaseTType, 3>> VorticityPortal;
+  PortalType<BaseTType> VorticityMagnitudePortal;
   PortalType<BaseTType> QCriterionPortal;
 };
 
@@ -189,10 +208,12 @@ struct GradientVecOutput : public vtkm::cont::ExecutionObjectBase
     return vtkm::exec::GradientVecOutputExecutionObject<T>(this->G,
                                                            this->D,
                                                            this->V,
+                                                           this->VM,
                                                            this->Q,
                                                            this->Gradient,
                                                            this->Divergence,
                                                            this->Vorticity,
+                                                           this->VorticityMagnitude,
                                                            this->Qcriterion,
                                                            this->Size,
                                                            device,
@@ -204,20 +225,24 @@ struct GradientVecOutput : public vtkm::cont::ExecutionObjectBase
   GradientVecOutput(bool g,
                     bool d,
                     bool v,
+                    bool vm,
                     bool q,
                     vtkm::cont::ArrayHandle<ValueType>& gradient,
                     vtkm::cont::ArrayHandle<BaseTType>& divergence,
                     vtkm::cont::ArrayHandle<vtkm::Vec<BaseTType, 3>>& vorticity,
+                    vtkm::cont::ArrayHandle<BaseTType>& vorticityMagnitude,
                     vtkm::cont::ArrayHandle<BaseTType>& qcriterion,
                     vtkm::Id size)
   {
     this->G = g;
     this->D = d;
     this->V = v;
+    this->VM = vm;
     this->Q = q;
     this->Gradient = gradient;
     this->Divergence = divergence;
     this->Vorticity = vorticity;
+    this->VorticityMagnitude = vorticityMagnitude;
     this->Qcriterion = qcriterion;
     this->Size = size;
   }
@@ -225,10 +250,12 @@ struct GradientVecOutput : public vtkm::cont::ExecutionObjectBase
   bool G;
   bool D;
   bool V;
+  bool VM;
   bool Q;
   vtkm::cont::ArrayHandle<ValueType> Gradient;
   vtkm::cont::ArrayHandle<BaseTType> Divergence;
   vtkm::cont::ArrayHandle<vtkm::Vec<BaseTType, 3>> Vorticity;
+  vtkm::cont::ArrayHandle<BaseTType> VorticityMagnitude;
   vtkm::cont::ArrayHandle<BaseTType> Qcriterion;
   vtkm::Id Size;
 };
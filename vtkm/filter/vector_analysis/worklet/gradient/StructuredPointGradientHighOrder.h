@@ -0,0 +1,199 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_gradient_StructuredPointGradientHighOrder_h
+#define vtk_m_worklet_gradient_StructuredPointGradientHighOrder_h
+
+#include <vtkm/VecTraits.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace gradient
+{
+
+/// \brief Finite difference weights of the first derivative along one axis of a grid.
+///
+/// For each of the `n` coordinates of the axis, `Weights` holds `StencilWidth` weights and
+/// `Starts` the index of the first point of the stencil. Interior points use a centered
+/// stencil. Near the ends, the stencil is shifted to stay within the axis, so every point
+/// gets the same order of accuracy. An axis with a single point has a zero derivative.
+struct StructuredAxisStencil
+{
+  vtkm::IdComponent StencilWidth = 1;
+  vtkm::cont::ArrayHandle<vtkm::Float64> Weights;
+  vtkm::cont::ArrayHandle<vtkm::Id> Starts;
+
+  StructuredAxisStencil() = default;
+
+  VTKM_CONT StructuredAxisStencil(const std::vector<vtkm::Float64>& coordinates,
+                                  vtkm::IdComponent order)
+  {
+    const vtkm::Id numPoints = static_cast<vtkm::Id>(coordinates.size());
+    this->StencilWidth =
+      static_cast<vtkm::IdComponent>(std::min(static_cast<vtkm::Id>(order + 1), numPoints));
+    const std::size_t width = static_cast<std::size_t>(this->StencilWidth);
+
+    this->Weights.Allocate(numPoints * this->StencilWidth);
+    this->Starts.Allocate(numPoints);
+    auto weightPortal = this->Weights.WritePortal();
+    auto startPortal = this->Starts.WritePortal();
+    std::vector<vtkm::Float64> weights(width);
+    for (vtkm::Id i = 0; i < numPoints; ++i)
+    {
+      const vtkm::Id start = std::max(
+        vtkm::Id(0), std::min(i - this->StencilWidth / 2, numPoints - this->StencilWidth));
+      startPortal.Set(i, start);
+      FirstDerivativeWeights(coordinates[static_cast<std::size_t>(i)],
+                             &coordinates[static_cast<std::size_t>(start)],
+                             width,
+                             weights.data());
+      for (std::size_t s = 0; s < width; ++s)
+      {
+        weightPortal.Set(i * this->StencilWidth + static_cast<vtkm::Id>(s), weights[s]);
+      }
+    }
+  }
+
+  // Weights of the first derivative at z using the values at x[0], ..., x[n-1] (B. Fornberg,
+  // "Generation of finite difference formulas on arbitrarily spaced grids", 1988).
+  static void FirstDerivativeWeights(vtkm::Float64 z,
+                                     const vtkm::Float64* x,
+                                     std::size_t n,
+                                     vtkm::Float64* weights)
+  {
+    // c[j][0] are the interpolation weights and c[j][1] the first derivative weights.
+    std::vector<vtkm::Vec2f_64> c(n, vtkm::Vec2f_64(0, 0));
+    c[0][0] = 1;
+    vtkm::Float64 c1 = 1;
+    vtkm::Float64 c4 = x[0] - z;
+    for (std::size_t i = 1; i < n; ++i)
+    {
+      vtkm::Float64 c2 = 1;
+      const vtkm::Float64 c5 = c4;
+      c4 = x[i] - z;
+      for (std::size_t j = 0; j < i; ++j)
+      {
+        const vtkm::Float64 c3 = x[i] - x[j];
+        c2 *= c3;
+        if (j == i - 1)
+        {
+          c[i][1] = c1 * (c[i - 1][0] - c5 * c[i - 1][1]) / c2;
+          c[i][0] = -c1 * c5 * c[i - 1][0] / c2;
+        }
+        c[j][1] = (c4 * c[j][1] - c[j][0]) / c3;
+        c[j][0] = c4 * c[j][0] / c3;
+      }
+      c1 = c2;
+    }
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      weights[j] = n > 1 ? c[j][1] : 0;
+    }
+  }
+};
+
+/// \brief Computes point gradients of a uniform or rectilinear grid with wide stencils.
+///
+/// Each invocation handles one row of points along x. The stencil weights along y and z
+/// are the same for the whole row, so they are loaded once and the row is then swept with
+/// unit stride through the field. The gradient is written to a `GradientOutput` execution
+/// object, which also derives the requested divergence, vorticity and Q-criterion.
+class StructuredPointGradientHighOrder : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn rowIndex,
+                                WholeArrayIn field,
+                                WholeArrayIn xWeights,
+                                WholeArrayIn xStarts,
+                                WholeArrayIn yWeights,
+                                WholeArrayIn yStarts,
+                                WholeArrayIn zWeights,
+                                WholeArrayIn zStarts,
+                                ExecObject outputFields);
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6, _7, _8, _9);
+
+  VTKM_CONT StructuredPointGradientHighOrder(const vtkm::Id3& pointDimensions,
+                                             const vtkm::Id3& stencilWidths)
+    : PointDimensions(pointDimensions)
+    , StencilWidths(stencilWidths)
+  {
+  }
+
+  template <typename FieldPortalType,
+            typename WeightPortalType,
+            typename StartPortalType,
+            typename OutputType>
+  VTKM_EXEC void operator()(vtkm::Id rowIndex,
+                            const FieldPortalType& field,
+                            const WeightPortalType& xWeights,
+                            const StartPortalType& xStarts,
+                            const WeightPortalType& yWeights,
+                            const StartPortalType& yStarts,
+                            const WeightPortalType& zWeights,
+                            const StartPortalType& zStarts,
+                            const OutputType& outputFields) const
+  {
+    using ValueType = typename FieldPortalType::ValueType;
+    using ComponentType = typename vtkm::VecTraits<ValueType>::BaseComponentType;
+
+    const vtkm::Id nx = this->PointDimensions[0];
+    const vtkm::Id ny = this->PointDimensions[1];
+    const vtkm::Id j = rowIndex % ny;
+    const vtkm::Id k = rowIndex / ny;
+    const vtkm::Id rowStart = rowIndex * nx;
+
+    // The y and z stencils are the same for every point of the row.
+    const vtkm::Id yFirst = (yStarts.Get(j) + ny * k) * nx;
+    const vtkm::Id zFirst = (j + ny * zStarts.Get(k)) * nx;
+    const vtkm::Id yWeightStart = j * this->StencilWidths[1];
+    const vtkm::Id zWeightStart = k * this->StencilWidths[2];
+
+    for (vtkm::Id i = 0; i < nx; ++i)
+    {
+      vtkm::Vec<ValueType, 3> gradient(ValueType(0));
+
+      const vtkm::Id xFirst = rowStart + xStarts.Get(i);
+      for (vtkm::Id s = 0; s < this->StencilWidths[0]; ++s)
+      {
+        const auto weight =
+          static_cast<ComponentType>(xWeights.Get(i * this->StencilWidths[0] + s));
+        gradient[0] = gradient[0] + field.Get(xFirst + s) * weight;
+      }
+      for (vtkm::Id s = 0; s < this->StencilWidths[1]; ++s)
+      {
+        const auto weight = static_cast<ComponentType>(yWeights.Get(yWeightStart + s));
+        gradient[1] = gradient[1] + field.Get(yFirst + s * nx + i) * weight;
+      }
+      for (vtkm::Id s = 0; s < this->StencilWidths[2]; ++s)
+      {
+        const auto weight = static_cast<ComponentType>(zWeights.Get(zWeightStart + s));
+        gradient[2] = gradient[2] + field.Get(zFirst + s * nx * ny + i) * weight;
+      }
+
+      outputFields.Set(rowStart + i, gradient);
+    }
+  }
+
+private:
+  vtkm::Id3 PointDimensions;
+  vtkm::Id3 StencilWidths;
+};
+}
+}
+}
+
+#endif
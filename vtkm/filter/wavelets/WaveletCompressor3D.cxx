@@ -0,0 +1,68 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/CellSetStructured.h>
+
+#include <vtkm/filter/wavelets/WaveletCompressor3D.h>
+
+#include <vtkm/worklet/WaveletCompressor.h>
+#include <vtkm/worklet/wavelets/BitPlaneCoder.h>
+#include <vtkm/worklet/wavelets/WaveletLifting.h>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace wavelets
+{
+//-----------------------------------------------------------------------------
+VTKM_CONT vtkm::cont::DataSet WaveletCompressor3D::DoExecute(const vtkm::cont::DataSet& input)
+{
+  vtkm::cont::CellSetStructured<3> cellSet;
+  input.GetCellSet().AsCellSet(cellSet);
+  vtkm::Id3 pointDimensions = cellSet.GetPointDimensions();
+
+  vtkm::worklet::wavelets::WaveletName name = (this->Wavelet == WaveletType::CDF5_3)
+    ? vtkm::worklet::wavelets::CDF5_3
+    : vtkm::worklet::wavelets::CDF9_7;
+  vtkm::Id levels = vtkm::worklet::wavelets::WaveletLifting::GetMaxLevel(pointDimensions);
+  if (this->NumberOfLevels >= 0 && this->NumberOfLevels < levels)
+  {
+    levels = this->NumberOfLevels;
+  }
+
+  // The transform works in place, so it gets its own copy of the field.
+  vtkm::cont::ArrayHandle<vtkm::Float64> coeffs;
+  vtkm::cont::ArrayCopy(this->GetFieldFromDataSet(input).GetData(), coeffs);
+
+  vtkm::worklet::wavelets::WaveletLifting lifting(name);
+  lifting.Decompose3D(coeffs, pointDimensions, levels);
+
+  vtkm::worklet::WaveletCompressor compressor(name);
+  compressor.SquashCoefficients(coeffs, this->CompressionRatio);
+
+  // The stream records the transform so that the decompressor does not need to be told.
+  vtkm::worklet::wavelets::BitPlaneCoder::Transform transform;
+  transform.Wavelet = name;
+  transform.Levels = levels;
+  transform.Dimensions = pointDimensions;
+  vtkm::worklet::wavelets::BitPlaneCoder coder;
+  vtkm::cont::ArrayHandle<vtkm::Int64> compressed =
+    coder.Encode(coeffs, this->NumberOfBitPlanes, transform);
+
+  // Like the ZFP compressor, the stream is a WholeDataSet field because its size does not match
+  // the number of points.
+  return this->CreateResultField(
+    input, "compressed", vtkm::cont::Field::Association::WholeDataSet, compressed);
+}
+} // namespace wavelets
+} // namespace filter
+} // namespace vtkm
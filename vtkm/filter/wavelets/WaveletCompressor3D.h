@@ -0,0 +1,89 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_filter_wavelets_WaveletCompressor3D_h
+#define vtk_m_filter_wavelets_WaveletCompressor3D_h
+
+#include <vtkm/filter/Filter.h>
+#include <vtkm/filter/wavelets/vtkm_filter_wavelets_export.h>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace wavelets
+{
+
+/// @brief The wavelets supported by `WaveletCompressor3D` and `WaveletDecompressor3D`.
+enum struct WaveletType
+{
+  /// The CDF 9/7 wavelet, which is used by lossy JPEG 2000.
+  CDF9_7,
+  /// The CDF 5/3 wavelet, which is used by lossless JPEG 2000.
+  CDF5_3
+};
+
+/// \brief Compress a scalar field with a wavelet transform.
+///
+/// The field is transformed in place with the lifting scheme over several levels. The smallest
+/// coefficients are then set to zero to reach a target compression ratio, and the coefficients
+/// are encoded as a progressive stream of bit planes, which is written to a `WholeDataSet`
+/// field named `compressed`.
+///
+/// The stream can be decoded with `WaveletDecompressor3D`, which can read only the first bit
+/// planes to reconstruct the field at a lower fidelity.
+/// @warning
+/// This filter currently only supports 3D structured cell sets.
+class VTKM_FILTER_WAVELETS_EXPORT WaveletCompressor3D : public vtkm::filter::Filter
+{
+public:
+  /// @brief Specifies the wavelet. The default is CDF 9/7.
+  void SetWavelet(vtkm::filter::wavelets::WaveletType wavelet) { this->Wavelet = wavelet; }
+  /// @copydoc SetWavelet
+  vtkm::filter::wavelets::WaveletType GetWavelet() const { return this->Wavelet; }
+
+  /// @brief Specifies the number of levels of the transform.
+  ///
+  /// A negative value (the default) uses as many levels as the dimensions allow. Larger values
+  /// are limited to that number. The number of levels is recorded in the compressed stream.
+  void SetNumberOfLevels(vtkm::Id levels) { this->NumberOfLevels = levels; }
+  /// @copydoc SetNumberOfLevels
+  vtkm::Id GetNumberOfLevels() const { return this->NumberOfLevels; }
+
+  /// @brief Specifies the ratio of all coefficients to the coefficients that are kept.
+  ///
+  /// A ratio of 10 keeps the largest tenth of the coefficients and sets the others to zero.
+  /// The default of 1 keeps all of them.
+  void SetCompressionRatio(vtkm::Float64 ratio) { this->CompressionRatio = ratio; }
+  /// @copydoc SetCompressionRatio
+  vtkm::Float64 GetCompressionRatio() const { return this->CompressionRatio; }
+
+  /// @brief Specifies the number of bit planes used to encode the coefficient magnitudes.
+  ///
+  /// More planes give a more accurate result and a larger stream. The default is 32 and the
+  /// maximum is 62.
+  void SetNumberOfBitPlanes(vtkm::Id planes) { this->NumberOfBitPlanes = planes; }
+  /// @copydoc SetNumberOfBitPlanes
+  vtkm::Id GetNumberOfBitPlanes() const { return this->NumberOfBitPlanes; }
+
+private:
+  VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
+
+  vtkm::filter::wavelets::WaveletType Wavelet = vtkm::filter::wavelets::WaveletType::CDF9_7;
+  vtkm::Id NumberOfLevels = -1;
+  vtkm::Float64 CompressionRatio = 1;
+  vtkm::Id NumberOfBitPlanes = 32;
+};
+
+} // namespace wavelets
+} // namespace filter
+} // namespace vtkm
+
+#endif // vtk_m_filter_wavelets_WaveletCompressor3D_h
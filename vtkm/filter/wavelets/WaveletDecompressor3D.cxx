@@ -0,0 +1,61 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/ErrorFilterExecution.h>
+
+#include <vtkm/filter/wavelets/WaveletDecompressor3D.h>
+
+#include <vtkm/worklet/wavelets/BitPlaneCoder.h>
+#include <vtkm/worklet/wavelets/WaveletLifting.h>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace wavelets
+{
+//-----------------------------------------------------------------------------
+VTKM_CONT vtkm::cont::DataSet WaveletDecompressor3D::DoExecute(const vtkm::cont::DataSet& input)
+{
+  vtkm::cont::CellSetStructured<3> cellSet;
+  input.GetCellSet().AsCellSet(cellSet);
+  vtkm::Id3 pointDimensions = cellSet.GetPointDimensions();
+
+  vtkm::cont::ArrayHandle<vtkm::Int64> compressed;
+  vtkm::cont::ArrayCopyShallowIfPossible(this->GetFieldFromDataSet(input).GetData(), compressed);
+
+  // The wavelet, levels and dimensions of the transform are read from the stream header.
+  const vtkm::worklet::wavelets::BitPlaneCoder::Transform transform =
+    vtkm::worklet::wavelets::BitPlaneCoder::GetTransform(compressed);
+  if (transform.Dimensions != pointDimensions)
+  {
+    throw vtkm::cont::ErrorFilterExecution(
+      "Compressed wavelet stream does not match the point dimensions.");
+  }
+
+  vtkm::worklet::wavelets::BitPlaneCoder coder;
+  vtkm::cont::ArrayHandle<vtkm::Float64> decompressed;
+  coder.Decode(compressed, decompressed, this->NumberOfBitPlanes);
+  if (decompressed.GetNumberOfValues() != cellSet.GetNumberOfPoints())
+  {
+    throw vtkm::cont::ErrorFilterExecution(
+      "Compressed wavelet stream does not match the number of points.");
+  }
+
+  vtkm::worklet::wavelets::WaveletLifting lifting(transform.Wavelet);
+  lifting.Reconstruct3D(decompressed, pointDimensions, transform.Levels);
+
+  return this->CreateResultFieldPoint(input, "decompressed", decompressed);
+}
+} // namespace wavelets
+} // namespace filter
+} // namespace vtkm
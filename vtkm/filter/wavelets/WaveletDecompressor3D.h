@@ -0,0 +1,54 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_filter_wavelets_WaveletDecompressor3D_h
+#define vtk_m_filter_wavelets_WaveletDecompressor3D_h
+
+#include <vtkm/filter/Filter.h>
+#include <vtkm/filter/wavelets/WaveletCompressor3D.h>
+#include <vtkm/filter/wavelets/vtkm_filter_wavelets_export.h>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace wavelets
+{
+
+/// \brief Decompress a scalar field compressed with `WaveletCompressor3D`.
+///
+/// Takes as input the `compressed` field of `WaveletCompressor3D` and generates a point field
+/// named `decompressed`. The wavelet, the number of levels and the dimensions are read from
+/// the stream, and the dimensions must match the point dimensions of the input.
+/// @warning
+/// This filter currently only supports 3D structured cell sets.
+class VTKM_FILTER_WAVELETS_EXPORT WaveletDecompressor3D : public vtkm::filter::Filter
+{
+public:
+  /// @brief Specifies the number of bit planes to read.
+  ///
+  /// Reading fewer planes than were compressed is faster and gives a coarser result. The
+  /// default of 0 reads every plane in the stream. The stream may also have been truncated
+  /// to fewer planes after it was compressed.
+  void SetNumberOfBitPlanes(vtkm::Id planes) { this->NumberOfBitPlanes = planes; }
+  /// @copydoc SetNumberOfBitPlanes
+  vtkm::Id GetNumberOfBitPlanes() const { return this->NumberOfBitPlanes; }
+
+private:
+  VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
+
+  vtkm::Id NumberOfBitPlanes = 0;
+};
+
+} // namespace wavelets
+} // namespace filter
+} // namespace vtkm
+
+#endif // vtk_m_filter_wavelets_WaveletDecompressor3D_h
@@ -0,0 +1,160 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
+#include <vtkm/cont/ErrorFilterExecution.h>
+#include <vtkm/cont/testing/Testing.h>
+
+#include <vtkm/filter/wavelets/WaveletCompressor3D.h>
+#include <vtkm/filter/wavelets/WaveletDecompressor3D.h>
+
+namespace
+{
+
+vtkm::cont::DataSet MakeInput()
+{
+  const vtkm::Id3 dims(24, 17, 9);
+  vtkm::cont::DataSet dataSet = vtkm::cont::DataSetBuilderUniform::Create(dims);
+  std::vector<vtkm::Float64> values(static_cast<std::size_t>(dims[0] * dims[1] * dims[2]));
+  std::size_t index = 0;
+  for (vtkm::Id k = 0; k < dims[2]; ++k)
+  {
+    for (vtkm::Id j = 0; j < dims[1]; ++j)
+    {
+      for (vtkm::Id i = 0; i < dims[0]; ++i)
+      {
+        values[index++] = 10 * vtkm::Sin(0.3 * static_cast<vtkm::Float64>(i)) *
+            vtkm::Cos(0.2 * static_cast<vtkm::Float64>(j)) +
+          0.5 * static_cast<vtkm::Float64>(k);
+      }
+    }
+  }
+  dataSet.AddPointField("pointvar", values);
+  return dataSet;
+}
+
+vtkm::Float64 MaxError(const vtkm::cont::DataSet& input, const vtkm::cont::DataSet& output)
+{
+  vtkm::cont::ArrayHandle<vtkm::Float64> original;
+  vtkm::cont::ArrayHandle<vtkm::Float64> result;
+  input.GetField("pointvar").GetData().AsArrayHandle(original);
+  output.GetField("decompressed").GetData().AsArrayHandle(result);
+  VTKM_TEST_ASSERT(original.GetNumberOfValues() == result.GetNumberOfValues());
+
+  auto originalPortal = original.ReadPortal();
+  auto resultPortal = result.ReadPortal();
+  vtkm::Float64 maxError = 0;
+  for (vtkm::Id i = 0; i < original.GetNumberOfValues(); ++i)
+  {
+    maxError = vtkm::Max(maxError, vtkm::Abs(originalPortal.Get(i) - resultPortal.Get(i)));
+  }
+  return maxError;
+}
+
+void TestRoundTrip(vtkm::filter::wavelets::WaveletType wavelet)
+{
+  std::cout << "Testing wavelet compressor round trip" << std::endl;
+  vtkm::cont::DataSet input = MakeInput();
+
+  vtkm::filter::wavelets::WaveletCompressor3D compressor;
+  compressor.SetActiveField("pointvar");
+  compressor.SetWavelet(wavelet);
+  compressor.SetNumberOfBitPlanes(40);
+  vtkm::cont::DataSet compressed = compressor.Execute(input);
+  VTKM_TEST_ASSERT(compressed.HasField("compressed", vtkm::cont::Field::Association::WholeDataSet));
+
+  vtkm::filter::wavelets::WaveletDecompressor3D decompressor;
+  decompressor.SetActiveField("compressed");
+  vtkm::Float64 fullError = MaxError(input, decompressor.Execute(compressed));
+  std::cout << "  error with all planes: " << fullError << std::endl;
+  VTKM_TEST_ASSERT(fullError < 1e-6, "Round trip error too large.");
+
+  // Reading fewer planes gives a coarser, but still bounded, reconstruction.
+  decompressor.SetNumberOfBitPlanes(10);
+  vtkm::Float64 coarseError = MaxError(input, decompressor.Execute(compressed));
+  std::cout << "  error with 10 planes: " << coarseError << std::endl;
+  VTKM_TEST_ASSERT(coarseError > fullError, "Fewer planes should be less accurate.");
+  VTKM_TEST_ASSERT(coarseError < 1.0, "Error with 10 planes too large.");
+}
+
+void TestTransformFromStream()
+{
+  std::cout << "Testing that the decompressor reads the transform from the stream" << std::endl;
+  vtkm::cont::DataSet input = MakeInput();
+
+  vtkm::filter::wavelets::WaveletCompressor3D compressor;
+  compressor.SetActiveField("pointvar");
+  compressor.SetWavelet(vtkm::filter::wavelets::WaveletType::CDF5_3);
+  compressor.SetNumberOfLevels(1);
+  compressor.SetNumberOfBitPlanes(40);
+  vtkm::cont::DataSet compressed = compressor.Execute(input);
+
+  vtkm::filter::wavelets::WaveletDecompressor3D decompressor;
+  decompressor.SetActiveField("compressed");
+  vtkm::Float64 error = MaxError(input, decompressor.Execute(compressed));
+  std::cout << "  error: " << error << std::endl;
+  VTKM_TEST_ASSERT(error < 1e-6, "Transform not read from the stream.");
+
+  // A stream cannot be reconstructed on a grid of other dimensions.
+  vtkm::cont::DataSet otherGrid = vtkm::cont::DataSetBuilderUniform::Create(vtkm::Id3(17, 24, 9));
+  otherGrid.AddField(compressed.GetField("compressed"));
+  bool threw = false;
+  try
+  {
+    decompressor.Execute(otherGrid);
+  }
+  catch (const vtkm::cont::ErrorFilterExecution&)
+  {
+    threw = true;
+  }
+  VTKM_TEST_ASSERT(threw, "Stream with other dimensions was not rejected.");
+}
+
+void TestCompressionRatio()
+{
+  std::cout << "Testing wavelet compressor with a compression ratio" << std::endl;
+  vtkm::cont::DataSet input = MakeInput();
+
+  vtkm::filter::wavelets::WaveletCompressor3D compressor;
+  compressor.SetActiveField("pointvar");
+  vtkm::cont::ArrayHandle<vtkm::Int64> full;
+  compressor.Execute(input).GetField("compressed").GetData().AsArrayHandle(full);
+
+  compressor.SetCompressionRatio(10);
+  vtkm::cont::DataSet compressed = compressor.Execute(input);
+  vtkm::cont::ArrayHandle<vtkm::Int64> squashed;
+  compressed.GetField("compressed").GetData().AsArrayHandle(squashed);
+  std::cout << "  stream sizes: " << full.GetNumberOfValues() << " and "
+            << squashed.GetNumberOfValues() << std::endl;
+  VTKM_TEST_ASSERT(squashed.GetNumberOfValues() < full.GetNumberOfValues(),
+                   "Compression ratio did not shrink the stream.");
+
+  vtkm::filter::wavelets::WaveletDecompressor3D decompressor;
+  decompressor.SetActiveField("compressed");
+  vtkm::Float64 error = MaxError(input, decompressor.Execute(compressed));
+  std::cout << "  error: " << error << std::endl;
+  VTKM_TEST_ASSERT(error < 2.0, "Error with compression ratio 10 too large.");
+}
+
+void TestWaveletCompressorFilter()
+{
+  TestRoundTrip(vtkm::filter::wavelets::WaveletType::CDF9_7);
+  TestRoundTrip(vtkm::filter::wavelets::WaveletType::CDF5_3);
+  TestTransformFromStream();
+  TestCompressionRatio();
+}
+
+} // anonymous namespace
+
+int UnitTestWaveletCompressorFilter(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(TestWaveletCompressorFilter, argc, argv);
+}
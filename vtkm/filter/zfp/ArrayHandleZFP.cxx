@@ -0,0 +1,33 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/filter/zfp/ArrayHandleZFP.h>
+
+#include <atomic>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace zfp
+{
+namespace detail
+{
+
+vtkm::UInt64 NextArrayPortalZFPId()
+{
+  static std::atomic<vtkm::UInt64> lastId(0);
+  return ++lastId;
+}
+
+}
+}
+}
+} // namespace vtkm::filter::zfp::detail
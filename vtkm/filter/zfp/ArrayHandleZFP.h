@@ -0,0 +1,399 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+#ifndef vtk_m_filter_zfp_ArrayHandleZFP_h
+#define vtk_m_filter_zfp_ArrayHandleZFP_h
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ErrorBadValue.h>
+
+#include <vtkm/filter/zfp/vtkm_filter_zfp_export.h>
+#include <vtkm/filter/zfp/worklet/zfp/ZFPDecode.h>
+#include <vtkm/filter/zfp/worklet/zfp/ZFPStructs.h>
+
+namespace vtkm
+{
+namespace filter
+{
+namespace zfp
+{
+
+namespace detail
+{
+
+/// Returns a new identifier for each `ArrayPortalZFP` created for an array. Identifiers are
+/// never reused, so a decoded block cached for one portal is never mistaken for a block of
+/// another.
+VTKM_FILTER_ZFP_EXPORT vtkm::UInt64 NextArrayPortalZFPId();
+
+/// The block of an `ArrayPortalZFP` that a host thread decoded last.
+template <typename T>
+struct ZFPDecodedBlock
+{
+  vtkm::UInt64 PortalId = 0;
+  vtkm::Id BlockIndex = -1;
+  T Values[64];
+};
+
+} // namespace detail
+
+/// @brief Describes how the values of an `ArrayHandleZFP` are laid out in the ZFP stream.
+struct ZFPArrayMetaData
+{
+  /// The logical dimensions of the (point) field that was compressed.
+  vtkm::Id3 Dims = { 0, 0, 0 };
+  /// The number of bits each 4x4x4 block occupies in the stream (fixed-rate mode), or the
+  /// most bits a block can occupy (fixed-accuracy and fixed-precision modes).
+  vtkm::UInt32 MaxBits = 0;
+  /// The most bit planes kept for each block.
+  vtkm::Int32 MaxPrec = ZFP_MAX_PREC;
+  /// The smallest bit plane kept for each block.
+  vtkm::Int32 MinExp = ZFP_MIN_EXP;
+};
+
+/// @brief A read-only portal that decodes values from a 3D ZFP stream on access.
+///
+/// In fixed-rate mode, blocks are found from their index. In the other modes, the blocks vary in
+/// size and are found with an index of the bit offset of each block.
+///
+/// `Get` decodes the 4x4x4 block holding the requested value. On host devices, each thread
+/// keeps the block it decoded last, so reading consecutive values of a block decodes it only
+/// once. The cache is kept per thread rather than in the portal because the threads of a
+/// worklet share one portal. On GPU devices every `Get` decodes its block. A caller that needs
+/// all values of a block can decode it once with `DecodeBlock`.
+template <typename T, typename WordsPortalType, typename OffsetsPortalType>
+class VTKM_ALWAYS_EXPORT ArrayPortalZFP
+{
+public:
+  using ValueType = T;
+  static constexpr vtkm::IdComponent BlockSize = 64;
+
+  ArrayPortalZFP() = default;
+
+  VTKM_CONT ArrayPortalZFP(const WordsPortalType& words,
+                           const OffsetsPortalType& offsets,
+                           const ZFPArrayMetaData& metaData)
+    : Words(words)
+    , Offsets(offsets)
+    , PortalId(detail::NextArrayPortalZFPId())
+    , Dims(metaData.Dims)
+    , MaxBits(metaData.MaxBits)
+    , MaxPrec(metaData.MaxPrec)
+    , MinExp(metaData.MinExp)
+  {
+    this->BlockDims[0] = (this->Dims[0] + 3) / 4;
+    this->BlockDims[1] = (this->Dims[1] + 3) / 4;
+    this->BlockDims[2] = (this->Dims[2] + 3) / 4;
+  }
+
+  VTKM_EXEC_CONT vtkm::Id GetNumberOfValues() const
+  {
+    return this->Dims[0] * this->Dims[1] * this->Dims[2];
+  }
+
+  VTKM_SUPPRESS_EXEC_WARNINGS
+  VTKM_EXEC_CONT ValueType Get(vtkm::Id index) const
+  {
+    const vtkm::Id i = index % this->Dims[0];
+    const vtkm::Id j = (index / this->Dims[0]) % this->Dims[1];
+    const vtkm::Id k = index / (this->Dims[0] * this->Dims[1]);
+
+    const vtkm::Id blockIndex = this->GetBlockIndex(vtkm::Id3(i / 4, j / 4, k / 4));
+    const vtkm::Id valueIndex = ((k % 4) * 4 + (j % 4)) * 4 + (i % 4);
+#if defined(VTKM_CUDA_DEVICE_PASS) || defined(VTKM_HIP)
+    ValueType block[BlockSize];
+    this->DecodeBlock(blockIndex, block);
+    return block[valueIndex];
+#else
+    static thread_local detail::ZFPDecodedBlock<ValueType> cache;
+    if ((cache.PortalId != this->PortalId) || (cache.BlockIndex != blockIndex))
+    {
+      this->DecodeBlock(blockIndex, cache.Values);
+      cache.PortalId = this->PortalId;
+      cache.BlockIndex = blockIndex;
+    }
+    return cache.Values[valueIndex];
+#endif
+  }
+
+  /// Returns the number of 4x4x4 blocks along each dimension.
+  VTKM_EXEC_CONT vtkm::Id3 GetBlockDimensions() const { return this->BlockDims; }
+
+  /// Returns the dimensions of the field.
+  VTKM_EXEC_CONT vtkm::Id3 GetDimensions() const { return this->Dims; }
+
+  /// Converts the logical index of a block to its position in the stream.
+  VTKM_EXEC_CONT vtkm::Id GetBlockIndex(const vtkm::Id3& block) const
+  {
+    return (block[2] * this->BlockDims[1] + block[1]) * this->BlockDims[0] + block[0];
+  }
+
+  /// Decodes all 64 values of a block. The values are ordered with x varying fastest.
+  /// Values of partial blocks past the end of the field are undefined.
+  VTKM_SUPPRESS_EXEC_WARNINGS
+  VTKM_EXEC_CONT void DecodeBlock(vtkm::Id blockIndex, ValueType* values) const
+  {
+    for (vtkm::IdComponent index = 0; index < BlockSize; ++index)
+    {
+      values[index] = ValueType(0);
+    }
+    if (this->Offsets.GetNumberOfValues() > 0)
+    {
+      vtkm::worklet::zfp::zfp_decode<BlockSize>(
+        values,
+        static_cast<vtkm::Int32>(this->MaxBits),
+        this->MaxPrec,
+        this->MinExp,
+        vtkm::worklet::zfp::BlockBitOffset{ this->Offsets.Get(blockIndex) },
+        this->Words);
+    }
+    else
+    {
+      vtkm::worklet::zfp::zfp_decode<BlockSize>(values,
+                                                static_cast<vtkm::Int32>(this->MaxBits),
+                                                static_cast<vtkm::UInt32>(blockIndex),
+                                                this->Words);
+    }
+  }
+
+private:
+  WordsPortalType Words;
+  OffsetsPortalType Offsets;
+  vtkm::UInt64 PortalId = 0;
+  vtkm::Id3 Dims = { 0, 0, 0 };
+  vtkm::Id3 BlockDims = { 0, 0, 0 };
+  vtkm::UInt32 MaxBits = 0;
+  vtkm::Int32 MaxPrec = ZFP_MAX_PREC;
+  vtkm::Int32 MinExp = ZFP_MIN_EXP;
+};
+
+/// @brief Storage tag for arrays that are decoded from a ZFP stream on access.
+struct VTKM_ALWAYS_EXPORT StorageTagZFP
+{
+};
+
+} // namespace zfp
+} // namespace filter
+
+namespace cont
+{
+namespace internal
+{
+
+template <typename T>
+class VTKM_ALWAYS_EXPORT Storage<T, vtkm::filter::zfp::StorageTagZFP>
+{
+  using WordsStorage = vtkm::cont::internal::Storage<vtkm::Int64, vtkm::cont::StorageTagBasic>;
+  using OffsetsStorage = vtkm::cont::internal::Storage<vtkm::Id, vtkm::cont::StorageTagBasic>;
+  using MetaDataType = vtkm::filter::zfp::ZFPArrayMetaData;
+
+  // Buffers are laid out as the meta data, the compressed words, and the block offsets.
+  static std::vector<vtkm::cont::internal::Buffer> WordsBuffers(
+    const std::vector<vtkm::cont::internal::Buffer>& buffers)
+  {
+    return std::vector<vtkm::cont::internal::Buffer>(buffers.begin() + 1, buffers.begin() + 2);
+  }
+
+  static std::vector<vtkm::cont::internal::Buffer> OffsetsBuffers(
+    const std::vector<vtkm::cont::internal::Buffer>& buffers)
+  {
+    return std::vector<vtkm::cont::internal::Buffer>(buffers.begin() + 2, buffers.end());
+  }
+
+public:
+  VTKM_STORAGE_NO_RESIZE;
+  VTKM_STORAGE_NO_WRITE_PORTAL;
+
+  using ReadPortalType = vtkm::filter::zfp::ArrayPortalZFP<T,
+                                                           typename WordsStorage::ReadPortalType,
+                                                           typename OffsetsStorage::ReadPortalType>;
+
+  VTKM_CONT static vtkm::IdComponent GetNumberOfComponentsFlat(
+    const std::vector<vtkm::cont::internal::Buffer>&)
+  {
+    return 1;
+  }
+
+  VTKM_CONT static vtkm::Id GetNumberOfValues(
+    const std::vector<vtkm::cont::internal::Buffer>& buffers)
+  {
+    const vtkm::Id3 dims = buffers[0].GetMetaData<MetaDataType>().Dims;
+    return dims[0] * dims[1] * dims[2];
+  }
+
+  VTKM_CONT static ReadPortalType CreateReadPortal(
+    const std::vector<vtkm::cont::internal::Buffer>& buffers,
+    vtkm::cont::DeviceAdapterId device,
+    vtkm::cont::Token& token)
+  {
+    return ReadPortalType(
+      WordsStorage::CreateReadPortal(WordsBuffers(buffers), device, token),
+      OffsetsStorage::CreateReadPortal(OffsetsBuffers(buffers), device, token),
+      buffers[0].GetMetaData<MetaDataType>());
+  }
+
+  VTKM_CONT static std::vector<vtkm::cont::internal::Buffer> CreateBuffers(
+    const MetaDataType& metaData = MetaDataType{},
+    const vtkm::cont::ArrayHandle<vtkm::Int64>& words = vtkm::cont::ArrayHandle<vtkm::Int64>{},
+    const vtkm::cont::ArrayHandle<vtkm::Id>& offsets = vtkm::cont::ArrayHandle<vtkm::Id>{})
+  {
+    return vtkm::cont::internal::CreateBuffers(metaData, words, offsets);
+  }
+
+  VTKM_CONT static MetaDataType GetMetaData(
+    const std::vector<vtkm::cont::internal::Buffer>& buffers)
+  {
+    return buffers[0].GetMetaData<MetaDataType>();
+  }
+
+  VTKM_CONT static vtkm::cont::ArrayHandle<vtkm::Int64> GetCompressedArray(
+    const std::vector<vtkm::cont::internal::Buffer>& buffers)
+  {
+    return vtkm::cont::ArrayHandle<vtkm::Int64>(WordsBuffers(buffers));
+  }
+
+  VTKM_CONT static vtkm::cont::ArrayHandle<vtkm::Id> GetBlockOffsets(
+    const std::vector<vtkm::cont::internal::Buffer>& buffers)
+  {
+    return vtkm::cont::ArrayHandle<vtkm::Id>(OffsetsBuffers(buffers));
+  }
+};
+
+} // namespace internal
+} // namespace cont
+
+namespace filter
+{
+namespace zfp
+{
+
+/// @brief A read-only array whose values are decoded from a 3D ZFP stream.
+///
+/// `ArrayHandleZFP` wraps the array produced by `ZFPCompressor3D` (or
+/// `vtkm::worklet::ZFPCompressor`) so that the field can be used without first
+/// decompressing all of it. Only the compressed words are held in memory, and each value is
+/// decoded from its 4x4x4 block when it is read. This trades computation for memory: an array
+/// that is read repeatedly in full is better decompressed once with `ZFPDecompressor3D`.
+///
+/// The memory is only saved by worklets that read the array directly. Most filters cast their
+/// input fields to basic arrays, which copies and thereby decompresses the whole field.
+///
+/// The value type must match the type of the field that was compressed. `ZFPDecompressor3D`
+/// only creates arrays of `vtkm::Float64`.
+template <typename T>
+class VTKM_ALWAYS_EXPORT ArrayHandleZFP
+  : public vtkm::cont::ArrayHandle<T, vtkm::filter::zfp::StorageTagZFP>
+{
+public:
+  VTKM_ARRAY_HANDLE_SUBCLASS(ArrayHandleZFP,
+                             (ArrayHandleZFP<T>),
+                             (vtkm::cont::ArrayHandle<T, vtkm::filter::zfp::StorageTagZFP>));
+
+  /// @brief Create an array from a stream compressed in fixed-rate mode.
+  ///
+  /// @param compressed The compressed words.
+  /// @param dims The dimensions of the field that was compressed.
+  /// @param rate The rate, in bits per value, used to compress the field.
+  VTKM_CONT ArrayHandleZFP(const vtkm::cont::ArrayHandle<vtkm::Int64>& compressed,
+                           const vtkm::Id3& dims,
+                           vtkm::Float64 rate)
+    : Superclass(StorageType::CreateBuffers(MakeMetaData(dims, rate), compressed))
+  {
+  }
+
+  /// @brief Create an array from a stream compressed in any mode.
+  ///
+  /// @param compressed The compressed words.
+  /// @param blockOffsets The bit offset of each block, as produced by
+  ///   `vtkm::worklet::ZFPCompressor`.
+  /// @param dims The dimensions of the field that was compressed.
+  /// @param stream The compression mode used to compress the field.
+  VTKM_CONT ArrayHandleZFP(const vtkm::cont::ArrayHandle<vtkm::Int64>& compressed,
+                           const vtkm::cont::ArrayHandle<vtkm::Id>& blockOffsets,
+                           const vtkm::Id3& dims,
+                           const vtkm::worklet::zfp::ZFPStream& stream)
+    : Superclass(StorageType::CreateBuffers(MakeMetaData(dims, stream), compressed, blockOffsets))
+  {
+    const vtkm::Id numBlocks = ((dims[0] + 3) / 4) * ((dims[1] + 3) / 4) * ((dims[2] + 3) / 4);
+    if (blockOffsets.GetNumberOfValues() < numBlocks)
+    {
+      throw vtkm::cont::ErrorBadValue("ArrayHandleZFP requires an offset for every block.");
+    }
+  }
+
+  /// Returns the dimensions of the field and the size of its blocks.
+  VTKM_CONT ZFPArrayMetaData GetMetaData() const
+  {
+    return StorageType::GetMetaData(this->GetBuffers());
+  }
+
+  /// Returns the array of compressed words.
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Int64> GetCompressedArray() const
+  {
+    return StorageType::GetCompressedArray(this->GetBuffers());
+  }
+
+  /// Returns the bit offset of each block, or an empty array for streams in fixed-rate mode.
+  VTKM_CONT vtkm::cont::ArrayHandle<vtkm::Id> GetBlockOffsets() const
+  {
+    return StorageType::GetBlockOffsets(this->GetBuffers());
+  }
+
+private:
+  VTKM_CONT static ZFPArrayMetaData MakeMetaData(const vtkm::Id3& dims, vtkm::Float64 rate)
+  {
+    // Match the block size chosen by ZFPCompressor, which always sets the rate for Float64.
+    vtkm::worklet::zfp::ZFPStream stream;
+    stream.SetRate(rate, 3, vtkm::Float64{});
+
+    return MakeMetaData(dims, stream);
+  }
+
+  VTKM_CONT static ZFPArrayMetaData MakeMetaData(const vtkm::Id3& dims,
+                                                 const vtkm::worklet::zfp::ZFPStream& stream)
+  {
+    if ((dims[0] < 1) || (dims[1] < 1) || (dims[2] < 1))
+    {
+      throw vtkm::cont::ErrorBadValue("ArrayHandleZFP requires positive dimensions.");
+    }
+    ZFPArrayMetaData metaData;
+    metaData.Dims = dims;
+    metaData.MaxBits = stream.maxbits;
+    metaData.MaxPrec = static_cast<vtkm::Int32>(stream.maxprec);
+    metaData.MinExp = stream.minexp;
+    return metaData;
+  }
+};
+
+/// @brief Create an `ArrayHandleZFP` from a stream compressed in fixed-rate mode.
+template <typename T>
+VTKM_CONT ArrayHandleZFP<T> make_ArrayHandleZFP(
+  const vtkm::cont::ArrayHandle<vtkm::Int64>& compressed,
+  const vtkm::Id3& dims,
+  vtkm::Float64 rate)
+{
+  return ArrayHandleZFP<T>(compressed, dims, rate);
+}
+
+/// @brief Create an `ArrayHandleZFP` from a stream compressed in any mode.
+template <typename T>
+VTKM_CONT ArrayHandleZFP<T> make_ArrayHandleZFP(
+  const vtkm::cont::ArrayHandle<vtkm::Int64>& compressed,
+  const vtkm::cont::ArrayHandle<vtkm::Id>& blockOffsets,
+  const vtkm::Id3& dims,
+  const vtkm::worklet::zfp::ZFPStream& stream)
+{
+  return ArrayHandleZFP<T>(compressed, blockOffsets, dims, stream);
+}
+
+}
+}
+} // namespace vtkm::filter::zfp
+
+#endif //vtk_m_filter_zfp_ArrayHandleZFP_h
@@ -10,6 +10,7 @@
 
 #include <vtkm/filter/zfp/ZFPCompressor3D.h>
 #include <vtkm/filter/zfp/worklet/ZFPCompressor.h>
+#include <vtkm/filter/zfp/worklet/zfp/ZFPStructs.h>
 
 namespace vtkm
 {
@@ -25,6 +26,17 @@ VTKM_CONT vtkm::cont::DataSet ZFPCompressor3D::DoExecute(const vtkm::cont::DataS
   vtkm::Id3 pointDimensions = cellSet.GetPointDimensions();
 
   vtkm::cont::ArrayHandle<vtkm::Int64> compressed;
+  vtkm::cont::ArrayHandle<vtkm::Id> blockOffsets;
+
+  vtkm::worklet::zfp::ZFPStream stream;
+  if (this->Precision > 0)
+  {
+    stream.SetPrecision(this->Precision);
+  }
+  else if (this->Tolerance > 0)
+  {
+    stream.SetAccuracy(this->Tolerance);
+  }
 
   vtkm::worklet::ZFPCompressor compressor;
   using SupportedTypes = vtkm::List<vtkm::Int32, vtkm::Float32, vtkm::Float64>;
@@ -32,15 +44,28 @@ VTKM_CONT vtkm::cont::DataSet ZFPCompressor3D::DoExecute(const vtkm::cont::DataS
     .GetData()
     .CastAndCallForTypesWithFloatFallback<SupportedTypes, VTKM_DEFAULT_STORAGE_LIST>(
       [&](const auto& concrete) {
-        compressed = compressor.Compress(concrete, rate, pointDimensions);
+        if ((this->Precision > 0) || (this->Tolerance > 0))
+        {
+          compressed = compressor.Compress(concrete, stream, pointDimensions, blockOffsets);
+        }
+        else
+        {
+          compressed = compressor.Compress(concrete, rate, pointDimensions);
+        }
       });
 
   // Note: the compressed array is set as a WholeDataSet field. It is really associated with
   // the points, but the size does not match and problems will occur if the user attempts to
   // use it as a point data set. The decompressor will place the data back as a point field.
   // (This might cause issues if cell fields are ever supported.)
-  return this->CreateResultField(
+  vtkm::cont::DataSet result = this->CreateResultField(
     input, "compressed", vtkm::cont::Field::Association::WholeDataSet, compressed);
+  if (blockOffsets.GetNumberOfValues() > 0)
+  {
+    result.AddField(vtkm::cont::Field(
+      "compressed_block_offsets", vtkm::cont::Field::Association::WholeDataSet, blockOffsets));
+  }
+  return result;
 }
 } // namespace zfp
 } // namespace filter
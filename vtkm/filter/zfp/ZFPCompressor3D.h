@@ -31,14 +31,47 @@ class VTKM_FILTER_ZFP_EXPORT ZFPCompressor3D : public vtkm::filter::Filter
 {
 public:
   /// @brief Specifies the rate of compression.
-  void SetRate(vtkm::Float64 _rate) { rate = _rate; }
+  ///
+  /// Compresses in fixed-rate mode, where every 4x4x4 block takes the same number of bits.
+  void SetRate(vtkm::Float64 _rate)
+  {
+    rate = _rate;
+    this->Tolerance = 0;
+    this->Precision = 0;
+  }
   /// @copydoc SetRate
   vtkm::Float64 GetRate() { return rate; }
 
+  /// @brief Compress in fixed-accuracy mode with the given absolute error tolerance.
+  ///
+  /// Blocks vary in size in this mode. The bit offset of each block is stored in an additional
+  /// field named `compressed_block_offsets`, which `ZFPDecompressor3D` needs.
+  void SetAccuracy(vtkm::Float64 tolerance)
+  {
+    this->Tolerance = tolerance;
+    this->Precision = 0;
+  }
+  /// @copydoc SetAccuracy
+  vtkm::Float64 GetAccuracy() const { return this->Tolerance; }
+
+  /// @brief Compress in fixed-precision mode, keeping the given number of bit planes.
+  ///
+  /// Blocks vary in size in this mode. The bit offset of each block is stored in an additional
+  /// field named `compressed_block_offsets`, which `ZFPDecompressor3D` needs.
+  void SetPrecision(vtkm::UInt32 precision)
+  {
+    this->Precision = precision;
+    this->Tolerance = 0;
+  }
+  /// @copydoc SetPrecision
+  vtkm::UInt32 GetPrecision() const { return this->Precision; }
+
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
   vtkm::Float64 rate = 0;
+  vtkm::Float64 Tolerance = 0;
+  vtkm::UInt32 Precision = 0;
 };
 
 } // namespace zfp
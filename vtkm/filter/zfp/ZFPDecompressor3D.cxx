@@ -9,8 +9,11 @@
 //============================================================================
 
 #include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ErrorFilterExecution.h>
+#include <vtkm/filter/zfp/ArrayHandleZFP.h>
 #include <vtkm/filter/zfp/ZFPDecompressor3D.h>
 #include <vtkm/filter/zfp/worklet/ZFPDecompress.h>
+#include <vtkm/filter/zfp/worklet/zfp/ZFPStructs.h>
 
 namespace vtkm
 {
@@ -30,6 +33,51 @@ VTKM_CONT vtkm::cont::DataSet ZFPDecompressor3D::DoExecute(const vtkm::cont::Dat
   input.GetCellSet().AsCellSet(cellSet);
   vtkm::Id3 pointDimensions = cellSet.GetPointDimensions();
 
+  if ((this->Precision > 0) || (this->Tolerance > 0))
+  {
+    vtkm::worklet::zfp::ZFPStream stream;
+    if (this->Precision > 0)
+    {
+      stream.SetPrecision(this->Precision);
+    }
+    else
+    {
+      stream.SetAccuracy(this->Tolerance);
+    }
+
+    const std::string offsetsName = this->GetActiveFieldName() + "_block_offsets";
+    constexpr auto wholeDataSet = vtkm::cont::Field::Association::WholeDataSet;
+    if (!input.HasField(offsetsName, wholeDataSet))
+    {
+      throw vtkm::cont::ErrorFilterExecution("Missing ZFP block offsets field " + offsetsName);
+    }
+    vtkm::cont::ArrayHandle<vtkm::Id> blockOffsets;
+    vtkm::cont::ArrayCopyShallowIfPossible(input.GetField(offsetsName, wholeDataSet).GetData(),
+                                           blockOffsets);
+
+    if (this->DecompressOnAccess)
+    {
+      return this->CreateResultFieldPoint(
+        input,
+        "decompressed",
+        vtkm::filter::zfp::make_ArrayHandleZFP<vtkm::Float64>(
+          compressed, blockOffsets, pointDimensions, stream));
+    }
+
+    vtkm::cont::ArrayHandle<vtkm::Float64> decompressed;
+    vtkm::worklet::ZFPDecompressor decompressor;
+    decompressor.Decompress(compressed, blockOffsets, decompressed, stream, pointDimensions);
+    return this->CreateResultFieldPoint(input, "decompressed", decompressed);
+  }
+
+  if (this->DecompressOnAccess)
+  {
+    return this->CreateResultFieldPoint(input,
+                                        "decompressed",
+                                        vtkm::filter::zfp::make_ArrayHandleZFP<vtkm::Float64>(
+                                          compressed, pointDimensions, this->rate));
+  }
+
   vtkm::cont::ArrayHandle<vtkm::Float64> decompressed;
   vtkm::worklet::ZFPDecompressor decompressor;
   decompressor.Decompress(compressed, decompressed, this->rate, pointDimensions);
@@ -31,14 +31,59 @@ class VTKM_FILTER_ZFP_EXPORT ZFPDecompressor3D : public vtkm::filter::Filter
 {
 public:
   /// @brief Specifies the rate of compression.
-  void SetRate(vtkm::Float64 _rate) { rate = _rate; }
+  ///
+  /// The stream must have been compressed in fixed-rate mode with the same rate.
+  void SetRate(vtkm::Float64 _rate)
+  {
+    rate = _rate;
+    this->Tolerance = 0;
+    this->Precision = 0;
+  }
   /// @copydoc SetRate
   vtkm::Float64 GetRate() { return rate; }
 
+  /// @brief Decompress a stream compressed in fixed-accuracy mode with the given tolerance.
+  ///
+  /// The input must also have the field of block offsets that `ZFPCompressor3D` creates,
+  /// named after the active field followed by `_block_offsets`.
+  void SetAccuracy(vtkm::Float64 tolerance)
+  {
+    this->Tolerance = tolerance;
+    this->Precision = 0;
+  }
+  /// @copydoc SetAccuracy
+  vtkm::Float64 GetAccuracy() const { return this->Tolerance; }
+
+  /// @brief Decompress a stream compressed in fixed-precision mode with the given precision.
+  ///
+  /// The input must also have the field of block offsets that `ZFPCompressor3D` creates,
+  /// named after the active field followed by `_block_offsets`.
+  void SetPrecision(vtkm::UInt32 precision)
+  {
+    this->Precision = precision;
+    this->Tolerance = 0;
+  }
+  /// @copydoc SetPrecision
+  vtkm::UInt32 GetPrecision() const { return this->Precision; }
+
+  /// @brief Specifies whether to keep the field compressed and decode values as they are read.
+  ///
+  /// When on, the output field is a `vtkm::filter::zfp::ArrayHandleZFP` of `vtkm::Float64`
+  /// that holds only the compressed stream and decodes each 4x4x4 block when one of its values
+  /// is read. Worklets that read the field directly use a fraction of the memory of the
+  /// decompressed field. Most filters, however, copy their input fields to basic arrays, which
+  /// decompresses the whole field anyway. Off by default.
+  void SetDecompressOnAccess(bool flag) { this->DecompressOnAccess = flag; }
+  /// @copydoc SetDecompressOnAccess
+  bool GetDecompressOnAccess() const { return this->DecompressOnAccess; }
+
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override;
 
   vtkm::Float64 rate = 0;
+  vtkm::Float64 Tolerance = 0;
+  vtkm::UInt32 Precision = 0;
+  bool DecompressOnAccess = false;
 };
 
 } // namespace zfp
@@ -8,16 +8,20 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/ArrayCopyDevice.h>
 #include <vtkm/cont/DataSet.h>
 #include <vtkm/cont/testing/MakeTestDataSet.h>
 #include <vtkm/cont/testing/Testing.h>
 
+#include <vtkm/filter/zfp/ArrayHandleZFP.h>
 #include <vtkm/filter/zfp/ZFPCompressor1D.h>
 #include <vtkm/filter/zfp/ZFPCompressor2D.h>
 #include <vtkm/filter/zfp/ZFPCompressor3D.h>
 #include <vtkm/filter/zfp/ZFPDecompressor1D.h>
 #include <vtkm/filter/zfp/ZFPDecompressor2D.h>
 #include <vtkm/filter/zfp/ZFPDecompressor3D.h>
+#include <vtkm/filter/zfp/worklet/ZFPCompressor.h>
+#include <vtkm/filter/zfp/worklet/ZFPDecompress.h>
 
 namespace
 {
@@ -114,11 +118,173 @@ void TestZFP3DFilter(vtkm::Float64 rate)
   }
 }
 
+void TestZFPArrayHandle(vtkm::Float64 rate)
+{
+  // Use dimensions that are not a multiple of the block size to get partial blocks.
+  const vtkm::Id3 dims(9, 7, 5);
+  vtkm::cont::testing::MakeTestDataSet testDataSet;
+  vtkm::cont::DataSet dataset = testDataSet.Make3DUniformDataSet3(dims);
+
+  vtkm::filter::zfp::ZFPCompressor3D compressor;
+  compressor.SetActiveField("pointvar");
+  compressor.SetRate(rate);
+  auto compressed = compressor.Execute(dataset);
+
+  vtkm::filter::zfp::ZFPDecompressor3D decompressor;
+  decompressor.SetActiveField("compressed");
+  decompressor.SetRate(rate);
+  vtkm::cont::ArrayHandle<vtkm::Float64> expected;
+  decompressor.Execute(compressed).GetField("decompressed").GetData().AsArrayHandle(expected);
+
+  vtkm::cont::ArrayHandle<vtkm::Int64> words;
+  compressed.GetField("compressed").GetData().AsArrayHandle(words);
+  auto onAccess = vtkm::filter::zfp::make_ArrayHandleZFP<vtkm::Float64>(words, dims, rate);
+  VTKM_TEST_ASSERT(onAccess.GetNumberOfValues() == expected.GetNumberOfValues());
+
+  std::cout << "  Read values from the control portal" << std::endl;
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(onAccess, expected));
+
+  std::cout << "  Interleave reads of two arrays" << std::endl;
+  // The block decoded last by a thread must not be used for another array.
+  const vtkm::Id3 otherDims(5, 7, 9);
+  vtkm::cont::DataSet otherDataset = testDataSet.Make3DUniformDataSet3(otherDims);
+  auto otherCompressed = compressor.Execute(otherDataset);
+  vtkm::cont::ArrayHandle<vtkm::Float64> otherExpected;
+  decompressor.Execute(otherCompressed)
+    .GetField("decompressed")
+    .GetData()
+    .AsArrayHandle(otherExpected);
+  vtkm::cont::ArrayHandle<vtkm::Int64> otherWords;
+  otherCompressed.GetField("compressed").GetData().AsArrayHandle(otherWords);
+  auto otherOnAccess =
+    vtkm::filter::zfp::make_ArrayHandleZFP<vtkm::Float64>(otherWords, otherDims, rate);
+  {
+    auto portal = onAccess.ReadPortal();
+    auto otherPortal = otherOnAccess.ReadPortal();
+    auto expectedPortal = expected.ReadPortal();
+    auto otherExpectedPortal = otherExpected.ReadPortal();
+    for (vtkm::Id index = portal.GetNumberOfValues() - 1; index >= 0; --index)
+    {
+      VTKM_TEST_ASSERT(test_equal(portal.Get(index), expectedPortal.Get(index)));
+      VTKM_TEST_ASSERT(test_equal(otherPortal.Get(index), otherExpectedPortal.Get(index)));
+    }
+  }
+
+  std::cout << "  Read values on the device" << std::endl;
+  vtkm::cont::ArrayHandle<vtkm::Float64> copied;
+  vtkm::cont::ArrayCopyDevice(onAccess, copied);
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(copied, expected));
+
+  std::cout << "  Decompress on access in the filter" << std::endl;
+  decompressor.SetDecompressOnAccess(true);
+  auto lazy = decompressor.Execute(compressed).GetField("decompressed").GetData();
+  VTKM_TEST_ASSERT(lazy.IsType<vtkm::filter::zfp::ArrayHandleZFP<vtkm::Float64>>());
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(lazy, expected));
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> original;
+  dataset.GetField("pointvar").GetData().AsArrayHandle(original);
+  auto originalPortal = original.ReadPortal();
+  auto onAccessPortal = onAccess.ReadPortal();
+  for (vtkm::Id index = 0; index < original.GetNumberOfValues(); ++index)
+  {
+    VTKM_TEST_ASSERT(test_equal(originalPortal.Get(index), onAccessPortal.Get(index), 0.8));
+  }
+}
+
+void TestZFPErrorBoundedModes()
+{
+  const vtkm::Id3 dims(9, 7, 5);
+  vtkm::cont::testing::MakeTestDataSet testDataSet;
+  vtkm::cont::DataSet dataset = testDataSet.Make3DUniformDataSet3(dims);
+  vtkm::cont::ArrayHandle<vtkm::Float64> original;
+  dataset.GetField("pointvar").GetData().AsArrayHandle(original);
+  const vtkm::Id numBlocks = 3 * 2 * 2;
+
+  auto roundTrip = [&](vtkm::filter::zfp::ZFPCompressor3D& compressor,
+                       vtkm::filter::zfp::ZFPDecompressor3D& decompressor) {
+    compressor.SetActiveField("pointvar");
+    auto compressed = compressor.Execute(dataset);
+    VTKM_TEST_ASSERT(compressed.HasField("compressed_block_offsets"));
+    VTKM_TEST_ASSERT(
+      compressed.GetField("compressed_block_offsets").GetNumberOfValues() == numBlocks + 1);
+
+    decompressor.SetActiveField("compressed");
+    vtkm::cont::ArrayHandle<vtkm::Float64> decompressed;
+    decompressor.Execute(compressed).GetField("decompressed").GetData().AsArrayHandle(
+      decompressed);
+
+    decompressor.SetDecompressOnAccess(true);
+    auto lazy = decompressor.Execute(compressed).GetField("decompressed").GetData();
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(lazy, decompressed));
+    return decompressed;
+  };
+
+  std::cout << "  Fixed accuracy" << std::endl;
+  const vtkm::Float64 tolerance = 1e-3;
+  vtkm::filter::zfp::ZFPCompressor3D compressor;
+  vtkm::filter::zfp::ZFPDecompressor3D decompressor;
+  compressor.SetAccuracy(tolerance);
+  decompressor.SetAccuracy(tolerance);
+  auto accurate = roundTrip(compressor, decompressor);
+  auto originalPortal = original.ReadPortal();
+  auto accuratePortal = accurate.ReadPortal();
+  for (vtkm::Id index = 0; index < original.GetNumberOfValues(); ++index)
+  {
+    VTKM_TEST_ASSERT(vtkm::Abs(originalPortal.Get(index) - accuratePortal.Get(index)) <=
+                       tolerance,
+                     "Fixed accuracy error exceeds tolerance at ",
+                     index);
+  }
+
+  std::cout << "  Fixed precision" << std::endl;
+  compressor.SetPrecision(32);
+  decompressor = vtkm::filter::zfp::ZFPDecompressor3D{};
+  decompressor.SetPrecision(32);
+  auto precise = roundTrip(compressor, decompressor);
+  auto precisePortal = precise.ReadPortal();
+  for (vtkm::Id index = 0; index < original.GetNumberOfValues(); ++index)
+  {
+    VTKM_TEST_ASSERT(test_equal(originalPortal.Get(index), precisePortal.Get(index), 1e-4));
+  }
+
+  std::cout << "  Decompress a sub-extent" << std::endl;
+  vtkm::worklet::zfp::ZFPStream stream;
+  stream.SetAccuracy(tolerance);
+  vtkm::cont::ArrayHandle<vtkm::Id> blockOffsets;
+  vtkm::worklet::ZFPCompressor worklet;
+  auto words = worklet.Compress(original, stream, dims, blockOffsets);
+
+  const vtkm::Id3 start(3, 2, 1);
+  const vtkm::Id3 count(5, 4, 3);
+  vtkm::cont::ArrayHandle<vtkm::Float64> subExtent;
+  vtkm::worklet::ZFPDecompressor().DecompressSubExtent(
+    words, blockOffsets, subExtent, stream, dims, start, count);
+  VTKM_TEST_ASSERT(subExtent.GetNumberOfValues() == count[0] * count[1] * count[2]);
+  auto subExtentPortal = subExtent.ReadPortal();
+  for (vtkm::Id k = 0; k < count[2]; ++k)
+  {
+    for (vtkm::Id j = 0; j < count[1]; ++j)
+    {
+      for (vtkm::Id i = 0; i < count[0]; ++i)
+      {
+        const vtkm::Id fullIndex =
+          (start[0] + i) + dims[0] * ((start[1] + j) + dims[1] * (start[2] + k));
+        VTKM_TEST_ASSERT(
+          test_equal(subExtentPortal.Get(i + count[0] * (j + count[1] * k)),
+                     accuratePortal.Get(fullIndex)),
+          "Sub-extent does not match full decompression.");
+      }
+    }
+  }
+}
+
 void TestZFPFilter()
 {
   TestZFP1DFilter(4);
   TestZFP2DFilter(4);
   TestZFP2DFilter(4);
+  TestZFPArrayHandle(8);
+  TestZFPErrorBoundedModes();
 }
 } // anonymous namespace
 
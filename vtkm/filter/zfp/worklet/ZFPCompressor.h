@@ -14,8 +14,11 @@
 #include <vtkm/cont/Algorithm.h>
 #include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayGetValues.h>
 #include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleView.h>
 #include <vtkm/cont/AtomicArray.h>
+#include <vtkm/cont/Invoker.h>
 #include <vtkm/cont/Timer.h>
 #include <vtkm/worklet/DispatcherMapField.h>
 
@@ -90,6 +93,55 @@ public:
 
     return output;
   }
+
+  /// Compresses `data` in the mode set on `stream`. In the fixed-accuracy and fixed-precision
+  /// modes the size of each block depends on its values. The size of every block is computed
+  /// first, and a scan of the sizes gives the bit at which each block starts, so all blocks are
+  /// still encoded in parallel. `blockOffsets` receives these bit offsets followed by the total
+  /// number of bits. In fixed-rate mode the offsets are simply multiples of the block size.
+  template <typename Scalar, typename Storage>
+  vtkm::cont::ArrayHandle<vtkm::Int64> Compress(
+    const vtkm::cont::ArrayHandle<Scalar, Storage>& data,
+    const zfp::ZFPStream& stream,
+    const vtkm::Id3 dims,
+    vtkm::cont::ArrayHandle<vtkm::Id>& blockOffsets)
+  {
+    vtkm::Id3 paddedDims = dims;
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      if (paddedDims[d] % 4 != 0)
+        paddedDims[d] += 4 - dims[d] % 4;
+    }
+    const vtkm::Id totalBlocks = (paddedDims[0] / 4) * (paddedDims[1] / 4) * (paddedDims[2] / 4);
+    vtkm::cont::ArrayHandleCounting<vtkm::Id> blockCounter(0, 1, totalBlocks);
+
+    vtkm::cont::ArrayHandle<vtkm::Int64> output;
+    vtkm::cont::Invoker invoke;
+    if (stream.IsFixedRate())
+    {
+      vtkm::cont::Algorithm::Copy(
+        vtkm::cont::ArrayHandleCounting<vtkm::Id>(0, vtkm::Id(stream.maxbits), totalBlocks + 1),
+        blockOffsets);
+      const vtkm::Id totalBits = vtkm::Id(stream.maxbits) * totalBlocks;
+      output.AllocateAndFill(totalBits / vtkm::Id(sizeof(ZFPWord) * 8) + 1, 0);
+      invoke(zfp::Encode3(dims, paddedDims, stream.maxbits), blockCounter, data, output);
+    }
+    else
+    {
+      vtkm::cont::ArrayHandle<vtkm::Id> blockBits;
+      invoke(zfp::EncodeBlockSize3(dims, paddedDims, stream), blockCounter, data, blockBits);
+      vtkm::cont::Algorithm::ScanExtended(blockBits, blockOffsets);
+
+      const vtkm::Id totalBits = vtkm::cont::ArrayGetValue(totalBlocks, blockOffsets);
+      output.AllocateAndFill(totalBits / vtkm::Id(sizeof(ZFPWord) * 8) + 1, 0);
+      invoke(zfp::EncodeIndexed3(dims, paddedDims, stream),
+             blockCounter,
+             vtkm::cont::make_ArrayHandleView(blockOffsets, 0, totalBlocks),
+             data,
+             output);
+    }
+    return output;
+  }
 };
 } // namespace worklet
 } // namespace vtkm
@@ -15,7 +15,10 @@
 #include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/ArrayHandleConstant.h>
 #include <vtkm/cont/ArrayHandleCounting.h>
+#include <vtkm/cont/ArrayHandleView.h>
 #include <vtkm/cont/AtomicArray.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Invoker.h>
 #include <vtkm/cont/Timer.h>
 #include <vtkm/filter/zfp/worklet/zfp/ZFPDecode3.h>
 #include <vtkm/filter/zfp/worklet/zfp/ZFPTools.h>
@@ -84,6 +87,83 @@ public:
     //    std::cout<<"Decompress rate "<<rate<<" GB / sec\n";
     //    DataDump(output, "decompressed");
   }
+
+  /// Decompresses a stream compressed in any mode with `ZFPCompressor`. `blockOffsets` is the
+  /// index of block offsets the compressor produced.
+  template <typename Scalar, typename StorageIn, typename StorageOut>
+  void Decompress(const vtkm::cont::ArrayHandle<vtkm::Int64, StorageIn>& encodedData,
+                  const vtkm::cont::ArrayHandle<vtkm::Id>& blockOffsets,
+                  vtkm::cont::ArrayHandle<Scalar, StorageOut>& output,
+                  const zfp::ZFPStream& stream,
+                  vtkm::Id3 dims)
+  {
+    const vtkm::Id3 paddedDims = PadDims(dims);
+    const vtkm::Id totalBlocks = (paddedDims[0] / 4) * (paddedDims[1] / 4) * (paddedDims[2] / 4);
+    CheckBlockOffsets(blockOffsets, totalBlocks);
+
+    output.Allocate(dims[0] * dims[1] * dims[2]);
+    vtkm::cont::Invoker invoke;
+    invoke(zfp::DecodeIndexed3(dims, paddedDims, stream),
+           vtkm::cont::ArrayHandleCounting<vtkm::Id>(0, 1, totalBlocks),
+           vtkm::cont::make_ArrayHandleView(blockOffsets, 0, totalBlocks),
+           output,
+           encodedData);
+  }
+
+  /// Decompresses only the points from `start` to `start + count - 1` of a field with the
+  /// given dimensions. Only the blocks overlapping this sub-extent are decoded, so the cost
+  /// depends on the size of the sub-extent rather than the size of the field. The output has
+  /// `count[0] * count[1] * count[2]` values.
+  template <typename Scalar, typename StorageIn, typename StorageOut>
+  void DecompressSubExtent(const vtkm::cont::ArrayHandle<vtkm::Int64, StorageIn>& encodedData,
+                           const vtkm::cont::ArrayHandle<vtkm::Id>& blockOffsets,
+                           vtkm::cont::ArrayHandle<Scalar, StorageOut>& output,
+                           const zfp::ZFPStream& stream,
+                           vtkm::Id3 dims,
+                           vtkm::Id3 start,
+                           vtkm::Id3 count)
+  {
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      if ((start[d] < 0) || (count[d] < 1) || (start[d] + count[d] > dims[d]))
+      {
+        throw vtkm::cont::ErrorBadValue("Sub-extent is outside the compressed field.");
+      }
+    }
+    const vtkm::Id3 paddedDims = PadDims(dims);
+    const vtkm::Id totalBlocks = (paddedDims[0] / 4) * (paddedDims[1] / 4) * (paddedDims[2] / 4);
+    CheckBlockOffsets(blockOffsets, totalBlocks);
+
+    output.Allocate(count[0] * count[1] * count[2]);
+    zfp::DecodeSubExtent3 decodeWorklet(paddedDims, start, count, stream);
+    vtkm::cont::Invoker invoke;
+    invoke(decodeWorklet,
+           vtkm::cont::ArrayHandleCounting<vtkm::Id>(0, 1, decodeWorklet.GetNumberOfBlocks()),
+           blockOffsets,
+           output,
+           encodedData);
+  }
+
+private:
+  static vtkm::Id3 PadDims(const vtkm::Id3& dims)
+  {
+    vtkm::Id3 paddedDims = dims;
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      if (paddedDims[d] % 4 != 0)
+        paddedDims[d] += 4 - dims[d] % 4;
+    }
+    return paddedDims;
+  }
+
+  static void CheckBlockOffsets(const vtkm::cont::ArrayHandle<vtkm::Id>& blockOffsets,
+                                vtkm::Id totalBlocks)
+  {
+    if (blockOffsets.GetNumberOfValues() != totalBlocks + 1)
+    {
+      throw vtkm::cont::ErrorBadValue("ZFP block offsets do not match the field dimensions.");
+    }
+  }
 };
 } // namespace worklet
 } // namespace vtkm
@@ -48,6 +48,20 @@ struct BlockReader
     m_block_idx = block_idx;
   }
 
+  VTKM_EXEC
+  BlockReader(const WordsPortalType& words, const int& maxbits, const BlockBitOffset& offset)
+    : Words(words)
+    , m_maxbits(maxbits)
+    , m_block_idx(-1)
+    , MaxIndex(words.GetNumberOfValues() - 1)
+  {
+    Index = offset.Value / vtkm::Id(sizeof(Word) * 8);
+    m_buffer = static_cast<Word>(Words.Get(Index));
+    m_current_bit = static_cast<vtkm::Int32>(offset.Value % vtkm::Id(sizeof(Word) * 8));
+
+    m_buffer >>= m_current_bit;
+  }
+
   inline VTKM_EXEC unsigned int read_bit()
   {
     vtkm::UInt32 bit = vtkm::UInt32(m_buffer) & 1u;
@@ -75,9 +89,10 @@ struct BlockReader
 
     vtkm::Int32 first_read = vtkm::Min(rem_bits, n_bits);
     // first mask
-    Word mask = ((Word)1 << ((first_read))) - 1;
+    // A whole word may be read, and shifting a word by its full width is undefined.
+    Word mask = first_read < 64 ? ((Word)1 << first_read) - 1 : ~(Word)0;
     bits = m_buffer & mask;
-    m_buffer >>= n_bits;
+    m_buffer = n_bits < 64 ? m_buffer >> n_bits : 0;
     m_current_bit += first_read;
     vtkm::Int32 next_read = 0;
     if (n_bits >= rem_bits)
@@ -94,7 +109,10 @@ struct BlockReader
     // all the bits. TODO: if we have aligned reads, this could
     // be a conditional without divergence
     mask = ((Word)1 << ((next_read))) - 1;
-    bits += (m_buffer & mask) << first_read;
+    if (next_read > 0)
+    {
+      bits += (m_buffer & mask) << first_read;
+    }
     m_buffer >>= next_read;
     m_current_bit += next_read;
     return bits;
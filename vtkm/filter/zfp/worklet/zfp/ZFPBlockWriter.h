@@ -44,6 +44,15 @@ struct BlockWriter
     m_start_bit = vtkm::Int32((block_idx * maxbits) % vtkm::Int32(sizeof(Word) * 8));
   }
 
+  VTKM_EXEC BlockWriter(AtomicPortalType& portal, const int& maxbits, const BlockBitOffset& offset)
+    : m_current_bit(0)
+    , m_maxbits(maxbits)
+    , Portal(portal)
+  {
+    m_word_index = offset.Value / vtkm::Id(sizeof(Word) * 8);
+    m_start_bit = vtkm::Int32(offset.Value % vtkm::Id(sizeof(Word) * 8));
+  }
+
   inline VTKM_EXEC void Add(const vtkm::Id index, Word& value)
   {
     UIntInt newval;
@@ -67,9 +76,9 @@ struct BlockWriter
     // If this does not happen, then we may write into a zfp
     // block not at the specified index
     // uint zero_shift = sizeof(Word) * 8 - n_bits;
-    Word left = (bits >> n_bits) << n_bits;
-
-    Word b = bits - left;
+    // A whole word is written when every bit plane of a 64 value block is significant, and
+    // shifting a word by its full width is undefined.
+    Word b = n_bits < sizeof(Word) * 8 ? bits & (((Word)1 << n_bits) - 1) : bits;
     Word add = b << shift;
     Add(write_index, add);
 
@@ -81,7 +90,7 @@ struct BlockWriter
       Add(write_index + 1, rem);
     }
     m_current_bit += n_bits;
-    return bits >> (Word)n_bits;
+    return n_bits < sizeof(Word) * 8 ? bits >> (Word)n_bits : 0;
   }
 
   // TODO: optimize
@@ -106,6 +115,17 @@ struct BlockWriter
   }
 };
 
+// Stands in for a BlockWriter when only the number of bits a block needs is wanted.
+struct NullBlockWriter
+{
+  inline VTKM_EXEC vtkm::UInt64 write_bits(const vtkm::UInt64& bits, const unsigned int& n_bits)
+  {
+    return n_bits < sizeof(Word) * 8 ? bits >> (Word)n_bits : 0;
+  }
+
+  inline VTKM_EXEC vtkm::UInt32 write_bit(const unsigned int& bit) { return bit; }
+};
+
 } // namespace zfp
 } // namespace worklet
 } // namespace vtkm
@@ -173,7 +173,8 @@ template <vtkm::Int32 BlockSize,
 VTKM_EXEC void decode_ints(ReaderType<BlockSize, PortalType>& reader,
                            vtkm::Int32& maxbits,
                            UInt* data,
-                           const vtkm::Int32 intprec)
+                           const vtkm::Int32 intprec,
+                           const vtkm::UInt32 kmin = 0)
 {
   for (vtkm::Int32 i = 0; i < BlockSize; ++i)
   {
@@ -181,7 +182,6 @@ VTKM_EXEC void decode_ints(ReaderType<BlockSize, PortalType>& reader,
   }
 
   vtkm::UInt64 x;
-  const vtkm::UInt32 kmin = 0;
   vtkm::Int32 bits = maxbits;
   for (vtkm::UInt32 k = static_cast<vtkm::UInt32>(intprec), n = 0; bits && k-- > kmin;)
   {
@@ -201,13 +201,15 @@ VTKM_EXEC void decode_ints(ReaderType<BlockSize, PortalType>& reader,
   }
 }
 
-template <vtkm::Int32 BlockSize, typename Scalar, typename PortalType>
-VTKM_EXEC void zfp_decode(Scalar* fblock,
-                          vtkm::Int32 maxbits,
-                          vtkm::UInt32 blockIdx,
-                          PortalType stream)
+// Decodes a block that was encoded keeping at most `maxprec` bit planes and no bit plane below
+// 2^minexp. These must match the values used to encode the block.
+template <vtkm::Int32 BlockSize, typename Scalar, typename ReaderType>
+VTKM_EXEC void zfp_decode_block(ReaderType& reader,
+                                Scalar* fblock,
+                                vtkm::Int32 maxbits,
+                                vtkm::Int32 maxprec,
+                                vtkm::Int32 minexp)
 {
-  zfp::BlockReader<BlockSize, PortalType> reader(stream, maxbits, vtkm::Int32(blockIdx));
   using Int = typename zfp::zfp_traits<Scalar>::Int;
   using UInt = typename zfp::zfp_traits<Scalar>::UInt;
 
@@ -227,16 +229,24 @@ VTKM_EXEC void zfp_decode(Scalar* fblock,
     {
       emax = vtkm::UInt32(reader.read_bits(static_cast<vtkm::Int32>(ebits) - 1));
       emax -= static_cast<vtkm::UInt32>(zfp::get_ebias<Scalar>());
+      // Same number of bit planes as computed by the encoder.
+      maxprec =
+        vtkm::Min(maxprec, vtkm::Max(0, static_cast<vtkm::Int32>(emax) - minexp + 8));
     }
     else
     {
       // no exponent bits
       ebits = 0;
+      emax = 0;
     }
 
+    const vtkm::Int32 intprec = zfp::get_precision<Scalar>();
+    const vtkm::UInt32 kmin =
+      intprec > maxprec ? static_cast<vtkm::UInt32>(intprec - maxprec) : vtkm::UInt32(0);
+
     maxbits -= ebits;
     UInt ublock[BlockSize];
-    decode_ints<BlockSize>(reader, maxbits, ublock, zfp::get_precision<Scalar>());
+    decode_ints<BlockSize>(reader, maxbits, ublock, intprec, kmin);
 
     Int iblock[BlockSize];
     const zfp::ZFPCodec<BlockSize> codec;
@@ -257,6 +267,34 @@ VTKM_EXEC void zfp_decode(Scalar* fblock,
     }
   }
 }
+
+template <vtkm::Int32 BlockSize, typename Scalar, typename PortalType>
+VTKM_EXEC void zfp_decode(Scalar* fblock,
+                          vtkm::Int32 maxbits,
+                          vtkm::UInt32 blockIdx,
+                          PortalType stream)
+{
+  zfp::BlockReader<BlockSize, PortalType> reader(stream, maxbits, vtkm::Int32(blockIdx));
+  zfp_decode_block<BlockSize>(
+    reader, fblock, maxbits, zfp::get_precision<Scalar>(), zfp::get_min_exp<Scalar>());
+}
+
+// Decodes a block that starts at the given bit of a stream with variable sized blocks.
+template <vtkm::Int32 BlockSize, typename Scalar, typename PortalType>
+VTKM_EXEC void zfp_decode(Scalar* fblock,
+                          vtkm::Int32 maxbits,
+                          vtkm::Int32 maxprec,
+                          vtkm::Int32 minexp,
+                          const zfp::BlockBitOffset& offset,
+                          PortalType stream)
+{
+  zfp::BlockReader<BlockSize, PortalType> reader(stream, maxbits, offset);
+  zfp_decode_block<BlockSize>(reader,
+                              fblock,
+                              maxbits,
+                              vtkm::Min(maxprec, zfp::get_precision<Scalar>()),
+                              vtkm::Max(minexp, zfp::get_min_exp<Scalar>()));
+}
 }
 }
 } // namespace vtkm::worklet::zfp
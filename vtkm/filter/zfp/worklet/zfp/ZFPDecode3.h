@@ -104,6 +104,15 @@ public:
     zfp::zfp_decode<BlockSize>(
       fblock, vtkm::Int32(MaxBits), static_cast<vtkm::UInt32>(blockIdx), stream);
 
+    this->ScatterBlock(blockIdx, fblock, scalars);
+  }
+
+protected:
+  template <typename Scalar, typename InputScalarPortal>
+  VTKM_EXEC void ScatterBlock(const vtkm::Id blockIdx,
+                              const Scalar* fblock,
+                              InputScalarPortal& scalars) const
+  {
     vtkm::Id3 zfpBlock;
     zfpBlock[0] = blockIdx % ZFPDims[0];
     zfpBlock[1] = (blockIdx / ZFPDims[0]) % ZFPDims[1];
@@ -135,6 +144,129 @@ public:
     }
   }
 };
+
+// Decodes blocks of variable size, each starting at the bit given by an index of offsets.
+struct DecodeIndexed3 : public Decode3
+{
+protected:
+  vtkm::Int32 MaxPrec; // most bit planes kept per block
+  vtkm::Int32 MinExp;  // smallest bit plane kept
+public:
+  DecodeIndexed3(const vtkm::Id3 dims, const vtkm::Id3 paddedDims, const ZFPStream& stream)
+    : Decode3(dims, paddedDims, stream.maxbits)
+    , MaxPrec(vtkm::Int32(stream.maxprec))
+    , MinExp(stream.minexp)
+  {
+  }
+  using ControlSignature = void(FieldIn, FieldIn blockOffset, WholeArrayOut, WholeArrayIn);
+
+  template <typename InputScalarPortal, typename BitstreamPortal>
+  VTKM_EXEC void operator()(const vtkm::Id blockIdx,
+                            const vtkm::Id blockOffset,
+                            InputScalarPortal& scalars,
+                            BitstreamPortal& stream) const
+  {
+    using Scalar = typename InputScalarPortal::ValueType;
+    constexpr vtkm::Int32 BlockSize = 64;
+    Scalar fblock[BlockSize];
+    for (vtkm::Int32 i = 0; i < BlockSize; ++i)
+    {
+      fblock[i] = static_cast<Scalar>(0);
+    }
+
+    zfp::zfp_decode<BlockSize>(fblock,
+                               vtkm::Int32(MaxBits),
+                               MaxPrec,
+                               MinExp,
+                               zfp::BlockBitOffset{ blockOffset },
+                               stream);
+
+    this->ScatterBlock(blockIdx, fblock, scalars);
+  }
+};
+
+// Decodes only the blocks that overlap a sub-extent of the field and writes the values inside
+// the extent to an array the size of the extent.
+struct DecodeSubExtent3 : public vtkm::worklet::WorkletMapField
+{
+protected:
+  vtkm::Id3 ZFPDims;     // zfp block dims of the whole field
+  vtkm::Id3 FirstBlock;  // first block overlapping the extent
+  vtkm::Id3 NumBlocks;   // number of blocks overlapping the extent
+  vtkm::Id3 ExtentStart; // first point of the extent
+  vtkm::Id3 ExtentDims;  // number of points in the extent
+  vtkm::UInt32 MaxBits;  // most bits per zfp block
+  vtkm::Int32 MaxPrec;   // most bit planes kept per block
+  vtkm::Int32 MinExp;    // smallest bit plane kept
+public:
+  DecodeSubExtent3(const vtkm::Id3 paddedDims,
+                   const vtkm::Id3 extentStart,
+                   const vtkm::Id3 extentDims,
+                   const ZFPStream& stream)
+    : ExtentStart(extentStart)
+    , ExtentDims(extentDims)
+    , MaxBits(stream.maxbits)
+    , MaxPrec(vtkm::Int32(stream.maxprec))
+    , MinExp(stream.minexp)
+  {
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      ZFPDims[d] = paddedDims[d] / 4;
+      FirstBlock[d] = extentStart[d] / 4;
+      NumBlocks[d] = (extentStart[d] + extentDims[d] + 3) / 4 - FirstBlock[d];
+    }
+  }
+
+  vtkm::Id GetNumberOfBlocks() const { return NumBlocks[0] * NumBlocks[1] * NumBlocks[2]; }
+
+  using ControlSignature = void(FieldIn, WholeArrayIn blockOffsets, WholeArrayOut, WholeArrayIn);
+
+  template <typename OffsetsPortal, typename OutputPortal, typename BitstreamPortal>
+  VTKM_EXEC void operator()(const vtkm::Id extentBlockIdx,
+                            const OffsetsPortal& blockOffsets,
+                            OutputPortal& output,
+                            const BitstreamPortal& stream) const
+  {
+    using Scalar = typename OutputPortal::ValueType;
+    constexpr vtkm::Int32 BlockSize = 64;
+
+    vtkm::Id3 zfpBlock;
+    zfpBlock[0] = FirstBlock[0] + extentBlockIdx % NumBlocks[0];
+    zfpBlock[1] = FirstBlock[1] + (extentBlockIdx / NumBlocks[0]) % NumBlocks[1];
+    zfpBlock[2] = FirstBlock[2] + extentBlockIdx / (NumBlocks[0] * NumBlocks[1]);
+    const vtkm::Id blockIdx = (zfpBlock[2] * ZFPDims[1] + zfpBlock[1]) * ZFPDims[0] + zfpBlock[0];
+
+    Scalar fblock[BlockSize];
+    for (vtkm::Int32 i = 0; i < BlockSize; ++i)
+    {
+      fblock[i] = static_cast<Scalar>(0);
+    }
+    zfp::zfp_decode<BlockSize>(fblock,
+                               vtkm::Int32(MaxBits),
+                               MaxPrec,
+                               MinExp,
+                               zfp::BlockBitOffset{ blockOffsets.Get(blockIdx) },
+                               stream);
+
+    for (vtkm::Id z = 0; z < 4; ++z)
+    {
+      const vtkm::Id k = zfpBlock[2] * 4 + z - ExtentStart[2];
+      for (vtkm::Id y = 0; y < 4; ++y)
+      {
+        const vtkm::Id j = zfpBlock[1] * 4 + y - ExtentStart[1];
+        for (vtkm::Id x = 0; x < 4; ++x)
+        {
+          const vtkm::Id i = zfpBlock[0] * 4 + x - ExtentStart[0];
+          if ((i >= 0) && (i < ExtentDims[0]) && (j >= 0) && (j < ExtentDims[1]) && (k >= 0) &&
+              (k < ExtentDims[2]))
+          {
+            output.Set((k * ExtentDims[1] + j) * ExtentDims[0] + i, fblock[(z * 4 + y) * 4 + x]);
+          }
+        }
+      }
+    }
+  }
+};
 }
 }
 } // namespace vtkm::worklet::zfp
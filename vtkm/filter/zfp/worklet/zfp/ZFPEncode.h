@@ -237,11 +237,12 @@ inline VTKM_EXEC void fwd_xform<vtkm::Int32, 4>(vtkm::Int32* p)
   fwd_lift<vtkm::Int32, 1>(p);
 }
 
-template <vtkm::Int32 BlockSize, typename PortalType, typename Int>
-VTKM_EXEC void encode_block(BlockWriter<BlockSize, PortalType>& stream,
-                            vtkm::Int32 maxbits,
-                            vtkm::Int32 maxprec,
-                            Int* iblock)
+// Returns the number of bits written.
+template <vtkm::Int32 BlockSize, typename WriterType, typename Int>
+VTKM_EXEC vtkm::Int32 encode_block(WriterType& stream,
+                                   vtkm::Int32 maxbits,
+                                   vtkm::Int32 maxprec,
+                                   Int* iblock)
 {
   using UInt = typename zfp_traits<Int>::UInt;
 
@@ -278,21 +279,23 @@ VTKM_EXEC void encode_block(BlockWriter<BlockSize, PortalType>& stream,
       }
     }
   }
+  return maxbits - static_cast<vtkm::Int32>(bits);
 }
 
 
-template <vtkm::Int32 BlockSize, typename Scalar, typename PortalType>
-inline VTKM_EXEC void zfp_encodef(Scalar* fblock,
-                                  vtkm::Int32 maxbits,
-                                  vtkm::UInt32 blockIdx,
-                                  PortalType& stream)
+// Encodes a block of floating point values keeping at most `maxprec` bit planes and no bit
+// plane below 2^minexp. Returns the number of bits the block occupies in the stream.
+template <vtkm::Int32 BlockSize, typename Scalar, typename WriterType>
+inline VTKM_EXEC vtkm::Int32 zfp_encodef_block(WriterType& blockWriter,
+                                               Scalar* fblock,
+                                               vtkm::Int32 maxbits,
+                                               vtkm::Int32 maxprec,
+                                               vtkm::Int32 minexp)
 {
   using Int = typename zfp::zfp_traits<Scalar>::Int;
-  zfp::BlockWriter<BlockSize, PortalType> blockWriter(stream, maxbits, vtkm::Id(blockIdx));
   vtkm::Int32 emax = zfp::MaxExponent<BlockSize, Scalar>(fblock);
   //  std::cout<<"EMAX "<<emax<<"\n";
-  vtkm::Int32 maxprec =
-    zfp::precision(emax, zfp::get_precision<Scalar>(), zfp::get_min_exp<Scalar>());
+  maxprec = zfp::precision(emax, maxprec, minexp);
   vtkm::UInt32 e = vtkm::UInt32(maxprec ? emax + zfp::get_ebias<Scalar>() : 0);
   /* encode block only if biased exponent is nonzero */
   if (e)
@@ -304,8 +307,22 @@ inline VTKM_EXEC void zfp_encodef(Scalar* fblock,
     Int iblock[BlockSize];
     zfp::fwd_cast<Int, Scalar, BlockSize>(iblock, fblock, emax);
 
-    encode_block<BlockSize>(blockWriter, maxbits - vtkm::Int32(ebits), maxprec, iblock);
+    return vtkm::Int32(ebits) +
+      encode_block<BlockSize>(blockWriter, maxbits - vtkm::Int32(ebits), maxprec, iblock);
   }
+  // An empty block is a single zero bit. The stream starts zeroed, so it is not written.
+  return 1;
+}
+
+template <vtkm::Int32 BlockSize, typename Scalar, typename PortalType>
+inline VTKM_EXEC void zfp_encodef(Scalar* fblock,
+                                  vtkm::Int32 maxbits,
+                                  vtkm::UInt32 blockIdx,
+                                  PortalType& stream)
+{
+  zfp::BlockWriter<BlockSize, PortalType> blockWriter(stream, maxbits, vtkm::Id(blockIdx));
+  zfp_encodef_block<BlockSize>(
+    blockWriter, fblock, maxbits, zfp::get_precision<Scalar>(), zfp::get_min_exp<Scalar>());
 }
 
 // helpers so we can do partial template instantiation since
@@ -325,6 +342,20 @@ struct ZFPBlockEncoder<BlockSize, vtkm::Float32, PortalType>
   {
     zfp_encodef<BlockSize>(fblock, maxbits, blockIdx, stream);
   }
+
+  template <typename WriterType>
+  VTKM_EXEC vtkm::Int32 encode(WriterType& writer,
+                               vtkm::Float32* fblock,
+                               vtkm::Int32 maxbits,
+                               vtkm::Int32 maxprec,
+                               vtkm::Int32 minexp)
+  {
+    return zfp_encodef_block<BlockSize>(writer,
+                                        fblock,
+                                        maxbits,
+                                        vtkm::Min(maxprec, zfp::get_precision<vtkm::Float32>()),
+                                        vtkm::Max(minexp, zfp::get_min_exp<vtkm::Float32>()));
+  }
 };
 
 template <vtkm::Int32 BlockSize, typename PortalType>
@@ -337,6 +368,20 @@ struct ZFPBlockEncoder<BlockSize, vtkm::Float64, PortalType>
   {
     zfp_encodef<BlockSize>(fblock, maxbits, blockIdx, stream);
   }
+
+  template <typename WriterType>
+  VTKM_EXEC vtkm::Int32 encode(WriterType& writer,
+                               vtkm::Float64* fblock,
+                               vtkm::Int32 maxbits,
+                               vtkm::Int32 maxprec,
+                               vtkm::Int32 minexp)
+  {
+    return zfp_encodef_block<BlockSize>(writer,
+                                        fblock,
+                                        maxbits,
+                                        vtkm::Min(maxprec, zfp::get_precision<vtkm::Float64>()),
+                                        vtkm::Max(minexp, zfp::get_min_exp<vtkm::Float64>()));
+  }
 };
 
 template <vtkm::Int32 BlockSize, typename PortalType>
@@ -351,6 +396,19 @@ struct ZFPBlockEncoder<BlockSize, vtkm::Int32, PortalType>
     zfp::BlockWriter<BlockSize, PortalType> blockWriter(stream, maxbits, vtkm::Id(blockIdx));
     encode_block<BlockSize>(blockWriter, maxbits, get_precision<vtkm::Int32>(), (Int*)fblock);
   }
+
+  // Integers have no exponent, so only the precision limits the number of bit planes.
+  template <typename WriterType>
+  VTKM_EXEC vtkm::Int32 encode(WriterType& writer,
+                               vtkm::Int32* fblock,
+                               vtkm::Int32 maxbits,
+                               vtkm::Int32 maxprec,
+                               vtkm::Int32 vtkmNotUsed(minexp))
+  {
+    using Int = typename zfp::zfp_traits<vtkm::Int32>::Int;
+    return encode_block<BlockSize>(
+      writer, maxbits, vtkm::Min(maxprec, get_precision<vtkm::Int32>()), (Int*)fblock);
+  }
 };
 
 template <vtkm::Int32 BlockSize, typename PortalType>
@@ -365,6 +423,19 @@ struct ZFPBlockEncoder<BlockSize, vtkm::Int64, PortalType>
     zfp::BlockWriter<BlockSize, PortalType> blockWriter(stream, maxbits, vtkm::Id(blockIdx));
     encode_block<BlockSize>(blockWriter, maxbits, get_precision<vtkm::Int64>(), (Int*)fblock);
   }
+
+  // Integers have no exponent, so only the precision limits the number of bit planes.
+  template <typename WriterType>
+  VTKM_EXEC vtkm::Int32 encode(WriterType& writer,
+                               vtkm::Int64* fblock,
+                               vtkm::Int32 maxbits,
+                               vtkm::Int32 maxprec,
+                               vtkm::Int32 vtkmNotUsed(minexp))
+  {
+    using Int = typename zfp::zfp_traits<vtkm::Int64>::Int;
+    return encode_block<BlockSize>(
+      writer, maxbits, vtkm::Min(maxprec, get_precision<vtkm::Int64>()), (Int*)fblock);
+  }
 };
 }
 }
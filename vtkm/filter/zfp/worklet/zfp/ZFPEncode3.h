@@ -112,7 +112,19 @@ public:
     using Scalar = typename InputScalarPortal::ValueType;
     constexpr vtkm::Int32 BlockSize = 64;
     Scalar fblock[BlockSize];
+    this->GatherBlock(blockIdx, scalars, fblock);
 
+    zfp::ZFPBlockEncoder<BlockSize, Scalar, BitstreamPortal> encoder;
+
+    encoder.encode(fblock, vtkm::Int32(MaxBits), vtkm::UInt32(blockIdx), stream);
+  }
+
+protected:
+  template <typename InputScalarPortal, typename Scalar>
+  VTKM_EXEC void GatherBlock(const vtkm::Id blockIdx,
+                             const InputScalarPortal& scalars,
+                             Scalar* fblock) const
+  {
     vtkm::Id3 zfpBlock;
     zfpBlock[0] = blockIdx % ZFPDims[0];
     zfpBlock[1] = (blockIdx / ZFPDims[0]) % ZFPDims[1];
@@ -145,10 +157,65 @@ public:
     {
       Gather3(fblock, scalars, Dims, offset);
     }
+  }
+};
 
-    zfp::ZFPBlockEncoder<BlockSize, Scalar, BitstreamPortal> encoder;
+// Computes the number of bits each block needs in the fixed-accuracy and fixed-precision
+// modes, where the size of a block depends on its values.
+struct EncodeBlockSize3 : public Encode3
+{
+protected:
+  vtkm::Int32 MaxPrec; // most bit planes kept per block
+  vtkm::Int32 MinExp;  // smallest bit plane kept
+public:
+  EncodeBlockSize3(const vtkm::Id3 dims, const vtkm::Id3 paddedDims, const ZFPStream& stream)
+    : Encode3(dims, paddedDims, stream.maxbits)
+    , MaxPrec(vtkm::Int32(stream.maxprec))
+    , MinExp(stream.minexp)
+  {
+  }
+  using ControlSignature = void(FieldIn, WholeArrayIn, FieldOut blockBits);
 
-    encoder.encode(fblock, vtkm::Int32(MaxBits), vtkm::UInt32(blockIdx), stream);
+  template <typename InputScalarPortal>
+  VTKM_EXEC void operator()(const vtkm::Id blockIdx,
+                            const InputScalarPortal& scalars,
+                            vtkm::Id& blockBits) const
+  {
+    using Scalar = typename InputScalarPortal::ValueType;
+    constexpr vtkm::Int32 BlockSize = 64;
+    Scalar fblock[BlockSize];
+    this->GatherBlock(blockIdx, scalars, fblock);
+
+    zfp::ZFPBlockEncoder<BlockSize, Scalar, InputScalarPortal> encoder;
+    zfp::NullBlockWriter writer;
+    blockBits = encoder.encode(writer, fblock, vtkm::Int32(MaxBits), MaxPrec, MinExp);
+  }
+};
+
+// Encodes blocks of variable size, each starting at the bit given by an index of offsets.
+struct EncodeIndexed3 : public EncodeBlockSize3
+{
+  EncodeIndexed3(const vtkm::Id3 dims, const vtkm::Id3 paddedDims, const ZFPStream& stream)
+    : EncodeBlockSize3(dims, paddedDims, stream)
+  {
+  }
+  using ControlSignature = void(FieldIn, FieldIn blockOffset, WholeArrayIn, AtomicArrayInOut);
+
+  template <typename InputScalarPortal, typename BitstreamPortal>
+  VTKM_EXEC void operator()(const vtkm::Id blockIdx,
+                            const vtkm::Id blockOffset,
+                            const InputScalarPortal& scalars,
+                            BitstreamPortal& stream) const
+  {
+    using Scalar = typename InputScalarPortal::ValueType;
+    constexpr vtkm::Int32 BlockSize = 64;
+    Scalar fblock[BlockSize];
+    this->GatherBlock(blockIdx, scalars, fblock);
+
+    zfp::ZFPBlockEncoder<BlockSize, Scalar, BitstreamPortal> encoder;
+    zfp::BlockWriter<BlockSize, BitstreamPortal> writer(
+      stream, vtkm::Int32(MaxBits), zfp::BlockBitOffset{ blockOffset });
+    encoder.encode(writer, fblock, vtkm::Int32(MaxBits), MaxPrec, MinExp);
   }
 };
 }
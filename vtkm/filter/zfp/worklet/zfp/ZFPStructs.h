@@ -18,6 +18,8 @@
 #include <vtkm/filter/zfp/worklet/zfp/ZFPFunctions.h>
 #include <vtkm/filter/zfp/worklet/zfp/ZFPTypeInfo.h>
 
+#include <cmath>
+
 namespace vtkm
 {
 namespace worklet
@@ -49,6 +51,38 @@ struct ZFPStream
     minexp = ZFP_MIN_EXP;
     return (double)bits / n;
   }
+
+  // Fixed-precision mode: every block keeps the given number of bit planes, so the relative
+  // error is bounded and blocks vary in size.
+  vtkm::UInt32 SetPrecision(const vtkm::UInt32 precision)
+  {
+    minbits = ZFP_MIN_BITS;
+    maxbits = ZFP_MAX_BITS;
+    maxprec = precision > ZFP_MAX_PREC ? ZFP_MAX_PREC : precision;
+    minexp = ZFP_MIN_EXP;
+    return maxprec;
+  }
+
+  // Fixed-accuracy mode: bit planes below the tolerance are dropped, so the absolute error is
+  // bounded and blocks vary in size.
+  vtkm::Float64 SetAccuracy(const vtkm::Float64 tolerance)
+  {
+    vtkm::Int32 emin = ZFP_MIN_EXP;
+    if (tolerance > 0)
+    {
+      std::frexp(tolerance, &emin);
+      emin--;
+    }
+    minbits = ZFP_MIN_BITS;
+    maxbits = ZFP_MAX_BITS;
+    maxprec = ZFP_MAX_PREC;
+    minexp = emin;
+    return tolerance > 0 ? std::ldexp(1.0, emin) : 0;
+  }
+
+  // In fixed-rate mode every block has the same size, so a block is found from its index.
+  // Otherwise a block is found from an index of block offsets.
+  bool IsFixedRate() const { return minbits == maxbits; }
 };
 }
 }
@@ -222,6 +222,13 @@ struct block_traits<2>
   typedef unsigned short PlaneType;
 };
 
+// The position of the first bit of a block in a stream. Blocks compressed in the fixed-accuracy
+// and fixed-precision modes vary in size, so they cannot be located from their index alone.
+struct BlockBitOffset
+{
+  vtkm::Id Value;
+};
+
 } // namespace zfp
 } // namespace worklet
 } // namespace vtkm
@@ -10,24 +10,17 @@
 
 #include <vtkm/io/BOVDataSetReader.h>
 
+#include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/io/ErrorIO.h>
 
 #include <fstream>
 #include <sstream>
+#include <vector>
 
 namespace
 {
 
-enum class DataFormat
-{
-  ByteData,
-  ShortData,
-  IntegerData,
-  FloatData,
-  DoubleData
-};
-
 template <typename T>
 void ReadBuffer(const std::string& fName, const vtkm::Id& sz, std::vector<T>& buff)
 {
@@ -46,11 +39,49 @@ void ReadBuffer(const std::string& fName, const vtkm::Id& sz, std::vector<T>& bu
   fclose(fp);
 }
 
+// Read the values of the points in a brick of the volume. Each row of the brick is
+// contiguous in the file, so the brick is read with one seek and one read per row.
+template <typename T>
+void ReadBrickBuffer(const std::string& fName,
+                     const vtkm::Id3& dims,
+                     const vtkm::Id3& brickStart,
+                     const vtkm::Id3& brickDims,
+                     vtkm::Id numComponents,
+                     std::vector<T>& buff)
+{
+  std::ifstream stream(fName, std::ios::in | std::ios::binary);
+  if (stream.fail())
+  {
+    throw vtkm::io::ErrorIO("Unable to open data file: " + fName);
+  }
+
+  const vtkm::Id rowSize = brickDims[0] * numComponents;
+  buff.resize(static_cast<size_t>(rowSize * brickDims[1] * brickDims[2]));
+  T* rowBuffer = buff.data();
+  for (vtkm::Id k = 0; k < brickDims[2]; ++k)
+  {
+    for (vtkm::Id j = 0; j < brickDims[1]; ++j)
+    {
+      vtkm::Id fileIndex =
+        ((brickStart[2] + k) * dims[1] + (brickStart[1] + j)) * dims[0] + brickStart[0];
+      stream.seekg(static_cast<std::streamoff>(fileIndex * numComponents) *
+                   static_cast<std::streamoff>(sizeof(T)));
+      stream.read(reinterpret_cast<char*>(rowBuffer),
+                  static_cast<std::streamsize>(static_cast<size_t>(rowSize) * sizeof(T)));
+      if (stream.fail())
+      {
+        throw vtkm::io::ErrorIO("Data file read failed: " + fName);
+      }
+      rowBuffer += rowSize;
+    }
+  }
+}
+
 template <typename T>
-void ReadScalar(const std::string& fName, const vtkm::Id& nTuples, vtkm::cont::ArrayHandle<T>& var)
+void ReadScalar(const std::vector<T>& buff,
+                const vtkm::Id& nTuples,
+                vtkm::cont::ArrayHandle<T>& var)
 {
-  std::vector<T> buff;
-  ReadBuffer(fName, nTuples, buff);
   var.Allocate(nTuples);
   auto writePortal = var.WritePortal();
   for (vtkm::Id i = 0; i < nTuples; i++)
@@ -60,13 +91,10 @@ void ReadScalar(const std::string& fName, const vtkm::Id& nTuples, vtkm::cont::A
 }
 
 template <typename T>
-void ReadVector(const std::string& fName,
+void ReadVector(const std::vector<T>& buff,
                 const vtkm::Id& nTuples,
                 vtkm::cont::ArrayHandle<vtkm::Vec<T, 3>>& var)
 {
-  std::vector<T> buff;
-  ReadBuffer(fName, nTuples * 3, buff);
-
   var.Allocate(nTuples);
   vtkm::Vec<T, 3> v;
   auto writePortal = var.WritePortal();
@@ -114,9 +142,40 @@ const vtkm::cont::DataSet& BOVDataSetReader::ReadDataSet()
   return this->DataSet;
 }
 
-void BOVDataSetReader::LoadFile()
+vtkm::Id3 BOVDataSetReader::GetPointDimensions()
 {
-  if (this->Loaded)
+  try
+  {
+    this->LoadHeader();
+  }
+  catch (std::ifstream::failure& e)
+  {
+    std::string message("IO Error: ");
+    throw vtkm::io::ErrorIO(message + e.what());
+  }
+  return this->Dimensions;
+}
+
+void BOVDataSetReader::SetBrick(const vtkm::Id3& pointIndexStart, const vtkm::Id3& pointDimensions)
+{
+  this->UseBrick = true;
+  this->BrickStart = pointIndexStart;
+  this->BrickDimensions = pointDimensions;
+  this->Loaded = false;
+}
+
+void BOVDataSetReader::ClearBrick()
+{
+  if (this->UseBrick)
+  {
+    this->UseBrick = false;
+    this->Loaded = false;
+  }
+}
+
+void BOVDataSetReader::LoadHeader()
+{
+  if (this->HeaderLoaded)
     return;
 
   std::ifstream stream(this->FileName);
@@ -211,39 +270,114 @@ void BOVDataSetReader::LoadFile()
   else
     fullPathDataFile = bovFile;
 
+  this->DataFileName = fullPathDataFile;
+  this->VariableName = variableName;
+  this->Format = dataFormat;
+  this->NumberOfComponents = numComponents;
+  this->Dimensions = dim;
+  this->Origin = origin;
+  this->Spacing = spacing;
+  this->HeaderLoaded = true;
+}
+
+void BOVDataSetReader::LoadFile()
+{
+  if (this->Loaded)
+    return;
+
+  this->LoadHeader();
+
+  vtkm::Id3 start(0);
+  vtkm::Id3 dim = this->Dimensions;
+  if (this->UseBrick)
+  {
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      if (this->BrickStart[d] < 0 || this->BrickDimensions[d] < 1 ||
+          this->BrickStart[d] + this->BrickDimensions[d] > this->Dimensions[d])
+      {
+        throw vtkm::io::ErrorIO("Brick is outside of the volume in " + this->FileName);
+      }
+    }
+    start = this->BrickStart;
+    dim = this->BrickDimensions;
+  }
+
+  vtkm::Vec3f origin = this->Origin + this->Spacing * vtkm::Vec3f(start);
 
   vtkm::cont::DataSetBuilderUniform dataSetBuilder;
-  this->DataSet = dataSetBuilder.Create(dim, origin, spacing);
+  this->DataSet = dataSetBuilder.Create(dim, origin, this->Spacing);
+
+  if (this->UseBrick)
+  {
+    // Record where the brick lies in the whole volume
+    if (this->Dimensions[2] <= 1)
+    {
+      vtkm::cont::CellSetStructured<2> cellSet;
+      cellSet.SetPointDimensions(vtkm::Id2{ dim[0], dim[1] });
+      cellSet.SetGlobalPointDimensions(vtkm::Id2{ this->Dimensions[0], this->Dimensions[1] });
+      cellSet.SetGlobalPointIndexStart(vtkm::Id2{ start[0], start[1] });
+      this->DataSet.SetCellSet(cellSet);
+    }
+    else
+    {
+      vtkm::cont::CellSetStructured<3> cellSet;
+      cellSet.SetPointDimensions(dim);
+      cellSet.SetGlobalPointDimensions(this->Dimensions);
+      cellSet.SetGlobalPointIndexStart(start);
+      this->DataSet.SetCellSet(cellSet);
+    }
+  }
 
   vtkm::Id numTuples = dim[0] * dim[1] * dim[2];
-  if (numComponents == 1)
+  auto readValues = [&](auto& buff) {
+    if (this->UseBrick)
+    {
+      ReadBrickBuffer(
+        this->DataFileName, this->Dimensions, start, dim, this->NumberOfComponents, buff);
+    }
+    else
+    {
+      ReadBuffer(this->DataFileName, numTuples * this->NumberOfComponents, buff);
+    }
+  };
+
+  if (this->NumberOfComponents == 1)
   {
-    if (dataFormat == DataFormat::FloatData)
+    if (this->Format == DataFormat::FloatData)
     {
+      std::vector<vtkm::Float32> buff;
+      readValues(buff);
       vtkm::cont::ArrayHandle<vtkm::Float32> var;
-      ReadScalar(fullPathDataFile, numTuples, var);
-      this->DataSet.AddPointField(variableName, var);
+      ReadScalar(buff, numTuples, var);
+      this->DataSet.AddPointField(this->VariableName, var);
     }
-    else if (dataFormat == DataFormat::DoubleData)
+    else if (this->Format == DataFormat::DoubleData)
     {
+      std::vector<vtkm::Float64> buff;
+      readValues(buff);
       vtkm::cont::ArrayHandle<vtkm::Float64> var;
-      ReadScalar(fullPathDataFile, numTuples, var);
-      this->DataSet.AddPointField(variableName, var);
+      ReadScalar(buff, numTuples, var);
+      this->DataSet.AddPointField(this->VariableName, var);
     }
   }
-  else if (numComponents == 3)
+  else if (this->NumberOfComponents == 3)
   {
-    if (dataFormat == DataFormat::FloatData)
+    if (this->Format == DataFormat::FloatData)
     {
+      std::vector<vtkm::Float32> buff;
+      readValues(buff);
       vtkm::cont::ArrayHandle<vtkm::Vec3f_32> var;
-      ReadVector(fullPathDataFile, numTuples, var);
-      this->DataSet.AddPointField(variableName, var);
+      ReadVector(buff, numTuples, var);
+      this->DataSet.AddPointField(this->VariableName, var);
     }
-    else if (dataFormat == DataFormat::DoubleData)
+    else if (this->Format == DataFormat::DoubleData)
     {
+      std::vector<vtkm::Float64> buff;
+      readValues(buff);
       vtkm::cont::ArrayHandle<vtkm::Vec3f_64> var;
-      ReadVector(fullPathDataFile, numTuples, var);
-      this->DataSet.AddPointField(variableName, var);
+      ReadVector(buff, numTuples, var);
+      this->DataSet.AddPointField(this->VariableName, var);
     }
   }
 
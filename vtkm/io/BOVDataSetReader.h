@@ -27,12 +27,55 @@ public:
 
   VTKM_CONT const vtkm::cont::DataSet& ReadDataSet();
 
+  /// @brief The point dimensions of the whole volume described by the .bov header.
+  ///
+  /// Only the header is parsed, so this can be used to plan a decomposition into
+  /// bricks before any data is read.
+  VTKM_CONT vtkm::Id3 GetPointDimensions();
+
+  /// @brief Restrict reading to a brick of the volume.
+  ///
+  /// When a brick is set, `ReadDataSet` reads only the points starting at
+  /// `pointIndexStart` with the given `pointDimensions` from the data file. The
+  /// structured cell set of the result records the global point dimensions and the
+  /// global start index of the brick, so the bricks of a volume can be passed as
+  /// partitions to filters that need the global structure (such as the distributed
+  /// contour tree). This allows processing volumes that do not fit into memory as a
+  /// whole one brick at a time.
+  VTKM_CONT void SetBrick(const vtkm::Id3& pointIndexStart, const vtkm::Id3& pointDimensions);
+
+  /// @brief Read the whole volume again after `SetBrick` has been called.
+  VTKM_CONT void ClearBrick();
+
 private:
+  VTKM_CONT void LoadHeader();
   VTKM_CONT void LoadFile();
 
+  enum class DataFormat
+  {
+    ByteData,
+    ShortData,
+    IntegerData,
+    FloatData,
+    DoubleData
+  };
+
   std::string FileName;
   bool Loaded;
   vtkm::cont::DataSet DataSet;
+
+  bool HeaderLoaded = false;
+  std::string DataFileName;
+  std::string VariableName;
+  DataFormat Format = DataFormat::ByteData;
+  vtkm::Id NumberOfComponents = 1;
+  vtkm::Id3 Dimensions = vtkm::Id3(0);
+  vtkm::Vec3f Origin = vtkm::Vec3f(0);
+  vtkm::Vec3f Spacing = vtkm::Vec3f(1);
+
+  bool UseBrick = false;
+  vtkm::Id3 BrickStart = vtkm::Id3(0);
+  vtkm::Id3 BrickDimensions = vtkm::Id3(0);
 };
 }
 } // vtkm::io
@@ -8,7 +8,11 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <cstdio>
+#include <fstream>
 #include <string>
+#include <vector>
+#include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/cont/testing/Testing.h>
 #include <vtkm/io/BOVDataSetReader.h>
 #include <vtkm/io/ErrorIO.h>
@@ -64,8 +68,106 @@ void TestReadingBOVDataSet()
                    "The field should be associated with points.");
 }
 
+// Removes the files written by a test when it finishes, even if it fails.
+struct RemoveFilesOnExit
+{
+  std::vector<std::string> FileNames;
+  ~RemoveFilesOnExit()
+  {
+    for (const std::string& fileName : this->FileNames)
+    {
+      std::remove(fileName.c_str());
+    }
+  }
+};
+
+void TestReadingBOVBricks()
+{
+  std::cout << "Testing reading bricks of a BOV file" << std::endl;
+
+  // Write a small volume where each value encodes the index of its point.
+  const vtkm::Id3 dims{ 7, 5, 4 };
+  std::vector<vtkm::Float32> values(static_cast<std::size_t>(dims[0] * dims[1] * dims[2]));
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = static_cast<vtkm::Float32>(i);
+  }
+  // The data file is found relative to the directory of the header file.
+  const std::string headerFileName =
+    vtkm::cont::testing::Testing::WriteDirPath("bov_bricks.bov");
+  const std::string dataFileName = vtkm::cont::testing::Testing::WriteDirPath("bov_bricks.values");
+  RemoveFilesOnExit removeFiles{ { headerFileName, dataFileName } };
+  {
+    std::ofstream dataFile(dataFileName, std::ios::binary);
+    dataFile.write(reinterpret_cast<const char*>(values.data()),
+                   static_cast<std::streamsize>(values.size() * sizeof(vtkm::Float32)));
+    std::ofstream headerFile(headerFileName);
+    headerFile << "DATA_FILE: bov_bricks.values" << std::endl
+               << "DATA_SIZE: " << dims[0] << " " << dims[1] << " " << dims[2] << std::endl
+               << "DATA_FORMAT: FLOAT" << std::endl
+               << "VARIABLE: var" << std::endl;
+  }
+
+  vtkm::io::BOVDataSetReader reader(headerFileName);
+  VTKM_TEST_ASSERT(reader.GetPointDimensions() == dims, "Wrong point dimensions");
+
+  const vtkm::Id3 brickStart{ 2, 1, 1 };
+  const vtkm::Id3 brickDims{ 4, 3, 2 };
+  reader.SetBrick(brickStart, brickDims);
+  vtkm::cont::DataSet brick = reader.ReadDataSet();
+  VTKM_TEST_ASSERT(brick.GetNumberOfPoints() == brickDims[0] * brickDims[1] * brickDims[2],
+                   "Wrong number of points in brick");
+
+  vtkm::cont::CellSetStructured<3> cellSet;
+  brick.GetCellSet().AsCellSet(cellSet);
+  VTKM_TEST_ASSERT(cellSet.GetPointDimensions() == brickDims, "Wrong brick dimensions");
+  VTKM_TEST_ASSERT(cellSet.GetGlobalPointDimensions() == dims, "Wrong global dimensions");
+  VTKM_TEST_ASSERT(cellSet.GetGlobalPointIndexStart() == brickStart, "Wrong brick start");
+
+  vtkm::cont::ArrayHandle<vtkm::Float32> brickValues;
+  brick.GetField("var").GetData().AsArrayHandle(brickValues);
+  auto brickPortal = brickValues.ReadPortal();
+  vtkm::Id brickIndex = 0;
+  for (vtkm::Id k = 0; k < brickDims[2]; ++k)
+  {
+    for (vtkm::Id j = 0; j < brickDims[1]; ++j)
+    {
+      for (vtkm::Id i = 0; i < brickDims[0]; ++i)
+      {
+        vtkm::Id index =
+          ((brickStart[2] + k) * dims[1] + brickStart[1] + j) * dims[0] + brickStart[0] + i;
+        VTKM_TEST_ASSERT(test_equal(brickPortal.Get(brickIndex++), index),
+                         "Wrong value in brick");
+      }
+    }
+  }
+
+  reader.ClearBrick();
+  VTKM_TEST_ASSERT(reader.ReadDataSet().GetNumberOfPoints() == dims[0] * dims[1] * dims[2],
+                   "Wrong number of points in volume");
+
+  bool caughtError = false;
+  try
+  {
+    reader.SetBrick(vtkm::Id3{ 4, 0, 0 }, vtkm::Id3{ 4, 1, 1 });
+    reader.ReadDataSet();
+  }
+  catch (vtkm::io::ErrorIO& error)
+  {
+    std::cout << "Got expected error: " << error.GetMessage() << std::endl;
+    caughtError = true;
+  }
+  VTKM_TEST_ASSERT(caughtError, "Expected error for brick outside of volume.");
+}
+
+void TestBOVDataSetReader()
+{
+  TestReadingBOVBricks();
+  TestReadingBOVDataSet();
+}
+
 
 int UnitTestBOVDataSetReader(int argc, char* argv[])
 {
-  return vtkm::cont::testing::Testing::Run(TestReadingBOVDataSet, argc, argv);
+  return vtkm::cont::testing::Testing::Run(TestBOVDataSetReader, argc, argv);
 }
@@ -7,6 +7,7 @@
 //  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
+#include <vtkm/cont/ArrayHandleTransform.h>
 #include <vtkm/source/Oscillator.h>
 #include <vtkm/worklet/WorkletMapField.h>
 
@@ -21,12 +22,12 @@ struct Oscillation
   vtkm::FloatDefault Zeta;
 };
 
-class OscillatorWorklet : public vtkm::worklet::WorkletMapField
+// Computes the oscillating field at a point. It is used both by the worklet that fills the
+// field and, as the functor of an `ArrayHandleTransform` of the point coordinates, to compute
+// values on demand.
+class OscillatorFunctor
 {
 public:
-  typedef void ControlSignature(FieldIn, FieldOut);
-  typedef _2 ExecutionSignature(_1);
-
   VTKM_CONT
   void AddPeriodic(vtkm::FloatDefault x,
                    vtkm::FloatDefault y,
@@ -72,7 +73,7 @@ public:
   VTKM_CONT
   void SetTime(vtkm::FloatDefault time) { this->Time = time; }
 
-  VTKM_EXEC
+  VTKM_EXEC_CONT
   vtkm::FloatDefault operator()(const vtkm::Vec3f& vec) const
   {
     vtkm::IdComponent oIdx;
@@ -137,6 +138,25 @@ private:
   vtkm::VecVariable<Oscillation, MAX_OSCILLATORS> DampedOscillators;
   vtkm::VecVariable<Oscillation, MAX_OSCILLATORS> DecayingOscillators;
   vtkm::FloatDefault Time{};
+}; // OscillatorFunctor
+
+class OscillatorWorklet : public vtkm::worklet::WorkletMapField
+{
+public:
+  typedef void ControlSignature(FieldIn, FieldOut);
+  typedef _2 ExecutionSignature(_1);
+
+  VTKM_CONT
+  OscillatorWorklet(const OscillatorFunctor& functor)
+    : Functor(functor)
+  {
+  }
+
+  VTKM_EXEC
+  vtkm::FloatDefault operator()(const vtkm::Vec3f& vec) const { return this->Functor(vec); }
+
+private:
+  OscillatorFunctor Functor;
 }; // OscillatorWorklet
 
 } // anonymous namespace
@@ -150,7 +170,8 @@ namespace source
 struct Oscillator::InternalStruct
 {
   vtkm::Id3 PointDimensions = { 3, 3, 3 };
-  OscillatorWorklet Worklet;
+  OscillatorFunctor Functor;
+  bool UseImplicitFields = false;
 };
 
 //-----------------------------------------------------------------------------
@@ -187,10 +208,20 @@ vtkm::Id3 Oscillator::GetCellDimensions() const
   return this->GetPointDimensions() - vtkm::Id3(1);
 }
 
+//-----------------------------------------------------------------------------
+void Oscillator::SetUseImplicitFields(bool flag)
+{
+  this->Internals->UseImplicitFields = flag;
+}
+bool Oscillator::GetUseImplicitFields() const
+{
+  return this->Internals->UseImplicitFields;
+}
+
 //-----------------------------------------------------------------------------
 void Oscillator::SetTime(vtkm::FloatDefault time)
 {
-  this->Internals->Worklet.SetTime(time);
+  this->Internals->Functor.SetTime(time);
 }
 
 //-----------------------------------------------------------------------------
@@ -201,7 +232,7 @@ void Oscillator::AddPeriodic(vtkm::FloatDefault x,
                              vtkm::FloatDefault omega,
                              vtkm::FloatDefault zeta)
 {
-  this->Internals->Worklet.AddPeriodic(x, y, z, radius, omega, zeta);
+  this->Internals->Functor.AddPeriodic(x, y, z, radius, omega, zeta);
 }
 
 //-----------------------------------------------------------------------------
@@ -212,7 +243,7 @@ void Oscillator::AddDamped(vtkm::FloatDefault x,
                            vtkm::FloatDefault omega,
                            vtkm::FloatDefault zeta)
 {
-  this->Internals->Worklet.AddDamped(x, y, z, radius, omega, zeta);
+  this->Internals->Functor.AddDamped(x, y, z, radius, omega, zeta);
 }
 
 //-----------------------------------------------------------------------------
@@ -223,7 +254,7 @@ void Oscillator::AddDecaying(vtkm::FloatDefault x,
                              vtkm::FloatDefault omega,
                              vtkm::FloatDefault zeta)
 {
-  this->Internals->Worklet.AddDecaying(x, y, z, radius, omega, zeta);
+  this->Internals->Functor.AddDecaying(x, y, z, radius, omega, zeta);
 }
 
 
@@ -249,9 +280,18 @@ vtkm::cont::DataSet Oscillator::DoExecute() const
   dataSet.AddCoordinateSystem(vtkm::cont::CoordinateSystem("coordinates", coordinates));
 
 
-  vtkm::cont::ArrayHandle<vtkm::FloatDefault> outArray;
-  this->Invoke(this->Internals->Worklet, coordinates, outArray);
-  dataSet.AddField(vtkm::cont::make_FieldPoint("oscillating", outArray));
+  if (this->Internals->UseImplicitFields)
+  {
+    dataSet.AddField(vtkm::cont::make_FieldPoint(
+      "oscillating",
+      vtkm::cont::make_ArrayHandleTransform(coordinates, this->Internals->Functor)));
+  }
+  else
+  {
+    vtkm::cont::ArrayHandle<vtkm::FloatDefault> outArray;
+    this->Invoke(OscillatorWorklet{ this->Internals->Functor }, coordinates, outArray);
+    dataSet.AddField(vtkm::cont::make_FieldPoint("oscillating", outArray));
+  }
 
   return dataSet;
 }
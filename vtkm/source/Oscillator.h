@@ -24,6 +24,9 @@ namespace source
  *
  * This array is based on the coordinates and evaluates to a sum of time-varying
  * Gaussian exponentials specified in its configuration.
+ *
+ * If `UseImplicitFields` is on, the field is computed each time a value is
+ * read instead of being stored.
  */
 class VTKM_SOURCE_EXPORT Oscillator final : public vtkm::source::Source
 {
@@ -45,6 +48,18 @@ public:
   VTKM_CONT void SetCellDimensions(vtkm::Id3 pointDimensions);
   VTKM_CONT vtkm::Id3 GetCellDimensions() const;
 
+  ///@{
+  /// \brief Specifies whether the point field is computed on demand.
+  ///
+  /// When on, `oscillating` is an `ArrayHandleTransform` of the point
+  /// coordinates that evaluates the oscillators whenever a value is read, so no
+  /// memory is allocated for the field. Most filters copy a field with this
+  /// storage into a basic array before using it, so the memory is only saved up
+  /// to the first such filter. The default is off.
+  VTKM_CONT void SetUseImplicitFields(bool flag);
+  VTKM_CONT bool GetUseImplicitFields() const;
+  ///@}
+
   VTKM_CONT
   void SetTime(vtkm::FloatDefault time);
 
@@ -11,6 +11,8 @@
 #include <random>
 
 #include <vtkm/VectorAnalysis.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/ExecutionAndControlObjectBase.h>
 #include <vtkm/filter/Filter.h>
 #include <vtkm/source/PerlinNoise.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
@@ -20,20 +22,20 @@
 namespace
 {
 
-struct PerlinNoiseWorklet : public vtkm::worklet::WorkletVisitPointsWithCells
+// Evaluates the noise at a point given the permutation table. It is shared by the worklet that
+// fills the field and the functor that computes values on demand.
+struct PerlinNoiseFunction
 {
-  using ControlSignature = void(CellSetIn, FieldInPoint, WholeArrayIn, FieldOut noise);
-  using ExecutionSignature = void(_2, _3, _4);
-
-  VTKM_CONT PerlinNoiseWorklet(vtkm::Id repeat)
+  VTKM_EXEC_CONT PerlinNoiseFunction(vtkm::Id repeat = 1)
     : Repeat(repeat)
   {
   }
 
   // Adapted from https://adrianb.io/2014/08/09/perlinnoise.html
   // Archive link: https://web.archive.org/web/20210329174559/https://adrianb.io/2014/08/09/perlinnoise.html
-  template <typename PointVecType, typename PermsPortal, typename OutType>
-  VTKM_EXEC void operator()(const PointVecType& pos, const PermsPortal& perms, OutType& noise) const
+  template <typename PointVecType, typename PermsPortal>
+  VTKM_EXEC_CONT vtkm::FloatDefault operator()(const PointVecType& pos,
+                                               const PermsPortal& perms) const
   {
     vtkm::Id xi = static_cast<vtkm::Id>(pos[0]) % this->Repeat;
     vtkm::Id yi = static_cast<vtkm::Id>(pos[1]) % this->Repeat;
@@ -68,20 +70,20 @@ struct PerlinNoiseWorklet : public vtkm::worklet::WorkletVisitPointsWithCells
       this->Gradient(abb, xf, yf - 1, zf - 1), this->Gradient(bbb, xf - 1, yf - 1, zf - 1), u);
     y2 = vtkm::Lerp(x1, x2, v);
 
-    noise = (vtkm::Lerp(y1, y2, w) + OutType(1.0f)) * OutType(0.5f);
+    return (vtkm::Lerp(y1, y2, w) + vtkm::FloatDefault(1.0f)) * vtkm::FloatDefault(0.5f);
   }
 
-  VTKM_EXEC vtkm::FloatDefault Fade(vtkm::FloatDefault t) const
+  VTKM_EXEC_CONT vtkm::FloatDefault Fade(vtkm::FloatDefault t) const
   {
     return t * t * t * (t * (t * 6 - 15) + 10);
   }
 
-  VTKM_EXEC vtkm::Id Increment(vtkm::Id n) const { return (n + 1) % this->Repeat; }
+  VTKM_EXEC_CONT vtkm::Id Increment(vtkm::Id n) const { return (n + 1) % this->Repeat; }
 
-  VTKM_EXEC vtkm::FloatDefault Gradient(vtkm::Id hash,
-                                        vtkm::FloatDefault x,
-                                        vtkm::FloatDefault y,
-                                        vtkm::FloatDefault z) const
+  VTKM_EXEC_CONT vtkm::FloatDefault Gradient(vtkm::Id hash,
+                                             vtkm::FloatDefault x,
+                                             vtkm::FloatDefault y,
+                                             vtkm::FloatDefault z) const
   {
     switch (hash & 0xF)
     {
@@ -125,6 +127,69 @@ struct PerlinNoiseWorklet : public vtkm::worklet::WorkletVisitPointsWithCells
   vtkm::Id Repeat;
 };
 
+struct PerlinNoiseWorklet : public vtkm::worklet::WorkletVisitPointsWithCells
+{
+  using ControlSignature = void(CellSetIn, FieldInPoint, WholeArrayIn, FieldOut noise);
+  using ExecutionSignature = void(_2, _3, _4);
+
+  VTKM_CONT PerlinNoiseWorklet(vtkm::Id repeat)
+    : Function(repeat)
+  {
+  }
+
+  template <typename PointVecType, typename PermsPortal, typename OutType>
+  VTKM_EXEC void operator()(const PointVecType& pos, const PermsPortal& perms, OutType& noise) const
+  {
+    noise = static_cast<OutType>(this->Function(pos, perms));
+  }
+
+  PerlinNoiseFunction Function;
+};
+
+// Noise of a point given its coordinates. The permutation table is prepared for the device
+// with the functor, so an `ArrayHandleTransform` of the coordinates can compute the noise on
+// demand.
+template <typename PermsPortal>
+struct PerlinNoiseEvaluator
+{
+  PerlinNoiseFunction Function;
+  PermsPortal Permutations;
+
+  VTKM_EXEC_CONT vtkm::FloatDefault operator()(const vtkm::Vec3f& pos) const
+  {
+    return this->Function(pos, this->Permutations);
+  }
+};
+
+struct PerlinNoiseFunctor : public vtkm::cont::ExecutionAndControlObjectBase
+{
+  vtkm::Id Repeat = 1;
+  vtkm::cont::ArrayHandle<vtkm::Id> Permutations;
+
+  PerlinNoiseFunctor() = default;
+
+  VTKM_CONT PerlinNoiseFunctor(vtkm::Id repeat, const vtkm::cont::ArrayHandle<vtkm::Id>& perms)
+    : Repeat(repeat)
+    , Permutations(perms)
+  {
+  }
+
+  using PortalType = typename vtkm::cont::ArrayHandle<vtkm::Id>::ReadPortalType;
+
+  VTKM_CONT PerlinNoiseEvaluator<PortalType> PrepareForExecution(
+    vtkm::cont::DeviceAdapterId device,
+    vtkm::cont::Token& token) const
+  {
+    return { PerlinNoiseFunction{ this->Repeat },
+             this->Permutations.PrepareForInput(device, token) };
+  }
+
+  VTKM_CONT PerlinNoiseEvaluator<PortalType> PrepareForControl() const
+  {
+    return { PerlinNoiseFunction{ this->Repeat }, this->Permutations.ReadPortal() };
+  }
+};
+
 class PerlinNoiseField : public vtkm::filter::Filter
 {
 public:
@@ -136,9 +201,22 @@ public:
     this->SetUseCoordinateSystemAsField(true);
   }
 
+  VTKM_CONT void SetUseImplicitFields(bool flag) { this->UseImplicitFields = flag; }
+
 private:
   VTKM_CONT vtkm::cont::DataSet DoExecute(const vtkm::cont::DataSet& input) override
   {
+    if (this->UseImplicitFields)
+    {
+      vtkm::cont::ArrayHandleUniformPointCoordinates coordinates;
+      input.GetCoordinateSystem().GetData().AsArrayHandle(coordinates);
+      return this->CreateResultFieldPoint(
+        input,
+        this->GetOutputFieldName(),
+        vtkm::cont::make_ArrayHandleTransform(
+          coordinates, PerlinNoiseFunctor{ this->TableSize, this->Permutations }));
+    }
+
     vtkm::cont::ArrayHandle<vtkm::FloatDefault> noise;
     PerlinNoiseWorklet worklet{ this->TableSize };
     this->Invoke(
@@ -170,6 +248,7 @@ private:
   vtkm::IdComponent TableSize;
   vtkm::IdComponent Seed;
   vtkm::cont::ArrayHandle<vtkm::Id> Permutations;
+  bool UseImplicitFields = false;
 };
 
 } // anonymous namespace
@@ -245,6 +324,7 @@ vtkm::cont::DataSet PerlinNoise::DoExecute() const
 
   PerlinNoiseField noiseGenerator(tableSize, seed);
   noiseGenerator.SetOutputFieldName("perlinnoise");
+  noiseGenerator.SetUseImplicitFields(this->UseImplicitFields);
   dataSet = noiseGenerator.Execute(dataSet);
 
   return dataSet;
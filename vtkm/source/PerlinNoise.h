@@ -25,6 +25,9 @@ namespace source
  *
  * The Execute method creates a complete structured dataset that have a
  * scalar point field named 'perlinnoise'.
+ *
+ * If `UseImplicitFields` is on, the field is computed each time a value is
+ * read instead of being stored.
 **/
 class VTKM_SOURCE_EXPORT PerlinNoise final : public vtkm::source::Source
 {
@@ -65,6 +68,19 @@ public:
     this->SeedSet = true;
   }
 
+  ///@{
+  /// \brief Specifies whether the point field is computed on demand.
+  ///
+  /// When on, `perlinnoise` is an `ArrayHandleTransform` of the point
+  /// coordinates that evaluates the noise whenever a value is read, so no
+  /// memory is allocated for the field. Only the permutation table is stored.
+  /// Most filters copy a field with this storage into a basic array before
+  /// using it, so the memory is only saved up to the first such filter. The
+  /// default is off.
+  VTKM_CONT void SetUseImplicitFields(bool flag) { this->UseImplicitFields = flag; }
+  VTKM_CONT bool GetUseImplicitFields() const { return this->UseImplicitFields; }
+  ///@}
+
 private:
   vtkm::cont::DataSet DoExecute() const override;
 
@@ -72,6 +88,7 @@ private:
   vtkm::Vec3f Origin = { 0, 0, 0 };
   vtkm::IdComponent Seed = 0;
   bool SeedSet = false;
+  bool UseImplicitFields = false;
 };
 } //namespace source
 } //namespace vtkm
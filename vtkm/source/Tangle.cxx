@@ -9,6 +9,7 @@
 //============================================================================
 
 #include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/ArrayHandleImplicit.h>
 #include <vtkm/source/Tangle.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
 
@@ -18,33 +19,31 @@ namespace source
 {
 namespace tangle
 {
-class TangleField : public vtkm::worklet::WorkletVisitPointsWithCells
+// Computes the tangle value of a point. It is used both by the worklet that fills the field
+// and, as the functor of an `ArrayHandleImplicit`, to compute values on demand.
+class TangleFunctor
 {
 public:
-  using ControlSignature = void(CellSetIn, FieldOut v);
-  using ExecutionSignature = void(ThreadIndices, _2);
-  using InputDomain = _1;
-
-  const vtkm::Vec3f CellDimsf;
-  const vtkm::Vec3f Mins;
-  const vtkm::Vec3f Maxs;
+  vtkm::Vec3f CellDimsf;
+  vtkm::Vec3f Mins;
+  vtkm::Vec3f Maxs;
+  vtkm::Id3 PointDims;
 
   VTKM_CONT
-  TangleField(const vtkm::Id3& cdims, const vtkm::Vec3f& mins, const vtkm::Vec3f& maxs)
+  TangleFunctor(const vtkm::Id3& cdims, const vtkm::Vec3f& mins, const vtkm::Vec3f& maxs)
     : CellDimsf(static_cast<vtkm::FloatDefault>(cdims[0]),
                 static_cast<vtkm::FloatDefault>(cdims[1]),
                 static_cast<vtkm::FloatDefault>(cdims[2]))
     , Mins(mins)
     , Maxs(maxs)
+    , PointDims(cdims + vtkm::Id3(1))
   {
   }
 
-  template <typename ThreadIndexType>
-  VTKM_EXEC void operator()(const ThreadIndexType& threadIndex, vtkm::Float32& v) const
+  TangleFunctor() = default;
+
+  VTKM_EXEC_CONT vtkm::Float32 Evaluate(const vtkm::Id3& ijk) const
   {
-    //We are operating on a 3d structured grid. This means that the threadIndex has
-    //efficiently computed the i,j,k of the point current point for us
-    const vtkm::Id3 ijk = threadIndex.GetInputIndex3D();
     const vtkm::Vec3f xyzf = static_cast<vtkm::Vec3f>(ijk) / this->CellDimsf;
 
     const vtkm::Vec3f_32 values = 3.0f * vtkm::Vec3f_32(Mins + (Maxs - Mins) * xyzf);
@@ -52,11 +51,43 @@ public:
     const vtkm::Float32& yy = values[1];
     const vtkm::Float32& zz = values[2];
 
-    v = (xx * xx * xx * xx - 5.0f * xx * xx + yy * yy * yy * yy - 5.0f * yy * yy +
-         zz * zz * zz * zz - 5.0f * zz * zz + 11.8f) *
-        0.2f +
+    return (xx * xx * xx * xx - 5.0f * xx * xx + yy * yy * yy * yy - 5.0f * yy * yy +
+            zz * zz * zz * zz - 5.0f * zz * zz + 11.8f) *
+      0.2f +
       0.5f;
   }
+
+  VTKM_EXEC_CONT vtkm::Float32 operator()(vtkm::Id index) const
+  {
+    const vtkm::Id3 ijk{ index % this->PointDims[0],
+                         (index / this->PointDims[0]) % this->PointDims[1],
+                         index / (this->PointDims[0] * this->PointDims[1]) };
+    return this->Evaluate(ijk);
+  }
+};
+
+class TangleField : public vtkm::worklet::WorkletVisitPointsWithCells
+{
+public:
+  using ControlSignature = void(CellSetIn, FieldOut v);
+  using ExecutionSignature = void(ThreadIndices, _2);
+  using InputDomain = _1;
+
+  const TangleFunctor Functor;
+
+  VTKM_CONT
+  TangleField(const TangleFunctor& functor)
+    : Functor(functor)
+  {
+  }
+
+  template <typename ThreadIndexType>
+  VTKM_EXEC void operator()(const ThreadIndexType& threadIndex, vtkm::Float32& v) const
+  {
+    //We are operating on a 3d structured grid. This means that the threadIndex has
+    //efficiently computed the i,j,k of the point current point for us
+    v = this->Functor.Evaluate(threadIndex.GetInputIndex3D());
+  }
 };
 } // namespace tangle
 
@@ -75,8 +106,19 @@ vtkm::cont::DataSet Tangle::DoExecute() const
 
   vtkm::Id3 cellDims = this->GetCellDimensions();
 
-  vtkm::cont::ArrayHandle<vtkm::Float32> pointFieldArray;
-  this->Invoke(tangle::TangleField{ cellDims, mins, maxs }, cellSet, pointFieldArray);
+  const tangle::TangleFunctor functor{ cellDims, mins, maxs };
+  vtkm::cont::UnknownArrayHandle pointFieldArray;
+  if (this->UseImplicitFields)
+  {
+    pointFieldArray =
+      vtkm::cont::make_ArrayHandleImplicit(functor, cellSet.GetNumberOfPoints());
+  }
+  else
+  {
+    vtkm::cont::ArrayHandle<vtkm::Float32> values;
+    this->Invoke(tangle::TangleField{ functor }, cellSet, values);
+    pointFieldArray = values;
+  }
 
   const vtkm::Vec3f origin(0.0f, 0.0f, 0.0f);
   const vtkm::Vec3f spacing(1.0f / static_cast<vtkm::FloatDefault>(cellDims[0]),
@@ -31,6 +31,9 @@ namespace source
  *
  * x^4 - 5x^2 + y^4 - 5y^2 + z^4 - 5z^2
  *
+ * If `UseImplicitFields` is on, the field is computed each time a value is
+ * read instead of being stored.
+ *
 **/
 class VTKM_SOURCE_EXPORT Tangle final : public vtkm::source::Source
 {
@@ -50,10 +53,22 @@ public:
   VTKM_CONT vtkm::Id3 GetCellDimensions() const { return this->PointDimensions - vtkm::Id3(1); }
   VTKM_CONT void SetCellDimensions(vtkm::Id3 dims) { this->PointDimensions = dims + vtkm::Id3(1); }
 
+  ///@{
+  /// \brief Specifies whether the point field is computed on demand.
+  ///
+  /// When on, `tangle` is an `ArrayHandleImplicit` that evaluates the function
+  /// whenever a value is read, so no memory is allocated for the field. Most
+  /// filters copy a field with this storage into a basic array before using it,
+  /// so the memory is only saved up to the first such filter. The default is off.
+  VTKM_CONT void SetUseImplicitFields(bool flag) { this->UseImplicitFields = flag; }
+  VTKM_CONT bool GetUseImplicitFields() const { return this->UseImplicitFields; }
+  ///@}
+
 private:
   vtkm::cont::DataSet DoExecute() const override;
 
   vtkm::Id3 PointDimensions = { 16, 16, 16 };
+  bool UseImplicitFields = false;
 };
 } //namespace source
 } //namespace vtkm
@@ -8,8 +8,8 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/cont/ArrayHandleImplicit.h>
 #include <vtkm/source/Wavelet.h>
-#include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/WorkletMapTopology.h>
 
 namespace
@@ -27,12 +27,10 @@ namespace source
 namespace wavelet
 {
 
-struct WaveletField : public vtkm::worklet::WorkletVisitPointsWithCells
+// Computes the RTData value of a point. It is used both by the worklet that fills the field
+// and, as the functor of an `ArrayHandleImplicit`, to compute values on demand.
+struct WaveletFunctor
 {
-  using ControlSignature = void(CellSetIn, FieldOut v);
-  using ExecutionSignature = void(ThreadIndices, _2);
-  using InputDomain = _1;
-
   using Vec3F = vtkm::Vec3f;
 
   Vec3F Center;
@@ -46,34 +44,8 @@ struct WaveletField : public vtkm::worklet::WorkletVisitPointsWithCells
   vtkm::FloatDefault MaximumValue;
   vtkm::FloatDefault Temp2;
 
-  WaveletField(const Vec3F& center,
-               const Vec3F& spacing,
-               const Vec3F& frequency,
-               const Vec3F& magnitude,
-               const Vec3F& minimumPoint,
-               const Vec3F& scale,
-               const vtkm::Id3& offset,
-               const vtkm::Id3& dims,
-               vtkm::FloatDefault maximumValue,
-               vtkm::FloatDefault temp2)
-    : Center(center)
-    , Spacing(spacing)
-    , Frequency(frequency)
-    , Magnitude(magnitude)
-    , MinimumPoint(minimumPoint)
-    , Scale(scale)
-    , Offset(offset)
-    , Dims(dims)
-    , MaximumValue(maximumValue)
-    , Temp2(temp2)
+  VTKM_EXEC_CONT vtkm::FloatDefault Evaluate(const vtkm::Id3& ijk) const
   {
-  }
-
-  template <typename ThreadIndexType>
-  VTKM_EXEC void operator()(const ThreadIndexType& threadIndex, vtkm::FloatDefault& scalar) const
-  {
-    const vtkm::Id3 ijk = threadIndex.GetInputIndex3D();
-
     // map ijk to the point location, accounting for spacing:
     const Vec3F loc = Vec3F(ijk + this->Offset) * this->Spacing;
 
@@ -90,8 +62,36 @@ struct WaveletField : public vtkm::worklet::WorkletVisitPointsWithCells
     // The vtkRTAnalyticSource documentation says the periodic contributions
     // should be multiplied in, but the implementation adds them. We'll do as
     // they do, not as they say.
-    scalar =
-      this->MaximumValue * vtkm::Exp(-gaussSum * this->Temp2) + vtkm::ReduceSum(periodicContribs);
+    return this->MaximumValue * vtkm::Exp(-gaussSum * this->Temp2) +
+      vtkm::ReduceSum(periodicContribs);
+  }
+
+  VTKM_EXEC_CONT vtkm::FloatDefault operator()(vtkm::Id index) const
+  {
+    const vtkm::Id3 ijk{ index % this->Dims[0],
+                         (index / this->Dims[0]) % this->Dims[1],
+                         index / (this->Dims[0] * this->Dims[1]) };
+    return this->Evaluate(ijk);
+  }
+};
+
+struct WaveletField : public vtkm::worklet::WorkletVisitPointsWithCells
+{
+  using ControlSignature = void(CellSetIn, FieldOut v);
+  using ExecutionSignature = void(ThreadIndices, _2);
+  using InputDomain = _1;
+
+  WaveletFunctor Functor;
+
+  WaveletField(const WaveletFunctor& functor)
+    : Functor(functor)
+  {
+  }
+
+  template <typename ThreadIndexType>
+  VTKM_EXEC void operator()(const ThreadIndexType& threadIndex, vtkm::FloatDefault& scalar) const
+  {
+    scalar = this->Functor.Evaluate(threadIndex.GetInputIndex3D());
   }
 };
 } // namespace wavelet
@@ -156,18 +156,24 @@ vtkm::cont::Field Wavelet::GeneratePointField(const vtkm::cont::CellSetStructure
                      computeScaleFactor(this->MinimumExtent[1], this->MaximumExtent[1]),
                      computeScaleFactor(this->MinimumExtent[2], this->MaximumExtent[2]) };
 
+  wavelet::WaveletFunctor functor{ this->Center,
+                                   this->Spacing,
+                                   this->Frequency,
+                                   this->Magnitude,
+                                   minPt,
+                                   scale,
+                                   this->MinimumExtent,
+                                   dims,
+                                   this->MaximumValue,
+                                   temp2 };
+  if (this->UseImplicitFields)
+  {
+    return vtkm::cont::make_FieldPoint(
+      name, vtkm::cont::make_ArrayHandleImplicit(functor, cellset.GetNumberOfPoints()));
+  }
+
   vtkm::cont::ArrayHandle<vtkm::FloatDefault> output;
-  wavelet::WaveletField worklet{ this->Center,
-                                 this->Spacing,
-                                 this->Frequency,
-                                 this->Magnitude,
-                                 minPt,
-                                 scale,
-                                 this->MinimumExtent,
-                                 dims,
-                                 this->MaximumValue,
-                                 temp2 };
-  this->Invoke(worklet, cellset, output);
+  this->Invoke(wavelet::WaveletField{ functor }, cellset, output);
   return vtkm::cont::make_FieldPoint(name, output);
 }
 
@@ -57,6 +57,9 @@ namespace source
  * - `Magnitude`: { 10, 18, 5 }
  *
  *  If the extent has zero length in the z-direction, a 2D dataset is generated.
+ *
+ *  If `UseImplicitFields` is on, `RTData` is computed each time a value is read
+ *  instead of being stored.
  */
 class VTKM_SOURCE_EXPORT Wavelet final : public vtkm::source::Source
 {
@@ -125,6 +128,18 @@ public:
   }
   VTKM_CONT vtkm::FloatDefault GetStandardDeviation() const { return this->StandardDeviation; }
 
+  ///@{
+  /// \brief Specifies whether the point field is computed on demand.
+  ///
+  /// When on, `RTData` is an `ArrayHandleImplicit` that evaluates the wavelet
+  /// function whenever a value is read, so no memory is allocated for the
+  /// field. Most filters copy a field with this storage into a basic array
+  /// before using it, so the memory is only saved up to the first such filter.
+  /// The default is off.
+  VTKM_CONT void SetUseImplicitFields(bool flag) { this->UseImplicitFields = flag; }
+  VTKM_CONT bool GetUseImplicitFields() const { return this->UseImplicitFields; }
+  ///@}
+
 private:
   vtkm::cont::DataSet DoExecute() const override;
 
@@ -144,6 +159,7 @@ private:
   vtkm::Id3 MaximumExtent = { 10, 10, 10 };
   vtkm::FloatDefault MaximumValue = 255.0f;
   vtkm::FloatDefault StandardDeviation = 0.5f;
+  bool UseImplicitFields = false;
 };
 } //namespace source
 } //namespace vtkm
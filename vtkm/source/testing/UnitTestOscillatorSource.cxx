@@ -59,6 +59,17 @@ void OscillatorSourceTest()
     VTKM_TEST_ASSERT(test_equal(data.Get(21), -0.0181952), "Incorrect scalar value.");
     VTKM_TEST_ASSERT(test_equal(data.Get(3110), -0.0404135), "Incorrect scalar value.");
   }
+
+  // The implicit field holds no values but reads the same as the stored field.
+  {
+    source.SetUseImplicitFields(true);
+    vtkm::cont::DataSet implicitDs = source.Execute();
+    auto implicitData = implicitDs.GetPointField("oscillating").GetData();
+    VTKM_TEST_ASSERT(!implicitData.IsStorageType<vtkm::cont::StorageTagBasic>(),
+                     "Field should not be stored in a basic array.");
+    VTKM_TEST_ASSERT(
+      test_equal_ArrayHandles(implicitData, ds.GetPointField("oscillating").GetData()));
+  }
 }
 
 int UnitTestOscillatorSource(int argc, char* argv[])
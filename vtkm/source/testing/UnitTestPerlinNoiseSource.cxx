@@ -0,0 +1,71 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#include <vtkm/source/PerlinNoise.h>
+
+#include <vtkm/cont/ArrayCopy.h>
+#include <vtkm/cont/testing/Testing.h>
+
+void PerlinNoiseSourceTest()
+{
+  vtkm::source::PerlinNoise source;
+  source.SetCellDimensions({ 20, 20, 20 });
+  source.SetOrigin({ 0.5f, -1.0f, 2.0f });
+  source.SetSeed(77698);
+  vtkm::cont::DataSet ds = source.Execute();
+
+  {
+    auto coords = ds.GetCoordinateSystem("coordinates");
+    auto data = coords.GetData();
+    VTKM_TEST_ASSERT(test_equal(data.GetNumberOfValues(), 9261), "Incorrect number of points.");
+  }
+
+  {
+    auto cells = ds.GetCellSet();
+    VTKM_TEST_ASSERT(test_equal(cells.GetNumberOfCells(), 8000), "Incorrect number of cells.");
+  }
+
+  using ScalarHandleType = vtkm::cont::ArrayHandle<vtkm::FloatDefault>;
+  auto storedData = ds.GetPointField("perlinnoise").GetData();
+  VTKM_TEST_ASSERT(storedData.IsType<ScalarHandleType>(), "Invalid scalar handle type.");
+  VTKM_TEST_ASSERT(test_equal(storedData.GetNumberOfValues(), 9261),
+                   "Incorrect number of scalars.");
+
+  // The implicit field holds no values but reads the same as the stored field.
+  {
+    source.SetUseImplicitFields(true);
+    vtkm::cont::DataSet implicitDs = source.Execute();
+    auto implicitData = implicitDs.GetPointField("perlinnoise").GetData();
+    VTKM_TEST_ASSERT(!implicitData.IsStorageType<vtkm::cont::StorageTagBasic>(),
+                     "Field should not be stored in a basic array.");
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(implicitData, storedData));
+
+    // Copying the implicit field on the device evaluates the noise there.
+    ScalarHandleType materialized;
+    vtkm::cont::ArrayCopy(implicitData, materialized);
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(materialized, storedData));
+  }
+
+  // A different seed gives a different field, on both paths.
+  {
+    source.SetSeed(4321);
+    auto implicitData = source.Execute().GetPointField("perlinnoise").GetData();
+    source.SetUseImplicitFields(false);
+    auto reseededData = source.Execute().GetPointField("perlinnoise").GetData();
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(implicitData, reseededData));
+    VTKM_TEST_ASSERT(!test_equal_ArrayHandles(reseededData, storedData),
+                     "Seed did not change the field.");
+  }
+}
+
+int UnitTestPerlinNoiseSource(int argc, char* argv[])
+{
+  return vtkm::cont::testing::Testing::Run(PerlinNoiseSourceTest, argc, argv);
+}
@@ -62,6 +62,16 @@ void TangleSourceTest()
     VTKM_TEST_ASSERT(test_equal(data.Get(6599), 7.79722), "Incorrect scalar value.");
     VTKM_TEST_ASSERT(test_equal(data.Get(7999), 7.94986), "Incorrect scalar value.");
   }
+
+  // The implicit field holds no values but reads the same as the stored field.
+  {
+    source.SetUseImplicitFields(true);
+    vtkm::cont::DataSet implicitDs = source.Execute();
+    auto implicitData = implicitDs.GetPointField("tangle").GetData();
+    VTKM_TEST_ASSERT(!implicitData.IsStorageType<vtkm::cont::StorageTagBasic>(),
+                     "Field should not be stored in a basic array.");
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(implicitData, ds.GetPointField("tangle").GetData()));
+  }
 }
 
 int UnitTestTangleSource(int argc, char* argv[])
@@ -52,6 +52,16 @@ void WaveletSourceTest()
     VTKM_TEST_ASSERT(test_equal(data.Get(6599), 120.068), "Incorrect scalar value.");
     VTKM_TEST_ASSERT(test_equal(data.Get(7999), 65.6710), "Incorrect scalar value.");
   }
+
+  // The implicit field holds no values but reads the same as the stored field.
+  {
+    source.SetUseImplicitFields(true);
+    vtkm::cont::DataSet implicitDs = source.Execute();
+    auto implicitData = implicitDs.GetPointField("RTData").GetData();
+    VTKM_TEST_ASSERT(!implicitData.IsStorageType<vtkm::cont::StorageTagBasic>(),
+                     "Field should not be stored in a basic array.");
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(implicitData, ds.GetPointField("RTData").GetData()));
+  }
 }
 
 int UnitTestWaveletSource(int argc, char* argv[])
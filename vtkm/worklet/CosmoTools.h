@@ -56,6 +56,7 @@
 #include <vtkm/cont/Field.h>
 
 #include <vtkm/worklet/cosmotools/CosmoTools.h>
+#include <vtkm/worklet/cosmotools/CosmoToolsBarnesHut.h>
 #include <vtkm/worklet/cosmotools/CosmoToolsCenterFinder.h>
 #include <vtkm/worklet/cosmotools/CosmoToolsHaloFinder.h>
 
@@ -88,6 +89,28 @@ public:
     cosmo.HaloFinder(resultHaloId, resultMBP, resultPot);
   }
 
+  // Run the halo finder and then the MBP center finder with Barnes-Hut potentials
+  // A node of a halo's octree is used as a whole when its size is less than openingAngle
+  // times its distance to the particle, so smaller angles are slower and more accurate
+  template <typename FieldType, typename StorageType>
+  void RunHaloFinder(vtkm::cont::ArrayHandle<FieldType, StorageType>& xLocation,
+                     vtkm::cont::ArrayHandle<FieldType, StorageType>& yLocation,
+                     vtkm::cont::ArrayHandle<FieldType, StorageType>& zLocation,
+                     const vtkm::Id nParticles,
+                     const FieldType particleMass,
+                     const vtkm::Id minHaloSize,
+                     const FieldType linkingLen,
+                     const FieldType openingAngle,
+                     vtkm::cont::ArrayHandle<vtkm::Id>& resultHaloId,
+                     vtkm::cont::ArrayHandle<vtkm::Id>& resultMBP,
+                     vtkm::cont::ArrayHandle<FieldType>& resultPot)
+  {
+    cosmotools::CosmoTools<FieldType, StorageType> cosmo(
+      nParticles, particleMass, minHaloSize, linkingLen, xLocation, yLocation, zLocation);
+
+    cosmo.HaloFinder(resultHaloId, resultMBP, resultPot, openingAngle);
+  }
+
   // Run MBP on a single halo of particles using the N^2 algorithm
   template <typename FieldType, typename StorageType>
   void RunMBPCenterFinderNxN(vtkm::cont::ArrayHandle<FieldType, StorageType> xLocation,
@@ -129,6 +152,29 @@ public:
     mxnResult.first = mxnMBP;
     mxnResult.second = mxnPotential;
   }
+
+  // Run MBP on a single halo of particles using the Barnes-Hut octree algorithm
+  // An opening angle of 0.5 typically gives potentials within a fraction of a percent
+  template <typename FieldType, typename StorageType>
+  void RunMBPCenterFinderBarnesHut(vtkm::cont::ArrayHandle<FieldType, StorageType> xLocation,
+                                   vtkm::cont::ArrayHandle<FieldType, StorageType> yLocation,
+                                   vtkm::cont::ArrayHandle<FieldType, StorageType> zLocation,
+                                   const vtkm::Id nParticles,
+                                   const FieldType particleMass,
+                                   const FieldType openingAngle,
+                                   vtkm::Pair<vtkm::Id, FieldType>& bhResult)
+  {
+    // Constructor gets particle locations and particle mass
+    cosmotools::CosmoTools<FieldType, StorageType> cosmo(
+      nParticles, particleMass, xLocation, yLocation, zLocation);
+
+    // Most Bound Particle with potentials approximated by an octree
+    FieldType bhPotential;
+    vtkm::Id bhMBP = cosmo.MBPCenterFinderBarnesHut(openingAngle, &bhPotential);
+
+    bhResult.first = bhMBP;
+    bhResult.second = bhPotential;
+  }
 };
 }
 } // namespace vtkm::worklet
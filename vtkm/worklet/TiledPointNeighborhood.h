@@ -0,0 +1,339 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_TiledPointNeighborhood_h
+#define vtk_m_worklet_TiledPointNeighborhood_h
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/CellSetStructured.h>
+#include <vtkm/cont/ErrorBadType.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/cont/UnknownCellSet.h>
+
+#include <vtkm/exec/BoundaryState.h>
+#include <vtkm/exec/FieldNeighborhood.h>
+
+#include <vtkm/internal/FunctionInterface.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+#include <vtkm/worklet/WorkletPointNeighborhood.h>
+
+#include <type_traits>
+
+namespace vtkm
+{
+namespace worklet
+{
+
+namespace detail
+{
+
+// Provides the argument of the neighborhood worklet for one tag of its ExecutionSignature.
+template <typename ControlSignature, typename ExecutionTag, typename Enable = void>
+struct TiledNeighborhoodArgument;
+
+template <typename ControlSignature, typename ExecutionTag>
+struct TiledNeighborhoodArgument<
+  ControlSignature,
+  ExecutionTag,
+  typename std::enable_if<std::is_base_of<vtkm::exec::arg::Boundary, ExecutionTag>::value>::type>
+{
+  template <typename NeighborhoodType, typename OutType>
+  VTKM_EXEC static const vtkm::exec::BoundaryState& Get(const NeighborhoodType&,
+                                                        const vtkm::exec::BoundaryState& boundary,
+                                                        OutType&)
+  {
+    return boundary;
+  }
+};
+
+template <typename ControlSignature, int Index>
+struct TiledNeighborhoodArgument<ControlSignature, vtkm::placeholders::Arg<Index>>
+{
+  using ControlTag = typename vtkm::internal::FunctionInterface<
+    ControlSignature>::template ParameterType<Index>::type;
+  static constexpr bool IsNeighborhood =
+    std::is_base_of<vtkm::worklet::WorkletNeighborhood::FieldInNeighborhood, ControlTag>::value;
+  static constexpr bool IsOutput =
+    std::is_base_of<vtkm::worklet::WorkletNeighborhood::FieldOut, ControlTag>::value;
+  VTKM_STATIC_ASSERT_MSG(IsNeighborhood || IsOutput,
+                         "Tiled execution only supports FieldInNeighborhood and FieldOut.");
+
+  template <typename NeighborhoodType, typename OutType>
+  VTKM_EXEC static const NeighborhoodType& Get(const NeighborhoodType& neighborhood,
+                                               const vtkm::exec::BoundaryState&,
+                                               OutType&,
+                                               std::true_type)
+  {
+    return neighborhood;
+  }
+
+  template <typename NeighborhoodType, typename OutType>
+  VTKM_EXEC static OutType& Get(const NeighborhoodType&,
+                                const vtkm::exec::BoundaryState&,
+                                OutType& out,
+                                std::false_type)
+  {
+    return out;
+  }
+
+  template <typename NeighborhoodType, typename OutType>
+  VTKM_EXEC static auto Get(const NeighborhoodType& neighborhood,
+                            const vtkm::exec::BoundaryState& boundary,
+                            OutType& out)
+    -> decltype(Get(neighborhood, boundary, out, std::integral_constant<bool, IsNeighborhood>{}))
+  {
+    return Get(neighborhood, boundary, out, std::integral_constant<bool, IsNeighborhood>{});
+  }
+};
+
+// Calls the neighborhood worklet as its ExecutionSignature describes.
+template <typename ControlSignature, typename ExecutionSignature>
+struct TiledNeighborhoodCall;
+
+template <typename ControlSignature, typename... ExecutionTags>
+struct TiledNeighborhoodCall<ControlSignature, void(ExecutionTags...)>
+{
+  template <typename WorkletType, typename NeighborhoodType, typename OutType>
+  VTKM_EXEC static void Call(const WorkletType& worklet,
+                             const NeighborhoodType& neighborhood,
+                             const vtkm::exec::BoundaryState& boundary,
+                             OutType& out)
+  {
+    worklet(TiledNeighborhoodArgument<ControlSignature, ExecutionTags>::Get(
+      neighborhood, boundary, out)...);
+  }
+};
+
+template <typename ControlSignature, int ReturnIndex, typename... ExecutionTags>
+struct TiledNeighborhoodCall<ControlSignature,
+                             vtkm::placeholders::Arg<ReturnIndex>(ExecutionTags...)>
+{
+  template <typename WorkletType, typename NeighborhoodType, typename OutType>
+  VTKM_EXEC static void Call(const WorkletType& worklet,
+                             const NeighborhoodType& neighborhood,
+                             const vtkm::exec::BoundaryState& boundary,
+                             OutType& out)
+  {
+    out = worklet(TiledNeighborhoodArgument<ControlSignature, ExecutionTags>::Get(
+      neighborhood, boundary, out)...);
+  }
+};
+
+} // namespace detail
+
+/// \brief Runs a point neighborhood worklet one tile of points at a time.
+///
+/// `WorkletPointNeighborhood` fetches every neighbor from the field array and clamps its
+/// index to the boundary, so a stencil of radius r reads each value (2r+1)^d times. This
+/// worklet instead copies a box of points plus a halo of `radius` points into a
+/// contiguous scratch buffer, clamping to the boundary once while the box is filled. It
+/// then calls the wrapped worklet for each point of the box with a `FieldNeighborhood`
+/// that reads the scratch buffer without any bounds checking.
+///
+/// The wrapped worklet must take a `FieldInNeighborhood` and a `FieldOut` and may ask for
+/// the `Boundary` in its `ExecutionSignature`. Its neighborhood accesses must stay within
+/// `radius` of the visited point. The scratch buffer lives on the stack of each invocation,
+/// which suits CPU devices. Use `InvokeTiledPointNeighborhood` to run it.
+template <typename NeighborhoodWorkletType>
+class TiledPointNeighborhood : public vtkm::worklet::WorkletMapField
+{
+public:
+  static constexpr vtkm::IdComponent MaxRadius = 7;
+  /// Number of values in the scratch buffer, which holds a tile and its halo.
+  static constexpr vtkm::IdComponent ScratchSize = 4096;
+
+  using ControlSignature = void(FieldIn tileIndex, WholeArrayIn input, WholeArrayOut output);
+  using ExecutionSignature = void(_1, _2, _3);
+
+  VTKM_CONT TiledPointNeighborhood(const NeighborhoodWorkletType& worklet,
+                                   vtkm::IdComponent radius,
+                                   const vtkm::Id3& pointDimensions)
+    : Worklet(worklet)
+    , PointDimensions(pointDimensions)
+  {
+    if (radius < 0 || radius > MaxRadius)
+    {
+      throw vtkm::cont::ErrorBadValue("Tiled neighborhood radius must be between 0 and " +
+                                      std::to_string(MaxRadius) + ".");
+    }
+    for (vtkm::IdComponent axis = 0; axis < 3; ++axis)
+    {
+      this->Halo[axis] = pointDimensions[axis] > 1 ? radius : 0;
+    }
+
+    // Keep the tiles short along z and y and as long as the scratch buffer allows along x,
+    // so the copies into the scratch buffer read long contiguous runs.
+    constexpr vtkm::Id cubeEdge = 16;
+    for (vtkm::IdComponent axis = 2; axis > 0; --axis)
+    {
+      this->TileSize[axis] =
+        vtkm::Max(vtkm::Id{ 1 },
+                  vtkm::Min(pointDimensions[axis], cubeEdge - 2 * this->Halo[axis]));
+    }
+    const vtkm::Id planeSize =
+      (this->TileSize[1] + 2 * this->Halo[1]) * (this->TileSize[2] + 2 * this->Halo[2]);
+    this->TileSize[0] = vtkm::Max(
+      vtkm::Id{ 1 },
+      vtkm::Min(pointDimensions[0], ScratchSize / planeSize - 2 * this->Halo[0]));
+
+    for (vtkm::IdComponent axis = 0; axis < 3; ++axis)
+    {
+      this->NumberOfTiles[axis] =
+        (pointDimensions[axis] + this->TileSize[axis] - 1) / this->TileSize[axis];
+    }
+  }
+
+  VTKM_CONT vtkm::Id GetNumberOfTiles() const
+  {
+    return this->NumberOfTiles[0] * this->NumberOfTiles[1] * this->NumberOfTiles[2];
+  }
+
+  /// Also lets the wrapped worklet raise errors.
+  VTKM_CONT void SetErrorMessageBuffer(const vtkm::exec::internal::ErrorMessageBuffer& buffer)
+  {
+    this->WorkletMapField::SetErrorMessageBuffer(buffer);
+    this->Worklet.SetErrorMessageBuffer(buffer);
+  }
+
+  template <typename InPortalType, typename OutPortalType>
+  VTKM_EXEC void operator()(vtkm::Id tileIndex,
+                            const InPortalType& input,
+                            const OutPortalType& output) const
+  {
+    using T = typename InPortalType::ValueType;
+    using OutType = typename OutPortalType::ValueType;
+    using Call =
+      detail::TiledNeighborhoodCall<typename NeighborhoodWorkletType::ControlSignature,
+                                    typename NeighborhoodWorkletType::ExecutionSignature>;
+
+    const vtkm::Id3 tile(tileIndex % this->NumberOfTiles[0],
+                         (tileIndex / this->NumberOfTiles[0]) % this->NumberOfTiles[1],
+                         tileIndex / (this->NumberOfTiles[0] * this->NumberOfTiles[1]));
+    vtkm::Id3 origin;
+    vtkm::Id3 size;
+    vtkm::Id3 scratchSize;
+    for (vtkm::IdComponent axis = 0; axis < 3; ++axis)
+    {
+      origin[axis] = tile[axis] * this->TileSize[axis];
+      size[axis] = vtkm::Min(this->TileSize[axis], this->PointDimensions[axis] - origin[axis]);
+      scratchSize[axis] = size[axis] + 2 * this->Halo[axis];
+    }
+
+    // Copy the tile and its halo, clamping the halo to the boundary.
+    vtkm::Vec<T, ScratchSize> scratch;
+    vtkm::IdComponent scratchIndex = 0;
+    for (vtkm::Id k = 0; k < scratchSize[2]; ++k)
+    {
+      const vtkm::Id z = this->Clamp(origin[2] + k - this->Halo[2], 2);
+      for (vtkm::Id j = 0; j < scratchSize[1]; ++j)
+      {
+        const vtkm::Id y = this->Clamp(origin[1] + j - this->Halo[1], 1);
+        const vtkm::Id rowStart = this->PointDimensions[0] * (y + this->PointDimensions[1] * z);
+        for (vtkm::Id i = 0; i < scratchSize[0]; ++i)
+        {
+          scratch[scratchIndex++] =
+            input.Get(rowStart + this->Clamp(origin[0] + i - this->Halo[0], 0));
+        }
+      }
+    }
+
+    vtkm::exec::internal::NeighborhoodTile<T> neighborhoodTile;
+    neighborhoodTile.Strides = vtkm::Id3(this->PointDimensions[0] > 1 ? 1 : 0,
+                                         this->PointDimensions[1] > 1 ? scratchSize[0] : 0,
+                                         this->PointDimensions[2] > 1
+                                           ? scratchSize[0] * scratchSize[1]
+                                           : 0);
+    for (vtkm::Id k = 0; k < size[2]; ++k)
+    {
+      for (vtkm::Id j = 0; j < size[1]; ++j)
+      {
+        const vtkm::Id scratchRow = (j + this->Halo[1]) * scratchSize[0] +
+          (k + this->Halo[2]) * scratchSize[0] * scratchSize[1] + this->Halo[0];
+        const vtkm::Id3 rowStart(origin[0], origin[1] + j, origin[2] + k);
+        const vtkm::Id outRow = rowStart[0] +
+          this->PointDimensions[0] * (rowStart[1] + this->PointDimensions[1] * rowStart[2]);
+        for (vtkm::Id i = 0; i < size[0]; ++i)
+        {
+          const vtkm::exec::BoundaryState boundary(
+            vtkm::Id3(rowStart[0] + i, rowStart[1], rowStart[2]), this->PointDimensions);
+          neighborhoodTile.Center = &scratch[static_cast<vtkm::IdComponent>(scratchRow + i)];
+          const vtkm::exec::FieldNeighborhood<vtkm::exec::internal::NeighborhoodTile<T>>
+            neighborhood(neighborhoodTile, boundary);
+          OutType value;
+          Call::Call(this->Worklet, neighborhood, boundary, value);
+          output.Set(outRow + i, value);
+        }
+      }
+    }
+  }
+
+private:
+  VTKM_EXEC vtkm::Id Clamp(vtkm::Id index, vtkm::IdComponent axis) const
+  {
+    return vtkm::Max(vtkm::Id{ 0 }, vtkm::Min(this->PointDimensions[axis] - 1, index));
+  }
+
+  NeighborhoodWorkletType Worklet;
+  vtkm::Id3 PointDimensions;
+  vtkm::IdComponent3 Halo;
+  vtkm::Id3 TileSize;
+  vtkm::Id3 NumberOfTiles;
+};
+
+/// \brief Invokes a point neighborhood worklet over a structured cell set in tiles.
+///
+/// This produces the same result as invoking `worklet` with `cellSet`, `input` and
+/// `output`, but runs it through `TiledPointNeighborhood`. `radius` is the largest
+/// neighbor offset that the worklet accesses.
+template <typename NeighborhoodWorkletType,
+          typename InValueType,
+          typename InStorageType,
+          typename OutValueType>
+VTKM_CONT void InvokeTiledPointNeighborhood(
+  const vtkm::cont::Invoker& invoke,
+  const NeighborhoodWorkletType& worklet,
+  vtkm::IdComponent radius,
+  const vtkm::cont::UnknownCellSet& cellSet,
+  const vtkm::cont::ArrayHandle<InValueType, InStorageType>& input,
+  vtkm::cont::ArrayHandle<OutValueType>& output)
+{
+  vtkm::Id3 pointDimensions;
+  if (cellSet.IsType<vtkm::cont::CellSetStructured<3>>())
+  {
+    pointDimensions = cellSet.AsCellSet<vtkm::cont::CellSetStructured<3>>().GetPointDimensions();
+  }
+  else if (cellSet.IsType<vtkm::cont::CellSetStructured<2>>())
+  {
+    vtkm::Id2 dims = cellSet.AsCellSet<vtkm::cont::CellSetStructured<2>>().GetPointDimensions();
+    pointDimensions = vtkm::Id3(dims[0], dims[1], 1);
+  }
+  else if (cellSet.IsType<vtkm::cont::CellSetStructured<1>>())
+  {
+    vtkm::Id dims = cellSet.AsCellSet<vtkm::cont::CellSetStructured<1>>().GetPointDimensions();
+    pointDimensions = vtkm::Id3(dims, 1, 1);
+  }
+  else
+  {
+    throw vtkm::cont::ErrorBadType(
+      "Tiled neighborhood execution requires a structured cell set.");
+  }
+
+  TiledPointNeighborhood<NeighborhoodWorkletType> tiled(worklet, radius, pointDimensions);
+  output.Allocate(input.GetNumberOfValues());
+  invoke(tiled, vtkm::cont::ArrayHandleIndex(tiled.GetNumberOfTiles()), input, output);
+}
+
+}
+} // namespace vtkm::worklet
+
+#endif // vtk_m_worklet_TiledPointNeighborhood_h
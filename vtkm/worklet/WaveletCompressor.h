@@ -421,19 +421,8 @@ public:
     if (ratio > 1.0)
     {
       vtkm::Id coeffLen = coeffIn.GetNumberOfValues();
-      using ValueType = typename CoeffArrayType::ValueType;
-      using CoeffArrayBasic = vtkm::cont::ArrayHandle<ValueType>;
-      CoeffArrayBasic sortedArray;
-      vtkm::cont::ArrayCopy(coeffIn, sortedArray);
-
-      WaveletBase::DeviceSort(sortedArray);
-
       vtkm::Id n = coeffLen - static_cast<vtkm::Id>(static_cast<vtkm::Float64>(coeffLen) / ratio);
-      vtkm::Float64 nthVal = static_cast<vtkm::Float64>(vtkm::cont::ArrayGetValue(n, sortedArray));
-      if (nthVal < 0.0)
-      {
-        nthVal *= -1.0;
-      }
+      vtkm::Float64 nthVal = WaveletBase::DeviceSelectAbs(coeffIn, n);
 
       using ThresholdType = vtkm::worklet::wavelets::ThresholdWorklet;
       ThresholdType thresholdWorklet(nthVal);
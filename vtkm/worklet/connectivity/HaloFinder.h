@@ -0,0 +1,291 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_connectivity_HaloFinder_h
+#define vtk_m_worklet_connectivity_HaloFinder_h
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayCopyDevice.h>
+#include <vtkm/cont/ArrayGetValues.h>
+#include <vtkm/cont/ArrayHandleConstant.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+#include <vtkm/cont/Invoker.h>
+#include <vtkm/worklet/connectivity/UnionFind.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace connectivity
+{
+namespace detail
+{
+// Find the bin of the grid of linking length sized bins each particle is in.
+class HaloFinderComputeBin : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn point, FieldOut binId);
+  using ExecutionSignature = void(_1, _2);
+
+  VTKM_CONT HaloFinderComputeBin(const vtkm::Vec3f_64& origin,
+                                 const vtkm::Vec3f_64& binSize,
+                                 const vtkm::Id3& dims)
+    : Origin(origin)
+    , InverseBinSize(1.0 / binSize[0], 1.0 / binSize[1], 1.0 / binSize[2])
+    , Dims(dims)
+  {
+  }
+
+  template <typename PointType>
+  VTKM_EXEC void operator()(const PointType& point, vtkm::Id& binId) const
+  {
+    vtkm::Id3 ijk;
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      const vtkm::Float64 x = (static_cast<vtkm::Float64>(point[d]) - this->Origin[d]) *
+        this->InverseBinSize[d];
+      ijk[d] = vtkm::Min(vtkm::Max(static_cast<vtkm::Id>(x), vtkm::Id(0)), this->Dims[d] - 1);
+    }
+    binId = ijk[0] + this->Dims[0] * (ijk[1] + this->Dims[1] * ijk[2]);
+  }
+
+private:
+  vtkm::Vec3f_64 Origin;
+  vtkm::Vec3f_64 InverseBinSize;
+  vtkm::Id3 Dims;
+};
+
+// Link each particle to the particles after it in bin order that are within the linking
+// length. The bins are at least one linking length wide, so the candidates are in the 27
+// bins around the particle's bin. Because the particles are sorted by bin, the 3 bins of a
+// row along x are one contiguous range of particles, so each particle searches 9 ranges.
+// Each pair of particles is tested once, by the particle that comes first in bin order.
+class HaloFinderLink : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn binId,
+                                FieldIn point,
+                                FieldIn partId,
+                                WholeArrayIn sortedBinIds,
+                                WholeArrayIn sortedPoints,
+                                WholeArrayIn sortedPartIds,
+                                AtomicArrayInOut parents);
+  using ExecutionSignature = void(WorkIndex, _1, _2, _3, _4, _5, _6, _7);
+
+  VTKM_CONT HaloFinderLink(const vtkm::Id3& dims, vtkm::Float64 linkingLength)
+    : Dims(dims)
+    , LinkingLength2(linkingLength * linkingLength)
+  {
+  }
+
+  template <typename PointType,
+            typename BinPortalType,
+            typename PointPortalType,
+            typename IdPortalType,
+            typename ParentsType>
+  VTKM_EXEC void operator()(vtkm::Id index,
+                            vtkm::Id binId,
+                            const PointType& point,
+                            vtkm::Id partId,
+                            const BinPortalType& sortedBinIds,
+                            const PointPortalType& sortedPoints,
+                            const IdPortalType& sortedPartIds,
+                            ParentsType& parents) const
+  {
+    const vtkm::Id xBin = binId % this->Dims[0];
+    const vtkm::Id yBin = (binId / this->Dims[0]) % this->Dims[1];
+    const vtkm::Id zBin = binId / (this->Dims[0] * this->Dims[1]);
+    const vtkm::Id xFirst = vtkm::Max(xBin - 1, vtkm::Id(0));
+    const vtkm::Id xLast = vtkm::Min(xBin + 1, this->Dims[0] - 1);
+
+    for (vtkm::Id z = vtkm::Max(zBin - 1, vtkm::Id(0));
+         z <= vtkm::Min(zBin + 1, this->Dims[2] - 1);
+         ++z)
+    {
+      for (vtkm::Id y = vtkm::Max(yBin - 1, vtkm::Id(0));
+           y <= vtkm::Min(yBin + 1, this->Dims[1] - 1);
+           ++y)
+      {
+        const vtkm::Id rowBin = this->Dims[0] * (y + this->Dims[1] * z);
+        const vtkm::Id rowEnd = UpperBound(sortedBinIds, xLast + rowBin);
+        if (rowEnd <= index + 1)
+        {
+          continue;
+        }
+        const vtkm::Id rowBegin =
+          vtkm::Max(LowerBound(sortedBinIds, xFirst + rowBin, rowEnd), index + 1);
+
+        for (vtkm::Id j = rowBegin; j < rowEnd; ++j)
+        {
+          const auto other = sortedPoints.Get(j);
+          vtkm::Float64 dist2 = 0;
+          for (vtkm::IdComponent d = 0; d < 3; ++d)
+          {
+            const vtkm::Float64 delta =
+              static_cast<vtkm::Float64>(point[d]) - static_cast<vtkm::Float64>(other[d]);
+            dist2 += delta * delta;
+          }
+          if (dist2 <= this->LinkingLength2)
+          {
+            UnionFind::Unite(parents, partId, sortedPartIds.Get(j));
+          }
+        }
+      }
+    }
+  }
+
+private:
+  template <typename PortalType>
+  VTKM_EXEC static vtkm::Id LowerBound(const PortalType& portal, vtkm::Id value, vtkm::Id end)
+  {
+    vtkm::Id begin = 0;
+    while (begin < end)
+    {
+      const vtkm::Id mid = begin + (end - begin) / 2;
+      if (portal.Get(mid) < value)
+      {
+        begin = mid + 1;
+      }
+      else
+      {
+        end = mid;
+      }
+    }
+    return begin;
+  }
+
+  template <typename PortalType>
+  VTKM_EXEC static vtkm::Id UpperBound(const PortalType& portal, vtkm::Id value)
+  {
+    vtkm::Id begin = 0;
+    vtkm::Id end = portal.GetNumberOfValues();
+    while (begin < end)
+    {
+      const vtkm::Id mid = begin + (end - begin) / 2;
+      if (portal.Get(mid) <= value)
+      {
+        begin = mid + 1;
+      }
+      else
+      {
+        end = mid;
+      }
+    }
+    return begin;
+  }
+
+  vtkm::Id3 Dims;
+  vtkm::Float64 LinkingLength2;
+};
+
+class HaloFinderCountSize : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn haloId, AtomicArrayInOut haloSize);
+  using ExecutionSignature = void(_1, _2);
+
+  template <typename AtomicSizeType>
+  VTKM_EXEC void operator()(vtkm::Id haloId, AtomicSizeType& haloSize) const
+  {
+    haloSize.Add(haloId, 1);
+  }
+};
+} // namespace detail
+
+/// Friends-of-friends halo finder. Two particles are friends when they are closer than the
+/// linking length, and a halo is a set of particles connected through friends. Each particle
+/// gets the id of its halo, which is the smallest index of the particles in the halo.
+///
+/// The particles are sorted into a grid of bins the size of the linking length. One pass
+/// over the particles unites each pair of friends with the lock-free `UnionFind`, and one
+/// pointer jumping pass flattens the trees, so the number of passes does not depend on the
+/// shape of the halos.
+class HaloFinder
+{
+public:
+  template <typename PointArrayType>
+  static void Run(const PointArrayType& points,
+                  vtkm::Float64 linkingLength,
+                  vtkm::cont::ArrayHandle<vtkm::Id>& haloIds)
+  {
+    VTKM_IS_ARRAY_HANDLE(PointArrayType);
+    using PointType = typename PointArrayType::ValueType;
+    using Algorithm = vtkm::cont::Algorithm;
+
+    const vtkm::Id numPoints = points.GetNumberOfValues();
+    Algorithm::Copy(vtkm::cont::ArrayHandleIndex(numPoints), haloIds);
+    if (numPoints == 0)
+    {
+      return;
+    }
+
+    const PointType first = vtkm::cont::ArrayGetValue(0, points);
+    const vtkm::Vec<PointType, 2> range = Algorithm::Reduce(
+      points, vtkm::Vec<PointType, 2>(first, first), vtkm::MinAndMax<PointType>());
+
+    // The bins are at least one linking length wide. Limit the number of bins along each
+    // axis so that a bin id always fits in a vtkm::Id.
+    constexpr vtkm::Id maxBins = 1048576;
+    vtkm::Vec3f_64 origin;
+    vtkm::Vec3f_64 binSize;
+    vtkm::Id3 dims;
+    for (vtkm::IdComponent d = 0; d < 3; ++d)
+    {
+      origin[d] = static_cast<vtkm::Float64>(range[0][d]);
+      const vtkm::Float64 extent = static_cast<vtkm::Float64>(range[1][d]) - origin[d];
+      dims[d] = linkingLength > 0
+        ? vtkm::Min(static_cast<vtkm::Id>(vtkm::Floor(extent / linkingLength)), maxBins)
+        : vtkm::Id(1);
+      dims[d] = vtkm::Max(dims[d], vtkm::Id(1));
+      binSize[d] = extent > 0 ? extent / static_cast<vtkm::Float64>(dims[d]) : 1.0;
+    }
+
+    vtkm::cont::Invoker invoke;
+
+    vtkm::cont::ArrayHandle<vtkm::Id> binIds;
+    invoke(detail::HaloFinderComputeBin(origin, binSize, dims), points, binIds);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> partIds;
+    Algorithm::Copy(vtkm::cont::ArrayHandleIndex(numPoints), partIds);
+    Algorithm::SortByKey(binIds, partIds);
+
+    // Gather the points in bin order so that neighboring particles are close in memory.
+    vtkm::cont::ArrayHandle<PointType> sortedPoints;
+    vtkm::cont::ArrayCopyDevice(vtkm::cont::make_ArrayHandlePermutation(partIds, points),
+                                sortedPoints);
+
+    invoke(detail::HaloFinderLink(dims, linkingLength),
+           binIds,
+           sortedPoints,
+           partIds,
+           binIds,
+           sortedPoints,
+           partIds,
+           haloIds);
+    invoke(PointerJumping{}, haloIds);
+  }
+
+  /// Count the particles in each halo. `haloSizes` is indexed by halo id, which is the
+  /// index of the first particle of the halo.
+  static void CountHaloSizes(const vtkm::cont::ArrayHandle<vtkm::Id>& haloIds,
+                             vtkm::cont::ArrayHandle<vtkm::Id>& haloSizes)
+  {
+    vtkm::cont::Algorithm::Copy(
+      vtkm::cont::ArrayHandleConstant<vtkm::Id>(0, haloIds.GetNumberOfValues()), haloSizes);
+    vtkm::cont::Invoker invoke;
+    invoke(detail::HaloFinderCountSize{}, haloIds, haloSizes);
+  }
+};
+} // namespace connectivity
+} // namespace worklet
+} // namespace vtkm
+
+#endif //vtk_m_worklet_connectivity_HaloFinder_h
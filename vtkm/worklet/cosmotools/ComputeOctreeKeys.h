@@ -0,0 +1,94 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtkm_worklet_cosmotools_compute_octree_keys_h
+#define vtkm_worklet_cosmotools_compute_octree_keys_h
+
+#include <vtkm/worklet/WorkletMapField.h>
+#include <vtkm/worklet/cosmotools/ComputeBinIndices.h>
+#include <vtkm/worklet/cosmotools/ComputeBins.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace cosmotools
+{
+
+// Worklet for computing the octree key of every particle in a group of particles
+// The key is the rank of the group followed by the Morton code of the particle's bin on
+// the finest level, so that sorting by key puts every octree node's particles together
+template <typename T>
+class ComputeOctreeKeys : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn location,        // (input) particle location
+                                FieldIn groupRank,       // (input) rank of particle's group
+                                WholeArrayIn groupMin,   // (input) lower corner of each group
+                                WholeArrayIn groupSize,  // (input) cube side of each group
+                                FieldOut key);           // (output) octree key
+  using ExecutionSignature = _5(_1, _2, _3, _4);
+  using InputDomain = _1;
+
+  vtkm::IdComponent numLevels; // Number of levels below the root of the octree
+
+  // Constructor
+  VTKM_EXEC_CONT
+  ComputeOctreeKeys(vtkm::IdComponent NumLevels)
+    : numLevels(NumLevels)
+  {
+  }
+
+  template <typename MinPortalType, typename SizePortalType>
+  VTKM_EXEC vtkm::Id operator()(const vtkm::Vec<T, 3>& location,
+                                const vtkm::Id& rank,
+                                const MinPortalType& groupMin,
+                                const SizePortalType& groupSize) const
+  {
+    // Bin the particle on the finest level of the group's cube
+    vtkm::Vec<T, 3> lower = groupMin.Get(rank);
+    T size = groupSize.Get(rank);
+    vtkm::Id numBins = vtkm::Id(1) << numLevels;
+    ComputeBins<T> computeBins(lower[0],
+                               lower[0] + size,
+                               lower[1],
+                               lower[1] + size,
+                               lower[2],
+                               lower[2] + size,
+                               numBins,
+                               numBins,
+                               numBins);
+    vtkm::Id bin = computeBins(location[0], location[1], location[2]);
+
+    vtkm::Id xbin, ybin, zbin;
+    ComputeBinIndices<T> computeBinIndices(numBins, numBins, numBins);
+    computeBinIndices(bin, xbin, ybin, zbin);
+
+    vtkm::Id morton = SpreadBits(xbin) | (SpreadBits(ybin) << 1) | (SpreadBits(zbin) << 2);
+    return (rank << (3 * numLevels)) | morton;
+  }
+
+  // Insert two zero bits between each of the lowest 10 bits
+  VTKM_EXEC
+  static vtkm::Id SpreadBits(vtkm::Id value)
+  {
+    value &= 0x3FF;
+    value = (value | (value << 16)) & 0x030000FF;
+    value = (value | (value << 8)) & 0x0300F00F;
+    value = (value | (value << 4)) & 0x030C30C3;
+    value = (value | (value << 2)) & 0x09249249;
+    return value;
+  }
+}; // ComputeOctreeKeys
+}
+}
+}
+
+#endif
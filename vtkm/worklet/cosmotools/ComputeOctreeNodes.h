@@ -0,0 +1,63 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtkm_worklet_cosmotools_compute_octree_nodes_h
+#define vtkm_worklet_cosmotools_compute_octree_nodes_h
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace cosmotools
+{
+
+// Worklet for computing the center of mass and the size of the nodes on one octree level
+template <typename T>
+class ComputeOctreeNodes : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn nodeKey,        // (input) octree key of the node
+                                FieldIn numParticles,   // (input) particles in the node
+                                FieldIn locationSum,    // (input) sum of particle locations
+                                WholeArrayIn groupSize, // (input) cube side of each group
+                                FieldOut center,        // (output) center of mass
+                                FieldOut size);         // (output) side of the node
+  using ExecutionSignature = void(_1, _2, _3, _4, _5, _6);
+  using InputDomain = _1;
+
+  vtkm::IdComponent level; // Level of the nodes, 0 being the root
+
+  // Constructor
+  VTKM_EXEC_CONT
+  ComputeOctreeNodes(vtkm::IdComponent Level)
+    : level(Level)
+  {
+  }
+
+  template <typename SizePortalType>
+  VTKM_EXEC void operator()(const vtkm::Id& key,
+                            const vtkm::Id& numParticles,
+                            const vtkm::Vec<T, 3>& locationSum,
+                            const SizePortalType& groupSize,
+                            vtkm::Vec<T, 3>& center,
+                            T& size) const
+  {
+    // All particles have the same mass
+    center = locationSum / static_cast<T>(numParticles);
+    size = groupSize.Get(key >> (3 * level)) / static_cast<T>(vtkm::Id(1) << level);
+  }
+}; // ComputeOctreeNodes
+}
+}
+}
+
+#endif
@@ -0,0 +1,127 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtkm_worklet_cosmotools_compute_potential_barnes_hut_h
+#define vtkm_worklet_cosmotools_compute_potential_barnes_hut_h
+
+#include <vtkm/VectorAnalysis.h>
+#include <vtkm/worklet/WorkletMapField.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace cosmotools
+{
+
+// Worklet for computing the potential of a particle by walking the octree of its group
+// A node is replaced by its center of mass when its size is smaller than the opening angle
+// times its distance to the particle. Otherwise its children are visited, or the potential
+// is summed directly over its particles when it is a leaf or holds few particles.
+template <typename T>
+class ComputePotentialBarnesHut : public vtkm::worklet::WorkletMapField
+{
+public:
+  static constexpr vtkm::IdComponent MAX_TREE_LEVELS = 10;
+  static constexpr vtkm::Id LEAF_SIZE = 8;
+
+  using ControlSignature = void(FieldIn inputIndex,              // (input) particle index
+                                FieldIn root,                    // (input) root node of group
+                                WholeArrayIn treeLocation,       // (input) locations in tree order
+                                WholeArrayIn nodeCenter,         // (input) center of mass
+                                WholeArrayIn nodeSize,           // (input) side of the node
+                                WholeArrayIn nodeFirstParticle,  // (input) first particle
+                                WholeArrayIn nodeNumParticles,   // (input) particles in node
+                                WholeArrayIn nodeFirstChild,     // (input) first child node
+                                WholeArrayIn nodeNumChildren,    // (input) children of node
+                                WholeArrayOut potential);        // (output) potential
+  using ExecutionSignature = void(WorkIndex, _1, _2, _3, _4, _5, _6, _7, _8, _9, _10);
+  using InputDomain = _1;
+
+  T mass;         // Particle mass
+  T openingAngle; // Largest ratio of node size to distance for using the center of mass
+
+  // Constructor
+  VTKM_EXEC_CONT
+  ComputePotentialBarnesHut(T Mass, T OpeningAngle)
+    : mass(Mass)
+    , openingAngle(OpeningAngle)
+  {
+  }
+
+  template <typename LocationPortalType,
+            typename SizePortalType,
+            typename IdPortalType,
+            typename OutPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id& treeIndex,
+                            const vtkm::Id& inputIndex,
+                            const vtkm::Id& root,
+                            const LocationPortalType& treeLocation,
+                            const LocationPortalType& nodeCenter,
+                            const SizePortalType& nodeSize,
+                            const IdPortalType& nodeFirstParticle,
+                            const IdPortalType& nodeNumParticles,
+                            const IdPortalType& nodeFirstChild,
+                            const IdPortalType& nodeNumChildren,
+                            const OutPortalType& potential) const
+  {
+    const vtkm::Vec<T, 3> location = treeLocation.Get(treeIndex);
+    T sum = 0.0f;
+
+    // Depth first walk, each level leaves at most 7 siblings on the stack
+    vtkm::Vec<vtkm::Id, 8 * MAX_TREE_LEVELS> stack;
+    vtkm::IdComponent top = 0;
+    stack[top++] = root;
+    while (top > 0)
+    {
+      vtkm::Id node = stack[--top];
+      vtkm::Id first = nodeFirstParticle.Get(node);
+      vtkm::Id numParticles = nodeNumParticles.Get(node);
+
+      // Never approximate a node holding the particle itself
+      if ((treeIndex < first) || (treeIndex >= first + numParticles))
+      {
+        T r = vtkm::Magnitude(nodeCenter.Get(node) - location);
+        if (nodeSize.Get(node) < openingAngle * r)
+        {
+          sum -= (mass * static_cast<T>(numParticles)) / r;
+          continue;
+        }
+      }
+
+      vtkm::Id numChildren = nodeNumChildren.Get(node);
+      if ((numChildren == 0) || (numParticles <= LEAF_SIZE))
+      {
+        for (vtkm::Id j = first; j < first + numParticles; j++)
+        {
+          T r = vtkm::Magnitude(treeLocation.Get(j) - location);
+          if ((j != treeIndex) && (r > 0.00000000001f))
+          {
+            sum -= mass / r;
+          }
+        }
+      }
+      else
+      {
+        vtkm::Id firstChild = nodeFirstChild.Get(node);
+        for (vtkm::Id child = 0; child < numChildren; child++)
+        {
+          stack[top++] = firstChild + child;
+        }
+      }
+    }
+    potential.Set(inputIndex, sum);
+  }
+}; // ComputePotentialBarnesHut
+}
+}
+}
+
+#endif
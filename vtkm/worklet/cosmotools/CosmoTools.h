@@ -51,10 +51,14 @@
 #ifndef vtkm_worklet_cosmotools_cosmotools_h
 #define vtkm_worklet_cosmotools_cosmotools_h
 
+#include <vtkm/Deprecated.h>
+
 #include <vtkm/worklet/cosmotools/ComputeBinIndices.h>
 #include <vtkm/worklet/cosmotools/ComputeBinRange.h>
 #include <vtkm/worklet/cosmotools/ComputeBins.h>
 #include <vtkm/worklet/cosmotools/ComputeNeighborBins.h>
+#include <vtkm/worklet/cosmotools/ComputeOctreeKeys.h>
+#include <vtkm/worklet/cosmotools/ComputeOctreeNodes.h>
 #include <vtkm/worklet/cosmotools/GraftParticles.h>
 #include <vtkm/worklet/cosmotools/IsStar.h>
 #include <vtkm/worklet/cosmotools/MarkActiveNeighbors.h>
@@ -62,6 +66,7 @@
 #include <vtkm/worklet/cosmotools/ValidHalo.h>
 
 #include <vtkm/worklet/cosmotools/ComputePotential.h>
+#include <vtkm/worklet/cosmotools/ComputePotentialBarnesHut.h>
 #include <vtkm/worklet/cosmotools/ComputePotentialBin.h>
 #include <vtkm/worklet/cosmotools/ComputePotentialMxN.h>
 #include <vtkm/worklet/cosmotools/ComputePotentialNeighbors.h>
@@ -208,9 +213,12 @@ public:
   ~CosmoTools() {}
 
   // Halo finding and center finding on halos
+  // A positive opening angle computes the potentials with Barnes-Hut instead of NxN
   void HaloFinder(vtkm::cont::ArrayHandle<vtkm::Id>& resultHaloId,
                   vtkm::cont::ArrayHandle<vtkm::Id>& resultMBP,
-                  vtkm::cont::ArrayHandle<T>& resultPot);
+                  vtkm::cont::ArrayHandle<T>& resultPot,
+                  const T openingAngle = T(0));
+  VTKM_DEPRECATED(2.3, "Halos are linked by vtkm::worklet::connectivity::HaloFinder.")
   void BinParticlesAll(vtkm::cont::ArrayHandle<vtkm::Id>& partId,
                        vtkm::cont::ArrayHandle<vtkm::Id>& binId,
                        vtkm::cont::ArrayHandle<vtkm::Id>& leftNeighbor,
@@ -218,7 +226,8 @@ public:
   void MBPCenterFindingByHalo(vtkm::cont::ArrayHandle<vtkm::Id>& partId,
                               vtkm::cont::ArrayHandle<vtkm::Id>& haloId,
                               vtkm::cont::ArrayHandle<vtkm::Id>& mbpId,
-                              vtkm::cont::ArrayHandle<T>& minPotential);
+                              vtkm::cont::ArrayHandle<T>& minPotential,
+                              const T openingAngle = T(0));
 
   // MBP Center finding on single halo using NxN algorithm
   vtkm::Id MBPCenterFinderNxN(T* nxnPotential);
@@ -226,6 +235,15 @@ public:
   // MBP Center finding on single halo using MxN estimation
   vtkm::Id MBPCenterFinderMxN(T* mxnPotential);
 
+  // MBP Center finding on single halo using Barnes-Hut potentials
+  vtkm::Id MBPCenterFinderBarnesHut(const T openingAngle, T* bhPotential);
+
+  // Potential of particles within groups sorted by group using a Barnes-Hut octree
+  void ComputePotentialBarnesHut(vtkm::cont::ArrayHandle<vtkm::Id>& groupId,
+                                 vtkm::cont::ArrayHandle<vtkm::Id>& partId,
+                                 const T openingAngle,
+                                 vtkm::cont::ArrayHandle<T>& potential);
+
   void BinParticlesHalo(vtkm::cont::ArrayHandle<vtkm::Id>& partId,
                         vtkm::cont::ArrayHandle<vtkm::Id>& binId,
                         vtkm::cont::ArrayHandle<vtkm::Id>& uniqueBins,
@@ -0,0 +1,317 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtkm_worklet_cosmotools_cosmotools_barneshut_h
+#define vtkm_worklet_cosmotools_cosmotools_barneshut_h
+
+#include <vtkm/worklet/cosmotools/CosmoTools.h>
+
+#include <vtkm/cont/ArrayGetValues.h>
+#include <vtkm/cont/ArrayHandlePermutation.h>
+
+#include <limits>
+#include <vector>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace cosmotools
+{
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Functors used to build the octree
+//
+///////////////////////////////////////////////////////////////////////////////
+struct ComponentMinimum
+{
+  template <typename VecType>
+  VTKM_EXEC_CONT VecType operator()(const VecType& a, const VecType& b) const
+  {
+    return vtkm::Min(a, b);
+  }
+};
+
+struct ComponentMaximum
+{
+  template <typename VecType>
+  VTKM_EXEC_CONT VecType operator()(const VecType& a, const VecType& b) const
+  {
+    return vtkm::Max(a, b);
+  }
+};
+
+// Side of the cube enclosing the bounds, or 1 when all particles are at the same location
+template <typename T>
+struct CubeSizeFunctor
+{
+  VTKM_EXEC_CONT
+  T operator()(const vtkm::Vec<T, 3>& lower, const vtkm::Vec<T, 3>& upper) const
+  {
+    vtkm::Vec<T, 3> extent = upper - lower;
+    T size = vtkm::Max(extent[0], vtkm::Max(extent[1], extent[2]));
+    return (size > 0) ? size : T(1);
+  }
+};
+
+// Octree key of the parent of a node that many levels up
+struct ShiftKeyFunctor
+{
+  vtkm::IdComponent Levels;
+
+  VTKM_CONT
+  ShiftKeyFunctor(vtkm::IdComponent levels = 0)
+    : Levels(levels)
+  {
+  }
+
+  VTKM_EXEC_CONT
+  vtkm::Id operator()(vtkm::Id key) const { return key >> (3 * this->Levels); }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Barnes-Hut potential of every particle within its group (a halo)
+// groupId must be sorted and gives the group of every particle in partId
+// The potential is returned in the same order as partId
+//
+// An octree is built over the cube enclosing each group. Its nodes are stored level
+// by level: the particles are sorted by the Morton code of their bin on the deepest
+// possible level, so that the particles of every node are contiguous and each level is
+// a ReduceByKey over the keys shifted to that level. The tree stops at the first level
+// where no leaf holds more than LEAF_SIZE particles.
+//
+///////////////////////////////////////////////////////////////////////////////
+template <typename T, typename StorageType>
+void CosmoTools<T, StorageType>::ComputePotentialBarnesHut(
+  vtkm::cont::ArrayHandle<vtkm::Id>& groupId,
+  vtkm::cont::ArrayHandle<vtkm::Id>& partId,
+  const T openingAngle,
+  vtkm::cont::ArrayHandle<T>& potential)
+{
+  using PositionType = vtkm::Vec<T, 3>;
+  using PotentialWorklet = cosmotools::ComputePotentialBarnesHut<T>;
+  vtkm::cont::Invoker invoke;
+
+  const vtkm::Id numParticles = partId.GetNumberOfValues();
+  potential.Allocate(numParticles);
+  if (numParticles == 0)
+  {
+    return;
+  }
+
+  // Number the groups and give every particle the rank of its group
+  vtkm::cont::ArrayHandleConstant<vtkm::Id> constArray(1, numParticles);
+  vtkm::cont::ArrayHandle<vtkm::Id> uniqueGroups;
+  vtkm::cont::ArrayHandle<vtkm::Id> partPerGroup;
+  DeviceAlgorithm::ReduceByKey(groupId, constArray, uniqueGroups, partPerGroup, vtkm::Add());
+  const vtkm::Id numGroups = uniqueGroups.GetNumberOfValues();
+
+  vtkm::cont::ArrayHandle<vtkm::Id> groupRank;
+  vtkm::worklet::ScatterCounting scatter(partPerGroup);
+  invoke(ScatterWorklet<vtkm::Id>{}, scatter, vtkm::cont::ArrayHandleIndex(numGroups), groupRank);
+
+  // Enclose each group in a cube
+  auto location = vtkm::cont::make_ArrayHandlePermutation(
+    partId, vtkm::cont::make_ArrayHandleCompositeVector(xLoc, yLoc, zLoc));
+  vtkm::cont::ArrayHandle<vtkm::Id> tempId;
+  vtkm::cont::ArrayHandle<PositionType> groupMin;
+  vtkm::cont::ArrayHandle<PositionType> groupMax;
+  vtkm::cont::ArrayHandle<T> groupSize;
+  DeviceAlgorithm::ReduceByKey(groupId, location, tempId, groupMin, ComponentMinimum());
+  DeviceAlgorithm::ReduceByKey(groupId, location, tempId, groupMax, ComponentMaximum());
+  DeviceAlgorithm::Transform(groupMin, groupMax, groupSize, CubeSizeFunctor<T>());
+  groupMax.ReleaseResources();
+
+  // Sort the particles by their octree key on the deepest level that the key can hold
+  vtkm::IdComponent maxLevels = PotentialWorklet::MAX_TREE_LEVELS;
+  while ((maxLevels > 1) &&
+         ((numGroups - 1) > (std::numeric_limits<vtkm::Id>::max() >> (3 * maxLevels))))
+  {
+    maxLevels--;
+  }
+  vtkm::cont::ArrayHandle<vtkm::Id> treeKey;
+  invoke(ComputeOctreeKeys<T>{ maxLevels }, location, groupRank, groupMin, groupSize, treeKey);
+  vtkm::cont::ArrayHandle<vtkm::Id> treeIndex;
+  DeviceAlgorithm::Copy(vtkm::cont::ArrayHandleIndex(numParticles), treeIndex);
+  DeviceAlgorithm::SortByKey(treeKey, treeIndex);
+  groupRank.ReleaseResources();
+
+  // Subdivide until no leaf holds more than LEAF_SIZE particles, since clustered groups
+  // need more levels than the largest group would on a uniform distribution
+  const vtkm::Id maxGroupParticles =
+    DeviceAlgorithm::Reduce(partPerGroup, vtkm::Id(0), vtkm::Maximum());
+  vtkm::IdComponent numLevels = 1;
+  while ((numLevels < maxLevels) &&
+         ((vtkm::Id(1) << (3 * numLevels)) * PotentialWorklet::LEAF_SIZE < maxGroupParticles))
+  {
+    numLevels++;
+  }
+  while (numLevels < maxLevels)
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> leafNumParticles;
+    DeviceAlgorithm::ReduceByKey(
+      vtkm::cont::make_ArrayHandleTransform(treeKey, ShiftKeyFunctor(maxLevels - numLevels)),
+      constArray,
+      tempId,
+      leafNumParticles,
+      vtkm::Add());
+    if (DeviceAlgorithm::Reduce(leafNumParticles, vtkm::Id(0), vtkm::Maximum()) <=
+        PotentialWorklet::LEAF_SIZE)
+    {
+      break;
+    }
+    numLevels++;
+  }
+
+  vtkm::cont::ArrayHandle<PositionType> treeLocation;
+  DeviceAlgorithm::Copy(vtkm::cont::make_ArrayHandlePermutation(treeIndex, location),
+                        treeLocation);
+
+  // Nodes of each level, from the roots (one per group) to the leaves
+  std::vector<vtkm::cont::ArrayHandle<vtkm::Id>> levelKey(numLevels + 1);
+  std::vector<vtkm::cont::ArrayHandle<vtkm::Id>> levelNumParticles(numLevels + 1);
+  std::vector<vtkm::cont::ArrayHandle<PositionType>> levelCenter(numLevels + 1);
+  std::vector<vtkm::cont::ArrayHandle<T>> levelSize(numLevels + 1);
+  std::vector<vtkm::Id> levelOffset(numLevels + 2, 0);
+  for (vtkm::IdComponent level = 0; level <= numLevels; level++)
+  {
+    auto key = vtkm::cont::make_ArrayHandleTransform(treeKey,
+                                                     ShiftKeyFunctor(maxLevels - level));
+    vtkm::cont::ArrayHandle<PositionType> locationSum;
+    DeviceAlgorithm::ReduceByKey(
+      key, constArray, levelKey[level], levelNumParticles[level], vtkm::Add());
+    DeviceAlgorithm::ReduceByKey(key, treeLocation, tempId, locationSum, vtkm::Add());
+
+    invoke(ComputeOctreeNodes<T>{ level },
+           levelKey[level],
+           levelNumParticles[level],
+           locationSum,
+           groupSize,
+           levelCenter[level],
+           levelSize[level]);
+    levelOffset[level + 1] = levelOffset[level] + levelKey[level].GetNumberOfValues();
+  }
+
+  // Gather the levels into single arrays of nodes
+  const vtkm::Id numNodes = levelOffset[numLevels + 1];
+  vtkm::cont::ArrayHandle<PositionType> nodeCenter;
+  vtkm::cont::ArrayHandle<T> nodeSize;
+  vtkm::cont::ArrayHandle<vtkm::Id> nodeFirstParticle;
+  vtkm::cont::ArrayHandle<vtkm::Id> nodeNumParticles;
+  vtkm::cont::ArrayHandle<vtkm::Id> nodeFirstChild;
+  vtkm::cont::ArrayHandle<vtkm::Id> nodeNumChildren;
+  nodeCenter.Allocate(numNodes);
+  nodeSize.Allocate(numNodes);
+  nodeFirstParticle.Allocate(numNodes);
+  nodeNumParticles.Allocate(numNodes);
+  nodeFirstChild.Allocate(numNodes);
+  nodeNumChildren.Allocate(numNodes);
+
+  for (vtkm::IdComponent level = 0; level <= numLevels; level++)
+  {
+    const vtkm::Id offset = levelOffset[level];
+    const vtkm::Id numLevelNodes = levelOffset[level + 1] - offset;
+    DeviceAlgorithm::CopySubRange(levelCenter[level], 0, numLevelNodes, nodeCenter, offset);
+    DeviceAlgorithm::CopySubRange(levelSize[level], 0, numLevelNodes, nodeSize, offset);
+    DeviceAlgorithm::CopySubRange(
+      levelNumParticles[level], 0, numLevelNodes, nodeNumParticles, offset);
+
+    // The particles of the nodes of a level cover all particles in order
+    vtkm::cont::ArrayHandle<vtkm::Id> firstParticle;
+    DeviceAlgorithm::ScanExclusive(levelNumParticles[level], firstParticle);
+    DeviceAlgorithm::CopySubRange(firstParticle, 0, numLevelNodes, nodeFirstParticle, offset);
+
+    // Likewise the children on the next level are in the order of their parents
+    vtkm::cont::ArrayHandle<vtkm::Id> numChildren;
+    vtkm::cont::ArrayHandle<vtkm::Id> firstChild;
+    vtkm::cont::ArrayHandle<vtkm::Id> tempChild;
+    if (level < numLevels)
+    {
+      auto parentKey = vtkm::cont::make_ArrayHandleTransform(levelKey[level + 1],
+                                                             ShiftKeyFunctor(1));
+      vtkm::cont::ArrayHandleConstant<vtkm::Id> childArray(
+        1, levelKey[level + 1].GetNumberOfValues());
+      DeviceAlgorithm::ReduceByKey(parentKey, childArray, tempId, numChildren, vtkm::Add());
+      DeviceAlgorithm::ScanExclusive(numChildren, tempChild);
+      DeviceAlgorithm::Copy(vtkm::cont::make_ArrayHandleTransform(
+                              tempChild, ScaleBiasFunctor<vtkm::Id>(1, levelOffset[level + 1])),
+                            firstChild);
+    }
+    else
+    {
+      DeviceAlgorithm::Copy(vtkm::cont::ArrayHandleConstant<vtkm::Id>(0, numLevelNodes),
+                            numChildren);
+      DeviceAlgorithm::Copy(numChildren, firstChild);
+    }
+    DeviceAlgorithm::CopySubRange(numChildren, 0, numLevelNodes, nodeNumChildren, offset);
+    DeviceAlgorithm::CopySubRange(firstChild, 0, numLevelNodes, nodeFirstChild, offset);
+
+    levelKey[level].ReleaseResources();
+    levelNumParticles[level].ReleaseResources();
+    levelCenter[level].ReleaseResources();
+    levelSize[level].ReleaseResources();
+  }
+#ifdef DEBUG_PRINT
+  std::cout << std::endl
+            << "** ComputePotentialBarnesHut (" << numGroups << " groups, " << numLevels
+            << " levels, " << numNodes << " nodes)" << std::endl;
+#endif
+
+  // The roots of the groups are the first nodes, in the order of the group ranks
+  PotentialWorklet computePotential(particleMass, openingAngle);
+  invoke(computePotential,
+         treeIndex,
+         vtkm::cont::make_ArrayHandleTransform(treeKey, ShiftKeyFunctor(maxLevels)),
+         treeLocation,
+         nodeCenter,
+         nodeSize,
+         nodeFirstParticle,
+         nodeNumParticles,
+         nodeFirstChild,
+         nodeNumChildren,
+         potential);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// Center finder for particles in a single halo using Barnes-Hut potentials
+// MBP (Most Bound Particle) is particle with the minimum potential energy
+//
+///////////////////////////////////////////////////////////////////////////////
+template <typename T, typename StorageType>
+vtkm::Id CosmoTools<T, StorageType>::MBPCenterFinderBarnesHut(const T openingAngle,
+                                                              T* bhPotential)
+{
+  vtkm::cont::ArrayHandle<vtkm::Id> groupId;
+  vtkm::cont::ArrayHandle<vtkm::Id> partId;
+  DeviceAlgorithm::Copy(vtkm::cont::ArrayHandleConstant<vtkm::Id>(0, nParticles), groupId);
+  DeviceAlgorithm::Copy(vtkm::cont::ArrayHandleIndex(nParticles), partId);
+
+  vtkm::cont::ArrayHandle<T> potential;
+  ComputePotentialBarnesHut(groupId, partId, openingAngle, potential);
+
+  // Of all particles which has the minimum potential
+  DeviceAlgorithm::SortByKey(potential, partId);
+#ifdef DEBUG_PRINT
+  DebugPrint("partId", partId);
+  DebugPrint("potential", potential);
+#endif
+
+  vtkm::Id bhMBP = vtkm::cont::ArrayGetValue(0, partId);
+  *bhPotential = vtkm::cont::ArrayGetValue(0, potential);
+
+  return bhMBP;
+}
+}
+}
+}
+#endif
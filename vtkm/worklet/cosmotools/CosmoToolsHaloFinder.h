@@ -53,7 +53,7 @@
 
 #include <vtkm/worklet/cosmotools/CosmoTools.h>
 
-#include <vtkm/cont/ArrayGetValues.h>
+#include <vtkm/worklet/connectivity/HaloFinder.h>
 
 namespace vtkm
 {
@@ -71,7 +71,8 @@ namespace cosmotools
 template <typename T, typename StorageType>
 void CosmoTools<T, StorageType>::HaloFinder(vtkm::cont::ArrayHandle<vtkm::Id>& resultHaloId,
                                             vtkm::cont::ArrayHandle<vtkm::Id>& resultMBP,
-                                            vtkm::cont::ArrayHandle<T>& resultPot)
+                                            vtkm::cont::ArrayHandle<T>& resultPot,
+                                            const T openingAngle)
 {
   // Package locations for worklets
   using CompositeLocationType =
@@ -79,105 +80,23 @@ void CosmoTools<T, StorageType>::HaloFinder(vtkm::cont::ArrayHandle<vtkm::Id>& r
   CompositeLocationType location;
   location = make_ArrayHandleCompositeVector(xLoc, yLoc, zLoc);
 
-  vtkm::cont::ArrayHandle<vtkm::Id> leftNeighbor;  // lower particle id to check for linking length
-  vtkm::cont::ArrayHandle<vtkm::Id> rightNeighbor; // upper particle id to check for linking length
-  vtkm::cont::ArrayHandle<vtkm::UInt32>
-    activeMask;                             // mask per particle indicating active neighbor bins
-  vtkm::cont::ArrayHandle<vtkm::Id> partId; // index into all particles
-  vtkm::cont::ArrayHandle<vtkm::Id> binId;  // bin id for each particle in each FOF halo
-
-  leftNeighbor.Allocate(NUM_NEIGHBORS * nParticles);
-  rightNeighbor.Allocate(NUM_NEIGHBORS * nParticles);
-
-  vtkm::cont::ArrayHandleConstant<bool> trueArray(true, nParticles);
-  vtkm::cont::ArrayHandleIndex indexArray(nParticles);
-
-  // Bin all particles in domain into bins of size linking length
-  BinParticlesAll(partId, binId, leftNeighbor, rightNeighbor);
-
-  // Mark active neighbor bins, meaning at least one particle in the bin
-  // is within linking length of the given particle indicated by mask
-  MarkActiveNeighbors<T> markActiveNeighbors(numBinsX, numBinsY, numBinsZ, NUM_NEIGHBORS, linkLen);
-  vtkm::worklet::DispatcherMapField<MarkActiveNeighbors<T>> markActiveNeighborsDispatcher(
-    markActiveNeighbors);
-  markActiveNeighborsDispatcher.Invoke(
-    indexArray,    // (input) index into all particles
-    partId,        // (input) particle id sorted by bin
-    binId,         // (input) bin id sorted
-    partId,        // (input) particle id (whole array)
-    location,      // (input) location on original particle order
-    leftNeighbor,  // (input) first partId for neighbor vector
-    rightNeighbor, // (input) last partId for neighbor vector
-    activeMask);   // (output) mask per particle indicating valid neighbors
-
-  // Initialize halo id of each particle to itself
-  vtkm::cont::ArrayHandle<vtkm::Id> haloIdCurrent;
-  vtkm::cont::ArrayHandle<vtkm::Id> haloIdLast;
-  DeviceAlgorithm::Copy(indexArray, haloIdCurrent);
-  DeviceAlgorithm::Copy(indexArray, haloIdLast);
-
-  // rooted star is nchecked each iteration for all particles being rooted in a halo
-  vtkm::cont::ArrayHandle<bool> rootedStar;
-
-  // Iterate over particles graft together to form halos
-  while (true)
-  {
-    // Connect each particle to another close particle to build halos
-    GraftParticles<T> graftParticles(numBinsX, numBinsY, numBinsZ, NUM_NEIGHBORS, linkLen);
-    vtkm::worklet::DispatcherMapField<GraftParticles<T>> graftParticlesDispatcher(graftParticles);
-
-    graftParticlesDispatcher.Invoke(indexArray,   // (input) index into particles
-                                    partId,       // (input) particle id sorted by bin
-                                    binId,        // (input) bin id sorted by bin
-                                    activeMask,   // (input) flag indicates if neighor range is used
-                                    partId,       // (input) particle id (whole array)
-                                    location,     // (input) location on original particle order
-                                    leftNeighbor, // (input) first partId for neighbor
-                                    rightNeighbor,  // (input) last partId for neighbor
-                                    haloIdCurrent); // (output)
-#ifdef DEBUG_PRINT
-    DebugPrint("haloIdCurrent", haloIdCurrent);
-#endif
-
-    // Reininitialize rootedStar for each pass
-    DeviceAlgorithm::Copy(trueArray, rootedStar);
-
-    // By comparing the haloIds from the last pass and this one
-    // determine if any particles are still migrating to halos
-    IsStar isStar;
-    vtkm::worklet::DispatcherMapField<IsStar> isStarDispatcher(isStar);
-    isStarDispatcher.Invoke(indexArray,
-                            haloIdCurrent, // input (whole array)
-                            haloIdLast,    // input (whole array)
-                            rootedStar);   // output (whole array)
-
-    // If all vertices are in rooted stars, algorithm is complete
-    bool allStars = DeviceAlgorithm::Reduce(rootedStar, true, vtkm::LogicalAnd());
-    if (allStars)
-    {
-      break;
-    }
-    else
-    // Otherwise copy current halo ids to last pass halo ids
-    {
-      PointerJump pointerJump;
-      vtkm::worklet::DispatcherMapField<PointerJump> pointerJumpDispatcher(pointerJump);
-      pointerJumpDispatcher.Invoke(indexArray, haloIdCurrent); // input (whole array)
-      DeviceAlgorithm::Copy(haloIdCurrent, haloIdLast);
-    }
-  }
+  // Link particles within the linking length of each other into friends-of-friends halos.
+  // The halo id of each particle is the smallest particle id in its halo.
+  vtkm::cont::ArrayHandle<vtkm::Id> haloId;
+  vtkm::worklet::connectivity::HaloFinder::Run(
+    location, static_cast<vtkm::Float64>(linkLen), haloId);
 
   // Index into final halo id is the original particle ordering
-  // not the particles sorted by bin
-  DeviceAlgorithm::Copy(indexArray, partId);
+  vtkm::cont::ArrayHandle<vtkm::Id> partId; // index into all particles
+  DeviceAlgorithm::Copy(vtkm::cont::ArrayHandleIndex(nParticles), partId);
 #ifdef DEBUG_PRINT
-  DebugPrint("FINAL haloId", haloIdCurrent);
+  DebugPrint("FINAL haloId", haloId);
   DebugPrint("FINAL partId", partId);
 #endif
 
   // Call center finding on all halos using method with ReduceByKey and Scatter
-  DeviceAlgorithm::Copy(haloIdCurrent, resultHaloId);
-  MBPCenterFindingByHalo(partId, resultHaloId, resultMBP, resultPot);
+  DeviceAlgorithm::Copy(haloId, resultHaloId);
+  MBPCenterFindingByHalo(partId, resultHaloId, resultMBP, resultPot, openingAngle);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -276,6 +195,7 @@ void CosmoTools<T, StorageType>::BinParticlesAll(vtkm::cont::ArrayHandle<vtkm::I
   DeviceAlgorithm::UpperBounds(binId, rightNeighbor, rightNeighbor);
 }
 
+
 ///////////////////////////////////////////////////////////////////////////////
 //
 // Center finder for all particles given location, particle id and halo id
@@ -287,7 +207,8 @@ template <typename T, typename StorageType>
 void CosmoTools<T, StorageType>::MBPCenterFindingByHalo(vtkm::cont::ArrayHandle<vtkm::Id>& partId,
                                                         vtkm::cont::ArrayHandle<vtkm::Id>& haloId,
                                                         vtkm::cont::ArrayHandle<vtkm::Id>& mbpId,
-                                                        vtkm::cont::ArrayHandle<T>& minPotential)
+                                                        vtkm::cont::ArrayHandle<T>& minPotential,
+                                                        const T openingAngle)
 {
   // Sort particles into groups according to halo id using an index into WholeArrays
   DeviceAlgorithm::SortByKey(haloId, partId);
@@ -340,18 +261,26 @@ void CosmoTools<T, StorageType>::MBPCenterFindingByHalo(vtkm::cont::ArrayHandle<
 #endif
 
   // Compute potentials
-  ComputePotential<T> computePotential(particleMass);
-  vtkm::worklet::DispatcherMapField<ComputePotential<T>> computePotentialDispatcher(
-    computePotential);
-
-  computePotentialDispatcher.Invoke(indexArray,
-                                    partId,      // input (whole array)
-                                    xLoc,        // input (whole array)
-                                    yLoc,        // input (whole array)
-                                    zLoc,        // input (whole array)
-                                    minParticle, // input (whole array)
-                                    maxParticle, // input (whole array)
-                                    potential);  // output
+  if (openingAngle > 0)
+  {
+    // Approximate far away particles of the halo with an octree
+    ComputePotentialBarnesHut(haloId, partId, openingAngle, potential);
+  }
+  else
+  {
+    ComputePotential<T> computePotential(particleMass);
+    vtkm::worklet::DispatcherMapField<ComputePotential<T>> computePotentialDispatcher(
+      computePotential);
+
+    computePotentialDispatcher.Invoke(indexArray,
+                                      partId,      // input (whole array)
+                                      xLoc,        // input (whole array)
+                                      yLoc,        // input (whole array)
+                                      zLoc,        // input (whole array)
+                                      minParticle, // input (whole array)
+                                      maxParticle, // input (whole array)
+                                      potential);  // output
+  }
 
   // Find minimum potential for all particles in a halo and scatter
   DeviceAlgorithm::ReduceByKey(haloId, potential, uniqueHaloIds, tempT, vtkm::Minimum());
@@ -51,6 +51,7 @@
 #ifndef vtkm_worklet_cosmotools_graft_particle_h
 #define vtkm_worklet_cosmotools_graft_particle_h
 
+#include <vtkm/Deprecated.h>
 #include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/cosmotools/TagTypes.h>
 
@@ -63,7 +64,8 @@ namespace cosmotools
 
 // Worklet to graft particles together to form halos
 template <typename T>
-class GraftParticles : public vtkm::worklet::WorkletMapField
+class VTKM_DEPRECATED(2.3, "Halos are linked by vtkm::worklet::connectivity::HaloFinder.")
+  GraftParticles : public vtkm::worklet::WorkletMapField
 {
 public:
   using ControlSignature =
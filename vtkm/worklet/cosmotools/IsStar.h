@@ -51,6 +51,7 @@
 #ifndef vtkm_worklet_cosmotools_is_star_h
 #define vtkm_worklet_cosmotools_is_star_h
 
+#include <vtkm/Deprecated.h>
 #include <vtkm/worklet/WorkletMapField.h>
 
 namespace vtkm
@@ -62,7 +63,8 @@ namespace cosmotools
 
 // Examine halo ids from current pass and last pass to see if particles
 // are rooted in an existing halo
-class IsStar : public vtkm::worklet::WorkletMapField
+class VTKM_DEPRECATED(2.3, "Halos are linked by vtkm::worklet::connectivity::HaloFinder.")
+  IsStar : public vtkm::worklet::WorkletMapField
 {
 public:
   using ControlSignature = void(FieldIn index,
@@ -51,6 +51,7 @@
 #ifndef vtkm_worklet_cosmotools_mark_active_neighbors_h
 #define vtkm_worklet_cosmotools_mark_active_neighbors_h
 
+#include <vtkm/Deprecated.h>
 #include <vtkm/worklet/WorkletMapField.h>
 #include <vtkm/worklet/cosmotools/TagTypes.h>
 
@@ -63,7 +64,8 @@ namespace cosmotools
 // Worklet for particles to indicate which neighbors are active
 // because at least one particle in that bin is within linking length
 template <typename T>
-class MarkActiveNeighbors : public vtkm::worklet::WorkletMapField
+class VTKM_DEPRECATED(2.3, "Halos are linked by vtkm::worklet::connectivity::HaloFinder.")
+  MarkActiveNeighbors : public vtkm::worklet::WorkletMapField
 {
 public:
   using ControlSignature =
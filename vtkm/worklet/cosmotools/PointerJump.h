@@ -51,6 +51,7 @@
 #ifndef vtkm_worklet_cosmotools_pointer_jump_h
 #define vtkm_worklet_cosmotools_pointer_jump_h
 
+#include <vtkm/Deprecated.h>
 #include <vtkm/worklet/WorkletMapField.h>
 
 namespace vtkm
@@ -61,7 +62,8 @@ namespace cosmotools
 {
 
 // Jump to next pointer in array
-class PointerJump : public vtkm::worklet::WorkletMapField
+class VTKM_DEPRECATED(2.3, "Halos are linked by vtkm::worklet::connectivity::HaloFinder.")
+  PointerJump : public vtkm::worklet::WorkletMapField
 {
 public:
   using ControlSignature = void(FieldIn index, WholeArrayInOut D);
@@ -12,6 +12,7 @@
 #include <vtkm/worklet/DispatcherMapField.h>
 
 #include <vtkm/Pair.h>
+#include <vtkm/cont/ArrayCopy.h>
 #include <vtkm/cont/ArrayHandle.h>
 #include <vtkm/cont/ArrayHandleIndex.h>
 #include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
@@ -21,6 +22,7 @@
 #include <vtkm/cont/testing/Testing.h>
 
 #include <fstream>
+#include <random>
 
 namespace
 {
@@ -319,12 +321,132 @@ void TestCosmo_3DCenterFind()
                    "NxN and MxN got different results");
 }
 
+void TestCosmo_BarnesHutPotential()
+{
+  std::cout << "Testing Barnes-Hut potential" << std::endl;
+
+  // Two clusters of particles so that the octree is uneven
+  const vtkm::Id nParticles = 3000;
+  std::default_random_engine generator(1);
+  std::normal_distribution<vtkm::Float32> core(0.0f, 0.5f);
+  std::normal_distribution<vtkm::Float32> clump(3.0f, 0.1f);
+  std::vector<vtkm::Float32> xLocation, yLocation, zLocation;
+  for (vtkm::Id i = 0; i < nParticles; i++)
+  {
+    auto& dist = (i % 5 == 0) ? clump : core;
+    xLocation.push_back(dist(generator));
+    yLocation.push_back(dist(generator));
+    zLocation.push_back(dist(generator));
+  }
+  auto xLocArray = vtkm::cont::make_ArrayHandle(xLocation, vtkm::CopyFlag::Off);
+  auto yLocArray = vtkm::cont::make_ArrayHandle(yLocation, vtkm::CopyFlag::Off);
+  auto zLocArray = vtkm::cont::make_ArrayHandle(zLocation, vtkm::CopyFlag::Off);
+  vtkm::Float32 particleMass = 1.0f;
+
+  using CosmoType =
+    vtkm::worklet::cosmotools::CosmoTools<vtkm::Float32, vtkm::cont::StorageTagBasic>;
+  CosmoType cosmo(nParticles, particleMass, xLocArray, yLocArray, zLocArray);
+
+  vtkm::cont::ArrayHandle<vtkm::Float32> nxnPotential;
+  vtkm::worklet::DispatcherMapField<vtkm::worklet::cosmotools::ComputePotentialNxN<vtkm::Float32>>
+    nxnDispatcher(
+      vtkm::worklet::cosmotools::ComputePotentialNxN<vtkm::Float32>(nParticles, particleMass));
+  nxnDispatcher.Invoke(
+    vtkm::cont::ArrayHandleIndex(nParticles), xLocArray, yLocArray, zLocArray, nxnPotential);
+
+  // A vanishing opening angle opens every node and sums all particles directly
+  for (vtkm::Float32 openingAngle : { 1e-6f, 0.3f, 0.7f })
+  {
+    vtkm::cont::ArrayHandle<vtkm::Id> groupId;
+    vtkm::cont::ArrayHandle<vtkm::Id> partId;
+    vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleConstant<vtkm::Id>(0, nParticles), groupId);
+    vtkm::cont::ArrayCopy(vtkm::cont::ArrayHandleIndex(nParticles), partId);
+    vtkm::cont::ArrayHandle<vtkm::Float32> bhPotential;
+    cosmo.ComputePotentialBarnesHut(groupId, partId, openingAngle, bhPotential);
+
+    vtkm::Float64 maxError = 0;
+    auto bhPortal = bhPotential.ReadPortal();
+    auto nxnPortal = nxnPotential.ReadPortal();
+    for (vtkm::Id i = 0; i < nParticles; i++)
+    {
+      vtkm::Float64 error = vtkm::Abs(bhPortal.Get(i) - nxnPortal.Get(i)) / -nxnPortal.Get(i);
+      maxError = vtkm::Max(maxError, error);
+    }
+    std::cout << "  opening angle " << openingAngle << " max relative error " << maxError
+              << std::endl;
+    VTKM_TEST_ASSERT(maxError < ((openingAngle < 0.1f) ? 1e-4 : 1e-2),
+                     "Barnes-Hut potential too far from NxN");
+  }
+
+  vtkm::worklet::CosmoTools cosmoTools;
+  vtkm::Pair<vtkm::Id, vtkm::Float32> nxnResult;
+  vtkm::Pair<vtkm::Id, vtkm::Float32> bhResult;
+  cosmoTools.RunMBPCenterFinderNxN(
+    xLocArray, yLocArray, zLocArray, nParticles, particleMass, nxnResult);
+  cosmoTools.RunMBPCenterFinderBarnesHut(
+    xLocArray, yLocArray, zLocArray, nParticles, particleMass, 0.5f, bhResult);
+  vtkm::Float32 bhExactPotential = nxnPotential.ReadPortal().Get(bhResult.first);
+  VTKM_TEST_ASSERT(test_equal(bhExactPotential, nxnResult.second, 1e-3),
+                   "Barnes-Hut MBP is not bound as tightly as the NxN MBP");
+}
+
+void TestCosmo_3DBarnesHut()
+{
+  std::cout << "Testing Barnes-Hut Halo and Center Finder 3D" << std::endl;
+
+  vtkm::cont::DataSet dataSet = MakeCosmo_3DDataSet_0();
+  vtkm::Id nCells = dataSet.GetNumberOfCells();
+
+  vtkm::cont::ArrayHandle<vtkm::Float32> xLocArray;
+  vtkm::cont::ArrayHandle<vtkm::Float32> yLocArray;
+  vtkm::cont::ArrayHandle<vtkm::Float32> zLocArray;
+  vtkm::cont::ArrayHandle<vtkm::Id> haloIdArray;
+  vtkm::cont::ArrayHandle<vtkm::Id> mbpArray;
+
+  dataSet.GetField("xLocation").GetData().AsArrayHandle(xLocArray);
+  dataSet.GetField("yLocation").GetData().AsArrayHandle(yLocArray);
+  dataSet.GetField("zLocation").GetData().AsArrayHandle(zLocArray);
+  dataSet.GetField("haloId").GetData().AsArrayHandle(haloIdArray);
+  dataSet.GetField("mbp").GetData().AsArrayHandle(mbpArray);
+
+  vtkm::cont::ArrayHandle<vtkm::Id> resultHaloId;
+  vtkm::cont::ArrayHandle<vtkm::Id> resultMBP;
+  vtkm::cont::ArrayHandle<vtkm::Float32> resultPot;
+
+  vtkm::worklet::CosmoTools cosmoTools;
+  cosmoTools.RunHaloFinder(xLocArray,
+                           yLocArray,
+                           zLocArray,
+                           nCells,
+                           1.0f,
+                           3,
+                           0.2f,
+                           0.5f,
+                           resultHaloId,
+                           resultMBP,
+                           resultPot);
+
+  VTKM_TEST_ASSERT(TestArrayHandle(haloIdArray, resultHaloId, nCells), "Incorrect Halo Ids");
+  VTKM_TEST_ASSERT(TestArrayHandle(mbpArray, resultMBP, nCells), "Incorrect MBP Ids");
+
+  vtkm::Pair<vtkm::Id, vtkm::Float32> nxnResult;
+  vtkm::Pair<vtkm::Id, vtkm::Float32> bhResult;
+  cosmoTools.RunMBPCenterFinderNxN(xLocArray, yLocArray, zLocArray, nCells, 1.0f, nxnResult);
+  cosmoTools.RunMBPCenterFinderBarnesHut(
+    xLocArray, yLocArray, zLocArray, nCells, 1.0f, 0.5f, bhResult);
+  VTKM_TEST_ASSERT(test_equal(nxnResult.first, bhResult.first),
+                   "NxN and Barnes-Hut got different results");
+}
+
 void TestCosmoTools()
 {
   TestCosmo_2DHaloFind();
   TestCosmo_3DHaloFind();
 
   TestCosmo_3DCenterFind();
+
+  TestCosmo_BarnesHutPotential();
+  TestCosmo_3DBarnesHut();
 }
 
 int UnitTestCosmoTools(int argc, char* argv[])
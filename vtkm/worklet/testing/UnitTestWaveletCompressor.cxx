@@ -9,6 +9,8 @@
 //============================================================================
 
 #include <vtkm/worklet/WaveletCompressor.h>
+#include <vtkm/worklet/wavelets/BitPlaneCoder.h>
+#include <vtkm/worklet/wavelets/WaveletLifting.h>
 
 #include <vtkm/cont/ArrayHandlePermutation.h>
 #include <vtkm/cont/Timer.h>
@@ -290,12 +292,128 @@ void TestDecomposeReconstruct1D(vtkm::Float64 cratio)
   }
 }
 
+void TestSelectAbs()
+{
+  std::cout << "Testing threshold selection" << std::endl;
+  vtkm::Id sigLen = 100000;
+  vtkm::cont::ArrayHandle<vtkm::Float64> inputArray;
+  inputArray.Allocate(sigLen);
+  auto wp = inputArray.WritePortal();
+  for (vtkm::Id i = 0; i < sigLen; i++)
+  {
+    // Include repeated values, zeros, and both signs.
+    wp.Set(i, static_cast<vtkm::Float64>((i * 7919) % 5003 - 2501) / 3.0);
+  }
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> sortedArray;
+  vtkm::cont::ArrayCopy(inputArray, sortedArray);
+  vtkm::worklet::WaveletCompressor compressor(vtkm::worklet::wavelets::CDF9_7);
+  compressor.DeviceSort(sortedArray);
+  auto sortedPortal = sortedArray.ReadPortal();
+  for (vtkm::Id n : { vtkm::Id(0), vtkm::Id(1), sigLen / 3, sigLen / 2, sigLen - 1 })
+  {
+    VTKM_TEST_ASSERT(compressor.DeviceSelectAbs(inputArray, n) ==
+                       vtkm::Abs(sortedPortal.Get(n)),
+                     "Selected threshold does not match sorted value");
+  }
+}
+
+void TestLifting3D(vtkm::worklet::wavelets::WaveletName wname)
+{
+  std::cout << "Testing lifting transform" << std::endl;
+  vtkm::Id3 dims(37, 20, 11);
+  vtkm::cont::ArrayHandle<vtkm::Float64> inputArray;
+  inputArray.Allocate(dims[0] * dims[1] * dims[2]);
+  FillArray3D(inputArray, dims[0], dims[1], dims[2]);
+
+  vtkm::worklet::wavelets::WaveletLifting lifting(wname);
+  vtkm::Id nLevels = lifting.GetMaxLevel(dims);
+  VTKM_TEST_ASSERT(nLevels == 4, "Wrong maximum level");
+
+  vtkm::cont::ArrayHandle<vtkm::Float64> coeffArray;
+  vtkm::cont::ArrayCopy(inputArray, coeffArray);
+  lifting.Decompose3D(coeffArray, dims, nLevels);
+
+  // A smooth signal has small detail coefficients.
+  vtkm::Float64 maxDetail = vtkm::Abs(vtkm::cont::ArrayGetValue(dims[0] - 1, coeffArray));
+  VTKM_TEST_ASSERT(maxDetail < 1.0, "Detail coefficient too large: ", maxDetail);
+
+  lifting.Reconstruct3D(coeffArray, dims, nLevels);
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(coeffArray, inputArray),
+                   "Lifting transform did not reconstruct the signal");
+}
+
+void TestBitPlaneCoder()
+{
+  std::cout << "Testing bit plane coder" << std::endl;
+  vtkm::Id sigLen = 1000;
+  vtkm::cont::ArrayHandle<vtkm::Float64> inputArray;
+  inputArray.Allocate(sigLen);
+  auto wp = inputArray.WritePortal();
+  for (vtkm::Id i = 0; i < sigLen; i++)
+  {
+    // The second half is zero, like thresholded detail coefficients.
+    wp.Set(i, i >= sigLen / 2 ? 0.0 : 100.0 * vtkm::Sin(static_cast<vtkm::Float64>(i)));
+  }
+
+  vtkm::worklet::wavelets::BitPlaneCoder coder;
+  vtkm::worklet::wavelets::BitPlaneCoder::Transform transform;
+  transform.Wavelet = vtkm::worklet::wavelets::CDF5_3;
+  transform.Levels = 2;
+  transform.Dimensions = vtkm::Id3(10, 10, 10);
+  vtkm::cont::ArrayHandle<vtkm::Int64> stream = coder.Encode(inputArray, 40, transform);
+  // Words holding only zeros are not stored.
+  VTKM_TEST_ASSERT(stream.GetNumberOfValues() < 41 * (sigLen / 64 + 1) * 2 / 3,
+                   "Zero words were stored");
+
+  vtkm::Float64 lastError = vtkm::Infinity64();
+  for (vtkm::Id numPlanes : { 4, 8, 16, 40 })
+  {
+    vtkm::cont::ArrayHandle<vtkm::Float64> decoded;
+    coder.Decode(stream, decoded, numPlanes);
+
+    vtkm::cont::ArrayHandle<vtkm::Float64> decodedTruncated;
+    vtkm::cont::ArrayHandle<vtkm::Int64> truncated = coder.Truncate(stream, numPlanes);
+    coder.Decode(truncated, decodedTruncated);
+    auto truncatedTransform = vtkm::worklet::wavelets::BitPlaneCoder::GetTransform(truncated);
+    VTKM_TEST_ASSERT(truncatedTransform.Wavelet == transform.Wavelet &&
+                       truncatedTransform.Levels == transform.Levels &&
+                       truncatedTransform.Dimensions == transform.Dimensions,
+                     "Transform not kept in truncated stream");
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(decoded, decodedTruncated),
+                     "Truncated stream decoded differently");
+
+    vtkm::Float64 maxError = 0;
+    auto decodedPortal = decoded.ReadPortal();
+    auto inputPortal = inputArray.ReadPortal();
+    for (vtkm::Id i = 0; i < sigLen; i++)
+    {
+      maxError = vtkm::Max(maxError, vtkm::Abs(decodedPortal.Get(i) - inputPortal.Get(i)));
+      if (i >= sigLen / 2)
+      {
+        VTKM_TEST_ASSERT(decodedPortal.Get(i) == 0, "Zero not preserved");
+      }
+    }
+    VTKM_TEST_ASSERT(maxError <= 100.0 / static_cast<vtkm::Float64>(vtkm::Id(1) << numPlanes),
+                     "Error too large for ",
+                     numPlanes,
+                     " planes: ",
+                     maxError);
+    VTKM_TEST_ASSERT(maxError < lastError, "Error did not decrease with more planes");
+    lastError = maxError;
+  }
+}
+
 void TestWaveletCompressor()
 {
   vtkm::Float64 cratio = 2.0; // X:1 compression, where X >= 1
   TestDecomposeReconstruct1D(cratio);
   TestDecomposeReconstruct2D(cratio);
   TestDecomposeReconstruct3D(cratio);
+  TestSelectAbs();
+  TestLifting3D(vtkm::worklet::wavelets::CDF9_7);
+  TestLifting3D(vtkm::worklet::wavelets::CDF5_3);
+  TestBitPlaneCoder();
 }
 
 int UnitTestWaveletCompressor(int argc, char* argv[])
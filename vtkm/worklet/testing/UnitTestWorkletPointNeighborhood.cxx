@@ -8,7 +8,9 @@
 //  PURPOSE.  See the above copyright notice for more information.
 //============================================================================
 
+#include <vtkm/worklet/AveragePointNeighborhood.h>
 #include <vtkm/worklet/DispatcherPointNeighborhood.h>
+#include <vtkm/worklet/TiledPointNeighborhood.h>
 #include <vtkm/worklet/WorkletPointNeighborhood.h>
 
 #include <vtkm/worklet/ScatterIdentity.h>
@@ -20,6 +22,7 @@
 #include <vtkm/cont/ArrayHandleUniformPointCoordinates.h>
 #include <vtkm/cont/CellSetStructured.h>
 #include <vtkm/cont/DataSet.h>
+#include <vtkm/cont/DataSetBuilderUniform.h>
 #include <vtkm/cont/DeviceAdapterTag.h>
 #include <vtkm/cont/Invoker.h>
 #include <vtkm/cont/RuntimeDeviceTracker.h>
@@ -218,6 +221,7 @@ static void TestMaxNeighborValue();
 static void TestScatterIdentityNeighbor();
 static void TestScatterUnfiormNeighbor();
 static void TestIndexing();
+static void TestTiledExecution();
 
 void TestWorkletPointNeighborhood(vtkm::cont::DeviceAdapterId id)
 {
@@ -229,6 +233,7 @@ void TestWorkletPointNeighborhood(vtkm::cont::DeviceAdapterId id)
   TestScatterIdentityNeighbor();
   TestScatterUnfiormNeighbor();
   TestIndexing();
+  TestTiledExecution();
 }
 
 static void TestMaxNeighborValue()
@@ -348,6 +353,56 @@ static void TestIndexing()
   }
 }
 
+static void TestTiledExecution()
+{
+  std::cout << "Testing tiled execution of PointNeighborhood worklets." << std::endl;
+
+  vtkm::cont::testing::MakeTestDataSet testDataSet;
+  vtkm::cont::Invoker invoke;
+  ::test_pointneighborhood::MaxNeighborValue maxNeighbor;
+
+  vtkm::cont::DataSet dataSet3D = testDataSet.Make3DUniformDataSet0();
+  vtkm::cont::ArrayHandle<vtkm::Float32> field3D;
+  dataSet3D.GetField("pointvar").GetData().AsArrayHandle(field3D);
+  vtkm::cont::ArrayHandle<vtkm::Float32> expected;
+  vtkm::cont::ArrayHandle<vtkm::Float32> output;
+  invoke(maxNeighbor, field3D, dataSet3D.GetCellSet(), expected);
+  vtkm::worklet::InvokeTiledPointNeighborhood(
+    invoke, maxNeighbor, 1, dataSet3D.GetCellSet(), field3D, output);
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(output, expected), "Wrong tiled 3D result");
+
+  vtkm::cont::DataSet dataSet2D = testDataSet.Make2DUniformDataSet1();
+  vtkm::cont::ArrayHandle<vtkm::Float32> field2D;
+  dataSet2D.GetField("pointvar").GetData().AsArrayHandle(field2D);
+  invoke(maxNeighbor, field2D, dataSet2D.GetCellSet(), expected);
+  vtkm::worklet::InvokeTiledPointNeighborhood(
+    invoke, maxNeighbor, 1, dataSet2D.GetCellSet(), field2D, output);
+  VTKM_TEST_ASSERT(test_equal_ArrayHandles(output, expected), "Wrong tiled 2D result");
+
+  // Large enough for several tiles along each axis, including partial ones.
+  const vtkm::Id3 dims(70, 23, 19);
+  vtkm::cont::DataSet dataSet = vtkm::cont::DataSetBuilderUniform::Create(dims);
+  std::vector<vtkm::Float64> values(static_cast<std::size_t>(dims[0] * dims[1] * dims[2]));
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    values[i] = static_cast<vtkm::Float64>((i * 7919) % 1009);
+  }
+  vtkm::cont::ArrayHandle<vtkm::Float64> field =
+    vtkm::cont::make_ArrayHandle(values, vtkm::CopyFlag::Off);
+  for (vtkm::IdComponent radius : { 1, 3, 7 })
+  {
+    vtkm::worklet::AveragePointNeighborhood average(radius);
+    vtkm::cont::ArrayHandle<vtkm::Float64> averageExpected;
+    vtkm::cont::ArrayHandle<vtkm::Float64> averageOutput;
+    invoke(average, dataSet.GetCellSet(), field, averageExpected);
+    vtkm::worklet::InvokeTiledPointNeighborhood(
+      invoke, average, radius, dataSet.GetCellSet(), field, averageOutput);
+    VTKM_TEST_ASSERT(test_equal_ArrayHandles(averageOutput, averageExpected),
+                     "Wrong tiled average with radius ",
+                     radius);
+  }
+}
+
 } // anonymous namespace
 
 int UnitTestWorkletPointNeighborhood(int argc, char* argv[])
@@ -0,0 +1,554 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_wavelets_bitplanecoder_h
+#define vtk_m_worklet_wavelets_bitplanecoder_h
+
+#include <vtkm/cont/Algorithm.h>
+#include <vtkm/cont/ArrayGetValues.h>
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ArrayHandleTransform.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Invoker.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+#include <vtkm/worklet/wavelets/WaveletFilter.h>
+
+#include <vtkm/Math.h>
+
+#include <cstring>
+#include <vector>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace wavelets
+{
+
+// Packs the sign plane and the magnitude bit planes of quantized coefficients into words.
+// Each invocation builds one word of one plane from 64 coefficients, so no two invocations
+// write the same word.
+class BitPlaneEncode : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn wordIndex, WholeArrayIn coeffs, FieldOut word);
+  using ExecutionSignature = _3(_1, _2);
+  using InputDomain = _1;
+
+  BitPlaneEncode(vtkm::Id numCoeffs, vtkm::Id numPlanes, vtkm::Float64 scale)
+    : NumberOfCoefficients(numCoeffs)
+    , NumberOfPlanes(numPlanes)
+    , WordsPerPlane((numCoeffs + 63) / 64)
+    , Scale(scale)
+  {
+  }
+
+  template <typename CoeffPortalType>
+  VTKM_EXEC vtkm::Int64 operator()(const vtkm::Id& wordIndex, const CoeffPortalType& coeffs) const
+  {
+    // Plane 0 holds the signs. Planes 1 to NumberOfPlanes hold the magnitudes, most
+    // significant bit first.
+    const vtkm::Id plane = wordIndex / this->WordsPerPlane;
+    const vtkm::Id first = (wordIndex % this->WordsPerPlane) * 64;
+    const vtkm::Id count = vtkm::Min(vtkm::Id(64), this->NumberOfCoefficients - first);
+    vtkm::UInt64 word = 0;
+    for (vtkm::Id bit = 0; bit < count; ++bit)
+    {
+      const vtkm::Float64 coeff = static_cast<vtkm::Float64>(coeffs.Get(first + bit));
+      vtkm::UInt64 value;
+      if (plane == 0)
+      {
+        value = coeff < 0 ? 1 : 0;
+      }
+      else
+      {
+        value = (this->Quantize(coeff) >> (this->NumberOfPlanes - plane)) & 1;
+      }
+      word |= value << bit;
+    }
+    return static_cast<vtkm::Int64>(word);
+  }
+
+private:
+  vtkm::Id NumberOfCoefficients;
+  vtkm::Id NumberOfPlanes;
+  vtkm::Id WordsPerPlane;
+  vtkm::Float64 Scale;
+
+  VTKM_EXEC vtkm::UInt64 Quantize(vtkm::Float64 coeff) const
+  {
+    const vtkm::UInt64 maxValue = (vtkm::UInt64(1) << this->NumberOfPlanes) - 1;
+    const vtkm::Float64 scaled = vtkm::Abs(coeff) / this->Scale *
+      static_cast<vtkm::Float64>(vtkm::UInt64(1) << this->NumberOfPlanes);
+    return vtkm::Min(static_cast<vtkm::UInt64>(scaled), maxValue);
+  }
+};
+
+// Rebuilds each coefficient from the sign plane and the first `numPlanes` magnitude planes.
+class BitPlaneDecode : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn coeffIndex, WholeArrayIn words, FieldOut coeff);
+  using ExecutionSignature = void(_1, _2, _3);
+  using InputDomain = _1;
+
+  BitPlaneDecode(vtkm::Id numCoeffs, vtkm::Id numPlanes, vtkm::Float64 scale)
+    : NumberOfPlanes(numPlanes)
+    , WordsPerPlane((numCoeffs + 63) / 64)
+    , Scale(scale)
+  {
+  }
+
+  template <typename WordPortalType, typename CoeffType>
+  VTKM_EXEC void operator()(const vtkm::Id& coeffIndex,
+                            const WordPortalType& words,
+                            CoeffType& coeff) const
+  {
+    const vtkm::Id word = coeffIndex / 64;
+    const vtkm::Id bit = coeffIndex % 64;
+    vtkm::UInt64 magnitude = 0;
+    for (vtkm::Id plane = 1; plane <= this->NumberOfPlanes; ++plane)
+    {
+      const vtkm::UInt64 planeWord =
+        static_cast<vtkm::UInt64>(words.Get(word + plane * this->WordsPerPlane));
+      magnitude = (magnitude << 1) | ((planeWord >> bit) & 1);
+    }
+
+    // Values that are zero in every plane read so far, including thresholded coefficients,
+    // stay zero. Others are placed at the middle of their quantization interval.
+    vtkm::Float64 value = 0;
+    if (magnitude != 0)
+    {
+      value = (static_cast<vtkm::Float64>(magnitude) + 0.5) * this->Scale /
+        static_cast<vtkm::Float64>(vtkm::UInt64(1) << this->NumberOfPlanes);
+      if ((static_cast<vtkm::UInt64>(words.Get(word)) >> bit) & 1)
+      {
+        value = -value;
+      }
+    }
+    coeff = static_cast<CoeffType>(value);
+  }
+
+private:
+  vtkm::Id NumberOfPlanes;
+  vtkm::Id WordsPerPlane;
+  vtkm::Float64 Scale;
+};
+
+// Builds the bitmap of the nonzero words of each plane. Each invocation builds one word of the
+// bitmap of one plane from 64 plane words.
+class BitPlaneMask : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn maskIndex, WholeArrayIn planeWords, FieldOut mask);
+  using ExecutionSignature = _3(_1, _2);
+  using InputDomain = _1;
+
+  BitPlaneMask(vtkm::Id wordsPerPlane)
+    : WordsPerPlane(wordsPerPlane)
+    , MasksPerPlane((wordsPerPlane + 63) / 64)
+  {
+  }
+
+  template <typename WordPortalType>
+  VTKM_EXEC vtkm::Int64 operator()(const vtkm::Id& maskIndex, const WordPortalType& words) const
+  {
+    const vtkm::Id plane = maskIndex / this->MasksPerPlane;
+    const vtkm::Id first = (maskIndex % this->MasksPerPlane) * 64;
+    const vtkm::Id count = vtkm::Min(vtkm::Id(64), this->WordsPerPlane - first);
+    vtkm::UInt64 mask = 0;
+    for (vtkm::Id bit = 0; bit < count; ++bit)
+    {
+      if (words.Get(plane * this->WordsPerPlane + first + bit) != 0)
+      {
+        mask |= vtkm::UInt64(1) << bit;
+      }
+    }
+    return static_cast<vtkm::Int64>(mask);
+  }
+
+private:
+  vtkm::Id WordsPerPlane;
+  vtkm::Id MasksPerPlane;
+};
+
+// Writes each nonzero plane word to its place in the stream. `rank` is the number of nonzero
+// words before it.
+class BitPlaneCompact : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn word, FieldIn rank, WholeArrayOut stream);
+  using ExecutionSignature = void(_1, _2, _3, WorkIndex);
+  using InputDomain = _1;
+
+  BitPlaneCompact(vtkm::Id wordsPerPlane, vtkm::Id headerSize)
+    : WordsPerPlane(wordsPerPlane)
+    , MasksPerPlane((wordsPerPlane + 63) / 64)
+    , HeaderSize(headerSize)
+  {
+  }
+
+  template <typename StreamPortalType>
+  VTKM_EXEC void operator()(const vtkm::Int64& word,
+                            const vtkm::Id& rank,
+                            const StreamPortalType& stream,
+                            const vtkm::Id& index) const
+  {
+    if (word != 0)
+    {
+      // The words of a plane follow its bitmap, and the bitmaps of all previous planes.
+      const vtkm::Id plane = index / this->WordsPerPlane;
+      stream.Set(this->HeaderSize + (plane + 1) * this->MasksPerPlane + rank, word);
+    }
+  }
+
+private:
+  vtkm::Id WordsPerPlane;
+  vtkm::Id MasksPerPlane;
+  vtkm::Id HeaderSize;
+};
+
+// Reads from the bitmaps whether each plane word is nonzero.
+class BitPlaneFlags : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature =
+    void(FieldIn index, WholeArrayIn stream, WholeArrayIn planeStarts, FieldOut flag);
+  using ExecutionSignature = _4(_1, _2, _3);
+  using InputDomain = _1;
+
+  BitPlaneFlags(vtkm::Id wordsPerPlane, vtkm::Id headerSize)
+    : WordsPerPlane(wordsPerPlane)
+    , MasksPerPlane((wordsPerPlane + 63) / 64)
+    , HeaderSize(headerSize)
+  {
+  }
+
+  template <typename StreamPortalType, typename StartsPortalType>
+  VTKM_EXEC vtkm::Id operator()(const vtkm::Id& index,
+                                const StreamPortalType& stream,
+                                const StartsPortalType& planeStarts) const
+  {
+    const vtkm::Id plane = index / this->WordsPerPlane;
+    const vtkm::Id word = index % this->WordsPerPlane;
+    const vtkm::Id maskStart =
+      this->HeaderSize + plane * this->MasksPerPlane + planeStarts.Get(plane);
+    const vtkm::UInt64 mask = static_cast<vtkm::UInt64>(stream.Get(maskStart + word / 64));
+    return static_cast<vtkm::Id>((mask >> (word % 64)) & 1);
+  }
+
+private:
+  vtkm::Id WordsPerPlane;
+  vtkm::Id MasksPerPlane;
+  vtkm::Id HeaderSize;
+};
+
+// Reads each plane word back from the stream, or zero if it was not stored.
+class BitPlaneExpand : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn flag, FieldIn rank, WholeArrayIn stream, FieldOut word);
+  using ExecutionSignature = _4(_1, _2, _3, WorkIndex);
+  using InputDomain = _1;
+
+  BitPlaneExpand(vtkm::Id wordsPerPlane, vtkm::Id headerSize)
+    : WordsPerPlane(wordsPerPlane)
+    , MasksPerPlane((wordsPerPlane + 63) / 64)
+    , HeaderSize(headerSize)
+  {
+  }
+
+  template <typename StreamPortalType>
+  VTKM_EXEC vtkm::Int64 operator()(const vtkm::Id& flag,
+                                   const vtkm::Id& rank,
+                                   const StreamPortalType& stream,
+                                   const vtkm::Id& index) const
+  {
+    if (!flag)
+    {
+      return 0;
+    }
+    const vtkm::Id plane = index / this->WordsPerPlane;
+    return stream.Get(this->HeaderSize + (plane + 1) * this->MasksPerPlane + rank);
+  }
+
+private:
+  vtkm::Id WordsPerPlane;
+  vtkm::Id MasksPerPlane;
+  vtkm::Id HeaderSize;
+};
+
+// Encodes an array of coefficients as a progressive stream of bit planes.
+//
+// Describes the wavelet transform of the coefficients in a bit plane stream, so that the
+// stream can be reconstructed without knowing how it was compressed.
+struct BitPlaneTransform
+{
+  vtkm::worklet::wavelets::WaveletName Wavelet = vtkm::worklet::wavelets::CDF9_7;
+  vtkm::Id Levels = 0;
+  vtkm::Id3 Dimensions = vtkm::Id3(0);
+};
+
+// The magnitudes of the coefficients are quantized relative to the largest magnitude and
+// stored one bit plane after another, most significant plane first, after a plane of signs.
+// Any prefix of the stream that ends on a plane boundary can be decoded, giving a coarser
+// approximation of the coefficients. So a stream can be truncated to fit a storage budget, or
+// read only partially to get a fast preview, without encoding it again.
+//
+// Only the 64-bit words of a plane that have a bit set are stored, after a bitmap of which
+// words these are. The high planes hold only the largest coefficients, and coefficients that
+// were thresholded to zero are zero in every plane, so most words of a plane are usually
+// skipped. Finding where each word goes is a scan, so encoding and decoding are parallel.
+//
+// The stream is an array of 64-bit words, like the ZFP streams. It starts with a header
+// holding the number of magnitude planes P, the number of coefficients, the quantization
+// scale, the wavelet transform that produced the coefficients (wavelet, number of levels and
+// three dimensions), and then P + 2 values giving the number of stored words before each plane.
+class BitPlaneCoder
+{
+public:
+  static constexpr vtkm::Id MaxPlanes = 62;
+
+  using Transform = vtkm::worklet::wavelets::BitPlaneTransform;
+
+  static vtkm::Id GetHeaderSize(vtkm::Id numPlanes) { return 8 + numPlanes + 2; }
+
+  template <typename CoeffArrayType>
+  vtkm::cont::ArrayHandle<vtkm::Int64> Encode(const CoeffArrayType& coeffs,
+                                              vtkm::Id numPlanes,
+                                              const Transform& transform = Transform{})
+  {
+    if (numPlanes < 1 || numPlanes > MaxPlanes)
+    {
+      throw vtkm::cont::ErrorBadValue("Number of bit planes must be between 1 and 62.");
+    }
+    const vtkm::Id numCoeffs = coeffs.GetNumberOfValues();
+    const vtkm::Id wordsPerPlane = (numCoeffs + 63) / 64;
+    const vtkm::Id masksPerPlane = (wordsPerPlane + 63) / 64;
+    const vtkm::Id numWords = (numPlanes + 1) * wordsPerPlane;
+    vtkm::Float64 scale = static_cast<vtkm::Float64>(
+      vtkm::cont::Algorithm::Reduce(coeffs, typename CoeffArrayType::ValueType(0), MaxAbs{}));
+    if (scale == 0)
+    {
+      scale = 1;
+    }
+
+    vtkm::cont::Invoker invoke;
+    vtkm::cont::ArrayHandle<vtkm::Int64> planes;
+    invoke(BitPlaneEncode(numCoeffs, numPlanes, scale),
+           vtkm::cont::ArrayHandleIndex(numWords),
+           coeffs,
+           planes);
+
+    vtkm::cont::ArrayHandle<vtkm::Id> ranks;
+    const vtkm::Id numStored = vtkm::cont::Algorithm::ScanExclusive(
+      vtkm::cont::make_ArrayHandleTransform(planes, NonZero{}), ranks);
+    std::vector<vtkm::Id> planeStartIndices;
+    for (vtkm::Id plane = 0; plane <= numPlanes; ++plane)
+    {
+      planeStartIndices.push_back(plane * wordsPerPlane);
+    }
+    std::vector<vtkm::Id> planeStarts;
+    vtkm::cont::ArrayGetValues(planeStartIndices, ranks, planeStarts);
+    planeStarts.push_back(numStored);
+
+    const vtkm::Id headerSize = GetHeaderSize(numPlanes);
+    vtkm::cont::ArrayHandle<vtkm::Int64> stream;
+    stream.Allocate(headerSize + (numPlanes + 1) * masksPerPlane + numStored);
+    {
+      auto header = stream.WritePortal();
+      header.Set(0, numPlanes);
+      header.Set(1, numCoeffs);
+      header.Set(2, ToBits(scale));
+      WriteTransform(header, transform);
+      for (std::size_t plane = 0; plane < planeStarts.size(); ++plane)
+      {
+        header.Set(8 + static_cast<vtkm::Id>(plane), planeStarts[plane]);
+      }
+    }
+
+    vtkm::cont::ArrayHandle<vtkm::Int64> masks;
+    invoke(BitPlaneMask(wordsPerPlane),
+           vtkm::cont::ArrayHandleIndex((numPlanes + 1) * masksPerPlane),
+           planes,
+           masks);
+    for (vtkm::Id plane = 0; plane <= numPlanes; ++plane)
+    {
+      vtkm::cont::Algorithm::CopySubRange(masks,
+                                          plane * masksPerPlane,
+                                          masksPerPlane,
+                                          stream,
+                                          headerSize + plane * masksPerPlane +
+                                            planeStarts[static_cast<std::size_t>(plane)]);
+    }
+    invoke(BitPlaneCompact(wordsPerPlane, headerSize), planes, ranks, stream);
+    return stream;
+  }
+
+  // Decodes the coefficients from the first `numPlanes` magnitude planes of a stream. A value
+  // of 0, or a value larger than the number of planes in the stream, uses every plane. The
+  // stream may be truncated after the last plane that is read.
+  template <typename CoeffType>
+  void Decode(const vtkm::cont::ArrayHandle<vtkm::Int64>& stream,
+              vtkm::cont::ArrayHandle<CoeffType>& coeffs,
+              vtkm::Id numPlanes = 0)
+  {
+    Header header = ReadHeader(stream);
+    if (numPlanes <= 0 || numPlanes > header.NumberOfPlanes)
+    {
+      numPlanes = header.NumberOfPlanes;
+    }
+    const vtkm::Id wordsPerPlane = (header.NumberOfCoefficients + 63) / 64;
+    const vtkm::Id masksPerPlane = (wordsPerPlane + 63) / 64;
+    const vtkm::Id headerSize = GetHeaderSize(header.NumberOfPlanes);
+    const vtkm::Id numWords = (numPlanes + 1) * wordsPerPlane;
+    if (stream.GetNumberOfValues() < headerSize + (numPlanes + 1) * masksPerPlane +
+          header.PlaneStarts[static_cast<std::size_t>(numPlanes + 1)])
+    {
+      throw vtkm::cont::ErrorBadValue("Bit plane stream is too short for the requested planes.");
+    }
+
+    vtkm::cont::Invoker invoke;
+    vtkm::cont::ArrayHandle<vtkm::Id> flags;
+    invoke(BitPlaneFlags(wordsPerPlane, headerSize),
+           vtkm::cont::ArrayHandleIndex(numWords),
+           stream,
+           vtkm::cont::make_ArrayHandle(header.PlaneStarts, vtkm::CopyFlag::On),
+           flags);
+    vtkm::cont::ArrayHandle<vtkm::Id> ranks;
+    vtkm::cont::Algorithm::ScanExclusive(flags, ranks);
+    vtkm::cont::ArrayHandle<vtkm::Int64> planes;
+    invoke(BitPlaneExpand(wordsPerPlane, headerSize), flags, ranks, stream, planes);
+
+    invoke(BitPlaneDecode(header.NumberOfCoefficients, numPlanes, header.Scale),
+           vtkm::cont::ArrayHandleIndex(header.NumberOfCoefficients),
+           planes,
+           coeffs);
+  }
+
+  // Returns a stream holding only the first `numPlanes` magnitude planes of a stream.
+  static vtkm::cont::ArrayHandle<vtkm::Int64> Truncate(
+    const vtkm::cont::ArrayHandle<vtkm::Int64>& stream,
+    vtkm::Id numPlanes)
+  {
+    Header header = ReadHeader(stream);
+    numPlanes = vtkm::Max(vtkm::Id(1), vtkm::Min(numPlanes, header.NumberOfPlanes));
+    const vtkm::Id wordsPerPlane = (header.NumberOfCoefficients + 63) / 64;
+    const vtkm::Id masksPerPlane = (wordsPerPlane + 63) / 64;
+    const vtkm::Id oldHeaderSize = GetHeaderSize(header.NumberOfPlanes);
+    const vtkm::Id newHeaderSize = GetHeaderSize(numPlanes);
+    const vtkm::Id bodySize = (numPlanes + 1) * masksPerPlane +
+      header.PlaneStarts[static_cast<std::size_t>(numPlanes + 1)];
+
+    vtkm::cont::ArrayHandle<vtkm::Int64> truncated;
+    truncated.Allocate(newHeaderSize + bodySize);
+    vtkm::cont::Algorithm::CopySubRange(stream, oldHeaderSize, bodySize, truncated, newHeaderSize);
+    auto portal = truncated.WritePortal();
+    portal.Set(0, numPlanes);
+    portal.Set(1, header.NumberOfCoefficients);
+    portal.Set(2, ToBits(header.Scale));
+    WriteTransform(portal, header.WaveletTransform);
+    for (vtkm::Id plane = 0; plane <= numPlanes + 1; ++plane)
+    {
+      portal.Set(8 + plane, header.PlaneStarts[static_cast<std::size_t>(plane)]);
+    }
+    return truncated;
+  }
+
+  // Returns the wavelet transform recorded in the header of a stream.
+  static Transform GetTransform(const vtkm::cont::ArrayHandle<vtkm::Int64>& stream)
+  {
+    return ReadHeader(stream).WaveletTransform;
+  }
+
+private:
+  struct Header
+  {
+    vtkm::Id NumberOfPlanes;
+    vtkm::Id NumberOfCoefficients;
+    vtkm::Float64 Scale;
+    Transform WaveletTransform;
+    std::vector<vtkm::Id> PlaneStarts;
+  };
+
+  template <typename PortalType>
+  static void WriteTransform(const PortalType& portal, const Transform& transform)
+  {
+    portal.Set(3, static_cast<vtkm::Int64>(transform.Wavelet));
+    portal.Set(4, transform.Levels);
+    for (vtkm::IdComponent dim = 0; dim < 3; ++dim)
+    {
+      portal.Set(5 + dim, transform.Dimensions[dim]);
+    }
+  }
+
+  static Header ReadHeader(const vtkm::cont::ArrayHandle<vtkm::Int64>& stream)
+  {
+    Header header;
+    const vtkm::Id streamSize = stream.GetNumberOfValues();
+    auto portal = stream.ReadPortal();
+    if (streamSize < 8 || portal.Get(0) < 1 || portal.Get(0) > MaxPlanes ||
+        streamSize < GetHeaderSize(portal.Get(0)))
+    {
+      throw vtkm::cont::ErrorBadValue("Bit plane stream has no valid header.");
+    }
+    header.NumberOfPlanes = portal.Get(0);
+    header.NumberOfCoefficients = portal.Get(1);
+    header.Scale = FromBits(portal.Get(2));
+    header.WaveletTransform.Wavelet =
+      static_cast<vtkm::worklet::wavelets::WaveletName>(portal.Get(3));
+    header.WaveletTransform.Levels = portal.Get(4);
+    for (vtkm::IdComponent dim = 0; dim < 3; ++dim)
+    {
+      header.WaveletTransform.Dimensions[dim] = portal.Get(5 + dim);
+    }
+    for (vtkm::Id plane = 0; plane <= header.NumberOfPlanes + 1; ++plane)
+    {
+      header.PlaneStarts.push_back(portal.Get(8 + plane));
+    }
+    return header;
+  }
+
+  static vtkm::Int64 ToBits(vtkm::Float64 value)
+  {
+    vtkm::Int64 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+  }
+
+  static vtkm::Float64 FromBits(vtkm::Int64 bits)
+  {
+    vtkm::Float64 value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+  }
+
+  struct MaxAbs
+  {
+    template <typename T>
+    VTKM_EXEC_CONT T operator()(const T& x, const T& y) const
+    {
+      return vtkm::Max(vtkm::Abs(x), vtkm::Abs(y));
+    }
+  };
+
+  struct NonZero
+  {
+    VTKM_EXEC_CONT vtkm::Id operator()(vtkm::Int64 word) const { return word != 0 ? 1 : 0; }
+  };
+};
+
+} // namespace wavelets
+} // namespace worklet
+} // namespace vtkm
+
+#endif // vtk_m_worklet_wavelets_bitplanecoder_h
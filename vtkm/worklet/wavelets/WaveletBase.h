@@ -197,6 +197,45 @@ public:
     vtkm::cont::Algorithm::Sort(array, SortLessAbsFunctor());
   }
 
+  // Find the absolute value that has index n when the array is sorted by absolute value,
+  // without sorting the array. This is a radix select that looks at 16 bits of the values at a
+  // time, so it makes 2 passes over a Float32 array and 4 passes over a Float64 array.
+  template <typename ArrayType>
+  vtkm::Float64 DeviceSelectAbs(const ArrayType& array, vtkm::Id n)
+  {
+    using ValueType = typename ArrayType::ValueType;
+    using BitsType = AbsBits<ValueType>;
+    using HistogramType = vtkm::worklet::wavelets::AbsRadixHistogram;
+    VTKM_ASSERT(n >= 0 && n < array.GetNumberOfValues());
+
+    vtkm::UInt64 prefix = 0;
+    vtkm::UInt64 prefixMask = 0;
+    vtkm::cont::ArrayHandle<vtkm::Id> bins;
+    for (vtkm::Id shift = 8 * sizeof(typename BitsType::Type) - HistogramType::DigitBits;
+         shift >= 0;
+         shift -= HistogramType::DigitBits)
+    {
+      bins.AllocateAndFill(HistogramType::NumberOfBins, 0);
+      HistogramType histogram(prefix, prefixMask, shift);
+      vtkm::worklet::DispatcherMapField<HistogramType> dispatcher(histogram);
+      dispatcher.Invoke(array, bins);
+
+      // Find the bin holding the value and the rank of the value within that bin.
+      auto binsPortal = bins.ReadPortal();
+      vtkm::UInt64 digit = 0;
+      while (n >= binsPortal.Get(static_cast<vtkm::Id>(digit)))
+      {
+        n -= binsPortal.Get(static_cast<vtkm::Id>(digit));
+        ++digit;
+      }
+      prefix |= digit << shift;
+      prefixMask |= vtkm::UInt64(HistogramType::NumberOfBins - 1) << shift;
+    }
+
+    return static_cast<vtkm::Float64>(
+      BitsType::ToValue(static_cast<typename BitsType::Type>(prefix)));
+  }
+
   // Reduce to the sum of all values on device
   template <typename ArrayType>
   typename ArrayType::ValueType DeviceSum(const ArrayType& array)
@@ -0,0 +1,359 @@
+//============================================================================
+//  Copyright (c) Kitware, Inc.
+//  All rights reserved.
+//  See LICENSE.txt for details.
+//
+//  This software is distributed WITHOUT ANY WARRANTY; without even
+//  the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+//  PURPOSE.  See the above copyright notice for more information.
+//============================================================================
+
+#ifndef vtk_m_worklet_wavelets_waveletlifting_h
+#define vtk_m_worklet_wavelets_waveletlifting_h
+
+#include <vtkm/worklet/wavelets/WaveletFilter.h>
+
+#include <vtkm/cont/ArrayHandle.h>
+#include <vtkm/cont/ArrayHandleIndex.h>
+#include <vtkm/cont/ErrorBadValue.h>
+#include <vtkm/cont/Invoker.h>
+
+#include <vtkm/worklet/WorkletMapField.h>
+
+#include <vtkm/Math.h>
+
+namespace vtkm
+{
+namespace worklet
+{
+namespace wavelets
+{
+
+// Lifting factorization of a biorthogonal wavelet: a sequence of predict (odd samples) and
+// update (even samples) steps followed by a scaling of the even and odd samples.
+struct LiftingScheme
+{
+  static constexpr vtkm::IdComponent MaxSteps = 4;
+
+  vtkm::IdComponent NumberOfSteps = 0;
+  vtkm::Float64 Steps[MaxSteps] = { 0, 0, 0, 0 };
+  vtkm::Float64 EvenScale = 1;
+  vtkm::Float64 OddScale = 1;
+};
+
+// A 1D lifting transform of lines of a 3D array, in place. Each invocation transforms one
+// line of the region [0, lenX) x [0, lenY) x [0, lenZ) of an array with dimensions
+// dimX x dimY x dimZ along the given axis. The coefficients of a line are stored as in
+// WaveletDWT: the approximation coefficients first, followed by the detail coefficients.
+//
+// The samples are extended symmetrically at the ends of the line (whole point symmetry),
+// matching the SYMW extension of the convolution transform.
+class LiftingTransform3D : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn lineIndex, WholeArrayInOut data, WholeArrayInOut scratch);
+  using ExecutionSignature = void(_1, _2, _3);
+  using InputDomain = _1;
+
+  LiftingTransform3D(const LiftingScheme& scheme,
+                     vtkm::Id3 dims,
+                     vtkm::Id3 lens,
+                     vtkm::IdComponent axis,
+                     bool inverse)
+    : Scheme(scheme)
+    , Inverse(inverse)
+  {
+    const vtkm::Id strides[3] = { 1, dims[0], dims[0] * dims[1] };
+    this->Stride = strides[axis];
+    this->Length = lens[axis];
+    // The other two axes enumerate the lines.
+    const vtkm::IdComponent axis1 = axis == 0 ? 1 : 0;
+    const vtkm::IdComponent axis2 = axis == 2 ? 1 : 2;
+    this->LineLength1 = lens[axis1];
+    this->LineStride1 = strides[axis1];
+    this->LineStride2 = strides[axis2];
+  }
+
+  template <typename DataPortalType, typename ScratchPortalType>
+  VTKM_EXEC void operator()(const vtkm::Id& lineIndex,
+                            const DataPortalType& data,
+                            const ScratchPortalType& scratch) const
+  {
+    const vtkm::Id start = (lineIndex % this->LineLength1) * this->LineStride1 +
+      (lineIndex / this->LineLength1) * this->LineStride2;
+    if (this->Length < 2)
+    {
+      return;
+    }
+    if (this->Inverse)
+    {
+      this->Interleave(start, data, scratch);
+      this->Scale(start, data, 1.0 / this->Scheme.EvenScale, 1.0 / this->Scheme.OddScale);
+      for (vtkm::IdComponent step = this->Scheme.NumberOfSteps - 1; step >= 0; --step)
+      {
+        this->Lift(start, data, step % 2 == 0, -this->Scheme.Steps[step]);
+      }
+    }
+    else
+    {
+      for (vtkm::IdComponent step = 0; step < this->Scheme.NumberOfSteps; ++step)
+      {
+        this->Lift(start, data, step % 2 == 0, this->Scheme.Steps[step]);
+      }
+      this->Scale(start, data, this->Scheme.EvenScale, this->Scheme.OddScale);
+      this->Deinterleave(start, data, scratch);
+    }
+  }
+
+private:
+  LiftingScheme Scheme;
+  bool Inverse;
+  vtkm::Id Stride;
+  vtkm::Id Length;
+  vtkm::Id LineLength1;
+  vtkm::Id LineStride1;
+  vtkm::Id LineStride2;
+
+  // Adds `weight` times the sum of the neighbors to every odd (predict) or even (update) sample.
+  template <typename DataPortalType>
+  VTKM_EXEC void Lift(vtkm::Id start,
+                      const DataPortalType& data,
+                      bool odd,
+                      vtkm::Float64 weight) const
+  {
+    using ValueType = typename DataPortalType::ValueType;
+    const vtkm::Id last = this->Length - 1;
+    for (vtkm::Id i = odd ? 1 : 0; i <= last; i += 2)
+    {
+      // Whole point symmetric extension: x[-1] = x[1] and x[n] = x[n - 2].
+      const vtkm::Id left = i > 0 ? i - 1 : 1;
+      const vtkm::Id right = i < last ? i + 1 : last - 1;
+      const vtkm::Float64 leftValue =
+        static_cast<vtkm::Float64>(data.Get(start + left * this->Stride));
+      const vtkm::Float64 rightValue =
+        static_cast<vtkm::Float64>(data.Get(start + right * this->Stride));
+      const vtkm::Id index = start + i * this->Stride;
+      data.Set(index,
+               static_cast<ValueType>(static_cast<vtkm::Float64>(data.Get(index)) +
+                                      weight * (leftValue + rightValue)));
+    }
+  }
+
+  template <typename DataPortalType>
+  VTKM_EXEC void Scale(vtkm::Id start,
+                       const DataPortalType& data,
+                       vtkm::Float64 evenScale,
+                       vtkm::Float64 oddScale) const
+  {
+    using ValueType = typename DataPortalType::ValueType;
+    for (vtkm::Id i = 0; i < this->Length; ++i)
+    {
+      const vtkm::Id index = start + i * this->Stride;
+      data.Set(index,
+               static_cast<ValueType>(static_cast<vtkm::Float64>(data.Get(index)) *
+                                      (i % 2 == 0 ? evenScale : oddScale)));
+    }
+  }
+
+  // The scratch array has the size of the data array, and lines do not overlap, so each line
+  // can use the scratch values at the same indices as its data.
+  template <typename DataPortalType, typename ScratchPortalType>
+  VTKM_EXEC void Deinterleave(vtkm::Id start,
+                              const DataPortalType& data,
+                              const ScratchPortalType& scratch) const
+  {
+    const vtkm::Id numApprox = (this->Length + 1) / 2;
+    for (vtkm::Id i = 0; i < this->Length; ++i)
+    {
+      scratch.Set(start + i * this->Stride, data.Get(start + i * this->Stride));
+    }
+    for (vtkm::Id i = 0; i < this->Length; ++i)
+    {
+      const vtkm::Id target = i % 2 == 0 ? i / 2 : numApprox + i / 2;
+      data.Set(start + target * this->Stride, scratch.Get(start + i * this->Stride));
+    }
+  }
+
+  template <typename DataPortalType, typename ScratchPortalType>
+  VTKM_EXEC void Interleave(vtkm::Id start,
+                            const DataPortalType& data,
+                            const ScratchPortalType& scratch) const
+  {
+    const vtkm::Id numApprox = (this->Length + 1) / 2;
+    for (vtkm::Id i = 0; i < this->Length; ++i)
+    {
+      scratch.Set(start + i * this->Stride, data.Get(start + i * this->Stride));
+    }
+    for (vtkm::Id i = 0; i < this->Length; ++i)
+    {
+      const vtkm::Id source = i % 2 == 0 ? i / 2 : numApprox + i / 2;
+      data.Set(start + i * this->Stride, scratch.Get(start + source * this->Stride));
+    }
+  }
+};
+
+// Multi-level 3D wavelet transform computed in place with the lifting scheme.
+//
+// Unlike WaveletCompressor::WaveDecompose3D, which convolves with the filter banks and writes
+// each level and dimension to new arrays, this transform overwrites its input and needs only
+// one scratch array of the size of the input. The scratch array is kept between calls, so
+// transforming many arrays of the same size allocates it once. The coefficients of a level are
+// laid out as in WaveDecompose3D, with the approximation coefficients in the low corner of the
+// array.
+class WaveletLifting
+{
+public:
+  WaveletLifting(WaveletName name)
+    : Scheme(MakeScheme(name))
+  {
+  }
+
+  // Returns the largest number of levels that still leaves 2 samples in every dimension of
+  // the coarsest level.
+  static vtkm::Id GetMaxLevel(vtkm::Id3 dims)
+  {
+    vtkm::Id levels = 0;
+    vtkm::Id3 lens = dims;
+    while (lens[0] >= 2 && lens[1] >= 2 && lens[2] >= 2)
+    {
+      ++levels;
+      lens = vtkm::Id3((lens[0] + 1) / 2, (lens[1] + 1) / 2, (lens[2] + 1) / 2);
+    }
+    return levels;
+  }
+
+  template <typename T, typename Storage>
+  void Decompose3D(vtkm::cont::ArrayHandle<T, Storage>& data, vtkm::Id3 dims, vtkm::Id nLevels)
+  {
+    this->CheckArguments(data.GetNumberOfValues(), dims, nLevels);
+    vtkm::cont::ArrayHandle<T>& scratch = this->GetScratch<T>(data.GetNumberOfValues());
+
+    vtkm::Id3 lens = dims;
+    for (vtkm::Id level = 0; level < nLevels; ++level)
+    {
+      for (vtkm::IdComponent axis = 0; axis < 3; ++axis)
+      {
+        this->Transform(data, scratch, dims, lens, axis, false);
+      }
+      lens = vtkm::Id3((lens[0] + 1) / 2, (lens[1] + 1) / 2, (lens[2] + 1) / 2);
+    }
+  }
+
+  template <typename T, typename Storage>
+  void Reconstruct3D(vtkm::cont::ArrayHandle<T, Storage>& data, vtkm::Id3 dims, vtkm::Id nLevels)
+  {
+    this->CheckArguments(data.GetNumberOfValues(), dims, nLevels);
+    vtkm::cont::ArrayHandle<T>& scratch = this->GetScratch<T>(data.GetNumberOfValues());
+
+    std::vector<vtkm::Id3> levelLens(static_cast<std::size_t>(nLevels));
+    vtkm::Id3 lens = dims;
+    for (auto& levelLen : levelLens)
+    {
+      levelLen = lens;
+      lens = vtkm::Id3((lens[0] + 1) / 2, (lens[1] + 1) / 2, (lens[2] + 1) / 2);
+    }
+    for (auto levelLen = levelLens.rbegin(); levelLen != levelLens.rend(); ++levelLen)
+    {
+      for (vtkm::IdComponent axis = 2; axis >= 0; --axis)
+      {
+        this->Transform(data, scratch, dims, *levelLen, axis, true);
+      }
+    }
+  }
+
+  // Releases the scratch array.
+  void ReleaseScratch()
+  {
+    this->Scratch32.ReleaseResources();
+    this->Scratch64.ReleaseResources();
+  }
+
+private:
+  LiftingScheme Scheme;
+  vtkm::cont::ArrayHandle<vtkm::Float32> Scratch32;
+  vtkm::cont::ArrayHandle<vtkm::Float64> Scratch64;
+
+  static LiftingScheme MakeScheme(WaveletName name)
+  {
+    LiftingScheme scheme;
+    if (name == CDF9_7 || name == BIOR4_4)
+    {
+      scheme.NumberOfSteps = 4;
+      scheme.Steps[0] = -1.586134342059924;
+      scheme.Steps[1] = -0.052980118572961;
+      scheme.Steps[2] = 0.882911075530934;
+      scheme.Steps[3] = 0.443506852043971;
+      scheme.EvenScale = 1.149604398860241;
+      scheme.OddScale = 1.0 / 1.149604398860241;
+    }
+    else if (name == CDF5_3 || name == BIOR2_2)
+    {
+      scheme.NumberOfSteps = 2;
+      scheme.Steps[0] = -0.5;
+      scheme.Steps[1] = 0.25;
+    }
+    else
+    {
+      throw vtkm::cont::ErrorBadValue(
+        "The lifting transform supports only the CDF9_7 and CDF5_3 wavelets.");
+    }
+    return scheme;
+  }
+
+  void CheckArguments(vtkm::Id numValues, vtkm::Id3 dims, vtkm::Id nLevels) const
+  {
+    if (numValues != dims[0] * dims[1] * dims[2])
+    {
+      throw vtkm::cont::ErrorBadValue("Array size does not match the dimensions.");
+    }
+    if (nLevels < 0 || nLevels > GetMaxLevel(dims))
+    {
+      throw vtkm::cont::ErrorBadValue("Number of levels of transform is not supported! ");
+    }
+  }
+
+  template <typename T>
+  vtkm::cont::ArrayHandle<T>& GetScratch(vtkm::Id numValues);
+
+  template <typename DataType, typename ScratchType>
+  void Transform(DataType& data,
+                 ScratchType& scratch,
+                 vtkm::Id3 dims,
+                 vtkm::Id3 lens,
+                 vtkm::IdComponent axis,
+                 bool inverse) const
+  {
+    const vtkm::Id numLines = (lens[0] * lens[1] * lens[2]) / lens[axis];
+    vtkm::cont::Invoker invoke;
+    invoke(LiftingTransform3D(this->Scheme, dims, lens, axis, inverse),
+           vtkm::cont::ArrayHandleIndex(numLines),
+           data,
+           scratch);
+  }
+};
+
+template <>
+inline vtkm::cont::ArrayHandle<vtkm::Float32>& WaveletLifting::GetScratch(vtkm::Id numValues)
+{
+  if (this->Scratch32.GetNumberOfValues() != numValues)
+  {
+    this->Scratch32.Allocate(numValues);
+  }
+  return this->Scratch32;
+}
+
+template <>
+inline vtkm::cont::ArrayHandle<vtkm::Float64>& WaveletLifting::GetScratch(vtkm::Id numValues)
+{
+  if (this->Scratch64.GetNumberOfValues() != numValues)
+  {
+    this->Scratch64.Allocate(numValues);
+  }
+  return this->Scratch64;
+}
+
+} // namespace wavelets
+} // namespace worklet
+} // namespace vtkm
+
+#endif // vtk_m_worklet_wavelets_waveletlifting_h
@@ -16,6 +16,8 @@
 
 #include <vtkm/Math.h>
 
+#include <cstring>
+
 namespace vtkm
 {
 namespace worklet
@@ -3145,6 +3147,74 @@ private:
   vtkm::Float64 neg_threshold; // negative
 };
 
+// The bits of the absolute value of a floating point number. For non-negative numbers, the
+// bits compare in the same order as the values, so a value can be found by its bits.
+// The bits are copied with memcpy because reading another member of a union is undefined.
+template <typename T, typename BitsType>
+struct AbsBitsImpl
+{
+  VTKM_STATIC_ASSERT(sizeof(T) == sizeof(BitsType));
+  using Type = BitsType;
+  VTKM_EXEC_CONT static Type Get(T value)
+  {
+    const T absValue = vtkm::Abs(value);
+    Type bits;
+    std::memcpy(&bits, &absValue, sizeof(Type));
+    return bits;
+  }
+  VTKM_EXEC_CONT static T ToValue(Type bits)
+  {
+    T value;
+    std::memcpy(&value, &bits, sizeof(T));
+    return value;
+  }
+};
+template <typename T>
+struct AbsBits;
+template <>
+struct AbsBits<vtkm::Float32> : AbsBitsImpl<vtkm::Float32, vtkm::UInt32>
+{
+};
+template <>
+struct AbsBits<vtkm::Float64> : AbsBitsImpl<vtkm::Float64, vtkm::UInt64>
+{
+};
+
+// One pass of a radix select on the absolute values of an array: counts the values whose
+// higher digits match `prefix` into bins by the digit at `shift`.
+class AbsRadixHistogram : public vtkm::worklet::WorkletMapField
+{
+public:
+  using ControlSignature = void(FieldIn, AtomicArrayInOut);
+  using ExecutionSignature = void(_1, _2);
+  using InputDomain = _1;
+
+  static constexpr vtkm::Id DigitBits = 16;
+  static constexpr vtkm::Id NumberOfBins = vtkm::Id(1) << DigitBits;
+
+  AbsRadixHistogram(vtkm::UInt64 prefix, vtkm::UInt64 prefixMask, vtkm::Id shift)
+    : Prefix(prefix)
+    , PrefixMask(prefixMask)
+    , Shift(shift)
+  {
+  }
+
+  template <typename ValueType, typename BinsType>
+  VTKM_EXEC void operator()(const ValueType& value, const BinsType& bins) const
+  {
+    const vtkm::UInt64 bits = static_cast<vtkm::UInt64>(AbsBits<ValueType>::Get(value));
+    if ((bits & this->PrefixMask) == this->Prefix)
+    {
+      bins.Add(static_cast<vtkm::Id>((bits >> this->Shift) & vtkm::UInt64(NumberOfBins - 1)), 1);
+    }
+  }
+
+private:
+  vtkm::UInt64 Prefix;
+  vtkm::UInt64 PrefixMask;
+  vtkm::Id Shift;
+};
+
 class SquaredDeviation : public vtkm::worklet::WorkletMapField
 {
 public: